@@ -16,9 +16,20 @@
 #include "DataFitSurrModel.hpp"
 #include "MarginalsCorrDistribution.hpp"
 #include "dakota_mersenne_twister.hpp"
+#include "util_threads.hpp"
+#include <algorithm>
+#include <exception>
+#include <thread>
 
 namespace Dakota {
 
+/// minimum number of bootstrap replicates per thread
+static const size_t ASM_THREAD_REPLICATES = 4;
+
+/// threshold relative to the largest candidate below which a pivot of the
+/// unpivoted elimination for the nested determinants is rejected
+static const Real ASM_PIVOT_THRESHOLD = 0.1;
+
 /// initialization of static needed by RecastModel callbacks
 ActiveSubspaceModel* ActiveSubspaceModel::asmInstance(NULL);
 
@@ -508,9 +519,10 @@ void ActiveSubspaceModel::compute_svd()
   // Want eigenvalues of derivMatrix*derivMatrix^T, so perform SVD of
   // derivMatrix and square them
 
-  RealMatrix V_transpose;
+  // only the left singular vectors are used
+  RealVector svd_work;
   leftSingularVectors = derivativeMatrix;
-  svd(leftSingularVectors, singularValues, V_transpose);
+  left_singular_vectors(leftSingularVectors, singularValues, svd_work);
 
   // TODO: Analyze whether we need to worry about this
   if(singularValues.length() == 0) {
@@ -532,6 +544,8 @@ void ActiveSubspaceModel::compute_svd()
 
 void ActiveSubspaceModel::truncate_subspace()
 {
+  compute_bootstrap_metrics();
+
   unsigned int bing_li_rank = compute_bing_li_criterion(singularValues),
     constantine_rank = compute_constantine_metric(singularValues),
     energy_rank      = compute_energy_criterion(singularValues),
@@ -631,6 +645,205 @@ void ActiveSubspaceModel::truncate_subspace()
 }
 
 
+/** The replicates resample whole samples (blocks of numFns columns) of
+    the derivative matrix.  Their block indices are drawn serially, so
+    the random sequence and both metrics are shared by the Bing Li and
+    Constantine criteria and do not depend on the number of threads;
+    each thread reuses one workspace for its contiguous range of
+    replicates, and the per-replicate results are summed in order. */
+void ActiveSubspaceModel::compute_bootstrap_metrics()
+{
+  int num_vars = derivativeMatrix.numRows(),
+    num_vals = std::min(num_vars, (int)derivativeMatrix.numCols());
+  size_t r, j, num_dets = num_vals,
+    num_dists = std::min(num_vals, num_vars-1);
+  bootstrapDeterminants.assign(num_dets, 0.);
+  bootstrapDistances.assign(num_dists, 0.);
+
+  BootstrapSampler<RealMatrix> bootstrap_sampler(derivativeMatrix, numFns);
+  size_t num_blocks = bootstrap_sampler.getDataSize();
+  std::vector<SizetArray> replicate_blocks(numReplicates);
+  for (r=0; r<numReplicates; ++r)
+    bootstrap_sampler.sample_indices(num_blocks, replicate_blocks[r]);
+
+  RealArray abs_dets(numReplicates * num_dets, 0.),
+    dists(numReplicates * num_dists, 0.);
+  auto replicate_range = [&](size_t r_start, size_t r_end) {
+    BootstrapWorkspace ws;
+    for (size_t i=r_start; i<r_end; ++i)
+      bootstrap_replicate(replicate_blocks[i], ws,
+			  abs_dets.data() + i * num_dets,
+			  dists.data() + i * num_dists);
+  };
+
+  size_t num_threads
+    = dakota::util::num_threads(0, numReplicates / ASM_THREAD_REPLICATES);
+  if (num_threads <= 1)
+    replicate_range(0, numReplicates);
+  else {
+    std::vector<std::thread> threads;
+    std::vector<std::exception_ptr> failures(num_threads);
+    size_t t, r_per_thread = numReplicates / num_threads,
+      r_remainder = numReplicates % num_threads, r_start = 0;
+    for (t=0; t<num_threads; ++t) {
+      size_t r_end = r_start + r_per_thread + (t < r_remainder ? 1 : 0);
+      threads.emplace_back([&, t, r_start, r_end]() {
+	try { replicate_range(r_start, r_end); }
+	catch (...) { failures[t] = std::current_exception(); }
+      });
+      r_start = r_end;
+    }
+    for (std::thread& th : threads)
+      th.join();
+    for (t=0; t<num_threads; ++t)
+      if (failures[t])
+	std::rethrow_exception(failures[t]);
+  }
+
+  for (r=0; r<numReplicates; ++r) {
+    for (j=0; j<num_dets; ++j)
+      bootstrapDeterminants[j] += abs_dets[r * num_dets + j];
+    for (j=0; j<num_dists; ++j)
+      bootstrapDistances[j] += dists[r * num_dists + j];
+  }
+  for (j=0; j<num_dets; ++j)
+    bootstrapDeterminants[j] /= (Real)numReplicates;
+  for (j=0; j<num_dists; ++j)
+    bootstrapDistances[j] /= (Real)numReplicates;
+}
+
+
+/** The replicate is assembled from whole samples and only its leading
+    singular vectors enter either metric (see subspace_metrics()). */
+void ActiveSubspaceModel::
+bootstrap_replicate(const SizetArray& blocks, BootstrapWorkspace& ws,
+		    Real* abs_dets, Real* dists) const
+{
+  int num_vars = derivativeMatrix.numRows(),
+    num_minors = (int)bootstrapDeterminants.size() - 1,
+    num_dists = bootstrapDistances.size(),
+    num_vecs = std::max(num_minors, num_dists);
+
+  // assemble the replicate from whole samples and compute its SVD
+  size_t b, f, num_blocks = blocks.size();
+  ws.replicate.shapeUninitialized(num_vars, derivativeMatrix.numCols());
+  for (b=0; b<num_blocks; ++b)
+    for (f=0; f<numFns; ++f) {
+      const Real* col = derivativeMatrix[blocks[b]*numFns + f];
+      std::copy(col, col + num_vars, ws.replicate[b*numFns + f]);
+    }
+  left_singular_vectors(ws.replicate, ws.singularValues, ws.svdWork);
+  if (num_vecs <= 0)
+    return;
+
+  RealMatrix W(Teuchos::View, leftSingularVectors, num_vars, num_vecs),
+    U(Teuchos::View, ws.replicate, num_vars, num_vecs);
+  subspace_metrics(W, U, num_minors, num_dists, ws, abs_dets, dists);
+}
+
+
+/** Both metrics depend on U only through the K x K projection P = W^T U
+    onto the leading K vectors of W.  The determinants of all leading
+    minors P_j follow from one elimination without pivoting, as the
+    products of its pivots, for as long as each pivot is within a
+    threshold of the largest candidate in its column; any remaining
+    minors are factored individually with partial pivoting.  The
+    distance between the projectors onto W_j and U_j is
+    sqrt(2) ||(I - W_j W_j^T) U_j||_F, which avoids the cancellation of
+    forming the projectors, and the residual is updated as each pair of
+    singular vectors is added. */
+void ActiveSubspaceModel::
+subspace_metrics(const RealMatrix& W, const RealMatrix& U, int num_minors,
+		 int num_dists, BootstrapWorkspace& ws, Real* abs_dets,
+		 Real* dists)
+{
+  int i, j, c, num_vars = W.numRows(),
+    num_vecs = std::max(num_minors, num_dists);
+  if (num_vecs <= 0)
+    return;
+
+  RealMatrix W_K(Teuchos::View, W, num_vars, num_vecs),
+    U_K(Teuchos::View, U, num_vars, num_vecs);
+  RealMatrix& P = ws.projection;
+  P.shapeUninitialized(num_vecs, num_vecs);
+  P.multiply(Teuchos::TRANS, Teuchos::NO_TRANS, 1., W_K, U_K, 0.);
+
+  // Bing Li: |det(P_j)| for j = 1, ..., num_minors, stored at abs_dets[j]
+  if (num_minors > 0) {
+    RealMatrix& A = ws.minor;
+    A.shapeUninitialized(num_minors, num_minors);
+    for (c=0; c<num_minors; ++c)
+      for (i=0; i<num_minors; ++i)
+	A(i,c) = P(i,c);
+    Real det = 1.;
+    for (j=0; j<num_minors; ++j) {
+      Real col_max = 0.;
+      for (i=j; i<num_minors; ++i)
+	col_max = std::max(col_max, std::abs(A(i,j)));
+      if (col_max == 0.) {
+	// the Schur complement is singular, as are all larger minors
+	for (; j<num_minors; ++j)
+	  abs_dets[j+1] = 0.;
+	break;
+      }
+      if (std::abs(A(j,j)) < ASM_PIVOT_THRESHOLD * col_max)
+	break;
+      det *= A(j,j);
+      abs_dets[j+1] = std::abs(det);
+      for (i=j+1; i<num_minors; ++i) {
+	Real l = A(i,j) / A(j,j);
+	for (c=j+1; c<num_minors; ++c)
+	  A(i,c) -= l * A(j,c);
+      }
+    }
+    Teuchos::LAPACK<int, Real> lapack;
+    for (; j<num_minors; ++j) {
+      int n = j+1, info;
+      A.shapeUninitialized(n, n);
+      for (c=0; c<n; ++c)
+	for (i=0; i<n; ++i)
+	  A(i,c) = P(i,c);
+      if (ws.pivots.length() < n)
+	ws.pivots.sizeUninitialized(n);
+      lapack.GETRF(n, n, A.values(), n, ws.pivots.values(), &info);
+      det = 1.;
+      for (i=0; i<n; ++i)
+	det *= A(i,i);
+      abs_dets[j+1] = std::abs(det);
+    }
+  }
+
+  // Constantine: ||W_j W_j^T - U_j U_j^T||_F for j+1 vectors at dists[j]
+  RealMatrix& R = ws.residual;
+  R.shapeUninitialized(num_vars, num_dists);
+  for (j=0; j<num_dists; ++j) {
+    // remove the component along w_j from the earlier residuals
+    const Real* w_j = W[j];
+    for (c=0; c<j; ++c) {
+      Real p = P(j,c), *r_c = R[c];
+      for (i=0; i<num_vars; ++i)
+	r_c[i] -= p * w_j[i];
+    }
+    // residual of u_j from its projection onto w_0, ..., w_j
+    Real* r_j = R[j];
+    const Real* u_j = U[j];
+    for (i=0; i<num_vars; ++i)
+      r_j[i] = u_j[i];
+    for (c=0; c<=j; ++c) {
+      Real p = P(c,j);
+      const Real* w_c = W[c];
+      for (i=0; i<num_vars; ++i)
+	r_j[i] -= p * w_c[i];
+    }
+    Real res_sq = 0.;
+    for (c=0; c<=j; ++c)
+      for (i=0; i<num_vars; ++i)
+	res_sq += R(i,c) * R(i,c);
+    dists[j] = std::sqrt(2. * res_sq);
+  }
+}
+
+
 unsigned int ActiveSubspaceModel::
 compute_bing_li_criterion(RealVector& singular_values)
 {
@@ -659,56 +872,12 @@ compute_bing_li_criterion(RealVector& singular_values)
 
   // Compute part 2 of criterion: bootstrapped determinant metric
 
-  RealMatrix bootstrapped_sample(num_vars, derivativeMatrix.numCols());
-  RealVector sample_sing_vals;
-  RealMatrix sample_sing_vectors;
-
-  Teuchos::LAPACK<RealMatrix::ordinalType, RealMatrix::scalarType> lapack;
-
-  std::vector<Real> bootstrapped_det(bing_li_criterion.size());
-
-  BootstrapSampler<RealMatrix> bootstrap_sampler(derivativeMatrix,numFns);
-
-  for (size_t i = 0; i < numReplicates; ++i) {
-    bootstrap_sampler(bootstrapped_sample);
-
-    svd(bootstrapped_sample, sample_sing_vals, sample_sing_vectors);
-
-    // Overwrite bootstrap replicate with singular matrix product
-    RealMatrix bootstrapped_sample_copy = bootstrapped_sample;
-    bootstrapped_sample.multiply(Teuchos::TRANS, Teuchos::NO_TRANS, 1.0,
-                                 leftSingularVectors, bootstrapped_sample_copy,
-                                 0.0);
-
-    for(size_t j = 1; j < bootstrapped_det.size(); ++j) {
-      size_t num_sing_vec = j;
-
-      RealMatrix submatrix(Teuchos::Copy, bootstrapped_sample, num_sing_vec,
-                           num_sing_vec);
-
-      // Get determinant from LU decomposition
-
-      Teuchos::SerialDenseVector<RealMatrix::ordinalType,
-                                 RealMatrix::ordinalType> pivot(num_sing_vec);
-      RealMatrix::ordinalType info;
-
-      lapack.GETRF(num_sing_vec, num_sing_vec, submatrix.values(),
-                   num_sing_vec, pivot.values(), &info);
-
-      RealMatrix::scalarType det = 1.0;
-      for (size_t i = 0; i < j; ++i) {
-        det *= submatrix(i,i);
-      }
-
-      bootstrapped_det[j] += std::abs(det);
-    }
-  }
+  std::vector<Real> bootstrapped_det(bootstrapDeterminants);
 
   RealMatrix::scalarType det_sum = 0.0;
   bootstrapped_det[0] = 0.0;
   for (size_t i = 1; i < bootstrapped_det.size(); ++i) {
-    bootstrapped_det[i] = 1.0 - bootstrapped_det[i] /
-                          static_cast<RealMatrix::scalarType>(numReplicates);
+    bootstrapped_det[i] = 1.0 - bootstrapped_det[i];
     det_sum += bootstrapped_det[i];
   }
 
@@ -744,57 +913,9 @@ compute_bing_li_criterion(RealVector& singular_values)
 unsigned int ActiveSubspaceModel::
 compute_constantine_metric(RealVector& singular_values)
 {
-  int num_vars = derivativeMatrix.numRows();
-  int num_vals;
-  if (derivativeMatrix.numCols() < num_vars)
-    num_vals = derivativeMatrix.numCols();
-  else
-    num_vals = num_vars;
-
-  // Stores Constantine's metric
-  RealArray constantine_metric((num_vals < num_vars-1) ? num_vals : num_vars-1,
-                               0);
-
-  // Compute bootstrapped subspaces
-  RealMatrix bootstrapped_sample(num_vars, derivativeMatrix.numCols());
-  RealMatrix dist_mat(num_vars, num_vars);
-  RealVector sample_sing_vals;
-  RealMatrix sample_sing_vectors;
-  RealVector dist_sing_vals;
-  RealMatrix dist_sing_vectors;
-
-  Teuchos::LAPACK<RealMatrix::ordinalType, RealMatrix::scalarType> lapack;
-
-  BootstrapSampler<RealMatrix> bootstrap_sampler(derivativeMatrix, numFns);
-
-  for (size_t i = 0; i < numReplicates; ++i) {
-    bootstrap_sampler(bootstrapped_sample);
-
-    svd(bootstrapped_sample, sample_sing_vals, sample_sing_vectors);
-
-    for(size_t j = 0; j < constantine_metric.size(); ++j) {
-      size_t num_sing_vec = j+1;
-
-      RealMatrix submatrix(Teuchos::View, leftSingularVectors, num_vars,
-                           num_sing_vec);
-
-      RealMatrix submatrix_bootstrap(Teuchos::View, bootstrapped_sample,
-                                     num_vars, num_sing_vec);
-
-      dist_mat.multiply(Teuchos::NO_TRANS, Teuchos::TRANS, 1.0,
-                        submatrix, submatrix, 0.0);
-
-      dist_mat.multiply(Teuchos::NO_TRANS, Teuchos::TRANS, -1.0,
-                        submatrix_bootstrap, submatrix_bootstrap, 1.0);
-
-      // The spectral norm is slow, let's use the Frobenius norm instead.
-      // Compute the spectral norm of dist_mat (largest singular value):
-      //svd(dist_mat, dist_sing_vals, dist_sing_vectors);
-      //constantine_metric[j] += dist_sing_vals(0) / numReplicates;
-
-      constantine_metric[j] += dist_mat.normFrobenius() / numReplicates;
-    }
-  }
+  // Stores Constantine's metric, the bootstrapped subspace distances; the
+  // spectral norm is slow, so the Frobenius norm is used instead
+  const RealArray& constantine_metric = bootstrapDistances;
 
   if (outputLevel >= NORMAL_OUTPUT) {
     Cout << "\nSubspace Model: Constantine metric values are:\n[ ";
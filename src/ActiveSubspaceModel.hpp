@@ -66,6 +66,31 @@ public:
   /// destructor
   ~ActiveSubspaceModel();
 
+  /// storage reused across the bootstrap replicates evaluated by a thread
+  struct BootstrapWorkspace {
+    RealMatrix replicate;      ///< replicate, overwritten with its U
+    RealVector singularValues; ///< singular values of the replicate
+    RealVector svdWork;        ///< LAPACK workspace for the SVD
+    RealMatrix projection;     ///< leading block of W^T U
+    RealMatrix minor;          ///< leading minor being factored
+    IntVector  pivots;         ///< pivots of the factored minor
+    RealMatrix residual;       ///< (I - W_j W_j^T) U_j
+  };
+
+  //
+  //- Heading: Static member functions
+  //
+
+  /// compare the leading singular vectors W of the derivative matrix
+  /// with those U of a bootstrap replicate (each with at least
+  /// max(num_minors, num_dists) orthonormal columns): |det(W_j^T U_j)|
+  /// for j = 1, ..., num_minors at abs_dets[j] and the projector distance
+  /// ||W_j W_j^T - U_j U_j^T||_F for j = 1, ..., num_dists at dists[j-1]
+  static void subspace_metrics(const RealMatrix& W, const RealMatrix& U,
+			       int num_minors, int num_dists,
+			       BootstrapWorkspace& ws, Real* abs_dets,
+			       Real* dists);
+
   //
   //- Heading: Virtual function redefinitions
   //
@@ -149,6 +174,16 @@ protected:
   /// use the truncation methods to identify the size of an active subspace
   void truncate_subspace();
 
+  /// average the nested determinants and subspace distances used by the
+  /// Bing Li and Constantine metrics over bootstrap replicates of the
+  /// derivative matrix, distributing the replicates among threads
+  void compute_bootstrap_metrics();
+
+  /// compute the metrics for the replicate comprising the given blocks
+  /// (samples) of the derivative matrix
+  void bootstrap_replicate(const SizetArray& blocks, BootstrapWorkspace& ws,
+			   Real* abs_dets, Real* dists) const;
+
   /// compute Bing Li's criterion to identify the active subspace
   unsigned int compute_bing_li_criterion(RealVector& singular_values);
 
@@ -263,6 +298,14 @@ protected:
   /// singular values of derivativeMatrix
   RealVector singularValues;
 
+  /// bootstrap mean of |det(W_j^T U_j)| for the leading j singular
+  /// vectors W of derivativeMatrix and U of a replicate (Bing Li)
+  RealArray bootstrapDeterminants;
+
+  /// bootstrap mean of ||W_j W_j^T - U_j U_j^T||_F for j+1 leading
+  /// singular vectors (Constantine)
+  RealArray bootstrapDistances;
+
   /// matrix of fullspace variable points samples
   /// size numContinuousVars * (numSamples)
   RealMatrix varsMatrix;
@@ -12,6 +12,9 @@
 #include "ParamResponsePair.hpp"
 #include "ProblemDescDB.hpp"
 #include "ParallelLibrary.hpp"
+#include <cmath>
+#include <iterator>
+#include <limits>
 
 //#define DEBUG
 
@@ -19,6 +22,21 @@ namespace Dakota {
 
 extern PRPCache data_pairs;
 
+/// target ratio of the message overhead to the evaluation time of a
+/// batched message
+static const Real BATCH_OVERHEAD_FRACTION = 0.1;
+/// weight of the latest batched message in the running means of the
+/// evaluation time and message overhead
+static const Real BATCH_SMOOTHING = 0.25;
+
+/// upper bound on the length of a batched message containing num_evals
+/// evaluation ids, each followed by an object packed in len_message bytes
+static int batch_message_length(int len_message, int num_evals)
+{
+  int len_int = MPIPackSize(num_evals);
+  return len_int + MPIPackSize((Real)0.) + num_evals * (len_int + len_message);
+}
+
 ApplicationInterface::
 ApplicationInterface(const ProblemDescDB& problem_db):
   Interface(BaseConstructor(), problem_db),
@@ -49,6 +67,10 @@ ApplicationInterface(const ProblemDescDB& problem_db):
   lenPRPairMessage(0),
   evalScheduling(problem_db.get_short("interface.evaluation_scheduling")),
   analysisScheduling(problem_db.get_short("interface.analysis_scheduling")),
+  messageBatchFlag(problem_db.get_bool("interface.message_batching")),
+  messageBatchMax(
+    problem_db.get_int("interface.message_batching.max_batch_size")),
+  messageBatching(false),
   asynchLocalEvalStatic(
     problem_db.get_short("interface.local_evaluation_scheduling") ==
     STATIC_SCHEDULING),
@@ -63,6 +85,8 @@ ApplicationInterface(const ProblemDescDB& problem_db):
     problem_db.get_bool("interface.nearby_evaluation_cache")),
   nearbyTolerance(
     problem_db.get_real("interface.nearby_evaluation_cache_tolerance")),
+  quantizedCacheFlag(problem_db.get_bool("interface.quantized_cache")),
+  evalKeyCacheLoaded(false),
   restartFileFlag(problem_db.get_bool("interface.restart_file")),
   sharedRespData(SharedResponseData(problem_db)),
   gradientType(problem_db.get_string("responses.gradient_type")),
@@ -75,7 +99,8 @@ ApplicationInterface(const ProblemDescDB& problem_db):
   failRetryLimit(problem_db.get_int("interface.failure_capture.retry_limit")),
   failRecoveryFnVals(
     problem_db.get_rv("interface.failure_capture.recovery_fn_vals")),
-  sendBuffers(NULL), recvBuffers(NULL), recvRequests(NULL)
+  sendBuffers(NULL), recvBuffers(NULL), recvRequests(NULL),
+  batchEvalTime(0.), batchMessageOverhead(0.), numBatchMessages(0)
 {
   // set coreMappings flag based on presence of analysis_drivers specification
   coreMappings = (numAnalysisDrivers > 0);
@@ -84,6 +109,13 @@ ApplicationInterface(const ProblemDescDB& problem_db):
 	 << "ApplicationInterface.\n" << std::endl;
     abort_handler(-1);
   }
+
+  if (quantizedCacheFlag) {
+    int max_entries
+      = problem_db.get_int("interface.quantized_cache_max_entries");
+    evalKeyCache.initialize((nearbyDuplicateDetect) ? nearbyTolerance : 0.,
+			    std::max(0, max_entries));
+  }
 }
 
 
@@ -211,6 +243,12 @@ set_evaluation_communicators(const IntArray& message_lengths)
   // user spec > 1).
   asynchLocalEvalConcurrency = (ieMessagePass && asynchLocalEvalConcSpec == 0)
                              ? 1 : asynchLocalEvalConcSpec;
+
+  // batched messages are exchanged by a dedicated master and servers that
+  // perform one evaluation at a time; this is determined consistently by
+  // the master and the servers from the same specification
+  messageBatching = (messageBatchFlag && ieMessagePass && ieDedMasterFlag &&
+		     asynchLocalEvalConcurrency <= 1);
 }
 
 
@@ -494,6 +532,7 @@ void ApplicationInterface::map(const Variables& vars, const ActiveSet& set,
 	// use this constructor since deep copies of vars/response are needed
 	ParamResponsePair prp(vars, interfaceId, core_resp, evalIdCntr);
 	beforeSynchCorePRPQueue.insert(prp);
+	TraceProfiler::begin_span("queue_wait", "interface", this, evalIdCntr);
 	// jobs are not queued until call to synchronize() to allow dynamic
 	// scheduling. Response data headers and data_pair list insertion
 	// appear in synchronize().
@@ -507,13 +546,18 @@ void ApplicationInterface::map(const Variables& vars, const ActiveSet& set,
 	//common_input_filtering(vars);
 
 	currEvalId = evalIdCntr;
-	try { derived_map(vars, core_set, core_resp, currEvalId); }
+	start_evaluation_timer(currEvalId);
+	try {
+	  TraceScope trace_scope("evaluation", "interface", currEvalId);
+	  derived_map(vars, core_set, core_resp, currEvalId);
+	}
 
 	catch(const FunctionEvalFailure& fneval_except) {
 	  //Cout << "Caught FunctionEvalFailure in map; message: " 
 	  //<< fneval_except.what() << std::endl;
 	  manage_failure(vars, core_set, core_resp, currEvalId);
 	}
+	stop_evaluation_timer(currEvalId, true);
 
 	//common_output_filtering(core_resp);
 
@@ -521,7 +565,7 @@ void ApplicationInterface::map(const Variables& vars, const ActiveSet& set,
 	  // manage shallow/deep copy of vars/response with evalCacheFlag
 	  ParamResponsePair prp(vars, interfaceId, core_resp, currEvalId,
 				evalCacheFlag);
-	  if (evalCacheFlag)   data_pairs.insert(prp);
+	  if (evalCacheFlag)   cache_evaluation(prp);
 	  if (restartFileFlag) parallelLib.write_restart(prp);
 	}
       }
@@ -608,7 +652,31 @@ duplication_detect(const Variables& vars, Response& response, bool asynch_flag)
   //   requiring an additional test to prefer positive id's in some use cases).
   PRPCacheOIter ord_it; PRPCacheHIter hash_it;
   ParamResponsePair cache_pr; int cache_eval_id; bool cache_hit = false;
-  if (nearbyDuplicateDetect) { // slow but allows tolerance on equality
+  if (quantizedCacheFlag) { // hashed, bounded, exact or tolerance-based
+    if (!evalKeyCacheLoaded) {
+      // evals preceding this interface's first map (e.g., from restart)
+      for (PRPCacheCIter it=data_pairs.begin(); it!=data_pairs.end(); ++it)
+	if (it->interface_id() == interfaceId)
+	  evalKeyCache.insert(*it);
+      evalKeyCacheLoaded = true;
+    }
+    const ParamResponsePair* found_pr = evalKeyCache.find(interfaceId, vars,
+      response.active_set());
+    cache_hit = (found_pr != NULL);
+    if (cache_hit) {
+      response.update(found_pr->response(), true); // update metadata
+      cache_eval_id = found_pr->eval_id();
+      if (cache_eval_id <= 0) {
+	cache_pr = *found_pr;
+	evalKeyCache.erase(cache_pr);
+	ord_it = lookup_by_ids(data_pairs, cache_pr.eval_interface_ids(),
+			       cache_pr);
+	if (ord_it != data_pairs.end())
+	  data_pairs.erase(ord_it);
+      }
+    }
+  }
+  else if (nearbyDuplicateDetect) { // slow but allows tolerance on equality
     ord_it = lookup_by_nearby_val(data_pairs, interfaceId, vars,
 				  response.active_set(), nearbyTolerance);
     cache_hit = (ord_it != data_pairs.end());
@@ -634,7 +702,9 @@ duplication_detect(const Variables& vars, Response& response, bool asynch_flag)
     if (cache_eval_id <= 0) {
       // ordered key is const; must remove (above) & change/add (below)
       cache_pr.eval_id(evalIdCntr); // promote
-      data_pairs.insert(cache_pr);  // shallow copy of previous vars/resp
+      // shallow copy of previous vars/resp
+      if (quantizedCacheFlag) cache_evaluation(cache_pr);
+      else                    data_pairs.insert(cache_pr);
     }
 
     if (asynch_flag) // asynch case: bookkeep
@@ -732,7 +802,10 @@ const IntResponseMap& ApplicationInterface::synchronize()
     // asynchronous case.
     if (core_prp_jobs) {
       if (ieMessagePass) { // single or multi-processor servers
-	if (ieDedMasterFlag) master_dynamic_schedule_evaluations();
+	if (ieDedMasterFlag) {
+	  if (messageBatching) master_dynamic_schedule_evaluation_batches();
+	  else                 master_dynamic_schedule_evaluations();
+	}
 	else {
 	  // utilize asynch local evals to accomplish a dynamic peer schedule
 	  // (even if hybrid mode not specified) unless precluded by direct
@@ -1041,6 +1114,73 @@ void ApplicationInterface::master_dynamic_schedule_evaluations()
 }
 
 
+/** This code runs on the iteratorCommRank 0 processor (the iterator)
+    in place of master_dynamic_schedule_evaluations() when message
+    batching is active.  Each message to a server carries a batch of
+    evaluations sized by message_batch_size(), and each reply carries
+    their responses along with the time the server spent evaluating,
+    which is used with the round trip time of the message to tune the
+    following batch sizes.  Each server has one message outstanding at a
+    time.  It matches serve_evaluations_synch_batch() on the servers. */
+void ApplicationInterface::master_dynamic_schedule_evaluation_batches()
+{
+  int num_jobs = beforeSynchCorePRPQueue.size(),
+    num_sends = std::min(numEvalServers, num_jobs);
+  Cout << "Master dynamic schedule: assigning " << num_jobs << " jobs among "
+       << num_sends << " servers in batches of up to " << messageBatchMax
+       << " jobs\n";
+
+  sendBuffers  = new MPIPackBuffer   [num_sends];
+  recvBuffers  = new MPIUnpackBuffer [num_sends];
+  recvRequests = new MPI_Request     [num_sends];
+  std::vector<std::chrono::steady_clock::time_point> send_times(num_sends);
+
+  // send a batch to each server and post receives for the replies
+  int i, index, server_id, batch_size, out_count,
+    num_assigned = 0, num_active = 0;
+  PRPQueueIter prp_iter = beforeSynchCorePRPQueue.begin();
+  for (i=0; i<num_sends; ++i) {
+    batch_size = message_batch_size(num_jobs - num_assigned);
+    send_times[i] = std::chrono::steady_clock::now();
+    send_evaluation_batch(prp_iter, batch_size, i, i+1);
+    std::advance(prp_iter, batch_size);
+    num_assigned += batch_size; ++num_active;
+  }
+
+  // process replies and assign the remaining jobs to the returning servers
+  MPI_Status* status_array = new MPI_Status [num_sends];
+  int* index_array = new int [num_sends];
+  while (num_active) {
+    if (outputLevel > SILENT_OUTPUT)
+      Cout << "Master dynamic schedule: waiting on completed jobs"<<std::endl;
+    parallelLib.waitsome(num_sends, recvRequests, out_count, index_array,
+			 status_array);
+    std::chrono::steady_clock::time_point recv_time
+      = std::chrono::steady_clock::now();
+    for (i=0; i<out_count; ++i) {
+      index = index_array[i]; server_id = index + 1;
+      std::chrono::duration<Real> round_trip = recv_time - send_times[index];
+      receive_evaluation_batch(index, server_id, round_trip.count());
+      --num_active;
+      if (num_assigned < num_jobs) {
+	batch_size = message_batch_size(num_jobs - num_assigned);
+	send_times[index] = std::chrono::steady_clock::now();
+	send_evaluation_batch(prp_iter, batch_size, index, server_id);
+	std::advance(prp_iter, batch_size);
+	num_assigned += batch_size; ++num_active;
+      }
+    }
+  }
+  delete [] status_array;
+  delete [] index_array;
+
+  // deallocate MPI & buffer arrays
+  delete [] sendBuffers;   sendBuffers = NULL;
+  delete [] recvBuffers;   recvBuffers = NULL;
+  delete [] recvRequests; recvRequests = NULL;
+}
+
+
 /** This code runs on the iteratorCommRank 0 processor (the iterator) and is
     called from synchronize() in order to manage a static schedule for cases
     where peer 1 must block when evaluating its local job allocation (e.g.,
@@ -2112,11 +2252,17 @@ synchronous_local_evaluations(PRPQueue& local_prp_queue)
     if (multiProcEvalFlag)
       broadcast_evaluation(*local_prp_iter);
 
-    try { derived_map(vars, set, local_response, currEvalId); } // synch. local
+    TraceProfiler::end_span("queue_wait", "interface", this, currEvalId);
+    start_evaluation_timer(currEvalId);
+    try { // synch. local
+      TraceScope trace_scope("evaluation", "interface", currEvalId);
+      derived_map(vars, set, local_response, currEvalId);
+    }
 
     catch(const FunctionEvalFailure& fneval_except) {
       manage_failure(vars, set, local_response, currEvalId);
     }
+    stop_evaluation_timer(currEvalId, true);
 
     process_synch_local(local_prp_iter);
   }
@@ -2168,8 +2314,9 @@ void ApplicationInterface::serve_evaluations()
     else              serve_evaluations_asynch();
   }
   else {
-    if (peer_server1) serve_evaluations_synch_peer();
-    else              serve_evaluations_synch();
+    if (peer_server1)         serve_evaluations_synch_peer();
+    else if (messageBatching) serve_evaluations_synch_batch();
+    else                      serve_evaluations_synch();
   }
 }
 
@@ -2249,6 +2396,98 @@ void ApplicationInterface::serve_evaluations_synch()
 }
 
 
+/** This code is invoked by serve_evaluations() in place of
+    serve_evaluations_synch() when message batching is active.  Each
+    message from the master (see send_evaluation_batch()) carries a
+    batch of evaluations, which are performed one at a time, with the
+    same broadcasts over a multiprocessor evalComm as
+    serve_evaluations_synch().  Their responses are returned in one
+    message along with the time spent evaluating the batch.  Incoming
+    batches are probed and the receive buffer grown to fit, while a reply
+    longer than the receive posted by the master is an error rather than
+    a truncated message. */
+void ApplicationInterface::serve_evaluations_synch_batch()
+{
+  currEvalId = 1;
+  MPI_Status status; // holds source, tag, and number received in MPI_Recv
+  MPI_Request request = MPI_REQUEST_NULL; // bypass MPI_Wait on first pass
+  MPIUnpackBuffer
+    recv_buffer(batch_message_length(lenVarsActSetMessage, messageBatchMax));
+  MPIPackBuffer
+    send_buffer(batch_message_length(lenResponseMessage, messageBatchMax));
+  IntArray eval_ids; ResponseArray responses;
+  int i, num_evals = 1;
+  while (num_evals) {
+    // blocking receive of a batch; a message tagged 0 is the termination
+    // signal from stop_evaluation_servers()
+    if (evalCommRank == 0) { // 1-level or local comm. leader in 2-level
+      int recv_length = parallelLib.probe_ie(0, MPI_ANY_TAG, status);
+      if (recv_buffer.size() < recv_length)
+	recv_buffer.resize(recv_length);
+      recv_buffer.reset();
+      parallelLib.recv_ie(recv_buffer, 0, status.MPI_TAG, status);
+      if (status.MPI_TAG) recv_buffer >> num_evals;
+      else                num_evals = 0;
+    }
+    if (multiProcEvalFlag)
+      parallelLib.bcast_e(num_evals);
+    if (!num_evals)
+      break;
+
+    eval_ids.resize(num_evals); responses.clear();
+    std::chrono::steady_clock::time_point start
+      = std::chrono::steady_clock::now();
+    for (i=0; i<num_evals; ++i) {
+      Variables vars; ActiveSet set;
+      if (evalCommRank == 0) {
+	recv_buffer >> currEvalId >> vars >> set;
+	if (multiProcEvalFlag) // matches serve_evaluations_synch() bcasts
+	  broadcast_evaluation(currEvalId, vars, set);
+      }
+      else if (multiProcEvalFlag) {
+	parallelLib.bcast_e(currEvalId);
+	MPIUnpackBuffer bcast_buffer(lenVarsActSetMessage);
+	parallelLib.bcast_e(bcast_buffer);
+	bcast_buffer >> vars >> set;
+      }
+
+      Response local_response(sharedRespData, set); // special constructor
+      try { derived_map(vars, set, local_response, currEvalId); } //synch local
+      catch(const FunctionEvalFailure& fneval_except) {
+        manage_failure(vars, set, local_response, currEvalId);
+      }
+      eval_ids[i] = currEvalId; responses.push_back(local_response);
+    }
+    std::chrono::duration<Real> batch_time
+      = std::chrono::steady_clock::now() - start;
+
+    // as in serve_evaluations_synch(), wait on the previous reply before
+    // reusing send_buffer
+    if (request != MPI_REQUEST_NULL)
+      parallelLib.wait(request, status);
+    if (evalCommRank == 0) {
+      send_buffer.reset();
+      send_buffer << num_evals << batch_time.count();
+      for (i=0; i<num_evals; ++i)
+	send_buffer << eval_ids[i] << responses[i];
+      // the master sized its receive from lenResponseMessage in
+      // send_evaluation_batch()
+      int max_length = batch_message_length(lenResponseMessage, num_evals);
+      if (send_buffer.size() > max_length) {
+	Cerr << "Error: reply to a batch of " << num_evals << " evaluations "
+	     << "requires " << send_buffer.size() << " bytes, exceeding the "
+	     << max_length << "\n       bytes expected by the master in "
+	     << "ApplicationInterface::serve_evaluations_synch_batch()."
+	     << std::endl;
+	abort_handler(-1);
+      }
+      parallelLib.isend_ie(send_buffer, 0, eval_ids[0], request);
+    }
+  }
+  currEvalId = 0;
+}
+
+
 /** This code is invoked by serve_evaluations() to perform a synchronous
     evaluation in coordination with the iteratorCommRank 0 processor
     (the iterator) for static schedules.  The bcast() matches either the
@@ -2902,15 +3141,72 @@ continuation(const Variables& target_vars, const ActiveSet& set,
 }
 
 
-// NOTE:  The following 3 methods CANNOT be inlined due to linkage errors on
+void ApplicationInterface::
+launch_threaded_evaluation(const ParamResponsePair& pair,
+			   const ThreadedMap& eval_fn)
+{
+  // worker count follows the user's local concurrency (default: one per core)
+  evalThreadPool.initialize(std::max(0, asynchLocalEvalConcurrency));
+
+  // shallow copy: the worker populates the response rep shared with the
+  // queued pair
+  ParamResponsePair prp(pair);
+  evalThreadPool.submit(pair.eval_id(), [prp, eval_fn](size_t thread_index) {
+    Response response(prp.response());
+    eval_fn(prp.variables(), prp.active_set(), response, prp.eval_id(),
+	    thread_index);
+  });
+}
+
+
+void ApplicationInterface::
+collect_threaded_evaluations(PRPQueue& prp_queue, bool block)
+{
+  std::map<int, std::exception_ptr> failures;
+  evalThreadPool.wait(completionSet, failures, block);
+
+  // failures are managed on this thread, as in the synchronous case
+  for (std::map<int, std::exception_ptr>::iterator f_it = failures.begin();
+       f_it != failures.end(); ++f_it) {
+    int fn_eval_id = f_it->first;
+    PRPQueueIter queue_it = lookup_by_eval_id(prp_queue, fn_eval_id);
+    if (queue_it == prp_queue.end()) {
+      Cerr << "Error: failure in queue lookup within ApplicationInterface::"
+	   << "collect_threaded_evaluations()." << std::endl;
+      abort_handler(-1);
+    }
+    Response response = queue_it->response(); // shallow copy
+    try { std::rethrow_exception(f_it->second); }
+    catch(const FunctionEvalFailure& fneval_except) {
+      manage_failure(queue_it->variables(), response.active_set(), response,
+		     fn_eval_id);
+    }
+  }
+}
+
+
+// NOTE:  The following 4 methods CANNOT be inlined due to linkage errors on
 //        native, Windows MSVC builds (strange handling of extern symbols
 //        BoStream write_restart and PRPCache data_pairs)
 
+void ApplicationInterface::cache_evaluation(const ParamResponsePair& prp)
+{
+  data_pairs.insert(prp);
+  // prior to the first lookup, evalKeyCache is loaded from data_pairs
+  if (quantizedCacheFlag && evalKeyCacheLoaded)
+    evalKeyCache.insert(prp);
+}
+
+
 void ApplicationInterface::
 receive_evaluation(PRPQueueIter& prp_it, size_t buff_index, int server_id,
                    bool peer_flag)
 {
+  if (messageBatching) // a batch of one from send_evaluation()
+    { receive_evaluation_batch(buff_index, server_id); return; }
+
   int fn_eval_id = prp_it->eval_id();
+  TraceProfiler::end_span("evaluation", "interface", this, fn_eval_id);
   if (outputLevel > SILENT_OUTPUT) {
     if (interfaceId.empty() || interfaceId == "NO_ID") Cout << "Evaluation ";
     else Cout << interfaceId << " evaluation ";
@@ -2935,11 +3231,123 @@ receive_evaluation(PRPQueueIter& prp_it, size_t buff_index, int server_id,
   raw_response.update(remote_response, true); // update metadata
 
   // insert into restart and eval cache ASAP
-  if (evalCacheFlag)   data_pairs.insert(*prp_it);
+  if (evalCacheFlag)   cache_evaluation(*prp_it);
   if (restartFileFlag) parallelLib.write_restart(*prp_it);
 }
 
 
+/** The message contains the number of evaluations followed by the id,
+    variables and active set of each.  Since its length varies with the
+    batch size, the receive buffer is presized for the batch from the
+    estimated response length; the server checks its reply against the
+    same bound (see serve_evaluations_synch_batch()). */
+void ApplicationInterface::
+send_evaluation_batch(PRPQueueIter prp_it, int num_evals, size_t buff_index,
+		      int server_id)
+{
+  MPIPackBuffer&   send_buffer = sendBuffers[buff_index];
+  MPIUnpackBuffer& recv_buffer = recvBuffers[buff_index];
+  int recv_length = batch_message_length(lenResponseMessage, num_evals);
+  if (recv_buffer.size() < recv_length)
+    recv_buffer.resize(recv_length);
+  send_buffer.reset(); recv_buffer.reset();
+
+  int fn_eval_id, first_eval_id = prp_it->eval_id();
+  send_buffer << num_evals;
+  for (int i=0; i<num_evals; ++i, ++prp_it) {
+    fn_eval_id = prp_it->eval_id();
+    send_buffer << fn_eval_id << prp_it->variables() << prp_it->active_set();
+    TraceProfiler::end_span("queue_wait", "interface", this, fn_eval_id);
+    TraceProfiler::begin_span("evaluation", "interface", this, fn_eval_id);
+  }
+
+  if (outputLevel > SILENT_OUTPUT) {
+    Cout << "Master assigning ";
+    if (!(interfaceId.empty() || interfaceId == "NO_ID")) Cout << interfaceId << ' ';
+    if (num_evals == 1) Cout << "evaluation " << first_eval_id;
+    else Cout << num_evals << " evaluations from " << first_eval_id;
+    Cout << " to server " << server_id << '\n';
+  }
+
+  // the reply is tagged with the id of the first evaluation in the batch
+  parallelLib.irecv_ie(recv_buffer, server_id, first_eval_id,
+		       recvRequests[buff_index]);
+  MPI_Request send_request; // only 1 needed
+  parallelLib.isend_ie(send_buffer, server_id, first_eval_id, send_request);
+  parallelLib.free(send_request); // no test/wait on send_request
+}
+
+
+/** The reply contains the number of evaluations and the time the server
+    spent evaluating them, followed by the id and response of each. */
+void ApplicationInterface::
+receive_evaluation_batch(size_t buff_index, int server_id, Real round_trip)
+{
+  MPIUnpackBuffer& recv_buffer = recvBuffers[buff_index];
+  int i, num_evals, fn_eval_id; Real batch_time;
+  recv_buffer >> num_evals >> batch_time;
+
+  for (i=0; i<num_evals; ++i) {
+    Response remote_response;
+    recv_buffer >> fn_eval_id >> remote_response; // lightweight response
+    PRPQueueIter prp_it
+      = lookup_by_eval_id(beforeSynchCorePRPQueue, fn_eval_id);
+    if (prp_it == beforeSynchCorePRPQueue.end()) {
+      Cerr << "Error: failure in eval id lookup in ApplicationInterface::"
+	   << "receive_evaluation_batch()." << std::endl;
+      abort_handler(-1);
+    }
+    TraceProfiler::end_span("evaluation", "interface", this, fn_eval_id);
+    if (outputLevel > SILENT_OUTPUT) {
+      if (interfaceId.empty() || interfaceId == "NO_ID") Cout << "Evaluation ";
+      else Cout << interfaceId << " evaluation ";
+      Cout << fn_eval_id << " has returned from slave server " << server_id
+	   << '\n';
+    }
+    // as for receive_evaluation()
+    Response raw_response = rawResponseMap[fn_eval_id] = prp_it->response();
+    raw_response.update(remote_response, true); // update metadata
+    if (evalCacheFlag)   cache_evaluation(*prp_it);
+    if (restartFileFlag) parallelLib.write_restart(*prp_it);
+  }
+
+  // update the running means used by message_batch_size()
+  if (round_trip >= 0. && num_evals) {
+    Real eval_time = batch_time / num_evals,
+      overhead = std::max(0., round_trip - batch_time);
+    if (numBatchMessages) {
+      batchEvalTime        += BATCH_SMOOTHING * (eval_time - batchEvalTime);
+      batchMessageOverhead
+	+= BATCH_SMOOTHING * (overhead - batchMessageOverhead);
+    }
+    else
+      { batchEvalTime = eval_time; batchMessageOverhead = overhead; }
+    ++numBatchMessages;
+  }
+}
+
+
+/** Until a reply has been timed, batches contain single evaluations.
+    Then the batch size is the smallest for which the message overhead is
+    at most BATCH_OVERHEAD_FRACTION of the evaluation time of the batch,
+    limited such that the unassigned evaluations still fill two batches
+    per server, which keeps the servers busy toward the end of the
+    schedule. */
+int ApplicationInterface::message_batch_size(int num_unassigned) const
+{
+  int batch_size = 1;
+  if (numBatchMessages) {
+    Real overhead_evals = batchMessageOverhead / BATCH_OVERHEAD_FRACTION;
+    batch_size = (overhead_evals < batchEvalTime * messageBatchMax) ?
+      (int)std::ceil(overhead_evals / batchEvalTime) : messageBatchMax;
+    batch_size = std::min(batch_size,
+			  std::max(1, num_unassigned / (2 * numEvalServers)));
+  }
+  return std::max(1, std::min(batch_size,
+			      std::min(messageBatchMax, num_unassigned)));
+}
+
+
 void ApplicationInterface::process_asynch_local(int fn_eval_id)
 {
   PRPQueueIter prp_it
@@ -2958,8 +3366,13 @@ void ApplicationInterface::process_asynch_local(int fn_eval_id)
     Cout << " has completed\n";
   }
 
+  // completion is detected by the scheduler, so the wall clock time may
+  // include some polling latency
+  stop_evaluation_timer(fn_eval_id, false);
+  TraceProfiler::end_span("evaluation", "interface", this, fn_eval_id);
+  TraceScope trace_scope("process_evaluation", "interface", fn_eval_id);
   rawResponseMap[fn_eval_id] = prp_it->response();
-  if (evalCacheFlag)   data_pairs.insert(*prp_it);
+  if (evalCacheFlag)   cache_evaluation(*prp_it);
   if (restartFileFlag) parallelLib.write_restart(*prp_it);
 
   asynchLocalActivePRPQueue.erase(prp_it);
@@ -2979,12 +3392,33 @@ void ApplicationInterface::process_synch_local(PRPQueueIter& prp_it)
     if (!(interfaceId.empty() || interfaceId == "NO_ID")) Cout << interfaceId << ' ';
     Cout << "evaluation " << fn_eval_id << std::endl;
   }
+  TraceScope trace_scope("process_evaluation", "interface", fn_eval_id);
   rawResponseMap[fn_eval_id] = prp_it->response();
-  if (evalCacheFlag)   data_pairs.insert(*prp_it);
+  if (evalCacheFlag)   cache_evaluation(*prp_it);
   if (restartFileFlag) parallelLib.write_restart(*prp_it);
 }
 
 
+/** CPU time follows the clock() convention of the ParallelLibrary
+    timers (calling process and its waited-for children), such that it
+    can only be attributed to an evaluation that ran alone. */
+void ApplicationInterface::stop_evaluation_timer(int fn_eval_id, bool cpu_flag)
+{
+  std::map<int, std::pair<std::chrono::steady_clock::time_point,
+    std::clock_t> >::iterator t_it = evalTimerStarts.find(fn_eval_id);
+  if (t_it == evalTimerStarts.end())
+    return;
+
+  std::chrono::duration<Real> wall_time
+    = std::chrono::steady_clock::now() - t_it->second.first;
+  Real cpu_time = (cpu_flag) ?
+    (Real)(std::clock() - t_it->second.second) / CLOCKS_PER_SEC :
+    std::numeric_limits<Real>::quiet_NaN();
+  evalTimingMap[fn_eval_id] = RealRealPair(wall_time.count(), cpu_time);
+  evalTimerStarts.erase(t_it);
+}
+
+
 void ApplicationInterface::common_input_filtering(const Variables& vars)
 { } // empty for now
 
@@ -12,8 +12,13 @@
 
 #include "DakotaInterface.hpp"
 #include "PRPMultiIndex.hpp"
+#include "QuantizedPRPCache.hpp"
+#include "EvaluationThreadPool.hpp"
 #include "ParallelLibrary.hpp"
 #include "DataMethod.hpp"
+#include "TraceProfiler.hpp"
+#include <chrono>
+#include <ctime>
 
 namespace Dakota {
 
@@ -48,6 +53,11 @@ public:
 
 protected:
 
+  /// evaluation function executed on a worker thread of evalThreadPool:
+  /// (vars, set, response, fn_eval_id, thread_index)
+  typedef std::function<void(const Variables&, const ActiveSet&, Response&,
+			     int, size_t)> ThreadedMap;
+
   //
   //- Heading: Member functions
   //
@@ -107,6 +117,15 @@ protected:
   /// run on evaluation servers to serve the iterator master
   void serve_evaluations();
 
+  /// launch the evaluation of pair on evalThreadPool, where eval_fn
+  /// is invoked on a worker thread with the evaluation data and the
+  /// index of the worker thread
+  void launch_threaded_evaluation(const ParamResponsePair& pair,
+				  const ThreadedMap& eval_fn);
+  /// add the evaluations completed on evalThreadPool to completionSet,
+  /// managing failures; if block, waits for at least one completion
+  void collect_threaded_evaluations(PRPQueue& prp_queue, bool block);
+
   /// used by the iterator master to terminate evaluation servers
   void stop_evaluation_servers();
 
@@ -250,6 +269,10 @@ protected:
   /// and test_local_evaluations()
   IntSet completionSet;
 
+  /// worker threads for asynchronous local evaluations of in-process
+  /// interfaces declared thread-safe (started on first use)
+  EvaluationThreadPool evalThreadPool;
+
   /// base message for managing failed evals; will be followed with
   /// more details in screen output
   String failureMessage;
@@ -264,6 +287,9 @@ private:
   /// evaluation request has already been performed or queued
   bool duplication_detect(const Variables& vars, Response& response,
 			  bool asynch_flag);
+  /// insert a completed evaluation into data_pairs and, if active, the
+  /// quantized evaluation cache
+  void cache_evaluation(const ParamResponsePair& prp);
 
   /// initialize default ASV if needed; this is done at run time due
   /// to post-construct time Response size changes.
@@ -275,6 +301,10 @@ private:
   /// using message passing on a dedicated master partition; executes on
   /// iteratorComm master
   void master_dynamic_schedule_evaluations();
+  /// blocking dynamic schedule of all evaluations in beforeSynchCorePRPQueue
+  /// using batched messages on a dedicated master partition; executes on
+  /// iteratorComm master
+  void master_dynamic_schedule_evaluation_batches();
   /// blocking static schedule of all evaluations in beforeSynchCorePRPQueue
   /// using message passing on a peer partition; executes on iteratorComm master
   void peer_static_schedule_evaluations();
@@ -316,6 +346,18 @@ private:
   /// helper function for processing recvBuffers[buff_index] within scheduler
   void receive_evaluation(PRPQueueIter& prp_it, size_t buff_index,
 			  int server_id, bool peer_flag);
+  /// helper function for sending num_evals evaluations starting at prp_it
+  /// to a server in one message within sendBuffers[buff_index]
+  void send_evaluation_batch(PRPQueueIter prp_it, int num_evals,
+			     size_t buff_index, int server_id);
+  /// helper function for processing the batch of responses within
+  /// recvBuffers[buff_index], updating the batch size tuning from the
+  /// round trip time of the message if nonnegative
+  void receive_evaluation_batch(size_t buff_index, int server_id,
+				Real round_trip = -1.);
+  /// number of evaluations for the next batched message, given the number
+  /// of evaluations not yet assigned to a server
+  int message_batch_size(int num_unassigned) const;
 
   /// launch an asynchronous local evaluation from a queue iterator 
   void launch_asynch_local(PRPQueueIter& prp_it);
@@ -327,6 +369,12 @@ private:
   /// process a completed synchronous local evaluation
   void process_synch_local(PRPQueueIter& prp_it);
 
+  /// record the start of a local evaluation when timeEvaluations is set
+  void start_evaluation_timer(int fn_eval_id);
+  /// record the elapsed time of a local evaluation within evalTimingMap,
+  /// including its CPU time if it ran without concurrent evaluations
+  void stop_evaluation_timer(int fn_eval_id, bool cpu_flag);
+
   /// helper function for creating an initial active local queue by launching
   /// asynch local jobs from local_prp_queue, as limited by server capacity
   void assign_asynch_local_queue(PRPQueue& local_prp_queue,
@@ -349,6 +397,9 @@ private:
   /// serve the evaluation message passing schedulers and perform
   /// one synchronous evaluation at a time as part of the 1st peer
   void serve_evaluations_synch_peer();
+  /// serve batched messages from a dedicated master and perform their
+  /// evaluations synchronously, one at a time
+  void serve_evaluations_synch_batch();
   /// serve the evaluation message passing schedulers and manage
   /// multiple asynchronous evaluations
   void serve_evaluations_asynch();
@@ -442,6 +493,14 @@ private:
   /// {DEFAULT,MASTER,PEER}_SCHEDULING.  Used for manual overrides of
   /// the auto-configure logic in ParallelLibrary::resolve_inputs().
   short analysisScheduling;
+  /// user specification of message batching between a dedicated master
+  /// and its evaluation servers
+  bool messageBatchFlag;
+  /// maximum number of evaluations in a batched message
+  int messageBatchMax;
+  /// whether message batching is active for the current parallel
+  /// configuration (dedicated master and synchronous evaluation servers)
+  bool messageBatching;
 
   /// limits the number of concurrent evaluations in asynchronous local
   /// scheduling and specifies hybrid concurrency when message passing
@@ -478,6 +537,14 @@ private:
   bool nearbyDuplicateDetect;
   /// tolerance value for tolerance-based duplication detection
   Real nearbyTolerance;
+  /// flag indicating duplication detection using the bounded, hashed
+  /// evalKeyCache in front of data_pairs (exact or within nearbyTolerance)
+  bool quantizedCacheFlag;
+  /// quantized-key index of this interface's evaluations in data_pairs
+  QuantizedPRPCache evalKeyCache;
+  /// whether evalKeyCache has been loaded with the data_pairs entries
+  /// present prior to the first evaluation (e.g., from restart)
+  bool evalKeyCacheLoaded;
 
   /// used to manage a user request to deactivate the restart file (i.e., 
   /// insertions into write_restart).
@@ -535,6 +602,10 @@ private:
   /// used by nonblocking asynchronous local schedulers to bookkeep
   /// active local jobs
   PRPQueue asynchLocalActivePRPQueue;
+  /// wall clock and CPU clock readings at the start of timed local
+  /// evaluations, keyed by evaluation id
+  std::map<int, std::pair<std::chrono::steady_clock::time_point,
+			  std::clock_t> > evalTimerStarts;
   /// used by nonblocking message passing schedulers to bookkeep which
   /// jobs are running remotely
   std::map<int, IntSizetPair> msgPassRunningMap;
@@ -548,6 +619,15 @@ private:
   MPIUnpackBuffer* recvBuffers;
   /// array of requests for nonblocking evaluation receives
   MPI_Request*     recvRequests;
+
+  /// running mean of the time in seconds per evaluation reported by
+  /// servers in replies to batched messages
+  Real batchEvalTime;
+  /// running mean of the overhead in seconds per batched message: the
+  /// round trip time seen by the master less the time spent evaluating
+  Real batchMessageOverhead;
+  /// number of batched messages contributing to the running means
+  size_t numBatchMessages;
 };
 
 
@@ -649,6 +729,11 @@ inline void ApplicationInterface::
 send_evaluation(PRPQueueIter& prp_it, size_t buff_index, int server_id,
 		bool peer_flag)
 {
+  // servers expecting batched messages receive single evaluations as
+  // batches of one (e.g., from master_dynamic_schedule_evaluations_nowait())
+  if (messageBatching)
+    { send_evaluation_batch(prp_it, 1, buff_index, server_id); return; }
+
   if (sendBuffers[buff_index].size()) // reuse of existing send/recv buffers
     { sendBuffers[buff_index].reset(); recvBuffers[buff_index].reset(); }
   else {                              // freshly allocated send/recv buffers
@@ -658,6 +743,8 @@ send_evaluation(PRPQueueIter& prp_it, size_t buff_index, int server_id,
   sendBuffers[buff_index] << prp_it->variables() << prp_it->active_set();
 
   int fn_eval_id = prp_it->eval_id();
+  TraceProfiler::end_span("queue_wait", "interface", this, fn_eval_id);
+  TraceProfiler::begin_span("evaluation", "interface", this, fn_eval_id);
   if (outputLevel > SILENT_OUTPUT) {
     if (peer_flag) {
       Cout << "Peer 1 assigning ";
@@ -707,6 +794,10 @@ inline void ApplicationInterface::launch_asynch_local(PRPQueueIter& prp_it)
   if (multiProcEvalFlag)
     broadcast_evaluation(*prp_it);
   // launch non-blocking job
+  int fn_eval_id = prp_it->eval_id();
+  TraceProfiler::end_span("queue_wait", "interface", this, fn_eval_id);
+  TraceProfiler::begin_span("evaluation", "interface", this, fn_eval_id);
+  start_evaluation_timer(fn_eval_id);
   derived_map_asynch(*prp_it);
 
   // Note: for (plug-in) direct interfaces supporting a batch capability,
@@ -739,6 +830,14 @@ launch_asynch_local(MPIUnpackBuffer& recv_buffer, int fn_eval_id)
 }
 
 
+inline void ApplicationInterface::start_evaluation_timer(int fn_eval_id)
+{
+  if (timeEvaluations)
+    evalTimerStarts[fn_eval_id]
+      = std::make_pair(std::chrono::steady_clock::now(), std::clock());
+}
+
+
 //inline void ApplicationInterface::clear_bookkeeping()
 //{ } // virtual function: default behavior does nothing
 
@@ -0,0 +1,133 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "BatchEvaluation.hpp"
+#include "ParamResponsePair.hpp"
+#include <algorithm>
+
+namespace Dakota {
+
+
+/// size matrix to num_rows x num_cols, reusing its storage when the
+/// shape is unchanged; optionally zero the contents
+template <typename ScalarType>
+static void size_matrix(Teuchos::SerialDenseMatrix<int, ScalarType>& matrix,
+			size_t num_rows, size_t num_cols, bool zero)
+{
+  if (matrix.numRows() != (int)num_rows || matrix.numCols() != (int)num_cols)
+    matrix.shape(num_rows, num_cols); // zeroed
+  else if (zero)
+    matrix.putScalar(ScalarType(0));
+}
+
+
+BatchEvaluation::BatchEvaluation(): numEvals(0), numFns(0)
+{ }
+
+
+BatchEvaluation::~BatchEvaluation()
+{ }
+
+
+bool BatchEvaluation::pack(const PRPQueue& prp_queue)
+{
+  if (prp_queue.empty())
+    return false;
+
+  // all evaluations must share counts and derivative variables
+  const ParamResponsePair& prp0 = *prp_queue.begin();
+  const Variables& vars0 = prp0.variables();
+  size_t num_acv = vars0.acv(), num_adiv = vars0.adiv(),
+    num_adrv = vars0.adrv(), num_adsv = vars0.adsv(),
+    num_fns = prp0.response().num_functions();
+  const SizetArray& dvv = prp0.active_set().derivative_vector();
+  bool grad_flag = false, hess_flag = false;
+  for (PRPQueueCIter it=prp_queue.begin(); it!=prp_queue.end(); ++it) {
+    const Variables& vars = it->variables();
+    if (vars.acv() != num_acv || vars.adiv() != num_adiv ||
+	vars.adrv() != num_adrv || vars.adsv() != num_adsv ||
+	it->response().num_functions() != num_fns ||
+	it->active_set().derivative_vector() != dvv)
+      return false;
+    const ShortArray& asv = it->active_set().request_vector();
+    for (size_t i=0; i<num_fns; ++i) {
+      if (asv[i] & 2) grad_flag = true;
+      if (asv[i] & 4) hess_flag = true;
+    }
+  }
+
+  numEvals = prp_queue.size(); numFns = num_fns; derivVars = dvv;
+  size_t j, num_deriv_vars = dvv.size(), num_fn_cols = numFns * numEvals;
+  size_matrix(contVars,     num_acv,  numEvals, false);
+  size_matrix(discIntVars,  num_adiv, numEvals, false);
+  size_matrix(discRealVars, num_adrv, numEvals, false);
+  discStringVars.resize(num_adsv * numEvals);
+  asvRequests.resize(num_fn_cols);
+  evalIds.resize(numEvals);
+
+  PRPQueueCIter it;
+  for (it=prp_queue.begin(), j=0; it!=prp_queue.end(); ++it, ++j) {
+    const Variables& vars = it->variables();
+    const RealVector& acv  = vars.all_continuous_variables();
+    const IntVector&  adiv = vars.all_discrete_int_variables();
+    const RealVector& adrv = vars.all_discrete_real_variables();
+    StringMultiArrayConstView adsv = vars.all_discrete_string_variables();
+    std::copy(acv.values(),  acv.values()  + num_acv,  contVars[j]);
+    std::copy(adiv.values(), adiv.values() + num_adiv, discIntVars[j]);
+    std::copy(adrv.values(), adrv.values() + num_adrv, discRealVars[j]);
+    std::copy(adsv.begin(), adsv.end(), discStringVars.begin() + j*num_adsv);
+    const ShortArray& asv = it->active_set().request_vector();
+    std::copy(asv.begin(), asv.end(), asvRequests.begin() + j*numFns);
+    evalIds[j] = it->eval_id();
+  }
+
+  size_matrix(fnVals, numFns, numEvals, true);
+  if (grad_flag) size_matrix(fnGrads, num_deriv_vars, num_fn_cols, true);
+  else           fnGrads.shape(0, 0);
+  if (hess_flag)
+    size_matrix(fnHessians, num_deriv_vars, num_deriv_vars * num_fn_cols,
+		true);
+  else
+    fnHessians.shape(0, 0);
+
+  return true;
+}
+
+
+void BatchEvaluation::unpack(PRPQueue& prp_queue) const
+{
+  size_t i, j, r, c, k, num_deriv_vars = derivVars.size();
+  PRPQueueIter it;
+  for (it=prp_queue.begin(), j=0; it!=prp_queue.end(); ++it, ++j) {
+    Response response = it->response(); // shallow copy
+    const ShortArray& asv = response.active_set_request_vector();
+    for (i=0; i<numFns; ++i) {
+      k = j * numFns + i;
+      if (asv[i] & 1)
+	response.function_value(fnVals(i, j), i);
+      if (asv[i] & 2) {
+	RealVector fn_grad = response.function_gradient_view(i);
+	const Real* batch_grad = fnGrads[k];
+	size_t num_rows = std::min((size_t)fn_grad.length(), num_deriv_vars);
+	std::copy(batch_grad, batch_grad + num_rows, fn_grad.values());
+      }
+      if (asv[i] & 4) {
+	RealSymMatrix fn_hess = response.function_hessian_view(i);
+	size_t num_rows = std::min((size_t)fn_hess.numRows(), num_deriv_vars);
+	for (c=0; c<num_rows; ++c) {
+	  const Real* batch_hess_col = fnHessians[k * num_deriv_vars + c];
+	  for (r=c; r<num_rows; ++r)
+	    fn_hess(r, c) = batch_hess_col[r];
+	}
+      }
+    }
+  }
+}
+
+} // namespace Dakota
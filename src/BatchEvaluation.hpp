@@ -0,0 +1,177 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#ifndef BATCH_EVALUATION_H
+#define BATCH_EVALUATION_H
+
+#include "dakota_data_types.hpp"
+#include "PRPMultiIndex.hpp"
+
+
+namespace Dakota {
+
+
+/// Contiguous storage of the data of a batch of function evaluations
+
+/** A BatchEvaluation packs the variables and active sets of a PRPQueue
+    into contiguous column-major arrays with one column per evaluation
+    (in eval id order), and provides preallocated contiguous output
+    arrays into which a vectorized simulator writes the requested
+    results for the whole batch in one call.  unpack() then copies the
+    requested results into the queue's responses.
+
+    Output layout, for evaluation j and function i (with k = j *
+    num_functions() + i):
+    \li function_values(): num_functions() x num_evaluations();
+        entry (i, j)
+    \li function_gradients(): num_derivative_variables() x
+        (num_functions() * num_evaluations()); column k
+    \li function_hessians(): num_derivative_variables() x
+        (num_derivative_variables() * num_functions() *
+        num_evaluations()); the symmetric matrix in columns
+        k * num_derivative_variables() through (k+1) *
+        num_derivative_variables() - 1, of which only the lower
+        triangle is read
+
+    Gradient and Hessian arrays are empty unless requested by some
+    evaluation; only the entries requested by active_set_requests()
+    need to be written. */
+
+class BatchEvaluation
+{
+public:
+
+  //
+  //- Heading: Constructors and destructor
+  //
+
+  BatchEvaluation();  ///< constructor
+  ~BatchEvaluation(); ///< destructor
+
+  //
+  //- Heading: Member functions
+  //
+
+  /// pack the evaluations of prp_queue, reusing previously allocated
+  /// storage where possible; returns false (and packs nothing) if the
+  /// evaluations differ in variable or function counts or derivative
+  /// variables and thus cannot share contiguous storage
+  bool pack(const PRPQueue& prp_queue);
+  /// copy the requested results into the responses of prp_queue (the
+  /// queue that was packed)
+  void unpack(PRPQueue& prp_queue) const;
+
+  /// number of evaluations in the batch
+  size_t num_evaluations() const;
+  /// number of response functions per evaluation
+  size_t num_functions() const;
+  /// number of derivative variables per evaluation
+  size_t num_derivative_variables() const;
+
+  /// evaluation ids of the batch, in column order
+  const IntArray& evaluation_ids() const;
+  /// continuous variables: num continuous x num_evaluations()
+  const RealMatrix& continuous_variables() const;
+  /// discrete integer variables: num discrete int x num_evaluations()
+  const IntMatrix& discrete_int_variables() const;
+  /// discrete real variables: num discrete real x num_evaluations()
+  const RealMatrix& discrete_real_variables() const;
+  /// discrete string variables, column-major with one column of num
+  /// discrete string values per evaluation
+  const StringArray& discrete_string_variables() const;
+  /// active set request vectors, column-major with one column of
+  /// num_functions() values per evaluation
+  const ShortArray& active_set_requests() const;
+  /// derivative variables vector shared by all evaluations
+  const SizetArray& derivative_variables() const;
+
+  /// function values (output)
+  RealMatrix& function_values();
+  /// function gradients (output)
+  RealMatrix& function_gradients();
+  /// function Hessians (output)
+  RealMatrix& function_hessians();
+
+private:
+
+  //
+  //- Heading: Data
+  //
+
+  size_t numEvals;      ///< number of evaluations
+  size_t numFns;        ///< number of functions per evaluation
+  IntArray evalIds;     ///< evaluation ids in column order
+
+  RealMatrix contVars;          ///< packed continuous variables
+  IntMatrix  discIntVars;       ///< packed discrete integer variables
+  RealMatrix discRealVars;      ///< packed discrete real variables
+  StringArray discStringVars;   ///< packed discrete string variables
+  ShortArray asvRequests;       ///< packed active set request vectors
+  SizetArray derivVars;         ///< shared derivative variables vector
+
+  RealMatrix fnVals;     ///< function values
+  RealMatrix fnGrads;    ///< function gradients
+  RealMatrix fnHessians; ///< function Hessians
+};
+
+
+inline size_t BatchEvaluation::num_evaluations() const
+{ return numEvals; }
+
+
+inline size_t BatchEvaluation::num_functions() const
+{ return numFns; }
+
+
+inline size_t BatchEvaluation::num_derivative_variables() const
+{ return derivVars.size(); }
+
+
+inline const IntArray& BatchEvaluation::evaluation_ids() const
+{ return evalIds; }
+
+
+inline const RealMatrix& BatchEvaluation::continuous_variables() const
+{ return contVars; }
+
+
+inline const IntMatrix& BatchEvaluation::discrete_int_variables() const
+{ return discIntVars; }
+
+
+inline const RealMatrix& BatchEvaluation::discrete_real_variables() const
+{ return discRealVars; }
+
+
+inline const StringArray& BatchEvaluation::discrete_string_variables() const
+{ return discStringVars; }
+
+
+inline const ShortArray& BatchEvaluation::active_set_requests() const
+{ return asvRequests; }
+
+
+inline const SizetArray& BatchEvaluation::derivative_variables() const
+{ return derivVars; }
+
+
+inline RealMatrix& BatchEvaluation::function_values()
+{ return fnVals; }
+
+
+inline RealMatrix& BatchEvaluation::function_gradients()
+{ return fnGrads; }
+
+
+inline RealMatrix& BatchEvaluation::function_hessians()
+{ return fnHessians; }
+
+} // namespace Dakota
+
+#endif
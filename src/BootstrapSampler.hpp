@@ -91,6 +91,16 @@ public:
     return sample;
   }
 
+  /// Generate the indices of num_samp samples from the empirical
+  /// distribution, drawing the same random variates as a bootstrapped
+  /// sample of that size, e.g., to assemble the sample elsewhere
+  void sample_indices(size_t num_samp, std::vector<size_t>& indices)
+  {
+    indices.resize(num_samp);
+    for(size_t i = 0; i < num_samp; ++i)
+      indices[i] = sampler(bootstrapRNG);
+  }
+
 protected:
 
   // Internal static members for random variate generation
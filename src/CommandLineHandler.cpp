@@ -384,6 +384,10 @@ void CommandLineHandler::initialize_options()
   enroll("write_restart", GetLongOpt::OptionalValue,
          "Write a new DAKOTA restart file $val", NULL);
 
+  // trace not invoked: retrieve returns NULL; no value: default filename
+  enroll("trace", GetLongOpt::OptionalValue,
+         "Write a trace of evaluation phases to Chrome trace file $val", NULL);
+
   //enroll("mpi", GetLongOpt::Valueless,
   //       "Turn on message passing within an executable built with MPI", 0);
 }
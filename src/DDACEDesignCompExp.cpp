@@ -167,7 +167,9 @@ void DDACEDesignCompExp::post_run(std::ostream& s)
                                                         numContinuousVars + numDiscreteIntVars + numDiscreteRealVars,
                                                         numSamples,
                                                         allSamples,
-                                                        allResponses);
+                                                        allResponses,
+                                                        vbdBootstrapSamples,
+                                                        randomSeed);
   }
   else {
     if (mainEffectsFlag) // need allResponses
@@ -239,7 +239,10 @@ evaluate_parameter_sets(Model& model, bool log_resp_flag, bool log_best_flag)
   bool header_flag = (allHeaders.size() == num_evals),
        asynch_flag = model.asynch_flag();
 
-  if (!asynch_flag && log_resp_flag) allResponses.clear();
+  if (log_resp_flag) {
+    if (!asynch_flag) allResponses.clear();
+    initialize_response_accumulation();
+  }
 
   // Loop over parameter sets and compute responses.  Collect data
   // and track best evaluations based on flags.
@@ -256,6 +259,8 @@ evaluate_parameter_sets(Model& model, bool log_resp_flag, bool log_best_flag)
     else {
       model.evaluate(activeSet);
       log_response(model, allResponses, i, log_resp_flag, log_best_flag);
+      if (log_resp_flag)
+	accumulate_response(model.evaluation_id(), model.current_response());
     }
     archive_model_variables(model, i);
   }
@@ -265,8 +270,12 @@ evaluate_parameter_sets(Model& model, bool log_resp_flag, bool log_best_flag)
   // and synchronize_batches()
   if (asynch_flag) {
     const IntResponseMap& resp_map = model.synchronize();
-    if (log_resp_flag) // log response data
+    if (log_resp_flag) { // log response data
       allResponses = resp_map;
+      for (IntRespMCIter r_cit=resp_map.begin(); r_cit!=resp_map.end();
+	   ++r_cit)
+	accumulate_response(r_cit->first, r_cit->second);
+    }
     if (compactMode) log_response_map(allSamples,   resp_map, log_best_flag);
     else             log_response_map(allVariables, resp_map, log_best_flag);
   }
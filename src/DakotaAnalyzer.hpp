@@ -154,6 +154,15 @@ protected:
   virtual void archive_model_response(const Response&, size_t idx) const
     { /* no-op */ }
 
+  /// prepare to accumulate the responses logged by
+  /// evaluate_parameter_sets() as they complete
+  virtual void initialize_response_accumulation()
+    { /* no-op */ }
+  /// accumulate a response logged by evaluate_parameter_sets(), in
+  /// order of evaluation id
+  virtual void accumulate_response(int eval_id, const Response& resp)
+    { /* no-op */ }
+
   /// convenience function for reading variables/responses (used in
   /// derived classes post_input)
   void read_variables_responses(int num_evals, size_t num_vars);
@@ -266,6 +266,13 @@ void Approximation::rebuild()
 }
 
 
+void Approximation::freeze_hyperparameters(bool freeze)
+{
+  if (approxRep) approxRep->freeze_hyperparameters(freeze);
+  //else no op: rebuild() does not distinguish hyperparameters
+}
+
+
 void Approximation::replace(const IntResponsePair& response_pr, size_t fn_index)
 {
   if (approxRep)
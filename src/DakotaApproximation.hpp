@@ -88,6 +88,9 @@ public:
 
   /// rebuilds the approximation incrementally
   virtual void rebuild();
+  /// hold the current hyperparameters fixed in subsequent rebuild()
+  /// calls, permitting a cheaper incremental update of derived quantities
+  virtual void freeze_hyperparameters(bool freeze);
 
   /// replace the response data 
   virtual void replace(const IntResponsePair& response_pr, size_t fn_index);
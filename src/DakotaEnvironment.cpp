@@ -13,6 +13,7 @@
 #include "WorkdirHelper.hpp"
 #include "ProblemDescDB.hpp"
 #include "IteratorScheduler.hpp"
+#include "TraceProfiler.hpp"
 #include "dakota_preproc_util.hpp"
 
 static const char rcsId[]="@(#) $Id: DakotaEnvironment.cpp 6749 2010-05-03 17:11:57Z briadam $";
@@ -363,9 +364,16 @@ void Environment::execute()
     if ( (topLevelIterator.method_name() & PARALLEL_BIT) == 0 && output_rank )
       topLevelIterator.initialize_graphics(); // default to server_id = 1
 
+    // phase profiling is active only for the run (-trace option)
+    if (!programOptions.trace_file().empty())
+      TraceProfiler::initialize(programOptions.trace_file(),
+				parallelLib.world_rank());
+
     ParLevLIter w_pl_iter = parallelLib.w_parallel_level_iterator();
     IteratorScheduler::run_iterator(topLevelIterator, w_pl_iter);
 
+    TraceProfiler::finalize(Cout, output_rank);
+
     if (output_rank)
       Cout << "<<<<< Environment execution completed.\n";
   
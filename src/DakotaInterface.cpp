@@ -68,7 +68,7 @@ Interface::Interface(BaseConstructor, const ProblemDescDB& problem_db):
   coreMappings(true), outputLevel(problem_db.get_short("method.output")),
   currEvalId(0), fineGrainEvalCounters(outputLevel > NORMAL_OUTPUT),
   evalIdCntr(0), newEvalIdCntr(0), evalIdRefPt(0), newEvalIdRefPt(0),
-  multiProcEvalFlag(false), ieDedMasterFlag(false),
+  timeEvaluations(false), multiProcEvalFlag(false), ieDedMasterFlag(false),
   // See base constructor in DakotaIterator.cpp for full discussion of output
   // verbosity.  Interfaces support the full granularity in verbosity.
   appendIfaceId(true), asl(NULL)
@@ -170,8 +170,8 @@ Interface::Interface(NoDBBaseConstructor, size_t num_fns, short output_level):
   interfaceId(no_spec_id()), algebraicMappings(false), coreMappings(true),
   outputLevel(output_level), currEvalId(0), 
   fineGrainEvalCounters(outputLevel > NORMAL_OUTPUT), evalIdCntr(0), 
-  newEvalIdCntr(0), evalIdRefPt(0), newEvalIdRefPt(0), multiProcEvalFlag(false),
-  ieDedMasterFlag(false), appendIfaceId(true)
+  newEvalIdCntr(0), evalIdRefPt(0), newEvalIdRefPt(0), timeEvaluations(false),
+  multiProcEvalFlag(false), ieDedMasterFlag(false), appendIfaceId(true)
 {
 #ifdef DEBUG
   outputLevel = DEBUG_OUTPUT;
@@ -255,6 +255,13 @@ public:
   /// return rawResponseMap
   IntResponseMap& response_map();
 
+  /// activate or deactivate the timing of evaluations within evalTimingMap
+  void time_evaluations(bool flag);
+  /// return timeEvaluations
+  bool time_evaluations() const;
+  /// return evalTimingMap
+  IntRealRealPairMap& evaluation_timings();
+
   /// migrate an unmatched response record from rawResponseMap to
   /// cachedResponseMap
   void cache_unmatched_response(int raw_id);
@@ -413,6 +420,14 @@ protected:
   /// level context and need to be stored for later
   IntResponseMap cachedResponseMap;
 
+  /// flag for recording the wall clock and CPU time of each evaluation
+  bool timeEvaluations;
+  /// wall clock and CPU seconds of completed evaluations, keyed by
+  /// evaluation id, pending retrieval by the Model that requested them.
+  /** The CPU time is NaN when it cannot be attributed to a single
+      evaluation, as for concurrent asynchronous evaluations. */
+  IntRealRealPairMap evalTimingMap;
+
   /// response function descriptors (used in
   /// print_evaluation_summary() and derived direct interface
   /// classes); initialized in map() functions due to potential
@@ -494,6 +509,21 @@ inline IntResponseMap& Interface::response_map()
 { return (interfaceRep) ? interfaceRep->rawResponseMap : rawResponseMap; }
 
 
+inline void Interface::time_evaluations(bool flag)
+{
+  if (interfaceRep) interfaceRep->timeEvaluations = flag;
+  else              timeEvaluations = flag;
+}
+
+
+inline bool Interface::time_evaluations() const
+{ return (interfaceRep) ? interfaceRep->timeEvaluations : timeEvaluations; }
+
+
+inline IntRealRealPairMap& Interface::evaluation_timings()
+{ return (interfaceRep) ? interfaceRep->evalTimingMap : evalTimingMap; }
+
+
 // nonvirtual functions can access letter attributes directly (only need to fwd
 // member function call when the function could be redefined).
 inline unsigned short Interface::interface_type() const
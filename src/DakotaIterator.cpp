@@ -129,6 +129,7 @@
 #include "DakotaGraphics.hpp"
 #include "ResultsManager.hpp"
 #include "EvaluationStore.hpp"
+#include "TraceProfiler.hpp"
 #include "NonDWASABIBayesCalibration.hpp"
 #include "NonDLowDiscrepancySampling.hpp"
 
@@ -1074,6 +1075,9 @@ void Iterator::run()
       //core_input();
       if (summaryOutputFlag && outputLevel > NORMAL_OUTPUT)
 	Cout << "\n>>>>> " << method_string <<": core run phase.\n";
+      // build the phase name only when tracing
+      TraceScope trace_scope((TraceProfiler::active()) ?
+	method_string + "::core_run" : String(), "iterator");
       core_run();
       //core_output();
     }
@@ -1086,6 +1090,7 @@ void Iterator::run()
     if (summaryOutputFlag)
       Cout << "\n<<<<< Iterator " << method_string <<" completed.\n";
     finalize_run();
+    evaluationsDB.flush();
     resultsDB.flush();
   }
 }
@@ -3746,6 +3746,23 @@ Real Model::solution_level_cost() const
 }
 
 
+RealVector Model::solution_level_measured_costs(bool cpu_time) const
+{
+  if (modelRep) // envelope fwd to letter
+    return modelRep->solution_level_measured_costs(cpu_time);
+  else          // default: no measurements
+    return RealVector();
+}
+
+
+void Model::time_evaluations(bool flag)
+{
+  if (modelRep) // envelope fwd to letter
+    modelRep->time_evaluations(flag);
+  // default: no measurements
+}
+
+
 short Model::solution_control_variable_type() const
 {
   if (!modelRep) { // letter lacking redefinition of virtual fn.
@@ -176,6 +176,13 @@ public:
   /// return currently active cost estimate from solution level
   /// control (SimulationModel)
   virtual Real solution_level_cost() const;
+  /// return ordered averages of measured wall clock (or CPU) seconds per
+  /// evaluation across solution levels (SimulationModel); empty if the
+  /// Model does not measure its evaluations
+  virtual RealVector solution_level_measured_costs(bool cpu_time = false) const;
+  /// activate or deactivate the measurement of evaluation times for
+  /// solution_level_measured_costs() (SimulationModel)
+  virtual void time_evaluations(bool flag);
 
   /// return type of solution control variable
   virtual short solution_control_variable_type() const;
@@ -1629,4 +1629,31 @@ void NonD::archive_equiv_hf_evals(const Real equiv_hf_evals) {
       {ResultAttribute<Real>("equiv_hf_evals",equiv_hf_evals)});
 }
 
+/** For each model, the average wall clock and CPU seconds per evaluation
+    (columns) at each solution level (rows).  Zero entries were not
+    measured. */
+void NonD::archive_measured_costs() {
+  if (!resultsDB.active()) return;
+  ModelList& sub_models = iteratedModel.subordinate_models(false);
+  StringArray timers = {String("wall_clock"), String("cpu")};
+  for (ModelLIter m_iter=sub_models.begin(); m_iter!=sub_models.end();
+       ++m_iter) {
+    RealVector wall_costs = m_iter->solution_level_measured_costs(),
+      cpu_costs = m_iter->solution_level_measured_costs(true);
+    int lev, num_lev = wall_costs.length();
+    if (!num_lev) continue;
+    RealMatrix costs(num_lev, 2, false);
+    IntArray levels(num_lev);
+    for (lev=0; lev<num_lev; ++lev) {
+      costs(lev, 0) = wall_costs[lev];  costs(lev, 1) = cpu_costs[lev];
+      levels[lev] = lev;
+    }
+    DimScaleMap scales;
+    scales.emplace(0, IntegerScale("solution_levels", levels));
+    scales.emplace(1, StringScale("timers", timers));
+    StringArray location = {String("measured_cost"), m_iter->model_id()};
+    resultsDB.insert(run_identifier(), location, costs, scales);
+  }
+}
+
 } // namespace Dakota
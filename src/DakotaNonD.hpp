@@ -287,6 +287,9 @@ protected:
   void archive_pdf(size_t fn_index, size_t inc_id = 0);
   /// archive the equivalent number of HF evals (used by ML/MF methods)
   void archive_equiv_hf_evals(const Real equiv_hf_evals);
+  /// archive the measured evaluation times of the model hierarchy (used
+  /// by ML/MF methods)
+  void archive_measured_costs();
 
   /// return true if N_m is empty or only populated with zeros
   bool zeros(const SizetArray& N_m) const;
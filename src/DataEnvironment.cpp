@@ -17,7 +17,7 @@ namespace Dakota {
 
 // Default constructor:
 DataEnvironmentRep::DataEnvironmentRep():
-  checkFlag(false), stopRestart(0), 
+  checkFlag(false), stopRestart(0), restartFlushInterval(0),
   preRunFlag(false), runFlag(false), postRunFlag(false),
   preRunOutputFormat(TABULAR_ANNOTATED), postRunInputFormat(TABULAR_ANNOTATED),
   graphicsFlag(false), tabularDataFlag(false), 
@@ -25,7 +25,8 @@ DataEnvironmentRep::DataEnvironmentRep():
   outputPrecision(0), 
   resultsOutputFlag(false), resultsOutputFile("dakota_results"),
   resultsOutputFormat(0), modelEvalsSelection(MODEL_EVAL_STORE_TOP_METHOD),
-  interfEvalsSelection(INTERF_EVAL_STORE_SIMULATION)
+  interfEvalsSelection(INTERF_EVAL_STORE_SIMULATION),
+  evalBufferSize(1), evalBufferFlushInterval(60)
 { }
 
 
@@ -33,13 +34,14 @@ void DataEnvironmentRep::write(MPIPackBuffer& s) const
 {
   s << checkFlag 
     << outputFile << errorFile << readRestart << stopRestart << writeRestart
+    << restartFlushInterval
     << preRunFlag << runFlag << postRunFlag << preRunInput << preRunOutput
     << runInput << runOutput << postRunInput << postRunOutput
     << preRunOutputFormat << postRunInputFormat
     << graphicsFlag << tabularDataFlag << tabularDataFile << tabularFormat 
     << outputPrecision << resultsOutputFlag << resultsOutputFile 
     << resultsOutputFormat << modelEvalsSelection << interfEvalsSelection
-    << topMethodPointer;
+    << evalBufferSize << evalBufferFlushInterval << topMethodPointer;
 }
 
 
@@ -47,13 +49,15 @@ void DataEnvironmentRep::read(MPIUnpackBuffer& s)
 {
   s >> checkFlag 
     >> outputFile >> errorFile >> readRestart >> stopRestart >> writeRestart
+    >> restartFlushInterval
     >> preRunFlag >> runFlag >> postRunFlag >> preRunInput >> preRunOutput
     >> runInput >> runOutput >> postRunInput >> postRunOutput
     >> preRunOutputFormat >> postRunInputFormat
     >> graphicsFlag >> tabularDataFlag >> tabularDataFile >> tabularFormat 
     >> outputPrecision
     >> resultsOutputFlag >> resultsOutputFile >> resultsOutputFormat 
-    >> modelEvalsSelection >> interfEvalsSelection >> topMethodPointer;
+    >> modelEvalsSelection >> interfEvalsSelection
+    >> evalBufferSize >> evalBufferFlushInterval >> topMethodPointer;
 }
 
 
@@ -61,13 +65,15 @@ void DataEnvironmentRep::write(std::ostream& s) const
 {
   s << checkFlag 
     << outputFile << errorFile << readRestart << stopRestart << writeRestart
+    << restartFlushInterval
     << preRunFlag << runFlag << postRunFlag << preRunInput << preRunOutput
     << runInput << runOutput << postRunInput << postRunOutput
     << preRunOutputFormat << postRunInputFormat
     << graphicsFlag << tabularDataFlag << tabularDataFile << tabularFormat 
     << outputPrecision
     << resultsOutputFlag << resultsOutputFile << resultsOutputFormat 
-    << modelEvalsSelection << interfEvalsSelection << topMethodPointer;
+    << modelEvalsSelection << interfEvalsSelection
+    << evalBufferSize << evalBufferFlushInterval << topMethodPointer;
 }
 
 
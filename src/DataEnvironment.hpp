@@ -55,6 +55,8 @@ public:
   int stopRestart;
   /// file name for restart write (overrides command-line)
   String writeRestart;
+  /// minimum time in seconds between flushes of the restart file
+  int restartFlushInterval;
 
   bool preRunFlag;      ///< flags invocation with command line option -pre_run
   bool runFlag;         ///< flags invocation with command line option -run
@@ -95,6 +97,11 @@ public:
   unsigned short modelEvalsSelection;
   /// Interface selection for eval storage
   unsigned short interfEvalsSelection;
+  /// Number of evaluations staged in memory per model/interface before
+  /// they are written to HDF5 as a block (1 = unbuffered)
+  int evalBufferSize;
+  /// Maximum age in seconds of staged evaluations before they are written
+  int evalBufferFlushInterval;
   /// method identifier for the environment (from the \c top_method_pointer
   /// specification
   String topMethodPointer;
@@ -19,6 +19,7 @@
 #include <boost/accumulators/statistics/stats.hpp>
 #include <boost/accumulators/statistics/rolling_mean.hpp>
 #include "EvaluationStore.hpp"
+#include "TraceProfiler.hpp"
 
 static const char rcsId[]="@(#) $Id: DataFitSurrModel.cpp 7034 2010-10-22 20:16:32Z mseldre $";
 
@@ -518,6 +519,7 @@ derived_init_communicators(ParLevLIter pl_iter, int max_eval_concurrency,
     for SurrogateData::anchor{Vars,Resp}, so is an unconstrained build. */
 void DataFitSurrModel::build_approximation()
 {
+  TraceScope trace_scope("build_approximation", "surrogate");
   Cout << "\n>>>>> Building " << surrogateType << " approximations.\n";
 
   // update actualModel w/ variable values/bounds/labels
@@ -551,6 +553,7 @@ build_approximation(const Variables& vars, const IntResponsePair& response_pr)
   // > used by SBLM global *with* persistent center vars,response
   // > used by NonDLocal *without* persistent vars,response
 
+  TraceScope trace_scope("build_approximation", "surrogate");
   Cout << "\n>>>>> Building " << surrogateType << " approximations.\n";
 
   // update actualModel w/ variable values/bounds/labels
@@ -583,6 +586,7 @@ build_approximation(const Variables& vars, const IntResponsePair& response_pr)
     It does not define an anchor point, so is an unconstrained build. */
 void DataFitSurrModel::rebuild_approximation()
 {
+  TraceScope trace_scope("rebuild_approximation", "surrogate");
   if (outputLevel >= NORMAL_OUTPUT)
     Cout << "\n>>>>> Rebuilding " << surrogateType << " approximations.\n";
 
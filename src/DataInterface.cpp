@@ -21,11 +21,13 @@ DataInterfaceRep::DataInterfaceRep():
   batchEvalFlag(false), asynchFlag(false),
   asynchLocalEvalConcurrency(0), asynchLocalEvalScheduling(DEFAULT_SCHEDULING),
   asynchLocalAnalysisConcurrency(0), evalServers(0),
-  evalScheduling(DEFAULT_SCHEDULING), procsPerEval(0), analysisServers(0),
+  evalScheduling(DEFAULT_SCHEDULING), messageBatchFlag(false),
+  messageBatchSize(32), procsPerEval(0), analysisServers(0),
   analysisScheduling(DEFAULT_SCHEDULING), procsPerAnalysis(0),
   failAction("abort"), retryLimit(1), activeSetVectorFlag(true),
   evalCacheFlag(true), nearbyEvalCacheFlag(false),
   nearbyEvalCacheTol(DBL_EPSILON), // default relative tolerance is tight
+  quantizedCacheFlag(false), quantizedCacheSize(0),
   restartFileFlag(true), useWorkdir(false), dirTag(false),
   dirSave(false), templateReplace(false), numpyFlag(false)
   // asynchLocal{Eval,Analysis}Concurrency, procsPer{Eval,Analysis} and
@@ -42,10 +44,12 @@ void DataInterfaceRep::write(MPIPackBuffer& s) const
     << resultsFileFormat << fileTagFlag << fileSaveFlag //<< gridHostNames << gridProcsPerHost
     << batchEvalFlag << asynchFlag << asynchLocalEvalConcurrency
     << asynchLocalEvalScheduling << asynchLocalAnalysisConcurrency
-    << evalServers << evalScheduling << procsPerEval << analysisServers
+    << evalServers << evalScheduling << messageBatchFlag << messageBatchSize
+    << procsPerEval << analysisServers
     << analysisScheduling << procsPerAnalysis << failAction << retryLimit
     << recoveryFnVals << activeSetVectorFlag << evalCacheFlag
-    << nearbyEvalCacheFlag << nearbyEvalCacheTol << restartFileFlag
+    << nearbyEvalCacheFlag << nearbyEvalCacheTol << quantizedCacheFlag
+    << quantizedCacheSize << restartFileFlag
     << useWorkdir << workDir << dirTag << dirSave << linkFiles
     << copyFiles << templateReplace << pluginLibraryPath << numpyFlag;
 }
@@ -59,10 +63,12 @@ void DataInterfaceRep::read(MPIUnpackBuffer& s)
     >> resultsFileFormat >> fileTagFlag >> fileSaveFlag //>> gridHostNames >> gridProcsPerHost
     >> batchEvalFlag >> asynchFlag >> asynchLocalEvalConcurrency
     >> asynchLocalEvalScheduling >> asynchLocalAnalysisConcurrency
-    >> evalServers >> evalScheduling >> procsPerEval >> analysisServers
+    >> evalServers >> evalScheduling >> messageBatchFlag >> messageBatchSize
+    >> procsPerEval >> analysisServers
     >> analysisScheduling >> procsPerAnalysis >> failAction >> retryLimit
     >> recoveryFnVals >> activeSetVectorFlag >> evalCacheFlag
-    >> nearbyEvalCacheFlag >> nearbyEvalCacheTol >> restartFileFlag
+    >> nearbyEvalCacheFlag >> nearbyEvalCacheTol >> quantizedCacheFlag
+    >> quantizedCacheSize >> restartFileFlag
     >> useWorkdir >> workDir >> dirTag >> dirSave >> linkFiles
     >> copyFiles >> templateReplace >> pluginLibraryPath >> numpyFlag;
 }
@@ -76,10 +82,12 @@ void DataInterfaceRep::write(std::ostream& s) const
     << resultsFileFormat << fileTagFlag << fileSaveFlag //<< gridHostNames << gridProcsPerHost
     << batchEvalFlag << asynchFlag << asynchLocalEvalConcurrency
     << asynchLocalEvalScheduling << asynchLocalAnalysisConcurrency
-    << evalServers << evalScheduling << procsPerEval << analysisServers
+    << evalServers << evalScheduling << messageBatchFlag << messageBatchSize
+    << procsPerEval << analysisServers
     << analysisScheduling << procsPerAnalysis << failAction << retryLimit
     << recoveryFnVals << activeSetVectorFlag << evalCacheFlag
-    << nearbyEvalCacheFlag << nearbyEvalCacheTol << restartFileFlag
+    << nearbyEvalCacheFlag << nearbyEvalCacheTol << quantizedCacheFlag
+    << quantizedCacheSize << restartFileFlag
     << useWorkdir << workDir << dirTag << dirSave << linkFiles
     << copyFiles << templateReplace << pluginLibraryPath << numpyFlag;
 }
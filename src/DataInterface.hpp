@@ -170,6 +170,13 @@ public:
   /// within an iterator: {DEFAULT,MASTER,PEER_DYNAMIC,PEER_STATIC}_SCHEDULING 
   /// (from the \c evaluation_scheduling specification in \ref InterfIndControl)
   short evalScheduling;
+  /// flag for packing several evaluations into each message between a
+  /// dedicated master and its evaluation servers (from the \c
+  /// message_batching specification in \ref InterfIndControl)
+  bool messageBatchFlag;
+  /// maximum number of evaluations per message for message batching (from
+  /// the \c max_batch_size specification in \ref InterfIndControl)
+  int messageBatchSize;
   /// processors per parallel evaluation within the parallel configuration
   /// (from the \c processors_per_evaluation spec in \ref InterfIndControl)
   int procsPerEval;
@@ -208,6 +215,12 @@ public:
   bool nearbyEvalCacheFlag;
   /// numerical tolerance for nearby evaluation cache lookups
   Real nearbyEvalCacheTol;
+  /// flag enabling duplicate detection using a hashed, bounded index of
+  /// the evaluation cache (from the \c quantized_cache specification
+  /// in \ref InterfIndControl)
+  bool quantizedCacheFlag;
+  /// maximum number of entries in the quantized cache index (0 = unlimited)
+  int quantizedCacheSize;
   /// function evaluation cache: 1=active (all new evaluations written to
   /// restart), 0=inactive (no records written to restart) (from the
   /// \c deactivate \c restart_file specification in \ref InterfIndControl)
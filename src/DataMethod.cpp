@@ -124,6 +124,7 @@ DataMethodRep::DataMethodRep():
   fixedSequenceFlag(false), //default is variable sampling patterns
   vbdFlag(false),vbdDropTolerance(-1.),
   vbdViaSamplingMethod(VBD_PICK_AND_FREEZE),vbdViaSamplingNumBins(-1),
+  vbdBootstrapSamples(0),
   backfillFlag(false), pcaFlag(false),
   percentVarianceExplained(0.95), wilksFlag(false), wilksOrder(1),
   wilksConfidenceLevel(0.95), wilksSidedInterval(ONE_SIDED_UPPER),
@@ -185,10 +186,10 @@ DataMethodRep::DataMethodRep():
   numCandidates(0), maxHifiEvals(-1), batchSize(1), batchSizeExplore(0),
   // DREAM
   numChains(3), numCR(3), crossoverChainPairs(3), grThreshold(1.2),
-  jumpStep(5),
+  jumpStep(5), dreamBatchGenerations(false),
   generatePosteriorSamples(false), evaluatePosteriorDensity(false),
   // Wasabi
-  numPushforwardSamples(10000),
+  numPushforwardSamples(10000), pushforwardKDETol(0.),
   // Parameter Study
   numSteps(0), pstudyFileFormat(TABULAR_ANNOTATED), pstudyFileActive(false),
   // Verification
@@ -301,7 +302,7 @@ void DataMethodRep::write(MPIPackBuffer& s) const
   // NonD & DACE
   s << numSamples << fixedSeedFlag << fixedSequenceFlag
     << vbdFlag << vbdDropTolerance
-    << vbdViaSamplingMethod << vbdViaSamplingNumBins
+    << vbdViaSamplingMethod << vbdViaSamplingNumBins << vbdBootstrapSamples
     << backfillFlag << pcaFlag
     << percentVarianceExplained << wilksFlag << wilksOrder
     << wilksConfidenceLevel << wilksSidedInterval;
@@ -356,7 +357,8 @@ void DataMethodRep::write(MPIPackBuffer& s) const
     << importCandFormat << numCandidates << maxHifiEvals
     << batchSize << batchSizeExplore
     << mutualInfoKSG2 << numChains << numCR << crossoverChainPairs
-    << grThreshold << jumpStep << numPushforwardSamples
+    << grThreshold << jumpStep << dreamBatchGenerations
+    << numPushforwardSamples << pushforwardKDETol
     << dataDistType << dataDistCovInputType << dataDistMeans
     << dataDistCovariance << dataDistFile << posteriorDensityExportFilename
     << posteriorSamplesExportFilename << posteriorSamplesImportFilename
@@ -478,7 +480,7 @@ void DataMethodRep::read(MPIUnpackBuffer& s)
   // NonD & DACE
   s >> numSamples >> fixedSeedFlag >> fixedSequenceFlag
     >> vbdFlag >> vbdDropTolerance
-    >> vbdViaSamplingMethod >> vbdViaSamplingNumBins
+    >> vbdViaSamplingMethod >> vbdViaSamplingNumBins >> vbdBootstrapSamples
     >> backfillFlag >> pcaFlag
     >> percentVarianceExplained >> wilksFlag >> wilksOrder
     >> wilksConfidenceLevel >> wilksSidedInterval;
@@ -533,7 +535,8 @@ void DataMethodRep::read(MPIUnpackBuffer& s)
     >> importCandFormat >> numCandidates >> maxHifiEvals
     >> batchSize >> batchSizeExplore
     >> mutualInfoKSG2 >> numChains >> numCR >> crossoverChainPairs
-    >> grThreshold >> jumpStep >> numPushforwardSamples
+    >> grThreshold >> jumpStep >> dreamBatchGenerations
+    >> numPushforwardSamples >> pushforwardKDETol
     >> dataDistType >> dataDistCovInputType >> dataDistMeans
     >> dataDistCovariance >> dataDistFile >> posteriorDensityExportFilename
     >> posteriorSamplesExportFilename >> posteriorSamplesImportFilename
@@ -655,7 +658,7 @@ void DataMethodRep::write(std::ostream& s) const
   // NonD & DACE
   s << numSamples << fixedSeedFlag << fixedSequenceFlag
     << vbdFlag << vbdDropTolerance
-    << vbdViaSamplingMethod << vbdViaSamplingNumBins
+    << vbdViaSamplingMethod << vbdViaSamplingNumBins << vbdBootstrapSamples
     << backfillFlag << pcaFlag
     << percentVarianceExplained << wilksFlag << wilksOrder
     << wilksConfidenceLevel << wilksSidedInterval;
@@ -705,7 +708,8 @@ void DataMethodRep::write(std::ostream& s) const
     << importCandFormat << numCandidates << maxHifiEvals
     << batchSize << batchSizeExplore
     << mutualInfoKSG2 << numChains << numCR << crossoverChainPairs
-    << grThreshold << jumpStep << numPushforwardSamples
+    << grThreshold << jumpStep << dreamBatchGenerations
+    << numPushforwardSamples << pushforwardKDETol
     << dataDistType << dataDistCovInputType << dataDistMeans
     << dataDistCovariance << dataDistFile << posteriorDensityExportFilename
     << posteriorSamplesExportFilename << posteriorSamplesImportFilename
@@ -872,6 +872,9 @@ public:
   unsigned short vbdViaSamplingMethod;
   /// Number of bins to use in case the Mahadevan method is selected (default is the square root of the number of samples)
   int vbdViaSamplingNumBins;
+  /// Number of bootstrap resamples for confidence intervals on Sobol
+  /// indices computed by the pick-and-freeze method (0 for none)
+  int vbdBootstrapSamples;
   /// the \c backfill option allows one to augment in LHS sample
   /// by enforcing the addition of unique discrete variables to the sample
   bool backfillFlag;
@@ -1289,11 +1292,17 @@ public:
   Real grThreshold;
   /// how often to perform a long jump in generations
   int jumpStep;
+  /// evaluate the proposals of all chains in a generation as a batch
+  /// rather than one at a time through the DREAM core
+  bool dreamBatchGenerations;
 
   // WASABI sub-specification
   /// Number of samples from the prior that is pushed forward
   /// through the model to obtain the initial set of pushforward samples
   int numPushforwardSamples;
+  /// relative error tolerance of the kernel density estimate of the
+  /// pushforward responses (0 = exact, via Pecos)
+  Real pushforwardKDETol;
   /// the type of data distribution: kde, or gaussian
   String dataDistType;
   /// the format of data distribution gaussian covariance input:
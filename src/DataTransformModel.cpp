@@ -874,6 +874,8 @@ cache_submodel_responses(const IntResponseMap& sm_resp_map, bool deep_copy)
 void DataTransformModel::collect_residuals(bool collect_all)
 {
   recastResponseMap.clear();
+  // completed evals (and their variables) awaiting covariance scaling
+  std::vector<std::pair<int, Variables> > block_scaled;
 
   //BOOST_FOREACH(IntIntResponseMapMap::value_type& cr_pair, cachedResp) 
   IntIntResponseMapMap::iterator cr_pair = cachedResp.begin();
@@ -900,8 +902,20 @@ void DataTransformModel::collect_residuals(bool collect_all)
       recastResponseMap[recast_id] = currentResponse.copy();
       recastResponseMap[recast_id].active_set(s_it->second);
 
-      transform_response_map(cr_pair->second, v_it->second,
-                             recastResponseMap[recast_id]);
+      // defer the covariance scaling of value-only residuals, to scale
+      // all those completed together as a block
+      bool defer_scaling = expData.variance_active();
+      const ShortArray& asv = s_it->second.request_vector();
+      for (size_t i=0; defer_scaling && i<asv.size(); ++i)
+	if (asv[i] != 1)
+	  defer_scaling = false;
+      if (defer_scaling) {
+	form_residuals(cr_pair->second, recastResponseMap[recast_id]);
+	block_scaled.push_back(std::make_pair(recast_id, v_it->second));
+      }
+      else
+	transform_response_map(cr_pair->second, v_it->second,
+			       recastResponseMap[recast_id]);
 
       // cleanup (could do clear() at end)
       recastVarsMap.erase(v_it);
@@ -911,11 +925,55 @@ void DataTransformModel::collect_residuals(bool collect_all)
       // BMA TODO: consider iterator here instead of value?
       cr_pair++;      
       cachedResp.erase(recast_id);
-      print_residual_response(recastResponseMap[recast_id]);
+      if (!defer_scaling)
+	print_residual_response(recastResponseMap[recast_id]);
     } else {
       cr_pair++;
     }
   }
+
+  if (!block_scaled.empty())
+    scale_response_block(block_scaled);
+}
+
+
+/** Scaling by the error covariance is a triangular solve per
+    experiment; applying it to the residual values of all the evals at
+    once replaces a matrix-vector product per eval with a matrix-matrix
+    product. */
+void DataTransformModel::
+scale_response_block(const std::vector<std::pair<int, Variables> >& evals)
+{
+  size_t i, j, num_evals = evals.size(),
+    num_resid = expData.num_total_exppoints();
+  if (num_evals == 1) {
+    Response& residual_resp = recastResponseMap[evals[0].first];
+    scale_response(subModel.current_variables(), evals[0].second,
+		   residual_resp);
+    print_residual_response(residual_resp);
+    return;
+  }
+
+  RealMatrix resid_block(num_resid, num_evals, false);
+  for (j=0; j<num_evals; ++j) {
+    const RealVector& fn_vals
+      = recastResponseMap[evals[j].first].function_values();
+    for (i=0; i<num_resid; ++i)
+      resid_block(i,j) = fn_vals[i];
+  }
+
+  // scale by (error covariance)^{-1/2}
+  expData.scale_residuals(resid_block);
+
+  for (j=0; j<num_evals; ++j) {
+    Response& residual_resp = recastResponseMap[evals[j].first];
+    RealVector fn_vals = residual_resp.function_values_view();
+    for (i=0; i<num_resid; ++i)
+      fn_vals[i] = resid_block(i,j);
+    scale_response_multipliers(subModel.current_variables(), evals[j].second,
+			       residual_resp);
+    print_residual_response(residual_resp);
+  }
 }
 
 
@@ -925,6 +983,17 @@ void DataTransformModel::
 transform_response_map(const IntResponseMap& submodel_resp,
                        const Variables& recast_vars,
                        Response& residual_resp)
+{
+  form_residuals(submodel_resp, residual_resp);
+
+  // scale by covariance, including hyper-parameter multipliers
+  // BMA TODO: doesn't need submodel vars...
+  scale_response(subModel.current_variables(), recast_vars, residual_resp);
+}
+
+
+void DataTransformModel::
+form_residuals(const IntResponseMap& submodel_resp, Response& residual_resp)
 {
   size_t num_exp = expData.num_experiments();
   if (submodel_resp.size() != num_exp) {
@@ -935,10 +1004,6 @@ transform_response_map(const IntResponseMap& submodel_resp,
   IntRespMCIter sm_eval_it = submodel_resp.begin();
   for (size_t i=0; i<num_exp; ++i, ++sm_eval_it)
     expData.form_residuals(sm_eval_it->second, i, residual_resp);
-
-  // scale by covariance, including hyper-parameter multipliers
-  // BMA TODO: doesn't need submodel vars...
-  scale_response(subModel.current_variables(), recast_vars, residual_resp);
 }
 
 void DataTransformModel::
@@ -950,6 +1015,15 @@ scale_response(const Variables& submodel_vars,
   if (expData.variance_active())
     expData.scale_residuals(recast_response);
 
+  scale_response_multipliers(submodel_vars, recast_vars, recast_response);
+}
+
+
+void DataTransformModel::
+scale_response_multipliers(const Variables& submodel_vars,
+			   const Variables& recast_vars,
+			   Response& recast_response)
+{
   // TODO: may need to scale by hyperparameters in Covariance as well
   if (obsErrorMultiplierMode > CALIBRATE_NONE) {  
     // r <- r ./ mult, where mult might be per-block
@@ -147,6 +147,16 @@ protected:
 			      const Variables& recast_vars,
 			      Response& residual_resp) ;
 
+  /// difference a set of per-configuration subModel Responses with the
+  /// data, without scaling
+  void form_residuals(const IntResponseMap& submodel_resp,
+		      Response& residual_resp);
+
+  /// scale the value-only residuals of the listed evals (recast eval
+  /// id, recast variables) in recastResponseMap, as a block
+  void scale_response_block(const std::vector<std::pair<int, Variables> >&
+			    evals);
+
   // ---
   // Callback functions that perform data transform during the Recast operations
   // ---
@@ -177,6 +187,12 @@ protected:
 		      const Variables& recast_vars,
 		      Response& recast_response);
 
+  /// scale the populated residual response by any hyper-parameter
+  /// multipliers
+  void scale_response_multipliers(const Variables& submodel_vars,
+				  const Variables& recast_vars,
+				  Response& recast_response);
+
   // NOTE: Shouldn't need non-default active set or secondary response
   // recast; default based on indices should suffice.
 
@@ -717,24 +717,56 @@ void DigitalNet::unsafe_get_points(
     abort_handler(METHOD_ERROR);
   }
 
-  /// Iterativey generate all points up to `nMin-1`
-  UInt64Vector current_point(points.numRows()); /// Set to 0 by default
-  for ( size_t k = 0; k < nMin; k++ )
-  {
-    next(k, current_point);
-  }
-
-  /// Generate points between `nMin` and `nMax`
+  /// Generate contiguous blocks of points in parallel; each block jumps
+  /// directly to its first point and then iterates with `next`, so the
+  /// cost is proportional to the number of requested points only
   int digits = std::numeric_limits<UInt64>::digits;
   double oneOnPow2tScramble = 1 / Real(UInt64(1) << digits - 1) / 2; /// 1 / 2^(-tMax)
-  for ( UInt64 k = nMin; k < nMax; ++k ) /// Loop over all points
+  int dimension = points.numRows();
+  generate_blocks(nMin, nMax, dimension,
+    [&](const size_t kStart, const size_t kEnd)
+    {
+      UInt64Vector current_point(dimension);
+      jump(kStart, current_point); /// Point with index `kStart`
+      for ( UInt64 k = kStart; k < kEnd; ++k ) /// Loop over all points
+      {
+        if ( k > kStart )
+          next(k, current_point); /// Generate the next point as UInt64Vector
+        Real* point = points[(this->*reorder)(k) - nMin];
+        for ( int j = 0; j < dimension; j++ ) /// Loop over all dimensions
+        {
+          point[j] = 
+            (current_point[j] ^ digitalShift[j]) * oneOnPow2tScramble; // apply digital shift
+        }
+      }
+    }
+  );
+}
+
+/// Set `current_point` to the point with index `k` represented as an 
+/// unsigned integer vector
+/// NOTE: unrolling the recursion in `next`, the point with index `k` is the
+/// XOR of the columns of the generating matrices selected by the bits of the
+/// Gray code of `k`, i.e.,
+///
+///              x_{k}[j] = XOR_{n : bit n of gray(k) is 1} C[j][n]
+///
+/// which costs O(d log2(k)) instead of O(d k) for iterating from index 0
+void DigitalNet::jump(
+  UInt64 k,
+  UInt64Vector& current_point
+)
+{
+  current_point.putScalar(0);
+  UInt64 g = binary2gray(k);
+  for ( int n = 0; g; ++n, g >>= 1 ) // Loop over bits of the Gray code
   {
-    next(k, current_point); /// Generate the next point as UInt64Vector
-    auto idx = (this->*reorder)(k);
-    for ( int j = 0; j < points.numRows(); j++ ) /// Loop over all dimensions
+    if ( g & 1 )
     {
-      points(j, idx - nMin) = 
-        (current_point[j] ^ digitalShift[j]) * oneOnPow2tScramble; // apply digital shift
+      for ( size_t j = 0; j < current_point.length(); j++ ) // Loop over dimensions
+      {
+        current_point[j] ^= scrambledGeneratingMatrices(j, n); // ^ is xor
+      }
     }
   }
 }
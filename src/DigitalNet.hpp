@@ -170,6 +170,13 @@ private:
     RealMatrix& points
   );
 
+  /// Jump directly to the point with index `k` of the sequence represented
+  /// as an unsigned integer vector
+  void jump(
+    UInt64 k,
+    UInt64Vector& current_point
+  );
+
   /// Get the next point of the sequence represented as an unsigned integer
   /// vector
   void next(
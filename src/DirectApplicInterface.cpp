@@ -274,68 +274,87 @@ int DirectApplicInterface::derived_map_of(const String& of_name)
 }
 
 
+/** Asynchronous evaluations are executed concurrently on the worker
+    threads of evalThreadPool, which requires a derived interface that
+    declares itself thread_safe().  Batches are evaluated as a unit
+    within wait_local_evaluations(). */
 void DirectApplicInterface::derived_map_asynch(const ParamResponsePair& pair)
 {
-  Cerr << "Error: asynchronous capability (multiple threads) not installed in"
-       << "\nDirectApplicInterface." << std::endl;
-  abort_handler(-1);
-
-  //pthread_create/thr_create(derived_map(...)) launches a new thread
-  //threadIdMap[tid] = fn_eval_id;
-
-  // Design note, 10/2013: the heavy fork() approach that already exists in
-  // ProcessHandleApplicInterface::create_evaluation_process() would be a
-  // quick and easy substitute for POSIX threads.  While this would work
-  // nicely for managing job concurrency with code that's already in hand
-  // (assuming sufficient memory for the required heavy fork() concurrency),
-  // there is no simple way to get response results back to the parent
-  // process from the child.  Short of resorting to the file system, there
-  // are examples of using pipes to accomplish this, but this moves the
-  // idea away from the state of low risk / high payoff.
+  if (batchEval)
+    return;
+  check_thread_safety();
+  launch_threaded_evaluation(pair,
+    [this](const Variables& vars, const ActiveSet& set, Response& response,
+	   int fn_eval_id, size_t thread_index)
+    { derived_map_threaded(vars, set, response, fn_eval_id, thread_index); });
 }
 
 
 void DirectApplicInterface::wait_local_evaluations(PRPQueue& prp_queue)
 {
-  Cerr << "Error: asynchronous capability (multiple threads) not installed in"
-       << "\nDirectApplicInterface." << std::endl;
-  abort_handler(-1);
-
-  /*
-  PRPQueueIter queue_it = lookup_by_eval_id(prp_queue, fn_eval_id);
-  if (queue_it == prp_queue.end()) {
-    Cerr << "Error: failure in queue lookup within DirectApplicInterface::"
-	 << "wait_local_evaluations()." << std::endl;
-    abort_handler(-1);
-  }
-  int fail_code = 0, id = queue_it->eval_id();
-  Variables    vars = queue_it->variables(); // shallow copy
-  Response response = queue_it->response();  // shallow copy
-
-  // pthread_join/thr_join(target_thread, ..., status) recovers threads.
-  // status provides a mechanism to return failure codes from analyses.
-  // The Solaris thr_join allows completion of any thread in the set if 
-  // target_thread is set to 0; unfortunately, this does not appear to be part
-  // of the POSIX standard (pthread_join must complete a valid target_thread).
-
-  // Possible better solution: look at OpenMP ??
-
-  // For the asynch case, Direct (unlike SysCall) can manage failures w/o 
-  // throwing exceptions.  See ApplicationInterface::manage_failure for notes.
-  if (fail_code)
-    manage_failure(vars, response.active_set(), response, id);
-
-  Cout << "Thread for evaluation " << id << " captured.\n";
-  queue_it->response(response);
-  */
+  if (batchEval)
+    { batch_evaluations(prp_queue); return; }
+  check_thread_safety();
+  collect_threaded_evaluations(prp_queue, true);
 }
 
 
 void DirectApplicInterface::test_local_evaluations(PRPQueue& prp_queue)
 {
-  Cerr << "Error: asynchronous capability (multiple threads) not installed in"
-       << "\nDirectApplicInterface." << std::endl;
-  abort_handler(-1);
+  if (batchEval)
+    { batch_evaluations(prp_queue); return; }
+  check_thread_safety();
+  collect_threaded_evaluations(prp_queue, false);
+}
+
+
+void DirectApplicInterface::batch_evaluations(PRPQueue& prp_queue)
+{
+  PRPQueueIter it;
+  if (batchEvaluation.pack(prp_queue)) {
+    bool batch_mapped;
+    try { batch_mapped = derived_map_batch(batchEvaluation); }
+    catch(const FunctionEvalFailure& fneval_except) {
+      // a failed batch call has no per-evaluation results
+      for (it=prp_queue.begin(); it!=prp_queue.end(); ++it) {
+	Response response = it->response(); // shallow copy
+	manage_failure(it->variables(), response.active_set(), response,
+		       it->eval_id());
+	completionSet.insert(it->eval_id());
+      }
+      return;
+    }
+    if (batch_mapped) {
+      batchEvaluation.unpack(prp_queue);
+      for (it=prp_queue.begin(); it!=prp_queue.end(); ++it)
+	completionSet.insert(it->eval_id());
+      return;
+    }
+  }
+
+  // no batch support (or nonuniform batch): evaluate one at a time
+  for (it=prp_queue.begin(); it!=prp_queue.end(); ++it) {
+    int fn_eval_id = it->eval_id();
+    Response response = it->response(); // shallow copy
+    try
+      { derived_map(it->variables(), it->active_set(), response, fn_eval_id); }
+    catch(const FunctionEvalFailure& fneval_except) {
+      manage_failure(it->variables(), response.active_set(), response,
+		     fn_eval_id);
+    }
+    completionSet.insert(fn_eval_id);
+  }
+}
+
+
+void DirectApplicInterface::check_thread_safety() const
+{
+  if (!thread_safe()) {
+    Cerr << "Error: asynchronous capability (multiple threads) not supported "
+	 << "by " << interface_enum_to_string(interfaceType)
+	 << "\ninterface, which is not thread-safe." << std::endl;
+    abort_handler(-1);
+  }
 }
 
 
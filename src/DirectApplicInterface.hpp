@@ -11,6 +11,7 @@
 #define DIRECT_APPLIC_INTERFACE_H
 
 #include "ApplicationInterface.hpp"
+#include "BatchEvaluation.hpp"
 //#ifndef OSF
 //#include <pthread.h>
 //#endif
@@ -113,6 +114,23 @@ protected:
   /// execute the output filter portion of a direct evaluation invocation
   virtual int derived_map_of(const Dakota::String& of_name);
 
+  /// whether derived_map() may be invoked concurrently from multiple
+  /// threads, enabling asynchronous local evaluations on evalThreadPool.
+  /// Derived interfaces may only return true if their derived_map() does
+  /// not use the class-scope evaluation data below (xC, fnVals, etc.).
+  virtual bool thread_safe() const;
+  /// perform an asynchronous evaluation on the worker thread with index
+  /// thread_index (for selecting per-thread scratch data); defaults to
+  /// derived_map()
+  virtual void derived_map_threaded(const Variables& vars,
+				    const ActiveSet& set, Response& response,
+				    int fn_eval_id, size_t thread_index);
+  /// evaluate a whole batch in one call from the contiguous input data
+  /// of batch into its preallocated output arrays; returns false if
+  /// batch evaluation is not supported (default), in which case the
+  /// evaluations are performed one at a time with derived_map()
+  virtual bool derived_map_batch(BatchEvaluation& batch);
+
   //
   //- Heading: Methods
   //
@@ -217,6 +235,9 @@ protected:
   /// the index of the active analysis driver within analysisDrivers
   size_t analysisDriverIndex;
 
+  /// contiguous storage for batch evaluations
+  BatchEvaluation batchEvaluation;
+
 private:
 
   //
@@ -227,6 +248,14 @@ private:
   void map_labels_to_enum(StringMultiArrayConstView &src,
       std::vector<var_t> &dest);
 
+  /// abort if asynchronous evaluations are requested from an interface
+  /// that is not thread_safe()
+  void check_thread_safety() const;
+
+  /// evaluate the jobs of prp_queue as a batch, using derived_map_batch()
+  /// if supported
+  void batch_evaluations(PRPQueue& prp_queue);
+
   //
   //- Heading: Data
   //
@@ -251,14 +280,31 @@ inline const StringArray& DirectApplicInterface::analysis_drivers() const
 { return analysisDrivers; }
 
 
+inline bool DirectApplicInterface::thread_safe() const
+{ return false; }
+
+
+inline bool DirectApplicInterface::derived_map_batch(BatchEvaluation& batch)
+{ return false; }
+
+
+inline void DirectApplicInterface::
+derived_map_threaded(const Variables& vars, const ActiveSet& set,
+		     Response& response, int fn_eval_id, size_t thread_index)
+{ derived_map(vars, set, response, fn_eval_id); }
+
+
 /** Process init issues as warnings since some contexts (e.g.,
     EnsembleSurrModel) initialize more configurations than will be
-    used and DirectApplicInterface allows override by derived plug-ins. */
+    used and DirectApplicInterface allows override by derived plug-ins.
+    Asynchronous local evaluations are supported by thread-safe
+    interfaces, and batch evaluations by all interfaces. */
 inline void DirectApplicInterface::
 init_communicators_checks(int max_eval_concurrency)
 {
   bool warn = true;
-  check_asynchronous(warn, max_eval_concurrency);
+  if (!thread_safe() && !batchEval)
+    check_asynchronous(warn, max_eval_concurrency);
   check_multiprocessor_asynchronous(warn, max_eval_concurrency);
 }
 
@@ -267,7 +313,9 @@ init_communicators_checks(int max_eval_concurrency)
 inline void DirectApplicInterface::
 set_communicators_checks(int max_eval_concurrency)
 {
-  bool warn = false,  mp1 = check_asynchronous(warn, max_eval_concurrency),
+  bool warn = false,
+       mp1 = !thread_safe() && !batchEval &&
+             check_asynchronous(warn, max_eval_concurrency),
        mp2 = check_multiprocessor_asynchronous(warn, max_eval_concurrency);
   if (mp1 || mp2)
     abort_handler(-1);
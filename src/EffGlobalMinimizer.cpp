@@ -514,7 +514,16 @@ append_liar(const Variables& vars_star, int liar_id, bool rebuild)
     Cout << "\nParallel EGO: appending liar response for evaluation "
 	 << liar_id << ".\n";
   IntResponsePair liar_resp_pr(liar_id, fhat_resp_star);
+  // > liar data should not inform the hyperparameters: hold them fixed so
+  //   that GPs supporting it update their factorization incrementally.
+  //   Truth data appended in evaluate_batch() triggers a full rebuild.
+  std::vector<Approximation>& approxs = fHatModel.approximations();
+  size_t i, num_approx = approxs.size();
+  for (i=0; i<num_approx; ++i)
+    approxs[i].freeze_hyperparameters(true);
   fHatModel.append_approximation(vars_star, liar_resp_pr, rebuild);
+  for (i=0; i<num_approx; ++i)
+    approxs[i].freeze_hyperparameters(false);
   //numDataPts = fHatModel.approximation_data(0).points(); // updated count
 }
 
@@ -24,6 +24,7 @@
 #include "dakota_data_types.hpp"
 #include "dakota_results_types.hpp"
 #include "MarginalsCorrDistribution.hpp"
+#include "TraceProfiler.hpp"
 
 namespace Dakota {
 
@@ -247,6 +248,7 @@ void EvaluationStore::store_model_variables(const String &model_id, const String
 #ifdef DAKOTA_HAVE_HDF5
   if(!active())
     return;
+  TraceScope trace_scope("store_model_variables", "evaluation_store", eval_id);
   const DefaultSet &default_set_s = modelDefaultSets[model_id];
   if(set.request_vector().size() != default_set_s.numFunctions) {
     if(resizedModels.find(model_id) == resizedModels.end()) {
@@ -260,6 +262,11 @@ void EvaluationStore::store_model_variables(const String &model_id, const String
   }
   resizedModels.erase(model_id);
   String root_group = create_model_root(model_id, model_type);
+  if(evalBufferSize > 1) {
+    int resp_idx = stage_variables(root_group, eval_id, set, variables, default_set_s);
+    modelResponseIndexCache.emplace(std::make_tuple(model_id, eval_id), resp_idx);
+    return;
+  }
   String scale_root = create_scale_root(root_group);
   // Create evaluation ID dataset, which is attached as a scale to many datasets
   String eval_ids_scale = scale_root + "evaluation_ids";
@@ -288,14 +295,19 @@ void EvaluationStore::store_model_response(const String &model_id, const String
 #ifdef DAKOTA_HAVE_HDF5
   if(!active())
     return;
+  TraceScope trace_scope("store_model_response", "evaluation_store", eval_id);
   const DefaultSet &default_set_s = modelDefaultSets[model_id];
   std::tuple<String, int> key(model_id, eval_id);
   int response_index = modelResponseIndexCache[key];
   if(response_index == -1)
     return;
   String root_group = create_model_root(model_id, model_type);
-  store_response(root_group, response_index, response, default_set_s);
-  store_metadata(root_group, response_index, response);
+  if(evalBufferSize > 1)
+    stage_response(root_group, response_index, response, default_set_s);
+  else {
+    store_response(root_group, response_index, response, default_set_s);
+    store_metadata(root_group, response_index, response);
+  }
   auto cache_entry = modelResponseIndexCache.find(key);
   modelResponseIndexCache.erase(cache_entry);
 #else
@@ -309,10 +321,16 @@ void EvaluationStore::store_interface_variables(const String &model_id, const St
 #ifdef DAKOTA_HAVE_HDF5
   if(!active())
     return;
+  TraceScope trace_scope("store_interface_variables", "evaluation_store", eval_id);
   String root_group = create_interface_root(model_id, interface_id);
-  String scale_root = create_scale_root(root_group);
   const auto set_key = std::make_pair(model_id, interface_id);
   const DefaultSet &default_set_s = interfaceDefaultSets[set_key];
+  if(evalBufferSize > 1) {
+    int resp_idx = stage_variables(root_group, eval_id, set, variables, default_set_s);
+    interfaceResponseIndexCache.emplace(std::make_tuple(model_id, interface_id, eval_id), resp_idx);
+    return;
+  }
+  String scale_root = create_scale_root(root_group);
   // Create evaluation ID dataset, which is attached as a scale to many datasets
   String eval_ids_scale = scale_root + "evaluation_ids";
   hdf5Stream->append_scalar(eval_ids_scale, eval_id);
@@ -338,11 +356,17 @@ void EvaluationStore::store_interface_response(const String &model_id, const Str
 #ifdef DAKOTA_HAVE_HDF5
   if(!active())
     return;
+  TraceScope trace_scope("store_interface_response", "evaluation_store", eval_id);
   std::tuple<String, String, int> key(model_id, interface_id, eval_id);
   int response_index = interfaceResponseIndexCache[key];
   String root_group = create_interface_root(model_id, interface_id);
-  store_response(root_group, response_index, response, interfaceDefaultSets[std::make_pair(model_id, interface_id)]);
-  store_metadata(root_group, response_index, response);
+  const DefaultSet &default_set_s = interfaceDefaultSets[std::make_pair(model_id, interface_id)];
+  if(evalBufferSize > 1)
+    stage_response(root_group, response_index, response, default_set_s);
+  else {
+    store_response(root_group, response_index, response, default_set_s);
+    store_metadata(root_group, response_index, response);
+  }
   auto cache_entry = interfaceResponseIndexCache.find(key);
   interfaceResponseIndexCache.erase(cache_entry);
 #else
@@ -350,6 +374,26 @@ void EvaluationStore::store_interface_response(const String &model_id, const Str
 #endif
 }
 
+void EvaluationStore::buffer_evaluations(const int &buffer_size, const int &flush_interval) {
+  flush();
+  evalBufferSize = buffer_size;
+  evalBufferFlushInterval = flush_interval;
+}
+
+void EvaluationStore::flush() {
+#ifdef DAKOTA_HAVE_HDF5
+  if(!active() || evaluationBuffers.empty())
+    return;
+  TraceScope trace_scope("flush", "evaluation_store");
+  for(auto &b : evaluationBuffers)
+    flush_buffer(b.first, b.second);
+  hdf5Stream->trim_reserved_layers();
+  hdf5Stream->flush();
+#else
+  return;
+#endif
+}
+
 String EvaluationStore::create_interface_root(const String &model_id, const String &interface_id) {
   return String("/interfaces/") + interface_id + '/' + model_id + '/';
 }
@@ -1949,7 +1993,7 @@ void EvaluationStore::store_variables(const String &root_group, const Variables
 }
 
 void EvaluationStore::store_response(const String &root_group, const int &resp_idx, 
-    const Response &response, const DefaultSet &default_set_s) {
+    const Response &response, const DefaultSet &default_set_s, const bool store_functions) {
 #ifdef DAKOTA_HAVE_HDF5
   String response_root = root_group + "responses/";
   const ActiveSet &set = response.active_set();
@@ -1960,7 +2004,7 @@ void EvaluationStore::store_response(const String &root_group, const int &resp_i
   const size_t num_default_deriv_vars = default_set_s.set.derivative_vector().size();
   const SizetArray &default_dvv = default_set_s.set.derivative_vector();
   // function values
-  bool has_functions = bool(default_set_s.numFunctions); 
+  bool has_functions = store_functions && bool(default_set_s.numFunctions); 
   String functions_name = response_root + "functions";
   if(has_functions) { 
     // because of NaN fill value, we have to do some legwork. If all of the function
@@ -2078,36 +2122,223 @@ void EvaluationStore::store_properties(const String &root_group, const ActiveSet
 #ifdef DAKOTA_HAVE_HDF5
   String properties_root = root_group + "properties/";
   hdf5Stream->append_vector(properties_root + "active_set_vector", set.request_vector());
-  // DVV. The dvv in set may be shorter than the default one, and so it has to be properties  // by ID.
-  const SizetArray &default_dvv = default_set_s.set.derivative_vector();
-  const ShortArray &default_asv = default_set_s.set.request_vector();
   // The DVV dataset doesn't exist unless gradients or hessians can be provided
   if(default_set_s.numGradients || default_set_s.numHessians) {
-    const SizetArray &dvv = set.derivative_vector();
-    // vector that will be apppended to the dataset. "bits" defaulted to 0 ("off")
-    IntArray dvv_row(default_dvv.size(), 0);
-    // Most of the time, all possible derivative variables will be "active" (the lengths of the 
-    // current and default DVV will match), so we don't need to examine the DVV entry by entry.
-    if(dvv.size() == default_dvv.size())
-      std::fill(dvv_row.begin(), dvv_row.end(), 1);
-    else {
-      // This logic assumes that the entries in dvv and default_dvv are sorted in ascending order.
-      // It iterates over the entries of the current dvv, and for each, advances through the default
-      // dvv until the entry is found. It then sets the bit for that entry and goes to the next one
-      // in the current dvv.
-      int di = 0;
-      for(int si = 0; si < dvv.size(); ++si) {
-        for(; di < default_dvv.size(); ++di) {
-          if(dvv[si] == default_dvv[di]) {
-            dvv_row[di] = 1;
-            ++di;
-            break;
-          }
+    IntArray dvv_row;
+    derivative_variables_row(set, default_set_s, dvv_row);
+    hdf5Stream->append_vector(properties_root + "derivative_variables_vector", dvv_row);
+  }
+  return;
+#endif
+}
+
+void EvaluationStore::derivative_variables_row(const ActiveSet &set,
+    const DefaultSet &default_set_s, IntArray &dvv_row) {
+  // DVV. The dvv in set may be shorter than the default one, and so it has to be stored
+  // by ID.
+  const SizetArray &default_dvv = default_set_s.set.derivative_vector();
+  const SizetArray &dvv = set.derivative_vector();
+  // "bits" defaulted to 0 ("off")
+  dvv_row.assign(default_dvv.size(), 0);
+  // Most of the time, all possible derivative variables will be "active" (the lengths of the 
+  // current and default DVV will match), so we don't need to examine the DVV entry by entry.
+  if(dvv.size() == default_dvv.size())
+    std::fill(dvv_row.begin(), dvv_row.end(), 1);
+  else {
+    // This logic assumes that the entries in dvv and default_dvv are sorted in ascending order.
+    // It iterates over the entries of the current dvv, and for each, advances through the default
+    // dvv until the entry is found. It then sets the bit for that entry and goes to the next one
+    // in the current dvv.
+    int di = 0;
+    for(int si = 0; si < dvv.size(); ++si) {
+      for(; di < default_dvv.size(); ++di) {
+        if(dvv[si] == default_dvv[di]) {
+          dvv_row[di] = 1;
+          ++di;
+          break;
         }
       }
     }
-    hdf5Stream->append_vector(properties_root + "derivative_variables_vector", dvv_row);
   }
+}
+
+/// Append variables, evaluation ID, and properties for an evaluation to the
+/// in-memory buffer for root_group. The returned index is the row that the
+/// evaluation will occupy once the buffer has been flushed.
+int EvaluationStore::stage_variables(const String &root_group, const int &eval_id,
+    const ActiveSet &set, const Variables &variables, const DefaultSet &default_set_s) {
+#ifdef DAKOTA_HAVE_HDF5
+  EvaluationBuffer &buffer = evaluationBuffers[root_group];
+  if(!buffer.numRows)
+    buffer.firstStaged = std::chrono::steady_clock::now();
+  buffer.defaultSet = &default_set_s;
+  buffer.evalIds.push_back(eval_id);
+  const RealVector &acv = variables.all_continuous_variables();
+  buffer.continuousVars.insert(buffer.continuousVars.end(),
+      acv.values(), acv.values() + acv.length());
+  const IntVector &adiv = variables.all_discrete_int_variables();
+  buffer.discreteIntVars.insert(buffer.discreteIntVars.end(),
+      adiv.values(), adiv.values() + adiv.length());
+  StringMultiArrayConstView adsv = variables.all_discrete_string_variables();
+  buffer.discreteStringVars.insert(buffer.discreteStringVars.end(),
+      adsv.begin(), adsv.end());
+  const RealVector &adrv = variables.all_discrete_real_variables();
+  buffer.discreteRealVars.insert(buffer.discreteRealVars.end(),
+      adrv.values(), adrv.values() + adrv.length());
+  const ShortArray &asv = set.request_vector();
+  buffer.asvRows.insert(buffer.asvRows.end(), asv.begin(), asv.end());
+  size_t num_dvv_ints = 0;
+  if(default_set_s.numGradients || default_set_s.numHessians) {
+    IntArray dvv_row;
+    derivative_variables_row(set, default_set_s, dvv_row);
+    buffer.dvvRows.insert(buffer.dvvRows.end(), dvv_row.begin(), dvv_row.end());
+    num_dvv_ints = dvv_row.size();
+  }
+  buffer.numBytes += sizeof(int) + sizeof(Real)*(acv.length() + adrv.length()) +
+    sizeof(int)*(adiv.length() + num_dvv_ints) + sizeof(short)*asv.size() +
+    sizeof(String)*adsv.size();
+  int resp_idx = buffer.firstRow + buffer.numRows++;
+  check_flush(root_group, buffer);
+  return resp_idx;
+#else
+  return -1;
+#endif
+}
+
+/// Responses that belong to evaluations that are still staged are kept in
+/// the buffer and written when it is flushed. The rows of all other
+/// responses already exist in the database, and they are stored immediately.
+void EvaluationStore::stage_response(const String &root_group, const int &resp_idx,
+    const Response &response, const DefaultSet &default_set_s) {
+#ifdef DAKOTA_HAVE_HDF5
+  auto b_it = evaluationBuffers.find(root_group);
+  if(b_it == evaluationBuffers.end() || resp_idx < b_it->second.firstRow) {
+    store_response(root_group, resp_idx, response, default_set_s);
+    store_metadata(root_group, resp_idx, response);
+    return;
+  }
+  EvaluationBuffer &buffer = b_it->second;
+  // deep copy; the caller is free to reuse the response
+  buffer.responses[resp_idx] = response.copy();
+  const ActiveSet &set = response.active_set();
+  buffer.numBytes += sizeof(Real)*(response.num_functions() + response.metadata().size() +
+    set.derivative_vector().size()*(default_set_s.numGradients +
+    set.derivative_vector().size()*default_set_s.numHessians));
+  check_flush(root_group, buffer);
+#else
+  return;
+#endif
+}
+
+/// Upper limit on the memory footprint of an evaluation buffer
+const size_t EVAL_BUFFER_MAX_BYTES = 64*1024*1024;
+
+void EvaluationStore::check_flush(const String &root_group, EvaluationBuffer &buffer) {
+  if(buffer.numRows >= evalBufferSize || buffer.numBytes >= EVAL_BUFFER_MAX_BYTES)
+    flush_buffer(root_group, buffer);
+  flush_expired();
+}
+
+/// There is no timer: the age of the staged data is checked when an
+/// evaluation is stored for any model or interface, so evaluations staged
+/// after the last one of a method wait for the flush at its end.
+void EvaluationStore::flush_expired() {
+  if(evalBufferFlushInterval <= 0)
+    return;
+  auto now = std::chrono::steady_clock::now();
+  for(auto &b : evaluationBuffers)
+    if(b.second.numRows &&
+       now - b.second.firstStaged >= std::chrono::seconds(evalBufferFlushInterval))
+      flush_buffer(b.first, b.second);
+}
+
+/// Each evaluation dataset for root_group is extended once by the number
+/// of staged evaluations, and the staged rows are written as a block.
+/// Function values and metadata of staged responses are written as blocks
+/// too; gradients and Hessians are written per evaluation because of the
+/// bookkeeping needed for mixed sets.
+void EvaluationStore::flush_buffer(const String &root_group, EvaluationBuffer &buffer) {
+#ifdef DAKOTA_HAVE_HDF5
+  const int num_rows = buffer.numRows;
+  if(!num_rows)
+    return;
+  const DefaultSet &default_set_s = *buffer.defaultSet;
+  String scale_root = create_scale_root(root_group);
+  String variables_root = root_group + "variables/";
+  String properties_root = root_group + "properties/";
+  String response_root = root_group + "responses/";
+
+  hdf5Stream->append_scalars(scale_root + "evaluation_ids", buffer.evalIds);
+  if(!buffer.continuousVars.empty())
+    hdf5Stream->append_vectors(variables_root + "continuous",
+        buffer.continuousVars, num_rows);
+  if(!buffer.discreteIntVars.empty())
+    hdf5Stream->append_vectors(variables_root + "discrete_integer",
+        buffer.discreteIntVars, num_rows);
+  if(!buffer.discreteStringVars.empty())
+    hdf5Stream->append_vectors(variables_root + "discrete_string",
+        buffer.discreteStringVars, num_rows);
+  if(!buffer.discreteRealVars.empty())
+    hdf5Stream->append_vectors(variables_root + "discrete_real",
+        buffer.discreteRealVars, num_rows);
+  hdf5Stream->append_vectors(properties_root + "active_set_vector",
+      buffer.asvRows, num_rows);
+  if(default_set_s.numGradients || default_set_s.numHessians)
+    hdf5Stream->append_vectors(properties_root + "derivative_variables_vector",
+        buffer.dvvRows, num_rows);
+
+  const int first_row = hdf5Stream->append_empty(response_root + "functions", num_rows);
+  if(default_set_s.numGradients)
+    hdf5Stream->append_empty(response_root + "gradients", num_rows);
+  if(default_set_s.numHessians)
+    hdf5Stream->append_empty(response_root + "hessians", num_rows);
+  if(default_set_s.numMetadata)
+    hdf5Stream->append_empty(root_group + "metadata", num_rows);
+
+  if(!buffer.responses.empty()) {
+    // Rows without a response (yet) and functions that were not requested
+    // keep the NaN fill value.
+    const size_t num_fns = default_set_s.numFunctions,
+      num_md = default_set_s.numMetadata;
+    RealArray fn_block(num_rows*num_fns, REAL_DSET_FILL_VAL),
+      md_block(num_rows*num_md, REAL_DSET_FILL_VAL);
+    bool any_derivs = false;
+    for(const auto &r : buffer.responses) {
+      const size_t row = r.first - buffer.firstRow;
+      const Response &response = r.second;
+      const ShortArray &asv = response.active_set().request_vector();
+      const RealVector &f = response.function_values();
+      if(asv.size() == num_fns)
+        for(size_t i = 0; i < num_fns; ++i)
+          if(asv[i] & 1) fn_block[row*num_fns + i] = f[i];
+      const std::vector<RespMetadataT> &md = response.metadata();
+      if(md.size() == num_md)
+        std::copy(md.begin(), md.end(), md_block.begin() + row*num_md);
+      if(std::any_of(asv.begin(), asv.end(), [](const short &a){return a & 6;}))
+        any_derivs = true;
+    }
+    if(num_fns)
+      hdf5Stream->set_vectors(response_root + "functions", fn_block, first_row, num_rows);
+    if(num_md)
+      hdf5Stream->set_vectors(root_group + "metadata", md_block, first_row, num_rows);
+    if(any_derivs)
+      for(const auto &r : buffer.responses)
+        store_response(root_group, r.first, r.second, default_set_s,
+            false /* functions already stored */);
+  }
+
+  buffer.firstRow += num_rows;
+  buffer.numRows = 0;
+  buffer.numBytes = 0;
+  buffer.evalIds.clear();
+  buffer.continuousVars.clear();
+  buffer.discreteIntVars.clear();
+  buffer.discreteStringVars.clear();
+  buffer.discreteRealVars.clear();
+  buffer.asvRows.clear();
+  buffer.dvvRows.clear();
+  buffer.responses.clear();
+#else
   return;
 #endif
 }
@@ -12,7 +12,9 @@
 
 #include <memory>
 #include <set>
+#include <chrono>
 #include "DakotaActiveSet.hpp"
+#include "DakotaResponse.hpp"
 #include "dakota_data_types.hpp"
 #include "MultivariateDistribution.hpp"
 #include "MarginalsCorrDistribution.hpp"
@@ -42,6 +44,38 @@ struct DefaultSet {
     DefaultSet() {};
 };
 
+/// Evaluations staged in memory for one model or interface+model root group
+/// when buffered storage is active. On flush, each dataset is extended once
+/// and the staged rows are written with a single hyperslab selection.
+struct EvaluationBuffer {
+    /// dataset row that the first staged evaluation will occupy
+    int firstRow = 0;
+    /// number of staged evaluations
+    int numRows = 0;
+    /// default set for the model or interface that owns the buffer
+    const DefaultSet *defaultSet = NULL;
+    /// staged evaluation ids
+    IntArray evalIds;
+    /// staged continuous variables (row-major)
+    RealArray continuousVars;
+    /// staged discrete integer variables (row-major)
+    IntArray discreteIntVars;
+    /// staged discrete string variables (row-major)
+    StringArray discreteStringVars;
+    /// staged discrete real variables (row-major)
+    RealArray discreteRealVars;
+    /// staged active set vectors (row-major)
+    ShortArray asvRows;
+    /// staged derivative variables vector indicators (row-major)
+    IntArray dvvRows;
+    /// responses that completed while their variables were staged, keyed by row
+    std::map<int, Response> responses;
+    /// approximate memory footprint of the staged data in bytes
+    size_t numBytes = 0;
+    /// time at which the first currently staged evaluation arrived
+    std::chrono::steady_clock::time_point firstStaged;
+};
+
 class EvaluationStore {
   public:
 #ifdef DAKOTA_HAVE_HDF5
@@ -88,6 +122,19 @@ class EvaluationStore {
     void store_interface_response(const String &model_id, const String &interface_id, 
                                 const int &eval_id, const Response &response);
 
+    /// Enable buffered storage. Up to buffer_size evaluations per model or
+    /// interface are staged in memory and written as a block. Staged data also
+    /// are written once they are older than flush_interval seconds (0 disables
+    /// the time threshold) or exceed an internal size limit. The age is
+    /// checked lazily, whenever an evaluation is stored, and everything
+    /// staged is written by flush() at the end of each method. A buffer_size
+    /// of 1 or less restores unbuffered storage.
+    void buffer_evaluations(const int &buffer_size, const int &flush_interval);
+
+    /// Write all staged evaluations to the database and release the rows
+    /// reserved beyond them in its datasets
+    void flush();
+
   private:
 
     /// Create the mapping from variable type to description
@@ -189,9 +236,11 @@ class EvaluationStore {
     /// Store variables
     void store_variables(const String &root_group, const Variables &variables);
 
-    /// Store response
+    /// Store response. Function values are omitted when store_functions is false
+    /// (they were already written as part of a block).
     void store_response(const String &root_group, const int &resp_idx, 
-        const Response &response, const DefaultSet &default_set_s);
+        const Response &response, const DefaultSet &default_set_s,
+        const bool store_functions = true);
 
     /// Store properties information (ASV, DVV, analysis components, distribution parameters)
     void store_properties(const String &root_group, const ActiveSet &set, 
@@ -200,6 +249,28 @@ class EvaluationStore {
     /// Store metadata
     void store_metadata(const String &root_group, const int &resp_idx, const Response &response);
 
+    /// Compute the row that is stored in the derivative_variables_vector dataset
+    void derivative_variables_row(const ActiveSet &set, const DefaultSet &default_set_s,
+        IntArray &dvv_row);
+
+    /// Stage variables and properties for an evaluation and return its row index
+    int stage_variables(const String &root_group, const int &eval_id, const ActiveSet &set,
+        const Variables &variables, const DefaultSet &default_set_s);
+
+    /// Stage or store a response, depending on whether its row has been written
+    void stage_response(const String &root_group, const int &resp_idx,
+        const Response &response, const DefaultSet &default_set_s);
+
+    /// Write the buffer if its size thresholds have been reached, and any
+    /// buffer whose oldest evaluation exceeds the flush interval
+    void check_flush(const String &root_group, EvaluationBuffer &buffer);
+
+    /// Write each buffer whose oldest evaluation exceeds the flush interval
+    void flush_expired();
+
+    /// Write the staged evaluations for root_group to the database
+    void flush_buffer(const String &root_group, EvaluationBuffer &buffer);
+
     /// Return true if the model is active
     bool model_active(const String &model_id);
 
@@ -232,6 +303,14 @@ class EvaluationStore {
     /// Cache index of "row" in dataset for this interface+model+evalID tuple. 
     std::map< std::tuple<String,String,int>, int > interfaceResponseIndexCache;
 
+    /// Maximum number of evaluations staged per root group; buffering is
+    /// disabled for values <= 1
+    int evalBufferSize = 1;
+    /// Maximum age in seconds of staged evaluations; 0 disables the check
+    int evalBufferFlushInterval = 0;
+    /// Staged evaluations, keyed by model or interface+model root group
+    std::map<String, EvaluationBuffer> evaluationBuffers;
+
     /// Models that have been declared as sources to iterators. Only populated when
     /// TOP_METHOD or ALL_METHODS model evals are stored.
     std::set<String> sourceModels;
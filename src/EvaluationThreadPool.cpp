@@ -0,0 +1,102 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "EvaluationThreadPool.hpp"
+#include "util_threads.hpp"
+#include <algorithm>
+
+namespace Dakota {
+
+
+EvaluationThreadPool::EvaluationThreadPool():
+  numOutstanding(0), shutdownFlag(false)
+{ }
+
+
+EvaluationThreadPool::~EvaluationThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(poolMutex);
+    shutdownFlag = true;
+    taskQueue.clear(); // abandon evaluations not yet started
+  }
+  taskCond.notify_all();
+  for (std::thread& t : workerThreads)
+    t.join();
+}
+
+
+void EvaluationThreadPool::initialize(size_t num_threads)
+{
+  if (!workerThreads.empty())
+    return;
+  num_threads = dakota::util::num_threads(num_threads);
+  workerThreads.reserve(num_threads);
+  for (size_t i=0; i<num_threads; ++i)
+    workerThreads.emplace_back(&EvaluationThreadPool::run, this, i);
+}
+
+
+void EvaluationThreadPool::submit(int eval_id, const Task& task)
+{
+  {
+    std::lock_guard<std::mutex> lock(poolMutex);
+    taskQueue.emplace_back(eval_id, task);
+    ++numOutstanding;
+  }
+  taskCond.notify_one();
+}
+
+
+void EvaluationThreadPool::
+wait(IntSet& completed_ids, std::map<int, std::exception_ptr>& failures,
+     bool block)
+{
+  std::unique_lock<std::mutex> lock(poolMutex);
+  if (block)
+    doneCond.wait(lock, [this]
+		  { return !completedIds.empty() || !numOutstanding; });
+  numOutstanding -= completedIds.size();
+  completed_ids.insert(completedIds.begin(), completedIds.end());
+  completedIds.clear();
+  failures.insert(failedEvals.begin(), failedEvals.end());
+  failedEvals.clear();
+}
+
+
+void EvaluationThreadPool::run(size_t thread_index)
+{
+  for (;;) {
+    std::pair<int, Task> job;
+    {
+      std::unique_lock<std::mutex> lock(poolMutex);
+      taskCond.wait(lock, [this]
+		    { return shutdownFlag || !taskQueue.empty(); });
+      if (shutdownFlag)
+	return;
+      job = std::move(taskQueue.front());
+      taskQueue.pop_front();
+    }
+
+    std::exception_ptr failure;
+    try { job.second(thread_index); }
+    catch (...) { failure = std::current_exception(); }
+    job.second = Task(); // release captured data outside the lock
+
+    {
+      std::lock_guard<std::mutex> lock(poolMutex);
+      completedIds.insert(job.first);
+      if (failure)
+	failedEvals[job.first] = failure;
+    }
+    doneCond.notify_all();
+  }
+}
+
+} // namespace Dakota
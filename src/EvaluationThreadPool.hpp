@@ -0,0 +1,124 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#ifndef EVALUATION_THREAD_POOL_H
+#define EVALUATION_THREAD_POOL_H
+
+#include "dakota_system_defs.hpp"
+#include "dakota_data_types.hpp"
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
+
+namespace Dakota {
+
+
+/// Fixed-size pool of worker threads executing function evaluations
+/// for in-process (direct and plugin) interfaces.
+
+/** Evaluation tasks are queued by evaluation id and executed in
+    submission order by the worker threads.  Each task receives the
+    index of the worker executing it, which interfaces use to select
+    per-thread scratch data.  Completed evaluation ids are collected
+    by wait() on the submitting (main) thread; an exception thrown by a
+    task (e.g., a FunctionEvalFailure) is captured and returned with
+    its id, so that failure management remains on the main thread. */
+
+class EvaluationThreadPool
+{
+public:
+
+  //
+  //- Heading: Type definitions
+  //
+
+  /// an evaluation task, invoked with the index of its worker thread
+  typedef std::function<void(size_t)> Task;
+
+  //
+  //- Heading: Constructors and destructor
+  //
+
+  EvaluationThreadPool();  ///< constructor
+  ~EvaluationThreadPool(); ///< destructor; joins the worker threads
+
+  //
+  //- Heading: Member functions
+  //
+
+  /// start num_threads worker threads (thread budget if 0);
+  /// no-op if the pool is already running
+  void initialize(size_t num_threads);
+
+  /// number of worker threads
+  size_t num_threads() const;
+
+  /// queue task for the evaluation with id eval_id
+  void submit(int eval_id, const Task& task);
+
+  /// collect the ids of completed evaluations into completed_ids and
+  /// the exceptions of failed evaluations (also in completed_ids) into
+  /// failures; if block, waits until at least one evaluation completes
+  /// (provided any are outstanding)
+  void wait(IntSet& completed_ids,
+	    std::map<int, std::exception_ptr>& failures, bool block);
+
+  /// number of submitted evaluations not yet collected by wait()
+  size_t outstanding() const;
+
+private:
+
+  //
+  //- Heading: Convenience functions
+  //
+
+  /// worker thread loop
+  void run(size_t thread_index);
+
+  //
+  //- Heading: Data
+  //
+
+  /// the worker threads
+  std::vector<std::thread> workerThreads;
+  /// evaluations awaiting a worker
+  std::deque<std::pair<int, Task> > taskQueue;
+  /// evaluations completed since the last wait()
+  IntSet completedIds;
+  /// exceptions thrown by evaluations completed since the last wait()
+  std::map<int, std::exception_ptr> failedEvals;
+  /// number of submitted evaluations not yet collected by wait()
+  size_t numOutstanding;
+  /// signals the worker threads to exit
+  bool shutdownFlag;
+
+  /// protects all data above except workerThreads
+  mutable std::mutex poolMutex;
+  /// signals the workers that a task is queued (or shutdown)
+  std::condition_variable taskCond;
+  /// signals wait() that an evaluation completed
+  std::condition_variable doneCond;
+};
+
+
+inline size_t EvaluationThreadPool::num_threads() const
+{ return workerThreads.size(); }
+
+
+inline size_t EvaluationThreadPool::outstanding() const
+{ std::lock_guard<std::mutex> lock(poolMutex); return numOutstanding; }
+
+} // namespace Dakota
+
+#endif
@@ -17,6 +17,7 @@ namespace Dakota {
 ExperimentData::ExperimentData():
   calibrationDataFlag(false), numExperiments(0), numConfigVars(0), 
   covarianceDeterminant(1.0), logCovarianceDeterminant(0.0),
+  multiplierCountsMode(CALIBRATE_NONE),
   scalarDataFormat(TABULAR_EXPER_ANNOT), scalarSigmaPerRow(0),
   readSimFieldCoords(false), interpolateFlag(false), outputLevel(NORMAL_OUTPUT)
 {  /* empty ctor */  }                                
@@ -29,6 +30,7 @@ ExperimentData(const ProblemDescDB& pddb,
   numExperiments(pddb.get_sizet("responses.num_experiments")), 
   numConfigVars(pddb.get_sizet("responses.num_config_vars")),
   covarianceDeterminant(1.0), logCovarianceDeterminant(0.0),
+  multiplierCountsMode(CALIBRATE_NONE),
   dataPathPrefix(pddb.get_string("responses.data_directory")),
   scalarDataFilename(pddb.get_string("responses.scalar_data_filename")),
   scalarDataFormat(pddb.get_ushort("responses.scalar_data_format")),
@@ -51,6 +53,7 @@ ExperimentData(size_t num_experiments, size_t num_config_vars,
   calibrationDataFlag(true), numExperiments(num_experiments),
   numConfigVars(num_config_vars),
   covarianceDeterminant(1.0), logCovarianceDeterminant(0.0),
+  multiplierCountsMode(CALIBRATE_NONE),
   dataPathPrefix(data_prefix), scalarDataFilename(scalar_data_filename),
   scalarDataFormat(TABULAR_EXPER_ANNOT), scalarSigmaPerRow(0),
   readSimFieldCoords(false), interpolateFlag(false), outputLevel(output_level)
@@ -70,6 +73,7 @@ ExperimentData(size_t num_experiments,
   calibrationDataFlag(false), numExperiments(num_experiments),
   numConfigVars(config_vars[0].total_active()),
   covarianceDeterminant(1.0), logCovarianceDeterminant(0.0),
+  multiplierCountsMode(CALIBRATE_NONE),
   scalarDataFormat(TABULAR_EXPER_ANNOT), scalarSigmaPerRow(0),
   readSimFieldCoords(false), interpolateFlag(false), outputLevel(output_level)
 {
@@ -270,6 +274,7 @@ void ExperimentData::update_data_properties()
     logCovarianceDeterminant +=
       allExperiments[exp_ind].log_covariance_determinant();
   }
+  multiplierCounts.sizeUninitialized(0);
 }
 
 
@@ -1283,6 +1288,19 @@ void ExperimentData::scale_residuals(Response& residual_response) const
 }
 
 
+void ExperimentData::scale_residuals(RealMatrix& residuals) const
+{
+  int num_resid = residuals.numCols();
+  for (size_t exp_ind = 0; exp_ind < numExperiments; ++exp_ind) {
+    // apply cov_inv_sqrt to this experiment's rows of all the residuals
+    RealMatrix exp_resid(Teuchos::View, residuals, experimentLengths[exp_ind],
+			 num_resid, expOffsets[exp_ind], 0);
+    allExperiments[exp_ind].experiment_covariance().
+      apply_experiment_covariance_inverse_sqrt_to_vectors(exp_resid);
+  }
+}
+
+
 /** Add the data back to the residual to recover the model, for use in
     surrogated-based LSQ where DB lookup will fail (need approx eval
     DB).  best_fns contains primary and secondary responses */
@@ -1606,11 +1624,24 @@ half_log_cov_determinant(const RealVector& multipliers,
     break;
     
   case CALIBRATE_PER_EXPER: case CALIBRATE_PER_RESP: case CALIBRATE_BOTH: {
-    RealVector expand_mults;
-    generate_multipliers(multipliers, multiplier_mode, expand_mults);
-    // for each experiment, add contribution from mult: det(mult_i*I*Cov_i)
-    for (size_t resid_ind = 0; resid_ind < total_resid; ++resid_ind)
-      log_det += std::log(expand_mults[resid_ind]);
+    // for each experiment, add contribution from mult: det(mult_i*I*Cov_i);
+    // the number of residuals sharing each multiplier is fixed, so this
+    // costs one log per multiplier rather than one per residual
+    size_t m, num_mults = multipliers.length();
+    if (multiplierCountsMode != multiplier_mode ||
+	multiplierCounts.length() != num_mults) {
+      // expand the multiplier indices to count their residuals
+      RealVector mult_indices(num_mults, false), expand_indices;
+      for (m=0; m<num_mults; ++m)
+	mult_indices[m] = (Real)m;
+      generate_multipliers(mult_indices, multiplier_mode, expand_indices);
+      multiplierCounts.size(num_mults); // init to 0
+      for (size_t resid_ind = 0; resid_ind < total_resid; ++resid_ind)
+	multiplierCounts[(size_t)expand_indices[resid_ind]] += 1.;
+      multiplierCountsMode = multiplier_mode;
+    }
+    for (m=0; m<num_mults; ++m)
+      log_det += multiplierCounts[m] * std::log(multipliers[m]);
     break;
   }
 
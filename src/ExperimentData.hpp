@@ -241,6 +241,11 @@ public:
   /// (scale functions, gradients, and Hessians by Gamma_d^{-1/2})
   void scale_residuals(Response& residual_response) const;
 
+  /// Apply the experiment data covariance in-place to a block of
+  /// residual vectors, one per column, whose leading rows are the
+  /// residuals for all experiments
+  void scale_residuals(RealMatrix& residuals) const;
+
   // All the following now assume any covariance scaling is already applied
 
   /// Build the gradient of the ssr from residuals and function gradients
@@ -438,6 +443,12 @@ private:
   /// cached sum of each experiment covariance's log determinant 
   Real logCovarianceDeterminant;
 
+  /// number of residuals scaled by each hyper-parameter multiplier,
+  /// cached for multiplierCountsMode
+  mutable RealVector multiplierCounts;
+  /// multiplier mode for which multiplierCounts is cached
+  mutable unsigned short multiplierCountsMode;
+
   /// path to prepend to any data file names
   boost::filesystem::path dataPathPrefix;
 
@@ -380,6 +380,35 @@ void CovarianceMatrix::apply_covariance_inverse_sqrt( const RealVector &vector,
   }
 }
 
+void CovarianceMatrix::
+apply_covariance_inverse_sqrt_to_vectors( RealMatrix &vectors ) const
+{
+  if ( vectors.numRows() != numDOF_ ){
+    std::string msg = "Vectors and covariance are incompatible for ";
+    msg += "multiplication.";
+    throw( std::runtime_error( msg ) );
+  }
+
+  int num_vec = vectors.numCols();
+  if ( covIsDiagonal_ ) {
+    for (int i=0; i<numDOF_; i++) {
+      Real sqrt_cov = std::sqrt( covDiagonal_[i] );
+      for (int j=0; j<num_vec; j++)
+	vectors(i,j) /= sqrt_cov;
+    }
+  }else{
+    // the inverse Cholesky factor is triangular, so a triangular matrix
+    // product (BLAS-3) replaces a matrix-vector product per column
+    Teuchos::BLAS<int, Real> blas;
+    Teuchos::EUplo uplo = ( covCholFactor_.UPLO()=='L' ) ?
+      Teuchos::LOWER_TRI : Teuchos::UPPER_TRI;
+    blas.TRMM( Teuchos::LEFT_SIDE, uplo, Teuchos::NO_TRANS,
+	       Teuchos::NON_UNIT_DIAG, numDOF_, num_vec, 1.0,
+	       cholFactorInv_.values(), cholFactorInv_.stride(),
+	       vectors.values(), vectors.stride() );
+  }
+}
+
 void CovarianceMatrix::apply_covariance_inverse_sqrt_to_gradients( 
           const RealMatrix &gradients,
 	  RealMatrix &result ) const
@@ -633,6 +662,22 @@ void ExperimentCovariance::apply_experiment_covariance_inverse_sqrt(
   }
 }
 
+void ExperimentCovariance::apply_experiment_covariance_inverse_sqrt_to_vectors(
+RealMatrix &vectors ) const{
+
+  if ( vectors.numRows() != num_dof() )
+    throw(std::runtime_error("apply_covariance_inverse_sqrt_to_vectors: vectors are inconsistent with covariance matrix"));
+
+  int shift = 0;
+  int num_vec = vectors.numCols();
+  for (int i=0; i<covMatrices_.size(); i++ ){
+    int num_dof = covMatrices_[i].num_dof();
+    RealMatrix sub_vectors( Teuchos::View, vectors, num_dof, num_vec, shift, 0 );
+    covMatrices_[i].apply_covariance_inverse_sqrt_to_vectors( sub_vectors );
+    shift += num_dof;
+  }
+}
+
 void ExperimentCovariance::apply_experiment_covariance_inverse_sqrt_to_gradients(
 const RealMatrix &gradients, RealMatrix &result ) const{
 
@@ -149,6 +149,10 @@ public:
   void apply_covariance_inverse_sqrt( const RealVector &vector, 
 				      RealVector &result ) const;
 
+  /// Multiply, in place, each column of vectors by the sqrt of the inverse
+  /// covariance matrix, as a single triangular matrix product
+  void apply_covariance_inverse_sqrt_to_vectors( RealMatrix &vectors ) const;
+
   /// Multiply a matrix of gradients g (each column is a gradient vector) 
   /// by the sqrt of the inverse covariance matrix C, i.e.
   /// compute L'*g where L is the cholesky factor of the positive definite 
@@ -224,6 +228,11 @@ public:
   void apply_experiment_covariance_inverse_sqrt( const RealVector &vector,
 						 RealVector &result ) const;
 
+  /// Compute, in place, the product inv(L)*V where the columns of V are
+  /// vectors over all degrees of freedom
+  void apply_experiment_covariance_inverse_sqrt_to_vectors(
+	   RealMatrix &vectors ) const;
+
   /// Compute the product inv(L)*G where L is the Cholesky factor of the 
   /// covariance matrix C and G is a matrix whose columns are gradient vectors
   /// for each degree of freedom
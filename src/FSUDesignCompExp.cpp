@@ -233,7 +233,9 @@ void FSUDesignCompExp::post_run(std::ostream& s)
                                                         numContinuousVars + numDiscreteIntVars + numDiscreteRealVars,
                                                         numSamples,
                                                         allSamples,
-                                                        allResponses);
+                                                        allResponses,
+                                                        vbdBootstrapSamples,
+                                                        randomSeed);
   else {
     // compute correlation statistics if (compute_corr_flag)
     bool compute_corr_flag = (!subIteratorFlag);
@@ -9,6 +9,7 @@
 
 #include "GaussProcApproximation.hpp"
 #include "dakota_data_types.hpp"
+#include "dakota_linear_algebra.hpp"
 #include "DakotaIterator.hpp"
 #include "DakotaResponse.hpp"
 //#include "NPSOLOptimizer.hpp"
@@ -23,6 +24,7 @@ using OPTPP::NLPFunction;
 using OPTPP::NLPGradient;
 #endif
 
+#include "Teuchos_BLAS.hpp"
 #include "Teuchos_LAPACK.hpp"
 #include "Teuchos_SerialDenseSolver.hpp"
 #include "Teuchos_SerialDenseHelpers.hpp"
@@ -132,7 +134,9 @@ GaussProcApproximation(const ProblemDescDB& problem_db,
 		       const SharedApproxData& shared_data,
                        const String& approx_label):
   Approximation(BaseConstructor(), problem_db, shared_data, approx_label),
-  usePointSelection(problem_db.get_bool("model.surrogate.point_selection"))
+  numObs(0),
+  usePointSelection(problem_db.get_bool("model.surrogate.point_selection")),
+  frozenHyperparams(false), cholFactorActive(false)
 {
   const String& trend_string
     = problem_db.get_string("model.surrogate.trend_order");
@@ -200,6 +204,81 @@ void GaussProcApproximation::build()
 }
 
 
+/** The training points retained from the last build are those leading
+    points of approxData that are unchanged, since appends and pops act
+    on the trailing points.  With thetaParams and the input
+    normalization held fixed, the covariance of the retained points is
+    unchanged, so its Cholesky factor is truncated to the retained
+    points and bordered with a row per new point, at O(numObs^2) cost
+    per point rather than the O(numObs^3) refactorization (and repeated
+    likelihood optimization) of build().  The trend coefficients and
+    process variance are then recomputed from the updated factor. */
+void GaussProcApproximation::rebuild()
+{
+  size_t i, j, num_v = sharedDataRep->numVars;
+  if (!frozenHyperparams || usePointSelection || !numObs ||
+      thetaParams.length() != num_v)
+    { build(); return; }
+
+  // base class implementation checks data set against min required
+  Approximation::build();
+
+  const Pecos::SDVArray& sdv_array = approxData.variables_data();
+  const Pecos::SDRArray& sdr_array = approxData.response_data();
+  size_t num_pts = approxData.points(), num_retained;
+  for (i=0; i<numObs && i<num_pts; ++i) {
+    const RealVector& c_vars = sdv_array[i].continuous_variables();
+    for (j=0; j<num_v; ++j)
+      if (trainPoints(i,j) != c_vars[j])
+	break;
+    if (j < num_v) break;
+  }
+  num_retained = i;
+  if (!num_retained)
+    { build(); return; }
+
+  // truncate to the retained points
+  if (num_retained < numObs) {
+    numObs = num_retained;
+    trainPoints.reshape(numObs, num_v);
+    normTrainPoints.reshape(numObs, num_v);
+    trendFunction.reshape(numObs, trendFunction.numCols());
+    if (cholFactorActive)
+      covCholFactor.reshape(numObs, numObs);
+  }
+  if (!cholFactorActive)
+    factor_cov_matrix();
+
+  // append the new points, normalized consistently with the frozen model
+  size_t trend_dim = trendFunction.numCols();
+  trainPoints.reshape(num_pts, num_v);
+  normTrainPoints.reshape(num_pts, num_v);
+  trendFunction.reshape(num_pts, trend_dim);
+  for (; numObs<num_pts; ++numObs) {
+    const RealVector& c_vars = sdv_array[numObs].continuous_variables();
+    trendFunction(numObs,0) = 1.;
+    for (j=0; j<num_v; ++j) {
+      Real norm_x = (c_vars[j] - trainMeans(j)) / trainStdvs(j);
+      trainPoints(numObs,j) = c_vars[j];
+      normTrainPoints(numObs,j) = norm_x;
+      if (trendOrder > 0)
+	trendFunction(numObs,j+1) = norm_x;
+      if (trendOrder == 2)
+	trendFunction(numObs,num_v+j+1) = norm_x*norm_x;
+    }
+    append_cov_factor();
+  }
+
+  // response data may have been replaced as well as appended
+  trainValues.shapeUninitialized(numObs, 1);
+  for (i=0; i<numObs; ++i)
+    trainValues(i,0) = sdr_array[i].response_function();
+
+  get_beta_coefficients();
+  get_process_variance();
+}
+
+
 Real GaussProcApproximation::value(const Variables& vars)
 { GPmodel_apply(vars.continuous_variables(),false,false); return approxValue; }
 
@@ -221,6 +300,7 @@ void GaussProcApproximation::GPmodel_build()
   //   probably use only a subset of the points for MLE, so the theta 
   //   parameters may be different.
   numObs = trainValues.numRows();
+  cholFactorActive = false; // hyperparameters and covSlvr to be recomputed
   // bool use_point_selection = false;
   //if (someLogicToTurnOnPointSelection) 
   //  use_point_selection = true;
@@ -478,6 +558,83 @@ int GaussProcApproximation::get_cholesky_factor()
 }
   
 
+void GaussProcApproximation::factor_cov_matrix()
+{
+  // as in get_cholesky_factor(), condition a covariance that is singular
+  // to working precision with an increasing nugget
+  Teuchos::LAPACK<int, Real> la;
+  int info;
+  cholNugget = 0.;
+  do {
+    get_cov_matrix();
+    covCholFactor.shape(numObs, numObs); // upper triangle remains zero
+    for (size_t j=0; j<numObs; ++j) {
+      for (size_t k=j; k<numObs; ++k)
+	covCholFactor(k,j) = covMatrix(k,j);
+      covCholFactor(j,j) += cholNugget;
+    }
+    la.POTRF('L', numObs, covCholFactor.values(), covCholFactor.stride(),
+	     &info);
+    if (info > 0)
+      cholNugget = (cholNugget > 0.) ? 3.*cholNugget : 1.e-15;
+  } while (info > 0);
+  if (cholNugget > 0.)
+    Cout << "COV matrix corrected with nugget: " << cholNugget << std::endl;
+  cholFactorActive = true;
+}
+
+
+void GaussProcApproximation::append_cov_factor()
+{
+  // covariance of the new point with the existing points
+  size_t i, n = numObs, num_v = sharedDataRep->numVars;
+  RealVector exp_theta(num_v, false), cov_row(n, false);
+  for (i=0; i<num_v; ++i)
+    exp_theta[i] = std::exp(thetaParams[i]);
+  for (size_t j=0; j<n; ++j) {
+    Real sume = 0.;
+    for (i=0; i<num_v; ++i) {
+      Real pt_diff = normTrainPoints(n,i) - normTrainPoints(j,i);
+      sume += exp_theta[i]*pt_diff*pt_diff;
+    }
+    cov_row[j] = std::exp(-1.*sume);
+  }
+
+  Real d2 = cholesky_append(covCholFactor, cov_row, 1. + cholNugget);
+  if (d2 <= 0.) {
+    // a (nearly) duplicate point: increase the nugget for this point only
+    Real l_dot_l = 1. + cholNugget - d2,
+      nugget = (cholNugget > 0.) ? cholNugget : 1.e-15;
+    while (1. + nugget - l_dot_l <= 0.)
+      nugget *= 3.;
+    d2 = 1. + nugget - l_dot_l;
+    Cout << "COV matrix corrected with nugget: " << nugget << std::endl;
+    covCholFactor(n,n) = std::sqrt(d2);
+  }
+}
+
+
+void GaussProcApproximation::cov_solve(RealMatrix& soln, RealMatrix& rhs)
+{
+  if (cholFactorActive) {
+    Teuchos::BLAS<int, Real> blas;
+    soln.assign(rhs);
+    blas.TRSM(Teuchos::LEFT_SIDE, Teuchos::LOWER_TRI, Teuchos::NO_TRANS,
+	      Teuchos::NON_UNIT_DIAG, numObs, soln.numCols(), 1.,
+	      covCholFactor.values(), covCholFactor.stride(), soln.values(),
+	      soln.stride());
+    blas.TRSM(Teuchos::LEFT_SIDE, Teuchos::LOWER_TRI, Teuchos::TRANS,
+	      Teuchos::NON_UNIT_DIAG, numObs, soln.numCols(), 1.,
+	      covCholFactor.values(), covCholFactor.stride(), soln.values(),
+	      soln.stride());
+  }
+  else {
+    covSlvr.setVectors( rcp(&soln, false), rcp(&rhs, false) );
+    covSlvr.solve();
+  }
+}
+
+
 void GaussProcApproximation::get_beta_coefficients()
 {
   // Default is generalized least squares, but ordinary least squares is
@@ -502,8 +659,7 @@ void GaussProcApproximation::get_beta_coefficients()
     eye_slvr.solve();
   }
   else {
-    covSlvr.setVectors( rcp(&Rinv_Y, false), rcp(&trainValues, false) );
-    covSlvr.solve();
+    cov_solve(Rinv_Y, trainValues);
   }
 
   RealMatrix FT_Rinv_Y(trend_dim, 1, false);
@@ -516,8 +672,7 @@ void GaussProcApproximation::get_beta_coefficients()
     eye_slvr.solve();
   }
   else {
-    covSlvr.setVectors( rcp(&Rinv_F, false), rcp(&trendFunction, false) );
-    covSlvr.solve();
+    cov_solve(Rinv_F, trendFunction);
   }
 
   RealMatrix FT_Rinv_F(trend_dim, trend_dim, false);
@@ -556,8 +711,7 @@ void GaussProcApproximation::get_process_variance()
   YFb.scale(-1);
   YFb += trainValues;
 
-  covSlvr.setVectors( rcp(&Rinv_YFb, false), rcp(&YFb, false) );
-  covSlvr.solve();
+  cov_solve(Rinv_YFb, YFb);
 
   temphold3.multiply(Teuchos::TRANS, Teuchos::NO_TRANS, 1., YFb, Rinv_YFb, 0.);
  
@@ -671,8 +825,7 @@ void GaussProcApproximation::predict(bool variance_flag, bool gradients_flag)
   if (variance_flag) {
     RealMatrix Rinv_covvec(numObs, 1, false), rT_Rinv_r(1, 1, false);
 
-    covSlvr.setVectors( rcp(&Rinv_covvec, false), rcp(&covVector, false) );
-    covSlvr.solve();
+    cov_solve(Rinv_covvec, covVector);
 
     rT_Rinv_r.multiply(Teuchos::TRANS, Teuchos::NO_TRANS, 1., covVector,
 		       Rinv_covvec, 0.);
@@ -699,8 +852,7 @@ void GaussProcApproximation::predict(bool variance_flag, bool gradients_flag)
 	f_xstar_T(i,0) = f_xstar(0,i);
       f_FT_Rinv_r += f_xstar_T;
       
-      covSlvr.setVectors( rcp(&Rinv_F, false), rcp(&trendFunction, false) );
-      covSlvr.solve();
+      cov_solve(Rinv_F, trendFunction);
 
       RealMatrix FT_Rinv_F(trend_dim, trend_dim, false);
       FT_Rinv_F.multiply(Teuchos::TRANS, Teuchos::NO_TRANS, 1., trendFunction,
@@ -68,6 +68,12 @@ protected:
 
   /// find the covariance parameters governing the Gaussian process response
   void build();
+  /// with frozen hyperparameters, update the Cholesky factor of the
+  /// covariance for the points appended (or popped) since the last
+  /// build; otherwise, rebuild from scratch
+  void rebuild();
+  /// hold thetaParams and the input normalization fixed in rebuild()
+  void freeze_hyperparameters(bool freeze);
 
   /// retrieve the function value for a given parameter set
   Real value(const Variables& vars);
@@ -110,6 +116,15 @@ private:
   void get_process_variance();
   /// calculates the covariance matrix for a given set of input points
   void get_cov_matrix();
+  /// forms the explicit lower Cholesky factor covCholFactor of the
+  /// covariance matrix for the current training points
+  void factor_cov_matrix();
+  /// borders covCholFactor with the covariance of a new normalized
+  /// training point (row numObs of normTrainPoints)
+  void append_cov_factor();
+  /// solves (covariance) soln = rhs, using covCholFactor if active and
+  /// covSlvr otherwise
+  void cov_solve(RealMatrix& soln, RealMatrix& rhs);
   /// calculates the covariance vector between a new point x and the 
   /// set of inputs upon which the GP is based
   void get_cov_vector();
@@ -234,6 +249,11 @@ private:
   RealMatrix trendFunctionAll;
   /// Matrix for storing inverse of correlation matrix Rinv*(Y-FB)
   RealMatrix Rinv_YFb;
+  /// Explicit lower Cholesky factor of the covariance matrix, maintained
+  /// by incremental rebuilds with frozen hyperparameters
+  RealMatrix covCholFactor;
+  /// The nugget added to the diagonal of the covariance in covCholFactor
+  Real cholNugget;
 
   /// The number of observations on which the GP surface is built.
   size_t numObs;
@@ -267,6 +287,11 @@ private:
   int cholFlag;
   /// a flag to indicate the use of point selection
   bool usePointSelection;
+  /// a flag to hold the hyperparameters fixed in rebuild()
+  bool frozenHyperparams;
+  /// a flag to indicate that covCholFactor (rather than covSlvr) holds
+  /// the current factorization
+  bool cholFactorActive;
   //bool afterOptNLL;
 };
 
@@ -275,17 +300,22 @@ private:
     NonDGlobalReliability that does not use a problem database defaults
     here are no point selectinn and quadratic trend function. */
 inline GaussProcApproximation::GaussProcApproximation():
-  trendOrder(2), usePointSelection(false)
+  numObs(0), trendOrder(2), usePointSelection(false),
+  frozenHyperparams(false), cholFactorActive(false)
 { }
 
 
 inline GaussProcApproximation::
 GaussProcApproximation(const SharedApproxData& shared_data):
-  Approximation(NoDBBaseConstructor(), shared_data), trendOrder(2),
-  usePointSelection(false)
+  Approximation(NoDBBaseConstructor(), shared_data), numObs(0), trendOrder(2),
+  usePointSelection(false), frozenHyperparams(false), cholFactorActive(false)
 { }
 
 
+inline void GaussProcApproximation::freeze_hyperparameters(bool freeze)
+{ frozenHyperparams = freeze; }
+
+
 inline GaussProcApproximation::~GaussProcApproximation()
 { }
 
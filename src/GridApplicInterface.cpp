@@ -13,7 +13,6 @@
 #include <link.h>
 #include <sys/types.h> // MAY REQUIRE ifndef(HPUX)
 #include <sys/stat.h>
-#include <thread> // for sleep_for()
 #include "DakotaResponse.hpp"
 #include "ParamResponsePair.hpp"
 #include "GridApplicInterface.hpp"
@@ -148,6 +147,10 @@ void GridApplicInterface::derived_map_asynch(const ParamResponsePair& pair)
   write_parameters_files(pair.variables(), pair.active_set(),
 			 pair.response(),  fn_eval_id);
   //
+  // Clear a sentinel left under a reused results file name
+  //
+  ResultsFileWatcher::clear_sentinel(completion_file(resultsFileName));
+  //
   // Launch the grid solver
   //
   // TODO - ERROR CHECKING
@@ -159,6 +162,8 @@ void GridApplicInterface::derived_map_asynch(const ParamResponsePair& pair)
   // Insert the evaluation ID into our current set
   //
   idSet.insert(fn_eval_id);
+  resultsWatcher.add(fn_eval_id,
+		     completion_file(fileNameMap[fn_eval_id].second));
 }
 
 
@@ -166,16 +171,21 @@ void GridApplicInterface::derived_map_asynch(const ParamResponsePair& pair)
 void GridApplicInterface::test_local_evaluation_sequence(PRPQueue& prp_queue)
 {
   //
-  // Iterate through the set of requests
+  // Iterate through the requests whose results files have been signaled
+  // as ready (closed, renamed into place, sentinel, or stable)
   //
-  for (ISIter it=idSet.begin(); it!=idSet.end(); it++) {
+  IntSet ready_ids;
+  resultsWatcher.ready(ready_ids);
+  for (ISIter it=ready_ids.begin(); it!=ready_ids.end(); it++) {
     //
     // Test for existence of the results file(s) corresponding to this eval
     //
     int fn_eval_id = *it;
     bool err_msg_caught = false;
     const String& file_to_test = fileNameMap[fn_eval_id].second;
-    if (grid_file_test(file_to_test)) {
+    if (!grid_file_test(file_to_test))
+      resultsWatcher.retry(fn_eval_id);
+    else {
       //
       // File exists; test for complete/valid set of results (an incomplete
       // set can result from a race condition in which Dakota is reading a
@@ -215,9 +225,9 @@ void GridApplicInterface::test_local_evaluation_sequence(PRPQueue& prp_queue)
 	else
 	  failCountMap[fn_eval_id] = 1;
 	//
-	// Sleep for 1 millisecond
+	// Wait for the next completion signal before reading again
 	//
-	std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	resultsWatcher.retry(fn_eval_id);
 #ifdef ASYNCH_DEBUG
 	Cerr << "Warning: exception caught in reading response file "
 	     << file_to_test << "\nException = \"" << fr_except.what()
@@ -249,11 +259,30 @@ void GridApplicInterface::test_local_evaluation_sequence(PRPQueue& prp_queue)
   }
 
   // reduce processor load from DAKOTA testing if jobs are not finishing
-  if (completionSet.empty()) // no jobs completed in pass through entire set
-    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  if (completionSet.empty()) // no jobs completed in pass through ready set
+    resultsWatcher.idle();
+  else
+    resultsWatcher.progress();
   // Remove completed jobs from idSet
-  for (ISIter it = completionSet.begin(); it != completionSet.end(); it++)
+  for (ISIter it = completionSet.begin(); it != completionSet.end(); it++) {
     idSet.erase(*it);
+    resultsWatcher.remove(*it);
+  }
+}
+
+
+/** With multiple analysis drivers and no output filter, the last tagged
+    results file (root_file.[num_progs]) signals completion. */
+String GridApplicInterface::completion_file(const String& root_file)
+{
+  size_t num_progs = programNames.length();
+  if ( num_progs > 1 && oFilterName().empty() ) {
+    char prog_num[16];
+    std::sprintf(prog_num, ".%d", num_progs);
+    return root_file + prog_num;
+  }
+  else
+    return root_file;
 }
 
 
@@ -11,6 +11,7 @@
 #define GRID_APPLIC_INTERFACE_H
 
 #include "SysCallApplicationInterface.hpp"
+#include "ResultsFileWatcher.hpp"
 
 
 namespace Dakota {
@@ -63,8 +64,11 @@ public:
   ///
   void wait_local_evaluation_sequence(PRPQueue& prp_queue)
 	{
-  	while (completionSet.empty())
+  	while (completionSet.empty()) {
           test_local_evaluation_sequence(prp_queue);
+	  if (completionSet.empty())
+	    resultsWatcher.wait();
+	}
 	}
 
   ///
@@ -90,6 +94,9 @@ protected:
 
   /// test file(s) for existence based on root_file name 
   bool grid_file_test(const String& root_file);
+  /// results file whose completion signals completion of the evaluation
+  /// writing root_file
+  String completion_file(const String& root_file);
 
   //
   //- Heading: Data
@@ -102,6 +109,10 @@ protected:
   /// map linking function evaluation id's to number of response read failures
   IntShortMap failCountMap; 
 
+  /// event-driven (with polling fallback) detection of completed
+  /// results files for the evaluations in idSet
+  ResultsFileWatcher resultsWatcher;
+
   /// handle to dynamically linked start_grid_computing function
   start_grid_computing_t start_grid_computing;
   /// handle to dynamically linked perform_analysis grid function
@@ -163,6 +163,13 @@ void HDF5IOHelper::append_vector(const String &dset_name, const StringMultiArray
   append_vector(dset_name, ptrs_to_data, row);
 }
 
+/// Append a block of rows of Strings to a 2D dataset
+void HDF5IOHelper::append_vectors(const String &dset_name, const std::vector<String> &data,
+                                  const int &num_rows) {
+  std::vector<const char *> ptrs_to_data = pointers_to_strings(data);
+  append_vectors(dset_name, ptrs_to_data, num_rows);
+}
+
 
 /// Store vector (1D) information to a dataset
 void HDF5IOHelper::store_vector(const std::string & dset_name,
@@ -253,6 +260,7 @@ void HDF5IOHelper::read_vector(const std::string& dset_name, StringArray& array)
 }
 
 int HDF5IOHelper::append_empty(const String &dset_name) {
+  release_reserved_layers(dset_name);
   H5::DataSet &ds = datasetCache[dset_name];
   H5::DataSpace f_space = ds.getSpace();
   hsize_t rank = f_space.getSimpleExtentNdims();
@@ -270,6 +278,63 @@ int HDF5IOHelper::append_empty(const String &dset_name) {
   return dim[0]-1;
 }
 
+int HDF5IOHelper::append_empty(const String &dset_name, const int &num_layers) {
+  H5::DataSet &ds = datasetCache[dset_name];
+  H5::DataSpace f_space = ds.getSpace();
+  hsize_t rank = f_space.getSimpleExtentNdims();
+  std::unique_ptr<hsize_t[]> dim(new hsize_t[rank]), maxdim(new hsize_t[rank]);
+  f_space.getSimpleExtentDims(dim.get(), maxdim.get());
+  if(maxdim[0] != H5S_UNLIMITED) {
+    flush();
+    throw std::runtime_error(String("Attempt to append empty 'elements' to a fixed-sized datasset ") +
+                               dset_name + " failed");
+  }
+  return reserve_layers(dset_name, ds, dim.get(), num_layers);
+}
+
+/// Block appends to evaluation datasets are frequent and small compared to
+/// a chunk, so the 0th dimension is extended to the next multiple of the
+/// chunk size rather than by the number of new layers. The layers actually
+/// appended are tracked in usedLayers until trim_reserved_layers().
+hsize_t HDF5IOHelper::reserve_layers(const String &dset_name, H5::DataSet &ds,
+                                     hsize_t *dims, const hsize_t &num_layers) {
+  auto u_it = usedLayers.find(dset_name);
+  const hsize_t first = (u_it == usedLayers.end()) ? dims[0] : u_it->second,
+    needed = first + num_layers;
+  if(needed > dims[0]) {
+    H5::DSetCreatPropList create_plist = ds.getCreatePlist();
+    const int rank = ds.getSpace().getSimpleExtentNdims();
+    std::unique_ptr<hsize_t[]> chunks(new hsize_t[rank]);
+    hsize_t chunk0 = (create_plist.getLayout() == H5D_CHUNKED &&
+        create_plist.getChunk(rank, chunks.get()) == rank) ? chunks[0] : 1;
+    dims[0] = ((needed + chunk0 - 1)/chunk0)*chunk0;
+    ds.extend(dims);
+  }
+  usedLayers[dset_name] = needed;
+  return first;
+}
+
+void HDF5IOHelper::trim_reserved_layers() {
+  while(!usedLayers.empty())
+    release_reserved_layers(usedLayers.begin()->first);
+}
+
+void HDF5IOHelper::release_reserved_layers(const String &dset_name) {
+  auto u_it = usedLayers.find(dset_name);
+  if(u_it == usedLayers.end())
+    return;
+  H5::DataSet &ds = datasetCache[dset_name];
+  H5::DataSpace f_space = ds.getSpace();
+  const int rank = f_space.getSimpleExtentNdims();
+  std::unique_ptr<hsize_t[]> dims(new hsize_t[rank]);
+  f_space.getSimpleExtentDims(dims.get());
+  if(dims[0] != u_it->second) {
+    dims[0] = u_it->second;
+    ds.extend(dims.get()); // H5Dset_extent, which also shrinks
+  }
+  usedLayers.erase(u_it);
+}
+
 
 // Create groups for the absolute path in name.
 // The includes_dset option controls whether the final token in name is
@@ -484,6 +549,16 @@ void HDF5IOHelper::create_softlink(const String &link_location, const String &so
   h5File.link(H5G_LINK_SOFT, source_location, link_location);
 }
 
+HDF5IOHelper::~HDF5IOHelper() {
+  try {
+    trim_reserved_layers();
+  }
+  catch(const H5::Exception &e) {
+    Cerr << "\nWarning: could not release reserved rows of HDF5 datasets in "
+         << fileName << ": " << e.getDetailMsg() << std::endl;
+  }
+}
+
 void HDF5IOHelper::flush() const {
   h5File.flush(H5F_SCOPE_LOCAL);
 }
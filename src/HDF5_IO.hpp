@@ -218,6 +218,10 @@ class HDF5IOHelper
    *   append_vector (to a 2D dataset)
    *   append_matrix (to a 3D dataset)
    *   append_vector_matrix (to a 4D dataset)
+   *  - Append a block of layers at once (buffered evaluation storage)
+   *   append_scalars (to a 1D dataset)
+   *   append_vectors (to a 2D dataset)
+   *   set_vectors (contiguous rows in a 2D dataset)
    * READING
    *  - Read an entire dataset
    *   read_scalar
@@ -380,6 +384,31 @@ class HDF5IOHelper
                      const std::vector<Teuchos::SerialDenseMatrix<int, T> > &data,
                      const bool &transpose = false);
 
+  /// Append num_layers empty "layers" to the 0th dimension with at most one
+  /// chunk-aligned extension and return the index of the first one
+  int append_empty(const String &dset_name, const int &num_layers);
+  /// Append a block of scalars to a 1D dataset with at most one
+  /// chunk-aligned extension
+  template<typename T>
+  void append_scalars(const String &dset_name, const std::vector<T> &data);
+  /// Append a block of num_rows rows, stored contiguously in row-major order,
+  /// to a 2D dataset with at most one chunk-aligned extension and a single
+  /// hyperslab write
+  template<typename T>
+  void append_vectors(const String &dset_name, const std::vector<T> &data,
+                      const int &num_rows);
+  /// Append a block of num_rows rows of Strings to a 2D dataset
+  void append_vectors(const String &dset_name, const std::vector<String> &data,
+                      const int &num_rows);
+  /// Set a block of num_rows contiguous rows, stored in row-major order, in
+  /// a 2D dataset beginning at index
+  template<typename T>
+  void set_vectors(const String &dset_name, const std::vector<T> &data,
+                   const int &index, const int &num_rows);
+  /// Shrink the 0th dimension of each dataset extended by the block
+  /// appenders above to the number of layers actually appended
+  void trim_reserved_layers();
+
   /// Read scalar data from a dataset
   template <typename T>
   void read_scalar(const std::string& dset_name, T& val);
@@ -478,7 +507,8 @@ class HDF5IOHelper
   /// Flush cache to file
   void flush() const;
  
-  ~HDF5IOHelper() {}; 
+  /// Release reserved layers before the datasets are closed
+  ~HDF5IOHelper();
 
   protected:
 
@@ -506,6 +536,19 @@ class HDF5IOHelper
   /// repeatedly flushed and reopened, which is very costly
   std::map<String, H5::DataSet> datasetCache;
 
+  /// Number of layers appended by the block appenders to datasets whose
+  /// 0th dimension has been extended beyond it by reserve_layers()
+  std::map<String, hsize_t> usedLayers;
+
+  /// Make room for num_layers more layers in the 0th dimension of ds,
+  /// extending it in multiples of its chunk size, and return the index of
+  /// the first new layer. dims holds the current extent and is updated.
+  hsize_t reserve_layers(const String &dset_name, H5::DataSet &ds,
+                         hsize_t *dims, const hsize_t &num_layers);
+  /// Shrink the 0th dimension of dset_name to the number of layers
+  /// appended, if it holds reserved layers, before a single-layer append
+  void release_reserved_layers(const String &dset_name);
+
   //H5::DataSet open_dataset(const String &ds_name);
 
 }; // class HDF5IOHelper
@@ -1005,6 +1048,7 @@ void HDF5IOHelper::append_scalar(const String &dset_name, const T&data) {
   // 3. Extend the dataset
   // 5. write
   
+  release_reserved_layers(dset_name);
   H5::DataSet &ds = datasetCache[dset_name];
   H5::DataSpace f_space = ds.getSpace();
   if(f_space.getSimpleExtentNdims() != 1) {
@@ -1031,6 +1075,7 @@ void HDF5IOHelper::append_vector(const String &dset_name, const T &data, const b
   // 3. Raise an error if the dataset can't be extended
   // 4. Extend
   // 4. Write
+  release_reserved_layers(dset_name);
   H5::DataSet ds = datasetCache[dset_name];
   H5::DataSpace f_space = ds.getSpace();
   if(f_space.getSimpleExtentNdims() != 2) {
@@ -1074,6 +1119,7 @@ void HDF5IOHelper::append_matrix(const String &dset_name,
   // 3. Raise an error if the dataset can't be extended
   // 4. Extend
   // 4. Write
+  release_reserved_layers(dset_name);
   H5::DataSet &ds = datasetCache[dset_name];
   H5::DataSpace f_space = ds.getSpace();
   if(f_space.getSimpleExtentNdims() != 3) {
@@ -1118,6 +1164,7 @@ void HDF5IOHelper::append_vector_matrix(const String &dset_name,
   // 3. Raise an error if the dataset can't be extended
   // 4. Extend
   // 4. Write
+  release_reserved_layers(dset_name);
   H5::DataSet &ds = datasetCache[dset_name];
   H5::DataSpace f_space = ds.getSpace();
   if(f_space.getSimpleExtentNdims() != 4) {
@@ -1148,6 +1195,116 @@ void HDF5IOHelper::append_vector_matrix(const String &dset_name,
   set_vector_matrix(dset_name, ds, data, dims[0]-1, transpose);
 }
 
+/// Append a block of scalars to a 1D dataset. The dataset is extended (in
+/// multiples of its chunk size) at most once, and the block is written with
+/// a single hyperslab selection.
+template<typename T>
+void HDF5IOHelper::append_scalars(const String &dset_name, const std::vector<T> &data) {
+  H5::DataSet &ds = datasetCache[dset_name];
+  H5::DataSpace f_space = ds.getSpace();
+  if(f_space.getSimpleExtentNdims() != 1) {
+    flush();
+    throw std::runtime_error(String("Attempt to append scalars to non-1D dataset ") + 
+                               dset_name + " failed" );
+  }
+  hsize_t dims[1], maxdims[1];
+  f_space.getSimpleExtentDims(dims, maxdims);
+  if(maxdims[0] != H5S_UNLIMITED) {
+    flush();
+    throw std::runtime_error(String("Attempt to append scalars to ") + 
+                               dset_name + " failed; dimensions are fixed.");
+  }
+  if(data.empty())
+    return;
+  hsize_t f_start[1] = {reserve_layers(dset_name, ds, dims, data.size())},
+    f_count[1] = {data.size()};
+  f_space = ds.getSpace();
+  f_space.selectHyperslab(H5S_SELECT_SET, f_count, f_start);
+  H5::DataSpace m_space(1, f_count);
+  ds.write(&data[0], h5_mem_dtype(data[0]), m_space, f_space);
+}
+
+/// Append a block of num_rows rows to a 2D dataset. data holds the rows
+/// contiguously in row-major order, and its length must be num_rows times
+/// the number of columns in the dataset. The dataset is extended (in
+/// multiples of its chunk size) at most once and the block is written with
+/// a single hyperslab selection.
+template<typename T>
+void HDF5IOHelper::append_vectors(const String &dset_name, const std::vector<T> &data,
+                                  const int &num_rows) {
+  H5::DataSet &ds = datasetCache[dset_name];
+  H5::DataSpace f_space = ds.getSpace();
+  if(f_space.getSimpleExtentNdims() != 2) {
+    flush();
+    throw std::runtime_error(String("Attempt to append rows to non-2D dataset ") + 
+                               dset_name + " failed" );
+  }
+  hsize_t dims[2], maxdims[2];
+  f_space.getSimpleExtentDims(dims, maxdims);
+  if(maxdims[0] != H5S_UNLIMITED) {
+    flush();
+    throw std::runtime_error(String("Attempt to append rows to ") + 
+                               dset_name + " failed; dimensions are fixed.");
+  }
+  if(data.size() != num_rows*dims[1]) {
+    flush();
+    throw std::runtime_error(String("Attempt to append rows to ") + 
+                               dset_name + " failed; length of data is " + 
+                               std::to_string(data.size()) + " but " +
+                               std::to_string(num_rows) + " rows of " +
+                               std::to_string(dims[1]) + " columns were expected");
+  }
+  if(num_rows <= 0)
+    return;
+  hsize_t f_start[2] = {reserve_layers(dset_name, ds, dims, num_rows), 0},
+    f_count[2] = {hsize_t(num_rows), dims[1]};
+  f_space = ds.getSpace();
+  f_space.selectHyperslab(H5S_SELECT_SET, f_count, f_start);
+  H5::DataSpace m_space(2, f_count);
+  ds.write(&data[0], h5_mem_dtype(data[0]), m_space, f_space);
+}
+
+/// Set a block of num_rows contiguous rows in a 2D dataset, beginning with
+/// row index. data holds the rows in row-major order.
+template<typename T>
+void HDF5IOHelper::set_vectors(const String &dset_name, const std::vector<T> &data,
+                               const int &index, const int &num_rows) {
+  H5::DataSet &ds = datasetCache[dset_name];
+  H5::DataSpace f_space = ds.getSpace();
+  if(f_space.getSimpleExtentNdims() != 2) {
+    flush();
+    throw std::runtime_error(String("Attempt to insert rows into non-2D dataset ") + 
+                               dset_name + " failed" );
+  }
+  hsize_t dims[2];
+  f_space.getSimpleExtentDims(dims);
+  // rows reserved beyond the appended ones are not yet part of the dataset
+  auto u_it = usedLayers.find(dset_name);
+  if(u_it != usedLayers.end())
+    dims[0] = u_it->second;
+  if(data.size() != num_rows*dims[1]) {
+    flush();
+    throw std::runtime_error(String("Attempt to insert rows into ") + 
+                               dset_name + " failed; length of data is " + 
+                               std::to_string(data.size()) + " but " +
+                               std::to_string(num_rows) + " rows of " +
+                               std::to_string(dims[1]) + " columns were expected");
+  } else if(index < 0 || index + num_rows > dims[0]) {
+    flush();
+    throw std::runtime_error(String("Attempt to insert rows into ") +
+                               dset_name + " failed; requested rows " + 
+                               std::to_string(index) + " through " +
+                               std::to_string(index + num_rows - 1) + 
+                               " but the dataset has " + std::to_string(dims[0]));
+  }
+  if(num_rows <= 0)
+    return;
+  hsize_t f_start[2] = {hsize_t(index), 0}, f_count[2] = {hsize_t(num_rows), dims[1]};
+  f_space.selectHyperslab(H5S_SELECT_SET, f_count, f_start);
+  H5::DataSpace m_space(2, f_count);
+  ds.write(&data[0], h5_mem_dtype(data[0]), m_space, f_space);
+}
+
 /// Read scalar data from a dataset
 template <typename T>
 void HDF5IOHelper::read_scalar(const std::string& dset_name, T& val) {
@@ -0,0 +1,234 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "KNNInfoEstimator.hpp"
+#include "dakota_global_defs.hpp"
+#include "util_threads.hpp"
+#include <boost/math/special_functions/digamma.hpp>
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <thread>
+
+namespace Dakota {
+
+/// minimum number of KL divergence queries per thread
+static const size_t KNN_THREAD_QUERIES = 1000;
+
+
+/** Apply fn(begin, end, buffer) to contiguous ranges of [0, num_items)
+    on up to num_threads threads, each with its own query buffer. */
+template <typename RangeFn>
+static void
+parallel_ranges(size_t num_items, size_t num_threads, RangeFn fn)
+{
+  num_threads = std::min(num_threads, num_items);
+  if (num_threads <= 1) {
+    SpatialIndex::QueryBuffer buffer;
+    fn(0, num_items, buffer);
+    return;
+  }
+
+  std::vector<std::thread> threads;
+  std::vector<std::exception_ptr> failures(num_threads);
+  size_t t, per_thread = num_items / num_threads,
+    remainder = num_items % num_threads, start = 0;
+  for (t=0; t<num_threads; ++t) {
+    size_t end = start + per_thread + (t < remainder ? 1 : 0);
+    threads.emplace_back([&, t, start, end]() {
+      try { SpatialIndex::QueryBuffer buffer; fn(start, end, buffer); }
+      catch (...) { failures[t] = std::current_exception(); }
+    });
+    start = end;
+  }
+  for (std::thread& th : threads)
+    th.join();
+  for (t=0; t<num_threads; ++t)
+    if (failures[t])
+      std::rethrow_exception(failures[t]);
+}
+
+
+KNNInfoEstimator::KNNInfoEstimator(unsigned short alg, int k):
+  miAlg(alg), numNeighbors(k), dimX(0)
+{ }
+
+
+KNNInfoEstimator::~KNNInfoEstimator()
+{ }
+
+
+void KNNInfoEstimator::x_samples(const RealMatrix& samples, int dim_x)
+{
+  dimX = dim_x;
+  int i, num_samples = samples.numCols();
+  xIndex.initialize(dimX, num_samples, SpatialIndex::LINF_NORM);
+  for (i=0; i<num_samples; ++i)
+    xIndex.insert(samples[i]);
+}
+
+
+Real KNNInfoEstimator::
+knn_distance(const SpatialIndex& index, const Real* x, int& k_i,
+	     SpatialIndex::QueryBuffer& buffer, SizetArray* neighbors)
+{
+  // the k_i+1'st neighbor, since a sample is its own nearest neighbor
+  index.k_nearest(x, k_i+1, buffer);
+  Real dist = buffer.neighbors.back().first;
+  size_t j, num_nbrs = buffer.neighbors.size();
+  if (dist == 0.) {
+    // advance to the first neighbor at positive distance, if any
+    size_t num_coincident = index.count_within(x, 0., buffer);
+    if (num_coincident < index.size()) {
+      index.k_nearest(x, num_coincident + 1, buffer);
+      dist = buffer.neighbors.back().first;
+      k_i = num_nbrs = num_coincident;
+    }
+  }
+  if (neighbors) {
+    neighbors->resize(num_nbrs);
+    for (j=0; j<num_nbrs; ++j)
+      (*neighbors)[j] = buffer.neighbors[j].second;
+  }
+  return dist;
+}
+
+
+Real KNNInfoEstimator::mutual_info(const RealMatrix& xy_samples, int dim_y) const
+{
+  SpatialIndex::QueryBuffer buffer;
+  return mutual_info(xy_samples, dim_y, buffer);
+}
+
+
+void KNNInfoEstimator::
+mutual_info(const RealMatrixArray& xy_samples, int dim_y, RealVector& mi_est,
+	    size_t num_threads) const
+{
+  size_t num_cand = xy_samples.size();
+  mi_est.sizeUninitialized(num_cand);
+  num_threads = dakota::util::num_threads(num_threads, num_cand);
+  parallel_ranges(num_cand, num_threads,
+    [&](size_t start, size_t end, SpatialIndex::QueryBuffer& buffer) {
+      for (size_t c=start; c<end; ++c)
+	mi_est[c] = mutual_info(xy_samples[c], dim_y, buffer);
+    });
+}
+
+
+Real KNNInfoEstimator::
+mutual_info(const RealMatrix& xy_samples, int dim_y,
+	    SpatialIndex::QueryBuffer& buffer) const
+{
+  int i, j, num_samples = xy_samples.numCols(), dim = dimX + dim_y;
+  if (xIndex.size() != num_samples) {
+    Cerr << "\nError: " << num_samples << " joint samples do not match the "
+	 << xIndex.size() << " indexed X samples in KNNInfoEstimator::"
+	 << "mutual_info()." << std::endl;
+    abort_handler(METHOD_ERROR);
+  }
+
+  // standardize the joint samples
+  RealVector mean_xy(dim), std_xy(dim);
+  for (i=0; i<num_samples; ++i)
+    for (j=0; j<dim; ++j)
+      mean_xy[j] += xy_samples(j,i);
+  for (j=0; j<dim; ++j)
+    mean_xy[j] /= double(num_samples);
+  for (i=0; i<num_samples; ++i)
+    for (j=0; j<dim; ++j)
+      std_xy[j] += std::pow(xy_samples(j,i) - mean_xy[j], 2.);
+  for (j=0; j<dim; ++j)
+    std_xy[j] = std::sqrt(std_xy[j] / (double(num_samples) - 1.));
+  RealMatrix norm_xy(dim, num_samples, false);
+  SpatialIndex xy_index, y_index;
+  xy_index.initialize(dim, num_samples, SpatialIndex::LINF_NORM);
+  y_index.initialize(dim_y, num_samples, SpatialIndex::LINF_NORM);
+  for (i=0; i<num_samples; ++i) {
+    for (j=0; j<dim; ++j)
+      norm_xy(j,i) = (xy_samples(j,i) - mean_xy[j]) / std_xy[j];
+    xy_index.insert(norm_xy[i]);
+    y_index.insert(xy_samples[i] + dimX);
+  }
+
+  // count marginal neighbors within the joint k-NN distance
+  SizetArray neighbors;
+  Real marg_sum = 0.;
+  for (i=0; i<num_samples; ++i) {
+    const Real *x_i = xy_samples[i], *y_i = x_i + dimX;
+    int k_i = numNeighbors;
+    size_t n_x, n_y;
+    if (miAlg == MI_ALG_KSG2) {
+      knn_distance(xy_index, norm_xy[i], k_i, buffer, &neighbors);
+      Real e_x = 0., e_y = 0.;
+      for (size_t n=1; n<neighbors.size(); ++n) {
+	e_x = std::max(e_x, xIndex.distance_measure(neighbors[n], x_i));
+	e_y = std::max(e_y, y_index.distance_measure(neighbors[n], y_i));
+      }
+      n_x = xIndex.count_within(x_i, e_x, buffer);
+      n_y = y_index.count_within(y_i, e_y, buffer);
+    }
+    else {
+      Real dist = knn_distance(xy_index, norm_xy[i], k_i, buffer);
+      n_x = xIndex.count_within(x_i, dist, buffer);
+      n_y = y_index.count_within(y_i, dist, buffer);
+    }
+    marg_sum += boost::math::digamma((Real)n_x)
+             +  boost::math::digamma((Real)n_y);
+  }
+
+  Real mi_est = boost::math::digamma((Real)numNeighbors)
+    - marg_sum / double(num_samples)
+    + boost::math::digamma((Real)num_samples);
+  if (miAlg == MI_ALG_KSG2)
+    mi_est -= 1. / double(numNeighbors);
+  return mi_est;
+}
+
+
+Real KNNInfoEstimator::
+kl_divergence(const RealMatrix& x_samples, const RealMatrix& y_samples,
+	      size_t dim, size_t num_threads)
+{
+  size_t i, num_x = x_samples.numCols(), num_y = y_samples.numCols();
+  SpatialIndex x_index, y_index;
+  x_index.initialize(dim, num_x); y_index.initialize(dim, num_y);
+  for (i=0; i<num_x; ++i)
+    x_index.insert(x_samples[i]);
+  for (i=0; i<num_y; ++i)
+    y_index.insert(y_samples[i]);
+
+  // k is recorded for each distance so that if it needs to be adapted
+  // (if kNN dist = 0), we can calculate the correction term; the first
+  // neighbor of a sample among the X samples is itself
+  IntVector k_xy(num_x), k_xx(num_x);
+  k_xy.putScalar(6); k_xx.putScalar(7);
+  RealVector dist_xy(num_x, false), dist_xx(num_x, false);
+  num_threads = dakota::util::num_threads(num_threads,
+					  num_x / KNN_THREAD_QUERIES);
+  parallel_ranges(num_x, num_threads,
+    [&](size_t start, size_t end, SpatialIndex::QueryBuffer& buffer) {
+      for (size_t q=start; q<end; ++q) {
+	dist_xy[q] = knn_distance(y_index, x_samples[q], k_xy[q], buffer);
+	dist_xx[q] = knn_distance(x_index, x_samples[q], k_xx[q], buffer);
+      }
+    });
+
+  Real log_sum = 0., digamma_sum = 0.;
+  for (i=0; i<num_x; ++i) {
+    log_sum += std::log(dist_xy[i] / dist_xx[i]);
+    if (k_xy[i] != k_xx[i] - 1)
+      digamma_sum += boost::math::digamma((Real)(k_xx[i] - 1))
+	- boost::math::digamma((Real)k_xy[i]);
+  }
+  return (double(dim) * log_sum + digamma_sum) / double(num_x)
+    + std::log( double(num_y) / (double(num_x) - 1.) );
+}
+
+} // namespace Dakota
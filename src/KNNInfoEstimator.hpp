@@ -0,0 +1,90 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#ifndef KNN_INFO_ESTIMATOR_H
+#define KNN_INFO_ESTIMATOR_H
+
+#include "dakota_data_types.hpp"
+#include "SpatialIndex.hpp"
+
+
+namespace Dakota {
+
+/// Kraskov-Stoegbauer-Grassberger mutual information estimators
+enum miAlg : unsigned short {MI_ALG_KSG1 = 0, MI_ALG_KSG2 = 1};
+
+
+/// k-nearest neighbor estimators of mutual information and KL divergence
+
+/** Mutual information is estimated between a fixed set of X samples
+    (e.g., posterior parameter samples) and the Y samples of any number
+    of candidates (e.g., model responses at candidate experimental
+    designs).  The k-d tree of the X marginal is built once and shared
+    by all candidates, which are estimated concurrently, each thread
+    with its own query buffers.  Samples are read in place from the
+    column-major sample matrices (one column per sample).
+
+    The estimates reproduce those of the ANN-based implementation: the
+    joint neighbors are found in the max norm on standardized samples,
+    and the marginal counts (which include the sample itself) use the
+    unstandardized samples. */
+
+class KNNInfoEstimator
+{
+public:
+
+  /// constructor
+  KNNInfoEstimator(unsigned short alg = MI_ALG_KSG1, int k = 6);
+  /// destructor
+  ~KNNInfoEstimator();
+
+  /// index the X samples: the leading dim_x rows of each column
+  void x_samples(const RealMatrix& samples, int dim_x);
+
+  /// mutual information between the indexed X samples and the remaining
+  /// dim_y rows of xy_samples, whose leading rows hold the X samples
+  Real mutual_info(const RealMatrix& xy_samples, int dim_y) const;
+  /// mutual information for each of a set of candidates, distributed
+  /// among up to num_threads threads (thread budget if 0)
+  void mutual_info(const RealMatrixArray& xy_samples, int dim_y,
+		   RealVector& mi_est, size_t num_threads = 0) const;
+
+  /// Kullback-Leibler divergence of the distribution of the X samples
+  /// from that of the Y samples (leading dim rows of each column), with
+  /// the queries distributed among up to num_threads threads
+  static Real kl_divergence(const RealMatrix& x_samples,
+			    const RealMatrix& y_samples, size_t dim,
+			    size_t num_threads = 0);
+
+private:
+
+  /// mutual information for a candidate using the given query buffer
+  Real mutual_info(const RealMatrix& xy_samples, int dim_y,
+		   SpatialIndex::QueryBuffer& buffer) const;
+
+  /// distance measure to the k_i+1'st nearest neighbor of x in index,
+  /// advanced past coincident neighbors (updating k_i) as for a
+  /// positive distance, and optionally the indices of those neighbors
+  static Real knn_distance(const SpatialIndex& index, const Real* x,
+			   int& k_i, SpatialIndex::QueryBuffer& buffer,
+			   SizetArray* neighbors = NULL);
+
+  /// estimator variant
+  unsigned short miAlg;
+  /// number of nearest neighbors
+  int numNeighbors;
+  /// number of X coordinates
+  int dimX;
+  /// k-d tree of the X marginal (max norm)
+  SpatialIndex xIndex;
+};
+
+} // namespace Dakota
+
+#endif
@@ -12,7 +12,11 @@
 
 #include "dakota_data_types.hpp"
 #include "dakota_stat_util.hpp"
+#include "util_threads.hpp"
 // #include "ProblemDescDB.hpp"
+#include <algorithm>
+#include <exception>
+#include <thread>
 
 namespace Dakota {
 
@@ -182,6 +186,53 @@ protected:
       RealMatrix& points
   ) = 0;
 
+  /// Split the point indices [nMin, nMax) into contiguous blocks and call
+  /// `generate_block(kStart, kEnd)` for each block, one thread per block
+  /// when there are enough `dimension`-dimensional points to amortize
+  /// thread startup
+  /// NOTE: `generate_block` must only write the points in its own block
+  template<typename BlockGenerator>
+  void generate_blocks(
+    const size_t nMin,
+    const size_t nMax,
+    const size_t dimension,
+    BlockGenerator generate_block
+  )
+  {
+    /// Minimum number of point coordinates generated per thread
+    const size_t minBlockWork = 1 << 16;
+    size_t numPoints = nMax - nMin;
+    size_t numThreads = std::min<size_t>(
+      dakota::util::thread_budget(),
+      numPoints * dimension / minBlockWork
+    );
+    if ( numThreads <= 1 )
+    {
+      generate_block(nMin, nMax);
+      return;
+    }
+
+    std::vector<std::thread> threads;
+    std::vector<std::exception_ptr> failures(numThreads);
+    size_t blockSize = numPoints / numThreads;
+    size_t remainder = numPoints % numThreads;
+    size_t kStart = nMin;
+    for ( size_t t = 0; t < numThreads; ++t )
+    {
+      size_t kEnd = kStart + blockSize + ( t < remainder ? 1 : 0 );
+      threads.emplace_back([&, t, kStart, kEnd]() {
+        try { generate_block(kStart, kEnd); }
+        catch (...) { failures[t] = std::current_exception(); }
+      });
+      kStart = kEnd;
+    }
+    for ( auto& thread : threads )
+      thread.join();
+    for ( auto& failure : failures )
+      if ( failure )
+        std::rethrow_exception(failure);
+  }
+
 private:
 
   /// Perform checks on dMax
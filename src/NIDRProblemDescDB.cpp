@@ -6568,8 +6568,10 @@ static bool
 	MP_(evalCacheFlag),
 	MP_(fileSaveFlag),
 	MP_(fileTagFlag),
+	MP_(messageBatchFlag),
 	MP_(nearbyEvalCacheFlag),
 	MP_(numpyFlag),
+	MP_(quantizedCacheFlag),
 	MP_(restartFileFlag),
 	MP_(templateReplace),
 	MP_(useWorkdir),
@@ -6580,8 +6582,10 @@ static int
 	MP_(asynchLocalAnalysisConcurrency),
 	MP_(asynchLocalEvalConcurrency),
 	MP_(evalServers),
+	MP_(messageBatchSize),
 	MP_(procsPerAnalysis),
-	MP_(procsPerEval);
+	MP_(procsPerEval),
+	MP_(quantizedCacheSize);
 
 static Real
 	MP_(nearbyEvalCacheTol);
@@ -6766,6 +6770,7 @@ static Real
 	MP_(mutationScale),
 	MP_(percentVarianceExplained),
         MP_(priorPropCovMult),
+	MP_(pushforwardKDETol),
 	MP_(refinementRate),
 	MP_(regressionL2Penalty),
 	MP_(shrinkagePercent),	// should be called shrinkageFraction
@@ -6904,6 +6909,7 @@ static bool
 	MP_(crossValidation),
 	MP_(crossValidNoiseOnly),
 	MP_(dOptimal),
+	MP_(dreamBatchGenerations),
         MP_(evaluatePosteriorDensity),
 	MP_(expansionFlag),
 	MP_(exportSampleSeqFlag),
@@ -7012,6 +7018,7 @@ static int
 	MP_(totalPatternSize),
 	MP_(verifyLevel),
 	MP_(vbdViaSamplingNumBins),
+	MP_(vbdBootstrapSamples),
   MP_(log2MaxPoints),
   MP_(numberOfBits),
   MP_(scrambleSize);
@@ -7776,7 +7783,10 @@ static bool
 	MP_(tabularDataFlag);
 
 static int
+        MP_(evalBufferFlushInterval),
+        MP_(evalBufferSize),
         MP_(outputPrecision),
+        MP_(restartFlushInterval),
         MP_(stopRestart);
 
 //#undef MP2
@@ -29,13 +29,7 @@
 #include "boost/random/variate_generator.hpp"
 #include "boost/generator_iterator.hpp"
 #include "boost/math/special_functions/digamma.hpp"
-// BMA: May need to better manage DLL export / import from ANN in the future
-// #ifdef DLL_EXPORTS
-// #undef DLL_EXPORTS
-// #endif
-#include "ANN/ANN.h"
-//#include "ANN/ANNperf.h"
-//#include "ANN/ANNx.h"
+#include "KNNInfoEstimator.hpp"
 #include "dakota_data_util.hpp"
 //#include "dakota_tabular_io.hpp"
 #include "DiscrepancyCorrection.hpp"
@@ -46,7 +40,9 @@ static const char rcsId[]="@(#) $Id$";
 
 namespace Dakota {
 
-enum miAlg : unsigned short {MI_ALG_KSG1 = 0, MI_ALG_KSG2 = 1};
+/// number of experimental design candidates whose lofi model responses
+/// are held for a concurrent mutual information estimate
+static const size_t MI_CANDIDATE_BLOCK = 32;
 
 // initialization of statics
 NonDBayesCalibration* NonDBayesCalibration::nonDBayesInstance(NULL);
@@ -1384,29 +1380,47 @@ void NonDBayesCalibration::choose_batch_from_mutual_info( int random_seed,
       build_error_matrix(sim_error_vec, sim_error_matrix, random_seed);
     }
 
-    for (size_t i=0; i < design_matrix.size(); i++) {
-      const Variables& xi_i = design_matrix[i]; // active are config vars
-      mcmcModel.current_variables().active_to_inactive_variables(xi_i);
-
-      build_hi2lo_xmatrix(Xmatrix, batch_n, mi_chain, sim_error_matrix);
+    // the posterior samples, and hence the k-d tree of the theta
+    // marginal, are common to all candidates
+    KNNInfoEstimator mi_estimator(mutualInfoAlg);
+    mi_estimator.x_samples(mi_chain, numContinuousVars);
+
+    // evaluate the lofi model for a block of candidates, then estimate
+    // their mutual information concurrently
+    size_t i, blk_start, blk_end, num_cand = design_matrix.size();
+    RealMatrixArray cand_xmatrices;
+    RealVector cand_MI;
+    for (blk_start=0; blk_start<num_cand; blk_start=blk_end) {
+      blk_end = std::min(blk_start + MI_CANDIDATE_BLOCK, num_cand);
+      cand_xmatrices.resize(blk_end - blk_start);
+      for (i=blk_start; i<blk_end; ++i) {
+	const Variables& xi_i = design_matrix[i]; // active are config vars
+	mcmcModel.current_variables().active_to_inactive_variables(xi_i);
+	build_hi2lo_xmatrix(Xmatrix, batch_n, mi_chain, sim_error_matrix);
+	cand_xmatrices[i - blk_start] = Xmatrix; // deep copy
+      }
 
       // calculate the mutual information b/w post theta and lofi responses
-      Real MI = knn_mutual_info(Xmatrix, numContinuousVars,
-			        batch_n * numFunctions, mutualInfoAlg);
-      if (outputLevel >= NORMAL_OUTPUT) 
-        print_hi2lo_status(num_it, i, xi_i, MI);
-    
-      // Now track max MI:
-      if (i == 0) {
-        max_MI = MI;
-        optimal_ind = i;
+      mi_estimator.mutual_info(cand_xmatrices, batch_n * numFunctions,
+			       cand_MI);
+
+      for (i=blk_start; i<blk_end; ++i) {
+	Real MI = cand_MI[i - blk_start];
+	if (outputLevel >= NORMAL_OUTPUT)
+	  print_hi2lo_status(num_it, i, design_matrix[i], MI);
+
+	// Now track max MI:
+	if (i == 0) {
+	  max_MI = MI;
+	  optimal_ind = i;
+	}
+	else
+	  if ( MI > max_MI) {
+	    max_MI = MI;
+	    optimal_ind = i;
+	  }
       }
-      else 
-        if ( MI > max_MI) {
-          max_MI = MI;
-          optimal_ind = i;
-        }
-    } // end for over the number of candidates
+    } // end for over the blocks of candidates
     
     MI_vec[batch_n-1] = max_MI;
 
@@ -2378,6 +2392,82 @@ log_likelihood(const RealVector& residuals, const RealVector& all_params)
 }
 
 
+void NonDBayesCalibration::
+log_likelihood(const RealMatrix& residuals, const RealMatrix& all_params,
+	       RealVector& log_like)
+{
+  int i, num_samples = residuals.numCols(), num_resid = residuals.numRows();
+  log_like.sizeUninitialized(num_samples);
+  Real half_nr_log2pi = num_resid * HALF_LOG_2PI;
+
+  // without hyper-parameters, the determinant is common to all samples
+  Real half_log_det = (numHyperparams) ? 0. :
+    expData.half_log_cov_determinant(RealVector(), obsErrorMultiplierMode);
+  Teuchos::BLAS<int, Real> blas;
+  for (i=0; i<num_samples; ++i) {
+    if (numHyperparams) {
+      RealVector hyper_params(Teuchos::View, const_cast<Real*>(all_params[i])
+			      + numContinuousVars, numHyperparams);
+      half_log_det =
+	expData.half_log_cov_determinant(hyper_params, obsErrorMultiplierMode);
+    }
+    // misfit defined as 1/2 r^T (mult^2*Gamma_d)^{-1} r
+    const Real* resid_i = residuals[i];
+    Real misfit = blas.DOT(num_resid, resid_i, 1, resid_i, 1) / 2.0;
+    log_like[i] = -half_nr_log2pi - half_log_det - misfit;
+  }
+}
+
+
+/** For independent random variables, the marginal densities are
+    accumulated one variable at a time over all samples, so that the
+    distribution is resolved and checked once per batch rather than
+    once per sample. */
+void NonDBayesCalibration::
+prior_density(const RealMatrix& samples, RealVector& pdf_vals)
+{
+  int j, num_samples = samples.numCols();
+  pdf_vals.sizeUninitialized(num_samples);
+
+  const Pecos::MultivariateDistribution& mv_dist
+    = (standardizedSpace) ? residualModel.multivariate_distribution()
+    : iteratedModel.multivariate_distribution();
+  if (mv_dist.correlation()) {
+    // the joint density does not factor by variable
+    for (j=0; j<num_samples; ++j) {
+      RealVector sample_j(Teuchos::View, const_cast<Real*>(samples[j]),
+			  samples.numRows());
+      pdf_vals[j] = prior_density(sample_j);
+    }
+    return;
+  }
+
+  const BitArray& active_vars = mv_dist.active_variables();
+  bool no_mask = active_vars.empty();
+  size_t i, v, num_rv = mv_dist.random_variables().size(),
+    active_rv = (no_mask) ? num_rv : active_vars.count();
+  if (active_rv != numContinuousVars) {
+    Cerr << "Error: active variable size mismatch in NonDBayesCalibration::"
+	 << "prior_density(): " << active_rv << " expected, "
+	 << numContinuousVars << " provided." << std::endl;
+    abort_handler(METHOD_ERROR);
+  }
+
+  pdf_vals.putScalar(1.);
+  size_t av_cntr = 0;
+  for (v=0; v<num_rv; ++v)
+    if (no_mask || active_vars[v]) {
+      for (j=0; j<num_samples; ++j)
+	pdf_vals[j] *= mv_dist.pdf(samples(av_cntr, j), v);
+      ++av_cntr;
+    }
+  // the estimated param is mult^2 ~ invgamma(alpha,beta)
+  for (i=0; i<numHyperparams; ++i)
+    for (j=0; j<num_samples; ++j)
+      pdf_vals[j] *= invGammaDists[i].pdf(samples(numContinuousVars + i, j));
+}
+
+
 void NonDBayesCalibration::prior_cholesky_factorization()
 {
   // factorization to be performed offline (init time) and used online
@@ -2971,18 +3061,38 @@ void NonDBayesCalibration::calculate_evidence()
     // Draw samples from prior distribution 
     RealMatrix prior_dist_samples(num_params, num_prior_samples);
     prior_sample_matrix(prior_dist_samples);
-    // Calculate likelihood for each sample
-    double sum_like = 0.;
+    // Calculate likelihood for each sample, evaluating the samples
+    // concurrently if supported
+    RealMatrix residuals(residualModel.response_size(), num_prior_samples);
     for (int i = 0; i < num_prior_samples; i++) {
-      RealVector params = Teuchos::getCol(Teuchos::View, prior_dist_samples, i);
-      RealVector cont_params = params;
-      cont_params.resize(numContinuousVars);  
+      RealVector cont_params(Teuchos::View, prior_dist_samples[i],
+			     numContinuousVars);
       residualModel.continuous_variables(cont_params);
-      residualModel.evaluate();
-      RealVector residual = residualModel.current_response().function_values();
-      double log_like = log_likelihood(residual, params);
-      sum_like += std::exp(log_like);
+      if (residualModel.asynch_flag())
+	residualModel.evaluate_nowait();
+      else {
+	residualModel.evaluate();
+	Teuchos::setCol(residualModel.current_response().function_values(),
+			i, residuals);
+      }
     }
+    if (residualModel.asynch_flag()) {
+      const IntResponseMap& resp_map = residualModel.synchronize();
+      if (resp_map.size() != (size_t)num_prior_samples) {
+	Cerr << "\nError: number of residual evaluations (" << resp_map.size()
+	     << ") does not match number of prior samples ("
+	     << num_prior_samples << ") in calculate_evidence()." << std::endl;
+	abort_handler(METHOD_ERROR);
+      }
+      IntRespMCIter r_cit = resp_map.begin();
+      for (int i = 0; r_cit != resp_map.end(); ++i, ++r_cit)
+	Teuchos::setCol(r_cit->second.function_values(), i, residuals);
+    }
+    RealVector log_like;
+    log_likelihood(residuals, prior_dist_samples, log_like);
+    double sum_like = 0.;
+    for (int i = 0; i < num_prior_samples; i++)
+      sum_like += std::exp(log_like[i]);
     double evidence = sum_like/num_prior_samples;
     Cout << "Model evidence (Monte Carlo) = " << evidence << '\n';
     //Cout << "num samples = " << num_prior_samples << '\n';
@@ -3325,72 +3435,7 @@ void NonDBayesCalibration::prior_sample_matrix(RealMatrix& prior_dist_samples)
 
 Real NonDBayesCalibration::knn_kl_div(RealMatrix& distX_samples,
     			 	RealMatrix& distY_samples, size_t dim)
-{
-  approxnn::normSelector::instance().method(approxnn::L2_NORM);
-
-  size_t NX = distX_samples.numCols();
-  size_t NY = distY_samples.numCols();
-  //size_t dim = numContinuousVars; 
-  
-  // k is recorded for each distance so that if it needs to be adapted
-  // (if kNN dist = 0), we can calculate the correction term 
-  IntVector k_vec_XY(NX);
-  k_vec_XY.putScalar(6); //k default set to 6
-  IntVector k_vec_XX(NX);
-  k_vec_XX.putScalar(7); //k default set to 6
-  			 //1st neighbor is self, so need k+1 for XtoX
-  double eps = 0.0; //default ann error
-   
-  // Copy distX samples into ANN data types
-  ANNpointArray dataX;
-  dataX = annAllocPts(NX, dim);
-  RealVector col(dim);
-  for (int i = 0; i < NX; i++){
-    col = Teuchos::getCol(Teuchos::View, distX_samples, i);
-    for (int j = 0; j < dim; j++){
-      dataX[i][j] = col[j];
-    }
-  } 
-  // Copy distY samples into ANN data types
-  ANNpointArray dataY;
-  dataY = annAllocPts(NY, dim);
-  for (int i = 0; i < NY; i++){
-    col = Teuchos::getCol(Teuchos::View, distY_samples, i);
-    for (int j = 0; j < dim; j++){
-      dataY[i][j] = col[j];
-    }
-  } 
-  
-  // calculate vector of kNN distances from dist1 to dist2
-  RealVector XtoYdistances(NX);
-  ann_dist(dataX, dataY, XtoYdistances, NX, NY, dim, k_vec_XY, eps);
-  // calculate vector of kNN distances from dist1 to itself
-  RealVector XtoXdistances(NX);
-  ann_dist(dataX, dataX, XtoXdistances, NX, NX, dim, k_vec_XX, eps);
-  
-  double log_sum = 0;
-  double digamma_sum = 0;
-  double rat;
-  for (int i = 0; i < NX; i++){
-    rat = XtoYdistances[i]/XtoXdistances[i];
-    log_sum += log(XtoYdistances[i]/XtoXdistances[i]);
-    if (k_vec_XY[i] != (k_vec_XX[i]-1)){ //XtoX: first NN is self
-      double psiX = boost::math::digamma(k_vec_XX[i]-1);
-      double psiY = boost::math::digamma(k_vec_XY[i]);
-      digamma_sum += psiX - psiY;
-    }
-  }
-  Real Dkl_est = 0.0;
-  Dkl_est = (double(dim)*log_sum + digamma_sum)/double(NX)
-          + log( double(NY)/(double(NX)-1) );
-
-  annDeallocPts( dataX );
-  annDeallocPts( dataY );
-
-  approxnn::normSelector::instance().reset();
-
-  return Dkl_est;
-}
+{ return KNNInfoEstimator::kl_divergence(distX_samples, distY_samples, dim); }
 
 void NonDBayesCalibration::mutual_info_buildX()
 {
@@ -3460,237 +3505,9 @@ void NonDBayesCalibration::mutual_info_buildX()
 Real NonDBayesCalibration::knn_mutual_info(RealMatrix& Xmatrix, int dimX,
     int dimY, unsigned short alg)
 {
-  approxnn::normSelector::instance().method(approxnn::LINF_NORM);
-
-  //std::ofstream test_stream("kam1.txt");
-  //test_stream << "Xmatrix = " << Xmatrix << '\n';
-  //Cout << "Xmatrix = " << Xmatrix << '\n';
-
-  int num_samples = Xmatrix.numCols();
-  int dim = dimX + dimY;
-
-  // Cast Xmatrix into ANN data structure
-  ANNpointArray dataXY;
-  dataXY = annAllocPts(num_samples, dim);
-  RealVector col(dim);
-  for (int i = 0; i < num_samples; i++){
-    col = Teuchos::getCol(Teuchos::View, Xmatrix, i);
-    for (int j = 0; j < dim; j++){
-      dataXY[i][j] = col[j];
-    }
-  }
-
-  // Normalize data
-  ANNpoint meanXY, stdXY;
-  meanXY = annAllocPt(dim); //means
-  for (int i = 0; i < num_samples; i++){
-    for(int j = 0; j < dim; j++){
-      meanXY[j] += dataXY[i][j];
-    }
-  }
-  for (int j = 0; j < dim; j++){
-    meanXY[j] = meanXY[j]/double(num_samples);
-    //Cout << "mean" << j << " = " << meanXY[j] << '\n';
-  }
-  stdXY = annAllocPt(dim); //standard deviations
-  for (int i = 0; i < num_samples; i++){
-    for (int j = 0; j < dim; j++){
-      stdXY[j] += pow (dataXY[i][j] - meanXY[j], 2.0);
-    }
-  }
-  for (int j = 0; j < dim; j++){
-    stdXY[j] = sqrt( stdXY[j]/(double(num_samples)-1.0) );
-    //Cout << "std" << j << " = " << stdXY[j] << '\n';
-  }
-  for (int i = 0; i < num_samples; i++){
-    for (int j = 0; j < dim; j++){
-      dataXY[i][j] = ( dataXY[i][j] - meanXY[j] )/stdXY[j];
-    }
-    //Cout << "dataXY = " << dataXY[i][0] << '\n';
-  }
-
-  // Get knn-distances for Xmatrix
-  RealVector XYdistances(num_samples);
-  Int2DArray XYindices(num_samples);
-  IntVector k_vec(num_samples);
-  int k = 6;
-  k_vec.putScalar(k); // for self distances, need k+1
-  double eps = 0.0;
-  ann_dist(dataXY, dataXY, XYdistances, XYindices, num_samples, num_samples, 
-           dim, k_vec, eps);
-
-  // Build marginals
-  ANNpointArray dataX, dataY;
-  dataX = annAllocPts(num_samples, dimX);
-  dataY = annAllocPts(num_samples, dimY);
-  //RealMatrix chainX(dimX, num_samples);
-  //RealMatrix chainY(dimY, num_samples);
-  for(int i = 0; i < num_samples; i++){
-    col = Teuchos::getCol(Teuchos::View, Xmatrix, i);
-    //Cout << "col = " << col << '\n';
-    for(int j = 0; j < dimX; j++){
-      //dataX[i][j] = dataXY[i][j];
-      //Cout << "col " << j << " = " << col[j] << '\n';
-      //chainX[i][j] = col[j];
-      dataX[i][j] = col[j];
-    }
-    for(int j = 0; j < dimY; j++){
-      //dataY[i][j] = dataXY[i][dimX+j];
-      //chainY[i][j] = col[dimX+j];
-      dataY[i][j] = col[dimX+j];
-    }
-  }
-  //Cout << "chainX = " << chainX;
-  ANNkd_tree* kdTreeX;
-  ANNkd_tree* kdTreeY;
-  kdTreeX = new ANNkd_tree(dataX, num_samples, dimX);
-  kdTreeY = new ANNkd_tree(dataY, num_samples, dimY);
-
-  double marg_sum = 0.0;
-  int n_x, n_y;
-  for(int i = 0; i < num_samples; i++){
-    if (alg == MI_ALG_KSG2) { //alg=1, ksg2
-      IntArray XYind_i = XYindices[i];	
-      RealArray ex_vec(XYind_i.size()-1);
-      RealArray ey_vec(XYind_i.size()-1);
-      for(int j = 1; j < XYind_i.size(); j ++) {
-	ex_vec[j-1] = annDist(dimX, dataX[i], dataX[XYind_i[j]]);
-	ey_vec[j-1] = annDist(dimY, dataY[i], dataY[XYind_i[j]]);
-      }
-      ANNdist e_x = *std::max_element(ex_vec.begin(), ex_vec.end());
-      ANNdist e_y = *std::max_element(ey_vec.begin(), ey_vec.end());
-      /*
-      ANNdist e = max(e_x, e_y);
-      n_x = kdTreeX->annkFRSearch(dataX[i], e, 0, NULL, NULL, eps);
-      n_y = kdTreeY->annkFRSearch(dataY[i], e, 0, NULL, NULL, eps);
-      */
-      n_x = kdTreeX->annkFRSearch(dataX[i], e_x, 0, NULL, NULL, eps);
-      n_y = kdTreeY->annkFRSearch(dataY[i], e_y, 0, NULL, NULL, eps);
-    }
-    else { //alg=0, ksg1
-      n_x = kdTreeX->annkFRSearch(dataX[i], XYdistances[i], 0, NULL, 
-  				    NULL, eps);
-      n_y = kdTreeY->annkFRSearch(dataY[i], XYdistances[i], 0, NULL,
-  				    NULL, eps);
-    }
-    double psiX = boost::math::digamma(n_x);
-    double psiY = boost::math::digamma(n_y);
-    //double psiX = boost::math::digamma(n_x+1);
-    //double psiY = boost::math::digamma(n_y+1);
-    marg_sum += psiX + psiY;
-    //test_stream <<"i = "<< i <<", nx = "<< n_x <<", ny = "<< n_y <<'\n';
-    //test_stream << "psiX = " << psiX << '\n';
-    //test_stream << "psiY = " << psiY << '\n';
-  }
-  double psik = boost::math::digamma(k);
-  double psiN = boost::math::digamma(num_samples);
-  double MI_est = psik - (marg_sum/double(num_samples)) + psiN;
-  if (alg == MI_ALG_KSG2) {
-    MI_est = MI_est - 1/double(k);
-  }
-  //test_stream << "psi_k = " << psik << '\n';
-  //test_stream << "marg_sum = " << marg_sum << '\n';
-  //test_stream << "psiN = " << psiN << '\n';
-  //test_stream << "MI_est = " << MI_est << '\n';
-
-  // Dealloc memory
-  delete kdTreeX;
-  delete kdTreeY;
-  annDeallocPts(dataX);
-  annDeallocPts(dataY);
-  annDeallocPts(dataXY);
-
-  approxnn::normSelector::instance().reset();
-
-  // Compare to dkl
-  /*
-  double kl_est = knn_kl_div(Xmatrix, Xmatrix);
-  test_stream << "KL = " << kl_est << '\n';
-  Cout << "KL = " << kl_est << '\n';
-  */
-  return MI_est;
-
-}
-
-void NonDBayesCalibration::ann_dist(const ANNpointArray matrix1, 
-     const ANNpointArray matrix2, RealVector& distances, int NX, int NY, 
-     int dim2, IntVector& k_vec, double eps)
-{
-
-  ANNkd_tree* kdTree;
-  kdTree = new ANNkd_tree( matrix2, NY, dim2 );
-  for (unsigned int i = 0; i < NX; ++i){
-    int k_i = k_vec[i] ;
-    ANNdistArray knn_dist = new ANNdist[k_i+1];
-    ANNidxArray knn_ind = new ANNidx[k_i+1];
-    //calc min number of distances needed
-    kdTree->annkSearch(matrix1[ i ], k_i+1, knn_ind, knn_dist, eps);
-    double dist = knn_dist[k_i];
-    if (dist == 0.0){
-      ANNdistArray knn_dist_i = new ANNdist[NY];
-      ANNidxArray knn_ind_i = new ANNidx[NY];
-      //calc distances for whole array
-      kdTree->annkSearch(matrix1[ i ], NY, knn_ind_i, knn_dist_i, eps); 
-      for (unsigned int j = k_i+1; j < NY; ++j){
-	if (knn_dist_i[j] > 0.0){
-	  dist = knn_dist_i[j];
-	  k_vec[i] = j;
-	  break;
-	}
-      }
-      delete [] knn_ind_i;
-      delete [] knn_dist_i;
-    }
-    distances[i] = dist;
-    delete [] knn_ind;
-    delete [] knn_dist;
-  }
-  delete kdTree;
-  annClose();
-}
-
-void NonDBayesCalibration::ann_dist(const ANNpointArray matrix1, 
-     const ANNpointArray matrix2, RealVector& distances, Int2DArray& indices, 
-     int NX, int NY, int dim2, IntVector& k_vec, 
-     double eps)
-{
-  ANNkd_tree* kdTree;
-  kdTree = new ANNkd_tree( matrix2, NY, dim2 );
-  for (unsigned int i = 0; i < NX; ++i){
-    int k_i = k_vec[i] ;
-    ANNdistArray knn_dist = new ANNdist[k_i+1];
-    ANNidxArray knn_ind = new ANNidx[k_i+1];
-    //calc min number of distances needed
-    kdTree->annkSearch(matrix1[ i ], k_i+1, knn_ind, knn_dist, eps);
-    double dist = knn_dist[k_i];
-    IntArray ind(k_i+1);
-    for (int j = 0; j < k_i+1; j ++) 
-      ind[j] = knn_ind[j];
-    if (dist == 0.0){
-      ANNdistArray knn_dist_i = new ANNdist[NY];
-      ANNidxArray knn_ind_i = new ANNidx[NY];
-      //calc distances for whole array
-      kdTree->annkSearch(matrix1[ i ], NY, knn_ind_i, knn_dist_i, eps); 
-      for (unsigned int j = k_i+1; j < NY; ++j){
-	if (knn_dist_i[j] > 0.0){
-	  dist = knn_dist_i[j];
-	  ind.resize(j);
-	  for (int k = 0; k < j; k ++)  
-	    ind[k] = knn_ind_i[k];
-	  k_vec[i] = j;
-	  break;
-	}
-      }
-      delete [] knn_ind_i;
-      delete [] knn_dist_i;
-    }
-    distances[i] = dist;
-    indices[i] = ind;
-    delete [] knn_ind;
-    delete [] knn_dist;
-  }
-  delete kdTree;
-  annClose();
+  KNNInfoEstimator mi_estimator(alg);
+  mi_estimator.x_samples(Xmatrix, dimX);
+  return mi_estimator.mutual_info(Xmatrix, dimY);
 }
 
 void NonDBayesCalibration::print_kl(std::ostream& s)
@@ -14,7 +14,6 @@
 #include "MarginalsCorrDistribution.hpp"
 #include "InvGammaRandomVariable.hpp"
 #include "GaussianKDE.hpp"
-#include "ANN/ANN.h" 
 
 //#define DEBUG
 
@@ -51,6 +50,8 @@ public:
   /// compute the log prior PDF for a particular MCMC sample
   template <typename VectorType>
   Real log_prior_density(const VectorType& vec);
+  /// compute the prior PDF for each column of samples
+  void prior_density(const RealMatrix& samples, RealVector& pdf_vals);
 
   /// draw a multivariate sample from the prior distribution
   template <typename Engine>
@@ -242,6 +243,11 @@ protected:
   /// they are already sized and scaled by covariance / hyperparams...
   Real log_likelihood(const RealVector& residuals,
 		      const RealVector& hyper_params);
+  /// calculate the log-likelihood for each column of residuals (sized
+  /// and scaled as for the single residual vector) with the
+  /// corresponding column of all_params
+  void log_likelihood(const RealMatrix& residuals,
+		      const RealMatrix& all_params, RealVector& log_like);
 
   /// compute priorCovCholFactor based on prior distributions for random
   /// variables and any hyperparameters
@@ -530,13 +536,6 @@ protected:
   void kl_post_prior(RealMatrix& acceptanceChain);
   void prior_sample_matrix(RealMatrix& prior_dist_samples);
   void mutual_info_buildX();
-  static void ann_dist(const ANNpointArray matrix1, const ANNpointArray matrix2,
-     		RealVector& distances, int NX, int NY, int dim2, IntVector& k, 
-		double eps);
-  static void ann_dist(const ANNpointArray matrix1, 
-                const ANNpointArray matrix2, RealVector& distances, 
-		Int2DArray& indices, int NX, int NY, int dim2, 
-		IntVector& k, double eps);
   Real kl_est;	
   void print_kl(std::ostream& stream);		
   void print_chain_diagnostics(std::ostream& s);
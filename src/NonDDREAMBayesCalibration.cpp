@@ -11,6 +11,9 @@
 #include "ProblemDescDB.hpp"
 #include "DakotaModel.hpp"
 #include "PRPMultiIndex.hpp"
+#include <boost/random/normal_distribution.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
 
 // BMA TODO: remove this header
 // for uniform PDF and samples
@@ -92,7 +95,8 @@ NonDDREAMBayesCalibration(ProblemDescDB& problem_db, Model& model):
   numCR(probDescDB.get_int("method.dream.num_cr")),
   crossoverChainPairs(probDescDB.get_int("method.dream.crossover_chain_pairs")),
   grThreshold(probDescDB.get_real("method.dream.gr_threshold")),
-  jumpStep(probDescDB.get_int("method.dream.jump_step"))
+  jumpStep(probDescDB.get_int("method.dream.jump_step")),
+  batchGenerations(probDescDB.get_bool("method.dream.batch_generations"))
 { 
   // don't use max_function_evaluations, since we have num_samples
   // consider max_iterations = generations, and adjust as needed?
@@ -143,6 +147,10 @@ NonDDREAMBayesCalibration(ProblemDescDB& problem_db, Model& model):
     Cout << "WARN (DREAM): jump_step < 1, resetting to 5 (default)." 
 	 << std::endl;
   }
+
+  // the proposals of the chains in a generation may be evaluated concurrently
+  if (batchGenerations)
+    maxEvalConcurrency *= numChains;
 }
 
 
@@ -268,8 +276,14 @@ void NonDDREAMBayesCalibration::calibrate()
   //                                   paramInitials, proposalCovMatrix);
 
   Cout << "INFO (DREAM): Running DREAM for Bayesian inference." << std::endl;
-  /// DREAM will callback to cache_chain to store the chain
-  dream_main(cache_chain);
+  // The DREAM core requests one likelihood at a time; if requested, drive
+  // the generations here instead, so that the proposals of all chains are
+  // evaluated as a batch (concurrently for an asynchronous model)
+  if (batchGenerations)
+    dream_generations();
+  else
+    /// DREAM will callback to cache_chain to store the chain
+    dream_main(cache_chain);
 
   // get the function values corresponding to the acceptance chain
   archive_acceptance_chain();
@@ -308,24 +322,364 @@ double NonDDREAMBayesCalibration::sample_likelihood(int par_num, double zp[])
     nonDDREAMInstance->residualModel.current_response().function_values();
   double log_like = nonDDREAMInstance->log_likelihood(residuals, all_params);
 
-  if (nonDDREAMInstance->outputLevel >= DEBUG_OUTPUT) {
-    Cout << "Log likelihood is " << log_like << " Likelihood is "
-         << std::exp(log_like) << '\n';
-
-    std::ofstream LogLikeOutput;
-    LogLikeOutput.open("NonDDREAMLogLike.txt", std::ios::out | std::ios::app);
-    // Note: parameter values are in scaled space, if scaling is
-    // active; residuals may be scaled by covariance
-    for (size_t i=0; i<par_num;  ++i) LogLikeOutput << zp[i] << ' ' ;
-    for (size_t i=0; i<residuals.length(); ++i)
-      LogLikeOutput << residuals(i) << ' ' ;
-    LogLikeOutput << log_like << '\n';
-    LogLikeOutput.close();
-  }
+  if (nonDDREAMInstance->outputLevel >= DEBUG_OUTPUT)
+    print_log_likelihood(all_params, residuals, log_like);
   return log_like;
 }
 
 
+void NonDDREAMBayesCalibration::
+print_log_likelihood(const RealVector& all_params, const RealVector& residuals,
+		     Real log_like)
+{
+  Cout << "Log likelihood is " << log_like << " Likelihood is "
+       << std::exp(log_like) << '\n';
+
+  std::ofstream LogLikeOutput;
+  LogLikeOutput.open("NonDDREAMLogLike.txt", std::ios::out | std::ios::app);
+  // Note: parameter values are in scaled space, if scaling is
+  // active; residuals may be scaled by covariance
+  for (size_t i=0; i<all_params.length(); ++i)
+    LogLikeOutput << all_params[i] << ' ' ;
+  for (size_t i=0; i<residuals.length(); ++i)
+    LogLikeOutput << residuals(i) << ' ' ;
+  LogLikeOutput << log_like << '\n';
+  LogLikeOutput.close();
+}
+
+
+/** Evaluate the log-likelihood at each column of all_params.  The
+    evaluations are queued with evaluate_nowait() and collected with
+    synchronize(), so that they may run concurrently. */
+void NonDDREAMBayesCalibration::
+batch_log_likelihood(const RealMatrix& all_params, RealVector& log_like)
+{
+  int i, num_samples = all_params.numCols(), par_num = all_params.numRows();
+  for (i=0; i<num_samples; ++i) {
+    RealVector params_i(Teuchos::View,
+			const_cast<Real*>(all_params[i]), par_num);
+    residualModel.continuous_variables(params_i);
+    residualModel.evaluate_nowait();
+  }
+
+  // responses are returned in order of evaluation id, hence of sample
+  const IntResponseMap& resp_map = residualModel.synchronize();
+  if (resp_map.size() != (size_t)num_samples) {
+    Cerr << "\nError (DREAM): expected " << num_samples << " responses from "
+	 << "batch evaluation; received " << resp_map.size() << "." << std::endl;
+    abort_handler(METHOD_ERROR);
+  }
+  RealMatrix residuals(residualModel.response_size(), num_samples, false);
+  IntRespMCIter r_cit;
+  for (i=0, r_cit=resp_map.begin(); r_cit!=resp_map.end(); ++i, ++r_cit)
+    Teuchos::setCol(r_cit->second.function_values(), i, residuals);
+  log_likelihood(residuals, all_params, log_like);
+
+  if (outputLevel >= DEBUG_OUTPUT)
+    for (i=0; i<num_samples; ++i) {
+      RealVector params_i(Teuchos::View,
+			  const_cast<Real*>(all_params[i]), par_num),
+	residuals_i(Teuchos::View, residuals[i], residuals.numRows());
+      print_log_likelihood(params_i, residuals_i, log_like[i]);
+    }
+}
+
+
+/** Generation-batched DREAM (Vrugt et al., 2009).  The proposal for
+    each chain is formed from the states of the other chains in the
+    previous generation, so the proposals of a generation are
+    independent and their likelihoods are evaluated as one batch.  The
+    settings and output files are those the DREAM core obtains from
+    problem_value(): as in the core, the Gelman-Rubin statistic is
+    computed every print step, the crossover probabilities are adapted
+    and outlier chains are reset until it meets the threshold, and the
+    chain, Gelman-Rubin and restart files are written at the end.  The
+    random number stream differs from that of the core. */
+void NonDDREAMBayesCalibration::dream_generations()
+{
+  int i, j, k, m, par_num = numContinuousVars + numHyperparams,
+    num_pairs = std::max(1, std::min(crossoverChainPairs, (numChains-1)/2)),
+    jump_step, print_step;
+  const Real b = 0.1, b_star = 1.e-6;
+
+  // settings and output files shared with the DREAM core
+  String chain_filename, gr_filename, restart_read_filename,
+    restart_write_filename;
+  Real gr_threshold;
+  RealArray limits(2 * par_num);
+  problem_value(&chain_filename, &gr_filename, gr_threshold, jump_step,
+		&limits[0], par_num, print_step, &restart_read_filename,
+		&restart_write_filename);
+
+  boost::random::uniform_real_distribution<Real> unif01(0., 1.),
+    unif_b(-b, b);
+  boost::random::normal_distribution<Real> noise(0., b_star);
+  boost::random::uniform_int_distribution<int> dim_dist(0, par_num - 1),
+    other_dist(0, numChains - 2);
+
+  // chain states in the layout of the DREAM core (passed to cache_chain)
+  // and the log-likelihood and log prior of the current states
+  RealArray z((size_t)par_num * numChains * numGenerations);
+  RealVector fit(numChains), log_prior(numChains), zp_fit;
+  RealMatrix fit_history(numChains, numGenerations, false),
+    zp(par_num, numChains, false);
+  auto state = [&](int chain, int gen)
+    { return &z[(size_t)par_num * (chain + gen * numChains)]; };
+
+  // initial population from the prior
+  for (j=0; j<numChains; ++j) {
+    RealVector zp_j(Teuchos::View, zp[j], par_num);
+    prior_sample(rnumGenerator, zp_j);
+    log_prior[j] = std::log(prior_density(zp_j));
+    std::copy(zp[j], zp[j] + par_num, state(j, 0));
+  }
+  batch_log_likelihood(zp, fit);
+  Teuchos::setCol(fit, 0, fit_history);
+
+  // jump rate for each number of dimensions updated
+  RealVector jump_rate(par_num, false);
+  for (i=0; i<par_num; ++i)
+    jump_rate[i] = 2.38 / std::sqrt(2. * num_pairs * (i+1));
+  // crossover values CR = (m+1)/numCR are selected with probability
+  // cr_prob[m], adapted toward those giving the larger jumps
+  RealVector cr_prob(numCR, false), cr_dis(numCR), cr_ups(numCR);
+  cr_prob.putScalar(1. / numCR);
+
+  IntArray cr_index(numChains), chain_order(numChains - 1);
+  RealVector diff(par_num, false), std_dev(par_num, false);
+  BitArray crossover(par_num);
+  RealArray gr_history; // statistic per parameter at each print step
+  bool gr_converged = false;
+  for (k=1; k<numGenerations; ++k) {
+
+    // the spread of the chains normalizes the jump distances
+    for (i=0; i<par_num; ++i) {
+      Real sum = 0., sum_sq = 0.;
+      for (j=0; j<numChains; ++j)
+	{ Real z_ij = state(j, k-1)[i]; sum += z_ij; sum_sq += z_ij * z_ij; }
+      Real mean = sum / numChains;
+      std_dev[i] = std::sqrt(std::max(0., sum_sq / numChains - mean * mean));
+    }
+
+    // propose a jump for each chain
+    for (j=0; j<numChains; ++j) {
+      const Real* z_old = state(j, k-1);
+      Real u = unif01(rnumGenerator), cum_prob = 0.;
+      for (m=0; m<numCR-1; ++m)
+	{ cum_prob += cr_prob[m]; if (u < cum_prob) break; }
+      cr_index[j] = m;
+      Real cr = (Real)(m+1) / numCR;
+
+      // differences of distinct pairs of the other chains
+      for (i=0; i<numChains-1; ++i)
+	chain_order[i] = (i < j) ? i : i+1;
+      for (i=0; i<2*num_pairs; ++i) {
+	boost::random::uniform_int_distribution<int>
+	  swap_dist(i, numChains - 2);
+	std::swap(chain_order[i], chain_order[swap_dist(rnumGenerator)]);
+      }
+      diff.putScalar(0.);
+      for (int p=0; p<num_pairs; ++p) {
+	const Real *z_r1 = state(chain_order[2*p], k-1),
+	  *z_r2 = state(chain_order[2*p+1], k-1);
+	for (i=0; i<par_num; ++i)
+	  diff[i] += z_r1[i] - z_r2[i];
+      }
+
+      // update each dimension with probability CR (at least one)
+      crossover.reset();
+      for (i=0; i<par_num; ++i)
+	if (unif01(rnumGenerator) < cr)
+	  crossover.set(i);
+      if (crossover.none())
+	crossover.set(dim_dist(rnumGenerator));
+      Real gamma = (k % jump_step == 0) ? 1. : jump_rate[crossover.count()-1];
+
+      for (i=0; i<par_num; ++i) {
+	Real z_i = z_old[i];
+	if (crossover[i]) {
+	  z_i += (1. + unif_b(rnumGenerator)) * gamma * diff[i]
+	      +  noise(rnumGenerator);
+	  // fold back into bounded parameter ranges
+	  Real lower = limits[2*i], upper = limits[2*i+1],
+	    range = upper - lower;
+	  if (std::isfinite(range) && range > 0.) {
+	    if (z_i < lower)
+	      z_i = upper - std::fmod(lower - z_i, range);
+	    else if (z_i > upper)
+	      z_i = lower + std::fmod(z_i - upper, range);
+	  }
+	}
+	zp(i,j) = z_i;
+      }
+    }
+
+    // evaluate the generation's proposals as a batch
+    batch_log_likelihood(zp, zp_fit);
+
+    // Metropolis acceptance for each chain
+    for (j=0; j<numChains; ++j) {
+      const Real* z_old = state(j, k-1);
+      Real* z_new = state(j, k);
+      RealVector zp_j(Teuchos::View, zp[j], par_num);
+      Real zp_log_prior = std::log(prior_density(zp_j)),
+	log_ratio = zp_fit[j] + zp_log_prior - fit[j] - log_prior[j];
+      if (std::log(unif01(rnumGenerator)) < log_ratio) {
+	std::copy(zp[j], zp[j] + par_num, z_new);
+	fit[j] = zp_fit[j]; log_prior[j] = zp_log_prior;
+      }
+      else
+	std::copy(z_old, z_old + par_num, z_new);
+
+      if (!gr_converged) {
+	Real jump_sq = 0.;
+	for (i=0; i<par_num; ++i)
+	  if (std_dev[i] > 0.)
+	    jump_sq += std::pow((z_new[i] - z_old[i]) / std_dev[i], 2.);
+	cr_dis[cr_index[j]] += jump_sq;
+	cr_ups[cr_index[j]] += 1.;
+      }
+    }
+    Teuchos::setCol(fit, k, fit_history);
+
+    if (!gr_converged) {
+      // favor the crossover values with the larger normalized jumps
+      // (once each has been tried)
+      Real cr_sum = 0.;
+      for (m=0; m<numCR && cr_ups[m] > 0.; ++m)
+	cr_sum += cr_dis[m] / cr_ups[m];
+      if (m == numCR && cr_sum > 0.)
+	for (m=0; m<numCR; ++m)
+	  cr_prob[m] = cr_dis[m] / cr_ups[m] / cr_sum;
+
+      // reset chains whose mean log-likelihood over the latter half of
+      // the generations is an outlier to the current best chain
+      RealArray avg(numChains), sorted_avg;
+      for (j=0; j<numChains; ++j) {
+	Real sum = 0.;
+	for (int g=k/2; g<=k; ++g)
+	  sum += fit_history(j,g);
+	avg[j] = sum / (k - k/2 + 1);
+      }
+      sorted_avg = avg;
+      std::sort(sorted_avg.begin(), sorted_avg.end());
+      Real q1 = sorted_avg[numChains/4], q3 = sorted_avg[(3*numChains)/4];
+      int best = 0;
+      for (j=1; j<numChains; ++j)
+	if (fit[j] > fit[best])
+	  best = j;
+      for (j=0; j<numChains; ++j)
+	if (avg[j] < q1 - 2. * (q3 - q1)) {
+	  std::copy(state(best, k), state(best, k) + par_num, state(j, k));
+	  fit[j] = fit[best]; log_prior[j] = log_prior[best];
+	  fit_history(j,k) = fit[best];
+	  if (outputLevel >= VERBOSE_OUTPUT)
+	    Cout << "INFO (DREAM): generation " << k << ", chain " << j
+		 << " is an outlier; resetting to chain " << best << ".\n";
+	}
+    }
+
+    // Gelman-Rubin statistic over the latter half of the generations
+    if ((k+1) % print_step == 0) {
+      int g_start = (k+1)/2, n = k - g_start + 1;
+      Real max_r_hat = 0.;
+      size_t gr_row = gr_history.size();
+      gr_history.resize(gr_row + par_num, 0.);
+      for (i=0; i<par_num && n > 1; ++i) {
+	Real mean = 0., b_n = 0., w = 0.;
+	RealVector chain_mean(numChains);
+	for (j=0; j<numChains; ++j) {
+	  for (int g=g_start; g<=k; ++g)
+	    chain_mean[j] += state(j, g)[i];
+	  chain_mean[j] /= n;
+	  mean += chain_mean[j] / numChains;
+	}
+	for (j=0; j<numChains; ++j) {
+	  b_n += std::pow(chain_mean[j] - mean, 2.) / (numChains - 1);
+	  for (int g=g_start; g<=k; ++g)
+	    w += std::pow(state(j, g)[i] - chain_mean[j], 2.)
+	      / (numChains * (n - 1));
+	}
+	if (w > 0.) {
+	  Real sigma2 = (n - 1.) / n * w + b_n,
+	    r_hat = std::sqrt((numChains + 1.) / numChains * sigma2 / w
+			      - (n - 1.) / (numChains * n));
+	  max_r_hat = std::max(max_r_hat, r_hat);
+	  gr_history[gr_row + i] = r_hat;
+	}
+      }
+      if (outputLevel >= VERBOSE_OUTPUT)
+	Cout << "INFO (DREAM): generation " << k+1
+	     << ", maximum Gelman-Rubin statistic " << max_r_hat << '\n';
+      if (!gr_converged && n > 1 && max_r_hat < gr_threshold) {
+	gr_converged = true;
+	Cout << "INFO (DREAM): Gelman-Rubin convergence criterion met at "
+	     << "generation " << k+1 << ".\n";
+      }
+    }
+  }
+
+  write_dream_files(chain_filename, gr_filename, restart_write_filename,
+		    z, fit_history, gr_history, print_step);
+  cache_chain(&z[0]);
+}
+
+
+/** The layouts follow the chain, Gelman-Rubin and restart writers of
+    the DREAM core: a chain file per chain, named by replacing the
+    trailing zeros of chain_filename with the chain index, with the
+    generation, log-likelihood and parameters on each line; the
+    statistic for each parameter every print_step generations; and the
+    log-likelihood and parameters of each chain in the last generation. */
+void NonDDREAMBayesCalibration::
+write_dream_files(const String& chain_filename, const String& gr_filename,
+		  const String& restart_filename, const RealArray& z,
+		  const RealMatrix& fit_history, const RealArray& gr_history,
+		  int print_step)
+{
+  int i, j, k, par_num = numContinuousVars + numHyperparams;
+  size_t tag_end = chain_filename.find_last_of('0') + 1,
+    tag_len = tag_end - chain_filename.find_last_not_of('0', tag_end-1) - 1;
+  for (j=0; j<numChains; ++j) {
+    String index = std::to_string(j);
+    String fname = chain_filename.substr(0, tag_end - tag_len)
+      + String(tag_len - std::min(tag_len, index.size()), '0') + index
+      + chain_filename.substr(tag_end);
+    std::ofstream chain(fname.c_str());
+    chain << "DREAM.CPP:Parameters_and_log_likelihood_for_chain_#" << j
+	  << '\n';
+    for (k=0; k<numGenerations; ++k) {
+      chain << "  " << k << "  " << fit_history(j,k);
+      const Real* z_jk = &z[(size_t)par_num * (j + k * numChains)];
+      for (i=0; i<par_num; ++i)
+	chain << "  " << z_jk[i];
+      chain << '\n';
+    }
+  }
+
+  std::ofstream gr(gr_filename.c_str());
+  gr << "DREAM.CPP:Monitored_parameter_interchains_Gelman_Rubin_statistic\n";
+  size_t gr_count = gr_history.size() / par_num;
+  for (size_t r=0; r<gr_count; ++r) {
+    gr << "  " << print_step * (r + 1);
+    for (i=0; i<par_num; ++i)
+      gr << "  " << gr_history[r * par_num + i];
+    gr << '\n';
+  }
+
+  std::ofstream restart(restart_filename.c_str());
+  restart << "DREAM.CPP:Parameter_values_for_restart.\n"
+	  << "  " << par_num << '\n' << "  " << numChains << '\n';
+  for (j=0; j<numChains; ++j) {
+    restart << "  " << fit_history(j, numGenerations-1);
+    const Real* z_j = &z[(size_t)par_num * (j + (numGenerations-1) * numChains)];
+    for (i=0; i<par_num; ++i)
+      restart << "  " << z_j[i];
+    restart << '\n';
+  }
+}
+
+
 /** See documentation in DREAM examples) */			     
 void NonDDREAMBayesCalibration::
 problem_size(int &chain_num, int &cr_num, int &gen_num, int &pair_num,
@@ -82,6 +82,23 @@ protected:
   /// save the final x-space acceptance chain and corresponding function values
   void archive_acceptance_chain();
 
+  /// run DREAM generation by generation, evaluating the proposals of
+  /// all chains in a generation concurrently
+  void dream_generations();
+  /// write the chain, Gelman-Rubin and restart files of
+  /// dream_generations() in the layouts of the DREAM core
+  void write_dream_files(const String& chain_filename,
+			 const String& gr_filename,
+			 const String& restart_filename, const RealArray& z,
+			 const RealMatrix& fit_history,
+			 const RealArray& gr_history, int print_step);
+  /// log-likelihood at each column of all_params, evaluated as a batch
+  void batch_log_likelihood(const RealMatrix& all_params,
+			    RealVector& log_like);
+  /// debug output of a log-likelihood evaluation
+  static void print_log_likelihood(const RealVector& all_params,
+				   const RealVector& residuals, Real log_like);
+
   //
   //- Heading: Data
 
@@ -104,6 +121,9 @@ protected:
   Real grThreshold;
   /// how often to perform a long jump in generations
   int jumpStep;
+  /// evaluate each generation of proposals as a batch in
+  /// dream_generations() rather than through the DREAM core
+  bool batchGenerations;
 
   /// random number engine for sampling the prior
   boost::mt19937 rnumGenerator;
@@ -48,7 +48,7 @@ NonDEnsembleSampling(ProblemDescDB& problem_db, Model& model):
   ModelLRevIter ml_rit; // reverse iteration for prev_lev tracking
   bool err_flag = false, mlmf = (methodName==MULTILEVEL_MULTIFIDELITY_SAMPLING);
   NLevActual.resize(num_mf);  NLevAlloc.resize(num_mf);
-  costMetadataIndices.resize(num_mf);
+  costMetadataIndices.resize(num_mf);  measuredCostForms.resize(num_mf);
   for (i=num_mf-1, ml_rit=model_ensemble.rbegin();
        ml_rit!=model_ensemble.rend(); --i, ++ml_rit) { // high fid to low fid
     // only SimulationModel supports solution_{levels,costs} and cost metadata.
@@ -71,12 +71,32 @@ NonDEnsembleSampling(ProblemDescDB& problem_db, Model& model):
     // > Previous option below uses solution_levels() with and without false,
     //   which can only differ if SimulationModel::solnCntlCostMap is empty.
     //if (md_index == SZ_MAX && num_lev > ml_rit->solution_levels(false)) { }
+    // Without cost metadata or offline costs, online cost recovery falls
+    // back to measured evaluation times, which are only available for
+    // evaluations performed locally by this process
     if (md_index == SZ_MAX && ml_rit->solution_levels(false) == 0) {
-      Cerr << "Error: insufficient cost data provided for ensemble sampling."
-	   << "\n       Please provide offline solution_level_cost "
-	   << "estimates or activate\n       online cost recovery for model "
-	   << ml_rit->model_id() << '.' << std::endl;
-      err_flag = true;
+      bool remote_evals = (parallelLib.world_size() > 1),
+	restart_evals = ( ml_rit->evaluation_cache() &&
+	  !parallelLib.program_options().read_restart_file().empty() );
+      if (remote_evals || restart_evals) {
+	Cerr << "Error: insufficient cost data provided for ensemble sampling."
+	     << "\n       Please provide offline solution_level_cost "
+	     << "estimates or activate\n       online cost recovery for model "
+	     << ml_rit->model_id() << ".\n       Evaluation times cannot be "
+	     << "measured for "
+	     << ((remote_evals) ? "evaluations on a dedicated master or "
+		 "remote\n       evaluation servers." : "evaluations "
+		 "retrieved from the restart file\n       as cache hits.")
+	     << std::endl;
+	err_flag = true;
+      }
+      else {
+	measuredCostForms.set(i);
+	ml_rit->time_evaluations(true);
+	Cout << "\nNo solution_level_cost or cost_recovery_metadata provided "
+	     << "for model " << ml_rit->model_id() << ".\nCosts will be "
+	     << "estimated from measured evaluation times." << std::endl;
+      }
     }
 
     //Sizet2DArray& Nl_i = NLevActual[i];
@@ -296,6 +316,7 @@ void NonDEnsembleSampling::print_results(std::ostream& s, short results_state)
     print_moments(s, "response function",
 		  iteratedModel.truth_model().response_labels());
     archive_moments();
+    archive_measured_costs();
   }
 }
 
@@ -329,6 +350,35 @@ print_multimodel_summary(std::ostream& s, const String& summary_type,
 }
 
 
+/** For model forms without cost metadata, the online cost of a solution
+    level is its offline solution_level_cost if provided, or else the
+    average measured time of its evaluations. */
+Real NonDEnsembleSampling::non_metadata_cost(size_t form, size_t lev)
+{
+  ModelList& sub_models = iteratedModel.subordinate_models(false);
+  ModelLIter m_iter = sub_models.begin();  std::advance(m_iter, form);
+  if (lev == _NPOS || lev == USHRT_MAX)
+    lev = m_iter->solution_level_cost_index();
+  if (lev == _NPOS) lev = 0;
+  RealVector costs = (measuredCostForms[form]) ?
+    m_iter->solution_level_measured_costs() : m_iter->solution_level_costs();
+  Real cost = (lev < (size_t)costs.length()) ? costs[lev] : 0.;
+  if (cost <= 0.) {
+    Cerr << "Error: no " << ((measuredCostForms[form]) ?
+			     "measured evaluation time" : "offline cost")
+	 << " available for solution level " << lev << " of model "
+	 << m_iter->model_id() << "\n       in NonDEnsembleSampling::"
+	 << "non_metadata_cost()." << std::endl;
+    abort_handler(METHOD_ERROR);
+  }
+  if (outputLevel >= DEBUG_OUTPUT)
+    Cout << ((measuredCostForms[form]) ? "Measured" : "Offline") << " cost for "
+	 << "model " << m_iter->model_id() << " level " << lev << " = " << cost
+	 << std::endl;
+  return cost;
+}
+
+
 void NonDEnsembleSampling::
 export_all_samples(String root_prepend, const Model& model, size_t iter,
 		   size_t step)
@@ -120,6 +120,9 @@ protected:
 			  const RealVector& sum_LL, const RealVector& sum_LH,
 			  const SizetArray& N_shared, RealVector& beta);
 
+  /// online cost of a solution level of a model form without cost metadata
+  Real non_metadata_cost(size_t form, size_t lev);
+
   /// export allSamples to tagged tabular file
   void export_all_samples(String root_prepend, const Model& model,
 			  size_t iter, size_t step);
@@ -172,6 +175,9 @@ protected:
   bool onlineCost;
   /// indices of cost data within response metadata, one per model form
   SizetSizetPairArray costMetadataIndices;
+  /// model forms for which online cost recovery uses measured evaluation
+  /// times, since neither cost metadata nor offline costs are available
+  BitArray measuredCostForms;
 
   /// user specification for seed_sequence
   SizetArray randomSeedSeqSpec;
@@ -33,7 +33,7 @@ NonDGenACVSampling(ProblemDescDB& problem_db, Model& model):
   dagDepthLimit(problem_db.get_ushort("method.nond.graph_depth_limit")),
   modelSelectType(
     problem_db.get_short("method.nond.search_model_graphs.selection")),
-  meritFnStar(DBL_MAX)
+  meritFnStar(DBL_MAX), pruneModelSets(true)
 {
   // assign appropriate throttle for cases other than PARTIAL_GRAPH_RECURSION
   switch (dagRecursionType) {
@@ -426,29 +426,7 @@ void NonDGenACVSampling::generalized_acv_online_pilot()
 			  sum_HH, N_H_actual, var_L, varH, covLL, covLH);
 
     if (mlmfIter == 0) precompute_ratios(); // metrics not dependent on DAG
-    for (activeModelSetIter  = modelDAGs.begin();
-	 activeModelSetIter != modelDAGs.end(); ++activeModelSetIter) {
-      const UShortArray& approx_set = activeModelSetIter->first;
-      const UShortArraySet& dag_set = activeModelSetIter->second;
-      soln_key.first = approx_set;
-      for (activeDAGIter  = dag_set.begin();
-	   activeDAGIter != dag_set.end(); ++activeDAGIter) {
-	// sample set definitions are enabled by reversing the DAG direction:
-	const UShortArray& active_dag = *activeDAGIter;
-	soln_key.second  = active_dag;
-	if (outputLevel >= QUIET_OUTPUT)
-	  Cout << "Evaluating active DAG:\n" << active_dag
-	       << "for approximation set:\n" << approx_set << std::endl;
-	generate_reverse_dag(approx_set, active_dag);
-	// compute the LF/HF evaluation ratios from shared samples and compute
-	// ratio of MC and ACV mean sq errors (which incorporates anticipated
-	// variance reduction from application of avg_eval_ratios).
-	MFSolutionData& soln = dagSolns[soln_key];
-	compute_ratios(var_L, soln);
-	update_best(soln);// store state for restoration
-	//reset_acv(); // reset state for next ACV execution
-      }
-    }
+    evaluate_model_dags(var_L);
     restore_best();
     soln_key.first  = activeModelSetIter->first;
     soln_key.second = *activeDAGIter;
@@ -497,30 +475,8 @@ void NonDGenACVSampling::generalized_acv_offline_pilot()
   size_t&     N_H_alloc  =  NLevAlloc[hf_form_index][hf_lev_index];
   N_H_actual.assign(numFunctions, 0);  N_H_alloc = 0;
   precompute_ratios(); // compute metrics not dependent on active DAG
+  evaluate_model_dags(var_L);
   std::pair<UShortArray, UShortArray> soln_key;
-  for (activeModelSetIter  = modelDAGs.begin();
-       activeModelSetIter != modelDAGs.end(); ++activeModelSetIter) {
-    const UShortArray& approx_set = activeModelSetIter->first;
-    const UShortArraySet& dag_set = activeModelSetIter->second;
-    soln_key.first = approx_set;
-    for (activeDAGIter  = dag_set.begin();
-	 activeDAGIter != dag_set.end(); ++activeDAGIter) {
-      // sample set definitions are enabled by reversing the DAG direction:
-      const UShortArray& active_dag = *activeDAGIter;
-      soln_key.second  = active_dag;
-      if (outputLevel >= QUIET_OUTPUT)
-	Cout << "Evaluating active DAG:\n" << active_dag
-	     << "for approximation set:\n" << approx_set << std::endl;
-      generate_reverse_dag(approx_set, active_dag);
-      // compute the LF/HF evaluation ratios from shared samples and compute
-      // ratio of MC and ACV mean sq errors (which incorporates anticipated
-      // variance reduction from application of avg_eval_ratios).
-      MFSolutionData& soln = dagSolns[soln_key];
-      compute_ratios(var_L, soln);
-      update_best(soln); // store state for restoration
-      //reset_acv(); // reset state for next ACV execution
-    }
-  }
   Cout << "\n>>>>> Approx subset and DAG evaluation completed\n" << std::endl;
   restore_best();
   ++mlmfIter;
@@ -584,9 +540,56 @@ void NonDGenACVSampling::generalized_acv_pilot_projection()
   // Compute "online" sample increments:
   // -----------------------------------
   precompute_ratios(); // compute metrics not dependent on active DAG
-  for (activeModelSetIter  = modelDAGs.begin();
-       activeModelSetIter != modelDAGs.end(); ++activeModelSetIter) {
-    const UShortArray&  approx_set = activeModelSetIter->first;
+  evaluate_model_dags(var_L);
+  restore_best();
+  ++mlmfIter;
+
+  // No LF increments or final moments for pilot projection
+  soln_key.first  = activeModelSetIter->first;
+  soln_key.second = *activeDAGIter;
+  MFSolutionData& soln = dagSolns[soln_key];
+  update_projected_samples(soln, soln_key.first, N_H_actual, N_H_alloc,
+			   deltaNActualHF, deltaEquivHF);
+  // No need for updating estimator variance given deltaNActualHF since
+  // NonDNonHierarchSampling::ensemble_numerical_solution() recovers N*
+  // from the numerical solve and computes projected avgEstVar{,Ratio}
+}
+
+
+/** Model subsets are visited in ascending order of the lower bound on
+    the merit of their DAGs from model_set_merit_bound().  Once a bound
+    exceeds meritFnStar, no DAG of the subset can be selected by
+    update_best() and its numerical solutions are skipped.  The best
+    solution is reset first, since the merits of a previous online
+    iteration were computed from different covariance estimates. */
+void NonDGenACVSampling::evaluate_model_dags(const RealMatrix& var_L)
+{
+  meritFnStar = DBL_MAX;
+  bestModelSetIter = modelDAGs.end();
+
+  typedef std::map<UShortArray, UShortArraySet>::const_iterator ModelSetIter;
+  std::vector<std::pair<Real, ModelSetIter> > ordered_sets;
+  ordered_sets.reserve(modelDAGs.size());
+  for (ModelSetIter ms_it=modelDAGs.begin(); ms_it!=modelDAGs.end(); ++ms_it)
+    ordered_sets.push_back(
+      std::make_pair(model_set_merit_bound(ms_it->first), ms_it));
+  // stable w.r.t. the key order of modelDAGs for equal bounds
+  std::stable_sort(ordered_sets.begin(), ordered_sets.end(),
+    [](const std::pair<Real, ModelSetIter>& a,
+       const std::pair<Real, ModelSetIter>& b) { return a.first < b.first; });
+
+  std::pair<UShortArray, UShortArray> soln_key;
+  size_t s, num_sets = ordered_sets.size();
+  for (s=0; s<num_sets; ++s) {
+    if (pruneModelSets && ordered_sets[s].first > meritFnStar) {
+      if (outputLevel >= NORMAL_OUTPUT)
+	Cout << "Pruning " << num_sets - s << " approximation set(s) with "
+	     << "merit bounds exceeding best merit = " << meritFnStar
+	     << std::endl;
+      break; // remaining bounds are no smaller
+    }
+    activeModelSetIter = ordered_sets[s].second;
+    const UShortArray& approx_set = activeModelSetIter->first;
     const UShortArraySet& dag_set = activeModelSetIter->second;
     soln_key.first = approx_set;
     for (activeDAGIter  = dag_set.begin();
@@ -595,7 +598,8 @@ void NonDGenACVSampling::generalized_acv_pilot_projection()
       const UShortArray& active_dag = *activeDAGIter;
       soln_key.second  = active_dag;
       if (outputLevel >= QUIET_OUTPUT)
-	Cout << "Evaluating active DAG:\n" << active_dag << std::endl;
+	Cout << "Evaluating active DAG:\n" << active_dag
+	     << "for approximation set:\n" << approx_set << std::endl;
       generate_reverse_dag(approx_set, active_dag);
       // compute the LF/HF evaluation ratios from shared samples and compute
       // ratio of MC and ACV mean sq errors (which incorporates anticipated
@@ -606,18 +610,66 @@ void NonDGenACVSampling::generalized_acv_pilot_projection()
       //reset_acv(); // reset state for next ACV execution
     }
   }
-  restore_best();
-  ++mlmfIter;
+}
 
-  // No LF increments or final moments for pilot projection
-  soln_key.first  = activeModelSetIter->first;
-  soln_key.second = *activeDAGIter;
-  MFSolutionData& soln = dagSolns[soln_key];
-  update_projected_samples(soln, soln_key.first, N_H_actual, N_H_alloc,
-			   deltaNActualHF, deltaEquivHF);
-  // No need for updating estimator variance given deltaNActualHF since
-  // NonDNonHierarchSampling::ensemble_numerical_solution() recovers N*
-  // from the numerical solve and computes projected avgEstVar{,Ratio}
+
+/** For any DAG, the estimator variance for QoI q is at least that of
+    the optimal control variate (OCV) using the approximations in
+    approx_set, var_H (1 - R^2_OCV) / N_H, and with r_i >= 1 the
+    equivalent cost is at least N_H (1 + Sum c_i / c_H).  Eliminating
+    N_H bounds the log of the average estimator variance at the budget.
+    The budget is relaxed by 10% to cover the penalty of nh_penalty_merit(),
+    which is at least this large for any larger violation.  No bound
+    (-DBL_MAX) is available for accuracy-constrained formulations or
+    when the OCV solve fails. */
+Real NonDGenACVSampling::
+model_set_merit_bound(const UShortArray& approx_set) const
+{
+  if (optSubProblemForm == N_MODEL_LINEAR_OBJECTIVE ||
+      optSubProblemForm == N_GROUP_LINEAR_OBJECTIVE ||
+      maxFunctionEvals == SZ_MAX)
+    return -DBL_MAX;
+
+  size_t i, j, qoi, num_approx = approx_set.size();
+  unsigned short approx_i;
+  Real cost_H = sequenceCost[numApprox], cost_factor = 1.,
+    sum_estvar = 0., R_sq;
+  for (i=0; i<num_approx; ++i)
+    cost_factor += sequenceCost[approx_set[i]] / cost_H;
+
+  RealSymMatrix C_S(num_approx, false);
+  RealVector c_S(num_approx, false), c_S_copy, lhs(num_approx);
+  for (qoi=0; qoi<numFunctions; ++qoi) {
+    if (varH[qoi] <= 0.) continue; // no contribution to estimator variance
+    const RealSymMatrix& cov_LL_q = covLL[qoi];
+    for (i=0; i<num_approx; ++i) {
+      approx_i = approx_set[i];
+      c_S[i] = covLH(qoi, approx_i);
+      for (j=0; j<=i; ++j)
+	C_S(i,j) = cov_LL_q(approx_i, approx_set[j]); // Ok for RealSymMatrix
+    }
+    c_S_copy = c_S; // RHS gets altered by equilibration
+    RealSpdSolver spd_solver;
+    spd_solver.setMatrix(Teuchos::rcp(&C_S, false));
+    spd_solver.setVectors(Teuchos::rcp(&lhs, false),
+			  Teuchos::rcp(&c_S_copy, false));
+    if (spd_solver.shouldEquilibrate())
+      spd_solver.factorWithEquilibration(true);
+    if (spd_solver.solve())
+      return -DBL_MAX; // singular subset: no pruning
+
+    R_sq = 0.;
+    for (i=0; i<num_approx; ++i)
+      R_sq += c_S[i] * lhs[i];
+    R_sq /= varH[qoi];
+    if      (R_sq < 0.) R_sq = 0.;
+    else if (R_sq > 1.) R_sq = 1.;
+    sum_estvar += varH[qoi] * (1. - R_sq);
+  }
+
+  Real budget = (Real)maxFunctionEvals;
+  return std::log(sum_estvar / numFunctions * cost_factor
+		  / (1.1 * (budget + .01)));
 }
 
 
@@ -822,8 +874,10 @@ compute_ratios(const RealMatrix& var_L, MFSolutionData& soln)
   //   dependent on the active DAG/model subset
   update_model_group_costs();
 
+  // A DAG without a previous solution (e.g., first visited after pruning in
+  // evaluate_model_dags()) is also initialized from analytic solutions
   const UShortArray& approx_set = activeModelSetIter->first;
-  if (mlmfIter == 0) {
+  if (mlmfIter == 0 || soln.solution_variables().empty()) {
     size_t hf_form_index, hf_lev_index; hf_indices(hf_form_index, hf_lev_index);
     SizetArray& N_H_actual = NLevActual[hf_form_index][hf_lev_index];
     size_t&     N_H_alloc  =  NLevAlloc[hf_form_index][hf_lev_index];
@@ -1974,6 +2028,12 @@ void NonDGenACVSampling::update_best(MFSolutionData& soln)
   else {
     merit_fn = nh_penalty_merit(soln);
     update = (merit_fn < meritFnStar);
+    // break exact ties in favor of the first {approx_set,DAG} in key order,
+    // such that the selection does not depend on the order of evaluation
+    if (!update && merit_fn == meritFnStar &&
+	bestModelSetIter != modelDAGs.end())
+      update = (std::make_pair(activeModelSetIter->first, *activeDAGIter) <
+		std::make_pair(bestModelSetIter->first,   *bestDAGIter));
   }
   if (update) {
     bestModelSetIter = activeModelSetIter;
@@ -36,6 +36,14 @@ public:
   /// destructor
   ~NonDGenACVSampling();
 
+  //
+  //- Heading: Member functions
+  //
+
+  /// enable (default) or disable the pruning of model subsets by their
+  /// merit bounds in evaluate_model_dags()
+  void prune_model_sets(bool prune);
+
 protected:
 
   //
@@ -229,6 +237,12 @@ private:
 				       const UShortArray& approx_set,
 				       const UShortList& root_list);
 
+  /// evaluate the DAGs of each model subset that is not pruned by its
+  /// merit bound, updating the best solution
+  void evaluate_model_dags(const RealMatrix& var_L);
+  /// lower bound on the merit of any DAG for a model subset
+  Real model_set_merit_bound(const UShortArray& approx_set) const;
+
   void update_best(MFSolutionData& solution);
   void restore_best();
   //void reset_acv();
@@ -280,6 +294,8 @@ private:
   /// the merit function value for the best solution, incorporating both
   /// estimator variance and budget (objective and constraint in some order)
   Real meritFnStar;
+  /// skip the model subsets whose merit bound exceeds meritFnStar
+  bool pruneModelSets;
 
   /// book-keeping of previous numerical optimization solutions for each DAG;
   /// used for warm starting
@@ -287,6 +303,10 @@ private:
 };
 
 
+inline void NonDGenACVSampling::prune_model_sets(bool prune)
+{ pruneModelSets = prune; }
+
+
 inline size_t NonDGenACVSampling::num_approximations() const
 { return activeModelSetIter->first.size(); }
 
@@ -83,32 +83,48 @@ accumulate_paired_online_cost(RealVector& accum_cost, SizetArray& num_cost,
   // costMetadataIndices follows ordered models
   const SizetSizetPair& cost1_mdi = costMetadataIndices[form1_index];
   size_t md1_index = cost1_mdi.first, md1_len = cost1_mdi.second,
-    md2_index, step1, step2;
+    md2_index = SZ_MAX, form2_index, step1, step2;
+  if (step) { step1 = step - 1; step2 = step; }
+  else        step1 = step;
   if (step) {
     unsigned short form2 = key.retrieve_model_form(1);
-    size_t form2_index = (form2 == USHRT_MAX) ? 0 : (size_t)form2;
+    form2_index = (form2 == USHRT_MAX) ? 0 : (size_t)form2;
     md2_index = costMetadataIndices[form2_index].first;
   }
 
+  // forms without cost metadata contribute their offline or measured cost
+  if (md1_index == SZ_MAX) {
+    accum_cost[step1]
+      += non_metadata_cost(form1_index, key.retrieve_resolution_level(0));
+    ++num_cost[step1];
+  }
+  if (step && md2_index == SZ_MAX) {
+    accum_cost[step2]
+      += non_metadata_cost(form2_index, key.retrieve_resolution_level(1));
+    ++num_cost[step2];
+  }
+  if (md1_index == SZ_MAX && (!step || md2_index == SZ_MAX))
+    return;
+
   using std::isfinite;  Real cost1, cost2;  IntRespMCIter r_cit;
   // uses one set of allResponses with QoI aggregation across all Models,
   // ordered by unorderedModels[i-1], i=1:numApprox --> truthModel
   for (r_cit=allResponses.begin(); r_cit!=allResponses.end(); ++r_cit) {
     const std::vector<RespMetadataT>& md = r_cit->second.metadata();//aggregated
 
-    if (step) { step1 = step - 1; step2 = step; }
-    else        step1 = step;
-
-    cost1 = md[md1_index]; // offset by metadata index
-    if (isfinite(cost1)) {
-      accum_cost[step1] += cost1;
-      ++num_cost[step1];
-      if (outputLevel >= DEBUG_OUTPUT)
-	Cout << "Metadata:\n" << md << "Model key1 cost: accum_cost = "
-	     << accum_cost[step1] << " num_cost = "<<num_cost[step1]<<std::endl;
+    if (md1_index != SZ_MAX) {
+      cost1 = md[md1_index]; // offset by metadata index
+      if (isfinite(cost1)) {
+	accum_cost[step1] += cost1;
+	++num_cost[step1];
+	if (outputLevel >= DEBUG_OUTPUT)
+	  Cout << "Metadata:\n" << md << "Model key1 cost: accum_cost = "
+	       << accum_cost[step1] << " num_cost = " << num_cost[step1]
+	       << std::endl;
+      }
     }
 
-    if (step) {
+    if (step && md2_index != SZ_MAX) {
       cost2 = md[md1_len + md2_index]; // offset by metadata index
       if (isfinite(cost2)) {
 	accum_cost[step2] += cost2;
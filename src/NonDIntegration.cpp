@@ -13,6 +13,7 @@
 #include "DakotaModel.hpp"
 #include "DakotaResponse.hpp"
 #include "ProblemDescDB.hpp"
+#include "TabularWriter.hpp"
 
 static const char rcsId[]="@(#) $Id: NonDIntegration.cpp,v 1.57 2004/06/21 19:57:32 mseldre Exp $";
 
@@ -147,12 +148,13 @@ void NonDIntegration::print_points_weights(const String& tabular_name)
     write_data_tabular(pts_wts_file,
 		       iteratedModel.continuous_variable_labels());
     pts_wts_file << '\n';
+    TabularIO::TabularWriter writer(pts_wts_file);
     for (i=0; i<num_pts; ++i) {
-      pts_wts_file << std::setw(6) << i+1 << ' ';
+      writer.write((int)i+1, 6);
       if (weights)
-	pts_wts_file << std::setw(write_precision+5) << t1_wts[i] << ' ';
-      write_data_tabular(pts_wts_file, allSamples[i], num_vars);
-      pts_wts_file << '\n';
+	writer.write(t1_wts[i], write_precision+5);
+      writer.write(allSamples[i], num_vars);
+      writer.write_eol();
     }
   }
 }
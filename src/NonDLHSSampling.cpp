@@ -51,6 +51,7 @@ NonDLHSSampling::NonDLHSSampling(ProblemDescDB& problem_db, Model& model):
   pcaFlag(probDescDB.get_bool("method.principal_components")),
   vbdViaSamplingMethod(probDescDB.get_ushort("method.vbd_via_sampling_method")),
   vbdViaSamplingNumBins(probDescDB.get_int("method.vbd_via_sampling_num_bins")),
+  vbdBootstrapSamples(probDescDB.get_int("method.vbd_bootstrap_samples")),
   percentVarianceExplained(
     probDescDB.get_real("method.percent_variance_explained"))
 {
@@ -737,7 +738,9 @@ void NonDLHSSampling::post_run(std::ostream& s)
                                                   numContinuousVars + numDiscreteIntVars + numDiscreteRealVars + numDiscreteStringVars,
                                                   numSamples,
                                                   allSamples,
-                                                  allResponses);
+                                                  allResponses,
+                                                  vbdBootstrapSamples,
+                                                  randomSeed);
       nonDSampCorr.archive_sobol_indices(run_identifier(),
                                          resultsDB,
                                          iteratedModel.ordered_labels(),
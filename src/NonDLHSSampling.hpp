@@ -173,6 +173,10 @@ private:
   /// number of bins for using with the Mahadevan sampling method for computing variance-based decomposition indices
   int vbdViaSamplingNumBins;
 
+  /// number of bootstrap resamples for confidence intervals on
+  /// pick-and-freeze variance-based decomposition indices
+  int vbdBootstrapSamples;
+
   /// flag to specify the calculation of principal components
   bool pcaFlag;
   /// Threshold to keep number of principal components that explain 
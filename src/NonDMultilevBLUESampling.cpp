@@ -353,7 +353,8 @@ recover_online_cost(const IntResponse2DMap& batch_resp_map)
     for (m=0, cntr=0; m<num_models; ++m) {
       mform = active_key.retrieve_model_form(m);
       const SizetSizetPair& cost_mdi = costMetadataIndices[mform];
-      if (contains(group_g, m)) { // repeated lookups Ok here (performed once)
+      if (cost_mdi.first != SZ_MAX && contains(group_g, m)) {
+	// repeated lookups Ok here (performed once)
 	md_index = cntr + cost_mdi.first;
 	for (r_cit=resp_map_g.begin(); r_cit!=resp_map_g.end(); ++r_cit) {
 	  // retrieve m-th cost entry from metadata: set start + position in set
@@ -367,6 +368,12 @@ recover_online_cost(const IntResponse2DMap& batch_resp_map)
   }
 
   for (m=0; m<num_models; ++m) {
+    mform = active_key.retrieve_model_form(m);
+    if (costMetadataIndices[mform].first == SZ_MAX) { // offline or measured
+      sequenceCost[m]
+	= non_metadata_cost(mform, active_key.retrieve_resolution_level(m));
+      continue;
+    }
     if (outputLevel >= DEBUG_OUTPUT)
       Cout << "Online cost: accumulated cost = " << sequenceCost[m]
 	   << " num cost = " << num_finite[m];
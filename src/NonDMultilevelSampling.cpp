@@ -119,6 +119,7 @@ void NonDMultilevelSampling::core_run()
 
   configure_sequence(numSteps, secondaryIndex, sequenceType);
   onlineCost = !query_cost(numSteps, sequenceType, sequenceCost);
+  bootstrapCache.clear();
 
   // Useful for future extensions when convergence tolerance can be a vector
   convergenceTolVec.sizeUninitialized(numFunctions);
@@ -1083,7 +1084,8 @@ variance_scalarization_Qsum(const IntRealMatrixMap& sum_Ql, const IntRealMatrixM
         cov_estim = (scalarizationCoeffs(qoi, cur_qoi_offset) == 0) ||
                     (scalarizationCoeffs(qoi, cur_qoi_offset+1) == 0) ? 0 :
           compute_bootstrap_covariance(step, cur_qoi, levQoisamplesmatrixMap, 
-          N_l[step][cur_qoi], false, dummy_grad, &(++bootstrapSeed)) * N_l[step][cur_qoi];
+          N_l[step][cur_qoi], false, dummy_grad, &(++bootstrapSeed),
+          bootstrapCache) * N_l[step][cur_qoi];
         break;
       case COV_PEARSON:
         cov_estim = std::sqrt(var_of_mean_l*var_of_sigma_l);
@@ -1119,61 +1121,106 @@ variance_scalarization_Qsum(const IntRealMatrixMap& sum_Ql, const IntRealMatrixM
   return var_of_scalarization_l; //Multiplication by N_l as described in the paper by Krumscheid, Pisaroni, Nobile is already done in submethods
 }
 
+/** Mean and standard deviation (normalized by N, as in compute_mean() and
+    compute_std()) of row qoi of the stored samples for each bootstrap
+    replicate, together with their derivatives w.r.t. N.  Replicates are
+    processed one at a time, each by a scalar pass over its column of
+    stored sample indices, in the operation order of compute_mean() and
+    compute_std() such that the moments are unchanged. */
+static void bootstrap_replicate_moments(const RealMatrix& samples,
+  const size_t qoi, const IntMatrix& indices, const Real N,
+  RealVector& mean_bs, RealVector& sigma_bs,
+  RealVector& mean_bs_grad, RealVector& sigma_bs_grad)
+{
+  int nb_samples = indices.numRows(), nb_bs_samples = indices.numCols(),
+    bs_resample, resample;
+  mean_bs.sizeUninitialized(nb_bs_samples);
+  sigma_bs.sizeUninitialized(nb_bs_samples);
+  mean_bs_grad.sizeUninitialized(nb_bs_samples);
+  sigma_bs_grad.sizeUninitialized(nb_bs_samples);
+  for(bs_resample = 0; bs_resample < nb_bs_samples; ++bs_resample){
+    const int* bs_idx = indices[bs_resample];
+    Real sum = 0, sigma_inner = 0, dev;
+    for(resample = 0; resample < nb_samples; ++resample)
+      sum += samples(qoi, bs_idx[resample]);
+    Real mean_hat = sum/N, mean_hat_grad = - 1./(N*N) * sum;
+    for(resample = 0; resample < nb_samples; ++resample){
+      dev = samples(qoi, bs_idx[resample]) - mean_hat;
+      sigma_inner += dev*dev;
+    }
+    Real sigma = std::sqrt(sigma_inner/(N-1.)),
+      sigma_partial = -1./((N-1.)*(N-1.))*sigma_inner
+                    + 1./(N-1.)*2.*(sum - nb_samples*mean_hat)*(-mean_hat_grad);
+    mean_bs[bs_resample] = mean_hat;
+    sigma_bs[bs_resample] = sigma;
+    mean_bs_grad[bs_resample] = mean_hat_grad;
+    sigma_bs_grad[bs_resample] = (sigma == 0) ? 0 : sigma_partial/(2.*sigma);
+  }
+}
+
+
+/** The replicate indices for a level are drawn once per seed and number
+    of stored samples and the covariance is evaluated once per QoI and N,
+    such that the repeated calls from the sample allocation optimizer are
+    lookups into bootstrap_cache. */
 Real NonDMultilevelSampling::compute_bootstrap_covariance(const size_t step, 
                 const size_t qoi, 
                 const IntRealMatrixMap& lev_qoisamplematrix_map, const Real N,
-                const bool compute_gradient, Real& grad, int* seed){
-  int nb_bs_samples = 100, nb_samples, nb_functions, bs_sample_idx;
-  RealVector bs_samples_l, bs_samples_lm1;
-  RealVector meanl_bs(nb_bs_samples), meanlm1_bs(nb_bs_samples);
-  RealVector sigmal_bs(nb_bs_samples), sigmalm1_bs(nb_bs_samples);
-  RealVector meanl_bs_grad, meanlm1_bs_grad, sigmal_bs_grad, sigmalm1_bs_grad;
-  if(compute_gradient){
-    meanl_bs_grad.size(nb_bs_samples);
-    meanlm1_bs_grad.size(nb_bs_samples);
-    sigmal_bs_grad.size(nb_bs_samples);
-    sigmalm1_bs_grad.size(nb_bs_samples);
+                const bool compute_gradient, Real& grad, int* seed,
+                std::map<size_t, BootstrapReplicates>& bootstrap_cache){
+  int nb_bs_samples = 100, nb_samples, nb_functions;
+
+  std::map<int, RealMatrix>::const_iterator it = lev_qoisamplematrix_map.find(step);
+  if (it == lev_qoisamplematrix_map.end()){
+    Cerr << "NonDMultilevelSampling::compute_bootstrap_covariance: no samples "
+	 << "stored for level " << step << "." << std::endl;
+    abort_handler(METHOD_ERROR);
   }
+  const RealMatrix& samples = it->second;
+  nb_samples = samples.numCols(); 
+  nb_functions = (step > 0) ? samples.numRows()/2 : samples.numRows();
+
+  BootstrapReplicates& replicates = bootstrap_cache[step];
+  if(replicates.indices.numCols() != nb_bs_samples ||
+     replicates.seed != *seed || replicates.numSamples != nb_samples){
+    //Cout << "Bootstrap seed: " << *seed << "\n";
+    boost::mt19937 rng((*seed));
+    boost::random::uniform_int_distribution<> rand_int_range( 0, nb_samples-1);
+    boost::variate_generator
+      < boost::mt19937, boost::random::uniform_int_distribution<> >
+      rand_int(rng, rand_int_range);
+
+    replicates.seed = *seed;
+    replicates.numSamples = nb_samples;
+    replicates.indices.shapeUninitialized(nb_samples, nb_bs_samples);
+    replicates.covariances.clear();
+    for(int bs_resample = 0; bs_resample < nb_bs_samples; ++bs_resample)
+      for(int resample = 0; resample < nb_samples; ++resample)
+        replicates.indices(resample, bs_resample) = rand_int();
+  }
+
+  std::pair<size_t, Real> cov_key(qoi, N);
+  std::map<std::pair<size_t, Real>, RealRealPair>::iterator cov_it
+    = replicates.covariances.find(cov_key);
+  if(cov_it != replicates.covariances.end()){
+    if(compute_gradient) grad = cov_it->second.second;
+    return cov_it->second.first;
+  }
+
+  RealVector meanl_bs, meanlm1_bs, sigmal_bs, sigmalm1_bs;
+  RealVector meanl_bs_grad, meanlm1_bs_grad, sigmal_bs_grad, sigmalm1_bs_grad;
   Real covmeanlsigmal = 0, covmeanlm1sigmal = 0, covmeanlsigmalm1 = 0, 
         covmeanlm1sigmalm1 = 0;
   Real covmeanlsigmal_grad = 0, covmeanlm1sigmal_grad = 0, 
         covmeanlsigmalm1_grad = 0, covmeanlm1sigmalm1_grad = 0;
 
-  std::map<int, RealMatrix>::const_iterator it = lev_qoisamplematrix_map.find(step);
-  nb_samples = it->second.numCols(); 
-  nb_functions = (step > 0) ? it->second.numRows()/2 : it->second.numRows();
-  bs_samples_l.size(nb_samples);
-  bs_samples_lm1.size(nb_samples);
-
-  //Cout << "Bootstrap seed: " << *seed << "\n";
-  boost::mt19937 rng((*seed));
-  boost::random::uniform_int_distribution<> rand_int_range( 0, nb_samples-1);
-  boost::variate_generator
-    < boost::mt19937, boost::random::uniform_int_distribution<> >
-    rand_int(rng, rand_int_range);
-
-  for(int bs_resample = 0; bs_resample < nb_bs_samples; ++bs_resample){
-
-    for(int resample = 0; resample < nb_samples; ++resample){
-      bs_sample_idx = rand_int();
-      bs_samples_l[resample] = it->second(qoi, bs_sample_idx);
-      bs_samples_lm1[resample] = (step > 0) ? 
-                                    it->second(qoi + nb_functions, bs_sample_idx) : 0;
-    }
-    meanl_bs[bs_resample] = compute_mean(bs_samples_l, N, compute_gradient, 
-                                          meanl_bs_grad[bs_resample]);
-    sigmal_bs[bs_resample] = compute_std(bs_samples_l, N, compute_gradient, 
-                                            sigmal_bs_grad[bs_resample]);
-    if(step > 0){
-      meanlm1_bs[bs_resample] = compute_mean(bs_samples_lm1, N, compute_gradient, 
-                                              meanlm1_bs_grad[bs_resample]);
-      sigmalm1_bs[bs_resample] = compute_std(bs_samples_lm1, N, compute_gradient, 
-                                              sigmalm1_bs_grad[bs_resample]);
-    }
-  }
-
+  bootstrap_replicate_moments(samples, qoi, replicates.indices, N, meanl_bs,
+                              sigmal_bs, meanl_bs_grad, sigmal_bs_grad);
   covmeanlsigmal = compute_cov(meanl_bs, sigmal_bs);
   if(step > 0){
+    bootstrap_replicate_moments(samples, qoi + nb_functions, replicates.indices,
+                                N, meanlm1_bs, sigmalm1_bs, meanlm1_bs_grad,
+                                sigmalm1_bs_grad);
     covmeanlm1sigmal = compute_cov(meanlm1_bs, sigmal_bs);
     covmeanlsigmalm1 = compute_cov(meanl_bs, sigmalm1_bs);
     covmeanlm1sigmalm1 = compute_cov(meanlm1_bs, sigmalm1_bs);
@@ -1184,56 +1231,59 @@ Real NonDMultilevelSampling::compute_bootstrap_covariance(const size_t step,
                         << covmeanlsigmalm1 << ", "
                         << covmeanlm1sigmalm1 << "\n";
   */
-  if(compute_gradient){
-    Real mean_meanl_bs = compute_mean(meanl_bs);
-    Real mean_sigmal_bs = compute_mean(sigmal_bs);
-    Real mean_meanl_bs_grad = compute_mean(meanl_bs_grad);
-    Real mean_sigmal_bs_grad = compute_mean(sigmal_bs_grad);
-    Real mean_meanlm1_bs = 0,mean_sigmalm1_bs = 0, mean_meanlm1_bs_grad=0,
-         mean_sigmalm1_bs_grad = 0; 
+
+  // the gradient is retained with the covariance for reuse by the optimizer
+  Real mean_meanl_bs = compute_mean(meanl_bs);
+  Real mean_sigmal_bs = compute_mean(sigmal_bs);
+  Real mean_meanl_bs_grad = compute_mean(meanl_bs_grad);
+  Real mean_sigmal_bs_grad = compute_mean(sigmal_bs_grad);
+  Real mean_meanlm1_bs = 0,mean_sigmalm1_bs = 0, mean_meanlm1_bs_grad=0,
+       mean_sigmalm1_bs_grad = 0; 
+  if(step > 0){
+    mean_meanlm1_bs = compute_mean(meanlm1_bs);
+    mean_sigmalm1_bs = compute_mean(sigmalm1_bs);
+    mean_meanlm1_bs_grad = compute_mean(meanlm1_bs_grad);
+    mean_sigmalm1_bs_grad = compute_mean(sigmalm1_bs_grad);
+  }
+  for(int bs_resample = 0; bs_resample < nb_bs_samples; ++bs_resample){
+    covmeanlsigmal_grad += (meanl_bs_grad[bs_resample] - mean_meanlm1_bs_grad) *
+                            (sigmal_bs[bs_resample] - mean_sigmal_bs) +
+                           (meanl_bs[bs_resample] - mean_meanl_bs) *
+                            (sigmal_bs_grad[bs_resample] - mean_sigmal_bs_grad);
+
     if(step > 0){
-      mean_meanlm1_bs = compute_mean(meanlm1_bs);
-      mean_sigmalm1_bs = compute_mean(sigmalm1_bs);
-      mean_meanlm1_bs_grad = compute_mean(meanlm1_bs_grad);
-      mean_sigmalm1_bs_grad = compute_mean(sigmalm1_bs_grad);
-    }
-    for(int bs_resample = 0; bs_resample < nb_bs_samples; ++bs_resample){
-      covmeanlsigmal_grad += (meanl_bs_grad[bs_resample] - mean_meanlm1_bs_grad) *
+      covmeanlm1sigmal_grad += (meanlm1_bs_grad[bs_resample] - mean_meanlm1_bs_grad) *
                               (sigmal_bs[bs_resample] - mean_sigmal_bs) +
-                             (meanl_bs[bs_resample] - mean_meanl_bs) *
+                             (meanlm1_bs[bs_resample] - mean_meanlm1_bs) *
                               (sigmal_bs_grad[bs_resample] - mean_sigmal_bs_grad);
 
-      if(step > 0){
-        covmeanlm1sigmal_grad += (meanlm1_bs_grad[bs_resample] - mean_meanlm1_bs_grad) *
-                                (sigmal_bs[bs_resample] - mean_sigmal_bs) +
-                               (meanlm1_bs[bs_resample] - mean_meanlm1_bs) *
-                                (sigmal_bs_grad[bs_resample] - mean_sigmal_bs_grad);
-
-        covmeanlsigmalm1_grad += (meanl_bs_grad[bs_resample] - mean_meanl_bs_grad) *
-                                (sigmalm1_bs[bs_resample] - mean_sigmalm1_bs) +
-                               (meanl_bs[bs_resample] - mean_meanl_bs) *
-                                (sigmalm1_bs_grad[bs_resample] - mean_sigmalm1_bs_grad);
-
-        covmeanlm1sigmalm1_grad += (meanlm1_bs_grad[bs_resample] - mean_meanlm1_bs_grad) * 
-                                (sigmalm1_bs[bs_resample] - mean_sigmalm1_bs) +
-                               (meanlm1_bs[bs_resample] - mean_meanlm1_bs) *
+      covmeanlsigmalm1_grad += (meanl_bs_grad[bs_resample] - mean_meanl_bs_grad) *
+                              (sigmalm1_bs[bs_resample] - mean_sigmalm1_bs) +
+                             (meanl_bs[bs_resample] - mean_meanl_bs) *
                               (sigmalm1_bs_grad[bs_resample] - mean_sigmalm1_bs_grad);
-      }
 
-    }
-    covmeanlsigmal_grad /= (nb_bs_samples - 1.);
-    if(step > 0){
-      covmeanlm1sigmal_grad /= (nb_bs_samples - 1.);
-      covmeanlsigmalm1_grad /= (nb_bs_samples - 1.);
-      covmeanlm1sigmalm1_grad /= (nb_bs_samples - 1.);
+      covmeanlm1sigmalm1_grad += (meanlm1_bs_grad[bs_resample] - mean_meanlm1_bs_grad) * 
+                              (sigmalm1_bs[bs_resample] - mean_sigmalm1_bs) +
+                             (meanlm1_bs[bs_resample] - mean_meanlm1_bs) *
+                            (sigmalm1_bs_grad[bs_resample] - mean_sigmalm1_bs_grad);
     }
 
-    grad = covmeanlsigmal_grad - covmeanlm1sigmal_grad - covmeanlsigmalm1_grad +
-            covmeanlm1sigmalm1_grad;
-    grad = 0; //TODO_SCALARBUGFIX
   }
-  return covmeanlsigmal - covmeanlm1sigmal - 
+  covmeanlsigmal_grad /= (nb_bs_samples - 1.);
+  if(step > 0){
+    covmeanlm1sigmal_grad /= (nb_bs_samples - 1.);
+    covmeanlsigmalm1_grad /= (nb_bs_samples - 1.);
+    covmeanlm1sigmalm1_grad /= (nb_bs_samples - 1.);
+  }
+
+  RealRealPair& cov_grad = replicates.covariances[cov_key];
+  cov_grad.first = covmeanlsigmal - covmeanlm1sigmal - 
           covmeanlsigmalm1 + covmeanlm1sigmalm1;
+  cov_grad.second = covmeanlsigmal_grad - covmeanlm1sigmal_grad -
+          covmeanlsigmalm1_grad + covmeanlm1sigmalm1_grad;
+  cov_grad.second = 0; //TODO_SCALARBUGFIX
+  if(compute_gradient) grad = cov_grad.second;
+  return cov_grad.first;
 }
 
 Real NonDMultilevelSampling::compute_mean(const RealVector& samples){
@@ -2036,7 +2086,7 @@ compute_error_estimates(const IntRealMatrixMap& sum_Ql, const IntRealMatrixMap&
       switch(cov_approximation_type){
         case COV_BOOTSTRAP:
           for (lev = 0; lev < num_lev; ++lev) {
-            agg_estim_cov_scalarization += compute_bootstrap_covariance(lev, qoi, levQoisamplesmatrixMap, num_Q[lev][qoi], false, dummy_grad, &(++bootstrapSeed));
+            agg_estim_cov_scalarization += compute_bootstrap_covariance(lev, qoi, levQoisamplesmatrixMap, num_Q[lev][qoi], false, dummy_grad, &(++bootstrapSeed), bootstrapCache);
           }
           break;
         case COV_PEARSON:
@@ -2115,6 +2165,7 @@ static const IntRealMatrixMap *static_sum_Qlm1(NULL);
 static const IntIntPairRealMatrixMap *static_sum_QlQlm1(NULL);
 static const RealMatrix *static_scalarization_response_mapping(NULL);
 static const IntRealMatrixMap *static_levQoisamplesmatrixMap(NULL);
+static std::map<size_t, BootstrapReplicates> *static_bootstrapCache(NULL);
 static const short *static_cov_approximation_type(NULL);
 
 
@@ -2136,6 +2187,7 @@ void NonDMultilevelSampling::assign_static_member(const Real &conv_tol, size_t &
     static_scalarization_response_mapping = &scalarization_response_mapping;
     static_levQoisamplesmatrixMap = &levQoisamplesmatrixMap;
     static_randomSeed = &bootstrapSeed;
+    static_bootstrapCache = &bootstrapCache;
     static_cov_approximation_type = &cov_approximation_type;
 }
 
@@ -3068,7 +3120,7 @@ void NonDMultilevelSampling::target_scalarization_objective_eval_optpp(int mode,
             Real grad_f_bootstrap_cov_tmp = 0;
             for (lev = 0; lev < num_lev; ++lev) {
               //TODO_SCALARBUGFIX x[lev] -> (*static_Nlq_pilot)[lev]: Results in a zero gradient and constant over N bootstrap estimation.
-              f_cov_estimate += compute_bootstrap_covariance(lev, cur_qoi, *static_levQoisamplesmatrixMap, (*static_Nlq_pilot)[lev], compute_gradient, grad_f_bootstrap_cov_tmp, static_randomSeed);
+              f_cov_estimate += compute_bootstrap_covariance(lev, cur_qoi, *static_levQoisamplesmatrixMap, (*static_Nlq_pilot)[lev], compute_gradient, grad_f_bootstrap_cov_tmp, static_randomSeed, *static_bootstrapCache);
               if(compute_gradient){
                 grad_f_cov_estimate[lev] = grad_f_bootstrap_cov_tmp;
               }
@@ -3240,7 +3292,7 @@ void NonDMultilevelSampling::target_scalarization_objective_eval_optpp_fd(int mo
             Real grad_f_bootstrap_cov_tmp = 0;
             for (lev = 0; lev < num_lev; ++lev) {
               //TODO_SCALARBUGFIX x[lev] -> (*static_Nlq_pilot)[lev]: Results in a zero gradient and constant over N bootstrap estimation.
-              f_cov_estimate += compute_bootstrap_covariance(lev, cur_qoi, *static_levQoisamplesmatrixMap, (*static_Nlq_pilot)[lev], compute_gradient, grad_f_bootstrap_cov_tmp, static_randomSeed);
+              f_cov_estimate += compute_bootstrap_covariance(lev, cur_qoi, *static_levQoisamplesmatrixMap, (*static_Nlq_pilot)[lev], compute_gradient, grad_f_bootstrap_cov_tmp, static_randomSeed, *static_bootstrapCache);
             }
           }
           break;
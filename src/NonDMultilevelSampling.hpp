@@ -21,6 +21,29 @@
 
 namespace Dakota {
 
+/// Bootstrap replicates of the samples stored for one level
+
+/** The sample indices of the replicates are drawn once per bootstrap
+    seed and number of stored samples, and the bootstrap covariance (and
+    its gradient) is retained for each QoI and sample count, such that
+    repeated estimates within the sample allocation optimization neither
+    redraw nor reevaluate the replicates. */
+struct BootstrapReplicates
+{
+  /// default constructor
+  BootstrapReplicates(): seed(0), numSamples(0) { }
+
+  /// seed from which the replicate indices were drawn
+  int seed;
+  /// number of stored samples when the replicate indices were drawn
+  int numSamples;
+  /// stored sample indices (rows) of each bootstrap replicate (columns)
+  IntMatrix indices;
+  /// bootstrap covariance and its gradient for each (QoI, N)
+  std::map<std::pair<size_t, Real>, RealRealPair> covariances;
+};
+
+
 /// Performs Multilevel Monte Carlo sampling for uncertainty quantification.
 
 /** Multilevel Monte Carlo (MLMC) is a variance-reduction technique
@@ -40,6 +63,18 @@ public:
   /// destructor
   ~NonDMultilevelSampling();
 
+  //
+  //- Heading: Member functions
+  //
+
+  /// bootstrap estimate of the covariance of the mean and standard
+  /// deviation estimators of a QoI at level step for N samples, drawing
+  /// replicates from (and retaining the estimate in) bootstrap_cache
+  static Real compute_bootstrap_covariance(const size_t step, const size_t qoi,
+    const IntRealMatrixMap& lev_qoisamplematrix_map, const Real N,
+    const bool compute_gradient, Real& grad, int* seed,
+    std::map<size_t, BootstrapReplicates>& bootstrap_cache);
+
 protected:
 
   //
@@ -268,10 +303,6 @@ private:
  									const IntIntPairRealMatrixMap& sum_QlQlm1, 
 									const Sizet2DArray& N_l, const size_t step, const size_t qoi);
 
-  static Real compute_bootstrap_covariance(const size_t step, const size_t qoi, 
-  								const IntRealMatrixMap& lev_qoisamplematrix_map, const Real N,
-  								const bool compute_gradient, Real& grad, int* seed);
-
   static Real compute_cov_mean_sigma(const IntRealMatrixMap& sum_Ql, 
                   const IntRealMatrixMap& sum_Qlm1, 
                   const IntIntPairRealMatrixMap& sum_QlQlm1, 
@@ -547,6 +578,8 @@ private:
   IntRealMatrixMap levQoisamplesmatrixMap;
   bool storeEvals;
   int bootstrapSeed;
+  /// bootstrap replicates of levQoisamplesmatrixMap for each level
+  std::map<size_t, BootstrapReplicates> bootstrapCache;
 
   short cov_approximation_type;
   enum {COV_BOOTSTRAP, COV_PEARSON, COV_CORRLIFT};
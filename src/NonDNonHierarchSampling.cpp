@@ -418,6 +418,11 @@ recover_online_cost(const IntResponseMap& all_resp)
   for (step=0, cntr=0; step<=numApprox; ++step) {
     mf = active_key.retrieve_model_form(step);
     const SizetSizetPair& cost_mdi = costMetadataIndices[mf];
+    if (cost_mdi.first == SZ_MAX) { // offline or measured cost
+      sequenceCost[step]
+	= non_metadata_cost(mf, active_key.retrieve_resolution_level(step));
+      cntr += cost_mdi.second;  continue;
+    }
     md_index = cntr + cost_mdi.first; // index into aggregated metadata
 
     accum = 0.;  num_finite = 0;
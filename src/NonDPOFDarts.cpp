@@ -324,6 +324,7 @@ void NonDPOFDarts::core_run()
         clock_t start_time, end_time; double cpu_time, total_time(0.0);
        
         _num_inserted_points = 0; _num_darts = 0;
+        _point_index.initialize(_n_dim, _total_budget); _max_rr = 0.0;
         
         for (size_t resp_fn_count = 0; resp_fn_count < numFunctions; resp_fn_count++)
         {
@@ -560,14 +561,13 @@ void NonDPOFDarts::core_run()
 
     bool NonDPOFDarts::valid_dart(double* x)
     {
-        for (size_t index = 0; index < _num_inserted_points; index++)
+        // only disks centered within the largest radius of x can cover it
+        SizetArray candidates;
+        _point_index.ball_query(x, std::sqrt(_max_rr), candidates);
+        for (size_t i = 0; i < candidates.size(); i++)
         {
-            double dd(0.0);
-            for (size_t idim = 0; idim < _n_dim; idim++)
-            {
-                double dx = x[idim] - _sample_points[index][idim];
-                dd += dx * dx;
-            }
+            size_t index = candidates[i];
+            double dd = _point_index.distance_squared(index, x);
             
             if (dd < fabs(_sample_points[index][_n_dim])) return false; // prior disk approach
         }
@@ -576,8 +576,12 @@ void NonDPOFDarts::core_run()
     
     bool NonDPOFDarts::valid_line_flat(size_t flat_dim, double* flat_dart)
     {
-        for (size_t index = 0; index < _num_inserted_points; index++)
+        // only disks centered within the largest radius of the line can trim it
+        SizetArray candidates;
+        _point_index.ball_query(flat_dart, std::sqrt(_max_rr), candidates, flat_dim);
+        for (size_t i = 0; i < candidates.size(); i++)
         {
+            size_t index = candidates[i];
             double hh(0.0);
             for (size_t idim = 0; idim < _n_dim; idim++)
             {
@@ -668,6 +672,7 @@ void NonDPOFDarts::core_run()
         _sample_neighbors[_num_inserted_points][0] = 0;
         
         for (size_t idim = 0; idim < _n_dim; idim++) _sample_points[_num_inserted_points][idim] = x[idim];
+        _point_index.insert(x);
         
         double* x_actual = new double[_n_dim];
         for (size_t idim = 0; idim < _n_dim; idim++) x_actual[idim] = _xmin[idim] + x[idim] * (_xmax[idim] - _xmin[idim]);
@@ -695,6 +700,7 @@ void NonDPOFDarts::core_run()
         else
         {
             update_global_L();
+            _max_rr = 0.0; // all radii are reassigned
             for (size_t isample = 0; isample < _num_inserted_points; isample++) assign_sphere_radius_POF(isample);
         }
         delete [] x_actual;
@@ -1058,6 +1064,7 @@ void NonDPOFDarts::core_run()
         
         _sample_points[isample][_n_dim] = r * r;
         if (_fval[_active_response_function][isample] < _failure_threshold) _sample_points[isample][_n_dim] = - _sample_points[isample][_n_dim];
+        if (r * r > _max_rr) _max_rr = r * r;
         
         if (_use_local_L)
         {
@@ -1065,8 +1072,13 @@ void NonDPOFDarts::core_run()
             
             // A sphere shouldn't contain a sample point that is not its neighbor
             
-            for (size_t jsample = 0; jsample < _num_inserted_points; jsample++)
+            // disk radii only shrink below, so the overlapping disks are
+            // among those centered within r + max radius of the sample
+            SizetArray candidates;
+            _point_index.ball_query(_sample_points[isample], r + std::sqrt(_max_rr), candidates);
+            for (size_t icand = 0; icand < candidates.size(); icand++)
             {
+                size_t jsample = candidates[icand];
                 //if (_sample_points[isample][_n_dim] * _sample_points[jsample][_n_dim] > 0.0) continue; // same color
                 
                 if (isample == jsample) continue;
@@ -1117,6 +1129,7 @@ void NonDPOFDarts::core_run()
         {
             if (fabs(_sample_points[isample][_n_dim]) > 0.95 * 0.95 * rr_max) _sample_points[isample][_n_dim] *= (0.95 * 0.95);
         }
+        _max_rr = 0.95 * 0.95 * rr_max;
     }
     
  
@@ -15,6 +15,7 @@
 #include "DakotaNonD.hpp"
 #include "DakotaApproximation.hpp"
 #include "VPSApproximation.hpp"
+#include "SpatialIndex.hpp"
 
 
 
@@ -193,6 +194,8 @@ protected:
     size_t** _sample_neighbors;
     double*  _sample_vsize;
     double   _max_vsize; // size of biggest Voronoi cell
+    SpatialIndex _point_index; // spatial index of the sample points
+    double   _max_rr; // upper bound on the squared radii of all disks
     
     // Darts
     double* _dart; // a dart for inserting a new sample point
@@ -16,6 +16,7 @@
 #include "SensAnalysisGlobal.hpp"
 #include "ProbabilityTransformation.hpp"
 #include "dakota_stat_util.hpp"
+#include "StreamingStatistics.hpp"
 #include "pecos_data_types.hpp"
 #include "NormalRandomVariable.hpp"
 #include "tolerance_intervals.hpp"
@@ -28,6 +29,12 @@ static const char rcsId[]="@(#) $Id: NonDSampling.cpp 7036 2010-10-22 23:20:24Z
 
 namespace Dakota {
 
+/// capacity of the quantile sketches for the p/beta* -> z level mappings,
+/// fixed independent of the number of samples: the mappings are exact up
+/// to this many finite samples of a QoI and approximate beyond it, with a
+/// rank error of a few times the sample count over the capacity
+static const size_t LEVEL_MAPPING_SKETCH_CAPACITY = 65536;
+
 
 /** This constructor is called for a standard letter-envelope iterator
     instantiation.  In this case, set_db_list_nodes has been called and
@@ -1045,24 +1052,18 @@ compute_intervals(RealRealPairArray& extreme_fns, const IntResponseMap& samples)
 {
   // For the samples array, calculate min/max response intervals
 
-  size_t i, j, num_obs = samples.size(), num_samp;
+  size_t i, num_obs = samples.size(), num_samp;
   const StringArray& resp_labels = iteratedModel.response_labels();
 
+  StreamingStatistics batch_stats; // skips NaN and +/-Inf
+  const StreamingStatistics& stream_stats
+    = sample_statistics(samples, batch_stats);
+
   extreme_fns.resize(numFunctions);
-  IntRespMCIter it;
   for (i=0; i<numFunctions; ++i) {
-    num_samp = 0;
-    Real min = DBL_MAX, max = -DBL_MAX;
-    for (it=samples.begin(); it!=samples.end(); ++it) {
-      Real sample = it->second.function_value(i);
-      if (std::isfinite(sample)) { // neither NaN nor +/-Inf
-	if (sample < min) min = sample;
-	if (sample > max) max = sample;
-	++num_samp;
-      }
-    }
-    extreme_fns[i].first  = min;
-    extreme_fns[i].second = max;
+    num_samp = stream_stats.num_samples(i);
+    extreme_fns[i].first  = stream_stats.min(i);
+    extreme_fns[i].second = stream_stats.max(i);
     if (num_samp != num_obs)
       Cerr << "Warning: sampling statistics for " << resp_labels[i] << " omit "
 	   << num_obs-num_samp << " failed evaluations out of " << num_obs
@@ -1123,23 +1124,29 @@ compute_moments(const IntResponseMap& samples, RealMatrix& moment_stats,
   if (!mom_fns && !mom_grads)
     return;
 
-  RealVectorArray fn_samples(num_obs);
-  SizetArray sample_counts;
-  IntRespMCIter it;
-  for (it=samples.begin(), i=0; it!=samples.end(); ++it, ++i)
-    fn_samples[i] = it->second.function_values_view();
-
   if (mom_fns) {
-    compute_moments(fn_samples,sample_counts,moment_stats,moments_type,labels);
+    if (!num_obs) {
+      Cerr << "Error: empty samples array in NonDSampling::compute_moments()."
+	   << std::endl;
+      abort_handler(METHOD_ERROR);
+    }
+    SizetArray sample_counts;
+    StreamingStatistics batch_stats;
+    compute_moments(sample_statistics(samples, batch_stats), sample_counts,
+		    moment_stats, moments_type, labels);
     compute_moment_confidence_intervals(moment_stats, moment_conf_ints,
 					sample_counts, moments_type);
     functionMomentsComputed = true;
   }
 
   if (mom_grads) {
+    RealVectorArray fn_samples(num_obs);
     RealMatrixArray grad_samples(num_obs);
-    for (it=samples.begin(), i=0; it!=samples.end(); ++it, ++i)
+    IntRespMCIter it;
+    for (it=samples.begin(), i=0; it!=samples.end(); ++it, ++i) {
+      fn_samples[i]   = it->second.function_values_view();
       grad_samples[i] = it->second.function_gradients_view();
+    }
     compute_moment_gradients(fn_samples, grad_samples, moment_stats,
 			     moment_grads, moments_type);
   }
@@ -1151,7 +1158,7 @@ compute_moments(const RealVectorArray& fn_samples, SizetArray& sample_counts,
 		RealMatrix& moment_stats, short moments_type,
 		const StringArray& labels)
 {
-  size_t i, j, num_obs = fn_samples.size(), num_qoi;
+  size_t num_obs = fn_samples.size(), num_qoi;
   if (num_obs)
     num_qoi = fn_samples[0].length();
   else {
@@ -1159,22 +1166,38 @@ compute_moments(const RealVectorArray& fn_samples, SizetArray& sample_counts,
 	 << std::endl;
     abort_handler(METHOD_ERROR);
   }
-  Real sum, cm2, cm3, cm4, sample;
 
+  // single pass over the samples, with QoIs partitioned among threads
+  StreamingStatistics stream_stats;
+  stream_stats.initialize(num_qoi);
+  stream_stats.update(fn_samples);
+  compute_moments(stream_stats, sample_counts, moment_stats, moments_type,
+		  labels);
+}
+
+
+void NonDSampling::
+compute_moments(const StreamingStatistics& stream_stats,
+		SizetArray& sample_counts, RealMatrix& moment_stats,
+		short moments_type, const StringArray& labels)
+{
+  size_t i, num_obs = stream_stats.num_observations(),
+    num_qoi = stream_stats.num_qoi();
   if (moment_stats.empty()) moment_stats.shapeUninitialized(4, num_qoi);
   sample_counts.resize(num_qoi);
 
+  bool central = (moments_type == Pecos::CENTRAL_MOMENTS);
   for (i=0; i<num_qoi; ++i) {
     size_t& num_samp = sample_counts[i];
     Real*  moments_i =  moment_stats[i];
-    Pecos::accumulate_mean(fn_samples, i, num_samp, moments_i[0]);
+    num_samp = stream_stats.num_samples(i);
     if (num_samp != num_obs)
       Cerr << "Warning: sampling statistics for " << labels[i] << " omit "
 	   << num_obs-num_samp << " failed evaluations out of " << num_obs
 	   << " samples.\n";
 
     if (num_samp)
-      Pecos::accumulate_moments(fn_samples, i, moments_type, moments_i);
+      stream_stats.moments(i).moments(central, moments_i);
     else {
       Cerr << "Warning: Number of samples for " << labels[i]
 	   << " must be nonzero for moment calculation in NonDSampling::"
@@ -1201,17 +1224,22 @@ compute_moments(const RealVectorArray& fn_samples, RealMatrix& moment_stats,
 
   if (moment_stats.empty()) moment_stats.shapeUninitialized(4, num_qoi);
 
+  StreamingStatistics stream_stats;
+  stream_stats.initialize(num_qoi);
+  stream_stats.update(fn_samples);
+
+  bool central = (moments_type == Pecos::CENTRAL_MOMENTS);
   for (i=0; i<num_qoi; ++i) {
 
     Real* moments_i = moment_stats[i];
-    Pecos::accumulate_mean(fn_samples, i, num_samp, moments_i[0]);
+    num_samp = stream_stats.num_samples(i);
     if (num_samp != num_obs)
       Cerr << "Warning: sampling statistics for quantity " << i+1 << " omit "
 	   << num_obs-num_samp << " failed evaluations out of " << num_obs
 	   << " samples.\n";
 
     if (num_samp)
-      Pecos::accumulate_moments(fn_samples, i, moments_type, moments_i);
+      stream_stats.moments(i).moments(central, moments_i);
     else {
       Cerr << "Warning: Number of samples for quantity " << i+1
 	   << " must be nonzero in NonDSampling::compute_moments().\n";
@@ -1576,10 +1604,8 @@ void NonDSampling::compute_level_mappings(const IntResponseMap& samples)
   // For the samples array, calculate the following statistics:
   // > CDF/CCDF mappings of response levels to probability/reliability levels
   // > CDF/CCDF mappings of probability/reliability levels to response levels
-  size_t i, j, k, num_obs = samples.size(), num_samp, bin_accumulator;
+  size_t i, j, k, num_samp, bin_accumulator;
   const StringArray& resp_labels = iteratedModel.response_labels();
-  std::multiset<Real> sorted_samples; // STL-based array for sorting
-  SizetArray bins; Real min, max, sample;
 
   // check if moments are required, and if so, compute them now
   if (momentStats.empty()) {
@@ -1603,8 +1629,13 @@ void NonDSampling::compute_level_mappings(const IntResponseMap& samples)
     }
   }
 
+  // Samples binned at the response levels for z -> p/beta* and sketched
+  // for p/beta* -> z (see initialize_sample_statistics())
+  StreamingStatistics batch_stats;
+  const StreamingStatistics& stream_stats
+    = sample_statistics(samples, batch_stats);
+
   if (pdfOutput) extremeValues.resize(numFunctions);
-  IntRespMCIter s_it; std::multiset<Real>::iterator ss_it;
   const ShortArray& final_asv = finalStatistics.active_set_request_vector();
   bool extrapolated_mappings = false,
     central_mom = (finalMomentsType == Pecos::CENTRAL_MOMENTS);
@@ -1620,55 +1651,12 @@ void NonDSampling::compute_level_mappings(const IntResponseMap& samples)
            bl_len = requestedRelLevels[i].length(),
            gl_len = requestedGenRelLevels[i].length();
 
-    // ----------------------------------------------------------------------
-    // Preliminaries: define finite subset, sort (if needed), and bin samples
-    // ----------------------------------------------------------------------
-    num_samp = 0;
-    if (pl_len || gl_len) { // sort samples array for p/beta* -> z mappings
-      sorted_samples.clear();
-      for (s_it=samples.begin(); s_it!=samples.end(); ++s_it) {
-        sample = s_it->second.function_value(i);
-	if (std::isfinite(sample))
-	  { ++num_samp; sorted_samples.insert(sample); }
-      }
-      // sort in ascending order
-      if (pdfOutput)
-        { min = *sorted_samples.begin(); max = *(--sorted_samples.end()); }
-      // in case of rl_len mixed with pl_len/gl_len, bin using sorted array.
-      if (rl_len && respLevelTarget != RELIABILITIES) {
-	const RealVector& req_rl_i = requestedRespLevels[i];
-        bins.assign(rl_len+1, 0); ss_it = sorted_samples.begin();
-	for (j=0; j<rl_len; ++j)
-	  while (ss_it!=sorted_samples.end() && *ss_it <= req_rl_i[j])// p(g<=z)
-	    { ++bins[j]; ++ss_it; }
-	bins[rl_len] += std::distance(ss_it, sorted_samples.end());
-      }
-    }
-    else if (rl_len && respLevelTarget != RELIABILITIES) {
-      // in case of rl_len without pl_len/gl_len, bin from original sample set
-      const RealVector& req_rl_i = requestedRespLevels[i];
-      bins.assign(rl_len+1, 0); min = DBL_MAX; max = -DBL_MAX;
-      for (s_it=samples.begin(); s_it!=samples.end(); ++s_it) {
-	sample = s_it->second.function_value(i);
-	if (std::isfinite(sample)) {
-	  ++num_samp;
-	  if (pdfOutput) {
-	    if (sample < min) min = sample;
-	    if (sample > max) max = sample;
-	  }
-	  // 1st PDF bin from -inf to 1st resp lev; last PDF bin from last resp
-	  // lev to +inf.
-	  bool found = false;
-	  for (k=0; k<rl_len; ++k)
-	    if (sample <= req_rl_i[k]) // cumulative p(g<=z)
-	      { ++bins[k]; found = true; break; }
-	  if (!found)
-	    ++bins[rl_len];
-	}
-      }
+    num_samp = stream_stats.num_samples(i);
+    const SizetArray& bins = stream_stats.level_counts(i);
+    if (pdfOutput) {
+      extremeValues[i].first  = stream_stats.min(i);
+      extremeValues[i].second = stream_stats.max(i);
     }
-    if (pdfOutput)
-      { extremeValues[i].first = min; extremeValues[i].second = max; }
 
     cntr += moment_offset;
     // ----------------
@@ -1742,21 +1730,21 @@ void NonDSampling::compute_level_mappings(const IntResponseMap& samples)
       //   omit any out-of-bounds resp levels within NonD::compute_densities()?
       //   --> PDF estimation based only on z->p binning or p->z interpolation
       //       within the sample bounds.
+      const QuantileSketch& sorted_samples = stream_stats.quantiles(i);
       Real cdf_incr_id = p_cdf * (Real)num_samp, lo_id;
-      ss_it = sorted_samples.begin();
       if (cdf_incr_id < 1.) { // extrapolate left of min sample using 1st slope
 	lo_id = 1.; extrapolated_mappings = true;
 	Cerr << "Warning: extrapolation required for response " << i+1;
 	if (j<pl_len) Cerr <<    " for probability level " << j+1       <<".\n";
 	else Cerr << " for generalized reliability level " << j+1-pl_len<<".\n";
       }
-      else { // linear interpolation between closest neighbors in sequence
+      else // linear interpolation between closest neighbors in sequence
         lo_id = std::floor(cdf_incr_id);
-	std::advance(ss_it, (size_t)lo_id - 1);
-      }
-      Real z, z_lo = *ss_it; ++ss_it;
-      if (ss_it == sorted_samples.end()) z = z_lo;
-      else          z = z_lo + (cdf_incr_id - lo_id) * (*ss_it - z_lo);
+      size_t lo_index = (size_t)lo_id - 1;
+      Real z, z_lo = sorted_samples.ranked_value(lo_index);
+      if (lo_index + 1 >= num_samp) z = z_lo;
+      else z = z_lo + (cdf_incr_id - lo_id)
+	     * (sorted_samples.ranked_value(lo_index + 1) - z_lo);
       if (j<pl_len) computedRespLevels[i][j] = z;
       else          computedRespLevels[i][j+bl_len] = z;
     }
@@ -1800,6 +1788,75 @@ void NonDSampling::compute_level_mappings(const IntResponseMap& samples)
 }
 
 
+void NonDSampling::
+initialize_sample_statistics(size_t num_qoi, StreamingStatistics& stats) const
+{
+  // level mappings apply only to the numFunctions QoIs of iteratedModel
+  // (not, e.g., to QoIs aggregated across the models of an ensemble)
+  if (num_qoi != numFunctions || !totalLevelRequests)
+    { stats.initialize(num_qoi); return; }
+
+  RealVectorArray bin_levels(numFunctions);
+  BitArray sort_samples(numFunctions);
+  for (size_t i=0; i<numFunctions; ++i) {
+    if (respLevelTarget != RELIABILITIES)
+      bin_levels[i] = requestedRespLevels[i];
+    if (requestedProbLevels[i].length() || requestedGenRelLevels[i].length())
+      sort_samples.set(i);
+  }
+  stats.initialize(numFunctions, bin_levels, sort_samples,
+		   LEVEL_MAPPING_SKETCH_CAPACITY);
+}
+
+
+const StreamingStatistics& NonDSampling::
+sample_statistics(const IntResponseMap& samples,
+		  StreamingStatistics& batch_stats)
+{
+  // streamStats applies if samples is allResponses as logged by the most
+  // recent evaluate_parameter_sets() (not since replaced, e.g., on input)
+  size_t i, num_obs = samples.size();
+  if (&samples == &allResponses && num_obs &&
+      streamStats.num_observations() == num_obs &&
+      samples.begin()->first  == streamEvalIds.first &&
+      samples.rbegin()->first == streamEvalIds.second) {
+    streamStats.finalize();
+    return streamStats;
+  }
+
+  // single pass over the samples, with QoIs partitioned among threads
+  RealVectorArray fn_samples(num_obs);
+  IntRespMCIter it;
+  for (it=samples.begin(), i=0; it!=samples.end(); ++it, ++i)
+    fn_samples[i] = it->second.function_values_view();
+  initialize_sample_statistics((num_obs) ? fn_samples[0].length() :
+			       numFunctions, batch_stats);
+  batch_stats.update(fn_samples);
+  batch_stats.finalize();
+  return batch_stats;
+}
+
+
+void NonDSampling::initialize_response_accumulation()
+{ streamStats.reset(); }
+
+
+/** Called as each evaluation of allResponses completes in
+    evaluate_parameter_sets(), so that the statistics are available
+    without revisiting the samples.  Synchronous evaluations are
+    accumulated one at a time; asynchronous evaluations as the
+    synchronized responses are logged. */
+void NonDSampling::accumulate_response(int eval_id, const Response& resp)
+{
+  if (!streamStats.num_observations()) {
+    initialize_sample_statistics(resp.num_functions(), streamStats);
+    streamEvalIds.first = eval_id;
+  }
+  streamStats.update(resp.function_values());
+  streamEvalIds.second = eval_id;
+}
+
+
 void NonDSampling::update_final_statistics()
 {
   if (finalStatistics.is_null()) // some ctor chains do not track final stats
@@ -14,6 +14,7 @@
 #include "DakotaNonD.hpp"
 #include "LHSDriver.hpp"
 #include "SensAnalysisGlobal.hpp"
+#include "StreamingStatistics.hpp"
 
 namespace Dakota {
 
@@ -77,6 +78,11 @@ public:
 			      SizetArray& sample_counts,
 			      RealMatrix& moment_stats, short moments_type,
 			      const StringArray& labels);
+  /// compute_moments() implementation from accumulated statistics
+  static void compute_moments(const StreamingStatistics& stats,
+			      SizetArray& sample_counts,
+			      RealMatrix& moment_stats, short moments_type,
+			      const StringArray& labels);
   /// core compute_moments() implementation with all data as inputs
   static void compute_moments(const RealVectorArray& fn_samples,
 			      RealMatrix& moment_stats, short moments_type);
@@ -267,6 +273,11 @@ protected:
   /// return error estimates associated with each of the finalStatistics
   const RealSymMatrix& response_error_estimates() const;
 
+  /// reset streamStats ahead of the evaluations in evaluate_parameter_sets()
+  void initialize_response_accumulation();
+  /// update streamStats with a response as it is logged
+  void accumulate_response(int eval_id, const Response& resp);
+
   //
   //- Heading: New virtual functions
   //
@@ -414,6 +425,15 @@ private:
   void sample_to_drv(const Real* sample_vars, Variables& vars,
 		     size_t& adrv_index, size_t num_adrv, size_t& samp_index);
 
+  /// configure stats for num_qoi QoIs, with response level bins and
+  /// quantile sketches for the level mappings if num_qoi is numFunctions
+  void initialize_sample_statistics(size_t num_qoi,
+				    StreamingStatistics& stats) const;
+  /// return streamStats if it was accumulated from samples, else
+  /// accumulate the statistics of samples in batch_stats and return it
+  const StreamingStatistics& sample_statistics(const IntResponseMap& samples,
+					       StreamingStatistics& batch_stats);
+
   //
   //- Heading: Data
   //
@@ -421,6 +441,13 @@ private:
   /// Matrix of confidence internals on moments, with rows for mean_lower,
   /// mean_upper, sd_lower, sd_upper (calculated in compute_moments())
   RealMatrix momentCIs;
+
+  /// statistics of allResponses, updated as each evaluation is logged by
+  /// evaluate_parameter_sets()
+  StreamingStatistics streamStats;
+  /// evaluation ids of the first and last responses in streamStats,
+  /// identifying the allResponses from which it was accumulated
+  IntIntPair streamEvalIds;
 };
 
 
@@ -31,6 +31,7 @@ NonDWASABIBayesCalibration::
 NonDWASABIBayesCalibration(ProblemDescDB& problem_db, Model& model):
   NonDBayesCalibration(problem_db, model),
   numPushforwardSamples(probDescDB.get_int("method.nond.pushforward_samples")),
+  pushforwardKDETol(probDescDB.get_real("method.nond.kde_tolerance")),
   dataDistMeans(probDescDB.get_rv("method.nond.data_dist_means")),
   dataDistCovariance(probDescDB.get_rv("method.nond.data_dist_covariance")),
   dataDistFilename(probDescDB.get_string("method.nond.data_dist_filename")),
@@ -144,7 +145,11 @@ void NonDWASABIBayesCalibration::calibrate()
   // compute_responses returns a matrix (num_qoi x num_samples)
   // but kde.inititalize expects the transpose of this matrix
   Pecos::DensityEstimator response_kde("gaussian_kde");
-  response_kde.initialize(pushforward_responses_from_prior, Teuchos::TRANS );
+  TreeGaussianKDE tree_kde(pushforwardKDETol);
+  if (pushforwardKDETol > 0.)
+    tree_kde.initialize(pushforward_responses_from_prior);
+  else
+    response_kde.initialize(pushforward_responses_from_prior, Teuchos::TRANS);
 
   ////////////////////////////////////////////////////////
   // Step 5 of 10: Pick a set of points (s_eval) to evaluate 
@@ -175,13 +180,8 @@ void NonDWASABIBayesCalibration::calibrate()
   // Step 6 of 10: Evaluate the prior density at samples_for_posterior_eval
   ////////////////////////////////////////////////////////
 
-  RealVector prior_density_vals(samples_for_posterior_eval.numCols(), false);
-
-  for (int j=0; j<samples_for_posterior_eval.numCols(); j++) {
-    RealVector samp_j(Teuchos::View, samples_for_posterior_eval[j],
-		      numContinuousVars);
-    prior_density_vals[j] = prior_density(samp_j);
-  }
+  RealVector prior_density_vals;
+  prior_density(samples_for_posterior_eval, prior_density_vals);
   
   ////////////////////////////////////////////////////////
   // Step 7 of 10: Evaluate the RSA at s_eval -> q_eval = RSA(s_eval)
@@ -202,10 +202,16 @@ void NonDWASABIBayesCalibration::calibrate()
   // Step 8 of 10: Evaluate the density at q_eval
   ////////////////////////////////////////////////////////
 
+  // the tree KDE sums only the kernels near each point, evaluating
+  // the points concurrently
   RealVector response_density_vals_for_posterior_eval;
-  response_kde.pdf(responses_for_posterior_eval, 
-		   response_density_vals_for_posterior_eval,
-		   Teuchos::TRANS);
+  if (pushforwardKDETol > 0.)
+    tree_kde.pdf(responses_for_posterior_eval,
+		 response_density_vals_for_posterior_eval);
+  else
+    response_kde.pdf(responses_for_posterior_eval, 
+		     response_density_vals_for_posterior_eval,
+		     Teuchos::TRANS);
 
   ////////////////////////////////////////////////////////
   // Step 9 of 10: Evaluate the given data distribution at q_eval
@@ -400,25 +406,12 @@ print_results(std::ostream& s, short results_state)
 }
 
 
+/** The samples are evaluated as a batch, concurrently if the model
+    supports asynchronous evaluation. */
 void NonDWASABIBayesCalibration::
 compute_responses(RealMatrix & samples, RealMatrix & responses)
 {
-
-  int num_samples = samples.numCols();
-  responses.shapeUninitialized(numFunctions, num_samples);
-
-  for (int j=0; j<num_samples; j++) {
-    RealVector sample(Teuchos::View, samples[j], numContinuousVars);
-    
-    mcmcModel.continuous_variables(sample); 
-
-    mcmcModel.evaluate();
-    const Response& curr_resp = mcmcModel.current_response();
-    const RealVector& fn_vals = curr_resp.function_values();
-
-    RealVector response_col(Teuchos::View, responses[j], numFunctions); 
-    response_col.assign(fn_vals);
-  }
+  Model::evaluate(samples, mcmcModel, responses);
 }
 
 } // namespace Dakota
@@ -12,6 +12,7 @@
 
 #include "NonDBayesCalibration.hpp"
 #include "GaussianKDE.hpp"
+#include "TreeGaussianKDE.hpp"
 #include "dakota_mersenne_twister.hpp"
 
 namespace Dakota {
@@ -80,6 +81,9 @@ protected:
   //- Heading: Data
   /// number of samples from the prior that is pushed forward through the model
   int numPushforwardSamples;
+  /// relative error tolerance of the density estimate of the pushforward
+  /// responses; if positive, TreeGaussianKDE replaces the exact Pecos KDE
+  Real pushforwardKDETol;
   /// The mean of the multivariate Gaussian distribution of the obs. data
   RealVector dataDistMeans;
   /// The covariance of the multivariate Gaussian distribution of the obs. data
@@ -7,7 +7,10 @@
     For more information, see the README file in the top Dakota directory.
     _______________________________________________________________________ */
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
+#include <thread>
 #include <utility>
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/regex.hpp>
@@ -23,11 +26,18 @@
 #include "dakota_tabular_io.hpp"
 #include "ResultsDBAny.hpp"
 #include "EvaluationStore.hpp"
+#include "util_threads.hpp"
 
 #ifdef DAKOTA_HAVE_HDF5
 #include "HDF5_IO.hpp"
 #include "ResultsDBHDF5.hpp"
 #endif
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 //#define OUTMGR_DEBUG 1
 
 namespace Dakota {
@@ -219,7 +229,10 @@ void OutputManager::close_streams()
 {
   // cout/cerr will be restored to default when the redirector is destroyed
 
-  // any remaining restart files will be closed at the destructor...
+  // any remaining restart files will be closed at the destructor, but
+  // flush records held back by group commit in case this is an abort
+  for (std::shared_ptr<RestartWriter>& rst_writer : restartDestinations)
+    rst_writer->flush();
   //restartDestinations.clear();
 
   // After completion of timings in ParallelLibrary... 
@@ -254,6 +267,9 @@ void OutputManager::parse(const ProgramOptions& prog_opts,
   resultsOutputFile = problem_db.get_string("environment.results_output_file");
   modelEvalsSelection = problem_db.get_ushort("environment.model_evals_selection");
   interfEvalsSelection = problem_db.get_ushort("environment.interface_evals_selection");
+  evalBufferSize = problem_db.get_int("environment.eval_buffer_size");
+  evalBufferFlushInterval =
+    problem_db.get_int("environment.eval_buffer_flush_interval");
   tabularFormat = problem_db.get_ushort("environment.tabular_format");
   resultsOutputFormat = problem_db.get_ushort("environment.results_output_format");
   if(resultsOutputFlag && resultsOutputFormat == 0)
@@ -312,7 +328,8 @@ push_output_tag(const String& iterator_tag, const ProgramOptions& prog_opts,
   read_write_restart(force_rst_redirect, read_restart_flag, 
 		     prog_opts.read_restart_file() + file_tag,
 		     prog_opts.stop_restart_evals(),
-		     prog_opts.write_restart_file() + file_tag);
+		     prog_opts.write_restart_file() + file_tag,
+		     prog_opts.restart_flush_interval());
 }
 
 
@@ -404,10 +421,9 @@ void OutputManager::append_restart(const ParamResponsePair& prp)
 	 << std::endl;
     abort_handler(-1);
   }
-  std::shared_ptr<RestartWriter> rst_writer = restartDestinations.back();
-  rst_writer->append_prp(prp);
-  // flush is critical so we have a complete restart record should Dakota abort
-  rst_writer->flush();
+  // flushes (possibly grouped) are critical so we have a complete
+  // restart record should Dakota abort
+  restartDestinations.back()->append_prp(prp);
 }
 
 
@@ -652,6 +668,8 @@ void OutputManager::init_results_db()
     evaluation_store_db.set_database(hdf5_helper_ptr);
     evaluation_store_db.model_selection(modelEvalsSelection);
     evaluation_store_db.interface_selection(interfEvalsSelection);
+    evaluation_store_db.buffer_evaluations(evalBufferSize,
+					   evalBufferFlushInterval);
   #else
     Cerr << "WARNING: HDF5 results output was requested, but is not available in this build.\n";
   #endif
@@ -688,7 +706,8 @@ void OutputManager::read_write_restart(bool restart_requested,
 				       bool read_restart_flag,
 				       const String& read_restart_filename,
 				       size_t stop_restart_evals,
-				       const String& write_restart_filename)
+				       const String& write_restart_filename,
+				       int restart_flush_interval)
 {
   // If no restart requested, push back a level that doesn't open
   // files so we can later pop it
@@ -716,72 +735,38 @@ void OutputManager::read_write_restart(bool restart_requested,
     try {
 
       // warn on old restart file
-      RestartVersion rst_ver =
-	RestartVersion::check_restart_version(read_restart_filename);
-
-      std::ifstream restart_input_fs(read_restart_filename.c_str(),
-				     std::ios::binary);
-      if (!restart_input_fs.good()) {
-	Cerr << "\nError: could not open restart file '"
-	     << read_restart_filename << "' for reading."<< std::endl;
-	abort_handler(IO_ERROR);
-      }
-      boost::archive::binary_iarchive restart_input_archive(restart_input_fs);
+      RestartReader rst_reader(read_restart_filename);
 
       Cout << "Reading restart file '" << read_restart_filename << "'.\n"
 	   << "  Any unexpected errors may indicate a corrupt restart file; "
 	   << "using -stop_restart\n  to truncate the read may help."
 	   << std::endl;
 
-      // re-read the full, correct version info from the new stream
-      if (RestartVersion::restartFirstVersionNumber <= rst_ver.restartVersion)
-	restart_input_archive & rst_ver;
-
       // The -stop_restart input for restricting the number of
       // evaluations read in from the restart file is very useful when
       // the last few evaluations in a run were corrupted.  Note that
       // the desired -stop_restart setting may differ from the
       // evaluation number in the previous run since detected
       // duplicates are included in Interface::evalIdCntr, but are not
-      // written to the restart file!
+      // written to the restart file!  Corrupt or incomplete records at
+      // the end of the file are detected and dropped by the reader.
       if (stop_restart_evals)// cmd_line_handler rtns 0 if no setting
 	Cout << "Stopping restart file processing at "
 	     << stop_restart_evals << " evaluations." << std::endl;
 
-      int cntr = 0;
-      restart_input_fs.peek(); // peek to force EOF if the last record was read
-      while ( restart_input_fs.good() && !restart_input_fs.eof() &&
-	      (!stop_restart_evals ||
-	       cntr < stop_restart_evals) ) {
-	// Use default ctor; relies on Variables and Response reads to size them
-	ParamResponsePair current_pair;
-	try {
-	  // this reads vars (svd, vars), iface, resp, eval_id
-	  // Would like to catch bad reads before bad allocs / segfaults...
-	  restart_input_archive & current_pair;
-	}
-	// TODO: should it be the default to truncate and warn when bad?!?
-	catch(const boost::archive::archive_exception& e) {
-	  Cerr << "\nError reading restart file '" << read_restart_filename
-	       << "'.\nYou may be able to recover the first " << cntr
-	       << " evaluations with -stop_restart " << cntr
-	       << ".\nDetails (boost::archive exception): "
-	       << e.what() << std::endl;
-	  abort_handler(IO_ERROR);
-	}
-
+      // Use default ctors; relies on Variables and Response reads to size them
+      PRPArray rst_pairs;
+      size_t cntr = rst_reader.read_prps(rst_pairs, stop_restart_evals);
+      for (size_t i=0; i<cntr; ++i) {
+	const ParamResponsePair& current_pair = rst_pairs[i];
 	read_pairs.insert(current_pair);
-	++cntr;
 	Cout << "\n------------------------------------------\nRestart record "
-	     << std::setw(4) << cntr << "  (evaluation id " << std::setw(4)
+	     << std::setw(4) << i+1 << "  (evaluation id " << std::setw(4)
 	     << current_pair.eval_id() << "):"
 	     << "\n------------------------------------------\n"
 	     << current_pair;
 	// Note: interface id printed in ParamResponsePair::write(ostream&)
-
-	restart_input_fs.peek(); // peek to force EOF if last record was read
       }
-      restart_input_fs.close();
       Cout << "Restart file processing completed: " << cntr
 	   << " evaluations retrieved.\n";
     }
@@ -831,6 +816,7 @@ void OutputManager::read_write_restart(bool restart_requested,
     // create a new restart destination
     std::shared_ptr<RestartWriter>
       rst_writer(new RestartWriter(write_restart_filename));
+    rst_writer->flush_interval(restart_flush_interval);
     restartDestinations.push_back(rst_writer);
 
     // Write any processed records from the old restart file to the new file.
@@ -1004,14 +990,18 @@ void ConsoleRedirector::pop_back()
 }
 
 
-RestartWriter::RestartWriter()
+RestartWriter::RestartWriter():
+  restartOutputStream(NULL), framedRecords(false), recordOffset(0),
+  flushInterval(0)
 {  /* empty ctor */  }
 
 
 RestartWriter::RestartWriter(const String& write_restart_filename,
 			     bool write_version):
   restartOutputFilename(write_restart_filename),
-  restartOutputFS(restartOutputFilename.c_str(), std::ios::binary)
+  restartOutputFS(restartOutputFilename.c_str(), std::ios::binary),
+  restartOutputStream(&restartOutputFS), framedRecords(false),
+  recordOffset(0), flushInterval(0)
 {
   if (!restartOutputFS.good()) {
     Cerr << "\nError: could not open restart file '"
@@ -1021,10 +1011,11 @@ RestartWriter::RestartWriter(const String& write_restart_filename,
 
   restartOutputArchive.reset(new boost::archive::binary_oarchive(restartOutputFS));
 
+  // without version info, the file mimics a pre-6.17.0 archive stream
   if (write_version) {
     RestartVersion rst_version(DakotaBuildInfo::get_release_num(),
 			       DakotaBuildInfo::get_rev_number());
-    restartOutputArchive->operator&(rst_version);
+    this->write_version(rst_version);
   }
 }
 
@@ -1032,7 +1023,9 @@ RestartWriter::RestartWriter(const String& write_restart_filename,
 RestartWriter::RestartWriter(const String& write_restart_filename,
 			     const RestartVersion& rst_version):
   restartOutputFilename(write_restart_filename),
-  restartOutputFS(restartOutputFilename.c_str(), std::ios::binary)
+  restartOutputFS(restartOutputFilename.c_str(), std::ios::binary),
+  restartOutputStream(&restartOutputFS), framedRecords(false),
+  recordOffset(0), flushInterval(0)
 {
   if (!restartOutputFS.good()) {
     Cerr << "\nError: could not open restart file '"
@@ -1042,16 +1035,39 @@ RestartWriter::RestartWriter(const String& write_restart_filename,
 
   restartOutputArchive.reset(new boost::archive::binary_oarchive(restartOutputFS));
 
-  restartOutputArchive->operator&(rst_version);
+  write_version(rst_version);
 }
 
 
 RestartWriter::RestartWriter(std::ostream& write_restart_ostream):
-  restartOutputArchive(new boost::archive::binary_oarchive(write_restart_ostream))
+  restartOutputStream(&write_restart_ostream),
+  restartOutputArchive(new boost::archive::binary_oarchive(write_restart_ostream)),
+  framedRecords(false), recordOffset(0), flushInterval(0)
 {
   RestartVersion rst_version(DakotaBuildInfo::get_release_num(),
 			     DakotaBuildInfo::get_rev_number());
+  write_version(rst_version);
+}
+
+
+RestartWriter::~RestartWriter()
+{
+  if (framedRecords && restartOutputStream) {
+    write_index();
+    restartOutputStream->flush();
+  }
+}
+
+
+void RestartWriter::write_version(const RestartVersion& rst_version)
+{
   restartOutputArchive->operator&(rst_version);
+  framedRecords = rst_version.framed_records();
+  if (framedRecords) {
+    // records are written directly to the stream following the header
+    std::streampos pos = restartOutputStream->tellp();
+    recordOffset = (pos == std::streampos(-1)) ? 0 : (unsigned long long)pos;
+  }
 }
 
 
@@ -1061,16 +1077,390 @@ const String& RestartWriter::filename()
 
 void RestartWriter::append_prp(const ParamResponsePair& prp_in)
 { 
-  if (restartOutputArchive)  // equivalent to NULL check
-    restartOutputArchive->operator&(prp_in);
-  else {
+  if (!restartOutputArchive) {  // equivalent to NULL check
     Cerr << "\nError: attempt to write to invalid restart file." << std::endl;
     abort_handler(IO_ERROR);
   }
+
+  if (framedRecords) {
+    // each payload is a complete archive so records decode independently
+    recordBuffer.str("");
+    {
+      boost::archive::binary_oarchive
+	record_archive(recordBuffer, boost::archive::no_header);
+      record_archive & prp_in;
+    }
+    const std::string& payload = recordBuffer.str();
+
+    RestartVersion::RecordHeader header;
+    header.magic    = RestartVersion::recordMagic;
+    header.length   = payload.size();
+    header.checksum = RestartVersion::checksum(payload.data(), payload.size());
+    header.evalId   = prp_in.eval_id();
+    restartOutputStream->write((const char*)&header, sizeof(header));
+    restartOutputStream->write(payload.data(), payload.size());
+
+    RestartVersion::IndexEntry entry;
+    entry.evalId = header.evalId; entry.reserved = 0;
+    entry.offset = recordOffset;
+    recordIndex.push_back(entry);
+    recordOffset += sizeof(header) + payload.size();
+  }
+  else
+    restartOutputArchive->operator&(prp_in);
+
+  // group commit: flush once the interval has elapsed since the last flush
+  if (flushInterval == 0 ||
+      (flushInterval > 0 && std::chrono::steady_clock::now() - lastFlush >=
+       std::chrono::seconds(flushInterval)))
+    flush();
 }
 
 void RestartWriter::flush()
-{ restartOutputFS.flush(); }
+{
+  if (restartOutputStream)
+    restartOutputStream->flush();
+  lastFlush = std::chrono::steady_clock::now();
+}
+
+
+void RestartWriter::flush_interval(int interval)
+{ flushInterval = interval; }
+
+
+/** The index is a record whose payload holds one IndexEntry per
+    evaluation record; the trailer that follows it at the end of the
+    file locates it. */
+void RestartWriter::write_index()
+{
+  const char* entries = (const char*)recordIndex.data();
+  size_t length = recordIndex.size() * sizeof(RestartVersion::IndexEntry);
+
+  RestartVersion::RecordHeader header;
+  header.magic    = RestartVersion::indexMagic;
+  header.length   = length;
+  header.checksum = RestartVersion::checksum(entries, length);
+  header.evalId   = recordIndex.size();
+  restartOutputStream->write((const char*)&header, sizeof(header));
+  restartOutputStream->write(entries, length);
+
+  RestartVersion::IndexTrailer trailer;
+  trailer.indexOffset = recordOffset;
+  trailer.magic       = RestartVersion::trailerMagic;
+  trailer.reserved    = 0;
+  restartOutputStream->write((const char*)&trailer, sizeof(trailer));
+}
+
+
+RestartReader::RestartReader(const String& read_restart_filename):
+  restartInputFilename(read_restart_filename), restartInputStream(NULL),
+  restartData(NULL), restartDataSize(0), mappedSize(0), nextRecord(0),
+  truncatedFlag(false)
+{
+  // warn on old restart file
+  restartVersion = RestartVersion::check_restart_version(read_restart_filename);
+
+  restartInputFS.open(read_restart_filename.c_str(), std::ios::binary);
+  if (!restartInputFS.good()) {
+    Cerr << "\nError: could not open restart file '"
+	 << read_restart_filename << "' for reading."<< std::endl;
+    abort_handler(IO_ERROR);
+  }
+  initialize(restartInputFS, 0);
+}
+
+
+RestartReader::RestartReader(std::istream& read_restart_stream):
+  restartInputStream(NULL), restartData(NULL), restartDataSize(0),
+  mappedSize(0), nextRecord(0), truncatedFlag(false)
+{
+  std::streamoff data_start = read_restart_stream.tellg();
+  try {
+    boost::archive::binary_iarchive version_archive(read_restart_stream);
+    version_archive & restartVersion;
+  }
+  catch (const std::exception& e) {
+    restartVersion = RestartVersion();
+  }
+  initialize(read_restart_stream, data_start);
+}
+
+
+RestartReader::~RestartReader()
+{
+#ifdef HAVE_SYS_MMAN_H
+  if (mappedSize)
+    munmap(const_cast<char*>(restartData), mappedSize);
+#endif
+}
+
+
+void RestartReader::
+initialize(std::istream& input_stream, std::streamoff data_start)
+{
+  if (!restartVersion.framed_records()) {
+    // older file: rewind and (re-)read the version info from a new archive
+    input_stream.clear();
+    input_stream.seekg(data_start);
+    restartInputArchive.reset
+      (new boost::archive::binary_iarchive(input_stream));
+    if (RestartVersion::restartFirstVersionNumber <=
+	restartVersion.restartVersion)
+      restartInputArchive->operator&(restartVersion);
+    restartInputStream = &input_stream;
+    return;
+  }
+
+  // skip the version info to find the first record
+  input_stream.clear();
+  input_stream.seekg(data_start);
+  {
+    boost::archive::binary_iarchive version_archive(input_stream);
+    version_archive & restartVersion;
+  }
+  std::streamoff records_start = input_stream.tellg() - data_start;
+
+  input_stream.seekg(data_start);
+  load_data(input_stream);
+  if (!read_index())
+    scan_records(records_start);
+}
+
+
+void RestartReader::load_data(std::istream& input_stream)
+{
+#ifdef HAVE_SYS_MMAN_H
+  // map the file itself rather than copying it through the stream
+  if (!restartInputFilename.empty()) {
+    int fd = open(restartInputFilename.c_str(), O_RDONLY);
+    struct stat st;
+    if (fd >= 0 && fstat(fd, &st) == 0 && st.st_size > 0) {
+      void* addr = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (addr != MAP_FAILED) {
+	restartData = (const char*)addr;
+	restartDataSize = mappedSize = st.st_size;
+	madvise(addr, mappedSize, MADV_WILLNEED);
+      }
+    }
+    if (fd >= 0)
+      close(fd);
+    if (mappedSize)
+      return;
+  }
+#endif
+  dataBuffer.assign(std::istreambuf_iterator<char>(input_stream),
+		    std::istreambuf_iterator<char>());
+  restartData = dataBuffer.data();
+  restartDataSize = dataBuffer.size();
+}
+
+
+bool RestartReader::read_index()
+{
+  RestartVersion::IndexTrailer trailer;
+  if (restartDataSize < sizeof(trailer))
+    return false;
+  size_t trailer_offset = restartDataSize - sizeof(trailer);
+  std::memcpy(&trailer, restartData + trailer_offset, sizeof(trailer));
+
+  RestartVersion::RecordHeader header;
+  if (trailer.magic != RestartVersion::trailerMagic ||
+      trailer.indexOffset >= trailer_offset ||
+      !valid_header(trailer.indexOffset, RestartVersion::indexMagic, header) ||
+      trailer.indexOffset + sizeof(header) + header.length != trailer_offset ||
+      header.length != (size_t)header.evalId *
+      sizeof(RestartVersion::IndexEntry))
+    return false;
+
+  const char* entries = restartData + trailer.indexOffset + sizeof(header);
+  if (RestartVersion::checksum(entries, header.length) != header.checksum)
+    return false;
+
+  recordIndex.resize(header.evalId);
+  std::memcpy(recordIndex.data(), entries, header.length);
+  // record checksums are verified as records are decoded
+  for (size_t i=0; i<recordIndex.size(); ++i)
+    if (!valid_header(recordIndex[i].offset, RestartVersion::recordMagic,
+		      header) ||
+	recordIndex[i].offset + sizeof(header) + header.length >
+	trailer.indexOffset) {
+      recordIndex.clear();
+      return false;
+    }
+  return true;
+}
+
+
+void RestartReader::scan_records(size_t data_start)
+{
+  recordIndex.clear();
+  RestartVersion::RecordHeader header;
+  size_t offset = data_start;
+  while (offset < restartDataSize) {
+    if (!valid_header(offset, RestartVersion::recordMagic, header)) {
+      // an index record without a valid trailer also ends the records
+      if (!valid_header(offset, RestartVersion::indexMagic, header)) {
+	truncatedFlag = true;
+	Cerr << "\nWarning: corrupt or incomplete record in restart file '"
+	     << restartInputFilename << "' at byte " << offset
+	     << ";\n  truncating to the " << recordIndex.size()
+	     << " evaluations preceding it." << std::endl;
+      }
+      break;
+    }
+    const char* payload = restartData + offset + sizeof(header);
+    if (RestartVersion::checksum(payload, header.length) != header.checksum) {
+      truncatedFlag = true;
+      Cerr << "\nWarning: checksum mismatch for evaluation " << header.evalId
+	   << " in restart file '" << restartInputFilename << "';\n  truncating"
+	   << " to the " << recordIndex.size() << " evaluations preceding it."
+	   << std::endl;
+      break;
+    }
+    RestartVersion::IndexEntry entry;
+    entry.evalId = header.evalId; entry.reserved = 0; entry.offset = offset;
+    recordIndex.push_back(entry);
+    offset += sizeof(header) + header.length;
+  }
+}
+
+
+bool RestartReader::
+valid_header(size_t offset, unsigned int magic,
+	     RestartVersion::RecordHeader& header) const
+{
+  if (offset > restartDataSize || restartDataSize - offset < sizeof(header))
+    return false;
+  std::memcpy(&header, restartData + offset, sizeof(header));
+  return header.magic == magic &&
+    header.length <= restartDataSize - offset - sizeof(header);
+}
+
+
+bool RestartReader::
+decode_record(size_t i, ParamResponsePair& prp_out) const
+{
+  RestartVersion::RecordHeader header;
+  std::memcpy(&header, restartData + recordIndex[i].offset, sizeof(header));
+  const char* payload = restartData + recordIndex[i].offset + sizeof(header);
+  if (RestartVersion::checksum(payload, header.length) != header.checksum)
+    return false;
+
+  // read the payload in place
+  struct PayloadBuffer: public std::streambuf {
+    PayloadBuffer(const char* data, size_t length) {
+      char* begin = const_cast<char*>(data);
+      setg(begin, begin, begin + length);
+    }
+  } payload_buf(payload, header.length);
+  std::istream payload_stream(&payload_buf);
+  try {
+    boost::archive::binary_iarchive
+      record_archive(payload_stream, boost::archive::no_header);
+    record_archive & prp_out;
+  }
+  catch (const std::exception& e) {
+    return false;
+  }
+  return true;
+}
+
+
+void RestartReader::truncate(size_t i, const String& reason)
+{
+  truncatedFlag = true;
+  Cerr << "\nWarning: " << reason << " reading restart file '"
+       << restartInputFilename << "';\n  truncating to the " << i
+       << " evaluations preceding it." << std::endl;
+  recordIndex.resize(i);
+}
+
+
+const RestartVersion& RestartReader::version() const
+{ return restartVersion; }
+
+
+bool RestartReader::truncated() const
+{ return truncatedFlag; }
+
+
+bool RestartReader::read_prp(ParamResponsePair& prp_out)
+{
+  if (restartInputArchive) {
+    if (truncatedFlag || !restartInputStream->good())
+      return false;
+    restartInputStream->peek(); // peek to force EOF if last record was read
+    if (restartInputStream->eof())
+      return false;
+    try {
+      // this reads vars (svd, vars), iface, resp, eval_id
+      restartInputArchive->operator&(prp_out);
+    }
+    catch (const std::exception& e) {
+      truncatedFlag = true;
+      Cerr << "\nWarning: error reading restart file '" << restartInputFilename
+	   << "' following " << nextRecord << " evaluations;\n  truncating to "
+	   << "these evaluations.\nDetails: " << e.what() << std::endl;
+      return false;
+    }
+    ++nextRecord;
+    return true;
+  }
+
+  if (nextRecord >= recordIndex.size())
+    return false;
+  if (!decode_record(nextRecord, prp_out)) {
+    truncate(nextRecord, "invalid record");
+    return false;
+  }
+  ++nextRecord;
+  return true;
+}
+
+
+/** Records of framed files are independent, so contiguous blocks of
+    them are decoded by concurrent threads. */
+size_t RestartReader::read_prps(PRPArray& prps_out, size_t max_prps)
+{
+  size_t num_read = 0;
+  if (restartInputArchive) {
+    ParamResponsePair prp;
+    while ( (!max_prps || num_read < max_prps) && read_prp(prp) ) {
+      prps_out.push_back(prp);
+      prp = ParamResponsePair(); // don't share reps with the stored pair
+      ++num_read;
+    }
+    return num_read;
+  }
+
+  size_t num_avail = recordIndex.size() - nextRecord;
+  size_t num_prps = (max_prps && max_prps < num_avail) ? max_prps : num_avail;
+  size_t start = prps_out.size();
+  prps_out.resize(start + num_prps);
+
+  // amortize thread startup over a reasonable number of records
+  size_t num_threads = dakota::util::num_threads(0, num_prps / 64);
+  std::vector<char> decoded(num_prps, false);
+  auto decode_block = [&](size_t t) {
+    for (size_t i = t*num_prps/num_threads; i<(t+1)*num_prps/num_threads; ++i)
+      decoded[i] = decode_record(nextRecord + i, prps_out[start + i]);
+  };
+  std::vector<std::thread> threads;
+  for (size_t t=1; t<num_threads; ++t)
+    threads.push_back(std::thread(decode_block, t));
+  decode_block(0);
+  for (std::thread& thr : threads)
+    thr.join();
+
+  while (num_read < num_prps && decoded[num_read])
+    ++num_read;
+  if (num_read < num_prps) {
+    truncate(nextRecord + num_read, "invalid record");
+    prps_out.resize(start + num_read);
+  }
+  nextRecord += num_read;
+  return num_read;
+}
 
 
 #ifdef Want_Heartbeat /*{*/
@@ -17,7 +17,9 @@
 #include "dakota_tabular_io.hpp"
 #include "DakotaGraphics.hpp"
 #include "RestartVersion.hpp"
+#include <chrono>
 #include <memory>
+#include <sstream>
 
 
 namespace Dakota {
@@ -114,7 +116,12 @@ private:
 
 
 /** Component for writing restart files.  Creation and destruction of
-    archive and associated stream are managed here. */
+    archive and associated stream are managed here.  When writing the
+    current restart version, each evaluation is appended as an
+    independently decodable, checksummed record and an index of the
+    records is written when the writer is destroyed (see
+    RestartVersion).  Without version info, evaluations are appended
+    to a single archive stream as in pre-6.17.0 files. */
 class RestartWriter {
 
 public:
@@ -132,6 +139,9 @@ public:
   /// alternate ctor taking a stream, helpful for testing; assumes
   /// client manages the output stream
   RestartWriter(std::ostream& write_restart_stream);
+
+  /// destructor; completes the file with the record index
+  ~RestartWriter();
   
   /// output filename for this writer
   const String& filename();
@@ -141,32 +151,161 @@ public:
   void operator&(const T& data_out)
   { restartOutputArchive->operator&(data_out); }
 
-  /// add the passed pair to the restart file
+  /// add the passed pair to the restart file, flushing it when the
+  /// flush interval has elapsed
   void append_prp(const ParamResponsePair& prp_in);
 
   /// flush the restart stream so we have a complete restart record
   /// should Dakota abort
   void flush();
 
+  /// set the minimum time in seconds between flushes of appended
+  /// records (group commit); 0 flushes every record and a negative
+  /// interval defers flushing to flush() or destruction
+  void flush_interval(int interval);
+
 private:
   /// copy constructor is disallowed due to file stream
   RestartWriter(const RestartWriter&);
   /// assignment is disallowed due to file stream
   const RestartWriter& operator=(const RestartWriter&);
 
+  /// write rst_version to the archive and set up record framing
+  void write_version(const RestartVersion& rst_version);
+
+  /// write the index record and trailer following the last record
+  void write_index();
+
   /// the name of the restart output file
   String restartOutputFilename;
 
   /// Binary stream to which restart data is written
   std::ofstream restartOutputFS;
 
+  /// the stream to which records are written (restartOutputFS or a
+  /// client-managed stream)
+  std::ostream* restartOutputStream;
+
   /// Binary output archive to which data is written (pointer since no
   /// default ctor for oarchive and may not be initialized); 
   std::unique_ptr<boost::archive::binary_oarchive> restartOutputArchive;
 
+  /// whether evaluations are written as framed records
+  bool framedRecords;
+  /// buffer reused for serializing record payloads
+  std::ostringstream recordBuffer;
+  /// offset in the stream at which the next record will be written
+  unsigned long long recordOffset;
+  /// eval ids and offsets of the records written so far
+  std::vector<RestartVersion::IndexEntry> recordIndex;
+
+  /// minimum time in seconds between flushes of appended records
+  int flushInterval;
+  /// time of the last flush
+  std::chrono::steady_clock::time_point lastFlush;
+
 };  // class RestartWriter
 
 
+/** Component for reading restart files of any version.  Framed
+    (version 2) files are memory mapped when possible and their
+    records located through the trailing index, or, when it is missing
+    (e.g., after an abort), by scanning the record headers.  Records
+    are verified against their checksums and the file is truncated
+    (with a warning) at the first corrupt or incomplete record.
+    Earlier versions are read sequentially from a single archive
+    stream; a read error ends the file in the same way. */
+class RestartReader {
+
+public:
+  /// typical ctor taking a filename; checks and reports the version info
+  RestartReader(const String& read_restart_filename);
+
+  /// alternate ctor taking a stream positioned at the start of the
+  /// restart data, helpful for testing; assumes client manages the stream
+  RestartReader(std::istream& read_restart_stream);
+
+  /// destructor
+  ~RestartReader();
+
+  /// the version info read from the restart file
+  const RestartVersion& version() const;
+
+  /// read the next evaluation; return false when no further (valid)
+  /// records remain
+  bool read_prp(ParamResponsePair& prp_out);
+
+  /// read all remaining evaluations, up to max_prps of them if
+  /// nonzero; records of framed files are decoded concurrently
+  size_t read_prps(PRPArray& prps_out, size_t max_prps = 0);
+
+  /// whether reading stopped at a corrupt or incomplete record
+  bool truncated() const;
+
+private:
+  /// copy constructor is disallowed due to file stream
+  RestartReader(const RestartReader&);
+  /// assignment is disallowed due to file stream
+  const RestartReader& operator=(const RestartReader&);
+
+  /// after reading the version info, locate the records of a framed
+  /// file or set up the archive stream of an older file
+  void initialize(std::istream& input_stream, std::streamoff data_start);
+
+  /// map (or read) the restart file into restartData
+  void load_data(std::istream& input_stream);
+
+  /// locate the records through the trailing index; return false if
+  /// the index is missing or invalid
+  bool read_index();
+  /// locate the records by scanning their headers from data_start,
+  /// stopping at the first invalid record
+  void scan_records(size_t data_start);
+
+  /// whether a valid record header of the given kind starts at offset
+  bool valid_header(size_t offset, unsigned int magic,
+		    RestartVersion::RecordHeader& header) const;
+
+  /// decode record i into prp_out; return false on checksum or
+  /// serialization errors
+  bool decode_record(size_t i, ParamResponsePair& prp_out) const;
+
+  /// discard record i and those following it, with a warning
+  void truncate(size_t i, const String& reason);
+
+  /// the name of the restart input file (empty if reading a stream)
+  String restartInputFilename;
+
+  /// version info read from the file
+  RestartVersion restartVersion;
+
+  /// Binary stream from which an older restart file is read
+  std::ifstream restartInputFS;
+  /// input archive for older restart files
+  std::unique_ptr<boost::archive::binary_iarchive> restartInputArchive;
+  /// the stream from which an older file is read (restartInputFS or a
+  /// client-managed stream)
+  std::istream* restartInputStream;
+
+  /// contents of a framed file: mapped or copied into dataBuffer
+  const char* restartData;
+  /// size of restartData in bytes
+  size_t restartDataSize;
+  /// size of the mapping of restartData (0 if not mapped)
+  size_t mappedSize;
+  /// copy of the file contents when it cannot be mapped
+  std::vector<char> dataBuffer;
+
+  /// offsets and eval ids of the (remaining) valid records
+  std::vector<RestartVersion::IndexEntry> recordIndex;
+  /// index of the next record to read
+  size_t nextRecord;
+  /// whether reading stopped at a corrupt or incomplete record
+  bool truncatedFlag;
+
+};  // class RestartReader
+
+
 
 // TODO: tagging for pre/run/post I/O files
 // TODO: consider a map of redirections with arbitrary rebinding
@@ -364,6 +503,10 @@ public:
   unsigned short modelEvalsSelection;
   /// Interfaces selected to store their evaluations
   unsigned short interfEvalsSelection;
+  /// Number of evaluations to stage before writing them to HDF5
+  int evalBufferSize;
+  /// Maximum age in seconds of staged evaluations
+  int evalBufferFlushInterval;
 
 private:
 
@@ -375,7 +518,8 @@ private:
   void read_write_restart(bool restart_requested, bool read_restart_flag,
 			  const String& read_restart_filename,
 			  size_t stop_restart_eval,
-			  const String& write_restart_filename);
+			  const String& write_restart_filename,
+			  int restart_flush_interval);
 
   // -----
   // Data
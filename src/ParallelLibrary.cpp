@@ -12,6 +12,8 @@
 #include "ProgramOptions.hpp"
 #include "dakota_results_types.hpp"
 #include "ResultsManager.hpp"
+#include "TraceProfiler.hpp"
+#include "util_threads.hpp"
 
 #ifdef DAKOTA_UTILIB
 #include <utilib/exception_mngr.h>
@@ -85,6 +87,15 @@ void ParallelLibrary::init_mpi_comm()
     pl.procsPerServer   = pl.serverCommSize;
     // initialize MPI timer
     startMPITime        = MPI_Wtime();
+#if MPI_VERSION >= 3
+    // share the hardware threads of each node among its Dakota processes
+    MPI_Comm node_comm; int procs_per_node;
+    MPI_Comm_split_type(pl.serverIntraComm, MPI_COMM_TYPE_SHARED,
+			pl.serverCommRank, MPI_INFO_NULL, &node_comm);
+    MPI_Comm_size(node_comm, &procs_per_node);
+    MPI_Comm_free(&node_comm);
+    dakota::util::set_processes_per_node(procs_per_node);
+#endif
   }
   else // most default ParallelLevel values apply
     pl.serverId         = pl.numServers       = pl.procsPerServer = 1;
@@ -1142,6 +1153,7 @@ void ParallelLibrary::pop_output_tag(const ParallelLevel& pl)
 void ParallelLibrary::write_restart(const ParamResponsePair& prp)
 {
   // delegate restart write to outputManager
+  TraceScope trace_scope("restart_write", "interface", prp.eval_id());
   outputManager.append_restart(prp);
 }
 
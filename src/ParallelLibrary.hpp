@@ -729,6 +729,11 @@ public:
 	     MPI_Request& recv_req, const ParallelLevel& parent_pl,
 	     const ParallelLevel& child_pl);
 
+  /// blocking probe for a buffer message at the current communication
+  /// level; returns the length of the pending message in bytes
+  int  probe(int source, int tag, MPI_Status& status,
+	     const ParallelLevel& parent_pl, const ParallelLevel& child_pl);
+
   /// process _NPOS default and perform error checks
   void check_mi_index(size_t& index) const;
 
@@ -777,6 +782,9 @@ public:
   /// nonblocking receive at the iterator-evaluation communication level
   void irecv_ie(MPIUnpackBuffer& recv_buff, int source, int tag, 
 		MPI_Request& recv_req);
+  /// blocking probe at the iterator-evaluation communication level;
+  /// returns the length of the pending message in bytes
+  int  probe_ie(int source, int tag, MPI_Status& status);
 
   /// blocking send at the evaluation-analysis communication level
   void  send_ea(int& send_int, int dest, int tag);
@@ -1653,6 +1661,37 @@ recv_ie(MPIUnpackBuffer& recv_buff, int source, int tag, MPI_Status& status)
 }
 
 
+/** Allows a receive buffer to be sized for a message whose length is
+    not known in advance.  The communicator selection matches recv(). */
+inline int ParallelLibrary::
+probe(int source, int tag, MPI_Status& status,
+      const ParallelLevel& parent_pl, const ParallelLevel& child_pl)
+{
+  int count = 0;
+#ifdef DAKOTA_HAVE_MPI
+  int err_code = 0;
+  if (child_pl.commSplitFlag)
+    err_code = (parent_pl.serverCommRank) ?
+      MPI_Probe(0, tag, child_pl.hubServerInterComm, &status) : // slaves
+      MPI_Probe(0, tag, child_pl.hubServerInterComms[source-1], &status);
+  else
+    err_code = MPI_Probe(source, tag, parent_pl.serverIntraComm, &status);
+  check_error("MPI_Probe", err_code);
+  err_code = MPI_Get_count(&status, MPI_PACKED, &count);
+  check_error("MPI_Get_count", err_code);
+#endif // DAKOTA_HAVE_MPI
+  return count;
+}
+
+
+inline int ParallelLibrary::
+probe_ie(int source, int tag, MPI_Status& status)
+{
+  return probe(source, tag, status, *currPCIter->miPLIters.back(),
+	       *currPCIter->iePLIter);
+}
+
+
 inline void ParallelLibrary::
 recv_ea(int& recv_int, int source, int tag, MPI_Status& status)
 {
@@ -77,21 +77,53 @@ void PluginInterface::derived_map(const Variables& vars, const ActiveSet& set,
 
 void PluginInterface::derived_map_asynch(const ParamResponsePair& pair)
 {
-  // This interface only supports bulk synchronous batch evals for now
-  // TODO: Catch this at construct time
-  if (!batchEval) {
+  // batches are evaluated as a unit within wait_local_evaluations()
+  if (batchEval)
+    return;
+
+  load_plugin();
+  if (!pluginInterface->thread_safe()) {
     Cerr << "\nError: Plugin interfaces support single or batch evaluations, "
-	 << "but not\nasynchronous.\n";
+	 << "but asynchronous\nevaluations only for plugins declaring "
+	 << "themselves thread-safe.\n";
     abort_handler(INTERFACE_ERROR);
   }
+
+  if (threadRequests.empty()) {
+    evalThreadPool.initialize(std::max(0, asynchLocalEvalConcurrency));
+    threadRequests.resize(evalThreadPool.num_threads());
+  }
+  launch_threaded_evaluation(pair,
+    [this](const Variables& vars, const ActiveSet& set, Response& response,
+	   int fn_eval_id, size_t thread_index) {
+      DakotaPlugins::EvalRequest& plugin_request = threadRequests[thread_index];
+      form_eval_request(vars, set, fn_eval_id, plugin_request);
+      populate_response(pluginInterface->evaluate(plugin_request), response);
+    });
 }
 
 
 void PluginInterface::wait_local_evaluations(PRPQueue& prp_queue)
 {
+  if (!batchEval) { // asynchronous evaluations on worker threads
+    collect_threaded_evaluations(prp_queue, true);
+    return;
+  }
+
   // loading at first map to head off conflicting Python issues
   load_plugin();
 
+  // evaluations sharing variable and function counts are passed to the
+  // plugin in contiguous storage
+  if (batchEvaluation.pack(prp_queue)) {
+    evaluate_packed_batch(*pluginInterface, batchEvaluation,
+			  prp_queue.begin()->variables());
+    batchEvaluation.unpack(prp_queue);
+    for (const auto& prp : prp_queue)
+      completionSet.insert(prp.eval_id());
+    return;
+  }
+
   // prepare requests
   std::vector<DakotaPlugins::EvalRequest> plugin_requests;
   plugin_requests.reserve(prp_queue.size());
@@ -115,6 +147,56 @@ void PluginInterface::wait_local_evaluations(PRPQueue& prp_queue)
 }
 
 
+void PluginInterface::test_local_evaluations(PRPQueue& prp_queue)
+{
+  if (batchEval) wait_local_evaluations(prp_queue);
+  else           collect_threaded_evaluations(prp_queue, false);
+}
+
+
+/** The request and response reference the storage of batch_eval,
+    which is used in place by the plugin. */
+void PluginInterface::
+evaluate_packed_batch(DakotaPlugins::DakotaInterfaceAPI& plugin,
+		      BatchEvaluation& batch_eval, const Variables& vars)
+{
+  DakotaPlugins::BatchEvalRequest req;
+  const RealMatrix& c_vars  = batch_eval.continuous_variables();
+  const IntMatrix&  di_vars = batch_eval.discrete_int_variables();
+  const RealMatrix& dr_vars = batch_eval.discrete_real_variables();
+  const StringArray& ds_vars = batch_eval.discrete_string_variables();
+  req.numEvals = batch_eval.num_evaluations();
+  req.numContinuousVars  = c_vars.numRows();
+  req.numDiscreteIntVars = di_vars.numRows();
+  req.numDiscreteStringVars = (req.numEvals) ? ds_vars.size()/req.numEvals : 0;
+  req.numDiscreteRealVars = dr_vars.numRows();
+  req.numFunctions = batch_eval.num_functions();
+  req.continuousVars  = c_vars.values();
+  req.discreteIntVars = di_vars.values();
+  req.discreteStringVars = ds_vars.data();
+  req.discreteRealVars = dr_vars.values();
+  req.activeSet = batch_eval.active_set_requests().data();
+  req.derivativeVars = batch_eval.derivative_variables();
+  req.functionEvalIds = batch_eval.evaluation_ids().data();
+
+  // labels are shared by all evaluations in the batch
+  copy_data(vars.all_continuous_variable_labels(), req.continuousLabels);
+  copy_data(vars.all_discrete_int_variable_labels(), req.discreteIntLabels);
+  copy_data(vars.all_discrete_string_variable_labels(), req.discreteStringLabels);
+  copy_data(vars.all_discrete_real_variable_labels(), req.discreteRealLabels);
+  req.inputOrderedLabels = vars.ordered_labels();
+
+  DakotaPlugins::BatchEvalResponse resp;
+  RealMatrix& fn_grads = batch_eval.function_gradients();
+  RealMatrix& fn_hess  = batch_eval.function_hessians();
+  resp.functions = batch_eval.function_values().values();
+  resp.gradients = (fn_grads.numCols()) ? fn_grads.values() : nullptr;
+  resp.hessians  = (fn_hess.numCols())  ? fn_hess.values()  : nullptr;
+
+  plugin.evaluate_batch(req, resp);
+}
+
+
 /** Load plugin if not already active */
 void PluginInterface::load_plugin()
 {
@@ -150,6 +232,15 @@ DakotaPlugins::EvalRequest PluginInterface::form_eval_request
 (const Variables& vars, const ActiveSet& set, int fn_eval_id) const
 {
   DakotaPlugins::EvalRequest req;
+  form_eval_request(vars, set, fn_eval_id, req);
+  return req;
+}
+
+
+void PluginInterface::
+form_eval_request(const Variables& vars, const ActiveSet& set, int fn_eval_id,
+		  DakotaPlugins::EvalRequest& req) const
+{
   // TODO: do we want to use the legacy copy_data or another means?
   copy_data(vars.all_continuous_variables(), req.continuousVars);
   copy_data(vars.all_discrete_int_variables(), req.discreteIntVars);
@@ -166,8 +257,6 @@ DakotaPlugins::EvalRequest PluginInterface::form_eval_request
   req.inputOrderedLabels = vars.ordered_labels();
 
   req.functionEvalId = fn_eval_id;
-
-  return req;
 }
 
 
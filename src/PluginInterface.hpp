@@ -11,6 +11,7 @@
 #define DAKOTA_PLUGIN_INTERFACE_H
 
 #include "ApplicationInterface.hpp"
+#include "BatchEvaluation.hpp"
 #include "plugins/DakotaInterfaceAPI.hpp"
 
 #include <boost/shared_ptr.hpp> // blech
@@ -30,11 +31,22 @@ public:
   void derived_map(const Variables& vars, const ActiveSet& set,
 		   Response& response, int fn_eval_id);
 
+  /// For batch evaluations, a no-op (see wait_local_evaluations()); for
+  /// thread-safe plugins, launches the evaluation on a worker thread
   void derived_map_asynch(const ParamResponsePair& pair);
 
   /// For plugins, implements blocking bulk-synchronous evaluation of
-  /// batch (PRPQueue)
+  /// batch (PRPQueue), or collects completed asynchronous evaluations
   void wait_local_evaluations(PRPQueue& prp_queue);
+  /// nonblocking version of wait_local_evaluations() for asynchronous
+  /// evaluations (batches are evaluated as in wait_local_evaluations())
+  void test_local_evaluations(PRPQueue& prp_queue);
+
+  /// evaluate the batch packed into batch_eval (sharing the labels of
+  /// vars) using the plugin's contiguous batch evaluator
+  static void evaluate_packed_batch(DakotaPlugins::DakotaInterfaceAPI& plugin,
+				    BatchEvaluation& batch_eval,
+				    const Variables& vars);
 
 
 protected:
@@ -45,6 +57,10 @@ protected:
   /// map variables and set to the plugin request
   DakotaPlugins::EvalRequest form_eval_request
   (const Variables& vars, const ActiveSet& set, int fn_eval_id) const;
+  /// map variables and set to an existing plugin request, reusing its
+  /// storage
+  void form_eval_request(const Variables& vars, const ActiveSet& set,
+			 int fn_eval_id, DakotaPlugins::EvalRequest& req) const;
 
   /// map plugin response to Dakota response
   void populate_response
@@ -61,6 +77,12 @@ protected:
   /// potentially be executed concurrently via MPI)
   StringArray analysisDrivers;
 
+  /// per-thread request scratch data for asynchronous evaluations
+  std::vector<DakotaPlugins::EvalRequest> threadRequests;
+
+  /// contiguous storage for batch evaluations
+  BatchEvaluation batchEvaluation;
+
 private:
 
   /// validate that the plugin exists on the filesystem
@@ -2204,6 +2204,7 @@ const Real& ProblemDescDB::get_real(const String& entry_name) const
       {"nond.c3function_train.stats_rounding_tolerance", P_MET statsRoundingTol},
       {"nond.collocation_ratio", P_MET collocationRatio},
       {"nond.collocation_ratio_terms_order", P_MET collocRatioTermsOrder},
+      {"nond.kde_tolerance", P_MET pushforwardKDETol},
       {"nond.multilevel_estimator_rate", P_MET multilevEstimatorRate},
       {"nond.regression_penalty", P_MET regressionL2Penalty},
       {"npsol.linesearch_tolerance", P_MET lineSearchTolerance},
@@ -2258,7 +2259,10 @@ int ProblemDescDB::get_int(const String& entry_name) const
   return get<int>
   ( "get_int()",
     { /* environment */
+      {"eval_buffer_flush_interval", P_ENV evalBufferFlushInterval},
+      {"eval_buffer_size", P_ENV evalBufferSize},
       {"output_precision", P_ENV outputPrecision},
+      {"restart_flush_interval", P_ENV restartFlushInterval},
       {"stop_restart", P_ENV stopRestart}
     },
     { /* method */
@@ -2299,6 +2303,7 @@ int ProblemDescDB::get_int(const String& entry_name) const
       {"sub_sampling_period", P_MET subSamplingPeriod},
       {"symbols", P_MET numSymbols},
       {"vbd_via_sampling_num_bins", P_MET vbdViaSamplingNumBins},
+      {"vbd_bootstrap_samples", P_MET vbdBootstrapSamples},
       {"m_max", P_MET log2MaxPoints},
       {"t_max", P_MET numberOfBits},
       {"t_scramble", P_MET scrambleSize}
@@ -2327,7 +2332,9 @@ int ProblemDescDB::get_int(const String& entry_name) const
       {"direct.processors_per_analysis", P_INT procsPerAnalysis},
       {"evaluation_servers", P_INT evalServers},
       {"failure_capture.retry_limit", P_INT retryLimit},
-      {"processors_per_evaluation", P_INT procsPerEval}
+      {"message_batching.max_batch_size", P_INT messageBatchSize},
+      {"processors_per_evaluation", P_INT procsPerEval},
+      {"quantized_cache_max_entries", P_INT quantizedCacheSize}
     },
     { /* responses */ },
     entry_name, dbRep);
@@ -2653,6 +2660,7 @@ bool ProblemDescDB::get_bool(const String& entry_name) const
       {"coliny.randomize", P_MET randomizeOrderFlag},
       {"coliny.show_misc_options", P_MET showMiscOptions},
       {"derivative_usage", P_MET methodUseDerivsFlag},
+      {"dream.batch_generations", P_MET dreamBatchGenerations},
       {"export_surrogate", P_MET exportSurrogate},
       {"fixed_seed", P_MET fixedSeedFlag},
       {"fsu_quasi_mc.fixed_sequence", P_MET fixedSequenceFlag},
@@ -2760,8 +2768,10 @@ bool ProblemDescDB::get_bool(const String& entry_name) const
       {"dirSave", P_INT dirSave},
       {"dirTag", P_INT dirTag},
       {"evaluation_cache", P_INT evalCacheFlag},
+      {"message_batching", P_INT messageBatchFlag},
       {"nearby_evaluation_cache", P_INT nearbyEvalCacheFlag},
       {"python.numpy", P_INT numpyFlag},
+      {"quantized_cache", P_INT quantizedCacheFlag},
       {"restart_file", P_INT restartFileFlag},
       {"templateReplace", P_INT templateReplace},
       {"useWorkdir", P_INT useWorkdir}
@@ -219,7 +219,10 @@ derived_map(const Variables& vars, const ActiveSet& set, Response& response,
     write_parameters_files(vars, set, response, fn_eval_id);
 
   // execute the simulator application -- blocking call
-  create_evaluation_process(BLOCK);
+  {
+    TraceScope trace_scope("simulation_run", "interface", fn_eval_id);
+    create_evaluation_process(BLOCK);
+  }
 
   try { 
     if (evalCommRank == 0)
@@ -266,7 +269,11 @@ void ProcessApplicInterface::derived_map_asynch(const ParamResponsePair& pair)
     write_parameters_files(pair.variables(), pair.active_set(),
 			 pair.response(),  fn_eval_id);
     // execute the simulator application -- nonblocking call
-    pid_t pid = create_evaluation_process(FALL_THROUGH);
+    pid_t pid;
+    {
+      TraceScope trace_scope("process_spawn", "interface", fn_eval_id);
+      pid = create_evaluation_process(FALL_THROUGH);
+    }
     // bind process id with eval id for use in synchronization
     map_bookkeeping(pid, fn_eval_id);
   }
@@ -540,6 +547,7 @@ void ProcessApplicInterface::
 write_parameters_files(const Variables& vars,    const ActiveSet& set,
 		       const Response& response, const int id)
 {
+  TraceScope trace_scope("write_parameters", "interface", id);
   PathTriple file_names(paramsFileWritten, resultsFileWritten, createdDir);
 
   // If a new evaluation, insert the modified file names into map for use in
@@ -710,6 +718,8 @@ write_parameters_file(const Variables& vars, const ActiveSet& set,
 void ProcessApplicInterface::
 read_results_files(Response& response, const int id, const String& eval_id_tag)
 {
+  TraceScope trace_scope("read_results", "interface", id);
+
   // Retrieve parameters & results file names using fn. eval. id.  A map of
   // filenames is used because the names of tmp files must be available here
   // and asynch_recv operations can perform output filtering out of order
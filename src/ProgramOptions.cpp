@@ -27,6 +27,7 @@ namespace Dakota {
 ProgramOptions::ProgramOptions():
   worldRank(0),
   echoInput(true), preprocInput(false), stopRestartEvals(0),
+  restartFlushInterval(0),
   helpFlag(false), versionFlag(false), checkFlag(false), 
   preRunFlag(false), runFlag(false), postRunFlag(false), userModesFlag(false),
   preRunOutputFormat(TABULAR_ANNOTATED), postRunInputFormat(TABULAR_ANNOTATED)
@@ -39,6 +40,7 @@ ProgramOptions::ProgramOptions():
 ProgramOptions::ProgramOptions(int world_rank):
   worldRank(world_rank),
   echoInput(true), preprocInput(false), stopRestartEvals(0),
+  restartFlushInterval(0),
   helpFlag(false), versionFlag(false), checkFlag(false), 
   preRunFlag(false), runFlag(false), postRunFlag(false), userModesFlag(false),
   preRunOutputFormat(TABULAR_ANNOTATED), postRunInputFormat(TABULAR_ANNOTATED)
@@ -51,6 +53,7 @@ ProgramOptions::ProgramOptions(int world_rank):
 ProgramOptions::ProgramOptions(int argc, char* argv[], int world_rank):
   worldRank(world_rank),
   echoInput(true), preprocInput(false), stopRestartEvals(0),
+  restartFlushInterval(0),
   helpFlag(false), versionFlag(false), checkFlag(false), 
   preRunFlag(false), runFlag(false), postRunFlag(false), userModesFlag(false),
   preRunOutputFormat(TABULAR_ANNOTATED), postRunInputFormat(TABULAR_ANNOTATED)
@@ -105,6 +108,13 @@ ProgramOptions::ProgramOptions(int argc, char* argv[], int world_rank):
   if (clh.retrieve("no_input_echo"))
     echoInput = false;
 
+  // only trace if the user passed the option
+  if (clh.retrieve("trace")) {
+    traceFile = clh.retrieve("trace");
+    if (traceFile.empty())
+      traceFile = "dakota_trace.json";
+  }
+
   validate();
 }
 
@@ -148,6 +158,12 @@ size_t ProgramOptions::stop_restart_evals() const
 String ProgramOptions::write_restart_file() const
 { return writeRestartFile.empty() ? "dakota.rst" : writeRestartFile; }
 
+int ProgramOptions::restart_flush_interval() const
+{ return restartFlushInterval; }
+
+const String& ProgramOptions::trace_file() const
+{ return traceFile; }
+
 
 bool ProgramOptions::help() const
 { return helpFlag; }
@@ -280,6 +296,12 @@ void ProgramOptions::stop_restart_evals(size_t stop_rst)
 void ProgramOptions::write_restart_file(const String& write_rst)
 { writeRestartFile = write_rst; }
 
+void ProgramOptions::restart_flush_interval(int flush_interval)
+{ restartFlushInterval = flush_interval; }
+
+void ProgramOptions::trace_file(const String& trace_file)
+{ traceFile = trace_file; }
+
 
 void ProgramOptions::help(bool help_flag)
 { helpFlag = help_flag; }
@@ -343,6 +365,8 @@ void ProgramOptions::parse(const ProblemDescDB& problem_db)
   }
 
   set_option(problem_db, "write_restart", writeRestartFile);
+  restartFlushInterval
+    = problem_db.get_int("environment.restart_flush_interval");
 
   // only override if non-default, no need to warn
   const bool& check_flag = problem_db.get_bool("environment.check");
@@ -395,7 +419,8 @@ void ProgramOptions::read(MPIUnpackBuffer& s)
   // core files and options
   s >> inputFile >> inputString >> echoInput >> parserOptions 
     >> outputFile >> errorFile 
-    >> readRestartFile >> stopRestartEvals >> writeRestartFile;
+    >> readRestartFile >> stopRestartEvals >> writeRestartFile
+    >> restartFlushInterval >> traceFile;
   // run mode controls
   s >> helpFlag >> versionFlag >> checkFlag >> preRunFlag >> runFlag 
     >> postRunFlag >> userModesFlag;
@@ -412,7 +437,8 @@ void ProgramOptions::write(MPIPackBuffer& s) const
   // core files and options
   s << inputFile << inputString << echoInput << parserOptions 
     << outputFile << errorFile 
-    << readRestartFile << stopRestartEvals << writeRestartFile;
+    << readRestartFile << stopRestartEvals << writeRestartFile
+    << restartFlushInterval << traceFile;
   // run mode controls
   s << helpFlag << versionFlag << checkFlag << preRunFlag << runFlag 
     << postRunFlag << userModesFlag;
@@ -79,6 +79,10 @@ public:
   size_t stop_restart_evals() const;
   /// write retart (user-provided or default) file base name (no tag)
   String write_restart_file() const;
+  /// minimum time in seconds between flushes of the restart file
+  int restart_flush_interval() const;
+  /// Chrome trace file for the phase profiler (empty = not tracing)
+  const String& trace_file() const;
 
   /// is help mode active?
   bool help() const;
@@ -156,6 +160,10 @@ public:
   void stop_restart_evals(size_t stop_rst);
   /// set base file name for restart file to write
   void write_restart_file(const String& write_rst);
+  /// set minimum time in seconds between flushes of the restart file
+  void restart_flush_interval(int flush_interval);
+  /// set Chrome trace file for the phase profiler (empty = not tracing)
+  void trace_file(const String& trace_file);
 
   /// set true to print help information and exit
   void help(bool help_flag);
@@ -241,6 +249,9 @@ private:
   String readRestartFile;    ///< e.g., "dakota.old.rst"
   size_t stopRestartEvals;   ///< eval number at which to stop restart read
   String writeRestartFile;   ///< e.g., "dakota.new.rst"
+  int restartFlushInterval;  ///< seconds between restart flushes (0 = each)
+
+  String traceFile;          ///< e.g., "dakota_trace.json"
 
   // Run mode flags; intially only valid on rank 0.
   // Could condense flags into a bit-wise short, but using bool for
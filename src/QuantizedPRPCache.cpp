@@ -0,0 +1,351 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "QuantizedPRPCache.hpp"
+#include "PRPMultiIndex.hpp"
+#include <boost/functional/hash.hpp>
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <cstring>
+
+namespace Dakota {
+
+/// marks a table slot that was never used
+static const int EMPTY_SLOT = -1;
+/// marks a table slot whose entry was removed
+static const int DELETED_SLOT = -2;
+/// initial (and minimum) number of table slots
+static const size_t MIN_SLOTS = 16;
+/// width of the quantization cells relative to the tolerance; larger
+/// cells make values near a cell boundary (and extra probes) rarer
+static const Real CELL_WIDTH_FACTOR = 16.;
+/// allowance for roundoff in the logarithm of values near zero
+static const Real LOG_ROUNDOFF = 64. * DBL_EPSILON;
+/// maximum number of ambiguous coordinates whose neighboring cells
+/// are probed (2^MAX_NEIGHBOR_BITS probes per lookup)
+static const size_t MAX_NEIGHBOR_BITS = 8;
+
+
+/// binary value of x for hashing, mapping -0. to 0. consistent with ==
+static long long real_bits(Real x)
+{
+  if (x == 0.) x = 0.;
+  long long bits;
+  std::memcpy(&bits, &x, sizeof(bits));
+  return bits;
+}
+
+
+QuantizedPRPCache::QuantizedPRPCache():
+  numEntries(0), numDeleted(0), maxEntries(0), lruHead(-1), lruTail(-1),
+  relTolerance(0.), cellWidth(0.)
+{ }
+
+
+QuantizedPRPCache::~QuantizedPRPCache()
+{ }
+
+
+void QuantizedPRPCache::initialize(Real rel_tol, size_t max_entries)
+{
+  clear();
+  relTolerance = std::max(0., rel_tol);
+  maxEntries = max_entries;
+  // two values within the relative tolerance of nearby() differ by at
+  // most -log(1-tol) in log space
+  cellWidth = (relTolerance > 0.) ? CELL_WIDTH_FACTOR *
+    (-std::log1p(-std::min(relTolerance, 0.5)) + LOG_ROUNDOFF) : 0.;
+}
+
+
+void QuantizedPRPCache::clear()
+{
+  slotTable.clear();
+  cacheEntries.clear();
+  freeEntries.clear();
+  numEntries = numDeleted = 0;
+  lruHead = lruTail = -1;
+}
+
+
+void QuantizedPRPCache::insert(const ParamResponsePair& prp)
+{
+  size_t base_hash;
+  quantize(prp.interface_id(), prp.variables(), base_hash, false);
+  size_t hash = key_hash(base_hash);
+
+  if (maxEntries && numEntries >= maxEntries)
+    remove_entry(lruTail);
+
+  int e;
+  if (freeEntries.empty()) {
+    e = cacheEntries.size();
+    cacheEntries.push_back(Entry());
+  }
+  else {
+    e = freeEntries.back();
+    freeEntries.pop_back();
+  }
+  Entry& entry = cacheEntries[e];
+  entry.prp  = prp;
+  entry.hash = hash;
+  lru_push_front(e);
+  add_to_table(e, hash);
+  ++numEntries;
+}
+
+
+const ParamResponsePair* QuantizedPRPCache::
+find(const String& search_interface_id, const Variables& search_vars,
+     const ActiveSet& search_set)
+{
+  if (!numEntries)
+    return NULL;
+
+  size_t base_hash;
+  bool tol_lookup = (relTolerance > 0.);
+  quantize(search_interface_id, search_vars, base_hash, tol_lookup);
+  int e = probe(key_hash(base_hash), search_interface_id, search_vars,
+		search_set);
+
+  // values within the tolerance of a cell boundary may match entries
+  // stored in the adjacent cell: probe all combinations of alternates
+  if (e < 0 && tol_lookup && !neighborCells.empty()) {
+    size_t i, num_bits = std::min(neighborCells.size(), MAX_NEIGHBOR_BITS);
+    std::vector<long long> home_cells(num_bits);
+    for (i=0; i<num_bits; ++i)
+      home_cells[i] = cellBuffer[neighborCells[i].first];
+    for (size_t mask=1; mask < (size_t(1) << num_bits) && e < 0; ++mask) {
+      for (i=0; i<num_bits; ++i)
+	cellBuffer[neighborCells[i].first]
+	  = (mask & (size_t(1) << i)) ? neighborCells[i].second : home_cells[i];
+      e = probe(key_hash(base_hash), search_interface_id, search_vars,
+		search_set);
+    }
+  }
+
+  if (e < 0)
+    return NULL;
+  if (e != lruHead)
+    { lru_unlink(e); lru_push_front(e); }
+  return &cacheEntries[e].prp;
+}
+
+
+void QuantizedPRPCache::erase(const ParamResponsePair& prp)
+{
+  if (!numEntries)
+    return;
+  size_t base_hash;
+  quantize(prp.interface_id(), prp.variables(), base_hash, false);
+  size_t hash = key_hash(base_hash), mask = slotTable.size() - 1;
+  const IntStringPair& ids = prp.eval_interface_ids();
+  for (size_t s = hash & mask; slotTable[s].entry != EMPTY_SLOT;
+       s = (s + 1) & mask) {
+    int e = slotTable[s].entry;
+    // eval ids from restart (<= 0) are not unique
+    if (e >= 0 && slotTable[s].hash == hash &&
+	cacheEntries[e].prp.eval_interface_ids() == ids &&
+	cacheEntries[e].prp.variables() == prp.variables()) {
+      remove_entry(e);
+      return;
+    }
+  }
+}
+
+
+void QuantizedPRPCache::
+quantize(const String& interface_id, const Variables& vars, size_t& base_hash,
+	 bool find_neighbors)
+{
+  // exact data: interface id and discrete values
+  base_hash = 0;
+  boost::hash_combine(base_hash, interface_id);
+  const IntVector& di_vars = vars.all_discrete_int_variables();
+  int i, num_vars = di_vars.length();
+  for (i=0; i<num_vars; ++i)
+    boost::hash_combine(base_hash, di_vars[i]);
+  StringMultiArrayConstView ds_vars = vars.all_discrete_string_variables();
+  for (size_t j=0; j<ds_vars.size(); ++j)
+    boost::hash_combine(base_hash, ds_vars[j]);
+  const RealVector& dr_vars = vars.all_discrete_real_variables();
+  num_vars = dr_vars.length();
+  for (i=0; i<num_vars; ++i)
+    boost::hash_combine(base_hash, real_bits(dr_vars[i]));
+
+  // continuous values: binary or logarithmic cell (with sign)
+  const RealVector& c_vars = vars.all_continuous_variables();
+  num_vars = c_vars.length();
+  boost::hash_combine(base_hash, num_vars);
+  cellBuffer.resize(num_vars);
+  neighborCells.clear();
+  std::vector<Real> boundary_dist;
+  for (i=0; i<num_vars; ++i) {
+    Real x = c_vars[i];
+    if (relTolerance <= 0.)
+      cellBuffer[i] = real_bits(x);
+    else if (std::abs(x) < DBL_MIN) // nearby() requires both ~ 0
+      cellBuffer[i] = LLONG_MIN;
+    else {
+      Real log_x = std::log(std::abs(x)), t = log_x / cellWidth,
+	cell = std::floor(t), frac = t - cell;
+      long long c = (long long)cell, sign = (x < 0.) ? 1 : 0;
+      cellBuffer[i] = 2 * c + sign;
+      if (find_neighbors) {
+	Real margin = (cellWidth / CELL_WIDTH_FACTOR +
+		       4. * DBL_EPSILON * std::abs(log_x)) / cellWidth;
+	if (frac < margin) {
+	  neighborCells.push_back(std::make_pair(i, 2 * (c - 1) + sign));
+	  boundary_dist.push_back(frac);
+	}
+	else if (1. - frac < margin) {
+	  neighborCells.push_back(std::make_pair(i, 2 * (c + 1) + sign));
+	  boundary_dist.push_back(1. - frac);
+	}
+      }
+    }
+  }
+
+  // probe the alternates of the most ambiguous coordinates first
+  if (neighborCells.size() > MAX_NEIGHBOR_BITS) {
+    std::vector<size_t> order(neighborCells.size());
+    for (size_t j=0; j<order.size(); ++j)
+      order[j] = j;
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b)
+	      { return boundary_dist[a] < boundary_dist[b]; });
+    std::vector<std::pair<size_t, long long> > sorted(MAX_NEIGHBOR_BITS);
+    for (size_t j=0; j<MAX_NEIGHBOR_BITS; ++j)
+      sorted[j] = neighborCells[order[j]];
+    neighborCells.swap(sorted);
+  }
+}
+
+
+size_t QuantizedPRPCache::key_hash(size_t base_hash) const
+{
+  size_t seed = base_hash;
+  for (long long c : cellBuffer)
+    boost::hash_combine(seed, c);
+  return seed;
+}
+
+
+bool QuantizedPRPCache::
+matches(int e, const String& search_interface_id,
+	const Variables& search_vars, const ActiveSet& search_set) const
+{
+  const ParamResponsePair& prp = cacheEntries[e].prp;
+  if (prp.interface_id() != search_interface_id)
+    return false;
+  if (relTolerance > 0.) {
+    if (!nearby(prp.variables(), search_vars, relTolerance))
+      return false;
+  }
+  else if (prp.variables() != search_vars)
+    return false;
+  return set_compare(prp, search_set);
+}
+
+
+int QuantizedPRPCache::
+probe(size_t hash, const String& search_interface_id,
+      const Variables& search_vars, const ActiveSet& search_set) const
+{
+  size_t mask = slotTable.size() - 1;
+  for (size_t s = hash & mask; slotTable[s].entry != EMPTY_SLOT;
+       s = (s + 1) & mask) {
+    const Slot& slot = slotTable[s];
+    if (slot.entry >= 0 && slot.hash == hash &&
+	matches(slot.entry, search_interface_id, search_vars, search_set))
+      return slot.entry;
+  }
+  return -1;
+}
+
+
+size_t QuantizedPRPCache::slot_of(int e, size_t hash) const
+{
+  size_t s, mask = slotTable.size() - 1;
+  for (s = hash & mask; slotTable[s].entry != e; s = (s + 1) & mask)
+    ;
+  return s;
+}
+
+
+void QuantizedPRPCache::add_to_table(int e, size_t hash)
+{
+  // keep the load (including deleted slots) at most 1/2
+  if ( 2 * (numEntries + numDeleted + 1) > slotTable.size() ) {
+    size_t num_slots = std::max(MIN_SLOTS, slotTable.size());
+    while (2 * (numEntries + 1) > num_slots / 2)
+      num_slots *= 2;
+    rehash(num_slots);
+  }
+  size_t s, mask = slotTable.size() - 1;
+  for (s = hash & mask; slotTable[s].entry >= 0; s = (s + 1) & mask)
+    ;
+  if (slotTable[s].entry == DELETED_SLOT)
+    --numDeleted;
+  slotTable[s].hash  = hash;
+  slotTable[s].entry = e;
+}
+
+
+void QuantizedPRPCache::rehash(size_t num_slots)
+{
+  Slot empty_slot = { 0, EMPTY_SLOT };
+  slotTable.assign(num_slots, empty_slot);
+  numDeleted = 0;
+  size_t mask = num_slots - 1;
+  for (int e = lruHead; e >= 0; e = cacheEntries[e].older) {
+    size_t s;
+    for (s = cacheEntries[e].hash & mask; slotTable[s].entry != EMPTY_SLOT;
+	 s = (s + 1) & mask)
+      ;
+    slotTable[s].hash  = cacheEntries[e].hash;
+    slotTable[s].entry = e;
+  }
+}
+
+
+void QuantizedPRPCache::remove_entry(int e)
+{
+  slotTable[slot_of(e, cacheEntries[e].hash)].entry = DELETED_SLOT;
+  ++numDeleted;
+  lru_unlink(e);
+  cacheEntries[e].prp = ParamResponsePair(); // release shared data
+  freeEntries.push_back(e);
+  --numEntries;
+}
+
+
+void QuantizedPRPCache::lru_unlink(int e)
+{
+  Entry& entry = cacheEntries[e];
+  if (entry.newer >= 0) cacheEntries[entry.newer].older = entry.older;
+  else                  lruHead = entry.older;
+  if (entry.older >= 0) cacheEntries[entry.older].newer = entry.newer;
+  else                  lruTail = entry.newer;
+  entry.older = entry.newer = -1;
+}
+
+
+void QuantizedPRPCache::lru_push_front(int e)
+{
+  Entry& entry = cacheEntries[e];
+  entry.newer = -1;
+  entry.older = lruHead;
+  if (lruHead >= 0) cacheEntries[lruHead].newer = e;
+  lruHead = e;
+  if (lruTail < 0) lruTail = e;
+}
+
+} // namespace Dakota
@@ -0,0 +1,188 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#ifndef QUANTIZED_PRP_CACHE_H
+#define QUANTIZED_PRP_CACHE_H
+
+#include "dakota_system_defs.hpp"
+#include "dakota_data_types.hpp"
+#include "ParamResponsePair.hpp"
+
+
+namespace Dakota {
+
+
+/// Bounded evaluation cache index supporting exact and
+/// tolerance-based duplicate detection in constant expected time.
+
+/** Each cached ParamResponsePair (a shallow copy sharing its
+    variables and response with the data_pairs entry) is keyed by a
+    single hash of its interface id and variable values.  For exact
+    lookups, continuous values are hashed by their binary value.  For
+    tolerance-based lookups, each nonzero continuous value is
+    quantized to a cell of a logarithmic grid whose width is a
+    multiple of the relative tolerance used by nearby(), and lookups
+    also probe the neighboring cells of values lying within the
+    tolerance of a cell boundary (up to a fixed number of probes).
+    Discrete values are always hashed exactly.  Candidates sharing a
+    hash are verified against the interface id, the variables (exact
+    or nearby()), and the active set (set_compare()).
+
+    The hashes are stored in an open-addressing table with linear
+    probing.  The entries are kept in least recently used order and,
+    when a maximum size is given, the least recently used entry is
+    evicted on insertion into a full cache.  Evicted evaluations
+    remain in data_pairs, since other clients search it; they are
+    only no longer found as duplicates by this index.  The maximum
+    size therefore bounds the index, not the memory of data_pairs. */
+
+class QuantizedPRPCache
+{
+public:
+
+  //
+  //- Heading: Constructors and destructor
+  //
+
+  QuantizedPRPCache();  ///< constructor
+  ~QuantizedPRPCache(); ///< destructor
+
+  //
+  //- Heading: Member functions
+  //
+
+  /// set the relative tolerance of lookups (0 for exact equality) and
+  /// the maximum number of entries (0 for no limit); clears the cache
+  void initialize(Real rel_tol, size_t max_entries);
+
+  /// add prp as the most recently used entry, evicting the least
+  /// recently used entry if the cache is full
+  void insert(const ParamResponsePair& prp);
+
+  /// find an entry matching the interface id, variables, and active
+  /// set; the entry becomes the most recently used.  Returns NULL if
+  /// there is no match.
+  const ParamResponsePair* find(const String& search_interface_id,
+				const Variables& search_vars,
+				const ActiveSet& search_set);
+
+  /// remove the entry holding the evaluation with prp's eval and
+  /// interface ids and variables, if present
+  void erase(const ParamResponsePair& prp);
+
+  /// remove all entries
+  void clear();
+
+  /// number of cached entries
+  size_t size() const;
+
+private:
+
+  //
+  //- Heading: Convenience functions
+  //
+
+  /// compute the cell coordinates (or binary values) of the continuous
+  /// variables into cellBuffer, the hash of the remaining key data into
+  /// base_hash, and, for tolerance-based lookups, the coordinates near
+  /// a cell boundary with their alternate cells into neighborCells
+  void quantize(const String& interface_id, const Variables& vars,
+		size_t& base_hash, bool find_neighbors);
+
+  /// hash of base_hash combined with the current cellBuffer
+  size_t key_hash(size_t base_hash) const;
+
+  /// whether entry e matches the search data
+  bool matches(int e, const String& search_interface_id,
+	       const Variables& search_vars, const ActiveSet& search_set) const;
+
+  /// search the table for an entry with the given hash that matches
+  /// the search data; returns the entry index or -1
+  int probe(size_t hash, const String& search_interface_id,
+	    const Variables& search_vars, const ActiveSet& search_set) const;
+
+  /// index of the table slot holding entry e (with hash)
+  size_t slot_of(int e, size_t hash) const;
+
+  /// add entry e with hash to the table, growing it if needed
+  void add_to_table(int e, size_t hash);
+  /// rebuild the table with the given number of slots
+  void rehash(size_t num_slots);
+
+  /// remove entry e from the table and the LRU list
+  void remove_entry(int e);
+
+  /// unlink entry e from the LRU list
+  void lru_unlink(int e);
+  /// link entry e at the front (most recently used) of the LRU list
+  void lru_push_front(int e);
+
+  //
+  //- Heading: Data
+  //
+
+  /// table slot: hash of an entry's key and its index
+  struct Slot {
+    /// hash of the key
+    size_t hash;
+    /// entry index, or EMPTY_SLOT / DELETED_SLOT
+    int entry;
+  };
+
+  /// cached evaluation with its key hash and LRU links
+  struct Entry {
+    /// shallow copy of the cached evaluation
+    ParamResponsePair prp;
+    /// hash of the key under which the entry is stored
+    size_t hash;
+    /// less recently used neighbor (-1 at the tail)
+    int older;
+    /// more recently used neighbor (-1 at the head)
+    int newer;
+  };
+
+  /// open-addressing table (size is a power of 2)
+  std::vector<Slot> slotTable;
+  /// entries referenced by the table; unused entries are listed in
+  /// freeEntries
+  std::vector<Entry> cacheEntries;
+  /// indices of unused cacheEntries
+  std::vector<int> freeEntries;
+
+  /// number of live entries
+  size_t numEntries;
+  /// number of deleted table slots
+  size_t numDeleted;
+  /// maximum number of entries (0 = unlimited)
+  size_t maxEntries;
+
+  /// most recently used entry (-1 if empty)
+  int lruHead;
+  /// least recently used entry (-1 if empty)
+  int lruTail;
+
+  /// relative tolerance for tolerance-based lookups (0 = exact)
+  Real relTolerance;
+  /// width of the logarithmic quantization cells
+  Real cellWidth;
+
+  /// quantized continuous values of the current key
+  std::vector<long long> cellBuffer;
+  /// (coordinate, alternate cell) pairs of the current key, most
+  /// ambiguous first
+  std::vector<std::pair<size_t, long long> > neighborCells;
+};
+
+
+inline size_t QuantizedPRPCache::size() const
+{ return numEntries; }
+
+} // namespace Dakota
+
+#endif
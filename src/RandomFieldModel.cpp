@@ -196,9 +196,11 @@ void RandomFieldModel::identify_field_model()
 {
   // operations common to both representations
   rfBasis.set_matrix(rfBuildData);
-  rfBasis.update_svd(true);  // true: center the matrix before factoring
   //percentVariance = 0.9; // hardcoded: need to remove
   ReducedBasis::VarianceExplained truncation(percentVariance);
+  // only the leading components retained by the truncation are computed;
+  // true: center the matrix before factoring
+  rfBasis.update_randomized_svd(truncation, true);
   actualReducedRank = truncation.get_num_components(rfBasis);
   Cout << "RandomFieldModel: retaining " << actualReducedRank 
        << " basis functions." << std::endl;
@@ -220,16 +222,11 @@ void RandomFieldModel::identify_field_model()
     const RealMatrix& principal_comp
       = rfBasis.get_right_singular_vector_transpose();
 
-    // Compute the factor scores
-    RealMatrix factor_scores(num_samples, numFns);
-    int myerr = factor_scores.multiply(Teuchos::NO_TRANS, Teuchos::TRANS, 1., 
-                                       centered_matrix, principal_comp, 0.);
-
-    // BMA TODO: verify why this size differs; seems that factor
-    // scores should be n x p and that this could seg fault if
-    // num_samples > numFns...
-    RealMatrix
-      f_scores(Teuchos::Copy, factor_scores, num_samples, num_samples, 0, 0);
+    // Compute the factor scores of the retained principal components
+    // (the rows of the truncated V')
+    RealMatrix f_scores(num_samples, principal_comp.numRows());
+    int myerr = f_scores.multiply(Teuchos::NO_TRANS, Teuchos::TRANS, 1., 
+                                  centered_matrix, principal_comp, 0.);
 
     // build the GP approximations, one per principal component
     String approx_type("global_kriging"); // Surfpack GP
@@ -431,15 +431,23 @@ void Rank1Lattice::unsafe_get_points(
   RealMatrix& points
 )
 {
-  for ( UInt32 k = nMin; k < nMax; ++k ) /// Loop over all points
-  {
-    Real phik = (this->*reorder)(k) * scale; /// phi(k)
-    for ( int j = 0; j < points.numRows(); ++j ) /// Loop over all dimensions
+  /// Points are independent, so contiguous blocks are generated in parallel
+  int dimension = points.numRows();
+  generate_blocks(nMin, nMax, dimension,
+    [&](const size_t kStart, const size_t kEnd)
     {
-      Real point = phik * generatingVector[j] + randomShift[j];
-      points[k - nMin][j] = point - std::floor(point); /// Map to [0, 1)
+      for ( UInt32 k = kStart; k < kEnd; ++k ) /// Loop over all points
+      {
+        Real phik = (this->*reorder)(k) * scale; /// phi(k)
+        Real* point_k = points[k - nMin];
+        for ( int j = 0; j < dimension; ++j ) /// Loop over all dimensions
+        {
+          Real point = phik * generatingVector[j] + randomShift[j];
+          point_k[j] = point - std::floor(point); /// Map to [0, 1)
+        }
+      }
     }
-  }
+  );
 }
 
 /// Position of the `k`th lattice point in RANK_1_LATTICE_NATURAL_ORDERING
@@ -287,6 +287,10 @@ protected:
   RealVector solution_level_costs() const;
   /// return active cost estimate from subModel::solnControlCostMap
   Real solution_level_cost() const;
+  /// return measured costs across the solution levels of subModel
+  RealVector solution_level_measured_costs(bool cpu_time = false) const;
+  /// activate or deactivate the measurement of evaluation times in subModel
+  void time_evaluations(bool flag);
 
   /// set the relative weightings for multiple objective functions or least
   /// squares terms and optionally recurses into subModel
@@ -879,6 +883,14 @@ inline Real RecastModel::solution_level_cost() const
 { return subModel.solution_level_cost(); }
 
 
+inline RealVector RecastModel::solution_level_measured_costs(bool cpu_time) const
+{ return subModel.solution_level_measured_costs(cpu_time); }
+
+
+inline void RecastModel::time_evaluations(bool flag)
+{ subModel.time_evaluations(flag); }
+
+
 inline void RecastModel::
 primary_response_fn_weights(const RealVector& wts, bool recurse_flag)
 {
@@ -12,13 +12,68 @@
 #include "dakota_global_defs.hpp"
 
 #include <Teuchos_SerialDenseHelpers.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/normal_distribution.hpp>
 
 namespace Dakota {
 
+/// number of singular triplets first requested of the randomized SVD
+static const int RB_RANDOMIZED_INITIAL_RANK = 16;
+/// additional samples of the range beyond the requested rank
+static const int RB_RANDOMIZED_OVERSAMPLING = 10;
+/// fixed seed, such that the randomized factorization is repeatable
+static const unsigned int RB_RANDOMIZED_SEED = 20170503;
+
+// ------------------------------------------
+
+/** Randomized range finder (Halko, Martinsson, and Tropp, 2011): the
+    orthonormalized product Q of X with num_samples Gaussian vectors,
+    refined by power iterations, spans the dominant range of X, and the
+    SVD of the num_samples x p matrix Q'X gives the leading rank
+    triplets.  When num_samples = min(n,p) the factorization is exact. */
+static void
+randomized_svd(const RealMatrix & X, int rank, int num_samples,
+               int power_iterations, boost::random::mt19937 & rng,
+               RealMatrix & U, RealVector & S, RealMatrix & VT)
+{
+  int i, j, n = X.numRows(), p = X.numCols();
+
+  boost::random::normal_distribution<Real> std_normal;
+  RealMatrix omega(p, num_samples, false);
+  for( j=0; j<num_samples; ++j )
+    for( i=0; i<p; ++i )
+      omega(i,j) = std_normal(rng);
+
+  RealMatrix Q(n, num_samples, false), Z(p, num_samples, false);
+  Q.multiply(Teuchos::NO_TRANS, Teuchos::NO_TRANS, 1.0, X, omega, 0.0);
+  thin_qr(Q);
+  for( int it=0; it<power_iterations; ++it ) {
+    Z.multiply(Teuchos::TRANS, Teuchos::NO_TRANS, 1.0, X, Q, 0.0);
+    thin_qr(Z);
+    Q.multiply(Teuchos::NO_TRANS, Teuchos::NO_TRANS, 1.0, X, Z, 0.0);
+    thin_qr(Q);
+  }
+
+  // X ~= Q Q'X = Q Z' with Z = X'Q = W S Y', so that U = Q Y and V = W
+  RealMatrix Y_trans;
+  Z.multiply(Teuchos::TRANS, Teuchos::NO_TRANS, 1.0, X, Q, 0.0);
+  svd(Z, S, Y_trans);
+  S.resize(rank);
+
+  RealMatrix Y_trans_k(Teuchos::View, Y_trans, rank, num_samples);
+  U.shape(n, rank);
+  U.multiply(Teuchos::NO_TRANS, Teuchos::TRANS, 1.0, Q, Y_trans_k, 0.0);
+  VT.shapeUninitialized(rank, p);
+  for( j=0; j<p; ++j )
+    for( i=0; i<rank; ++i )
+      VT(i,j) = Z(j,i);
+}
+
 // ------------------------------------------
 
 ReducedBasis::ReducedBasis() :
-  col_means_computed(false), is_centered(false), is_valid_svd(false)
+  col_means_computed(false), is_centered(false), is_valid_svd(false),
+  is_truncated_svd(false)
 {
 }
 
@@ -31,6 +86,7 @@ ReducedBasis::set_matrix(const RealMatrix & mat)
   col_means_computed = false;
   is_centered = false;
   is_valid_svd = false;
+  is_truncated_svd = false;
 }
 
 // ------------------------------------------
@@ -41,6 +97,8 @@ ReducedBasis::center_matrix()
   if ( is_centered )
     return;
 
+  // retain the means of the data for predictions and updates
+  get_column_means();
   center_matrix_cols(matrix);
 
   is_centered = true;
@@ -74,6 +132,215 @@ ReducedBasis::update_svd(bool do_center)
     eigen_values_sum += S_values(i)*S_values(i);
 
   is_valid_svd = true;
+  is_truncated_svd = false;
+}
+
+// ------------------------------------------
+
+/** Each attempt doubles the rank until the number of components
+    selected by the truncation condition is less than the rank, or all
+    min(n,p) singular triplets are computed.  The total of the
+    eigenvalues is the squared Frobenius norm of the matrix, so
+    variance-based conditions are evaluated without the full spectrum. */
+void
+ReducedBasis::update_randomized_svd(const TruncationCondition & truncation,
+                                    bool do_center, int power_iterations)
+{
+  if( is_valid_svd )
+    return;
+
+  if( matrix.empty() )
+    throw std::runtime_error("Matrix is empty.  Make sure to call set_matrix(...) first.");
+
+  if( do_center )
+    center_matrix();
+
+  int full_rank = std::min(matrix.numRows(), matrix.numCols());
+  Real frobenius_norm = matrix.normFrobenius();
+  eigen_values_sum = frobenius_norm*frobenius_norm;
+
+  boost::random::mt19937 rng(RB_RANDOMIZED_SEED);
+  int rank = std::min(RB_RANDOMIZED_INITIAL_RANK, full_rank);
+  while( true ) {
+    int num_samples = std::min(rank + RB_RANDOMIZED_OVERSAMPLING, full_rank);
+    randomized_svd(matrix, rank, num_samples, power_iterations, rng,
+                   U_matrix, S_values, VT_matrix);
+
+    singular_values_sum = 0.0;
+    for( int i=0; i<rank; ++i )
+      singular_values_sum += S_values(i);
+    is_valid_svd = true;
+    is_truncated_svd = (rank < full_rank);
+
+    if( !is_truncated_svd || truncation.get_num_components(*this) < rank )
+      break;
+    rank = std::min(2*rank, full_rank);
+  }
+}
+
+// ------------------------------------------
+
+/** The Gram matrix of the updated matrix is that of the current
+    factorization S V' plus that of rows C, which are the appended rows,
+    or when centered, the appended rows about their mean and a row for
+    the shift of the mean (as in incremental PCA).  Following Brand
+    (2006), C is split into its projection L = C V and the residual
+    C - L V' = R'Q' with orthonormal Q, so that the new S and V follow
+    from the SVD of the small matrix [S 0; L R'] and
+    V_new = [V Q] V_K.  The left singular vectors are the updated
+    matrix times V_new S_new^{-1}, which for the current rows follows
+    from U S (V'V_new) without revisiting the data. */
+void
+ReducedBasis::append_rows(const RealMatrix & new_rows, int max_rank)
+{
+  if( !is_valid_svd )
+    throw std::runtime_error("No factorization to update.  Make sure to call update_svd(...) first.");
+
+  int i, j, n = matrix.numRows(), p = matrix.numCols(),
+    r = new_rows.numRows(), k = S_values.length();
+  if( new_rows.numCols() != p )
+    throw std::runtime_error("Appended rows must have as many columns as the matrix.");
+  if( r == 0 )
+    return;
+
+  int n_new = n + r, num_c = is_centered ? r + 1 : r;
+  RealVector new_means(p), mean_shift(p);
+  RealMatrix C(num_c, p, false);
+  if( is_centered ) {
+    RealVector row_means(p);
+    Real scale = std::sqrt((Real)n*(Real)r/(Real)n_new);
+    for( j=0; j<p; ++j ) {
+      for( i=0; i<r; ++i )
+        row_means(j) += new_rows(i,j);
+      row_means(j) /= (Real)r;
+      new_means(j) = (n*column_means(j) + r*row_means(j))/(Real)n_new;
+      mean_shift(j) = new_means(j) - column_means(j);
+      for( i=0; i<r; ++i )
+        C(i,j) = new_rows(i,j) - row_means(j);
+      C(r,j) = scale*(row_means(j) - column_means(j));
+    }
+  }
+  else
+    C.assign(new_rows);
+
+  Real c_norm = C.normFrobenius();
+  eigen_values_sum += c_norm*c_norm;
+
+  int num_k = k + num_c, new_rank = std::min(num_k, std::min(n_new, p));
+  if( max_rank > 0 && new_rank > max_rank )
+    new_rank = max_rank;
+
+  RealMatrix VT_k(Teuchos::View, VT_matrix, k, p), K(num_k, num_k),
+    K_VT, new_VT(new_rank, p);
+  RealVector new_S;
+  if( p <= num_k ) {
+    // few columns: factor [S V'; C] directly
+    RealMatrix M(num_k, p);
+    for( j=0; j<p; ++j ) {
+      for( i=0; i<k; ++i )
+        M(i,j) = S_values(i)*VT_k(i,j);
+      for( i=0; i<num_c; ++i )
+        M(k+i,j) = C(i,j);
+    }
+    svd(M, new_S, K_VT);
+    for( j=0; j<p; ++j )
+      for( i=0; i<new_rank; ++i )
+        new_VT(i,j) = K_VT(i,j);
+  }
+  else {
+    // L = C V and the residual H' = C' - V L' = Q R; Q is orthogonalized
+    // against V once more, since its columns for a rank-deficient
+    // residual (e.g., centered rows) are otherwise dominated by rounding:
+    // Q = Q_2 R_2 + V L_2 gives L += (L_2 R)' and R = R_2 R
+    RealMatrix L(num_c, k), L2(k, num_c), L2_R(k, num_c),
+      H_trans(p, num_c, false), R, R2, R2_R(num_c, num_c);
+    for( j=0; j<num_c; ++j )
+      for( i=0; i<p; ++i )
+        H_trans(i,j) = C(j,i);
+    L.multiply(Teuchos::NO_TRANS, Teuchos::TRANS, 1.0, C, VT_k, 0.0);
+    H_trans.multiply(Teuchos::TRANS, Teuchos::TRANS, -1.0, VT_k, L, 1.0);
+    thin_qr(H_trans, &R);
+    L2.multiply(Teuchos::NO_TRANS, Teuchos::NO_TRANS, 1.0, VT_k, H_trans, 0.0);
+    H_trans.multiply(Teuchos::TRANS, Teuchos::NO_TRANS, -1.0, VT_k, L2, 1.0);
+    thin_qr(H_trans, &R2);
+    L2_R.multiply(Teuchos::NO_TRANS, Teuchos::NO_TRANS, 1.0, L2, R, 0.0);
+    R2_R.multiply(Teuchos::NO_TRANS, Teuchos::NO_TRANS, 1.0, R2, R, 0.0);
+    R = R2_R;
+    for( j=0; j<k; ++j )
+      for( i=0; i<num_c; ++i )
+        L(i,j) += L2_R(j,i);
+
+    for( i=0; i<k; ++i )
+      K(i,i) = S_values(i);
+    for( i=0; i<num_c; ++i ) {
+      for( j=0; j<k; ++j )
+        K(k+i,j) = L(i,j);
+      for( j=0; j<=i; ++j )
+        K(k+i,k+j) = R(j,i);
+    }
+    svd(K, new_S, K_VT);
+
+    // V_new' = V_K' [V'; Q']
+    RealMatrix K_VT_V(Teuchos::View, K_VT, new_rank, k, 0, 0),
+      K_VT_Q(Teuchos::View, K_VT, new_rank, num_c, 0, k);
+    new_VT.multiply(Teuchos::NO_TRANS, Teuchos::NO_TRANS, 1.0,
+                    K_VT_V, VT_k, 0.0);
+    new_VT.multiply(Teuchos::NO_TRANS, Teuchos::TRANS, 1.0,
+                    K_VT_Q, H_trans, 1.0);
+  }
+  new_S.resize(new_rank);
+
+  // U_new = [U S V'V_new - 1 (V_new' d)'; (new rows - 1 m') V_new] S_new^{-1}
+  RealMatrix US(Teuchos::Copy, U_matrix, n, k),
+    VT_V(k, new_rank), new_U(n_new, new_rank);
+  for( j=0; j<k; ++j )
+    for( i=0; i<n; ++i )
+      US(i,j) *= S_values(j);
+  VT_V.multiply(Teuchos::NO_TRANS, Teuchos::TRANS, 1.0, VT_k, new_VT, 0.0);
+  RealMatrix new_U_old(Teuchos::View, new_U, n, new_rank, 0, 0),
+    new_U_new(Teuchos::View, new_U, r, new_rank, n, 0), centered_rows(new_rows);
+  new_U_old.multiply(Teuchos::NO_TRANS, Teuchos::NO_TRANS, 1.0, US, VT_V, 0.0);
+  if( is_centered ) {
+    RealVector shift_proj(new_rank);
+    shift_proj.multiply(Teuchos::NO_TRANS, Teuchos::NO_TRANS, 1.0,
+                        new_VT, mean_shift, 0.0);
+    for( j=0; j<new_rank; ++j )
+      for( i=0; i<n; ++i )
+        new_U_old(i,j) -= shift_proj(j);
+    for( j=0; j<p; ++j )
+      for( i=0; i<r; ++i )
+        centered_rows(i,j) -= new_means(j);
+  }
+  new_U_new.multiply(Teuchos::NO_TRANS, Teuchos::TRANS, 1.0,
+                     centered_rows, new_VT, 0.0);
+  for( j=0; j<new_rank; ++j ) {
+    Real s_inv = (new_S(j) > 0.0) ? 1.0/new_S(j) : 0.0;
+    for( i=0; i<n_new; ++i )
+      new_U(i,j) *= s_inv;
+  }
+
+  // append the rows to the (centered) matrix
+  RealMatrix new_matrix(n_new, p, false);
+  for( j=0; j<p; ++j ) {
+    Real old_shift = is_centered ? mean_shift(j) : 0.0;
+    for( i=0; i<n; ++i )
+      new_matrix(i,j) = matrix(i,j) - old_shift;
+    for( i=0; i<r; ++i )
+      new_matrix(n+i,j) = centered_rows(i,j);
+  }
+  matrix = new_matrix;
+  if( is_centered )
+    column_means = new_means;
+  else
+    col_means_computed = false;
+
+  U_matrix = new_U;
+  S_values = new_S;
+  VT_matrix = new_VT;
+  singular_values_sum = 0.0;
+  for( i=0; i<new_rank; ++i )
+    singular_values_sum += S_values(i);
+  is_truncated_svd = (new_rank < std::min(n_new, p));
 }
 
 // ------------------------------------------
@@ -136,10 +403,10 @@ int ReducedBasis::VarianceExplained::get_num_components(const ReducedBasis & bas
 
   Real total_sum = basis.get_eigen_values_sum();
   const RealVector & singular_vals = basis.get_singular_values();
-  int num_comp = 0;
+  int num_comp = 0, num_values = singular_vals.length();
   Real partial_sum = 0.0;
 
-  while( partial_sum/total_sum < variance_explained )
+  while( num_comp < num_values && partial_sum/total_sum < variance_explained )
     partial_sum += singular_vals(num_comp)*singular_vals(num_comp++);
 
   return num_comp;
@@ -164,10 +431,10 @@ int ReducedBasis::HeuristicVarianceExplained::get_num_components(const ReducedBa
 
   const RealVector & singular_vals = basis.get_singular_values();
   Real largest_eig_val = singular_vals(0)*singular_vals(0);
-  int num_comp = 0;
+  int num_comp = 0, num_values = singular_vals.length();
   Real ratio = 1.0;
 
-  while( ratio > (1.0-variance_explained) )
+  while( num_comp < num_values && ratio > (1.0-variance_explained) )
     ratio = singular_vals(num_comp)*singular_vals(num_comp++)/largest_eig_val;
 
   return num_comp;
@@ -50,9 +50,26 @@ class ReducedBasis
     /// ensure that the factorization is current, centering if requested
     void update_svd(bool center_matrix_by_col_means = true);
 
+    /// ensure that the factorization is current, approximating only the
+    /// leading singular triplets with a randomized range finder; the rank
+    /// grows until the truncation condition is met within those computed
+    void update_randomized_svd(const TruncationCondition & truncation,
+                               bool center_matrix_by_col_means = true,
+                               int power_iterations = 2);
+
+    /// append observations (rows) to the matrix, updating the current
+    /// factorization rather than recomputing it; a positive max_rank
+    /// bounds the number of singular triplets retained; RandomFieldModel
+    /// regenerates its build data in full and so uses update_*svd instead
+    void append_rows(const RealMatrix & new_rows, int max_rank = 0);
+
     bool is_valid() const
       { return is_valid_svd; }
 
+    /// whether fewer than min(n,p) singular triplets are retained
+    bool is_truncated() const
+      { return is_truncated_svd; }
+
     const Real & get_singular_values_sum() const
       { return singular_values_sum; }
 
@@ -74,12 +91,14 @@ class ReducedBasis
 
     /// the num_observations n x num_observations n orthogonal matrix
     /// U; the left singular vectors are the first min(n,p) columns
+    /// (the first k when k < min(n,p) singular values are retained)
     const RealMatrix & get_left_singular_vector() const
       { return U_matrix; }
 
     /// the num_responses p x num_responses p orthogonal matrix V';
     /// the right singular vectors are the first min(n,p) rows of V'
-    /// (columns of V)
+    /// (columns of V); only the k x p leading rows when k < min(n,p)
+    /// singular values are retained
     const RealMatrix & get_right_singular_vector_transpose() const
       { return VT_matrix; }
 
@@ -97,8 +116,12 @@ class ReducedBasis
     bool col_means_computed;
     bool is_centered;
     bool is_valid_svd;
+    bool is_truncated_svd;
 
+    /// sum of the retained singular values
     Real singular_values_sum;
+    /// sum of all eigenvalues (squared Frobenius norm of the matrix),
+    /// also when the factorization is truncated
     Real eigen_values_sum;
 
     TruncationCondition * truncation;
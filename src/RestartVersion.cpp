@@ -14,9 +14,18 @@
 #include <boost/archive/binary_oarchive.hpp>
 #include <boost/archive/binary_iarchive.hpp>
 #include <boost/serialization/export.hpp>
+#include <boost/crc.hpp>
 
 namespace Dakota {
 
+unsigned int RestartVersion::checksum(const char* data, size_t length)
+{
+  boost::crc_32_type crc;
+  crc.process_bytes(data, length);
+  return crc.checksum();
+}
+
+
 /** This creates its own iarchive for the restart file as if the file
     doesn't contain full restart information, need to rewind and
     create a new iarchive anyway. */
@@ -12,6 +12,7 @@
 
 #include <boost/serialization/access.hpp>
 #include <boost/serialization/version.hpp>
+#include <cstddef>
 #include <limits>
 #include <string>
 
@@ -39,8 +40,60 @@ public:
   /** Increment this to increment the actual restart version when one
       or more underlying (or this RestartVersion) class version
       changes. This is also the version of this class for Boost
-      purposes. Dakota 6.17.0 ==> versionDelta = 1 */
-  static const unsigned int latestRestartVersionDelta = 1;
+      purposes. Dakota 6.17.0 ==> versionDelta = 1; framed records
+      ==> versionDelta = 2 */
+  static const unsigned int latestRestartVersionDelta = 2;
+
+  /// first user-friendly restart version in which evaluations are
+  /// stored as framed records rather than a single archive stream
+  /** A version 2 file holds the archived RestartVersion, followed by
+      one record per evaluation: a RecordHeader and a payload holding
+      the ParamResponsePair serialized to a headerless binary archive.
+      A file closed normally ends with an index record (eval ids and
+      offsets of all records) and an IndexTrailer locating it. */
+  static const unsigned int firstFramedRestartVersionDelta = 2;
+
+  /// marks the start of an evaluation record
+  static const unsigned int recordMagic = 0x44525243; // "CRRD"
+  /// marks the start of the index record
+  static const unsigned int indexMagic = 0x44585249;  // "IRXD"
+  /// marks the trailer at the end of a completely written file
+  static const unsigned int trailerMagic = 0x4C525444; // "DTRL"
+
+  /// fixed-size header preceding each record payload
+  struct RecordHeader {
+    /// recordMagic or indexMagic
+    unsigned int magic;
+    /// payload length in bytes
+    unsigned int length;
+    /// CRC-32 checksum of the payload
+    unsigned int checksum;
+    /// evaluation id of the record (number of entries for the index)
+    int evalId;
+  };
+
+  /// entry of the index record
+  struct IndexEntry {
+    /// evaluation id of the record
+    int evalId;
+    /// padding for a fixed on-disk layout
+    int reserved;
+    /// byte offset of the record header from the start of the file
+    unsigned long long offset;
+  };
+
+  /// fixed-size trailer written after the index record
+  struct IndexTrailer {
+    /// byte offset of the index record header from the start of the file
+    unsigned long long indexOffset;
+    /// trailerMagic
+    unsigned int magic;
+    /// padding for a fixed on-disk layout
+    unsigned int reserved;
+  };
+
+  /// CRC-32 checksum of a record payload
+  static unsigned int checksum(const char* data, size_t length);
 
   /// The latest restart version (that supported by the current source code)
   static const unsigned int latestRestartVersion =
@@ -68,6 +121,10 @@ public:
       restartVersion - restartFirstVersionNumber;
   }
 
+  /// whether evaluations follow the version info as framed records
+  bool framed_records() const
+  { return friendly_rst_version() >= firstFramedRestartVersionDelta; }
+
   /// check the read rst_filename's version and issue diagnostic info
   /// vs. current Dakota version
   static RestartVersion check_restart_version(const std::string& rst_filename);
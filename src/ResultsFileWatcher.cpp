@@ -0,0 +1,276 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "ResultsFileWatcher.hpp"
+#include <algorithm>
+#include <thread>
+#ifdef HAVE_SYS_INOTIFY_H
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace Dakota {
+
+/// initial (and minimum) delay between polls of the results files (ms)
+static const int MIN_POLL_DELAY = 1;
+/// upper bound on the adaptive delay between polls of the results files (ms)
+static const int MAX_POLL_DELAY = 256;
+/// suffix of the optional sentinel file that signals completion
+static const String SENTINEL_SUFFIX(".done");
+
+
+ResultsFileWatcher::ResultsFileWatcher():
+  inotifyFd(-1), pollDue(true), pollDelay(MIN_POLL_DELAY)
+{
+#ifdef HAVE_SYS_INOTIFY_H
+  inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  // a failure (e.g., exhausted instance limit) falls back to polling
+#endif
+}
+
+
+ResultsFileWatcher::~ResultsFileWatcher()
+{
+#ifdef HAVE_SYS_INOTIFY_H
+  if (inotifyFd >= 0)
+    close(inotifyFd); // also releases all watches
+#endif
+}
+
+
+void ResultsFileWatcher::add(int id, const bfs::path& results_file)
+{
+  // Events still queued for an earlier evaluation that used the same
+  // file name must not be attributed to this one.
+  if (inotifyFd >= 0)
+    process_events();
+  WatchedFile& wf = watchedFiles[id];
+  wf.resultsFile = results_file;
+  wf.fileName    = results_file.filename().string();
+  if (inotifyFd >= 0) {
+    bfs::path dir = results_file.parent_path();
+    wf.watchDesc = add_watch(dir.empty() ? String(".") : dir.string());
+    if (wf.watchDesc >= 0) {
+      eventIndex[std::make_pair(wf.watchDesc, wf.fileName)] = id;
+      eventIndex[std::make_pair(wf.watchDesc, wf.fileName + SENTINEL_SUFFIX)]
+	= id;
+    }
+  }
+  // The evaluation process is launched before it is registered, so a
+  // fast simulation may already have finished; events for it are lost.
+  boost::system::error_code ec;
+  if (bfs::exists(results_file, ec) ||
+      bfs::exists(sentinel_file(results_file), ec))
+    wf.ready = true;
+}
+
+
+void ResultsFileWatcher::remove(int id)
+{
+  std::map<int, WatchedFile>::iterator it = watchedFiles.find(id);
+  if (it == watchedFiles.end())
+    return;
+  WatchedFile& wf = it->second;
+  if (wf.watchDesc >= 0) {
+    eventIndex.erase(std::make_pair(wf.watchDesc, wf.fileName));
+    eventIndex.erase(std::make_pair(wf.watchDesc,
+				    wf.fileName + SENTINEL_SUFFIX));
+    remove_watch(wf.watchDesc);
+  }
+  // the results file has been read (and possibly saved under its name)
+  clear_sentinel(wf.resultsFile);
+  watchedFiles.erase(it);
+}
+
+
+void ResultsFileWatcher::ready(IntSet& ready_ids)
+{
+  if (inotifyFd >= 0)
+    process_events();
+  // Without events, every pass is a polling pass.  With events, files
+  // are polled only once the delay expired without notifications, which
+  // covers writes that inotify cannot observe (e.g., remote NFS clients).
+  if (inotifyFd < 0 || pollDue) {
+    poll_files();
+    pollDue = false;
+  }
+  for (std::map<int, WatchedFile>::iterator it = watchedFiles.begin();
+       it != watchedFiles.end(); ++it)
+    if (it->second.ready)
+      ready_ids.insert(it->first);
+}
+
+
+void ResultsFileWatcher::retry(int id)
+{
+  std::map<int, WatchedFile>::iterator it = watchedFiles.find(id);
+  if (it != watchedFiles.end()) {
+    it->second.ready = it->second.observed = false;
+    // ensure a stat-based recheck even if no further event arrives
+    pollDue = true;
+  }
+}
+
+
+void ResultsFileWatcher::wait()
+{
+  bool events = false;
+  if (inotifyFd >= 0)
+    events = wait_for_events(pollDelay);
+  else
+    std::this_thread::sleep_for(std::chrono::milliseconds(pollDelay));
+
+  if (!events) {
+    pollDue = true;
+    pollDelay = std::min(2 * pollDelay, MAX_POLL_DELAY);
+  }
+}
+
+
+void ResultsFileWatcher::idle()
+{
+  if (inotifyFd >= 0) {
+    if (!wait_for_events(MIN_POLL_DELAY))
+      pollDue = true;
+  }
+  else
+    std::this_thread::sleep_for(std::chrono::milliseconds(MIN_POLL_DELAY));
+}
+
+
+void ResultsFileWatcher::progress()
+{ pollDelay = MIN_POLL_DELAY; }
+
+
+void ResultsFileWatcher::clear_sentinel(const bfs::path& results_file)
+{
+  boost::system::error_code ec; // a missing sentinel is not an error
+  bfs::remove(sentinel_file(results_file), ec);
+}
+
+
+void ResultsFileWatcher::process_events()
+{
+#ifdef HAVE_SYS_INOTIFY_H
+  // buffer aligned for struct inotify_event, per inotify(7)
+  char buf[4096]
+    __attribute__ ((aligned(__alignof__(struct inotify_event))));
+  for (;;) {
+    ssize_t len = read(inotifyFd, buf, sizeof(buf));
+    if (len <= 0) // EAGAIN: no more pending events
+      break;
+    for (char *ptr = buf; ptr < buf + len; ) {
+      const struct inotify_event *event = (const struct inotify_event *)ptr;
+      ptr += sizeof(struct inotify_event) + event->len;
+      if (event->mask & IN_Q_OVERFLOW) { // events lost; fall back to a sweep
+	pollDue = true;
+	continue;
+      }
+      if (!event->len)
+	continue;
+      std::map<std::pair<int, String>, int>::iterator e_it
+	= eventIndex.find(std::make_pair(event->wd, String(event->name)));
+      if (e_it != eventIndex.end())
+	watchedFiles[e_it->second].ready = true;
+    }
+  }
+#endif
+}
+
+
+void ResultsFileWatcher::poll_files()
+{
+  boost::system::error_code ec;
+  for (std::map<int, WatchedFile>::iterator it = watchedFiles.begin();
+       it != watchedFiles.end(); ++it) {
+    WatchedFile& wf = it->second;
+    if (wf.ready)
+      continue;
+    if (bfs::exists(sentinel_file(wf.resultsFile), ec)) {
+      wf.ready = true;
+      continue;
+    }
+    std::uintmax_t size = bfs::file_size(wf.resultsFile, ec);
+    if (ec) { // does not exist (yet)
+      wf.observed = false;
+      continue;
+    }
+    std::time_t write_time = bfs::last_write_time(wf.resultsFile, ec);
+    if (ec)
+      continue;
+    // ready once unchanged between two consecutive polls
+    if (wf.observed && size && size == wf.lastSize &&
+	write_time == wf.lastWriteTime)
+      wf.ready = true;
+    else {
+      wf.observed      = true;
+      wf.lastSize      = size;
+      wf.lastWriteTime = write_time;
+    }
+  }
+}
+
+
+bool ResultsFileWatcher::wait_for_events(int delay_ms)
+{
+#ifdef HAVE_SYS_INOTIFY_H
+  struct pollfd pfd;
+  pfd.fd = inotifyFd; pfd.events = POLLIN; pfd.revents = 0;
+  return (poll(&pfd, 1, delay_ms) > 0);
+#else
+  return false;
+#endif
+}
+
+
+int ResultsFileWatcher::add_watch(const String& dir)
+{
+  std::map<String, int>::iterator d_it = dirWatches.find(dir);
+  if (d_it != dirWatches.end()) {
+    ++watchRefs[d_it->second];
+    return d_it->second;
+  }
+  int wd = -1;
+#ifdef HAVE_SYS_INOTIFY_H
+  // IN_CLOSE_WRITE: writer closed the file (or touched the sentinel);
+  // IN_MOVED_TO: atomic rename into place.  IN_CREATE is deliberately
+  // omitted since it precedes the write.
+  wd = inotify_add_watch(inotifyFd, dir.c_str(),
+			 IN_CLOSE_WRITE | IN_MOVED_TO);
+  if (wd >= 0) {
+    dirWatches[dir] = wd;
+    watchRefs[wd] = 1;
+  }
+  // on failure (e.g., watch limit reached), this file is polled
+#endif
+  return wd;
+}
+
+
+void ResultsFileWatcher::remove_watch(int wd)
+{
+  std::map<int, size_t>::iterator r_it = watchRefs.find(wd);
+  if (r_it == watchRefs.end() || --r_it->second)
+    return;
+  watchRefs.erase(r_it);
+  for (std::map<String, int>::iterator d_it = dirWatches.begin();
+       d_it != dirWatches.end(); ++d_it)
+    if (d_it->second == wd)
+      { dirWatches.erase(d_it); break; }
+#ifdef HAVE_SYS_INOTIFY_H
+  inotify_rm_watch(inotifyFd, wd);
+#endif
+}
+
+
+bfs::path ResultsFileWatcher::sentinel_file(const bfs::path& results_file)
+{ return bfs::path(results_file.string() + SENTINEL_SUFFIX); }
+
+} // namespace Dakota
@@ -0,0 +1,156 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#ifndef RESULTS_FILE_WATCHER_H
+#define RESULTS_FILE_WATCHER_H
+
+#include "dakota_system_defs.hpp"
+#include "dakota_data_types.hpp"
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+namespace bfs = boost::filesystem;
+
+#include <chrono>
+#include <ctime>
+
+
+namespace Dakota {
+
+
+/// Detects completion of results files written by asynchronous
+/// system call (and grid) evaluations.
+
+/** A results file is reported ready when one of the following occurs:
+    (1) it is renamed into place (atomic rename protocol), (2) the
+    process that wrote it closes it, or (3) a sentinel file with the
+    same name plus ".done" appears.  Cases (1) and (2) are detected
+    through inotify when it is available.  Otherwise, and as a safety
+    net for shared filesystems on which inotify does not observe
+    writes from other hosts, files are polled with an exponentially
+    increasing delay, and a file is reported ready once it exists and
+    its size and modification time are unchanged between two polls.
+    In the common case, each results file is therefore parsed exactly
+    once.  The sentinel is deleted when its evaluation is removed, and
+    clear_sentinel() removes one left behind under a reused results
+    file name before the next evaluation is launched. */
+
+class ResultsFileWatcher
+{
+public:
+
+  //
+  //- Heading: Constructors and destructor
+  //
+
+  ResultsFileWatcher();  ///< constructor
+  ~ResultsFileWatcher(); ///< destructor
+
+  //
+  //- Heading: Member functions
+  //
+
+  /// begin watching results_file for completion of evaluation id
+  void add(int id, const bfs::path& results_file);
+  /// stop watching the results file for evaluation id and delete its
+  /// sentinel, if any
+  void remove(int id);
+
+  /// insert the ids of evaluations whose results files are ready to be
+  /// read into ready_ids; does not block
+  void ready(IntSet& ready_ids);
+  /// a read of the results file for id found it incomplete; wait for
+  /// another completion signal before reporting it ready again
+  void retry(int id);
+
+  /// block until a watched file may have changed or the current
+  /// (adaptive) polling delay has expired; the delay doubles each time
+  /// it expires without progress
+  void wait();
+  /// brief pause used by nonblocking tests when nothing completed
+  void idle();
+  /// at least one evaluation completed: reset the polling delay
+  void progress();
+
+  /// whether completion is detected through filesystem events
+  bool event_driven() const;
+
+  /// delete a stale sentinel for results_file so that it cannot signal
+  /// completion of the next evaluation writing the same file
+  static void clear_sentinel(const bfs::path& results_file);
+
+private:
+
+  //
+  //- Heading: Convenience functions
+  //
+
+  /// drain pending inotify events and flag the affected files
+  void process_events();
+  /// stat-based completion check for files not yet flagged ready
+  void poll_files();
+  /// block on the inotify descriptor for at most delay_ms milliseconds;
+  /// return true if events arrived
+  bool wait_for_events(int delay_ms);
+
+  /// add an inotify watch for dir (reference counted)
+  int add_watch(const String& dir);
+  /// release a reference to the inotify watch wd
+  void remove_watch(int wd);
+
+  /// the sentinel file signaling completion of results_file
+  static bfs::path sentinel_file(const bfs::path& results_file);
+
+  //
+  //- Heading: Data
+  //
+
+  /// state of a watched results file
+  struct WatchedFile {
+    /// full path of the results file
+    bfs::path resultsFile;
+    /// file name (without directory), as reported in inotify events
+    String fileName;
+    /// inotify watch descriptor of the parent directory (-1 if none)
+    int watchDesc = -1;
+    /// completion has been signaled and the file has not been read yet
+    bool ready = false;
+    /// the file has been observed by a previous poll
+    bool observed = false;
+    /// size at the previous poll
+    std::uintmax_t lastSize = 0;
+    /// modification time at the previous poll
+    std::time_t lastWriteTime = 0;
+  };
+
+  /// watched files keyed by evaluation id
+  std::map<int, WatchedFile> watchedFiles;
+  /// lookup from (watch descriptor, file name) to evaluation id
+  std::map<std::pair<int, String>, int> eventIndex;
+  /// watch descriptors keyed by directory
+  std::map<String, int> dirWatches;
+  /// number of watched files per watch descriptor
+  std::map<int, size_t> watchRefs;
+
+  /// inotify instance, or -1 when event detection is unavailable
+  int inotifyFd;
+  /// true once the current polling delay expired without events, which
+  /// triggers a stat-based sweep even in event-driven mode
+  bool pollDue;
+  /// current polling delay in milliseconds
+  int pollDelay;
+};
+
+
+inline bool ResultsFileWatcher::event_driven() const
+{ return inotifyFd >= 0; }
+
+} // namespace Dakota
+
+#endif
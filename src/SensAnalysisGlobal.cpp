@@ -13,6 +13,7 @@
 #include "dakota_linear_algebra.hpp"
 #include "dakota_data_util.hpp"
 #include "dakota_stat_util.hpp"
+#include "StreamingVBD.hpp"
 #include <algorithm>
 #include <boost/iterator/counting_iterator.hpp>
 #include "DataMethod.hpp" 
@@ -810,6 +811,8 @@ void SensAnalysisGlobal::compute_vbd_stats_via_sampling( const unsigned short
                                                        , const size_t           num_samples
                                                        , const RealMatrix &     vars_samples
                                                        , const IntResponseMap & resp_samples
+                                                       , const size_t           num_bootstrap
+                                                       , const int              bootstrap_seed
                                                        )
 {
 
@@ -827,6 +830,8 @@ void SensAnalysisGlobal::compute_vbd_stats_via_sampling( const unsigned short
                                            , num_vars
                                            , num_samples
                                            , resp_samples
+                                           , num_bootstrap
+                                           , bootstrap_seed
                                            );
   }
 }
@@ -835,6 +840,8 @@ void SensAnalysisGlobal::compute_pick_and_freeze_vbd_stats( const size_t
                                                           , const size_t           num_vars
                                                           , const size_t           num_samples
                                                           , const IntResponseMap & resp_samples
+                                                          , const size_t           num_bootstrap
+                                                          , const int              bootstrap_seed
                                                           )
 {
   if (resp_samples.size() != num_samples * (num_vars+2)) {
@@ -845,32 +852,6 @@ void SensAnalysisGlobal::compute_pick_and_freeze_vbd_stats( const size_t
     abort_handler(METHOD_ERROR);
   }
   
-  // BMA: for now copy the data to previous data structure 
-  //      total_fn_vals[respFn][replicate][sample]
-  // This is making the assumption that the responses are ordered as allSamples
-  // BMA TODO: compute statistics on finite samples only
-  boost::multi_array<Real,3> total_fn_vals(boost::extents[numFunctions][num_vars+2][num_samples]); // [k][i][j]
-  IntRespMCIter r_it = resp_samples.begin();
-  for (size_t i(0); i < (num_vars+2); ++i) {
-    for (size_t j(0); j < num_samples; ++r_it, ++j) {
-      for (size_t k(0); k < numFunctions; ++k) {
-        total_fn_vals[k][i][j] = r_it->second.function_value(k);
-      }
-    }
-  }
-
-#ifdef DEBUG
-  //Cout << "allSamples:\n" << allSamples << '\n';
-  for (size_t k(0); k < numFunctions; ++k) {
-    for (size_t i(0); i < num_vars+2; ++i) {
-      for (size_t j(0); j < num_samples; ++j) {
-        Cout << "Response " << k << " for replicate " << i << ", sample " << j
-             << ": " << total_fn_vals[k][i][j] << '\n';
-      }
-    }
-  }
-#endif
-
   // We compute variables indexSi and indexTi according to the following paper:
   // - A. Saltelli, P. Annoni, I. Azzini, F. Campolongo, M. Ratto, S. Tarantola,
   //   "Variance based sensitivity analysis of model output. Design and estimator
@@ -883,71 +864,22 @@ void SensAnalysisGlobal::compute_pick_and_freeze_vbd_stats( const size_t
   // - V. Weirs, J. Kamm, L. Swiler, S. Tarantola, M. Ratto, B. Adams, W. Rider,
   //   M. Eldred, "Sensitivity analysis techniques applied to a system of
   //   hyperbolic conservation laws", RESS, 107, pp. 157--170, Nov. 2012.
-
-  indexSi.resize(numFunctions, RealVector(num_vars));
-  indexTi.resize(numFunctions, RealVector(num_vars));
-
-  boost::multi_array<Real,3> total_norm_vals(boost::extents[numFunctions][num_vars+2][num_samples]); // [k][i][j]
-
-  Real dNumSamples( static_cast<Real>(num_samples) );
-
-  // Obtain sensitivity indices for each function
-  for (size_t k(0); k < numFunctions; ++k) {
-    Real mean_C(0.);
-    {
-      Real mean_hatY(0.);
-      for (size_t j(0); j < num_samples; ++j) {
-        mean_hatY += total_fn_vals[k][0][j];
-      }
-      mean_hatY /= dNumSamples;
-
-      Real mean_hatB(0.); 
-      for (size_t j(0); j < num_samples; ++j) {
-        mean_hatB += total_fn_vals[k][1][j];
-      }
-      mean_hatB /= dNumSamples;
-
-      Real overall_mean(0.);
-      for (size_t j(0); j < num_samples; ++j) {
-        for(size_t i(0); i < (num_vars+2); ++i) { 
-          total_norm_vals[k][i][j]  = total_fn_vals[k][i][j];
-          overall_mean             += total_norm_vals[k][i][j];
-        } 
-      }
-      overall_mean /= static_cast<Real>( num_samples * (num_vars+2) );
-      for (size_t j(0); j < num_samples; ++j) {
-        for(size_t i(0); i < (num_vars+2); ++i) {
-          total_norm_vals[k][i][j] -= overall_mean;
-        }
-      }
-
-      mean_C = (mean_hatB + mean_hatY) / 2.;
-    }
-
-    Real var_hatYC(0.);
-    for (size_t j(0); j < num_samples; ++j) {
-      var_hatYC += std::pow(total_fn_vals[k][0][j],2);
-    }
-    for (size_t j(0); j < num_samples; ++j) {
-      var_hatYC += std::pow(total_fn_vals[k][1][j],2);
-    }
-    var_hatYC = var_hatYC / (2. * dNumSamples)
-              - mean_C * mean_C;
-
-    // calculate first order sensitivity indices and first order total indices
-    for (size_t i(0); i < num_vars; ++i) {
-      Real sum_S(0.);
-      Real sum_T(0.);
-      for (size_t j(0); j < num_samples; ++j) {
-        Real diff(total_norm_vals[k][i+2][j] - total_norm_vals[k][1][j]);
-        sum_S += total_norm_vals[k][0][j] * diff;
-        sum_T += std::pow(diff, 2);
-      }
-
-      indexSi[k][i] = (sum_S /       dNumSamples ) / var_hatYC;
-      indexTi[k][i] = (sum_T / (2. * dNumSamples)) / var_hatYC;
-    }
-  } // for k
+  //
+  // The estimator sums are accumulated directly from (views of) the
+  // responses, which are assumed ordered as allSamples, without forming
+  // the numFunctions x (num_vars+2) x num_samples response tensor.
+  // BMA TODO: compute statistics on finite samples only
+  RealVectorArray fn_samples(resp_samples.size());
+  IntRespMCIter r_it = resp_samples.begin();
+  for (size_t i(0); i < fn_samples.size(); ++i, ++r_it)
+    fn_samples[i] = r_it->second.function_values_view();
+
+  StreamingVBD vbd;
+  vbd.initialize(numFunctions, num_vars, num_samples, num_bootstrap,
+		 bootstrap_seed);
+  vbd.update(fn_samples); // variables partitioned among threads
+  vbd.compute_indices(indexSi, indexTi);
+  vbd.compute_confidence_intervals(0.95, indexSiCI, indexTiCI);
 }
 
 void SensAnalysisGlobal::compute_binned_vbd_stats( const int              numBins
@@ -1033,6 +965,22 @@ void SensAnalysisGlobal::print_main_and_total_effects_indices( std::ostream
           << var_labels[i] << '\n';
       }
     }
+    if (k < indexSiCI.size() && indexSiCI[k].numCols()) {
+      const RealMatrix& si_ci = indexSiCI[k];
+      const RealMatrix& ti_ci = indexTiCI[k];
+      s << "  95% bootstrap confidence intervals:\n"
+        << std::setw(38) << "Main" << std::setw(40) << "Total\n";
+      for (size_t i(0); i < var_labels.size(); ++i) {
+        if (std::abs(indexSi[k][i]) > dropTol ||
+            std::abs(indexTi[k][i]) > dropTol) {
+          s << "                     [" << std::setw(write_precision+7)
+            << si_ci(0,i) << ", " << std::setw(write_precision+7) << si_ci(1,i)
+            << "] [" << std::setw(write_precision+7) << ti_ci(0,i) << ", "
+            << std::setw(write_precision+7) << ti_ci(1,i) << "] "
+            << var_labels[i] << '\n';
+        }
+      }
+    }
   }
 }
 
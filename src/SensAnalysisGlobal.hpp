@@ -86,7 +86,8 @@ public:
                                 StringArray var_labels,
 			        const StringArray& resp_labels) const;
 
-  /// compute VBD-based Sobol indices
+  /// compute VBD-based Sobol indices; for pick-and-freeze, 95%
+  /// confidence intervals are estimated from num_bootstrap resamples
   void compute_vbd_stats_via_sampling( const unsigned short   method
                                      , const int              numBins
                                      , const size_t           numFunctions
@@ -94,6 +95,8 @@ public:
                                      , const size_t           num_samples
                                      , const RealMatrix &     vars_samples
                                      , const IntResponseMap & resp_samples
+                                     , const size_t           num_bootstrap = 0
+                                     , const int              bootstrap_seed = 0
                                      );
 
   /// Printing of VBD results
@@ -197,6 +200,8 @@ private:
                                         , const size_t           num_vars
                                         , const size_t           num_samples
                                         , const IntResponseMap & resp_samples
+                                        , const size_t           num_bootstrap
+                                        , const int              bootstrap_seed
                                         );
 
   void compute_binned_vbd_stats( const int              numBins
@@ -294,6 +299,11 @@ protected:
 
   /// VBD total effect indices
   RealVectorArray indexTi;
+
+  /// bootstrap confidence intervals (lower, upper rows) for indexSi
+  RealMatrixArray indexSiCI;
+  /// bootstrap confidence intervals (lower, upper rows) for indexTi
+  RealMatrixArray indexTiCI;
 };
 
 
@@ -11,6 +11,7 @@
 #include "SimulationModel.hpp"
 #include "ProblemDescDB.hpp"
 #include "MarginalsCorrDistribution.hpp"
+#include <cmath>
 
 static const char rcsId[]="@(#) $Id: SimulationModel.cpp 6492 2009-12-19 00:04:28Z briadam $";
 
@@ -37,6 +38,10 @@ SimulationModel::SimulationModel(ProblemDescDB& problem_db):
   initialize_solution_recovery(
     probDescDB.get_string("model.simulation.cost_recovery_metadata"));
 
+  // evaluation times are measured only on request (see time_evaluations())
+  measuredCostSums.assign(solution_levels(), RealRealPair(0., 0.));
+  measuredCostCounts.assign(solution_levels(), SizetSizetPair(0, 0));
+
   // Error checks can encompass a model ensemble at a higher level
   //if (solnCntlCostMap.empty() && costMetadataIndex == _NPOS)
   //  Cerr << "Error: insufficient cost data provided." << std::endl;
@@ -412,6 +417,56 @@ RealVector SimulationModel::solution_level_costs() const
 }
 
 
+/** Levels without measured evaluations have zero cost. */
+RealVector SimulationModel::solution_level_measured_costs(bool cpu_time) const
+{
+  size_t i, num_lev = solution_levels(),
+    num_meas = std::min(num_lev, measuredCostSums.size());
+  RealVector cost_levels(num_lev); // init to 0
+  for (i=0; i<num_meas; ++i) {
+    size_t count = (cpu_time) ? measuredCostCounts[i].second
+                              : measuredCostCounts[i].first;
+    if (count)
+      cost_levels[i] = ( (cpu_time) ? measuredCostSums[i].second
+			 : measuredCostSums[i].first ) / (Real)count;
+  }
+  return cost_levels;
+}
+
+
+/** Evaluations that have returned from userDefinedInterface without a
+    timing (duplicates or remote evaluations) are dropped. */
+void SimulationModel::accumulate_measured_costs()
+{
+  IntRealRealPairMap& timings = userDefinedInterface.evaluation_timings();
+  std::map<int, size_t>::iterator l_it = measuredCostLevels.begin();
+  while (l_it != measuredCostLevels.end()) {
+    int iface_eval_id = l_it->first;
+    IntRealRealPairMap::iterator t_it = timings.find(iface_eval_id);
+    if (t_it != timings.end()) {
+      size_t lev = l_it->second;
+      if (lev >= measuredCostSums.size()) {
+	measuredCostSums.resize(lev+1, RealRealPair(0., 0.));
+	measuredCostCounts.resize(lev+1, SizetSizetPair(0, 0));
+      }
+      const RealRealPair& times = t_it->second;
+      measuredCostSums[lev].first += times.first;
+      ++measuredCostCounts[lev].first;
+      if (std::isfinite(times.second)) {
+	measuredCostSums[lev].second += times.second;
+	++measuredCostCounts[lev].second;
+      }
+      timings.erase(t_it);
+      measuredCostLevels.erase(l_it++);
+    }
+    else if (simIdMap.find(iface_eval_id) == simIdMap.end())
+      measuredCostLevels.erase(l_it++);
+    else
+      ++l_it;
+  }
+}
+
+
 Real SimulationModel::solution_level_cost() const
 {
   std::map<Real, size_t>::const_iterator cit = solnCntlCostMap.begin();
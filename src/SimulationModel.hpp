@@ -61,6 +61,10 @@ protected:
   void solution_level_cost_index(size_t cost_index);
   /// return active entry in solnCntlCostMap
   size_t solution_level_cost_index() const;
+  /// return averages of the measured evaluation times per solution level
+  RealVector solution_level_measured_costs(bool cpu_time = false) const;
+  /// activate or deactivate the timing of userDefinedInterface evaluations
+  void time_evaluations(bool flag);
 
   /// return solnCntlVarType
   short solution_control_variable_type() const;
@@ -179,6 +183,13 @@ private:
   /// solnCntlCostMap, and solnCntl{AV,ADV}Index
   void initialize_solution_recovery(const String& cost_label);
 
+  /// index of the active solution level for measured costs (0 without
+  /// solution control)
+  size_t measured_cost_level() const;
+  /// accumulate the measured times of evaluations in measuredCostLevels
+  /// that are available from userDefinedInterface
+  void accumulate_measured_costs();
+
   //
   //- Heading: Data members
   //
@@ -210,6 +221,15 @@ private:
   /// map of simulation-based responses returned by derived_synchronize()
   /// and derived_synchronize_nowait()
   IntResponseMap simResponseMap;
+
+  /// solution level indices of userDefinedInterface evaluations awaiting
+  /// their measured times
+  std::map<int, size_t> measuredCostLevels;
+  /// sums of measured wall clock and CPU seconds per solution level
+  RealRealPairArray measuredCostSums;
+  /// numbers of evaluations within measuredCostSums per solution level
+  /// (wall clock, CPU)
+  SizetSizetPairArray measuredCostCounts;
 };
 
 
@@ -246,6 +266,17 @@ inline size_t SimulationModel::cost_metadata_index() const
 { return costMetadataIndex; }
 
 
+inline void SimulationModel::time_evaluations(bool flag)
+{ userDefinedInterface.time_evaluations(flag); }
+
+
+inline size_t SimulationModel::measured_cost_level() const
+{
+  size_t cost_index = solution_level_cost_index();
+  return (cost_index == _NPOS) ? 0 : cost_index;
+}
+
+
 inline void SimulationModel::derived_evaluate(const ActiveSet& set)
 {
   // store/set/restore ParallelLibrary::currPCIter to simplify recursion
@@ -259,6 +290,12 @@ inline void SimulationModel::derived_evaluate(const ActiveSet& set)
           default_interface_active_set(), userDefinedInterface.analysis_components());
 
   userDefinedInterface.map(currentVariables, set, currentResponse);
+  // the time of a synchronous evaluation is available upon return from map()
+  if (userDefinedInterface.time_evaluations()) {
+    measuredCostLevels[userDefinedInterface.evaluation_id()]
+      = measured_cost_level();
+    accumulate_measured_costs();
+  }
 
   if(interfEvaluationsDBState == EvaluationsDBState::ACTIVE) {
     evaluationsDB.store_interface_variables(modelId, interface_id(),
@@ -291,6 +328,9 @@ inline void SimulationModel::derived_evaluate_nowait(const ActiveSet& set)
   // where multiple Models use the same Interface instance, for which this
   // Model instance will only match a subset of the Interface eval ids.
   simIdMap[userDefinedInterface.evaluation_id()] = simModelEvalCntr;
+  if (userDefinedInterface.time_evaluations())
+    measuredCostLevels[userDefinedInterface.evaluation_id()]
+      = measured_cost_level();
 }
 
 
@@ -303,6 +343,7 @@ inline const IntResponseMap& SimulationModel::derived_synchronize()
   // Any responses from userDefinedInterface.synchronize() that are unmatched
   // in simIdMap are cached in Interface::cachedResponseMap
   rekey_synch(userDefinedInterface, true, simIdMap, simResponseMap);
+  if (!measuredCostLevels.empty()) accumulate_measured_costs();
   // Caching for Models must also occur at the base class level
   // (Model::cachedResponseMap) since deriv estimation-based rekeying is
   // performed as this top level (and any lower level mappings are erased
@@ -321,6 +362,7 @@ inline const IntResponseMap& SimulationModel::derived_synchronize_nowait()
 
   // See comments above regarding levels of rekeying / caching
   rekey_synch(userDefinedInterface, false, simIdMap, simResponseMap);
+  if (!measuredCostLevels.empty()) accumulate_measured_costs();
 
   parallelLib.parallel_configuration_iterator(curr_pc_iter); // restore
   return simResponseMap;
@@ -0,0 +1,306 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "SpatialIndex.hpp"
+#include <algorithm>
+#include <cfloat>
+
+namespace Dakota {
+
+/// maximum number of (non-coincident) points in a leaf
+static const size_t SPATIAL_INDEX_LEAF_SIZE = 16;
+
+
+SpatialIndex::SpatialIndex(): numDims(0), normType(L2_NORM)
+{ }
+
+
+SpatialIndex::~SpatialIndex()
+{ }
+
+
+void SpatialIndex::
+initialize(size_t num_dims, size_t capacity, NormType norm)
+{
+  numDims = num_dims; normType = norm;
+  pointCoords.assign(numDims, RealArray());
+  for (size_t d=0; d<numDims; ++d)
+    pointCoords[d].reserve(capacity);
+
+  treeNodes.assign(1, Node());
+  treeNodes[0].children[0] = treeNodes[0].children[1] = 0;
+  // an empty box, at infinite distance from any point
+  boxLower.assign(numDims, DBL_MAX); boxUpper.assign(numDims, -DBL_MAX);
+  nodeCentroids.assign(numDims, 0.);
+}
+
+
+size_t SpatialIndex::insert(const Real* x)
+{
+  size_t d, index = size(), node = 0;
+  for (d=0; d<numDims; ++d)
+    pointCoords[d].push_back(x[d]);
+
+  // descend to a leaf, growing the boxes and updating the centroids
+  // (Welford) along the way
+  while (true) {
+    Node& n = treeNodes[node];
+    Real *lower = &boxLower[node * numDims], *upper = &boxUpper[node * numDims],
+      *centroid = &nodeCentroids[node * numDims], count = (Real)++n.numPoints;
+    for (d=0; d<numDims; ++d) {
+      if (x[d] < lower[d]) lower[d] = x[d];
+      if (x[d] > upper[d]) upper[d] = x[d];
+      Real delta = x[d] - centroid[d];
+      centroid[d] += delta / count;
+      n.scatter += delta * (x[d] - centroid[d]);
+    }
+    if (!n.children[0]) break;
+    node = n.children[(x[n.splitDim] < n.splitValue) ? 0 : 1];
+  }
+
+  treeNodes[node].points.push_back(index);
+  if (treeNodes[node].points.size() > SPATIAL_INDEX_LEAF_SIZE)
+    split(node);
+  return index;
+}
+
+
+void SpatialIndex::split(size_t node)
+{
+  // split along the widest extent of the leaf
+  const Real *lower = &boxLower[node * numDims],
+    *upper = &boxUpper[node * numDims];
+  size_t d, split_dim = 0;
+  Real width = -1.;
+  for (d=0; d<numDims; ++d)
+    if (upper[d] - lower[d] > width)
+      { width = upper[d] - lower[d]; split_dim = d; }
+  if (width <= 0.) return; // coincident points: leave the leaf oversized
+
+  const SizetArray& points = treeNodes[node].points;
+  const RealArray& coords = pointCoords[split_dim];
+  size_t i, num_pts = points.size();
+  RealArray values(num_pts);
+  for (i=0; i<num_pts; ++i)
+    values[i] = coords[points[i]];
+  std::nth_element(values.begin(), values.begin() + num_pts/2, values.end());
+  Real split_value = values[num_pts/2];
+  // with repeated values, the median may equal the minimum, leaving the
+  // lower child empty; the maximum then separates at least one point
+  if (split_value <= lower[split_dim])
+    split_value = upper[split_dim];
+
+  size_t left = treeNodes.size(), right = left + 1;
+  treeNodes.resize(left + 2);
+  boxLower.resize((left + 2) * numDims); boxUpper.resize((left + 2) * numDims);
+  nodeCentroids.resize((left + 2) * numDims);
+  Node& n = treeNodes[node];
+  for (i=0; i<num_pts; ++i) {
+    size_t p = n.points[i];
+    treeNodes[(coords[p] < split_value) ? left : right].points.push_back(p);
+  }
+  for (i=left; i<=right; ++i) {
+    treeNodes[i].children[0] = treeNodes[i].children[1] = 0;
+    fit_node(i);
+  }
+  n.splitDim = split_dim; n.splitValue = split_value;
+  n.children[0] = left;   n.children[1] = right;
+  SizetArray().swap(n.points);
+}
+
+
+void SpatialIndex::fit_node(size_t node)
+{
+  Real *lower = &boxLower[node * numDims], *upper = &boxUpper[node * numDims],
+    *centroid = &nodeCentroids[node * numDims];
+  std::fill(lower, lower + numDims,  DBL_MAX);
+  std::fill(upper, upper + numDims, -DBL_MAX);
+  Node& n = treeNodes[node];
+  const SizetArray& points = n.points;
+  size_t i, num_pts = points.size();
+  n.numPoints = num_pts; n.scatter = 0.;
+  for (size_t d=0; d<numDims; ++d) {
+    const RealArray& coords = pointCoords[d];
+    Real sum = 0.;
+    for (i=0; i<num_pts; ++i) {
+      Real c = coords[points[i]];
+      if (c < lower[d]) lower[d] = c;
+      if (c > upper[d]) upper[d] = c;
+      sum += c;
+    }
+    centroid[d] = sum / (Real)num_pts;
+    for (i=0; i<num_pts; ++i) {
+      Real dc = coords[points[i]] - centroid[d];
+      n.scatter += dc * dc;
+    }
+  }
+}
+
+
+Real SpatialIndex::
+box_distance(size_t node, const Real* x, size_t skip_dim) const
+{
+  const Real *lower = &boxLower[node * numDims],
+    *upper = &boxUpper[node * numDims];
+  Real dist = 0.;
+  for (size_t d=0; d<numDims; ++d) {
+    if (d == skip_dim) continue;
+    Real dx = (x[d] < lower[d]) ? lower[d] - x[d] :
+      ( (x[d] > upper[d]) ? x[d] - upper[d] : 0. );
+    if (normType == LINF_NORM)
+      { if (dx > dist) dist = dx; }
+    else
+      dist += dx * dx;
+  }
+  return dist;
+}
+
+
+void SpatialIndex::
+node_measures(size_t node, const Real* x, Real& min_measure,
+	      Real& max_measure) const
+{
+  const Real *lower = &boxLower[node * numDims],
+    *upper = &boxUpper[node * numDims];
+  min_measure = max_measure = 0.;
+  for (size_t d=0; d<numDims; ++d) {
+    Real dx_min = (x[d] < lower[d]) ? lower[d] - x[d] :
+      ( (x[d] > upper[d]) ? x[d] - upper[d] : 0. ),
+      dx_max = std::max(std::abs(x[d] - lower[d]), std::abs(x[d] - upper[d]));
+    if (normType == LINF_NORM) {
+      if (dx_min > min_measure) min_measure = dx_min;
+      if (dx_max > max_measure) max_measure = dx_max;
+    }
+    else
+      { min_measure += dx_min * dx_min; max_measure += dx_max * dx_max; }
+  }
+}
+
+
+void SpatialIndex::
+ball_query(const Real* x, Real radius, SizetArray& indices,
+	   size_t skip_dim) const
+{
+  indices.clear();
+  if (!size()) return;
+
+  Real max_measure = (normType == LINF_NORM) ? radius : radius * radius;
+  SizetArray stack(1, 0);
+  while (!stack.empty()) {
+    size_t node = stack.back(); stack.pop_back();
+    if (box_distance(node, x, skip_dim) > max_measure)
+      continue;
+    const Node& n = treeNodes[node];
+    if (n.children[0])
+      { stack.push_back(n.children[0]); stack.push_back(n.children[1]); }
+    else
+      for (size_t i=0; i<n.points.size(); ++i) {
+	size_t p = n.points[i];
+	if (point_distance(p, x, skip_dim) <= max_measure)
+	  indices.push_back(p);
+      }
+  }
+  std::sort(indices.begin(), indices.end());
+}
+
+
+size_t SpatialIndex::nearest(const Real* x) const
+{
+  size_t best = _NPOS;
+  if (!size()) return best;
+
+  // depth-first, nearer child first; boxes farther than the incumbent
+  // are pruned, but equidistant ones are not, to resolve ties by index
+  Real best_dist = DBL_MAX;
+  SizetArray stack(1, 0);
+  while (!stack.empty()) {
+    size_t node = stack.back(); stack.pop_back();
+    if (box_distance(node, x, _NPOS) > best_dist)
+      continue;
+    const Node& n = treeNodes[node];
+    if (n.children[0]) {
+      bool lower_first = (x[n.splitDim] < n.splitValue);
+      stack.push_back(n.children[lower_first ? 1 : 0]);
+      stack.push_back(n.children[lower_first ? 0 : 1]);
+    }
+    else
+      for (size_t i=0; i<n.points.size(); ++i) {
+	size_t p = n.points[i];
+	Real dist = point_distance(p, x, _NPOS);
+	if (dist < best_dist || (dist == best_dist && p < best))
+	  { best_dist = dist; best = p; }
+      }
+  }
+  return best;
+}
+
+
+void SpatialIndex::
+k_nearest(const Real* x, size_t k, QueryBuffer& buffer) const
+{
+  // max-heap of the best k (measure, index) pairs found so far, so that
+  // ties in measure are resolved by index
+  std::vector<std::pair<Real, size_t> >& heap = buffer.neighbors;
+  heap.clear();
+  k = std::min(k, size());
+  if (!k) return;
+
+  SizetArray& stack = buffer.nodeStack;
+  stack.assign(1, 0);
+  while (!stack.empty()) {
+    size_t node = stack.back(); stack.pop_back();
+    if (heap.size() == k && box_distance(node, x, _NPOS) > heap.front().first)
+      continue;
+    const Node& n = treeNodes[node];
+    if (n.children[0]) {
+      bool lower_first = (x[n.splitDim] < n.splitValue);
+      stack.push_back(n.children[lower_first ? 1 : 0]);
+      stack.push_back(n.children[lower_first ? 0 : 1]);
+    }
+    else
+      for (size_t i=0; i<n.points.size(); ++i) {
+	std::pair<Real, size_t> cand(point_distance(n.points[i], x, _NPOS),
+				     n.points[i]);
+	if (heap.size() < k)
+	  { heap.push_back(cand); std::push_heap(heap.begin(), heap.end()); }
+	else if (cand < heap.front()) {
+	  std::pop_heap(heap.begin(), heap.end());
+	  heap.back() = cand;
+	  std::push_heap(heap.begin(), heap.end());
+	}
+      }
+  }
+  std::sort_heap(heap.begin(), heap.end());
+}
+
+
+size_t SpatialIndex::
+count_within(const Real* x, Real max_measure, QueryBuffer& buffer) const
+{
+  size_t count = 0;
+  if (!size()) return count;
+
+  SizetArray& stack = buffer.nodeStack;
+  stack.assign(1, 0);
+  while (!stack.empty()) {
+    size_t node = stack.back(); stack.pop_back();
+    if (box_distance(node, x, _NPOS) > max_measure)
+      continue;
+    const Node& n = treeNodes[node];
+    if (n.children[0])
+      { stack.push_back(n.children[0]); stack.push_back(n.children[1]); }
+    else
+      for (size_t i=0; i<n.points.size(); ++i)
+	if (point_distance(n.points[i], x, _NPOS) <= max_measure)
+	  ++count;
+  }
+  return count;
+}
+
+} // namespace Dakota
@@ -0,0 +1,213 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#ifndef SPATIAL_INDEX_H
+#define SPATIAL_INDEX_H
+
+#include "dakota_data_types.hpp"
+#include "dakota_global_defs.hpp"
+#include <cmath>
+
+
+namespace Dakota {
+
+
+/// Incrementally constructed k-d tree for proximity queries on points
+
+/** Points are numbered in order of insertion and their coordinates are
+    stored by dimension, in one contiguous array per coordinate.  Leaves
+    hold a bounded number of points and are split at the median of
+    their widest coordinate when they overflow, so that points may be
+    inserted one at a time (e.g., as darts are accepted) without
+    rebuilding the tree.  Each node records the bounding box of its
+    points, which prunes the fixed-radius and nearest neighbor queries
+    to the nodes that can contain a result.
+
+    Distances are Euclidean or Chebyshev (max norm).  As in ANN, the
+    k-nearest neighbor and range counting queries work in terms of a
+    distance measure that is the squared distance for the Euclidean norm
+    and the distance itself for the max norm.  These queries are const
+    and keep their working storage in a caller-supplied QueryBuffer, so
+    that threads may query a shared index concurrently. */
+
+class SpatialIndex
+{
+public:
+
+  /// norm defining the distance between points
+  enum NormType { L2_NORM, LINF_NORM };
+
+  /// per-thread working storage for queries
+  struct QueryBuffer {
+    /// nodes pending a visit
+    SizetArray nodeStack;
+    /// (distance measure, index) of the neighbors found by k_nearest()
+    std::vector<std::pair<Real, size_t> > neighbors;
+  };
+
+  SpatialIndex();  ///< constructor
+  ~SpatialIndex(); ///< destructor
+
+  /// discard all points and set the dimension and norm, reserving
+  /// storage for capacity points
+  void initialize(size_t num_dims, size_t capacity = 0,
+		  NormType norm = L2_NORM);
+  /// add a point, returning its index
+  size_t insert(const Real* x);
+
+  /// number of points
+  size_t size() const;
+  /// number of coordinates per point
+  size_t dimension() const;
+  /// coordinate d of point i
+  Real coordinate(size_t i, size_t d) const;
+  /// squared distance between point i and x
+  Real distance_squared(size_t i, const Real* x) const;
+
+  /// indices, in ascending order, of the points within distance radius
+  /// of x (inclusive); if skip_dim is a valid dimension, that coordinate
+  /// is ignored, giving the points within radius of the line through x
+  /// parallel to axis skip_dim
+  void ball_query(const Real* x, Real radius, SizetArray& indices,
+		  size_t skip_dim = _NPOS) const;
+  /// index of the point nearest to x (the lowest index among equidistant
+  /// points), or _NPOS if there are no points
+  size_t nearest(const Real* x) const;
+
+  /// distance measure between point i and x
+  Real distance_measure(size_t i, const Real* x) const;
+  /// the min(k, size()) points nearest to x, in buffer.neighbors in
+  /// ascending order of distance measure (and of index among ties)
+  void k_nearest(const Real* x, size_t k, QueryBuffer& buffer) const;
+  /// number of points with distance measure from x at most max_measure
+  size_t count_within(const Real* x, Real max_measure,
+		      QueryBuffer& buffer) const;
+
+  /// number of points in the subtree of node, the root being node 0
+  size_t node_size(size_t node) const;
+  /// set the children of node and return true if it is not a leaf
+  bool node_children(size_t node, size_t& lower, size_t& upper) const;
+  /// points of a leaf node
+  const SizetArray& node_points(size_t node) const;
+  /// centroid of the points in the subtree of node
+  const Real* node_centroid(size_t node) const;
+  /// sum of the squared distances of the points in the subtree of node
+  /// from their centroid
+  Real node_scatter(size_t node) const;
+  /// minimum and maximum distance measures from x to the bounding box
+  /// of node
+  void node_measures(size_t node, const Real* x, Real& min_measure,
+		     Real& max_measure) const;
+
+private:
+
+  /// tree node: a leaf if children[0] is 0 (the root is never a child)
+  struct Node {
+    size_t splitDim;     ///< coordinate compared at an interior node
+    Real splitValue;     ///< points with smaller coordinate go to children[0]
+    size_t children[2];  ///< interior node children
+    SizetArray points;   ///< leaf points
+    size_t numPoints;    ///< number of points in the subtree
+    Real scatter;        ///< squared distances of the points from centroid
+  };
+
+  /// split leaf node in two if its points are not coincident
+  void split(size_t node);
+  /// set the bounding box, size, centroid and scatter of node from its
+  /// (leaf) points
+  void fit_node(size_t node);
+  /// distance measure from x to the bounding box of node, ignoring
+  /// coordinate skip_dim
+  Real box_distance(size_t node, const Real* x, size_t skip_dim) const;
+  /// distance measure from x to point i, ignoring coordinate skip_dim
+  Real point_distance(size_t i, const Real* x, size_t skip_dim) const;
+
+  /// number of coordinates per point
+  size_t numDims;
+  /// norm defining the distance between points
+  NormType normType;
+  /// point coordinates, one array per dimension
+  std::vector<RealArray> pointCoords;
+  /// tree nodes; the root is treeNodes[0]
+  std::vector<Node> treeNodes;
+  /// lower and upper bounds of the points of each node, numDims per node
+  RealArray boxLower, boxUpper;
+  /// centroids of the points of each node, numDims per node
+  RealArray nodeCentroids;
+};
+
+
+inline size_t SpatialIndex::size() const
+{ return (numDims) ? pointCoords[0].size() : 0; }
+
+
+inline size_t SpatialIndex::dimension() const
+{ return numDims; }
+
+
+inline Real SpatialIndex::coordinate(size_t i, size_t d) const
+{ return pointCoords[d][i]; }
+
+
+inline Real SpatialIndex::distance_squared(size_t i, const Real* x) const
+{
+  Real dist_sq = 0.;
+  for (size_t d=0; d<numDims; ++d)
+    { Real dx = x[d] - pointCoords[d][i]; dist_sq += dx * dx; }
+  return dist_sq;
+}
+
+
+inline Real SpatialIndex::
+point_distance(size_t i, const Real* x, size_t skip_dim) const
+{
+  Real dist = 0.;
+  for (size_t d=0; d<numDims; ++d)
+    if (d != skip_dim) {
+      Real dx = x[d] - pointCoords[d][i];
+      if (normType == LINF_NORM)
+	{ dx = std::abs(dx); if (dx > dist) dist = dx; }
+      else
+	dist += dx * dx;
+    }
+  return dist;
+}
+
+
+inline Real SpatialIndex::distance_measure(size_t i, const Real* x) const
+{ return point_distance(i, x, _NPOS); }
+
+
+inline size_t SpatialIndex::node_size(size_t node) const
+{ return treeNodes[node].numPoints; }
+
+
+inline bool SpatialIndex::
+node_children(size_t node, size_t& lower, size_t& upper) const
+{
+  const Node& n = treeNodes[node];
+  lower = n.children[0]; upper = n.children[1];
+  return (n.children[0] != 0);
+}
+
+
+inline const SizetArray& SpatialIndex::node_points(size_t node) const
+{ return treeNodes[node].points; }
+
+
+inline const Real* SpatialIndex::node_centroid(size_t node) const
+{ return &nodeCentroids[node * numDims]; }
+
+
+inline Real SpatialIndex::node_scatter(size_t node) const
+{ return treeNodes[node].scatter; }
+
+} // namespace Dakota
+
+#endif
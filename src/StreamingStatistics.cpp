@@ -0,0 +1,496 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "StreamingStatistics.hpp"
+#include "dakota_global_defs.hpp"
+#include "util_threads.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <thread>
+
+namespace Dakota {
+
+/// minimum number of samples (QoIs times evaluations) for which a
+/// batch update is divided among threads
+static const size_t STREAMING_STATS_THREAD_WORK = 100000;
+
+/// message tag for the partial statistics exchanged in reduce()
+static const int STREAMING_STATS_REDUCE_TAG = 1001;
+
+
+StreamingMoments::StreamingMoments()
+{ reset(); }
+
+
+StreamingMoments::~StreamingMoments()
+{ }
+
+
+void StreamingMoments::reset()
+{
+  numSamples = 0;
+  sampleMean = centralSum2 = centralSum3 = centralSum4 = 0.;
+}
+
+
+void StreamingMoments::add(Real sample)
+{
+  Real n1 = (Real)numSamples, n = n1 + 1.;
+  Real delta = sample - sampleMean, delta_n = delta / n,
+    delta_n2 = delta_n * delta_n, term1 = delta * delta_n * n1;
+  sampleMean  += delta_n;
+  centralSum4 += term1 * delta_n2 * (n*n - 3.*n + 3.)
+    + 6. * delta_n2 * centralSum2 - 4. * delta_n * centralSum3;
+  centralSum3 += term1 * delta_n * (n - 2.) - 3. * delta_n * centralSum2;
+  centralSum2 += term1;
+  ++numSamples;
+}
+
+
+void StreamingMoments::merge(const StreamingMoments& other)
+{
+  if (!other.numSamples)
+    return;
+  if (!numSamples)
+    { *this = other; return; }
+
+  Real na = (Real)numSamples, nb = (Real)other.numSamples, n = na + nb,
+    delta = other.sampleMean - sampleMean, delta2 = delta * delta,
+    nanb = na * nb;
+  Real cs2 = centralSum2 + other.centralSum2 + delta2 * nanb / n;
+  Real cs3 = centralSum3 + other.centralSum3
+    + delta * delta2 * nanb * (na - nb) / (n * n)
+    + 3. * delta * (na * other.centralSum2 - nb * centralSum2) / n;
+  Real cs4 = centralSum4 + other.centralSum4
+    + delta2 * delta2 * nanb * (na*na - nanb + nb*nb) / (n * n * n)
+    + 6. * delta2 * (na*na * other.centralSum2 + nb*nb * centralSum2) / (n*n)
+    + 4. * delta * (na * other.centralSum3 - nb * centralSum3) / n;
+
+  sampleMean += delta * nb / n;
+  centralSum2 = cs2; centralSum3 = cs3; centralSum4 = cs4;
+  numSamples += other.numSamples;
+}
+
+
+void StreamingMoments::moments(bool central, Real* moments) const
+{
+  if (!numSamples) {
+    for (size_t i=0; i<4; ++i)
+      moments[i] = std::numeric_limits<Real>::quiet_NaN();
+    return;
+  }
+
+  Real ns = (Real)numSamples, nm1 = ns - 1., nm2 = ns - 2., nm3 = ns - 3.;
+  bool pos_var = (centralSum2 > 0.);
+  moments[0] = sampleMean;
+  if (central)      moments[1] = centralSum2 / nm1;
+  else if (pos_var) moments[1] = std::sqrt(centralSum2 / nm1);
+  else              moments[1] = 0.;
+
+  if (pos_var && numSamples > 2)
+    moments[2] = (central) ? centralSum3 * ns / (nm1 * nm2) :
+      centralSum3 * ns * std::sqrt(nm1) / (nm2 * std::pow(centralSum2, 1.5));
+  else
+    moments[2] = 0.;
+
+  if (pos_var && numSamples > 3)
+    moments[3] = (central) ?
+      ( (ns*ns - 2.*ns + 3.) * centralSum4
+	- 3. * (2.*ns - 3.) * centralSum2 * centralSum2 / ns )
+      / (nm1 * nm2 * nm3) :
+      nm1 / (nm2 * nm3) * ( (ns + 1.) * ns * centralSum4
+			    / (centralSum2 * centralSum2) - 3. * nm1 );
+  else
+    moments[3] = 0.;
+}
+
+
+void StreamingMoments::pack(MPIPackBuffer& send_buff) const
+{
+  send_buff << numSamples << sampleMean << centralSum2 << centralSum3
+	    << centralSum4;
+}
+
+
+void StreamingMoments::unpack(MPIUnpackBuffer& recv_buff)
+{
+  recv_buff >> numSamples >> sampleMean >> centralSum2 >> centralSum3
+	    >> centralSum4;
+}
+
+
+QuantileSketch::QuantileSketch(size_t capacity):
+  levelCapacity(std::max(capacity, (size_t)2)), totalCount(0)
+{ }
+
+
+QuantileSketch::~QuantileSketch()
+{ }
+
+
+void QuantileSketch::capacity(size_t cap)
+{ levelCapacity = std::max(cap, (size_t)2); }
+
+
+void QuantileSketch::reset()
+{
+  totalCount = 0;
+  levelSamples.clear(); compactOffset.clear();
+  sortedSamples.clear(); cumulativeWeights.clear();
+}
+
+
+void QuantileSketch::add(Real sample)
+{
+  if (levelSamples.empty())
+    { levelSamples.resize(1); compactOffset.assign(1, 0); }
+  levelSamples[0].push_back(sample);
+  ++totalCount;
+  if (levelSamples[0].size() > levelCapacity)
+    compact(0);
+}
+
+
+/** Pairs of adjacent sorted samples at level are replaced by one of
+    the two at level+1, preserving the total weight; for an odd count,
+    the largest sample remains at level. */
+void QuantileSketch::compact(size_t level)
+{
+  if (level + 1 == levelSamples.size())
+    { levelSamples.resize(level + 2); compactOffset.push_back(0); }
+
+  RealArray& samples = levelSamples[level];
+  std::sort(samples.begin(), samples.end());
+  size_t i, num_pairs = samples.size() / 2;
+  unsigned char& offset = compactOffset[level];
+  RealArray& promoted = levelSamples[level + 1];
+  for (i=0; i<num_pairs; ++i)
+    promoted.push_back(samples[2*i + offset]);
+  offset ^= 1;
+  if (samples.size() % 2)
+    { Real last = samples.back(); samples.clear(); samples.push_back(last); }
+  else
+    samples.clear();
+
+  if (promoted.size() > levelCapacity)
+    compact(level + 1);
+}
+
+
+void QuantileSketch::merge(const QuantileSketch& other)
+{
+  size_t h, num_levels = other.levelSamples.size();
+  if (levelSamples.size() < num_levels) {
+    levelSamples.resize(num_levels);
+    compactOffset.resize(num_levels, 0);
+  }
+  for (h=0; h<num_levels; ++h)
+    levelSamples[h].insert(levelSamples[h].end(),
+			   other.levelSamples[h].begin(),
+			   other.levelSamples[h].end());
+  totalCount += other.totalCount;
+  for (h=0; h<levelSamples.size(); ++h)
+    if (levelSamples[h].size() > levelCapacity)
+      compact(h);
+}
+
+
+void QuantileSketch::finalize()
+{
+  sortedSamples.clear(); cumulativeWeights.clear();
+  if (exact()) {
+    if (!levelSamples.empty())
+      sortedSamples = levelSamples[0];
+    std::sort(sortedSamples.begin(), sortedSamples.end());
+    return;
+  }
+
+  std::vector<std::pair<Real, size_t> > weighted;
+  for (size_t h=0; h<levelSamples.size(); ++h)
+    for (size_t i=0; i<levelSamples[h].size(); ++i)
+      weighted.push_back(std::make_pair(levelSamples[h][i], (size_t)1 << h));
+  std::sort(weighted.begin(), weighted.end());
+  size_t i, num_weighted = weighted.size(), cum_wt = 0;
+  sortedSamples.resize(num_weighted); cumulativeWeights.resize(num_weighted);
+  for (i=0; i<num_weighted; ++i) {
+    sortedSamples[i] = weighted[i].first;
+    cumulativeWeights[i] = cum_wt += weighted[i].second;
+  }
+}
+
+
+Real QuantileSketch::ranked_value(size_t r) const
+{
+  if (sortedSamples.empty())
+    return std::numeric_limits<Real>::quiet_NaN();
+  if (cumulativeWeights.empty()) // exact
+    return sortedSamples[std::min(r, sortedSamples.size() - 1)];
+  // first retained sample whose cumulative weight exceeds r
+  size_t index = std::upper_bound(cumulativeWeights.begin(),
+				  cumulativeWeights.end(), r)
+    - cumulativeWeights.begin();
+  return sortedSamples[std::min(index, sortedSamples.size() - 1)];
+}
+
+
+void QuantileSketch::pack(MPIPackBuffer& send_buff) const
+{
+  size_t h, i, num_levels = levelSamples.size();
+  send_buff << levelCapacity << totalCount << num_levels;
+  for (h=0; h<num_levels; ++h) {
+    const RealArray& samples = levelSamples[h];
+    size_t num_samples = samples.size();
+    send_buff << compactOffset[h] << num_samples;
+    for (i=0; i<num_samples; ++i)
+      send_buff << samples[i];
+  }
+}
+
+
+void QuantileSketch::unpack(MPIUnpackBuffer& recv_buff)
+{
+  size_t h, i, num_levels, num_samples;
+  recv_buff >> levelCapacity >> totalCount >> num_levels;
+  levelSamples.resize(num_levels); compactOffset.resize(num_levels);
+  for (h=0; h<num_levels; ++h) {
+    recv_buff >> compactOffset[h] >> num_samples;
+    RealArray& samples = levelSamples[h];
+    samples.resize(num_samples);
+    for (i=0; i<num_samples; ++i)
+      recv_buff >> samples[i];
+  }
+  sortedSamples.clear(); cumulativeWeights.clear();
+}
+
+
+StreamingStatistics::StreamingStatistics(): numObservations(0)
+{ }
+
+
+StreamingStatistics::~StreamingStatistics()
+{ }
+
+
+void StreamingStatistics::
+initialize(size_t num_qoi, const RealVectorArray& resp_levels,
+	   const BitArray& track_quantiles, size_t sketch_capacity)
+{
+  qoiMoments.assign(num_qoi, StreamingMoments());
+  qoiQuantiles.assign(num_qoi, QuantileSketch(sketch_capacity));
+  trackQuantiles = track_quantiles;
+  trackQuantiles.resize(num_qoi, false);
+  respLevels.assign(num_qoi, RealArray());
+  ascendingLevels.assign(num_qoi, true);
+  for (size_t q=0; q<num_qoi && q<resp_levels.size(); ++q) {
+    const RealVector& levels_q = resp_levels[q];
+    respLevels[q].assign(levels_q.values(), levels_q.values() +
+			 levels_q.length());
+    ascendingLevels[q]
+      = std::is_sorted(respLevels[q].begin(), respLevels[q].end());
+  }
+  reset();
+}
+
+
+void StreamingStatistics::reset()
+{
+  size_t q, num_qoi = qoiMoments.size();
+  numObservations = 0;
+  qoiMin.assign(num_qoi, DBL_MAX);
+  qoiMax.assign(num_qoi, -DBL_MAX);
+  levelCounts.resize(num_qoi);
+  for (q=0; q<num_qoi; ++q) {
+    qoiMoments[q].reset();
+    qoiQuantiles[q].reset();
+    levelCounts[q].assign(respLevels[q].empty() ? 0 :
+			  respLevels[q].size() + 1, 0);
+  }
+}
+
+
+void StreamingStatistics::update(size_t q, Real sample)
+{
+  if (!std::isfinite(sample)) // neither NaN nor +/-Inf
+    return;
+  qoiMoments[q].add(sample);
+  if (sample < qoiMin[q]) qoiMin[q] = sample;
+  if (sample > qoiMax[q]) qoiMax[q] = sample;
+  const RealArray& levels_q = respLevels[q];
+  if (!levels_q.empty()) { // first level >= sample: cumulative p(g <= z)
+    size_t l, num_lev = levels_q.size();
+    if (ascendingLevels[q])
+      l = std::lower_bound(levels_q.begin(), levels_q.end(), sample)
+	- levels_q.begin();
+    else
+      for (l=0; l<num_lev && sample > levels_q[l]; ++l) ;
+    ++levelCounts[q][l];
+  }
+  if (trackQuantiles[q])
+    qoiQuantiles[q].add(sample);
+}
+
+
+void StreamingStatistics::update(const RealVector& fn_vals)
+{
+  size_t q, num_qoi = qoiMoments.size();
+  for (q=0; q<num_qoi; ++q)
+    update(q, fn_vals[q]);
+  ++numObservations;
+}
+
+
+/** Each thread accumulates all samples for a contiguous range of
+    QoIs, so that the result is independent of the number of threads. */
+void StreamingStatistics::
+update(const RealVectorArray& fn_samples, size_t num_threads)
+{
+  size_t num_obs = fn_samples.size(), num_qoi = qoiMoments.size();
+  num_threads = (num_obs * num_qoi < STREAMING_STATS_THREAD_WORK) ? 1 :
+    dakota::util::num_threads(num_threads, num_qoi);
+
+  auto update_range = [&](size_t q_start, size_t q_end) {
+    for (size_t s=0; s<num_obs; ++s) {
+      const Real* fn_vals = fn_samples[s].values();
+      for (size_t q=q_start; q<q_end; ++q)
+	update(q, fn_vals[q]);
+    }
+  };
+
+  if (num_threads <= 1)
+    update_range(0, num_qoi);
+  else {
+    std::vector<std::thread> threads;
+    std::vector<std::exception_ptr> failures(num_threads);
+    size_t t, q_per_thread = num_qoi / num_threads,
+      q_remainder = num_qoi % num_threads, q_start = 0;
+    for (t=0; t<num_threads; ++t) {
+      size_t q_end = q_start + q_per_thread + (t < q_remainder ? 1 : 0);
+      threads.emplace_back([&, t, q_start, q_end]() {
+	try { update_range(q_start, q_end); }
+	catch (...) { failures[t] = std::current_exception(); }
+      });
+      q_start = q_end;
+    }
+    for (std::thread& th : threads)
+      th.join();
+    for (t=0; t<num_threads; ++t)
+      if (failures[t])
+	std::rethrow_exception(failures[t]);
+  }
+  numObservations += num_obs;
+}
+
+
+void StreamingStatistics::merge(const StreamingStatistics& other)
+{
+  size_t q, l, num_qoi = qoiMoments.size();
+  for (q=0; q<num_qoi; ++q) {
+    qoiMoments[q].merge(other.qoiMoments[q]);
+    qoiMin[q] = std::min(qoiMin[q], other.qoiMin[q]);
+    qoiMax[q] = std::max(qoiMax[q], other.qoiMax[q]);
+    SizetArray& counts_q = levelCounts[q];
+    for (l=0; l<counts_q.size(); ++l)
+      counts_q[l] += other.levelCounts[q][l];
+    if (trackQuantiles[q])
+      qoiQuantiles[q].merge(other.qoiQuantiles[q]);
+  }
+  numObservations += other.numObservations;
+}
+
+
+/** Binomial tree reduction: at each step, ranks (relative to root) at
+    odd multiples of the stride send their packed partial statistics to
+    the rank one stride below and drop out, while the receivers merge.
+    The merge order, and hence the result, depends only on the number
+    of ranks.  Message lengths vary with the quantile sketches, so each
+    receive is sized by probing. */
+void StreamingStatistics::reduce(MPI_Comm comm, int root)
+{
+#ifdef DAKOTA_HAVE_MPI
+  int rank, num_ranks, err_code = 0;
+  MPI_Comm_rank(comm, &rank); MPI_Comm_size(comm, &num_ranks);
+  int rel_rank = (rank - root + num_ranks) % num_ranks;
+  for (int stride=1; stride<num_ranks && !err_code; stride*=2) {
+    if (rel_rank % (2*stride)) {
+      MPIPackBuffer send_buff;
+      pack(send_buff);
+      err_code = MPI_Send((void*)send_buff.buf(), send_buff.size(),
+			  MPI_PACKED, (rank - stride + num_ranks) % num_ranks,
+			  STREAMING_STATS_REDUCE_TAG, comm);
+      break;
+    }
+    else if (rel_rank + stride < num_ranks) {
+      int source = (rank + stride) % num_ranks, length;
+      MPI_Status status;
+      err_code = MPI_Probe(source, STREAMING_STATS_REDUCE_TAG, comm, &status);
+      if (!err_code)
+	err_code = MPI_Get_count(&status, MPI_PACKED, &length);
+      if (err_code) break;
+      MPIUnpackBuffer recv_buff(length);
+      err_code = MPI_Recv((void*)recv_buff.buf(), length, MPI_PACKED, source,
+			  STREAMING_STATS_REDUCE_TAG, comm, &status);
+      if (err_code) break;
+      StreamingStatistics partial(*this); // same configuration
+      partial.unpack(recv_buff);
+      merge(partial);
+    }
+  }
+  if (err_code) {
+    Cerr << "Error: MPI communication returns with error code " << err_code
+	 << " in StreamingStatistics::reduce()." << std::endl;
+    abort_handler(-1);
+  }
+#endif // DAKOTA_HAVE_MPI
+}
+
+
+void StreamingStatistics::finalize()
+{
+  size_t q, num_qoi = qoiMoments.size();
+  for (q=0; q<num_qoi; ++q)
+    if (trackQuantiles[q])
+      qoiQuantiles[q].finalize();
+}
+
+
+void StreamingStatistics::pack(MPIPackBuffer& send_buff) const
+{
+  size_t q, l, num_qoi = qoiMoments.size();
+  send_buff << numObservations;
+  for (q=0; q<num_qoi; ++q) {
+    qoiMoments[q].pack(send_buff);
+    send_buff << qoiMin[q] << qoiMax[q];
+    const SizetArray& counts_q = levelCounts[q];
+    for (l=0; l<counts_q.size(); ++l)
+      send_buff << counts_q[l];
+    if (trackQuantiles[q])
+      qoiQuantiles[q].pack(send_buff);
+  }
+}
+
+
+void StreamingStatistics::unpack(MPIUnpackBuffer& recv_buff)
+{
+  size_t q, l, num_qoi = qoiMoments.size();
+  recv_buff >> numObservations;
+  for (q=0; q<num_qoi; ++q) {
+    qoiMoments[q].unpack(recv_buff);
+    recv_buff >> qoiMin[q] >> qoiMax[q];
+    SizetArray& counts_q = levelCounts[q];
+    for (l=0; l<counts_q.size(); ++l)
+      recv_buff >> counts_q[l];
+    if (trackQuantiles[q])
+      qoiQuantiles[q].unpack(recv_buff);
+  }
+}
+
+} // namespace Dakota
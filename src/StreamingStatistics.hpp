@@ -0,0 +1,284 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#ifndef STREAMING_STATISTICS_H
+#define STREAMING_STATISTICS_H
+
+#include "dakota_data_types.hpp"
+#include "MPIPackBuffer.hpp"
+#include "MPIManager.hpp"
+
+
+namespace Dakota {
+
+
+/// Mergeable one-pass accumulator of the first four central moments
+
+/** Samples are accumulated with the Welford/Terriberry recurrences
+    for the mean and central sums of powers 2 through 4, and partial
+    accumulations (e.g., from different threads or MPI ranks) are
+    combined with Pebay's pairwise formulas, so that no sample needs to
+    be retained or revisited. */
+
+class StreamingMoments
+{
+public:
+
+  StreamingMoments();  ///< constructor
+  ~StreamingMoments(); ///< destructor
+
+  /// accumulate a sample
+  void add(Real sample);
+  /// combine with the accumulation of a disjoint set of samples
+  void merge(const StreamingMoments& other);
+  /// discard all samples
+  void reset();
+
+  /// number of samples accumulated
+  size_t count() const;
+  /// sample mean
+  Real mean() const;
+
+  /// unbiased estimators of the mean, variance (central) or standard
+  /// deviation, third central moment or skewness, and fourth central
+  /// moment or excess kurtosis; the third and fourth are zero where
+  /// undefined (non-positive variance or too few samples)
+  void moments(bool central, Real* moments) const;
+
+  /// pack the accumulation state for transfer to another rank
+  void pack(MPIPackBuffer& send_buff) const;
+  /// unpack an accumulation state packed with pack()
+  void unpack(MPIUnpackBuffer& recv_buff);
+
+private:
+
+  size_t numSamples; ///< number of samples
+  Real sampleMean;   ///< running mean
+  Real centralSum2;  ///< sum of squared deviations from the mean
+  Real centralSum3;  ///< sum of cubed deviations from the mean
+  Real centralSum4;  ///< sum of fourth powers of deviations from the mean
+};
+
+
+inline size_t StreamingMoments::count() const
+{ return numSamples; }
+
+
+inline Real StreamingMoments::mean() const
+{ return sampleMean; }
+
+
+/// Mergeable quantile sketch of a stream of samples
+
+/** Samples are retained exactly until more than the capacity have
+    been added.  Beyond that, the sketch is a hierarchy of compactors:
+    a full level is sorted and every other sample (alternating between
+    the odd and even positions on successive compactions, for
+    reproducibility) is promoted to the next level with twice the
+    weight.  Memory is then O(capacity * log(count / capacity)), and the
+    rank error of any quantile is at most a few times count / capacity.
+    Sketches merge level by level. */
+
+class QuantileSketch
+{
+public:
+
+  /// constructor
+  QuantileSketch(size_t capacity = 65536);
+  /// destructor
+  ~QuantileSketch();
+
+  /// set the compactor capacity; only valid before samples are added
+  void capacity(size_t cap);
+  /// compactor capacity
+  size_t capacity() const;
+
+  /// add a sample
+  void add(Real sample);
+  /// combine with the sketch of a disjoint set of samples
+  void merge(const QuantileSketch& other);
+  /// discard all samples
+  void reset();
+
+  /// number of samples added
+  size_t count() const;
+  /// true if all samples are retained (no compaction has occurred)
+  bool exact() const;
+
+  /// sort the retained samples in preparation for ranked_value()
+  void finalize();
+  /// the sample of (zero-based) rank r in ascending order, exact if
+  /// exact(); requires finalize() after the last add() or merge()
+  Real ranked_value(size_t r) const;
+
+  /// pack the sketch for transfer to another rank
+  void pack(MPIPackBuffer& send_buff) const;
+  /// unpack a sketch packed with pack()
+  void unpack(MPIUnpackBuffer& recv_buff);
+
+private:
+
+  /// compact level, and any levels thereby filled
+  void compact(size_t level);
+
+  /// maximum number of samples retained at each level
+  size_t levelCapacity;
+  /// total number of samples added
+  size_t totalCount;
+  /// samples retained at each level; a sample at level h has weight 2^h
+  std::vector<RealArray> levelSamples;
+  /// offset (0 or 1) of the next compaction at each level
+  std::vector<unsigned char> compactOffset;
+  /// retained samples in ascending order (from finalize())
+  RealArray sortedSamples;
+  /// cumulative weights of sortedSamples (from finalize())
+  SizetArray cumulativeWeights;
+};
+
+
+inline size_t QuantileSketch::capacity() const
+{ return levelCapacity; }
+
+
+inline size_t QuantileSketch::count() const
+{ return totalCount; }
+
+
+inline bool QuantileSketch::exact() const
+{ return levelSamples.size() <= 1; }
+
+
+/// Streaming sample statistics for a set of quantities of interest
+
+/** Accumulates, for each QoI, the moments, extreme values, counts of
+    samples binned by a set of response levels (as for CDF estimation),
+    and (optionally) a quantile sketch, skipping non-finite (failed)
+    samples.  Samples may be added one evaluation at a time as they
+    complete, or as a batch, in which case the QoIs are partitioned
+    among threads.  Statistics accumulated separately (on different
+    ranks or for different sample sets) are merged without loss, either
+    directly or across the ranks of a communicator with reduce(). */
+
+class StreamingStatistics
+{
+public:
+
+  StreamingStatistics();  ///< constructor
+  ~StreamingStatistics(); ///< destructor
+
+  /// size for num_qoi quantities; resp_levels[q] (if present) are the
+  /// response levels at which to bin QoI q, and quantiles for QoI q
+  /// are tracked (with sketch_capacity) if track_quantiles[q]
+  void initialize(size_t num_qoi,
+		  const RealVectorArray& resp_levels = RealVectorArray(),
+		  const BitArray& track_quantiles = BitArray(),
+		  size_t sketch_capacity = 65536);
+  /// discard all samples, retaining the configuration
+  void reset();
+
+  /// accumulate the QoI values of one evaluation
+  void update(const RealVector& fn_vals);
+  /// accumulate the QoI values of a batch of evaluations, using up to
+  /// num_threads threads (thread budget if 0)
+  void update(const RealVectorArray& fn_samples, size_t num_threads = 0);
+  /// combine with statistics accumulated from a disjoint set of samples
+  /// (with the same configuration)
+  void merge(const StreamingStatistics& other);
+  /// merge the statistics accumulated on each rank of comm (with the same
+  /// configuration) into those on rank root; other ranks retain partial
+  /// merges.  No-op without MPI.
+  void reduce(MPI_Comm comm, int root = 0);
+  /// sort the retained quantile samples prior to quantile queries
+  void finalize();
+
+  /// number of QoIs
+  size_t num_qoi() const;
+  /// number of evaluations accumulated (including failures)
+  size_t num_observations() const;
+  /// number of finite samples of QoI q
+  size_t num_samples(size_t q) const;
+  /// moments of QoI q
+  const StreamingMoments& moments(size_t q) const;
+  /// minimum finite sample of QoI q (DBL_MAX if none)
+  Real min(size_t q) const;
+  /// maximum finite sample of QoI q (-DBL_MAX if none)
+  Real max(size_t q) const;
+  /// counts of QoI q samples binned at the first response level z_k with
+  /// sample <= z_k, i.e., (-inf, z_0], (z_0, z_1], ..., (z_last, inf) for
+  /// ascending levels, with the last count for samples above all levels
+  const SizetArray& level_counts(size_t q) const;
+  /// quantile sketch of QoI q
+  const QuantileSketch& quantiles(size_t q) const;
+
+  /// pack the statistics for transfer to another rank
+  void pack(MPIPackBuffer& send_buff) const;
+  /// unpack statistics packed with pack() (into an object with the
+  /// same configuration)
+  void unpack(MPIUnpackBuffer& recv_buff);
+
+private:
+
+  /// accumulate sample for QoI q
+  void update(size_t q, Real sample);
+
+  /// number of evaluations accumulated
+  size_t numObservations;
+  /// moments per QoI
+  std::vector<StreamingMoments> qoiMoments;
+  /// minimum finite sample per QoI
+  RealArray qoiMin;
+  /// maximum finite sample per QoI
+  RealArray qoiMax;
+  /// response levels per QoI
+  Real2DArray respLevels;
+  /// whether respLevels[q] is in ascending order (permitting bisection)
+  BoolDeque ascendingLevels;
+  /// counts of samples binned by respLevels per QoI
+  Sizet2DArray levelCounts;
+  /// quantile sketches per QoI (unused if not tracked)
+  std::vector<QuantileSketch> qoiQuantiles;
+  /// QoIs for which quantiles are tracked
+  BitArray trackQuantiles;
+};
+
+
+inline size_t StreamingStatistics::num_qoi() const
+{ return qoiMoments.size(); }
+
+
+inline size_t StreamingStatistics::num_observations() const
+{ return numObservations; }
+
+
+inline size_t StreamingStatistics::num_samples(size_t q) const
+{ return qoiMoments[q].count(); }
+
+
+inline const StreamingMoments& StreamingStatistics::moments(size_t q) const
+{ return qoiMoments[q]; }
+
+
+inline Real StreamingStatistics::min(size_t q) const
+{ return qoiMin[q]; }
+
+
+inline Real StreamingStatistics::max(size_t q) const
+{ return qoiMax[q]; }
+
+
+inline const SizetArray& StreamingStatistics::level_counts(size_t q) const
+{ return levelCounts[q]; }
+
+
+inline const QuantileSketch& StreamingStatistics::quantiles(size_t q) const
+{ return qoiQuantiles[q]; }
+
+} // namespace Dakota
+
+#endif
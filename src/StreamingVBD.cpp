@@ -0,0 +1,255 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "StreamingVBD.hpp"
+#include "dakota_global_defs.hpp"
+#include "dakota_mersenne_twister.hpp"
+#include "util_threads.hpp"
+#include <boost/random/uniform_int_distribution.hpp>
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <thread>
+
+namespace Dakota {
+
+/// minimum number of C responses per thread in a batch update
+static const size_t STREAMING_VBD_THREAD_WORK = 10000;
+
+
+StreamingVBD::StreamingVBD():
+  numFns(0), numVars(0), numSamples(0), numBoot(0)
+{ }
+
+
+StreamingVBD::~StreamingVBD()
+{ }
+
+
+void StreamingVBD::
+initialize(size_t num_fns, size_t num_vars, size_t num_samples,
+	   size_t num_bootstrap, int seed)
+{
+  numFns = num_fns; numVars = num_vars; numSamples = num_samples;
+  numBoot = num_bootstrap;
+
+  aVals.assign(numFns * numSamples, 0.); bVals.assign(numFns * numSamples, 0.);
+  aReceived.clear(); aReceived.resize(numSamples, false);
+  bReceived.clear(); bReceived.resize(numSamples, false);
+  deferredC.clear();
+  fnShift.assign(numFns, 0.);
+  size_t num_sums = numFns * numVars * (numBoot + 1);
+  sumAD.assign(num_sums, 0.); sumD.assign(num_sums, 0.);
+  sumDD.assign(num_sums, 0.);
+
+  // each resample draws num_samples indices with replacement; only the
+  // resulting multiplicities enter the sums
+  bootWeights.assign(numBoot * numSamples, 0);
+  boost::random::mt19937 rng(seed);
+  boost::random::uniform_int_distribution<size_t> index_dist(0, numSamples-1);
+  for (size_t b=0; b<numBoot; ++b) {
+    unsigned int* weights_b = &bootWeights[b * numSamples];
+    for (size_t j=0; j<numSamples; ++j)
+      ++weights_b[index_dist(rng)];
+  }
+}
+
+
+void StreamingVBD::update(size_t eval_index, const RealVector& fn_vals)
+{
+  size_t block = eval_index / numSamples, sample = eval_index % numSamples;
+  if (block >= numVars + 2) {
+    Cerr << "\nError: evaluation index " << eval_index << " exceeds the "
+	 << numSamples * (numVars + 2) << " evaluations of the pick-and-freeze "
+	 << "design in StreamingVBD::update()." << std::endl;
+    abort_handler(METHOD_ERROR);
+  }
+
+  const Real* vals = fn_vals.values();
+  if (block < 2) {
+    RealArray& ab_vals = (block) ? bVals : aVals;
+    std::copy(vals, vals + numFns, &ab_vals[sample * numFns]);
+    if (block) bReceived.set(sample);
+    else {
+      aReceived.set(sample);
+      if (!sample) fnShift.assign(vals, vals + numFns);
+    }
+    if (!deferredC.empty())
+      update_deferred();
+  }
+  else if (ready(sample))
+    update_c(block - 2, sample, vals);
+  else
+    deferredC.insert(std::make_pair(sample,
+      std::make_pair(block - 2, RealVector(Teuchos::Copy,
+					   const_cast<Real*>(vals), numFns))));
+}
+
+
+void StreamingVBD::update_deferred()
+{
+  std::multimap<size_t, std::pair<size_t, RealVector> >::iterator
+    it = deferredC.begin();
+  while (it != deferredC.end())
+    if (ready(it->first)) {
+      update_c(it->second.first, it->first, it->second.second.values());
+      deferredC.erase(it++);
+    }
+    else
+      ++it;
+}
+
+
+void StreamingVBD::update_c(size_t var, size_t sample, const Real* fn_vals)
+{
+  const Real *a_vals = &aVals[sample * numFns], *b_vals = &bVals[sample * numFns];
+  for (size_t k=0; k<numFns; ++k) {
+    Real a = a_vals[k] - fnShift[k], d = fn_vals[k] - b_vals[k],
+      ad = a * d, dd = d * d;
+    size_t index = fn_var_index(k, var, 0);
+    Real *sum_ad = &sumAD[index], *sum_d = &sumD[index], *sum_dd = &sumDD[index];
+    sum_ad[0] += ad; sum_d[0] += d; sum_dd[0] += dd;
+    for (size_t b=1; b<=numBoot; ++b) {
+      Real w = (Real)bootWeights[(b-1) * numSamples + sample];
+      sum_ad[b] += w * ad; sum_d[b] += w * d; sum_dd[b] += w * dd;
+    }
+  }
+}
+
+
+/** Each thread accumulates all samples of a contiguous range of
+    variables, in sample order, so that the sums do not depend on the
+    number of threads. */
+void StreamingVBD::update(const RealVectorArray& fn_samples, size_t num_threads)
+{
+  size_t num_evals = numSamples * (numVars + 2);
+  if (fn_samples.size() != num_evals) {
+    Cerr << "\nError: expected " << num_evals << " responses; received "
+	 << fn_samples.size() << " in StreamingVBD::update()." << std::endl;
+    abort_handler(METHOD_ERROR);
+  }
+
+  size_t j;
+  for (j=0; j<2*numSamples; ++j)
+    update(j, fn_samples[j]);
+
+  num_threads = dakota::util::num_threads(num_threads, std::min(numVars,
+    numVars * numSamples * numFns / STREAMING_VBD_THREAD_WORK));
+
+  auto update_range = [&](size_t v_start, size_t v_end) {
+    for (size_t v=v_start; v<v_end; ++v)
+      for (size_t s=0; s<numSamples; ++s)
+	update_c(v, s, fn_samples[(v + 2) * numSamples + s].values());
+  };
+
+  if (num_threads <= 1)
+    update_range(0, numVars);
+  else {
+    std::vector<std::thread> threads;
+    std::vector<std::exception_ptr> failures(num_threads);
+    size_t t, v_per_thread = numVars / num_threads,
+      v_remainder = numVars % num_threads, v_start = 0;
+    for (t=0; t<num_threads; ++t) {
+      size_t v_end = v_start + v_per_thread + (t < v_remainder ? 1 : 0);
+      threads.emplace_back([&, t, v_start, v_end]() {
+	try { update_range(v_start, v_end); }
+	catch (...) { failures[t] = std::current_exception(); }
+      });
+      v_start = v_end;
+    }
+    for (std::thread& th : threads)
+      th.join();
+    for (t=0; t<num_threads; ++t)
+      if (failures[t])
+	std::rethrow_exception(failures[t]);
+  }
+}
+
+
+/** Equivalent to centering all responses by their overall mean and
+    applying the Saltelli (2010) main effect and Jansen total effect
+    estimators with the variance estimated from the A and B responses. */
+void StreamingVBD::indices(size_t fn, size_t b, Real* si, Real* ti) const
+{
+  Real num_wt = 0., sum_a = 0., sum_b = 0., sum_sq = 0., shift = fnShift[fn];
+  const unsigned int* weights = (b) ? &bootWeights[(b-1) * numSamples] : NULL;
+  for (size_t j=0; j<numSamples; ++j) {
+    Real w = (weights) ? (Real)weights[j] : 1.,
+      a = aVals[j * numFns + fn] - shift, bv = bVals[j * numFns + fn] - shift;
+    num_wt += w; sum_a += w * a; sum_b += w * bv;
+    sum_sq += w * (a * a + bv * bv);
+  }
+  Real mean_c = (sum_a + sum_b) / (2. * num_wt),
+    var_c = sum_sq / (2. * num_wt) - mean_c * mean_c;
+
+  // overall mean (relative to shift) of A, B and all C_i = B + D_i
+  size_t v, index;
+  Real sum_all = sum_a + sum_b;
+  for (v=0; v<numVars; ++v)
+    sum_all += sumD[fn_var_index(fn, v, b)] + sum_b;
+  Real overall_mean = sum_all / (num_wt * (Real)(numVars + 2));
+
+  for (v=0; v<numVars; ++v) {
+    index = fn_var_index(fn, v, b);
+    si[v] = ( (sumAD[index] - overall_mean * sumD[index]) / num_wt ) / var_c;
+    ti[v] = ( sumDD[index] / (2. * num_wt) ) / var_c;
+  }
+}
+
+
+void StreamingVBD::
+compute_indices(RealVectorArray& index_si, RealVectorArray& index_ti) const
+{
+  if (!deferredC.empty()) {
+    Cerr << "\nError: " << deferredC.size() << " responses await A/B "
+	 << "responses in StreamingVBD::compute_indices()." << std::endl;
+    abort_handler(METHOD_ERROR);
+  }
+  index_si.resize(numFns); index_ti.resize(numFns);
+  for (size_t k=0; k<numFns; ++k) {
+    index_si[k].sizeUninitialized(numVars);
+    index_ti[k].sizeUninitialized(numVars);
+    indices(k, 0, index_si[k].values(), index_ti[k].values());
+  }
+}
+
+
+void StreamingVBD::
+compute_confidence_intervals(Real conf_level, RealMatrixArray& si_ci,
+			     RealMatrixArray& ti_ci) const
+{
+  si_ci.resize(numFns); ti_ci.resize(numFns);
+  if (!numBoot) {
+    for (size_t k=0; k<numFns; ++k)
+      { si_ci[k].shape(0, 0); ti_ci[k].shape(0, 0); }
+    return;
+  }
+
+  // percentile interval from the order statistics of the resamples
+  Real alpha = (1. - conf_level) / 2.;
+  size_t b, k, v, lo = (size_t)std::floor(alpha * (Real)(numBoot - 1)),
+    hi = (size_t)std::ceil((1. - alpha) * (Real)(numBoot - 1));
+  RealMatrix boot_si(numVars, numBoot, false), boot_ti(numVars, numBoot, false);
+  RealArray si_v(numBoot), ti_v(numBoot);
+  for (k=0; k<numFns; ++k) {
+    for (b=0; b<numBoot; ++b)
+      indices(k, b+1, boot_si[b], boot_ti[b]);
+    si_ci[k].shapeUninitialized(2, numVars);
+    ti_ci[k].shapeUninitialized(2, numVars);
+    for (v=0; v<numVars; ++v) {
+      for (b=0; b<numBoot; ++b)
+	{ si_v[b] = boot_si(v, b); ti_v[b] = boot_ti(v, b); }
+      std::sort(si_v.begin(), si_v.end()); std::sort(ti_v.begin(), ti_v.end());
+      si_ci[k](0, v) = si_v[lo]; si_ci[k](1, v) = si_v[hi];
+      ti_ci[k](0, v) = ti_v[lo]; ti_ci[k](1, v) = ti_v[hi];
+    }
+  }
+}
+
+} // namespace Dakota
@@ -0,0 +1,118 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#ifndef STREAMING_VBD_H
+#define STREAMING_VBD_H
+
+#include "dakota_data_types.hpp"
+
+
+namespace Dakota {
+
+
+/// One-pass pick-and-freeze estimator of Sobol' main and total effects
+
+/** Evaluations of the Saltelli design are indexed as in the sample
+    set: num_samples evaluations of the A matrix, then of the B matrix,
+    then of each of the num_vars C_i matrices (B with column i from A).
+    The A and B responses are retained; each C_i response contributes
+    to the per-QoI, per-variable sums of the Saltelli (2010) main effect
+    and Jansen total effect estimators and is then discarded, so storage
+    is O(num_fns * (num_samples + num_vars)) rather than the full
+    O(num_fns * num_vars * num_samples) response tensor.  A C_i response
+    received before its A and B responses is deferred until they arrive.
+
+    Bootstrap confidence intervals are formed from num_bootstrap
+    multinomial resamplings of the sample indices, drawn up front, which
+    enter the same sums as integer weights. */
+
+class StreamingVBD
+{
+public:
+
+  StreamingVBD();  ///< constructor
+  ~StreamingVBD(); ///< destructor
+
+  /// size the accumulation; bootstrap resamples are drawn from seed
+  void initialize(size_t num_fns, size_t num_vars, size_t num_samples,
+		  size_t num_bootstrap = 0, int seed = 0);
+
+  /// accumulate the response of evaluation eval_index (in sample set order)
+  void update(size_t eval_index, const RealVector& fn_vals);
+  /// accumulate the responses of the complete sample set, with the
+  /// variables partitioned among up to num_threads threads (thread
+  /// budget if 0)
+  void update(const RealVectorArray& fn_samples, size_t num_threads = 0);
+
+  /// main (index_si) and total (index_ti) effect indices per QoI;
+  /// requires all evaluations
+  void compute_indices(RealVectorArray& index_si,
+		       RealVectorArray& index_ti) const;
+  /// percentile bootstrap confidence intervals at conf_level per QoI,
+  /// with rows (lower, upper) and a column per variable
+  void compute_confidence_intervals(Real conf_level, RealMatrixArray& si_ci,
+				    RealMatrixArray& ti_ci) const;
+
+  /// number of bootstrap resamples
+  size_t num_bootstrap() const;
+
+private:
+
+  /// accumulate the response of C_var for sample
+  void update_c(size_t var, size_t sample, const Real* fn_vals);
+  /// accumulate any deferred C responses for which A and B are available
+  void update_deferred();
+  /// true if the A and B responses needed by sample are available
+  bool ready(size_t sample) const;
+
+  /// index into the sum arrays for fn, var and resample b (b = 0 for
+  /// the original sample set, 1..num_bootstrap for the resamples)
+  size_t fn_var_index(size_t fn, size_t var, size_t b) const;
+
+  /// finalized (Si, Ti) for fn and resample b
+  void indices(size_t fn, size_t b, Real* si, Real* ti) const;
+
+  size_t numFns;     ///< number of QoIs
+  size_t numVars;    ///< number of variables
+  size_t numSamples; ///< number of samples per design matrix
+  size_t numBoot;    ///< number of bootstrap resamples
+
+  /// multinomial resampling counts, num_samples per resample
+  std::vector<unsigned int> bootWeights;
+
+  /// retained A and B responses, num_fns per sample
+  RealArray aVals, bVals;
+  /// which A and B responses have been received
+  BitArray aReceived, bReceived;
+  /// C responses awaiting A/B, keyed by sample, with their variable
+  std::multimap<size_t, std::pair<size_t, RealVector> > deferredC;
+
+  /// per-QoI shift (the first A response) reducing cancellation
+  RealArray fnShift;
+
+  /// per-QoI, per-variable, per-resample sums of (A - shift) (C_i - B),
+  /// (C_i - B) and (C_i - B)^2
+  RealArray sumAD, sumD, sumDD;
+};
+
+
+inline size_t StreamingVBD::num_bootstrap() const
+{ return numBoot; }
+
+
+inline size_t StreamingVBD::fn_var_index(size_t fn, size_t var, size_t b) const
+{ return (fn * numVars + var) * (numBoot + 1) + b; }
+
+
+inline bool StreamingVBD::ready(size_t sample) const
+{ return aReceived[0] && aReceived[sample] && bReceived[sample]; }
+
+} // namespace Dakota
+
+#endif
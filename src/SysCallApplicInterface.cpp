@@ -14,7 +14,6 @@
 #include "ParallelLibrary.hpp"
 #include "CommandShell.hpp"
 #include "WorkdirHelper.hpp"
-#include <thread>
 
 namespace Dakota {
 
@@ -25,7 +24,12 @@ SysCallApplicInterface(const ProblemDescDB& problem_db):
 
 
 void SysCallApplicInterface::map_bookkeeping(pid_t pid, int fn_eval_id)
-{ sysCallSet.insert(fn_eval_id); } // ignores pid
+{
+  // ignores pid
+  sysCallSet.insert(fn_eval_id);
+  resultsWatcher.add(fn_eval_id,
+		     completion_file(fileNameMap[fn_eval_id].get<1>()));
+}
 
 
 pid_t SysCallApplicInterface::create_evaluation_process(bool block_flag)
@@ -34,6 +38,10 @@ pid_t SysCallApplicInterface::create_evaluation_process(bool block_flag)
   if (asynchLocalAnalysisFlag && evalCommRank == 0 && evalServerId == 1)
     Cerr << "Warning: asynchronous analysis_drivers not supported in system "
 	 << "call interfaces.\n         Concurrency request will be ignored.\n";
+  // A sentinel left under a reused results file name (file_save or an
+  // untagged results_file) would otherwise signal completion at once.
+  if (evalCommRank == 0)
+    ResultsFileWatcher::clear_sentinel(completion_file(resultsFileWritten));
   // Analysis concurrency is a problem for SysCalls if there are no specified 
   // file names for detecting analysis completion (e.g., an oFilter maps
   // unspecified data files to results.out after all analyses have completed --
@@ -116,12 +124,19 @@ pid_t SysCallApplicInterface::create_evaluation_process(bool block_flag)
 
 
 /** Check for completion of active asynch jobs (tracked with sysCallSet).
-    Make one pass through sysCallSet & complete all jobs that have returned. */
+    Make one pass through the jobs whose results files have been signaled
+    as ready by resultsWatcher & complete all jobs that have returned. */
 void SysCallApplicInterface::test_local_evaluation_sequence(PRPQueue& prp_queue)
 {
   // Convenience function for common code between wait and nowait case.
 
-  for (ISIter it=sysCallSet.begin(); it!=sysCallSet.end(); ++it) {
+  // Only files signaled complete (closed after writing, renamed into place,
+  // sentinel present, or stable across polls) are parsed, rather than
+  // attempting a read of every active evaluation on every pass.
+  IntSet ready_ids;
+  resultsWatcher.ready(ready_ids);
+
+  for (ISIter it=ready_ids.begin(); it!=ready_ids.end(); ++it) {
 
     // Identify the corresponding PRPair
     int fn_eval_id = *it;
@@ -129,7 +144,9 @@ void SysCallApplicInterface::test_local_evaluation_sequence(PRPQueue& prp_queue)
 
     // Test for existence of the results file(s) corresponding to this PRPair
     const bfs::path& file_to_test = fileNameMap[fn_eval_id].get<1>();
-    if (system_call_file_test(file_to_test)) {
+    if (!system_call_file_test(file_to_test))
+      resultsWatcher.retry(fn_eval_id);
+    else {
       // File exists; test for complete/valid set of results (an incomplete 
       // set can result from a race condition in which Dakota is reading a 
       // file that a simulator has not finished writing).  Response::read
@@ -168,7 +185,8 @@ void SysCallApplicInterface::test_local_evaluation_sequence(PRPQueue& prp_queue)
         else
           failCountMap[fn_eval_id] = 1;
 
-	std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	// wait for the next completion signal before reading again
+	resultsWatcher.retry(fn_eval_id);
 #ifdef ASYNCH_DEBUG
         Cerr << "Warning: exception caught in reading response file "
              << file_to_test << "\nException = \"" << fr_except.what()
@@ -206,12 +224,26 @@ void SysCallApplicInterface::test_local_evaluation_sequence(PRPQueue& prp_queue)
   }
 
   // reduce processor load from DAKOTA testing if jobs are not finishing
-  if (completionSet.empty()) { // no jobs completed in pass through entire set
-    std::this_thread::sleep_for(std::chrono::milliseconds(1));
-  }
+  if (completionSet.empty()) // no jobs completed in pass through ready set
+    resultsWatcher.idle();
+  else
+    resultsWatcher.progress();
   // remove completed jobs from sysCallSet
-  for (ISCIter it = completionSet.begin(); it != completionSet.end(); ++it)
+  for (ISCIter it = completionSet.begin(); it != completionSet.end(); ++it) {
     sysCallSet.erase(*it);
+    resultsWatcher.remove(*it);
+  }
+}
+
+
+/** With multiple analysis drivers and no output filter, the last tagged
+    results file (root_file.[num_programs]) signals completion. */
+bfs::path SysCallApplicInterface::completion_file(const bfs::path& root_file)
+{
+  size_t num_programs = programNames.size();
+  return ( num_programs > 1 && oFilterName.empty() ) ?
+    WorkdirHelper::concat_path(root_file, "." + std::to_string(num_programs)) :
+    root_file;
 }
 
 
@@ -11,6 +11,7 @@
 #define SYS_CALL_APPLIC_INTERFACE_H
 
 #include "ProcessApplicInterface.hpp"
+#include "ResultsFileWatcher.hpp"
 
 
 namespace Dakota {
@@ -64,6 +65,9 @@ private:
   /// detect completion of a function evaluation through existence of
   /// the necessary results file(s); return true if results files found
   bool system_call_file_test(const bfs::path& root_file);
+  /// results file whose completion signals completion of the evaluation
+  /// writing root_file
+  bfs::path completion_file(const bfs::path& root_file);
 
   /// spawn a complete function evaluation
   void spawn_evaluation_to_shell(bool block_flag);
@@ -84,6 +88,10 @@ private:
     
   /// map linking function evaluation id's to number of response read failures
   IntShortMap failCountMap; 
+
+  /// event-driven (with polling fallback) detection of completed
+  /// results files for the evaluations in sysCallSet
+  ResultsFileWatcher resultsWatcher;
 };
 
 
@@ -100,8 +108,11 @@ inline SysCallApplicInterface::~SysCallApplicInterface()
 inline void SysCallApplicInterface::
 wait_local_evaluation_sequence(PRPQueue& prp_queue)
 {
-  while (completionSet.empty()) // complete at least one job
+  while (completionSet.empty()) { // complete at least one job
     test_local_evaluation_sequence(prp_queue);
+    if (completionSet.empty()) // block on file events or the adaptive delay
+      resultsWatcher.wait();
+  }
 }
 
 
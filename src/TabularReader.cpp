@@ -0,0 +1,401 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "TabularReader.hpp"
+#include "dakota_tabular_io.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace Dakota {
+
+namespace TabularIO {
+
+/// initial size of the block buffer used when the file is not mapped
+static const size_t TABULAR_BLOCK_SIZE = 4194304;
+
+
+static inline bool is_space(char c)
+{ return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' ||
+    c == '\f'; }
+
+
+static inline bool is_digit(char c)
+{ return c >= '0' && c <= '9'; }
+
+
+TabularReader::
+TabularReader(const std::string& input_filename,
+	      const std::string& context_message,
+	      unsigned short tabular_format):
+  inputFilename(input_filename), contextMessage(context_message),
+  tabularFormat(tabular_format), numLeading(0), projectWidth(0),
+  mappedData(NULL), mappedSize(0), bufferedBytes(0), currPos(NULL),
+  windowEnd(NULL), lineNum(1)
+{
+  if (tabular_format & TABULAR_EVAL_ID)  ++numLeading;
+  if (tabular_format & TABULAR_IFACE_ID) ++numLeading;
+
+  open(input_filename);
+
+  if ( (tabular_format & TABULAR_HEADER) && next_line() ) {
+    headerLabels.resize(lineFields.size());
+    for (size_t i=0; i<lineFields.size(); ++i)
+      headerLabels[i] = field(i);
+    lineFields.clear();
+  }
+}
+
+
+TabularReader::~TabularReader()
+{
+#ifdef HAVE_SYS_MMAN_H
+  if (mappedSize)
+    munmap(const_cast<char*>(mappedData), mappedSize);
+#endif
+}
+
+
+void TabularReader::open(const std::string& input_filename)
+{
+  // open through the stream first for the usual error handling
+  open_file(inputStream, input_filename, contextMessage);
+
+#ifdef HAVE_SYS_MMAN_H
+  int fd = ::open(input_filename.c_str(), O_RDONLY);
+  struct stat st;
+  if (fd >= 0 && fstat(fd, &st) == 0 && st.st_size > 0) {
+    void* addr = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr != MAP_FAILED) {
+      mappedData = (const char*)addr;
+      mappedSize = st.st_size;
+      // pages are read once, front to back
+      madvise(addr, mappedSize, MADV_SEQUENTIAL);
+    }
+  }
+  if (fd >= 0)
+    ::close(fd);
+  if (mappedSize) {
+    inputStream.close();
+    currPos = mappedData; windowEnd = mappedData + mappedSize;
+    return;
+  }
+#endif
+
+  blockBuffer.resize(TABULAR_BLOCK_SIZE);
+  currPos = windowEnd = blockBuffer.data();
+}
+
+
+/** Retains any partial line following the current window, then reads
+    until the buffer holds at least one whole line (growing it for
+    lines longer than the block size) or the file is exhausted.  The
+    window thus always ends on a line boundary, so that neither tokens
+    nor lines span two windows. */
+bool TabularReader::fill_buffer()
+{
+  if (mappedData || !inputStream.is_open())
+    return false;
+
+  char* data = blockBuffer.data();
+  size_t carry_start = windowEnd - data, carry = bufferedBytes - carry_start;
+  std::memmove(data, data + carry_start, carry);
+  bufferedBytes = carry;
+
+  size_t window_len = 0;
+  for (;;) {
+    if (bufferedBytes == blockBuffer.size())
+      blockBuffer.resize(2 * blockBuffer.size());
+    data = blockBuffer.data();
+    size_t prev_bytes = bufferedBytes;
+    inputStream.read(data + bufferedBytes, blockBuffer.size() - bufferedBytes);
+    bufferedBytes += inputStream.gcount();
+    // the carried partial line has no newline; search only the new data
+    const char* new_begin = data + prev_bytes;
+    const char* new_end   = data + bufferedBytes;
+    const char* last_nl = new_end;
+    while (last_nl != new_begin && *(last_nl - 1) != '\n')
+      --last_nl;
+    if (last_nl != new_begin)
+      { window_len = last_nl - data; break; }
+    if (!inputStream)
+      { window_len = bufferedBytes; inputStream.close(); break; }
+  }
+
+  currPos = data; windowEnd = data + window_len;
+  return window_len > 0;
+}
+
+
+bool TabularReader::skip_whitespace()
+{
+  for (;;) {
+    while (currPos != windowEnd && is_space(*currPos)) {
+      if (*currPos == '\n')
+	++lineNum;
+      ++currPos;
+    }
+    if (currPos != windowEnd)
+      return true;
+    if (!fill_buffer())
+      return false;
+  }
+}
+
+
+bool TabularReader::next_token(const char*& begin, const char*& end)
+{
+  if (!skip_whitespace())
+    return false;
+  begin = currPos;
+  while (currPos != windowEnd && !is_space(*currPos))
+    ++currPos;
+  end = currPos;
+  return true;
+}
+
+
+bool TabularReader::next_line()
+{
+  lineFields.clear();
+  if (!skip_whitespace())
+    return false;
+  // a line never spans windows
+  while (currPos != windowEnd && *currPos != '\n') {
+    if (is_space(*currPos))
+      { ++currPos; continue; }
+    const char* begin = currPos;
+    while (currPos != windowEnd && !is_space(*currPos))
+      ++currPos;
+    lineFields.push_back(std::make_pair(begin, currPos));
+  }
+  return true;
+}
+
+
+String TabularReader::line() const
+{
+  String line_str;
+  for (size_t i=0; i<lineFields.size(); ++i) {
+    if (i) line_str += ' ';
+    line_str.append(lineFields[i].first, lineFields[i].second);
+  }
+  return line_str;
+}
+
+
+void TabularReader::project(const SizetArray& columns)
+{
+  projectCols = columns;
+  projectWidth = columns.empty() ? 0 :
+    *std::max_element(columns.begin(), columns.end()) + 1;
+}
+
+
+bool TabularReader::
+read_record(Real* values, size_t record_len, int& eval_id, String& iface_id,
+	    size_t stride)
+{
+  size_t i;
+  if (!projectCols.empty()) {
+    if (!next_line())
+      return false;
+    if (lineFields.size() < numLeading + projectWidth)
+      read_error("expected at least " + std::to_string(numLeading +
+		 projectWidth) + " columns, found " +
+		 std::to_string(lineFields.size()));
+    leading_columns(eval_id, iface_id);
+    for (i=0; i<record_len; ++i) {
+      const std::pair<const char*, const char*>& fld
+	= lineFields[numLeading + projectCols[i]];
+      values[i*stride] = parse_required(fld.first, fld.second);
+    }
+    return true;
+  }
+
+  const char *begin, *end;
+  if (!next_token(begin, end))
+    return false;
+  if (tabularFormat & TABULAR_EVAL_ID) {
+    eval_id = std::atoi(String(begin, end).c_str());
+    if ( (tabularFormat & TABULAR_IFACE_ID) && !next_token(begin, end) )
+      read_error("insufficient data for record");
+  }
+  else
+    ++eval_id;
+  if (tabularFormat & TABULAR_IFACE_ID) {
+    iface_id.assign(begin, end);
+    // (Dakota 6.1 used EMPTY for missing ID)
+    if (iface_id == "EMPTY")
+      iface_id = "NO_ID";
+  }
+  else
+    iface_id = "NO_ID";
+
+  for (i=0; i<record_len; ++i) {
+    if ( (numLeading || i) && !next_token(begin, end) )
+      read_error("insufficient data for record of length " +
+		 std::to_string(record_len));
+    values[i*stride] = parse_required(begin, end);
+  }
+  return true;
+}
+
+
+size_t TabularReader::
+read_records(RealMatrix& chunk, size_t record_len, size_t max_records)
+{
+  if (chunk.numRows() != (int)record_len || chunk.numCols() != (int)max_records)
+    chunk.shapeUninitialized(record_len, max_records);
+  size_t num_read = 0;
+  while (num_read < max_records && read_record(chunk[num_read], record_len))
+    ++num_read;
+  return num_read;
+}
+
+
+Real TabularReader::real_field(size_t i, bool lenient) const
+{
+  const std::pair<const char*, const char*>& fld = lineFields[i];
+  Real value;
+  if (parse_real(fld.first, fld.second, value))
+    return value;
+  if (!lenient)
+    read_error("non-numeric value '" + field(i) + "'");
+  return std::atof(field(i).c_str());
+}
+
+
+void TabularReader::leading_columns(int& eval_id, String& iface_id) const
+{
+  size_t i = 0;
+  if (tabularFormat & TABULAR_EVAL_ID)
+    eval_id = std::atoi(field(i++).c_str());
+  else
+    ++eval_id;
+
+  if (tabularFormat & TABULAR_IFACE_ID) {
+    iface_id = field(i);
+    // (Dakota 6.1 used EMPTY for missing ID)
+    if (iface_id == "EMPTY")
+      iface_id = "NO_ID";
+  }
+  else
+    iface_id = "NO_ID";
+}
+
+
+bool TabularReader::exists_extra_data()
+{ return skip_whitespace(); }
+
+
+Real TabularReader::parse_required(const char* begin, const char* end) const
+{
+  Real value;
+  if (!parse_real(begin, end, value))
+    read_error("non-numeric value '" + String(begin, end) + "'");
+  return value;
+}
+
+
+void TabularReader::read_error(const std::string& msg) const
+{
+  Cerr << "\nError (" << contextMessage << "): " << msg << " on line "
+       << lineNum << "\nof file '" << inputFilename << "'." << std::endl;
+  abort_handler(IO_ERROR);
+}
+
+
+/** Decimal mantissas of at most 19 digits are accumulated exactly;
+    when the mantissa is below 2^53 and the decimal exponent at most 22
+    in magnitude, a single multiplication or division by an exactly
+    representable power of ten yields the correctly rounded result.
+    All other numbers (including nan and inf) are converted by
+    std::strtod. */
+bool TabularReader::parse_real(const char* begin, const char* end, Real& value)
+{
+  static const double pow10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+  const char* p = begin;
+  bool neg = false;
+  if (p != end && (*p == '-' || *p == '+'))
+    { neg = (*p == '-'); ++p; }
+
+  unsigned long long mantissa = 0;
+  int num_digits = 0, exp10 = 0;
+  bool any_digits = false, truncated = false;
+  for (; p != end && is_digit(*p); ++p) {
+    any_digits = true;
+    if (num_digits < 19) {
+      mantissa = 10*mantissa + (*p - '0');
+      if (mantissa) ++num_digits;
+    }
+    else
+      { ++exp10; if (*p != '0') truncated = true; }
+  }
+  if (p != end && *p == '.')
+    for (++p; p != end && is_digit(*p); ++p) {
+      any_digits = true;
+      if (num_digits < 19) {
+	mantissa = 10*mantissa + (*p - '0');
+	if (mantissa) ++num_digits;
+	--exp10;
+      }
+      else if (*p != '0')
+	truncated = true;
+    }
+  if (any_digits && p != end && (*p == 'e' || *p == 'E')) {
+    ++p;
+    bool neg_exp = false;
+    if (p != end && (*p == '-' || *p == '+'))
+      { neg_exp = (*p == '-'); ++p; }
+    if (p == end || !is_digit(*p))
+      return false;
+    int e = 0;
+    for (; p != end && is_digit(*p); ++p)
+      if (e < 100000) e = 10*e + (*p - '0');
+    exp10 += neg_exp ? -e : e;
+  }
+
+  if (any_digits && p == end && !truncated) {
+    if (!mantissa)
+      { value = neg ? -0. : 0.; return true; }
+    if (mantissa <= (1ULL << 53) && exp10 >= -22 && exp10 <= 22) {
+      value = (exp10 < 0) ? (double)mantissa / pow10[-exp10]
+	                  : (double)mantissa * pow10[exp10];
+      if (neg) value = -value;
+      return true;
+    }
+  }
+
+  // general case: strtod requires a terminated string
+  char buf[64];
+  size_t len = end - begin;
+  std::string long_token;
+  const char* str;
+  if (len < sizeof(buf))
+    { std::memcpy(buf, begin, len); buf[len] = '\0'; str = buf; }
+  else
+    { long_token.assign(begin, end); str = long_token.c_str(); }
+  char* str_end;
+  value = std::strtod(str, &str_end);
+  return len && str_end == str + len;
+}
+
+} // namespace TabularIO
+
+} // namespace Dakota
@@ -0,0 +1,200 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#ifndef TABULAR_READER_H
+#define TABULAR_READER_H
+
+#include "dakota_data_types.hpp"
+#include <fstream>
+
+
+namespace Dakota {
+
+namespace TabularIO {
+
+/// Chunked reader for (potentially very large) tabular data files
+
+/** The file is memory mapped where supported, otherwise read in
+    blocks of whole lines, and numeric fields are parsed in place
+    without stream extraction or intermediate strings.  Records of
+    numeric data may be read in free-form order (any whitespace,
+    including newlines, separating values) or projected onto a subset
+    of the columns of each line, one at a time or in chunks of bounded
+    size.  For callers interpreting the fields themselves, the file may
+    instead be traversed line by line.  Leading eval and interface id
+    columns are skipped or returned according to the tabular format,
+    and a header line, if present, is read on construction. */
+
+class TabularReader
+{
+public:
+
+  //
+  //- Heading: Constructors and destructor
+  //
+
+  /// constructor: open the file (aborting with context_message on
+  /// failure) and read its header if tabular_format has one
+  TabularReader(const std::string& input_filename,
+		const std::string& context_message,
+		unsigned short tabular_format);
+  /// destructor
+  ~TabularReader();
+
+  //
+  //- Heading: Member functions
+  //
+
+  /// labels in the header line (empty without TABULAR_HEADER)
+  const StringArray& header() const;
+  /// number of leading (eval id, interface id) columns per record
+  size_t num_leading_columns() const;
+  /// line number of the most recently read data
+  size_t line_number() const;
+
+  /// restrict records to the given data columns, numbered from the
+  /// first column after any leading columns; record entry i is taken
+  /// from column columns[i].  A projected record occupies exactly one
+  /// line.  An empty array restores free-form records.
+  void project(const SizetArray& columns);
+
+  /// read the next record of record_len values (record_len must
+  /// match the projection, if any) into values[0], values[stride],
+  /// ...; returns false at end of data and aborts on a truncated or
+  /// non-numeric record
+  bool read_record(Real* values, size_t record_len, size_t stride = 1);
+  /// read_record() returning the leading column data; eval_id is
+  /// incremented when the file has no eval id column
+  bool read_record(Real* values, size_t record_len, int& eval_id,
+		   String& iface_id, size_t stride = 1);
+  /// read up to max_records records of record_len values into the
+  /// columns of chunk, which is reshaped to record_len x max_records
+  /// only if its shape differs; returns the number of records read
+  size_t read_records(RealMatrix& chunk, size_t record_len,
+		      size_t max_records);
+
+  /// advance to the next non-blank line and split it into fields;
+  /// returns false at end of data
+  bool next_line();
+  /// number of fields on the current line, including leading columns
+  size_t num_fields() const;
+  /// field i of the current line as a string
+  String field(size_t i) const;
+  /// the current line, with fields separated by single spaces
+  String line() const;
+  /// field i of the current line as a Real; aborts if it is not
+  /// numeric, unless lenient, in which case its leading numeric part
+  /// (as for std::atof) is returned
+  Real real_field(size_t i, bool lenient = false) const;
+  /// leading column data of the current line; eval_id is incremented
+  /// when the file has no eval id column
+  void leading_columns(int& eval_id, String& iface_id) const;
+
+  /// true if any data remains to be read
+  bool exists_extra_data();
+
+  /// parse the Real in [begin, end), returning false unless the whole
+  /// range is a valid number
+  static bool parse_real(const char* begin, const char* end, Real& value);
+
+private:
+
+  //
+  //- Heading: Convenience functions
+  //
+
+  /// map the file (or allocate the block buffer for reading it)
+  void open(const std::string& input_filename);
+  /// advance the data window to the next block of whole lines; returns
+  /// false if no data remains
+  bool fill_buffer();
+  /// skip whitespace (across lines and blocks); returns false if no
+  /// data remains
+  bool skip_whitespace();
+  /// read the next whitespace-delimited token; returns false if no
+  /// data remains
+  bool next_token(const char*& begin, const char*& end);
+  /// parse a required numeric token, aborting on failure
+  Real parse_required(const char* begin, const char* end) const;
+  /// abort with a message identifying the file and current line
+  void read_error(const std::string& msg) const;
+
+  //
+  //- Heading: Data
+  //
+
+  /// name of the file being read
+  std::string inputFilename;
+  /// context for error messages
+  std::string contextMessage;
+  /// tabular format of the file
+  unsigned short tabularFormat;
+  /// number of leading columns per record
+  size_t numLeading;
+  /// header labels
+  StringArray headerLabels;
+  /// data columns of each projected record; empty if free-form
+  SizetArray projectCols;
+  /// one past the largest entry of projectCols
+  size_t projectWidth;
+
+  /// start of the memory-mapped file (NULL if not mapped)
+  const char* mappedData;
+  /// size of the mapping
+  size_t mappedSize;
+  /// stream used when the file is not mapped
+  std::ifstream inputStream;
+  /// block buffer used when the file is not mapped
+  std::vector<char> blockBuffer;
+  /// number of bytes of blockBuffer holding file data
+  size_t bufferedBytes;
+
+  /// current parse position
+  const char* currPos;
+  /// end of the current window of whole lines
+  const char* windowEnd;
+  /// line number at currPos
+  size_t lineNum;
+  /// fields of the current line
+  std::vector<std::pair<const char*, const char*> > lineFields;
+};
+
+
+inline const StringArray& TabularReader::header() const
+{ return headerLabels; }
+
+
+inline size_t TabularReader::num_leading_columns() const
+{ return numLeading; }
+
+
+inline size_t TabularReader::line_number() const
+{ return lineNum; }
+
+
+inline size_t TabularReader::num_fields() const
+{ return lineFields.size(); }
+
+
+inline String TabularReader::field(size_t i) const
+{ return String(lineFields[i].first, lineFields[i].second); }
+
+
+inline bool TabularReader::
+read_record(Real* values, size_t record_len, size_t stride)
+{
+  int eval_id = 0; String iface_id; // discarded
+  return read_record(values, record_len, eval_id, iface_id, stride);
+}
+
+} // namespace TabularIO
+
+} // namespace Dakota
+
+#endif
@@ -0,0 +1,136 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "TabularWriter.hpp"
+#include "dakota_global_defs.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace Dakota {
+
+namespace TabularIO {
+
+
+TabularWriter::TabularWriter(std::ostream& output_stream, size_t buffer_size):
+  outputStream(output_stream), formatBuffer(buffer_size), numBuffered(0),
+  realPrecision(write_precision), fieldWidth(write_precision+4)
+{ }
+
+
+TabularWriter::~TabularWriter()
+{ flush(); }
+
+
+void TabularWriter::reserve(size_t len)
+{
+  if (numBuffered + len > formatBuffer.size()) {
+    flush();
+    if (len > formatBuffer.size())
+      formatBuffer.resize(len);
+  }
+}
+
+
+void TabularWriter::flush()
+{
+  if (numBuffered) {
+    outputStream.write(formatBuffer.data(), numBuffered);
+    numBuffered = 0;
+  }
+}
+
+
+void TabularWriter::
+write_leading_columns(size_t eval_id, const String& iface_id,
+		      unsigned short tabular_format)
+{
+  // left aligned, consistent with the stream-based write_leading_columns()
+  if (tabular_format & TABULAR_EVAL_ID) {
+    reserve(32);
+    numBuffered += std::snprintf(&formatBuffer[numBuffered], 32, "%-8lu ",
+				 (unsigned long)eval_id);
+  }
+  if (tabular_format & TABULAR_IFACE_ID) {
+    const String& id = iface_id.empty() ? String("NO_ID") : iface_id;
+    size_t len = std::max(id.size(), (size_t)10) + 2;
+    reserve(len);
+    numBuffered += std::snprintf(&formatBuffer[numBuffered], len, "%-10s ",
+				 id.c_str());
+  }
+}
+
+
+void TabularWriter::write(Real value, int width)
+{
+  if (width < 0) width = fieldWidth;
+  size_t len = std::max(width, realPrecision + 16) + 2;
+  reserve(len);
+  // %g matches stream insertion with default floatfield and precision
+  numBuffered += std::snprintf(&formatBuffer[numBuffered], len, "%*.*g ",
+			       width, realPrecision, value);
+}
+
+
+void TabularWriter::write(int value, int width)
+{
+  if (width < 0) width = fieldWidth;
+  size_t len = std::max(width, 16) + 2;
+  reserve(len);
+  numBuffered += std::snprintf(&formatBuffer[numBuffered], len, "%*d ",
+			       width, value);
+}
+
+
+void TabularWriter::write(const String& value, int width)
+{
+  if (width < 0) width = fieldWidth;
+  size_t len = std::max((size_t)width, value.size()) + 2;
+  reserve(len);
+  numBuffered += std::snprintf(&formatBuffer[numBuffered], len, "%*s ",
+			       width, value.c_str());
+}
+
+
+void TabularWriter::write(const Real* values, size_t num_values)
+{
+  for (size_t i=0; i<num_values; ++i)
+    write(values[i]);
+}
+
+
+void TabularWriter::write(const unsigned short* values, size_t num_values)
+{
+  for (size_t i=0; i<num_values; ++i)
+    write(values[i]);
+}
+
+
+void TabularWriter::write_eol()
+{
+  reserve(1);
+  formatBuffer[numBuffered++] = '\n';
+}
+
+
+void TabularWriter::
+write_rows(const RealMatrix& data, const String& iface_id,
+	   unsigned short tabular_format, size_t first_eval_id)
+{
+  size_t j, num_rows = data.numRows(), num_cols = data.numCols();
+  for (j=0; j<num_cols; ++j) {
+    write_leading_columns(first_eval_id + j, iface_id, tabular_format);
+    write(data[j], num_rows);
+    write_eol();
+  }
+}
+
+} // namespace TabularIO
+
+} // namespace Dakota
@@ -0,0 +1,103 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#ifndef TABULAR_WRITER_H
+#define TABULAR_WRITER_H
+
+#include "dakota_data_types.hpp"
+
+
+namespace Dakota {
+
+namespace TabularIO {
+
+/// Buffered writer formatting tabular data rows in bulk
+
+/** Fields are formatted directly into a character buffer, which is
+    written to the output stream whenever it fills and on flush() or
+    destruction, rather than being inserted into the stream one at a
+    time.  The output is identical to that of the stream-based tabular
+    writers: Reals use write_precision significant digits in fields of
+    width write_precision+4 (unless overridden), each field is followed
+    by a space, and leading eval and interface id columns follow
+    write_leading_columns(). */
+
+class TabularWriter
+{
+public:
+
+  //
+  //- Heading: Constructors and destructor
+  //
+
+  /// constructor
+  TabularWriter(std::ostream& output_stream, size_t buffer_size = 1048576);
+  /// destructor; flushes the buffer
+  ~TabularWriter();
+
+  //
+  //- Heading: Member functions
+  //
+
+  /// write the leading columns of a record as specified by tabular_format
+  void write_leading_columns(size_t eval_id, const String& iface_id,
+			     unsigned short tabular_format);
+
+  /// write a Real field of the given width (default write_precision+4)
+  void write(Real value, int width = -1);
+  /// write an integer field of the given width (default write_precision+4)
+  void write(int value, int width = -1);
+  /// write a string field of the given width (default write_precision+4)
+  void write(const String& value, int width = -1);
+  /// write num_values consecutive Real fields
+  void write(const Real* values, size_t num_values);
+  /// write num_values consecutive integer fields
+  void write(const unsigned short* values, size_t num_values);
+
+  /// terminate the current row
+  void write_eol();
+
+  /// write each column of data as a row preceded by its leading columns,
+  /// with eval ids counting from first_eval_id
+  void write_rows(const RealMatrix& data, const String& iface_id,
+		  unsigned short tabular_format, size_t first_eval_id = 1);
+
+  /// write the buffered rows to the output stream
+  void flush();
+
+private:
+
+  //
+  //- Heading: Convenience functions
+  //
+
+  /// ensure that len more characters fit in the buffer
+  void reserve(size_t len);
+
+  //
+  //- Heading: Data
+  //
+
+  /// destination stream
+  std::ostream& outputStream;
+  /// formatted data not yet written to outputStream
+  std::vector<char> formatBuffer;
+  /// number of characters in formatBuffer
+  size_t numBuffered;
+  /// significant digits for Reals (write_precision on construction)
+  int realPrecision;
+  /// default field width
+  int fieldWidth;
+};
+
+} // namespace TabularIO
+
+} // namespace Dakota
+
+#endif
@@ -221,6 +221,38 @@ TestDriverInterface::~TestDriverInterface()
 }
 
 
+/** A batch is evaluated in one call when its single analysis driver
+    has a batch implementation and the evaluation is a plain function
+    call (no filters or multiprocessor analyses).  Otherwise false is
+    returned and the evaluations are mapped one at a time, which also
+    reports any specification errors. */
+bool TestDriverInterface::derived_map_batch(BatchEvaluation& batch)
+{
+  if (numAnalysisDrivers != 1 || iFilterType || oFilterType ||
+      multiProcAnalysisFlag)
+    return false;
+
+  switch (analysisDriverTypes[0]) {
+  case TEXT_BOOK:
+#ifndef TB_EXPENSIVE
+    // text_book() assumes no discrete variables in derivative mode
+    if (batch.num_functions() > 3 || batch.discrete_int_variables().numRows()
+	|| batch.discrete_real_variables().numRows() ||
+	!batch.discrete_string_variables().empty())
+      return false;
+    if (evalCommRank == 0 && !suppressOutput && outputLevel > SILENT_OUTPUT)
+      Cout << "Direct interface: invoking " << analysisDrivers[0]
+	   << " for a batch of " << batch.num_evaluations() << " evaluations"
+	   << std::endl;
+    text_book_batch(batch);
+    return true;
+#endif // TB_EXPENSIVE
+  default:
+    return false;
+  }
+}
+
+
 /** Derived map to evaluate a particular built-in test analysis function */
 int TestDriverInterface::derived_map_ac(const String& ac_name)
 {
@@ -3207,6 +3239,75 @@ int TestDriverInterface::text_book()
 }
 
 
+/** Same arithmetic as text_book1/2/3() in the serial case, so that
+    batch and single evaluations agree to the last bit. */
+void TestDriverInterface::text_book_batch(BatchEvaluation& batch)
+{
+  const RealMatrix&  x_c  = batch.continuous_variables();
+  const ShortArray&  asv  = batch.active_set_requests();
+  const SizetArray&  dvv  = batch.derivative_variables();
+  RealMatrix& fn_vals  = batch.function_values();
+  RealMatrix& fn_grads = batch.function_gradients();
+  RealMatrix& fn_hess  = batch.function_hessians();
+  size_t i, j, r, num_evals = batch.num_evaluations(),
+    num_fns = batch.num_functions(), num_deriv_vars = dvv.size(),
+    num_vars = x_c.numRows();
+
+  for (j=0; j<num_evals; ++j) {
+    const Real* x = x_c[j];
+    for (i=0; i<num_fns; ++i) {
+      size_t k = j * num_fns + i;
+      short asv_k = asv[k];
+      // **** f: sum (x[i] - POWVAL)^4, c1: x[0]*x[0] - 0.5*x[1],
+      // **** c2: x[1]*x[1] - 0.5*x[0]
+      if (asv_k & 1) {
+	Real val = 0.0;
+	for (r=0; r<num_vars; ++r)
+	  switch (i) {
+	  case 0: val += std::pow(x[r]-POW_VAL, 4); break;
+	  case 1:
+	    if (r==0)      val += x[r]*x[r];
+	    else if (r==1) val -= 0.5*x[r];
+	    break;
+	  case 2:
+	    if (r==0)      val -= 0.5*x[r];
+	    else if (r==1) val += x[r]*x[r];
+	    break;
+	  }
+	fn_vals(i, j) = val;
+      }
+      if (asv_k & 2) { // zeroed by BatchEvaluation::pack()
+	Real* grad = fn_grads[k];
+	for (r=0; r<num_deriv_vars; ++r) {
+	  size_t var_index = dvv[r] - 1; // no discrete vars
+	  switch (i) {
+	  case 0: grad[r] = 4.*std::pow(x[var_index]-POW_VAL,3); break;
+	  case 1:
+	    if (var_index == 0)      grad[r] = 2.*x[0];
+	    else if (var_index == 1) grad[r] = -0.5;
+	    break;
+	  case 2:
+	    if (var_index == 0)      grad[r] = -0.5;
+	    else if (var_index == 1) grad[r] = 2.*x[1];
+	    break;
+	  }
+	}
+      }
+      if (asv_k & 4) // diagonal only; off-diagonal zeroed by pack()
+	for (r=0; r<num_deriv_vars; ++r) {
+	  size_t var_index = dvv[r] - 1;
+	  Real& hess_rr = fn_hess(r, k * num_deriv_vars + r);
+	  switch (i) {
+	  case 0: hess_rr = 12.*std::pow(x[var_index]-POW_VAL,2); break;
+	  case 1: hess_rr = (var_index == 0) ? 2. : 0.;            break;
+	  case 2: hess_rr = (var_index == 1) ? 2. : 0.;            break;
+	  }
+	}
+    }
+  }
+}
+
+
 // text_book1/2/3 are used when evalComm is split into multiple analysis
 // servers.  In this case, the 3 portions are executed in parallel.
 int TestDriverInterface::text_book1()
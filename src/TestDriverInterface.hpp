@@ -38,6 +38,9 @@ protected:
 
   /// execute an analysis code portion of a direct evaluation invocation
   virtual int derived_map_ac(const Dakota::String& ac_name);
+  /// evaluate a batch in one call for drivers with a batch
+  /// implementation (currently text_book)
+  virtual bool derived_map_batch(BatchEvaluation& batch);
 
 private:
 
@@ -107,6 +110,8 @@ private:
   int text_book1();    ///< portion of text_book() evaluating the objective fn
   int text_book2();    ///< portion of text_book() evaluating constraint 1
   int text_book3();    ///< portion of text_book() evaluating constraint 2
+  /// text_book() over all evaluations of a batch
+  void text_book_batch(BatchEvaluation& batch);
   int text_book_ouu(); ///< the text_book_ouu OUU test function
   int scalable_text_book(); ///< scalable version of the text_book test function
   int scalable_monomials(); ///< simple monomials for UQ exactness testing
@@ -0,0 +1,195 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "TraceProfiler.hpp"
+#include "dakota_global_defs.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+namespace Dakota {
+
+std::atomic<bool> TraceProfiler::traceActive(false);
+String TraceProfiler::traceFile;
+int TraceProfiler::traceRank = 0;
+TraceProfiler::Clock::time_point TraceProfiler::traceStart;
+std::vector<TraceProfiler::TraceEvent> TraceProfiler::traceEvents;
+std::map<TraceProfiler::SpanKey, TraceProfiler::SpanStart>
+  TraceProfiler::openSpans;
+size_t TraceProfiler::numSpans = 0;
+std::mutex TraceProfiler::traceMutex;
+std::atomic<size_t> TraceProfiler::numThreads(0);
+
+
+void TraceProfiler::initialize(const String& trace_file, int world_rank)
+{
+  std::lock_guard<std::mutex> lock(traceMutex);
+  traceFile = (world_rank) ?
+    trace_file + "." + std::to_string(world_rank) : trace_file;
+  traceRank = world_rank;
+  traceEvents.clear(); openSpans.clear(); numSpans = 0;
+  traceStart = Clock::now();
+  traceActive.store(true);
+}
+
+
+/** Spans still open (e.g., evaluations abandoned by an iterator) are
+    not written. */
+void TraceProfiler::finalize(std::ostream& s, bool output_flag)
+{
+  if (!traceActive.exchange(false))
+    return;
+
+  std::lock_guard<std::mutex> lock(traceMutex);
+  std::ofstream trace_stream(traceFile.c_str());
+  if (trace_stream)
+    write_trace(trace_stream);
+  else
+    Cerr << "\nWarning: could not open trace file " << traceFile
+	 << " for writing." << std::endl;
+
+  if (output_flag) {
+    print_summary(s);
+    s << "Trace events written to " << traceFile << '\n';
+  }
+  traceEvents.clear(); openSpans.clear();
+}
+
+
+void TraceProfiler::
+complete(const String& name, const char* category,
+	 const Clock::time_point& start, const Clock::time_point& end,
+	 int eval_id)
+{
+  if (!active())
+    return;
+  std::lock_guard<std::mutex> lock(traceMutex);
+  record(name, category, 'X', start, end, eval_id);
+}
+
+
+void TraceProfiler::
+open_span(const char* name, const void* owner, int eval_id)
+{
+  Clock::time_point start = Clock::now();
+  std::lock_guard<std::mutex> lock(traceMutex);
+  openSpans[std::make_tuple(String(name), owner, eval_id)]
+    = std::make_pair(start, ++numSpans);
+}
+
+
+void TraceProfiler::
+close_span(const char* name, const char* category, const void* owner,
+	   int eval_id)
+{
+  Clock::time_point end = Clock::now();
+  std::lock_guard<std::mutex> lock(traceMutex);
+  std::map<SpanKey, SpanStart>::iterator s_it
+    = openSpans.find(std::make_tuple(String(name), owner, eval_id));
+  if (s_it == openSpans.end())
+    return;
+  record(std::get<0>(s_it->first), category, 'b', s_it->second.first, end,
+	 eval_id, s_it->second.second);
+  openSpans.erase(s_it);
+}
+
+
+size_t TraceProfiler::thread_index()
+{
+  static thread_local size_t index = numThreads++;
+  return index;
+}
+
+
+/** Called with traceMutex held. */
+void TraceProfiler::
+record(const String& name, const char* category, char phase,
+       const Clock::time_point& start, const Clock::time_point& end,
+       int eval_id, size_t span_id)
+{
+  typedef std::chrono::duration<Real, std::micro> Microseconds;
+  TraceEvent event;
+  event.name     = name;
+  event.category = category;
+  event.phase    = phase;
+  event.start    = Microseconds(start - traceStart).count();
+  event.duration = Microseconds(end - start).count();
+  event.thread   = thread_index();
+  event.evalId   = eval_id;
+  event.spanId   = span_id;
+  traceEvents.push_back(event);
+}
+
+
+/** Scoped phases are complete ('X') events on the thread that timed
+    them.  Spans are written as async begin/end ('b'/'e') pairs sharing
+    a unique id, such that concurrent evaluations appear as separate
+    tracks.  Names are Dakota identifiers and phase labels, which do not
+    require escaping. */
+void TraceProfiler::write_trace(std::ostream& s)
+{
+  s << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+  s << std::fixed << std::setprecision(3);
+  bool first = true;
+  for (const TraceEvent& event : traceEvents) {
+    String args = (event.evalId) ?
+      ",\"args\":{\"eval_id\":" + std::to_string(event.evalId) + "}" : "";
+    String common = "{\"name\":\"" + event.name + "\",\"cat\":\""
+      + event.category + "\",\"pid\":" + std::to_string(traceRank)
+      + ",\"tid\":" + std::to_string(event.thread);
+    if (!first) s << ",\n";
+    first = false;
+    if (event.phase == 'X')
+      s << common << ",\"ph\":\"X\",\"ts\":" << event.start << ",\"dur\":"
+	<< event.duration << args << '}';
+    else
+      s << common << ",\"ph\":\"b\",\"id\":" << event.spanId << ",\"ts\":"
+	<< event.start << args << "},\n" << common
+	<< ",\"ph\":\"e\",\"id\":" << event.spanId << ",\"ts\":"
+	<< event.start + event.duration << '}';
+  }
+  s << "\n]}\n";
+}
+
+
+void TraceProfiler::print_summary(std::ostream& s)
+{
+  struct PhaseTotals { size_t count; Real total, max; };
+  std::map<std::pair<String, String>, PhaseTotals> phase_totals;
+  for (const TraceEvent& event : traceEvents) {
+    PhaseTotals& pt = phase_totals[std::make_pair(String(event.category),
+						  event.name)];
+    Real t = event.duration * 1.e-6;
+    ++pt.count; pt.total += t;
+    if (t > pt.max) pt.max = t;
+  }
+
+  std::vector<std::pair<std::pair<String, String>, PhaseTotals> >
+    sorted_totals(phase_totals.begin(), phase_totals.end());
+  std::stable_sort(sorted_totals.begin(), sorted_totals.end(),
+    [](const std::pair<std::pair<String, String>, PhaseTotals>& a,
+       const std::pair<std::pair<String, String>, PhaseTotals>& b)
+    { return a.second.total > b.second.total; });
+
+  std::ios_base::fmtflags flags = s.flags();
+  s << "\n<<<<< Trace profile summary (seconds):\n"
+    << std::setw(18) << std::left << "category" << std::setw(34) << "phase"
+    << std::right << std::setw(10) << "count" << std::setw(14) << "total"
+    << std::setw(14) << "mean" << std::setw(14) << "max" << '\n';
+  s << std::scientific << std::setprecision(5);
+  for (const auto& pt : sorted_totals)
+    s << std::setw(18) << std::left << pt.first.first << std::setw(34)
+      << pt.first.second << std::right << std::setw(10) << pt.second.count
+      << std::setw(14) << pt.second.total << std::setw(14)
+      << pt.second.total / pt.second.count << std::setw(14) << pt.second.max
+      << '\n';
+  s.flags(flags);
+}
+
+} // namespace Dakota
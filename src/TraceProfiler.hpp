@@ -0,0 +1,212 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#ifndef TRACE_PROFILER_H
+#define TRACE_PROFILER_H
+
+#include "dakota_system_defs.hpp"
+#include "dakota_data_types.hpp"
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+
+namespace Dakota {
+
+
+/// Recorder of timed phases of a Dakota run for export as a Chrome trace
+
+/** When activated by the -trace command line option, phases timed by
+    TraceScope (e.g., writing a parameters file or an iterator's
+    core_run()) and spans between two points of the code (e.g., an
+    asynchronous evaluation from launch to completion) are recorded
+    with their thread and evaluation id.  At the end of the run, the
+    events are written in the Chrome trace event format, which can be
+    loaded in chrome://tracing or ui.perfetto.dev, and a summary table
+    of the count, total, mean and maximum time of each phase is
+    printed.  While inactive, an instrumentation point costs one test
+    of a static flag. */
+
+class TraceProfiler
+{
+public:
+
+  //
+  //- Heading: Type definitions
+  //
+
+  /// clock used for all trace events
+  typedef std::chrono::steady_clock Clock;
+
+  //
+  //- Heading: Static member functions
+  //
+
+  /// start recording events, to be written to trace_file (tagged with
+  /// the world rank for ranks other than 0) by finalize()
+  static void initialize(const String& trace_file, int world_rank);
+  /// write the trace file, print the summary table to s if output_flag,
+  /// and stop recording
+  static void finalize(std::ostream& s, bool output_flag);
+
+  /// whether events are being recorded
+  static bool active();
+
+  /// record a phase that ran from start to end on the calling thread
+  static void complete(const String& name, const char* category,
+		       const Clock::time_point& start,
+		       const Clock::time_point& end, int eval_id = 0);
+  /// start a span, identified by its name, owner (e.g., an Interface)
+  /// and evaluation id, that may end on another call stack, such as an
+  /// asynchronous evaluation
+  static void begin_span(const char* name, const char* category,
+			 const void* owner, int eval_id);
+  /// end a span started by begin_span(); no-op if it was not started
+  static void end_span(const char* name, const char* category,
+		       const void* owner, int eval_id);
+
+private:
+
+  //
+  //- Heading: Convenience functions
+  //
+
+  /// record the start of a span for begin_span()
+  static void open_span(const char* name, const void* owner, int eval_id);
+  /// record a span started by open_span() for end_span()
+  static void close_span(const char* name, const char* category,
+			 const void* owner, int eval_id);
+  /// a small index for the calling thread, in order of first use
+  static size_t thread_index();
+  /// store an event (phase 'X' for a scoped phase, 'b' for a span)
+  static void record(const String& name, const char* category, char phase,
+		     const Clock::time_point& start,
+		     const Clock::time_point& end, int eval_id,
+		     size_t span_id = 0);
+  /// write the recorded events in the Chrome trace event format
+  static void write_trace(std::ostream& s);
+  /// print the count, total, mean and maximum time of each phase
+  static void print_summary(std::ostream& s);
+
+  //
+  //- Heading: Data
+  //
+
+  /// a recorded phase or span
+  struct TraceEvent {
+    String name;          ///< phase name
+    const char* category; ///< phase category (static string)
+    char phase;           ///< 'X' (scoped phase) or 'b' (span)
+    Real start;           ///< microseconds since initialize()
+    Real duration;        ///< microseconds
+    size_t thread;        ///< thread_index() of the recording thread
+    int evalId;           ///< evaluation id (0 if none)
+    size_t spanId;        ///< unique id of a span
+  };
+
+  /// key of an open span: name, owner and evaluation id
+  typedef std::tuple<String, const void*, int> SpanKey;
+  /// start time and unique id of an open span
+  typedef std::pair<Clock::time_point, size_t> SpanStart;
+
+  /// whether events are being recorded
+  static std::atomic<bool> traceActive;
+  /// output file for the trace events
+  static String traceFile;
+  /// MPI rank used as the process id of the trace events
+  static int traceRank;
+  /// time origin of the trace
+  static Clock::time_point traceStart;
+  /// recorded events
+  static std::vector<TraceEvent> traceEvents;
+  /// open spans
+  static std::map<SpanKey, SpanStart> openSpans;
+  /// number of spans started
+  static size_t numSpans;
+  /// guards traceEvents and openSpans
+  static std::mutex traceMutex;
+  /// number of threads assigned an index by thread_index()
+  static std::atomic<size_t> numThreads;
+};
+
+
+inline bool TraceProfiler::active()
+{ return traceActive.load(std::memory_order_relaxed); }
+
+
+inline void TraceProfiler::
+begin_span(const char* name, const char* category, const void* owner,
+	   int eval_id)
+{ if (active()) open_span(name, owner, eval_id); }
+
+
+inline void TraceProfiler::
+end_span(const char* name, const char* category, const void* owner,
+	 int eval_id)
+{ if (active()) close_span(name, category, owner, eval_id); }
+
+
+/// Times the enclosing scope for the TraceProfiler, if active
+
+class TraceScope
+{
+public:
+
+  /// start timing the phase name within category
+  TraceScope(const char* name, const char* category, int eval_id = 0);
+  /// start timing the phase name within category
+  TraceScope(const String& name, const char* category, int eval_id = 0);
+  /// record the phase with the TraceProfiler
+  ~TraceScope();
+
+private:
+
+  /// whether the TraceProfiler was active at construction
+  bool traceFlag;
+  /// phase name (only assigned if traceFlag)
+  String traceName;
+  /// phase category
+  const char* traceCategory;
+  /// evaluation id associated with the phase
+  int evalId;
+  /// start of the phase
+  TraceProfiler::Clock::time_point startTime;
+};
+
+
+inline TraceScope::
+TraceScope(const char* name, const char* category, int eval_id):
+  traceFlag(TraceProfiler::active()), traceCategory(category), evalId(eval_id)
+{
+  if (traceFlag)
+    { traceName = name; startTime = TraceProfiler::Clock::now(); }
+}
+
+
+inline TraceScope::
+TraceScope(const String& name, const char* category, int eval_id):
+  traceFlag(TraceProfiler::active()), traceCategory(category), evalId(eval_id)
+{
+  if (traceFlag)
+    { traceName = name; startTime = TraceProfiler::Clock::now(); }
+}
+
+
+inline TraceScope::~TraceScope()
+{
+  if (traceFlag)
+    TraceProfiler::complete(traceName, traceCategory, startTime,
+			    TraceProfiler::Clock::now(), evalId);
+}
+
+} // namespace Dakota
+
+#endif
@@ -0,0 +1,210 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "TreeGaussianKDE.hpp"
+#include "dakota_global_defs.hpp"
+#include "util_threads.hpp"
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <thread>
+
+namespace Dakota {
+
+/// minimum number of density evaluation points per thread
+static const size_t TREE_KDE_THREAD_POINTS = 500;
+
+
+TreeGaussianKDE::TreeGaussianKDE(Real rel_tol):
+  relTol(rel_tol), pdfScale(0.)
+{ }
+
+
+TreeGaussianKDE::~TreeGaussianKDE()
+{ }
+
+
+void TreeGaussianKDE::initialize(const RealMatrix& samples)
+{
+  int i, d, num_dims = samples.numRows(), num_samples = samples.numCols();
+  if (num_samples < 2) {
+    Cerr << "\nError: TreeGaussianKDE requires at least two samples."
+	 << std::endl;
+    abort_handler(METHOD_ERROR);
+  }
+
+  // Silverman's rule of thumb for the bandwidth in each dimension
+  Real n = (Real)num_samples,
+    rule = std::pow(4. / ((num_dims + 2.) * n), 1. / (num_dims + 4.));
+  kernelBandwidths.size(num_dims);
+  pdfScale = 1. / n;
+  for (d=0; d<num_dims; ++d) {
+    Real mean = 0., var = 0.;
+    for (i=0; i<num_samples; ++i)
+      mean += samples(d,i);
+    mean /= n;
+    for (i=0; i<num_samples; ++i)
+      var += std::pow(samples(d,i) - mean, 2.);
+    Real std_dev = std::sqrt(var / (n - 1.));
+    if (std_dev <= 0.) {
+      Cerr << "\nError: samples have zero variance in dimension " << d+1
+	   << " in TreeGaussianKDE::initialize()." << std::endl;
+      abort_handler(METHOD_ERROR);
+    }
+    kernelBandwidths[d] = rule * std_dev;
+    pdfScale /= std::sqrt(2. * PI) * kernelBandwidths[d];
+  }
+
+  scaledSamples.initialize(num_dims, num_samples);
+  RealArray scaled_x(num_dims);
+  for (i=0; i<num_samples; ++i) {
+    for (d=0; d<num_dims; ++d)
+      scaled_x[d] = samples(d,i) / kernelBandwidths[d];
+    scaledSamples.insert(&scaled_x[0]);
+  }
+}
+
+
+/** Each thread evaluates a contiguous range of points. */
+void TreeGaussianKDE::
+pdf(const RealMatrix& points, RealVector& pdf_vals, size_t num_threads) const
+{
+  size_t num_pts = points.numCols();
+  if (points.numRows() != kernelBandwidths.length()) {
+    Cerr << "\nError: points of dimension " << points.numRows() << " do not "
+	 << "match the " << kernelBandwidths.length() << " dimensions of the "
+	 << "samples in TreeGaussianKDE::pdf()." << std::endl;
+    abort_handler(METHOD_ERROR);
+  }
+  pdf_vals.sizeUninitialized(num_pts);
+
+  num_threads = dakota::util::num_threads(num_threads,
+					  num_pts / TREE_KDE_THREAD_POINTS);
+
+  auto pdf_range = [&](size_t p_start, size_t p_end) {
+    std::vector<NodeBounds> node_stack;
+    RealArray scaled_x(kernelBandwidths.length());
+    for (size_t p=p_start; p<p_end; ++p)
+      pdf_vals[p] = pdf(points[p], node_stack, scaled_x);
+  };
+
+  if (num_threads <= 1)
+    pdf_range(0, num_pts);
+  else {
+    std::vector<std::thread> threads;
+    std::vector<std::exception_ptr> failures(num_threads);
+    size_t t, p_per_thread = num_pts / num_threads,
+      p_remainder = num_pts % num_threads, p_start = 0;
+    for (t=0; t<num_threads; ++t) {
+      size_t p_end = p_start + p_per_thread + (t < p_remainder ? 1 : 0);
+      threads.emplace_back([&, t, p_start, p_end]() {
+	try { pdf_range(p_start, p_end); }
+	catch (...) { failures[t] = std::current_exception(); }
+      });
+      p_start = p_end;
+    }
+    for (std::thread& th : threads)
+      th.join();
+    for (t=0; t<num_threads; ++t)
+      if (failures[t])
+	std::rethrow_exception(failures[t]);
+  }
+}
+
+
+/** The kernel sum S is accumulated over a traversal of the tree,
+    nearer children first.  The mean kernel of the n samples of a node
+    is approximated by the midpoint of its bounds from kernel_bounds(),
+    with error at most n/2 times their width, once this error is within
+    relTol n/N times a lower bound on S, comprising the kernels already
+    summed and the lower bounds of the approximated and pending nodes.
+    The total error is then at most relTol S, and the traversal depends
+    only on the tree and x. */
+Real TreeGaussianKDE::
+pdf(const Real* x, std::vector<NodeBounds>& node_stack,
+    RealArray& scaled_x) const
+{
+  size_t d, i, num_dims = scaled_x.size(), num_samples = scaledSamples.size();
+  for (d=0; d<num_dims; ++d)
+    scaled_x[d] = x[d] / kernelBandwidths[d];
+  const Real* sx = &scaled_x[0];
+
+  Real sum = 0.;
+  if (relTol <= 0.) {
+    for (i=0; i<num_samples; ++i)
+      sum += std::exp(-.5 * scaledSamples.distance_squared(i, sx));
+    return pdfScale * sum;
+  }
+
+  // the bounds of each node are computed once, when it is pushed
+  NodeBounds entry;
+  entry.node = 0;
+  kernel_bounds(0, sx, entry.kLower, entry.kUpper);
+  Real lower = num_samples * entry.kLower,
+    width_tol = 2. * relTol / (Real)num_samples;
+  node_stack.assign(1, entry);
+  while (!node_stack.empty()) {
+    entry = node_stack.back(); node_stack.pop_back();
+    Real n = (Real)scaledSamples.node_size(entry.node);
+    if (entry.kUpper - entry.kLower <= width_tol * lower)
+      { sum += .5 * n * (entry.kLower + entry.kUpper); continue; }
+
+    // replace the lower bound of the node with those of its contents
+    lower -= n * entry.kLower;
+    size_t child[2];
+    if (scaledSamples.node_children(entry.node, child[0], child[1])) {
+      NodeBounds child_entry[2];
+      for (i=0; i<2; ++i) {
+	child_entry[i].node = child[i];
+	kernel_bounds(child[i], sx, child_entry[i].kLower,
+		      child_entry[i].kUpper);
+	lower += scaledSamples.node_size(child[i]) * child_entry[i].kLower;
+      }
+      bool lower_first = (child_entry[0].kLower >= child_entry[1].kLower);
+      node_stack.push_back(child_entry[lower_first ? 1 : 0]);
+      node_stack.push_back(child_entry[lower_first ? 0 : 1]);
+    }
+    else {
+      const SizetArray& points = scaledSamples.node_points(entry.node);
+      for (i=0; i<points.size(); ++i) {
+	Real k = std::exp(-.5 * scaledSamples.distance_squared(points[i], sx));
+	sum += k; lower += k;
+      }
+    }
+  }
+  return pdfScale * sum;
+}
+
+
+/** The kernel exp(-t/2) is convex in the squared distance t, which for
+    the samples of a node lies between the squared distances a and b
+    from x to its bounding box and has mean m = |x - c|^2 + scatter / n
+    about the centroid c.  By Jensen's inequality the mean kernel is at
+    least exp(-m/2), and it is at most the chord from exp(-a/2) to
+    exp(-b/2) at m.  The gap is second order in b - a. */
+void TreeGaussianKDE::
+kernel_bounds(size_t node, const Real* scaled_x, Real& k_lower,
+	      Real& k_upper) const
+{
+  Real a, b, n = (Real)scaledSamples.node_size(node);
+  scaledSamples.node_measures(node, scaled_x, a, b);
+  const Real* centroid = scaledSamples.node_centroid(node);
+  Real m = scaledSamples.node_scatter(node) / n;
+  for (size_t d=0; d<scaledSamples.dimension(); ++d)
+    { Real dx = scaled_x[d] - centroid[d]; m += dx * dx; }
+  m = std::min(std::max(m, a), b);
+
+  Real k_a = std::exp(-.5 * a), k_b = std::exp(-.5 * b);
+  k_lower = std::exp(-.5 * m);
+  k_upper = (b > a) ? k_a + (k_b - k_a) * (m - a) / (b - a) : k_a;
+  // guard against rounding in the interpolation
+  if (k_upper < k_lower) k_upper = k_lower;
+}
+
+} // namespace Dakota
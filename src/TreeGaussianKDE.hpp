@@ -0,0 +1,86 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#ifndef TREE_GAUSSIAN_KDE_H
+#define TREE_GAUSSIAN_KDE_H
+
+#include "dakota_data_types.hpp"
+#include "SpatialIndex.hpp"
+
+
+namespace Dakota {
+
+
+/// Gaussian kernel density estimate evaluated on a k-d tree
+
+/** The product Gaussian kernel has a bandwidth in each dimension given
+    by Silverman's rule of thumb, as for the Pecos gaussian_kde.  The
+    samples are indexed in coordinates scaled by the bandwidths, with the
+    centroid and scatter of each node.  The density at a point sums the
+    kernels of nearby samples individually, while nodes on which the
+    mean kernel is tightly bounded contribute their size times the
+    midpoint of the bounds, such that the relative error of each density
+    value is at most relTol; a zero tolerance sums all kernels directly.  Evaluation
+    points are distributed among threads, each with its own traversal
+    storage, and the densities do not depend on the number of threads. */
+
+class TreeGaussianKDE
+{
+public:
+
+  /// constructor
+  TreeGaussianKDE(Real rel_tol = 0.);
+  /// destructor
+  ~TreeGaussianKDE();
+
+  /// set the bandwidths from and index the samples (one per column)
+  void initialize(const RealMatrix& samples);
+
+  /// kernel bandwidth in each dimension
+  const RealVector& bandwidths() const;
+
+  /// density at each column of points, distributed among up to
+  /// num_threads threads (thread budget if 0)
+  void pdf(const RealMatrix& points, RealVector& pdf_vals,
+	   size_t num_threads = 0) const;
+
+private:
+
+  /// node pending traversal, with the bounds on its mean kernel
+  struct NodeBounds {
+    size_t node;  ///< index of the node in scaledSamples
+    Real kLower;  ///< lower bound on the mean kernel
+    Real kUpper;  ///< upper bound on the mean kernel
+  };
+
+  /// density at x using the given node stack and scaled point storage
+  Real pdf(const Real* x, std::vector<NodeBounds>& node_stack,
+	   RealArray& scaled_x) const;
+  /// lower and upper bounds on the mean kernel of the samples of a node
+  /// at scaled_x
+  void kernel_bounds(size_t node, const Real* scaled_x, Real& k_lower,
+		     Real& k_upper) const;
+
+  /// bound on the relative error of the density values (0 = exact)
+  Real relTol;
+  /// kernel bandwidth in each dimension
+  RealVector kernelBandwidths;
+  /// normalization of the kernel sum: 1 / (N (2 pi)^{d/2} prod_d h_d)
+  Real pdfScale;
+  /// k-d tree of the samples scaled by the bandwidths
+  SpatialIndex scaledSamples;
+};
+
+
+inline const RealVector& TreeGaussianKDE::bandwidths() const
+{ return kernelBandwidths; }
+
+} // namespace Dakota
+
+#endif
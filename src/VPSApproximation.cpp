@@ -593,6 +593,10 @@ namespace Dakota
         
         #endif
         
+        // index the cell seeds for closest cell retrieval
+        _cell_index.initialize(_n_dim, _num_inserted_points);
+        for (size_t ipoint = 0; ipoint < _num_inserted_points; ipoint++) _cell_index.insert(_sample_points[ipoint]);
+        
         
         if (_vps_subsurrogate == LS)
         {
@@ -1905,23 +1909,9 @@ namespace Dakota
     
     size_t VPSApproximation::retrieve_closest_cell(double* x)
     {
-        size_t iclosest = _num_inserted_points;
-        double dmin = DBL_MAX;
-        for (size_t ipoint = 0; ipoint < _num_inserted_points; ipoint++)
-        {
-            double dd = 0.0;
-            for (size_t idim = 0; idim < _n_dim; idim++)
-            {
-                double dx = x[idim] - _sample_points[ipoint][idim];
-                dd += dx * dx;
-            }
-            if (dd < dmin)
-            {
-                dmin = dd;
-                iclosest = ipoint;
-            }
-        }
-        return iclosest;
+        // the Voronoi cell containing x is that of the nearest seed
+        size_t iclosest = _cell_index.nearest(x);
+        return (iclosest == _NPOS) ? _num_inserted_points : iclosest;
     }
     
     bool VPSApproximation::trim_line_using_Hyperplane(size_t num_dim,                               // number of dimensions
@@ -15,6 +15,7 @@
 #include "DakotaApproximation.hpp"
 #include "SharedSurfpackApproxData.hpp"
 #include "pecos_data_types.hpp" // to identify SDVArrays and SDRArrays
+#include "SpatialIndex.hpp"
 
 namespace Dakota
 {
@@ -234,6 +235,7 @@ private:
         size_t _vps_order, _num_GMRES;
         size_t* _num_cell_basis_functions; // number of basis functions for each cell
         double* _sample_vsize;  // furthest distance between seed and one of its Voronoi corners
+        SpatialIndex _cell_index; // spatial index of the cell seeds
         double* _vps_dfar;       // furthest distance between a seed and its extended neighbors
         double*** _sample_basis;  // centers of rbs for a given cell
         
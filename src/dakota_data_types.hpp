@@ -171,6 +171,7 @@ typedef std::map<int, int>             IntIntMap;
 typedef std::map<int, short>           IntShortMap;
 typedef std::map<unsigned long, unsigned long> ULongULongMap;
 typedef std::map<int, Real>            IntRealMap;
+typedef std::map<int, RealRealPair>    IntRealRealPairMap;
 typedef std::map<Real, Real>           RealRealMap;
 typedef std::map<String, Real>         StringRealMap;
 typedef std::multimap<Real, int>       RealIntMultiMap;
@@ -10,6 +10,7 @@
 #include "dakota_global_defs.hpp"
 #include "dakota_linear_algebra.hpp"
 #include "Teuchos_LAPACK.hpp"
+#include "Teuchos_BLAS.hpp"
 
 namespace Dakota {
 
@@ -77,6 +78,44 @@ void singular_values(RealMatrix& matrix, RealVector& singular_vals)
 }
 
 
+void left_singular_vectors(RealMatrix& matrix, RealVector& singular_vals,
+			   RealVector& work)
+{
+  Teuchos::LAPACK<int, Real> la;
+
+  char JOBU = 'O', JOBVT = 'N'; // overwrite A with U; no VT
+  int M(matrix.numRows());
+  int N(matrix.numCols());
+  int LDA = matrix.stride();
+  int num_singular_values = std::min(M, N);
+  if (singular_vals.length() != num_singular_values)
+    singular_vals.sizeUninitialized(num_singular_values);
+  int LDU = 1, LDVT = 1, info = 0;
+  Real *U = NULL, *VT = NULL, *RWORK = NULL;
+
+  Real work_query;
+  la.GESVD(JOBU, JOBVT, M, N, matrix[0], LDA, &singular_vals[0],
+	   U, LDU, VT, LDVT, &work_query, -1, RWORK, &info);
+  int work_size = (int)work_query;
+  if (work.length() < work_size)
+    work.sizeUninitialized(work_size);
+  la.GESVD(JOBU, JOBVT, M, N, matrix[0], LDA, &singular_vals[0],
+	   U, LDU, VT, LDVT, work.values(), work.length(), RWORK, &info);
+
+  if (info < 0) {
+    Cerr << "\nError: left_singular_vectors() failed. " << "The "
+	 << std::abs( info ) << "-th argument had an illegal value.\n";
+    abort_handler(-1);
+  }
+  if (info > 0) {
+    Cerr << "\nError: left_singular_vectors() failed. " << info
+	 << " superdiagonals of an intermediate bidiagonal form B did not "
+	 << "converge to 0.\n";
+    abort_handler(-1);
+  }
+}
+
+
 int qr(RealMatrix& A)
 {
   Teuchos::LAPACK<int, Real> la;
@@ -108,6 +147,52 @@ int qr(RealMatrix& A)
 }
 
 
+void thin_qr(RealMatrix& A, RealMatrix* R)
+{
+  Teuchos::LAPACK<int, Real> la;
+
+  int M = A.numRows();
+  int N = A.numCols();
+  int LDA = A.stride();
+  if (M < N) {
+    Cerr << "Error (thin_qr): matrix has fewer rows (" << M << ") than "
+	 << "columns (" << N << ")." << std::endl;
+    abort_handler(-1);
+  }
+  if (N == 0) {
+    if (R) R->shape(0, 0);
+    return;
+  }
+  RealVector TAU(N);
+  int info = 0;
+
+  Real work_query;
+  la.GEQRF(M, N, A.values(), LDA, TAU.values(), &work_query, -1, &info);
+  int work_size = (int)work_query;
+  la.ORGQR(M, N, N, A.values(), LDA, TAU.values(), &work_query, -1, &info);
+  work_size = std::max(work_size, (int)work_query);
+  RealVector work(work_size);
+
+  la.GEQRF(M, N, A.values(), LDA, TAU.values(), work.values(), work_size,
+	   &info);
+  if (info == 0 && R) {
+    R->shape(N, N);
+    for (int j=0; j<N; ++j)
+      for (int i=0; i<=j; ++i)
+	(*R)(i,j) = A(i,j);
+  }
+  if (info == 0)
+    la.ORGQR(M, N, N, A.values(), LDA, TAU.values(), work.values(), work_size,
+	     &info);
+
+  if (info < 0) {
+    Cerr << "Error (thin_qr): the " << -info << "-th argument had an illegal "
+	 << "value.";
+    abort_handler(-1);
+  }
+}
+
+
 /** Returns info > 0 if the matrix is singular */
 int qr_rsolve(const RealMatrix& q_r, bool transpose, RealMatrix& rhs)
 {
@@ -146,4 +231,32 @@ double det_AtransA(RealMatrix& A)
   return det;
 }
 
+
+Real cholesky_append(RealMatrix& chol_factor, const RealVector& a, Real alpha)
+{
+  int n = chol_factor.numRows();
+  if (chol_factor.numCols() != n || a.length() != n) {
+    Cerr << "Error (cholesky_append): a square factor and a new row of "
+	 << "matching length are required." << std::endl;
+    abort_handler(-1);
+  }
+
+  // border: L l = a, d = sqrt(alpha - l'l)
+  chol_factor.reshape(n+1, n+1);
+  int ld = chol_factor.stride();
+  Real* l_row = chol_factor.values() + n; // row n, stride between entries
+  for (int j=0; j<n; ++j)
+    l_row[j*ld] = a[j];
+  if (n) {
+    Teuchos::BLAS<int, Real> blas;
+    blas.TRSV(Teuchos::LOWER_TRI, Teuchos::NO_TRANS, Teuchos::NON_UNIT_DIAG,
+	      n, chol_factor.values(), ld, l_row, ld);
+  }
+  Real pivot = alpha;
+  for (int j=0; j<n; ++j)
+    pivot -= l_row[j*ld] * l_row[j*ld];
+  chol_factor(n,n) = (pivot > 0.) ? std::sqrt(pivot) : 0.;
+  return pivot;
+}
+
 }  // namespace Dakota
@@ -61,6 +61,17 @@ void svd(RealMatrix& matrix, RealVector& singular_vals, RealMatrix& v_trans,
 /// (A will be destroyed)
 void singular_values(RealMatrix& matrix, RealVector& singular_values);
 
+/**
+ * \brief Compute the singular values and left singular vectors of A
+
+   As for svd(), but without the right singular vectors, whose N x N
+   storage and computation dominate for wide matrices; the leading
+   min(M,N) columns of A are overwritten with U.  The LAPACK workspace
+   is grown as needed and may be reused across calls.
+ */
+void left_singular_vectors(RealMatrix& matrix, RealVector& singular_vals,
+			   RealVector& work);
+
 /**
  * \brief Compute an in-place QR factorization A = QR
 
@@ -69,6 +80,15 @@ void singular_values(RealMatrix& matrix, RealVector& singular_values);
  */
 int qr(RealMatrix& A);
 
+/**
+ * \brief Compute a thin QR factorization A = QR, overwriting A with Q
+
+   For M >= N, uses Teuchos::LAPACK.GEQRF() and ORGQR() to overwrite A
+   with the M x N orthonormal factor Q, optionally returning the N x N
+   upper triangular factor R.
+ */
+void thin_qr(RealMatrix& A, RealMatrix* R = NULL);
+
 /**
  * \brief Perform a multiple right-hand sides Rinv * rhs solve using
  * the R from a qr factorization.
@@ -80,6 +100,19 @@ int qr_rsolve(const RealMatrix& q_r, bool transpose, RealMatrix& rhs);
 /// Use SVD to compute det(A'*A), destroying A with the SVD
 double det_AtransA(RealMatrix& A);
 
+/**
+ * \brief Border a lower Cholesky factor with a row and column
+
+   Given the lower triangular factor L of an n x n SPD matrix A, the
+   n entries a of a new row of A and its diagonal entry alpha, grows
+   L to the (n+1) x (n+1) factor of [A a; a' alpha] at O(n^2) cost,
+   using Teuchos::BLAS.TRSV().  Returns the pivot alpha - l'l, the
+   square of the new diagonal entry; if it is not positive, the
+   extended matrix is not numerically SPD and the new diagonal entry
+   is left zero.
+ */
+Real cholesky_append(RealMatrix& chol_factor, const RealVector& a, Real alpha);
+
 }  // namespace Dakota
 
 #endif  // DAKOTA_LINEAR_ALGEBRA_H
@@ -12,6 +12,8 @@
 #include "DakotaVariables.hpp"
 #include "DakotaResponse.hpp"
 #include "ParamResponsePair.hpp"
+#include "TabularReader.hpp"
+#include "TabularWriter.hpp"
 
 namespace Dakota {
 
@@ -367,15 +369,15 @@ void write_data_tabular(const std::string& output_filename,
   if (error_flag)
     abort_handler(-1);
 
-  // TODO: consider removing TabularIO namespace
-  for (size_t row = 0; row < num_coeff_rows; ++row) {
-    for (size_t fn_ind = 0; fn_ind < num_fns; ++fn_ind)
-      Dakota::
-	write_data_tabular(output_stream, &output_coeffs[fn_ind][row], 1);
-    Dakota::
-      write_data_tabular(output_stream, &output_indices[row][0], num_vars);
-    output_stream << std::endl;
-  }
+  {
+    TabularWriter writer(output_stream);
+    for (size_t row = 0; row < num_coeff_rows; ++row) {
+      for (size_t fn_ind = 0; fn_ind < num_fns; ++fn_ind)
+	writer.write(output_coeffs[fn_ind][row]);
+      writer.write(&output_indices[row][0], num_vars);
+      writer.write_eol();
+    }
+  } // flush before close
 
   close_file(output_stream, output_filename, context_message);
 }
@@ -513,7 +515,7 @@ void print_expected_labels(bool active_only,
 // NOTE: Passing all these args around begs for a class to
 // encapsulate, BMA TODO: refactor procedural code
 std::vector<size_t>
-validate_header(std::ifstream& data_stream,
+validate_header(const StringArray& header_fields,
 		const std::string& input_filename,
 		const std::string& context_message,
 		const Variables& vars,
@@ -531,7 +533,6 @@ validate_header(std::ifstream& data_stream,
 
   StringArray expected_vars =
     vars.ordered_labels(active_only ? ACTIVE_VARS : ALL_VARS);
-  StringArray header_fields = read_header_tabular(data_stream, tabular_format);
   size_t read_fields = header_fields.size();
 
   std::vector<size_t> var_inds;  // only populated if reordering
@@ -601,6 +602,20 @@ validate_header(std::ifstream& data_stream,
 }
 
 
+std::vector<size_t>
+validate_header(std::ifstream& data_stream,
+		const std::string& input_filename,
+		const std::string& context_message,
+		const Variables& vars,
+		unsigned short tabular_format, bool verbose,
+		bool use_var_labels, bool active_only)
+{
+  return validate_header(read_header_tabular(data_stream, tabular_format),
+			 input_filename, context_message, vars, tabular_format,
+			 verbose, use_var_labels, active_only);
+}
+
+
 void read_data_tabular(const std::string& input_filename, 
 		       const std::string& context_message,
 		       RealVector& input_vector, size_t num_entries,
@@ -852,69 +867,85 @@ void read_data_tabular(const std::string& input_filename,
 }
 
 
+/** Each line is parsed in place by a TabularReader.  When the
+    variables to be read are all continuous, values are assigned
+    directly from the parsed fields (honoring any label-based
+    reordering); otherwise the line is read through the Variables and
+    Response tabular readers. */
 void read_data_tabular(const std::string& input_filename, 
 		       const std::string& context_message,
 		       Variables vars, Response resp, PRPList& input_prp,
 		       unsigned short tabular_format, bool verbose,
 		       bool use_var_labels, bool active_only)
 {
-  std::ifstream data_stream;
-  open_file(data_stream, input_filename, context_message);
+  TabularReader reader(input_filename, context_message, tabular_format);
 
   // only populated if reordering
   std::vector<size_t> var_inds =
-    validate_header(data_stream, input_filename, context_message, vars,
+    validate_header(reader.header(), input_filename, context_message, vars,
 		    tabular_format, verbose, use_var_labels, active_only);
 
   int eval_id = 0;  // number the evals starting from 1 if not contained in file
   String iface_id;
-  size_t line = (tabular_format & TABULAR_HEADER) ? 1 : 0;
 
-  size_t num_lead = 0;
-  if (tabular_format & TABULAR_EVAL_ID) ++num_lead;
-  if (tabular_format & TABULAR_IFACE_ID) ++num_lead;
+  size_t i, num_lead = reader.num_leading_columns(),
+    num_fns = resp.num_functions();
   size_t num_vars = active_only ? vars.total_active() : vars.tv();
-  size_t num_cols = num_lead + num_vars + resp.num_functions();;
-  // shouldn't need both good and eof checks
-  data_stream >> std::ws;
-  while (data_stream.good() && !data_stream.eof()) {
-    try {
-
-      // Read a line, then use existing vars/resp read functions
-      data_stream >> std::ws;
-      String row_str;
-      getline(data_stream, row_str);
-      ++line;
+  size_t num_cols = num_lead + num_vars + num_fns;
+  bool cv_only = active_only ? (vars.cv()  == num_vars) :
+                               (vars.acv() == num_vars);
+  RealVector cv_read, fn_read;
+  if (cv_only)
+    { cv_read.sizeUninitialized(num_vars); fn_read.sizeUninitialized(num_fns); }
+
+  while (reader.next_line()) {
+
+    size_t num_read = reader.num_fields();
+    if (num_read != num_cols) {
+      // TODO: more detailed message about column contents
+      Cerr << "\nError (" << context_message
+	   << "): wrong number of columns on line " << reader.line_number()
+	   << "\nof file '" << input_filename << "'; expected " << num_cols
+	   << ", found " << num_read << ".\n";
+      print_expected_format(Cerr, tabular_format, 0, num_cols);
+      abort_handler(IO_ERROR);
+    }
 
-      size_t num_read = strsplit(row_str).size(); // TODO: count without storing
-      if (num_read != num_cols) {
-	// TODO: more detailed message about column contents
+    if (cv_only) {
+      reader.leading_columns(eval_id, iface_id);
+      for (i=0; i<num_vars; ++i)
+	cv_read[i] = reader.real_field(num_lead +
+				       (var_inds.empty() ? i : var_inds[i]));
+      // as for Response::read_tabular(), non-numeric responses (e.g., N/A)
+      // are read leniently
+      for (i=0; i<num_fns; ++i)
+	fn_read[i] = reader.real_field(num_lead + num_vars + i, true);
+      if (active_only) vars.continuous_variables(cv_read);
+      else             vars.all_continuous_variables(cv_read);
+      resp.function_values(fn_read);
+    }
+    else {
+      try {
+	// use existing vars/resp read functions
+	String row_str = reader.line();
+	std::istringstream row_iss(var_inds.empty() ? row_str :
+				   reorder_row(row_str, var_inds, num_lead));
+	read_leading_columns(row_iss, tabular_format, eval_id, iface_id);
+	vars.read_tabular(row_iss, (active_only ? ACTIVE_VARS : ALL_VARS) );
+	resp.read_tabular(row_iss);
+      }
+      catch (const TabularDataTruncated& tdtrunc) {
+	// this will be thrown if either Variables or Response was truncated
 	Cerr << "\nError (" << context_message
-	     << "): wrong number of columns on line " << line << "\nof file '"
-	     << input_filename << "'; expected " << num_cols << ", found "
-	     << num_read << ".\n";
-	print_expected_format(Cerr, tabular_format, 0, num_cols);
+	     << "): could not read variables or responses from file "
+	     << input_filename << ";\n  "  << tdtrunc.what() << std::endl;
+	abort_handler(IO_ERROR);
+      }
+      catch(...) {
+	Cerr << "\nError (" << context_message << "): could not read file " 
+	     << input_filename << " (unknown error).";
 	abort_handler(IO_ERROR);
       }
-
-      std::istringstream row_iss(var_inds.empty() ? row_str :
-				 reorder_row(row_str, var_inds, num_lead));
-
-      read_leading_columns(row_iss, tabular_format, eval_id, iface_id);
-      vars.read_tabular(row_iss, (active_only ? ACTIVE_VARS : ALL_VARS) );
-      resp.read_tabular(row_iss);
-    }
-    catch (const TabularDataTruncated& tdtrunc) {
-      // this will be thrown if either Variables or Response was truncated
-      Cerr << "\nError (" << context_message
-	   << "): could not read variables or responses from file "
-	   << input_filename << ";\n  "  << tdtrunc.what() << std::endl;
-      abort_handler(IO_ERROR);
-    }
-    catch(...) {
-      Cerr << "\nError (" << context_message << "): could not read file " 
-	   << input_filename << " (unknown error).";
-      abort_handler(IO_ERROR);
     }
     if (verbose) {
       Cout << "Variables read:\n" << vars;
@@ -925,12 +956,7 @@ void read_data_tabular(const std::string& input_filename,
 
     // append deep copy of vars,resp as PRP
     input_prp.push_back(ParamResponsePair(vars, iface_id, resp, eval_id));
-
-    // advance so EOF can detect properly
-    data_stream >> std::ws;
   }
-
-  close_file(data_stream, input_filename, context_message);
 }
 
 
@@ -940,8 +966,7 @@ void read_data_tabular(const std::string& input_filename,
 		       size_t num_rows, size_t num_cols,
 		       unsigned short tabular_format, bool verbose)
 {
-  std::ifstream input_stream;
-  open_file(input_stream, input_filename, context_message);
+  TabularReader reader(input_filename, context_message, tabular_format);
 
   if (verbose) {
     Cout << "\nAttempting to read " << num_rows << " x " << num_cols << " = "
@@ -950,86 +975,47 @@ void read_data_tabular(const std::string& input_filename,
 	 << " file " << input_filename << "..." << std::endl;
   }
 
-  read_header_tabular(input_stream, tabular_format);
-
-  input_matrix.shapeUninitialized(num_rows, num_cols);	
-  for (size_t row_ind = 0; row_ind < num_rows; ++row_ind) {
-    try {
-      // experiment data would never have an interface ID
-      if (tabular_format & TABULAR_EVAL_ID) {
-	// discard the row label (typically eval or data ID)
-	size_t discard_row_label;
-	input_stream >> discard_row_label;
-      }
-      for (size_t col_ind = 0; col_ind < num_cols; ++col_ind)
-	input_stream >> input_matrix(row_ind, col_ind);
-    }
-    catch (const std::ios_base::failure& failorbad_except) {
+  // each record is a row of input_matrix: read it in place with a stride
+  input_matrix.shapeUninitialized(num_rows, num_cols);
+  size_t lda = input_matrix.stride();
+  for (size_t row_ind = 0; row_ind < num_rows; ++row_ind)
+    if (!reader.read_record(input_matrix.values() + row_ind, num_cols, lda)) {
       Cerr << "\nError (" << context_message << "): could not read file.";
       print_expected_format(Cerr, tabular_format, num_rows, num_cols);
       abort_handler(-1);
     }
-  }
 
-  if (exists_extra_data(input_stream))
+  if (reader.exists_extra_data())
     print_unexpected_data(Cout, input_filename, context_message, tabular_format);
-
-  close_file(input_stream, input_filename, context_message);
 }
 
 
+/** Records are parsed directly into the columns of input_matrix,
+    which grows geometrically, rather than through per-record vectors
+    and a final transposed copy. */
 void read_data_tabular(const std::string& input_filename,
 		       const std::string& context_message,
 		       RealMatrix& input_matrix, size_t record_len,
 		       unsigned short tabular_format, bool verbose)
 {
-  std::ifstream input_stream;
-  open_file(input_stream, input_filename, context_message);
-
-  RealVectorArray rva;
-  RealVector read_rv(record_len);
-  try {
-
-    read_header_tabular(input_stream, tabular_format);
-
-    input_stream >> std::ws;
-    while (input_stream.good() && !input_stream.eof()) {
-
-      // discard any leading columns; annotated is unlikely in this case
-      read_leading_columns(input_stream, tabular_format);
-
-      // read the (required) coefficients of length num_fns
-      read_rv = std::numeric_limits<Real>::quiet_NaN();
-      if (input_stream >> read_rv) {
-	if (verbose) Cout << "read:\n" << read_rv;
-	rva.push_back(read_rv);
-      }
-      else {
-	Cerr << "\nError (" << context_message << "): unexpected row read "
-	     << "error in file " << input_filename << ".\nread:\n" << read_rv;
-	abort_handler(-1);
-      }
-      input_stream >> std::ws; // advance to next input for EOF detection
+  TabularReader reader(input_filename, context_message, tabular_format);
+
+  size_t num_records = 0, capacity = 0;
+  input_matrix.shapeUninitialized(record_len, 0);
+  for (;;) {
+    if (num_records == capacity) {
+      capacity = std::max((size_t)1024, 2*capacity);
+      input_matrix.reshape(record_len, capacity);
     }
+    if (!reader.read_record(input_matrix[num_records], record_len))
+      break;
+    if (verbose) {
+      RealVector read_rv(Teuchos::View, input_matrix[num_records], record_len);
+      Cout << "read:\n" << read_rv;
+    }
+    ++num_records;
   }
-  catch (const std::ios_base::failure& failorbad_except) {
-    Cerr << "\nError (" << context_message << "): could not read file " 
-	 << input_filename << ".";
-    print_expected_format(Cerr, tabular_format, 0, record_len);
-    abort_handler(-1);
-  }
-  catch(...) {
-    Cerr << "\nError (" << context_message << "): could not read file " 
-	 << input_filename << " (unknown error).";
-    abort_handler(-1);
-  }
-
-  // this transposes the rva tabular layout (num_records X record_len) into the
-  // rm layout (record_len X num_records), since the natural place to store the
-  // ith vector rva[i] is as rm[i], a Teuchos column vector.
-  copy_data_transpose(rva, input_matrix);
-
-  close_file(input_stream, input_filename, context_message);
+  input_matrix.reshape(record_len, num_records);
 }
 
 
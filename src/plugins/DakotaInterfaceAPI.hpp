@@ -52,6 +52,66 @@ public:
 };
 
 
+/** Data to send a batch of evaluation requests to the interface plugin
+    API in contiguous, column-major storage with one column per
+    evaluation.  The pointers reference storage owned by Dakota that is
+    valid for the duration of the evaluate_batch() call. */
+class BatchEvalRequest {
+
+public:
+  size_t numEvals = 0;
+  size_t numContinuousVars = 0;
+  size_t numDiscreteIntVars = 0;
+  size_t numDiscreteStringVars = 0;
+  size_t numDiscreteRealVars = 0;
+  size_t numFunctions = 0;
+
+  /// numContinuousVars x numEvals
+  const double* continuousVars = nullptr;
+  /// numDiscreteIntVars x numEvals
+  const int* discreteIntVars = nullptr;
+  /// numDiscreteStringVars x numEvals
+  const std::string* discreteStringVars = nullptr;
+  /// numDiscreteRealVars x numEvals
+  const double* discreteRealVars = nullptr;
+
+  /// active set vectors: numFunctions x numEvals
+  const short* activeSet = nullptr;
+  /// 1-based IDs of derivative variables, shared by all evaluations
+  std::vector<size_t> derivativeVars;
+
+  // labels are shared by all evaluations
+  std::vector<std::string> continuousLabels;
+  std::vector<std::string> discreteIntLabels;
+  std::vector<std::string> discreteStringLabels;
+  std::vector<std::string> discreteRealLabels;
+  std::vector<std::string> inputOrderedLabels;
+
+  /// numEvals evaluation ids
+  const int* functionEvalIds = nullptr;
+
+};
+
+
+/** Preallocated, zero-initialized output storage for a batch of
+    evaluations, in which only the results requested by the active set
+    need to be written.  For evaluation j and function i, with
+    k = j * numFunctions + i and nd = derivativeVars.size():
+    functions[k] is the value, gradients[k*nd + r] the derivative with
+    respect to derivative variable r, and hessians[(k*nd + c)*nd + r]
+    the (r,c) Hessian entry, of which only the lower triangle (r >= c)
+    is read.  gradients and hessians are null unless requested by some
+    evaluation. */
+class BatchEvalResponse {
+
+public:
+  double* functions = nullptr;
+  double* gradients = nullptr;
+  double* hessians = nullptr;
+
+};
+
+
 /** API for Dakota plugin Interfaces. Only std c++ allowed as
     specializations must be able to compile without Dakota.
  */
@@ -103,6 +163,67 @@ public:
 
   virtual void finalize() {};
 
+  // New virtual functions are appended here, preserving the vtable
+  // layout seen by plugins built against earlier versions of this API
+
+  /// whether the single evaluator may be invoked concurrently from
+  /// multiple threads, enabling asynchronous evaluations
+  virtual bool thread_safe() const { return false; }
+
+  /// contiguous batch evaluator; the default implementation delegates
+  /// to the batch evaluator above, copying data in and out
+  virtual void evaluate_batch(BatchEvalRequest const& request,
+                              BatchEvalResponse& response) {
+    size_t const num_evals = request.numEvals,
+      num_fns = request.numFunctions,
+      num_derivs = request.derivativeVars.size();
+    std::vector<EvalRequest> requests(num_evals);
+    for (size_t j = 0; j < num_evals; ++j) {
+      EvalRequest& req = requests[j];
+      req.continuousVars.assign(
+          request.continuousVars + j*request.numContinuousVars,
+          request.continuousVars + (j+1)*request.numContinuousVars);
+      req.discreteIntVars.assign(
+          request.discreteIntVars + j*request.numDiscreteIntVars,
+          request.discreteIntVars + (j+1)*request.numDiscreteIntVars);
+      req.discreteStringVars.assign(
+          request.discreteStringVars + j*request.numDiscreteStringVars,
+          request.discreteStringVars + (j+1)*request.numDiscreteStringVars);
+      req.discreteRealVars.assign(
+          request.discreteRealVars + j*request.numDiscreteRealVars,
+          request.discreteRealVars + (j+1)*request.numDiscreteRealVars);
+      req.continuousLabels = request.continuousLabels;
+      req.discreteIntLabels = request.discreteIntLabels;
+      req.discreteStringLabels = request.discreteStringLabels;
+      req.discreteRealLabels = request.discreteRealLabels;
+      req.activeSet.assign(request.activeSet + j*num_fns,
+                           request.activeSet + (j+1)*num_fns);
+      req.derivativeVars = request.derivativeVars;
+      req.inputOrderedLabels = request.inputOrderedLabels;
+      req.functionEvalId = request.functionEvalIds[j];
+    }
+
+    std::vector<EvalResponse> const responses = evaluate(requests);
+
+    for (size_t j = 0; j < num_evals; ++j) {
+      for (size_t i = 0; i < num_fns; ++i) {
+        size_t const k = j*num_fns + i;
+        short const asv = request.activeSet[k];
+        if (asv & 1)
+          response.functions[k] = responses[j].functions[i];
+        if (asv & 2)
+          for (size_t r = 0; r < num_derivs; ++r)
+            response.gradients[k*num_derivs + r]
+              = responses[j].gradients[i][r];
+        if (asv & 4)
+          for (size_t c = 0; c < num_derivs; ++c)
+            for (size_t r = c; r < num_derivs; ++r)
+              response.hessians[(k*num_derivs + c)*num_derivs + r]
+                = responses[j].hessians[i][r][c];
+      }
+    }
+  }
+
 protected:
 
   void resize_response_arrays(
@@ -36,6 +36,30 @@ DP::EvalResponse PluginIdentityMap::evaluate(DP::EvalRequest const& request) {
 
 }
 
+void PluginIdentityMap::evaluate_batch(DP::BatchEvalRequest const& request,
+    DP::BatchEvalResponse& response) {
+
+  size_t const num_fns = request.numFunctions;
+  size_t const num_vars = request.numContinuousVars;
+  size_t const num_derivs = request.derivativeVars.size();
+
+  // outputs are zero-initialized: only the nonzeros are written
+  for (size_t j = 0; j < request.numEvals; ++j) {
+    double const* x = request.continuousVars + j*num_vars;
+    for (size_t i = 0; i < num_fns; ++i) {
+      size_t const k = j*num_fns + i;
+      short const asv = request.activeSet[k];
+      if (asv & 1) {
+        response.functions[k] = x[i];
+      }
+      if ((asv & 2) && i < num_derivs) {
+        response.gradients[k*num_derivs + i] = 1.;
+      }
+    }
+  }
+
+}
+
 void PluginIdentityMap::evaluate_functions(size_t const idx,
     DP::EvalRequest const& request,
     DP::EvalResponse& response) {
@@ -20,6 +20,10 @@ public:
   DakotaPlugins::EvalResponse evaluate(
       DakotaPlugins::EvalRequest const& request) override;
 
+  /// evaluate a whole batch directly in Dakota's contiguous storage
+  void evaluate_batch(DakotaPlugins::BatchEvalRequest const& request,
+      DakotaPlugins::BatchEvalResponse& response) override;
+
 private:
   void evaluate_functions(size_t const idx,
       DakotaPlugins::EvalRequest const& request,
@@ -15,6 +15,7 @@
 #include <boost/program_options.hpp>
 #include "dakota_system_defs.hpp"
 #include "dakota_data_types.hpp"
+#include "OutputManager.hpp"
 #include "ParamResponsePair.hpp"
 #include "PRPMultiIndex.hpp"
 #include "RestartVersion.hpp"
@@ -222,21 +223,7 @@ void print_restart(StringArray pos_args, String print_dest)
 
   try {
 
-    RestartVersion rst_ver =
-      RestartVersion::check_restart_version(read_restart_filename);
-
-    std::ifstream restart_input_fs(read_restart_filename.c_str(),
-				   std::ios::binary);
-    if (!restart_input_fs.good()) {
-      Cerr << "\nError: could not open restart file '"
-	   << read_restart_filename << "' for reading."<< std::endl;
-      exit(-1);
-    }
-    boost::archive::binary_iarchive restart_input_archive(restart_input_fs);
-
-    // re-read the full, correct version info from the new stream
-    if (RestartVersion::restartFirstVersionNumber <= rst_ver.restartVersion)
-      restart_input_archive & rst_ver;
+    RestartReader rst_reader(read_restart_filename);
 
     cout << "Reading restart file '" << read_restart_filename << "'."
 	 << std::endl;
@@ -251,21 +238,9 @@ void print_restart(StringArray pos_args, String print_dest)
     write_precision = 16;
 
     int cntr = 0;
-    restart_input_fs.peek();  // peek to force EOF if no records in restart file
-    while (restart_input_fs.good() && !restart_input_fs.eof()) {
-
-      ParamResponsePair current_pair;
-      try { 
-	restart_input_archive & current_pair; 
-      }
-      catch(const boost::archive::archive_exception& e) {
-	// No current way a user can recover from this with remove_ids
-	Cerr << "\nError reading restart file '" << read_restart_filename
-	     << "'.\nDetails (boost::archive exception):      "
-	     << e.what() << std::endl;
-	abort_handler(-1);
-      }
-      // serialization functions no longer throw strings
+    // reading stops (with a warning) at any corrupt record
+    ParamResponsePair current_pair;
+    while (rst_reader.read_prp(current_pair)) {
 
       cntr++;
       if (print_dest == "stdout")
@@ -277,8 +252,7 @@ void print_restart(StringArray pos_args, String print_dest)
       else if (print_dest == "neutral_file")
 	current_pair.write_annotated(neutral_file_stream);
 
-      // peek to force EOF if the last restart record was read
-      restart_input_fs.peek();
+      current_pair = ParamResponsePair();
     }
     if (print_dest == "neutral_file")
       neutral_file_stream.close();
@@ -313,41 +287,15 @@ void print_restart_pdb(StringArray pos_args, String print_dest)
     exit(-1);
   }
 
-  RestartVersion rst_ver =
-    RestartVersion::check_restart_version(pos_args[0]);
-
-  std::ifstream restart_input_fs(pos_args[0].c_str(), std::ios::binary);
-  if (!restart_input_fs.good()) {
-    Cerr << "Error: failed to open restart file " << pos_args[0] << endl;
-    exit(-1);
-  }
-  boost::archive::binary_iarchive restart_input_archive(restart_input_fs);
-
-  // re-read the full, correct version info from the new stream
-  if (RestartVersion::restartFirstVersionNumber <= rst_ver.restartVersion)
-    restart_input_archive & rst_ver;
+  RestartReader rst_reader(pos_args[0]);
 
   size_t i, j, num_evals = 0;
   PRPCache read_pairs;
-  restart_input_fs.peek();  // peek to force EOF if no records in restart file
-  while (restart_input_fs.good() && !restart_input_fs.eof()) {
-
-    ParamResponsePair current_pair;
-    try {
-      restart_input_archive & current_pair;
-    }
-    catch(const boost::archive::archive_exception& e) {
-      Cerr << "\nError reading restart file (boost::archive exception):\n" 
-	   << e.what() << std::endl;
-      abort_handler(-1);
-    }
-    // serialization functions no longer throw strings
-
+  PRPArray rst_pairs;
+  rst_reader.read_prps(rst_pairs);
+  for (const ParamResponsePair& current_pair : rst_pairs) {
     read_pairs.insert(current_pair);
     ++num_evals;
-
-    // peek to force EOF if the last restart record was read
-    restart_input_fs.peek();
   }
 
   PRPCacheCIter prp_iter = read_pairs.begin();
@@ -476,21 +424,7 @@ void print_restart_tabular(StringArray pos_args, String print_dest,
 
   try {
 
-    RestartVersion rst_ver =
-      RestartVersion::check_restart_version(read_restart_filename);
-
-    std::ifstream restart_input_fs(read_restart_filename.c_str(),
-				   std::ios::binary);
-    if (!restart_input_fs.good()) {
-      Cerr << "\nError: could not open restart file '"
-	   << read_restart_filename << "' for reading."<< std::endl;
-      exit(-1);
-    }
-    boost::archive::binary_iarchive restart_input_archive(restart_input_fs);
-
-    // re-read the full, correct version info from the new stream
-    if (RestartVersion::restartFirstVersionNumber <= rst_ver.restartVersion)
-      restart_input_archive & rst_ver;
+    RestartReader rst_reader(read_restart_filename);
 
     cout << "Reading restart file '" << read_restart_filename << "'."
 	 << std::endl;
@@ -513,21 +447,9 @@ void print_restart_tabular(StringArray pos_args, String print_dest,
     int wp_save = write_precision;  // later restore since this is global data
     write_precision = tabular_precision;
 
-    restart_input_fs.peek();  // peek to force EOF if no records in restart file
-    while (restart_input_fs.good() && !restart_input_fs.eof()) {
-
-      ParamResponsePair current_pair;
-      try {
-	restart_input_archive & current_pair;
-      }
-      catch(const boost::archive::archive_exception& e) {
-	// No current way a user can recover from this with remove_ids
-	Cerr << "\nError reading restart file '" << read_restart_filename
-	     << "'.\nDetails (boost::archive exception):      "
-	     << e.what() << std::endl;
-	abort_handler(-1);
-      }
-      // serialization functions no longer throw strings
+    // reading stops (with a warning) at any corrupt record
+    ParamResponsePair current_pair;
+    while (rst_reader.read_prp(current_pair)) {
 
       // The number of variables or responses may differ across
       // different interfaces.  Output the header when needed due to
@@ -558,8 +480,7 @@ void print_restart_tabular(StringArray pos_args, String print_dest,
       current_pair.write_tabular(tabular_text, tabular_format);  // also writes IDs
       ++num_evals;
 
-      // peek to force EOF if the last restart record was read
-      restart_input_fs.peek();
+      current_pair = ParamResponsePair();
     }
 
     cout << "Restart file processing completed: " << num_evals
@@ -607,14 +528,8 @@ void read_neutral(StringArray pos_args)
 
   try {
 
-    std::ofstream restart_output_fs(write_restart_filename.c_str(),
-				    std::ios::binary);
-    if (!restart_output_fs.good()) {
-      Cerr << "\nError: could not open restart file '"
-	   << write_restart_filename << "' for writing."<< std::endl;
-      abort_handler(IO_ERROR);
-    }
-    boost::archive::binary_oarchive restart_output_archive(restart_output_fs);
+    RestartWriter rst_writer(write_restart_filename);
+    rst_writer.flush_interval(-1); // flushed when complete
     cout << "Writing new restart file " << write_restart_filename << '\n';
 
     int cntr = 0;
@@ -630,13 +545,12 @@ void read_neutral(StringArray pos_args)
 	     << std::endl;
 	abort_handler(-1);
       }
-      restart_output_archive & current_pair;
+      rst_writer.append_prp(current_pair);
       cntr++;
       neutral_file_stream >> std::ws;
     }
     cout << "Neutral file processing completed: " << cntr
 	 << " evaluations retrieved.\n";
-    restart_output_fs.close();
 
   }
   catch (const boost::archive::archive_exception& e) {
@@ -713,47 +627,17 @@ void repair_restart(StringArray pos_args, String identifier_type)
 
   try {
 
-    RestartVersion rst_ver =
-      RestartVersion::check_restart_version(read_restart_filename);
+    RestartReader rst_reader(read_restart_filename);
 
-    std::ifstream restart_input_fs(read_restart_filename.c_str(),
-				   std::ios::binary);
-    if (!restart_input_fs.good()) {
-      Cerr << "\nError: could not open restart file '"
-	   << read_restart_filename << "' for reading."<< std::endl;
-      abort_handler(IO_ERROR);
-    }
-    boost::archive::binary_iarchive restart_input_archive(restart_input_fs);
-
-    // re-read the full, correct version info from the new stream
-    if (RestartVersion::restartFirstVersionNumber <= rst_ver.restartVersion)
-      restart_input_archive & rst_ver;
-
-    std::ofstream restart_output_fs(write_restart_filename.c_str(),
-				    std::ios::binary);
-    if (!restart_output_fs.good()) {
-      Cerr << "\nError: could not open restart file '"
-	   << write_restart_filename << "' for writing."<< std::endl;
-      abort_handler(IO_ERROR);
-    }
-    boost::archive::binary_oarchive restart_output_archive(restart_output_fs);
+    RestartWriter rst_writer(write_restart_filename);
+    rst_writer.flush_interval(-1); // flushed when complete
 
     cout << "Writing new restart file " << write_restart_filename << '\n';
 
+    // a corrupt or incomplete tail is dropped (with a warning)
     int cntr = 0, good_cntr = 0;
-    restart_input_fs.peek();  // peek to force EOF if no records in restart file
-    while (restart_input_fs.good() && !restart_input_fs.eof()) {
-
-      ParamResponsePair current_pair;
-      try {
-	restart_input_archive & current_pair;
-      }
-      catch(const boost::archive::archive_exception& e) {
-	Cerr << "\nError reading restart file '" << read_restart_filename
-	     << "'.\nDetails (boost::archive exception):      "
-	     << e.what() << std::endl;
-	abort_handler(IO_ERROR);
-      }
+    ParamResponsePair current_pair;
+    while (rst_reader.read_prp(current_pair)) {
 
       cntr++;
 
@@ -775,16 +659,14 @@ void repair_restart(StringArray pos_args, String identifier_type)
 
       // if current_pair is bad, omit it from the new restart file
       if (!bad_flag) {
-	restart_output_archive & current_pair;
+	rst_writer.append_prp(current_pair);
 	good_cntr++;
       }
 
-      // peek to force EOF if the last restart record was read
-      restart_input_fs.peek();
+      current_pair = ParamResponsePair();
     }
     cout << "Restart repair completed: " << cntr << " evaluations retrieved"
 	 << ", " << cntr-good_cntr << " removed, " << good_cntr << " saved.\n";
-    restart_output_fs.close();
 
   }
   catch (const boost::archive::archive_exception& e) {
@@ -817,60 +699,24 @@ void concatenate_restart(StringArray pos_args)
   try {
 
     String write_restart_filename = pos_args.back(); pos_args.pop_back();
-    std::ofstream restart_output_fs(write_restart_filename.c_str(),
-				    std::ios::binary);
-    if (!restart_output_fs.good()) {
-      Cerr << "\nError: could not open restart file '"
-	   << write_restart_filename << "' for writing."<< std::endl;
-      exit(-1);
-    }
-    boost::archive::binary_oarchive restart_output_archive(restart_output_fs);
+    RestartWriter rst_writer(write_restart_filename);
+    rst_writer.flush_interval(-1); // flushed when complete
 
     cout << "Writing new restart file " << write_restart_filename << '\n';
 
     for(const String& rst_file : pos_args) {
 
-      RestartVersion rst_ver =
-	RestartVersion::check_restart_version(rst_file);
-
-      std::ifstream restart_input_fs(rst_file.c_str(), std::ios::binary);
-      if (!restart_input_fs.good()) {
-	Cerr << "\nError: could not open restart file '"
-	     << rst_file << "' for reading."<< std::endl;
-	exit(-1);
-      }
-      boost::archive::binary_iarchive restart_input_archive(restart_input_fs);
-
-      // re-read the full, correct version info from the new stream
-      if (RestartVersion::restartFirstVersionNumber <= rst_ver.restartVersion)
-	restart_input_archive & rst_ver;
-
-      int cntr = 0;
-      restart_input_fs.peek();  // peek to force EOF if no records in restart file
-      while (restart_input_fs.good() && !restart_input_fs.eof()) {
+      RestartReader rst_reader(rst_file);
 
-	ParamResponsePair current_pair;
-	try {
-	  restart_input_archive & current_pair;
-	}
-	catch(const boost::archive::archive_exception& e) {
-	  Cerr << "\nError reading restart file '" << rst_file
-	       << "'.\nDetails (boost::archive exception):      "
-	       << e.what() << std::endl;
-	  abort_handler(-1);
-	}
-	// serialization functions no longer throw strings
-	restart_output_archive & current_pair;
-	cntr++;
- 
-	// peek to force EOF if the last restart record was read
-	restart_input_fs.peek();
-      }
+      // records of each file are decoded concurrently, then appended
+      PRPArray rst_pairs;
+      size_t cntr = rst_reader.read_prps(rst_pairs);
+      for (const ParamResponsePair& current_pair : rst_pairs)
+	rst_writer.append_prp(current_pair);
 
       cout << rst_file << " processing completed: " << cntr
 	   << " evaluations retrieved.\n";
     }
-    restart_output_fs.close();
 
   }
   catch (const boost::archive::archive_exception& e) {
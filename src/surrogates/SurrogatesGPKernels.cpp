@@ -9,6 +9,8 @@
 
 #include "SurrogatesGPKernels.hpp"
 
+#include <algorithm>
+
 namespace dakota {
 namespace surrogates {
 
@@ -36,6 +38,14 @@ void SquaredExponentialKernel::compute_gram_derivs(
   }
 }
 
+void SquaredExponentialKernel::compute_gram_tile(
+    const Eigen::ArrayXXd& Dbar2_tile, const double sig2,
+    bool compute_deriv_weights, Eigen::ArrayXXd& gram_tile,
+    Eigen::ArrayXXd& deriv_weight_tile) const {
+  gram_tile = sig2 * (-0.5 * Dbar2_tile).exp();
+  if (compute_deriv_weights) deriv_weight_tile = gram_tile;
+}
+
 MatrixXd SquaredExponentialKernel::compute_first_deriv_pred_gram(
     const MatrixXd& pred_gram, const std::vector<MatrixXd>& mixed_dists,
     const VectorXd& theta_values, const int index) {
@@ -84,6 +94,20 @@ void Matern32Kernel::compute_gram_derivs(const MatrixXd& gram,
   }
 }
 
+void Matern32Kernel::compute_gram_tile(
+    const Eigen::ArrayXXd& Dbar2_tile, const double sig2,
+    bool compute_deriv_weights, Eigen::ArrayXXd& gram_tile,
+    Eigen::ArrayXXd& deriv_weight_tile) const {
+  /* gram_tile holds sqrt(3)*Dbar, then exp(-sqrt(3)*Dbar), then the kernel */
+  gram_tile = sqrt3 * Dbar2_tile.sqrt();
+  if (compute_deriv_weights) {
+    deriv_weight_tile = (-gram_tile).exp();
+    gram_tile = sig2 * (1.0 + gram_tile) * deriv_weight_tile;
+    deriv_weight_tile *= 3.0 * sig2;
+  } else
+    gram_tile = sig2 * (1.0 + gram_tile) * (-gram_tile).exp();
+}
+
 MatrixXd Matern32Kernel::compute_first_deriv_pred_gram(
     const MatrixXd& pred_gram, const std::vector<MatrixXd>& mixed_dists,
     const VectorXd& theta_values, const int index) {
@@ -138,6 +162,19 @@ void Matern52Kernel::compute_gram_derivs(const MatrixXd& gram,
   }
 }
 
+void Matern52Kernel::compute_gram_tile(
+    const Eigen::ArrayXXd& Dbar2_tile, const double sig2,
+    bool compute_deriv_weights, Eigen::ArrayXXd& gram_tile,
+    Eigen::ArrayXXd& deriv_weight_tile) const {
+  /* gram_tile holds sqrt(5)*Dbar before it is overwritten by the kernel */
+  gram_tile = sqrt5 * Dbar2_tile.sqrt();
+  if (compute_deriv_weights)
+    deriv_weight_tile =
+        5.0 / 3.0 * sig2 * (1.0 + gram_tile) * (-gram_tile).exp();
+  gram_tile = sig2 * (1.0 + gram_tile + gram_tile.square() / 3.0) *
+              (-gram_tile).exp();
+}
+
 MatrixXd Matern52Kernel::compute_first_deriv_pred_gram(
     const MatrixXd& pred_gram, const std::vector<MatrixXd>& mixed_dists,
     const VectorXd& theta_values, const int index) {
@@ -215,6 +252,106 @@ void Kernel::compute_Dbar(const std::vector<MatrixXd>& dists2,
   if (take_sqrt) Dbar = Dbar2.cwiseSqrt();
 }
 
+void Kernel::compute_Dbar2_tile(const MatrixXd& scaled_a,
+                                const MatrixXd& scaled_b, const int row_a,
+                                const int row_b, const int num_a,
+                                const int num_b, Eigen::ArrayXXd& Dbar2_tile) {
+  const int num_variables = scaled_a.cols();
+  Dbar2_tile.setZero(num_a, num_b);
+  for (int k = 0; k < num_variables; k++) {
+    const auto col_a = scaled_a.col(k).segment(row_a, num_a).array();
+    for (int j = 0; j < num_b; j++)
+      Dbar2_tile.col(j) += (col_a - scaled_b(row_b + j, k)).square();
+  }
+}
+
+void Kernel::compute_gram(const MatrixXd& points_a, const MatrixXd& points_b,
+                          const VectorXd& theta_values, MatrixXd& gram) const {
+  const int num_a = points_a.rows();
+  const int num_b = points_b.rows();
+  const int num_variables = points_a.cols();
+  const double sig2 = exp(2.0 * theta_values(0));
+  /* scaling the points once by the inverse length-scales lets each tile
+     accumulate Dbar2 directly */
+  const VectorXd inv_ls = (-theta_values.tail(num_variables)).array().exp();
+  const MatrixXd scaled_a = points_a * inv_ls.asDiagonal();
+  const MatrixXd scaled_b = points_b * inv_ls.asDiagonal();
+
+  gram.resize(num_a, num_b);
+  Eigen::ArrayXXd Dbar2_tile, gram_tile, unused;
+  for (int jb = 0; jb < num_b; jb += gramTileSize) {
+    const int nb = std::min(gramTileSize, num_b - jb);
+    for (int ib = 0; ib < num_a; ib += gramTileSize) {
+      const int na = std::min(gramTileSize, num_a - ib);
+      compute_Dbar2_tile(scaled_a, scaled_b, ib, jb, na, nb, Dbar2_tile);
+      compute_gram_tile(Dbar2_tile, sig2, false, gram_tile, unused);
+      gram.block(ib, jb, na, nb) = gram_tile.matrix();
+    }
+  }
+}
+
+void Kernel::compute_gram(const MatrixXd& points, const VectorXd& theta_values,
+                          MatrixXd& gram) const {
+  const int num_points = points.rows();
+  const int num_variables = points.cols();
+  const double sig2 = exp(2.0 * theta_values(0));
+  const VectorXd inv_ls = (-theta_values.tail(num_variables)).array().exp();
+  const MatrixXd scaled = points * inv_ls.asDiagonal();
+
+  gram.resize(num_points, num_points);
+  Eigen::ArrayXXd Dbar2_tile, gram_tile, unused;
+  for (int jb = 0; jb < num_points; jb += gramTileSize) {
+    const int nb = std::min(gramTileSize, num_points - jb);
+    for (int ib = 0; ib <= jb; ib += gramTileSize) {
+      const int na = std::min(gramTileSize, num_points - ib);
+      compute_Dbar2_tile(scaled, scaled, ib, jb, na, nb, Dbar2_tile);
+      compute_gram_tile(Dbar2_tile, sig2, false, gram_tile, unused);
+      gram.block(ib, jb, na, nb) = gram_tile.matrix();
+      if (ib != jb)
+        gram.block(jb, ib, nb, na) = gram_tile.matrix().transpose();
+    }
+  }
+}
+
+void Kernel::contract_gram_derivs(const MatrixXd& points,
+                                  const VectorXd& theta_values,
+                                  const MatrixXd& weights,
+                                  VectorXd& gram_derivs_dot) const {
+  const int num_points = points.rows();
+  const int num_variables = points.cols();
+  const double sig2 = exp(2.0 * theta_values(0));
+  const VectorXd inv_ls = (-theta_values.tail(num_variables)).array().exp();
+  const MatrixXd scaled = points * inv_ls.asDiagonal();
+
+  gram_derivs_dot.setZero(num_variables + 1);
+  Eigen::ArrayXXd Dbar2_tile, gram_tile, deriv_weight_tile, weight_tile;
+  for (int jb = 0; jb < num_points; jb += gramTileSize) {
+    const int nb = std::min(gramTileSize, num_points - jb);
+    for (int ib = 0; ib <= jb; ib += gramTileSize) {
+      const int na = std::min(gramTileSize, num_points - ib);
+      compute_Dbar2_tile(scaled, scaled, ib, jb, na, nb, Dbar2_tile);
+      compute_gram_tile(Dbar2_tile, sig2, true, gram_tile, deriv_weight_tile);
+      /* an upper tile also accounts for its mirror image in the lower
+         triangle, which shares the same Gram matrix derivatives */
+      weight_tile = weights.block(ib, jb, na, nb).array();
+      if (ib != jb)
+        weight_tile += weights.block(jb, ib, nb, na).transpose().array();
+      /* d/dtheta_0 = 2 * gram */
+      gram_derivs_dot(0) += 2.0 * (gram_tile * weight_tile).sum();
+      /* d/dtheta_k = deriv_weight * (scaled component distance)^2 */
+      deriv_weight_tile *= weight_tile;
+      for (int k = 0; k < num_variables; k++) {
+        const auto col_a = scaled.col(k).segment(ib, na).array();
+        double sum = 0.0;
+        for (int j = 0; j < nb; j++)
+          sum += (deriv_weight_tile.col(j) *
+                  (col_a - scaled(jb + j, k)).square()).sum();
+        gram_derivs_dot(k + 1) += sum;
+      }
+    }
+  }
+}
+
 std::shared_ptr<Kernel> kernel_factory(const std::string& kernel_type) {
   if (kernel_type == "squared exponential") {
     return std::make_shared<SquaredExponentialKernel>();
@@ -83,7 +83,64 @@ class Kernel {
       const MatrixXd& pred_gram, const std::vector<MatrixXd>& mixed_dists,
       const VectorXd& theta_values, const int index_i, const int index_j) = 0;
 
+  /**
+   *  \brief Compute a Gram matrix between two sets of points. The matrix is
+   *  assembled in cache-sized tiles, with the scaled squared distances for
+   *  each tile computed on the fly, so no per-component distance matrices
+   *  are formed.
+   *  \param[in] points_a First set of points - (num_points_a by num_features).
+   *  \param[in] points_b Second set of points - (num_points_b by
+   *  num_features).
+   *  \param[in] theta_values Vector of hyperparameters.
+   *  \param[inout] gram Gram matrix - (num_points_a by num_points_b).
+   */
+  void compute_gram(const MatrixXd& points_a, const MatrixXd& points_b,
+                    const VectorXd& theta_values, MatrixXd& gram) const;
+
+  /**
+   *  \brief Compute the symmetric Gram matrix for a set of points. The
+   *  matrix is assembled tile by tile. Only the upper tiles are evaluated,
+   *  and each one is mirrored to the lower triangle.
+   *  \param[in] points Set of points - (num_points by num_features).
+   *  \param[in] theta_values Vector of hyperparameters.
+   *  \param[inout] gram Gram matrix - (num_points by num_points).
+   */
+  void compute_gram(const MatrixXd& points, const VectorXd& theta_values,
+                    MatrixXd& gram) const;
+
+  /**
+   *  \brief Contract the derivatives of the symmetric Gram matrix with
+   *  respect to the kernel hyperparameters with a weight matrix. Each
+   *  derivative is summed over a tile as soon as that tile is evaluated, so
+   *  the derivative matrices are never stored.
+   *  \param[in] points Set of points - (num_points by num_features).
+   *  \param[in] theta_values Vector of hyperparameters.
+   *  \param[in] weights Weight matrix - (num_points by num_points).
+   *  \param[out] gram_derivs_dot Sum of the elementwise product of weights
+   *  with each Gram matrix derivative - (num_features + 1).
+   */
+  void contract_gram_derivs(const MatrixXd& points,
+                            const VectorXd& theta_values,
+                            const MatrixXd& weights,
+                            VectorXd& gram_derivs_dot) const;
+
  protected:
+  /**
+   *  \brief Evaluate the kernel on a tile of hyperparameter-scaled squared
+   *  distances.
+   *  \param[in] Dbar2_tile Tile of scaled squared distances.
+   *  \param[in] sig2 Squared scale (sigma) hyperparameter.
+   *  \param[in] compute_deriv_weights Flag for computing deriv_weight_tile.
+   *  \param[out] gram_tile Tile of the Gram matrix.
+   *  \param[out] deriv_weight_tile Factor that, multiplied by a scaled
+   *  squared component-wise distance, gives the derivative of the Gram
+   *  matrix with respect to that component's log length-scale.
+   */
+  virtual void compute_gram_tile(const Eigen::ArrayXXd& Dbar2_tile,
+                                 const double sig2, bool compute_deriv_weights,
+                                 Eigen::ArrayXXd& gram_tile,
+                                 Eigen::ArrayXXd& deriv_weight_tile) const = 0;
+
   /**
    *  \brief Compute the ``Dbar'' matrices of scaled distances
    *  \param[in] cw_dists2 Vector of component-wise squared distance matrices.
@@ -95,6 +152,28 @@ class Kernel {
                     const VectorXd& theta_values, bool take_sqrt = true);
 
   MatrixXd Dbar, Dbar2;
+
+  /// Number of rows/columns in a Gram matrix tile; 64x64 doubles (32 KB)
+  /// of distances stay resident in L1/L2 cache.
+  const int gramTileSize = 64;
+
+ private:
+  /**
+   *  \brief Compute a tile of scaled squared distances between rows of two
+   *  sets of length-scale-scaled points. The inner loop runs over
+   *  contiguous column entries so that it vectorizes.
+   *  \param[in] scaled_a First set of scaled points.
+   *  \param[in] scaled_b Second set of scaled points.
+   *  \param[in] row_a First row of the tile in scaled_a.
+   *  \param[in] row_b First row of the tile in scaled_b.
+   *  \param[in] num_a Number of tile rows.
+   *  \param[in] num_b Number of tile columns.
+   *  \param[out] Dbar2_tile Tile of scaled squared distances.
+   */
+  static void compute_Dbar2_tile(const MatrixXd& scaled_a,
+                                 const MatrixXd& scaled_b, const int row_a,
+                                 const int row_b, const int num_a,
+                                 const int num_b, Eigen::ArrayXXd& Dbar2_tile);
 };
 
 /// Stationary kernel with C^\infty smooth realizations.
@@ -104,6 +183,8 @@ class SquaredExponentialKernel : public Kernel {
 
   ~SquaredExponentialKernel();
 
+  using Kernel::compute_gram;
+
   void compute_gram(const std::vector<MatrixXd>& dists2,
                     const VectorXd& theta_values, MatrixXd& gram) override;
 
@@ -120,6 +201,11 @@ class SquaredExponentialKernel : public Kernel {
       const MatrixXd& pred_gram, const std::vector<MatrixXd>& mixed_dists,
       const VectorXd& theta_values, const int index_i,
       const int index_j) override;
+
+ protected:
+  void compute_gram_tile(const Eigen::ArrayXXd& Dbar2_tile, const double sig2,
+                         bool compute_deriv_weights, Eigen::ArrayXXd& gram_tile,
+                         Eigen::ArrayXXd& deriv_weight_tile) const override;
 };
 
 /// Stationary kernel with C^1 smooth realizations.
@@ -129,6 +215,8 @@ class Matern32Kernel : public Kernel {
 
   ~Matern32Kernel();
 
+  using Kernel::compute_gram;
+
   void compute_gram(const std::vector<MatrixXd>& dists2,
                     const VectorXd& theta_values, MatrixXd& gram) override;
 
@@ -146,6 +234,11 @@ class Matern32Kernel : public Kernel {
       const VectorXd& theta_values, const int index_i,
       const int index_j) override;
 
+ protected:
+  void compute_gram_tile(const Eigen::ArrayXXd& Dbar2_tile, const double sig2,
+                         bool compute_deriv_weights, Eigen::ArrayXXd& gram_tile,
+                         Eigen::ArrayXXd& deriv_weight_tile) const override;
+
  private:
   const double sqrt3 = sqrt(3.);
 };
@@ -157,6 +250,8 @@ class Matern52Kernel : public Kernel {
 
   ~Matern52Kernel();
 
+  using Kernel::compute_gram;
+
   void compute_gram(const std::vector<MatrixXd>& dists2,
                     const VectorXd& theta_values, MatrixXd& gram) override;
 
@@ -174,6 +269,11 @@ class Matern52Kernel : public Kernel {
       const VectorXd& theta_values, const int index_i,
       const int index_j) override;
 
+ protected:
+  void compute_gram_tile(const Eigen::ArrayXXd& Dbar2_tile, const double sig2,
+                         bool compute_deriv_weights, Eigen::ArrayXXd& gram_tile,
+                         Eigen::ArrayXXd& deriv_weight_tile) const override;
+
  private:
   const double sqrt5 = sqrt(5.);
 };
@@ -17,7 +17,7 @@ using RolVec = ROL::Vector<double>;
 /// Dakota alias for ROL StdVector
 using RolStdVec = ROL::StdVector<double>;
 
-GP_Objective::GP_Objective(GaussianProcess& gp_model) : gp(gp_model) {
+GP_Objective::GP_Objective(const GaussianProcess& gp_model) : gp(gp_model) {
   nopt = gp.get_num_opt_variables();
   grad_old.resize(nopt);
   pold.resize(nopt);
@@ -33,8 +33,9 @@ double GP_Objective::value(const ROL::Vector<double>& p, double& tol) {
   ROL::Ptr<const std::vector<double> > xp = getVector(p);
   double obj_val;
   VectorXd grad(nopt);
-  gp.set_opt_params(*xp);
-  gp.negative_marginal_log_likelihood(false, pdiff(*xp), obj_val, grad);
+  gp.set_opt_params(*xp, workspace);
+  gp.negative_marginal_log_likelihood(workspace, false, pdiff(*xp), obj_val,
+                                      grad);
   return obj_val;
 }
 
@@ -45,8 +46,9 @@ void GP_Objective::gradient(ROL::Vector<double>& g,
   ROL::Ptr<std::vector<double> > gpointer = getVector(g);
   double obj_val;
   VectorXd grad(nopt);
-  gp.set_opt_params(*xp);
-  gp.negative_marginal_log_likelihood(true, pdiff(*xp), obj_val, grad);
+  gp.set_opt_params(*xp, workspace);
+  gp.negative_marginal_log_likelihood(workspace, true, pdiff(*xp), obj_val,
+                                      grad);
   for (int i = 0; i < grad.size(); ++i) {
     (*gpointer)[i] = grad(i);
   }
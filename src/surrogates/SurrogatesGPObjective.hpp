@@ -35,7 +35,7 @@ class GP_Objective : public ROL::Objective<double> {
    *  \param[in] gp_model Reference to the GaussianProcess surrogate.
    *
    */
-  GP_Objective(GaussianProcess& gp_model);
+  GP_Objective(const GaussianProcess& gp_model);
   ~GP_Objective();
 
   // ------------------------------------------------------------
@@ -93,8 +93,11 @@ class GP_Objective : public ROL::Objective<double> {
   // ------------------------------------------------------------
   // Private member variables
 
-  /// Pointer to the GaussianProcess surrogate.
-  GaussianProcess& gp;
+  /// Reference to the GaussianProcess surrogate.
+  const GaussianProcess& gp;
+  /// Hyperparameters and Gram matrix factorization for this optimization
+  /// run; private to the objective so that restarts may run concurrently.
+  GaussianProcess::MLEWorkspace workspace;
   /// Number of optimization variables.
   int nopt;
   /// Previously computed value of the objective function.
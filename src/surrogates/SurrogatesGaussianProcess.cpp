@@ -15,6 +15,12 @@
 #include "SurrogatesGPObjective.hpp"
 #include "Teuchos_oblackholestream.hpp"
 #include "util_math_tools.hpp"
+#include "util_threads.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
 
 namespace dakota {
 namespace surrogates {
@@ -101,13 +107,12 @@ void GaussianProcess::build(const MatrixXd& samples, const MatrixXd& response) {
   setup_hyperparameter_bounds(sigma_bounds, length_scale_bounds, nugget_bounds);
   const int num_restarts = configOptions.get<int>("num restarts");
 
-  /* Scale the data and compute build squared distances */
+  /* Scale the data */
   dataScaler =
       *(util::scaler_factory(util::DataScaler::scaler_type(
                                  configOptions.get<std::string>("scaler name")),
                              samples));
   dataScaler.scale_samples(samples, scaledBuildPoints);
-  compute_build_dists();
 
   MatrixXd beta_bounds;
   estimateTrend = configOptions.sublist("Trend").get<bool>("estimate trend");
@@ -127,12 +132,8 @@ void GaussianProcess::build(const MatrixXd& samples, const MatrixXd& response) {
   bestThetaValues.resize(numVariables + 1);
   betaValues.resize(numPolyTerms);
   bestBetaValues.resize(numPolyTerms);
-  /* set the size of the GramMatrix and its derivatives */
+  /* set the size of the GramMatrix */
   GramMatrix.resize(numSamples, numSamples);
-  GramMatrixDerivs.resize(numVariables + 1);
-  for (int k = 0; k < numVariables + 1; k++) {
-    GramMatrixDerivs[k].resize(numSamples, numSamples);
-  }
 
   /* DTS: if the nugget is being estimated, should the fixed value be set to
    * zero? */
@@ -146,14 +147,6 @@ void GaussianProcess::build(const MatrixXd& samples, const MatrixXd& response) {
                            num_restarts, configOptions.get<int>("gp seed"),
                            initial_guesses);
 
-  ROL::Ptr<std::ostream> outStream;
-  Teuchos::oblackholestream bhs;
-  outStream = ROL::makePtrFromRef(bhs);
-
-  /* Uncomment if you'd like to print ROL's output to screen.
-   * Useful for debugging */
-  // outStream = ROL::makePtrFromRef(std::cout);
-
   /* No more reading in rol_params from an xml file
    * Set defaults in here instead */
   /*
@@ -166,96 +159,120 @@ void GaussianProcess::build(const MatrixXd& samples, const MatrixXd& response) {
       Teuchos::rcp(new ParameterList("GP_MLE_Optimization"));
   setup_default_optimization_params(gp_mle_rol_params);
 
-  auto gp_objective = std::make_shared<GP_Objective>(*this);
   int dim = numVariables + 1 + numPolyTerms + numNuggetTerms;
 
-  // Define algorithm
-  ROL::Ptr<ROL::Step<double>> step =
-      ROL::makePtr<ROL::LineSearchStep<double>>(*gp_mle_rol_params);
-  ROL::Ptr<ROL::StatusTest<double>> status =
-      ROL::makePtr<ROL::StatusTest<double>>(*gp_mle_rol_params);
-  ROL::Algorithm<double> algo(step, status, false);
-
-  /* set up parameter vectors and bounds */
-  ROL::Ptr<std::vector<double>> x_ptr =
-      ROL::makePtr<std::vector<double>>(dim, 0.0);
-  ROL::StdVector<double> x(x_ptr);
-  ROL::Ptr<ROL::Bounds<double>> bound;
-  ROL::Ptr<std::vector<double>> lo_ptr =
-      ROL::makePtr<std::vector<double>>(dim, 0.0);
-  ROL::Ptr<std::vector<double>> hi_ptr =
-      ROL::makePtr<std::vector<double>>(dim, 0.0);
+  /* set up parameter bounds */
+  std::vector<double> lower_bounds(dim, 0.0), upper_bounds(dim, 0.0);
   /* sigma bounds */
-  (*lo_ptr)[0] = log(sigma_bounds(0));
-  (*hi_ptr)[0] = log(sigma_bounds(1));
+  lower_bounds[0] = log(sigma_bounds(0));
+  upper_bounds[0] = log(sigma_bounds(1));
   /* length scale bounds */
   for (int i = 0; i < numVariables; i++) {
     if (length_scale_bounds.rows() > 1) {
-      (*lo_ptr)[i + 1] = log(length_scale_bounds(i, 0));
-      (*hi_ptr)[i + 1] = log(length_scale_bounds(i, 1));
+      lower_bounds[i + 1] = log(length_scale_bounds(i, 0));
+      upper_bounds[i + 1] = log(length_scale_bounds(i, 1));
     } else {
-      (*lo_ptr)[i + 1] = log(length_scale_bounds(0, 0));
-      (*hi_ptr)[i + 1] = log(length_scale_bounds(0, 1));
+      lower_bounds[i + 1] = log(length_scale_bounds(0, 0));
+      upper_bounds[i + 1] = log(length_scale_bounds(0, 1));
     }
   }
   if (estimateTrend) {
     for (int i = 0; i < numPolyTerms; i++) {
-      (*lo_ptr)[numVariables + 1 + i] = beta_bounds(i, 0);
-      (*hi_ptr)[numVariables + 1 + i] = beta_bounds(i, 1);
+      lower_bounds[numVariables + 1 + i] = beta_bounds(i, 0);
+      upper_bounds[numVariables + 1 + i] = beta_bounds(i, 1);
     }
   }
   if (estimateNugget) {
-    (*lo_ptr)[dim - 1] = log(nugget_bounds(0));
-    (*hi_ptr)[dim - 1] = log(nugget_bounds(1));
+    lower_bounds[dim - 1] = log(nugget_bounds(0));
+    upper_bounds[dim - 1] = log(nugget_bounds(1));
   }
 
-  ROL::Ptr<ROL::Vector<double>> lop =
-      ROL::makePtr<ROL::StdVector<double>>(lo_ptr);
-  ROL::Ptr<ROL::Vector<double>> hip =
-      ROL::makePtr<ROL::StdVector<double>>(hi_ptr);
-  bound = ROL::makePtr<ROL::Bounds<double>>(lop, hip);
-
-  std::vector<std::string> output;
-
   objectiveFunctionHistory.resize(num_restarts);
   objectiveGradientHistory.resize(num_restarts, dim);
   thetaHistory.resize(num_restarts, dim);
 
-  double final_obj_value;
-  VectorXd final_obj_gradient(dim);
-
-  for (int i = 0; i < num_restarts; i++) {
-    for (int j = 0; j < dim; ++j) {
-      (*x_ptr)[j] = initial_guesses(i, j);
-    }
-    output = algo.run(x, *gp_objective, *bound, true, *outStream);
-    for (int j = 0; j < thetaValues.size(); ++j) {
-      (thetaValues)(j) = (*x_ptr)[j];
-    }
-    if (estimateTrend) {
-      for (int j = 0; j < numPolyTerms; ++j) {
-        betaValues(j) = (*x_ptr)[numVariables + 1 + j];
+  /* Each restart runs on its own objective, workspace, and ROL algorithm,
+   * so restarts are independent and may run concurrently. Final values land
+   * in row i of the history arrays regardless of which thread ran restart i.
+   */
+  int num_threads = static_cast<int>(util::num_threads(
+      std::max(0, configOptions.get<int>("num threads")), num_restarts));
+
+  std::atomic<int> next_restart(0);
+  std::vector<std::exception_ptr> thread_errors(num_threads);
+  auto run_restarts = [&](const int thread_id) {
+    try {
+      /* ROL steps read (and mark) their ParameterList; give each thread
+       * its own copy */
+      ParameterList rol_params(*gp_mle_rol_params);
+      Teuchos::oblackholestream bhs;
+      ROL::Ptr<std::ostream> outStream = ROL::makePtrFromRef(bhs);
+      /* Uncomment if you'd like to print ROL's output to screen.
+       * Useful for debugging */
+      // outStream = ROL::makePtrFromRef(std::cout);
+
+      ROL::Ptr<ROL::Vector<double>> lop = ROL::makePtr<ROL::StdVector<double>>(
+          ROL::makePtr<std::vector<double>>(lower_bounds));
+      ROL::Ptr<ROL::Vector<double>> hip = ROL::makePtr<ROL::StdVector<double>>(
+          ROL::makePtr<std::vector<double>>(upper_bounds));
+      ROL::Bounds<double> bound(lop, hip);
+
+      ROL::Ptr<std::vector<double>> x_ptr =
+          ROL::makePtr<std::vector<double>>(dim, 0.0);
+      ROL::StdVector<double> x(x_ptr);
+      MLEWorkspace workspace;
+      double final_obj_value;
+      VectorXd final_obj_gradient(dim);
+
+      int i;
+      while ((i = next_restart++) < num_restarts) {
+        // Define algorithm
+        ROL::Ptr<ROL::Step<double>> step =
+            ROL::makePtr<ROL::LineSearchStep<double>>(rol_params);
+        ROL::Ptr<ROL::StatusTest<double>> status =
+            ROL::makePtr<ROL::StatusTest<double>>(rol_params);
+        ROL::Algorithm<double> algo(step, status, false);
+        GP_Objective gp_objective(*this);
+
+        for (int j = 0; j < dim; ++j) {
+          (*x_ptr)[j] = initial_guesses(i, j);
+        }
+        algo.run(x, gp_objective, bound, true, *outStream);
+
+        /* get the final objective function value and gradient */
+        set_opt_params(*x_ptr, workspace);
+        negative_marginal_log_likelihood(workspace, true, true,
+                                         final_obj_value, final_obj_gradient);
+        objectiveFunctionHistory(i) = final_obj_value;
+        objectiveGradientHistory.row(i) = final_obj_gradient;
+        for (int j = 0; j < dim; ++j) {
+          thetaHistory(i, j) = (*x_ptr)[j];
+        }
       }
+    } catch (...) {
+      thread_errors[thread_id] = std::current_exception();
     }
-    if (estimateNugget) {
-      estimatedNuggetValue = (*x_ptr)[numVariables + 1 + numPolyTerms];
-    }
-    /* get the final objective function value and gradient */
-    negative_marginal_log_likelihood(true, true, final_obj_value,
-                                     final_obj_gradient);
-    if (final_obj_value < bestObjFunValue) {
-      bestObjFunValue = final_obj_value;
-      bestThetaValues = thetaValues;
-      if (estimateTrend) bestBetaValues = betaValues;
-      if (estimateNugget) bestEstimatedNuggetValue = estimatedNuggetValue;
+  };
+
+  std::vector<std::thread> threads;
+  for (int t = 1; t < num_threads; t++) threads.emplace_back(run_restarts, t);
+  run_restarts(0);
+  for (auto& thread : threads) thread.join();
+  for (const auto& error : thread_errors)
+    if (error) std::rethrow_exception(error);
+
+  /* select the best restart in restart order (lowest index wins ties), which
+   * is independent of the number of threads */
+  for (int i = 0; i < num_restarts; i++) {
+    if (objectiveFunctionHistory(i) < bestObjFunValue) {
+      bestObjFunValue = objectiveFunctionHistory(i);
+      bestThetaValues = thetaHistory.row(i).head(numVariables + 1).transpose();
+      if (estimateTrend)
+        bestBetaValues = thetaHistory.row(i)
+                             .segment(numVariables + 1, numPolyTerms)
+                             .transpose();
+      if (estimateNugget) bestEstimatedNuggetValue = thetaHistory(i, dim - 1);
     }
-    objectiveFunctionHistory(i) = final_obj_value;
-    objectiveGradientHistory.row(i) = final_obj_gradient;
-    thetaHistory.row(i).head(numVariables + 1) = thetaValues;
-    if (estimateTrend)
-      thetaHistory.row(i).segment(numVariables + 1, numPolyTerms) = betaValues;
-    if (estimateNugget) thetaHistory.row(i).tail(1)(0) = estimatedNuggetValue;
-    algo.reset();
   }
 
   thetaValues = bestThetaValues;
@@ -267,7 +284,7 @@ void GaussianProcess::build(const MatrixXd& samples, const MatrixXd& response) {
   if (estimateNugget) estimatedNuggetValue = bestEstimatedNuggetValue;
 
   /* compute and store best Cholesky factorization */
-  compute_gram(cwiseDists2, true, false, GramMatrix);
+  compute_gram(scaledBuildPoints, true, GramMatrix);
   CholFact.compute(GramMatrix);
   hasBestCholFact = true;
 
@@ -299,16 +316,16 @@ VectorXd GaussianProcess::value(const MatrixXd& eval_points, const int qoi) {
 
   /* scale the eval_points (prediction points) */
   const MatrixXd& scaled_pred_points = dataScaler.scale_samples(eval_points);
-  compute_pred_dists(scaled_pred_points);
 
   /* compute the Gram matrix and its Cholesky factorization */
   if (!hasBestCholFact) {
-    compute_gram(cwiseDists2, true, false, GramMatrix);
+    compute_gram(scaledBuildPoints, true, GramMatrix);
     CholFact.compute(GramMatrix);
   }
 
   VectorXd resid, chol_solve_resid;
-  compute_gram(cwiseMixedDists2, false, false, predMixedGramMatrix);
+  kernel->compute_gram(scaled_pred_points, scaledBuildPoints, thetaValues,
+                       predMixedGramMatrix);
 
   if (estimateTrend) {
     resid = targetValues - basisMatrix * betaValues;
@@ -349,12 +366,13 @@ MatrixXd GaussianProcess::gradient(const MatrixXd& eval_points, const int qoi) {
 
   /* compute the Gram matrix and its Cholesky factorization */
   if (!hasBestCholFact) {
-    compute_gram(cwiseDists2, true, false, GramMatrix);
+    compute_gram(scaledBuildPoints, true, GramMatrix);
     CholFact.compute(GramMatrix);
   }
 
   MatrixXd chol_solve_resid, first_deriv_pred_gram, grad_components, resid;
-  compute_gram(cwiseMixedDists2, false, false, predMixedGramMatrix);
+  kernel->compute_gram(scaled_pred_pts, scaledBuildPoints, thetaValues,
+                       predMixedGramMatrix);
   resid = targetValues;
   if (estimateTrend) resid -= basisMatrix * betaValues;
   chol_solve_resid = CholFact.solve(resid);
@@ -394,12 +412,13 @@ MatrixXd GaussianProcess::hessian(const MatrixXd& eval_point, const int qoi) {
 
   /* compute the Gram matrix and its Cholesky factorization */
   if (!hasBestCholFact) {
-    compute_gram(cwiseDists2, true, false, GramMatrix);
+    compute_gram(scaledBuildPoints, true, GramMatrix);
     CholFact.compute(GramMatrix);
   }
 
   MatrixXd chol_solve_resid, second_deriv_pred_gram, resid;
-  compute_gram(cwiseMixedDists2, false, false, predMixedGramMatrix);
+  kernel->compute_gram(scaled_pred_point, scaledBuildPoints, thetaValues,
+                       predMixedGramMatrix);
   resid = targetValues;
   if (estimateTrend) resid -= basisMatrix * betaValues;
   chol_solve_resid = CholFact.solve(resid);
@@ -438,17 +457,17 @@ MatrixXd GaussianProcess::covariance(const MatrixXd& eval_points,
   predCovariance.resize(num_eval_points, num_eval_points);
   /* scale the eval_points (prediction points) */
   const MatrixXd& scaled_pred_points = dataScaler.scale_samples(eval_points);
-  compute_pred_dists(scaled_pred_points);
 
   /* compute the Gram matrix and its Cholesky factorization */
   if (!hasBestCholFact) {
-    compute_gram(cwiseDists2, true, false, GramMatrix);
+    compute_gram(scaledBuildPoints, true, GramMatrix);
     CholFact.compute(GramMatrix);
   }
 
   VectorXd resid;
   MatrixXd chol_solve_pred_mat;
-  compute_gram(cwiseMixedDists2, false, false, predMixedGramMatrix);
+  kernel->compute_gram(scaled_pred_points, scaledBuildPoints, thetaValues,
+                       predMixedGramMatrix);
 
   if (estimateTrend)
     resid = targetValues - basisMatrix * betaValues;
@@ -457,7 +476,7 @@ MatrixXd GaussianProcess::covariance(const MatrixXd& eval_points,
 
   chol_solve_pred_mat = CholFact.solve(predMixedGramMatrix.transpose());
 
-  compute_gram(cwisePredDists2, true, false, predGramMatrix);
+  compute_gram(scaled_pred_points, true, predGramMatrix);
   predCovariance = predGramMatrix - predMixedGramMatrix * chol_solve_pred_mat;
 
   if (estimateTrend) {
@@ -488,40 +507,46 @@ VectorXd GaussianProcess::variance(const MatrixXd& eval_points, const int qoi) {
   return variance;
 }
 
-void GaussianProcess::negative_marginal_log_likelihood(bool compute_grad,
-                                                       bool form_gram,
-                                                       double& obj_value,
-                                                       VectorXd& obj_gradient) {
+void GaussianProcess::negative_marginal_log_likelihood(
+    MLEWorkspace& workspace, bool compute_grad, bool form_gram,
+    double& obj_value, VectorXd& obj_gradient) const {
   if (form_gram) {
-    compute_gram(cwiseDists2, true, true, GramMatrix);
-    CholFact.compute(GramMatrix);
-    trendTargetResidual = targetValues;
-    if (estimateTrend) trendTargetResidual -= basisMatrix * betaValues;
-    GramResidualSolution = CholFact.solve(trendTargetResidual);
+    compute_gram(scaledBuildPoints, workspace.thetaValues,
+                 workspace.estimatedNuggetValue, true, workspace.GramMatrix);
+    workspace.CholFact.compute(workspace.GramMatrix);
+    workspace.trendTargetResidual = targetValues;
+    if (estimateTrend)
+      workspace.trendTargetResidual -= basisMatrix * workspace.betaValues;
+    workspace.GramResidualSolution =
+        workspace.CholFact.solve(workspace.trendTargetResidual);
   }
 
-  obj_value =
-      0.5 * log(CholFact.vectorD().array()).matrix().sum() +
-      0.5 * (trendTargetResidual.transpose() * GramResidualSolution)(0, 0) +
-      static_cast<double>(numSamples) / 2.0 * log(2.0 * PI);
+  obj_value = 0.5 * log(workspace.CholFact.vectorD().array()).matrix().sum() +
+              0.5 * (workspace.trendTargetResidual.transpose() *
+                     workspace.GramResidualSolution)(0, 0) +
+              static_cast<double>(numSamples) / 2.0 * log(2.0 * PI);
 
   if (compute_grad) {
     /* DTS: This Cholesky solve is much more expensive than the factorization!
      */
-    MatrixXd Q =
-        -0.5 * (GramResidualSolution * GramResidualSolution.transpose() -
-                CholFact.solve(eyeMatrix));
+    MatrixXd Q = -0.5 * (workspace.GramResidualSolution *
+                             workspace.GramResidualSolution.transpose() -
+                         workspace.CholFact.solve(eyeMatrix));
     if (estimateTrend) {
       obj_gradient.segment(numVariables + 1, numPolyTerms) =
-          -basisMatrix.transpose() * GramResidualSolution;
+          -basisMatrix.transpose() * workspace.GramResidualSolution;
     }
 
-    for (int k = 0; k < numVariables + 1; k++)
-      obj_gradient(k) = (GramMatrixDerivs[k].cwiseProduct(Q)).sum();
+    /* contract the Gram matrix derivatives with Q tile by tile rather than
+       forming numVariables + 1 dense derivative matrices */
+    VectorXd gram_derivs_dot;
+    kernel->contract_gram_derivs(scaledBuildPoints, workspace.thetaValues, Q,
+                                 gram_derivs_dot);
+    obj_gradient.head(numVariables + 1) = gram_derivs_dot;
 
     if (estimateNugget) {
       obj_gradient(numVariables + 1 + numPolyTerms) =
-          2.0 * exp(2.0 * estimatedNuggetValue) * Q.trace();
+          2.0 * exp(2.0 * workspace.estimatedNuggetValue) * Q.trace();
     }
   }
 }
@@ -558,22 +583,27 @@ void GaussianProcess::setup_hyperparameter_bounds(VectorXd& sigma_bounds,
   }
 }
 
-int GaussianProcess::get_num_opt_variables() {
+int GaussianProcess::get_num_opt_variables() const {
   return numVariables + 1 + numPolyTerms + numNuggetTerms;
 }
 
 int GaussianProcess::get_num_variables() const { return numVariables; }
 
-void GaussianProcess::set_opt_params(const std::vector<double>& opt_params) {
-  for (int i = 0; i < numVariables + 1; i++) thetaValues(i) = opt_params[i];
+void GaussianProcess::set_opt_params(const std::vector<double>& opt_params,
+                                     MLEWorkspace& workspace) const {
+  workspace.thetaValues.resize(numVariables + 1);
+  for (int i = 0; i < numVariables + 1; i++)
+    workspace.thetaValues(i) = opt_params[i];
 
   if (estimateTrend) {
+    workspace.betaValues.resize(numPolyTerms);
     for (int i = 0; i < numPolyTerms; i++)
-      betaValues(i) = opt_params[numVariables + 1 + i];
+      workspace.betaValues(i) = opt_params[numVariables + 1 + i];
   }
 
   if (estimateNugget)
-    estimatedNuggetValue = opt_params[numVariables + 1 + numPolyTerms];
+    workspace.estimatedNuggetValue =
+        opt_params[numVariables + 1 + numPolyTerms];
 }
 
 void GaussianProcess::default_options() {
@@ -623,6 +653,9 @@ void GaussianProcess::default_options() {
                            "scaler for variables");
   defaultConfigOptions.set("num restarts", 10,
                            "local optimizer number of initial iterates");
+  defaultConfigOptions.set("num threads", 1,
+                           "number of threads for concurrent restarts "
+                           "(0 for the per-process thread budget)");
   defaultConfigOptions.set("gp seed", 42,
                            "random seed for initial iterate generation");
   defaultConfigOptions.set("standardize response", true,
@@ -658,62 +691,37 @@ void GaussianProcess::default_options() {
       "verbosity", 1, "console output verbosity");
 }
 
-void GaussianProcess::compute_build_dists() {
-  cwiseDists2.resize(numVariables);
-
-  for (int k = 0; k < numVariables; k++) {
-    cwiseDists2[k].resize(numSamples, numSamples);
-    for (int i = 0; i < numSamples; i++) {
-      for (int j = i; j < numSamples; j++) {
-        cwiseDists2[k](i, j) =
-            pow(scaledBuildPoints(i, k) - scaledBuildPoints(j, k), 2);
-        if (i != j) cwiseDists2[k](j, i) = cwiseDists2[k](i, j);
-      }
-    }
-  }
-}
-
 void GaussianProcess::compute_pred_dists(const MatrixXd& scaled_pred_pts) {
   const int num_pred_pts = scaled_pred_pts.rows();
   cwiseMixedDists.resize(numVariables);
-  cwiseMixedDists2.resize(numVariables);
-  cwisePredDists2.resize(numVariables);
 
   for (int k = 0; k < numVariables; k++) {
     cwiseMixedDists[k].resize(num_pred_pts, numSamples);
-    cwisePredDists2[k].resize(num_pred_pts, num_pred_pts);
     for (int i = 0; i < num_pred_pts; i++) {
       for (int j = 0; j < numSamples; j++) {
         cwiseMixedDists[k](i, j) =
             scaled_pred_pts(i, k) - scaledBuildPoints(j, k);
       }
-      for (int j = i; j < num_pred_pts; j++) {
-        cwisePredDists2[k](i, j) =
-            pow(scaled_pred_pts(i, k) - scaled_pred_pts(j, k), 2);
-        if (i != j) cwisePredDists2[k](j, i) = cwisePredDists2[k](i, j);
-      }
     }
-    cwiseMixedDists2[k] = cwiseMixedDists[k].array().square();
   }
 }
 
-void GaussianProcess::compute_gram(const std::vector<MatrixXd>& dists2,
-                                   bool add_nugget, bool compute_derivs,
+void GaussianProcess::compute_gram(const MatrixXd& points, bool add_nugget,
                                    MatrixXd& gram) {
-  const int num_rows = dists2[0].rows();
-  const int num_cols = dists2[0].cols();
-  gram.resize(num_rows, num_cols);
-  kernel->compute_gram(dists2, thetaValues, gram);
+  compute_gram(points, thetaValues, estimatedNuggetValue, add_nugget, gram);
+}
 
-  if (compute_derivs)
-    kernel->compute_gram_derivs(gram, dists2, thetaValues, GramMatrixDerivs);
+void GaussianProcess::compute_gram(const MatrixXd& points,
+                                   const VectorXd& theta_values,
+                                   const double estimated_nugget,
+                                   bool add_nugget, MatrixXd& gram) const {
+  kernel->compute_gram(points, theta_values, gram);
 
   if (add_nugget) {
     /* add in the fixed nugget */
     gram.diagonal().array() += fixedNuggetValue;
     /* add in the estimated nugget */
-    if (estimateNugget)
-      gram.diagonal().array() += exp(2.0 * estimatedNuggetValue);
+    if (estimateNugget) gram.diagonal().array() += exp(2.0 * estimated_nugget);
   }
 }
 
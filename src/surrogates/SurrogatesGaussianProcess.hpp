@@ -18,6 +18,7 @@
 
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/vector.hpp>
+#include <boost/serialization/version.hpp>
 
 namespace dakota {
 
@@ -48,6 +49,28 @@ namespace surrogates {
  */
 class GaussianProcess : public Surrogate {
  public:
+  /**
+   *  \brief State of one marginal likelihood optimization run: the
+   *  hyperparameters being optimized and the Gram matrix factorization they
+   *  determine. Concurrent restarts each own a workspace.
+   */
+  struct MLEWorkspace {
+    /// Vector of log-space hyperparameters.
+    VectorXd thetaValues;
+    /// Vector of polynomial coefficients.
+    VectorXd betaValues;
+    /// Estimated nugget term.
+    double estimatedNuggetValue = 0.0;
+    /// Gram matrix for the build points.
+    MatrixXd GramMatrix;
+    /// Pivoted Cholesky factorization of GramMatrix.
+    Eigen::LDLT<MatrixXd> CholFact;
+    /// Difference between target values and trend predictions.
+    VectorXd trendTargetResidual;
+    /// Cholesky solve for Gram matrix with trendTargetResidual rhs.
+    VectorXd GramResidualSolution;
+  };
+
   /* Constructors and destructors */
 
   /// Constructor that uses defaultConfigOptions and does not build.
@@ -205,15 +228,17 @@ class GaussianProcess : public Surrogate {
 
   /**
    *  \brief Evaluate the negative marginal loglikelihood and its
-   *  gradient.
+   *  gradient for the hyperparameters in a workspace.
+   *  \param[inout] workspace Hyperparameters and Gram matrix factorization.
    *  \param[in] compute_grad Flag for computation of gradient.
    *  \param[in] compute_gram Flag for various Gram matrix calculations.
    *  \param[out] obj_value Value of the objection function.
    *  \param[out] obj_gradient Gradient of the objective function.
    */
-  void negative_marginal_log_likelihood(bool compute_grad, bool compute_gram,
+  void negative_marginal_log_likelihood(MLEWorkspace& workspace,
+                                        bool compute_grad, bool compute_gram,
                                         double& obj_value,
-                                        VectorXd& obj_gradient);
+                                        VectorXd& obj_gradient) const;
 
   /**
    *  \brief Initialize the hyperparameter bounds for MLE from
@@ -235,7 +260,7 @@ class GaussianProcess : public Surrogate {
    *  \returns Number of total optimization variables (hyperparameters + trend
    * coefficients + nugget)
    */
-  int get_num_opt_variables();
+  int get_num_opt_variables() const;
 
   /**
    *  \brief Get the dimension of the feature space.
@@ -266,10 +291,12 @@ class GaussianProcess : public Surrogate {
   MatrixXd get_theta_history() { return thetaHistory; }
 
   /**
-   *  \brief Update the vector of optimization parameters.
+   *  \brief Update the optimization parameters in a workspace.
    *  \param[in] opt_params Vector of optimization parameter values.
+   *  \param[inout] workspace Workspace holding the parameters.
    */
-  void set_opt_params(const std::vector<double>& opt_params);
+  void set_opt_params(const std::vector<double>& opt_params,
+                      MLEWorkspace& workspace) const;
 
   std::shared_ptr<Surrogate> clone() const override {
     return std::make_shared<GaussianProcess>(configOptions);
@@ -281,27 +308,35 @@ class GaussianProcess : public Surrogate {
   /// Construct and populate the defaultConfigOptions.
   void default_options() override;
 
-  /// Compute squared distances between the scaled build points.
-  void compute_build_dists();
-
   /**
-   *  \brief Compute distances between build and prediction points. This
-   * includes build-prediction and prediction-prediction distance matrices.
+   *  \brief Compute component-wise signed distances between prediction and
+   *  build points, as needed by the derivatives of the prediction Gram
+   *  matrix.
    *  \param[in] scaled_pred_pts Matrix of scaled prediction points.
    */
   void compute_pred_dists(const MatrixXd& scaled_pred_pts);
 
   /**
-   *  \brief Compute a Gram matrix given a vector of squared distances and
-   *  optionally compute its derivatives and/or adds nugget terms.
-   *  \param[in] dists2 Vector of squared distance matrices.
+   *  \brief Compute the symmetric Gram matrix for a set of points and
+   *  optionally add nugget terms.
+   *  \param[in] points Matrix of scaled points.
+   *  \param[in] add_nugget Bool for whether or add nugget terms.
+   *  \param[out] gram Gram matrix.
+   */
+  void compute_gram(const MatrixXd& points, bool add_nugget, MatrixXd& gram);
+
+  /**
+   *  \brief Compute the symmetric Gram matrix for a set of points and given
+   *  hyperparameters and optionally add nugget terms.
+   *  \param[in] points Matrix of scaled points.
+   *  \param[in] theta_values Vector of log-space hyperparameters.
+   *  \param[in] estimated_nugget Estimated nugget term.
    *  \param[in] add_nugget Bool for whether or add nugget terms.
-   *  \param[in] compute_derivs Bool for whether or not to compute the
-   *  derivatives of the Gram matrix.
    *  \param[out] gram Gram matrix.
    */
-  void compute_gram(const std::vector<MatrixXd>& dists2, bool add_nugget,
-                    bool compute_derivs, MatrixXd& gram);
+  void compute_gram(const MatrixXd& points, const VectorXd& theta_values,
+                    const double estimated_nugget, bool add_nugget,
+                    MatrixXd& gram) const;
 
   /**
    *  \brief Randomly generate initial guesses for the optimization routine.
@@ -351,7 +386,7 @@ class GaussianProcess : public Surrogate {
   VectorXd betaValues;
 
   /// Estimated nugget term.
-  double estimatedNuggetValue;
+  double estimatedNuggetValue = 0.0;
 
   /// Vector of best hyperparameters from MLE with restarts.
   VectorXd bestThetaValues;
@@ -374,27 +409,9 @@ class GaussianProcess : public Surrogate {
   /// Gram matrix for the build points
   MatrixXd GramMatrix;
 
-  /// Difference between target values and trend predictions.
-  VectorXd trendTargetResidual;
-
-  /// Cholesky solve for Gram matrix with trendTargetResidual rhs.
-  VectorXd GramResidualSolution;
-
-  /// Derivatives of the Gram matrix w.r.t. the hyperparameters.
-  std::vector<MatrixXd> GramMatrixDerivs;
-
-  /// Squared component-wise distances between points in the surrogate dataset.
-  std::vector<MatrixXd> cwiseDists2;
-
   /// Component-wise distances between prediction and build points.
   std::vector<MatrixXd> cwiseMixedDists;
 
-  /// Squared component-wise distances between prediction and build points.
-  std::vector<MatrixXd> cwiseMixedDists2;
-
-  /// Component-wise distances between prediction points.
-  std::vector<MatrixXd> cwisePredDists2;
-
   /// Pivoted Cholesky factorization.
   Eigen::LDLT<MatrixXd> CholFact;
 
@@ -457,12 +474,16 @@ class GaussianProcess : public Surrogate {
 
 template <class Archive>
 void GaussianProcess::serialize(Archive& archive, const unsigned int version) {
-  silence_unused_args(version);
-
   archive& boost::serialization::base_object<Surrogate>(*this);
 
+  // Version 0 archives stored the per-dimension squared distance
+  // matrices, which are no longer members; read and discard them
+  if (Archive::is_loading::value && version < 1) {
+    std::vector<MatrixXd> cwise_dists2;
+    archive& cwise_dists2;
+  }
+
   // BMA: Initial cut is aggressive, serializing most members
-  archive& cwiseDists2;
   archive& thetaValues;
   archive& fixedNuggetValue;
   archive& estimateNugget;
@@ -500,5 +521,6 @@ void GaussianProcess::serialize(Archive& archive, const unsigned int version) {
 }  // namespace dakota
 
 BOOST_CLASS_EXPORT_KEY(dakota::surrogates::GaussianProcess)
+BOOST_CLASS_VERSION(dakota::surrogates::GaussianProcess, 1)
 
 #endif  // include guard
@@ -11,6 +11,7 @@
 #include "surrogates_tools.hpp"
 #include "util_common.hpp"
 #include "util_data_types.hpp"
+#include "util_math_tools.hpp"
 
 #define BOOST_TEST_MODULE surrogates_GaussianProcessTest
 #include <boost/test/included/unit_test.hpp>
@@ -905,4 +906,81 @@ BOOST_AUTO_TEST_CASE(test_surrogates_gp_read_from_parameterlist) {
                 "SVD");
 }
 
+BOOST_AUTO_TEST_CASE(test_surrogates_gp_threaded_restarts) {
+  MatrixXd samples, length_scale_bounds;
+  VectorXd response, eval_pts, sigma_bounds;
+
+  get_1D_gp_test_data(samples, response, eval_pts);
+  get_gp_hyperparameter_bounds(1, sigma_bounds, length_scale_bounds);
+  ParameterList param_list =
+      get_gp_config_options(sigma_bounds, length_scale_bounds);
+
+  GaussianProcess gp_serial(param_list);
+  gp_serial.build(samples, response);
+
+  /* restarts run concurrently must reproduce the serial results exactly,
+   * independent of the number of threads */
+  for (const int num_threads : {2, 3, 0}) {
+    param_list.set("num threads", num_threads);
+    GaussianProcess gp_threaded(param_list);
+    gp_threaded.build(samples, response);
+
+    BOOST_CHECK(matrix_equals(gp_threaded.get_theta_history(),
+                              gp_serial.get_theta_history(), 0.0));
+    BOOST_CHECK(matrix_equals(gp_threaded.get_objective_function_history(),
+                              gp_serial.get_objective_function_history(), 0.0));
+    BOOST_CHECK(matrix_equals(gp_threaded.value(eval_pts),
+                              gp_serial.value(eval_pts), 0.0));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_surrogates_gp_tiled_gram) {
+  /* enough points for several (partial) tiles */
+  const int num_samples = 150, num_pred = 37, num_vars = 5;
+  MatrixXd samples = create_uniform_random_double_matrix(
+      num_samples, num_vars, 42, true, -1.0, 1.0);
+  MatrixXd pred_pts =
+      create_uniform_random_double_matrix(num_pred, num_vars, 43, true, -1.0,
+                                          1.0);
+  MatrixXd weights = create_uniform_random_double_matrix(
+      num_samples, num_samples, 44, true, -1.0, 1.0);
+  VectorXd theta_values(num_vars + 1);
+  theta_values << 0.3, -0.2, 0.1, 0.4, -0.5, 0.25;
+
+  /* reference: per-component squared distance matrices */
+  std::vector<MatrixXd> dists2(num_vars), mixed_dists2(num_vars);
+  for (int k = 0; k < num_vars; k++) {
+    dists2[k].resize(num_samples, num_samples);
+    mixed_dists2[k].resize(num_pred, num_samples);
+    for (int j = 0; j < num_samples; j++) {
+      for (int i = 0; i < num_samples; i++)
+        dists2[k](i, j) = pow(samples(i, k) - samples(j, k), 2);
+      for (int i = 0; i < num_pred; i++)
+        mixed_dists2[k](i, j) = pow(pred_pts(i, k) - samples(j, k), 2);
+    }
+  }
+
+  const double abs_tol = 1.0e-12;
+  for (const std::string kernel_type :
+       {"squared exponential", "Matern 3/2", "Matern 5/2"}) {
+    std::shared_ptr<Kernel> kernel = kernel_factory(kernel_type);
+    MatrixXd gram_gold, gram, mixed_gram_gold, mixed_gram;
+    kernel->compute_gram(dists2, theta_values, gram_gold);
+    kernel->compute_gram(samples, theta_values, gram);
+    BOOST_CHECK(matrix_equals(gram, gram_gold, abs_tol));
+
+    kernel->compute_gram(mixed_dists2, theta_values, mixed_gram_gold);
+    kernel->compute_gram(pred_pts, samples, theta_values, mixed_gram);
+    BOOST_CHECK(matrix_equals(mixed_gram, mixed_gram_gold, abs_tol));
+
+    std::vector<MatrixXd> gram_derivs(num_vars + 1);
+    kernel->compute_gram_derivs(gram_gold, dists2, theta_values, gram_derivs);
+    VectorXd derivs_dot_gold(num_vars + 1), derivs_dot;
+    for (int k = 0; k < num_vars + 1; k++)
+      derivs_dot_gold(k) = gram_derivs[k].cwiseProduct(weights).sum();
+    kernel->contract_gram_derivs(samples, theta_values, weights, derivs_dot);
+    BOOST_CHECK(matrix_equals(derivs_dot, derivs_dot_gold, 1.0e-10));
+  }
+}
+
 }  // namespace
@@ -0,0 +1,236 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "ActiveSubspaceModel.hpp"
+#include "Teuchos_LAPACK.hpp"
+
+#include <random>
+
+#define BOOST_TEST_MODULE dakota_active_subspace
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+
+namespace {
+
+const int NUM_VARS = 12;
+const int NUM_VECS = 5;
+const int NUM_MINORS = NUM_VECS - 1;
+const int NUM_DISTS = NUM_VECS;
+
+/// orthonormalize the columns of A in place (modified Gram-Schmidt,
+/// applied twice)
+void orthonormalize(RealMatrix& A)
+{
+  int i, j, c, pass, m = A.numRows(), n = A.numCols();
+  for (pass=0; pass<2; ++pass)
+    for (j=0; j<n; ++j) {
+      for (c=0; c<j; ++c) {
+	Real dot = 0.;
+	for (i=0; i<m; ++i) dot += A(i,c) * A(i,j);
+	for (i=0; i<m; ++i) A(i,j) -= dot * A(i,c);
+      }
+      Real norm = 0.;
+      for (i=0; i<m; ++i) norm += A(i,j) * A(i,j);
+      norm = std::sqrt(norm);
+      for (i=0; i<m; ++i) A(i,j) /= norm;
+    }
+}
+
+/// random matrix with standard normal entries
+RealMatrix random_matrix(std::mt19937& gen, int m, int n)
+{
+  std::normal_distribution<> dist;
+  RealMatrix A(m, n);
+  for (int j=0; j<n; ++j)
+    for (int i=0; i<m; ++i)
+      A(i,j) = dist(gen);
+  return A;
+}
+
+/// orthonormal columns U with the given projection P = W^T U onto the
+/// leading NUM_VECS columns of the orthonormal W (NUM_VARS x NUM_VARS),
+/// completed within the span of the next NUM_VECS columns using the
+/// Cholesky factor L L^T = I - P^T P (requires ||P||_2 < 1)
+RealMatrix subspace_with_projection(const RealMatrix& W, const RealMatrix& P)
+{
+  int i, j, k;
+  RealMatrix L(NUM_VECS, NUM_VECS);
+  for (j=0; j<NUM_VECS; ++j)
+    for (i=j; i<NUM_VECS; ++i) {
+      Real g = (i == j) ? 1. : 0.;
+      for (k=0; k<NUM_VECS; ++k) g -= P(k,i) * P(k,j);
+      for (k=0; k<j; ++k)        g -= L(i,k) * L(j,k);
+      L(i,j) = (i == j) ? std::sqrt(g) : g / L(j,j);
+    }
+  RealMatrix U(NUM_VARS, NUM_VECS);
+  for (j=0; j<NUM_VECS; ++j)
+    for (i=0; i<NUM_VARS; ++i)
+      for (k=0; k<NUM_VECS; ++k)
+	U(i,j) += W(i,k) * P(k,j) + W(i,NUM_VECS+k) * L(j,k);
+  return U;
+}
+
+/// reference metrics: each |det(W_j^T U_j)| from its own LU factorization
+/// with partial pivoting and each distance from the formed projectors
+void reference_metrics(const RealMatrix& W, const RealMatrix& U,
+		       RealArray& abs_dets, RealArray& dists)
+{
+  Teuchos::LAPACK<int, Real> lapack;
+  abs_dets.assign(NUM_MINORS + 1, 0.);
+  for (int n=1; n<=NUM_MINORS; ++n) {
+    RealMatrix W_n(Teuchos::View, W, NUM_VARS, n),
+      U_n(Teuchos::View, U, NUM_VARS, n), A(n, n);
+    A.multiply(Teuchos::TRANS, Teuchos::NO_TRANS, 1., W_n, U_n, 0.);
+    IntVector pivots(n);
+    int info;
+    lapack.GETRF(n, n, A.values(), n, pivots.values(), &info);
+    Real det = 1.;
+    for (int i=0; i<n; ++i)
+      det *= A(i,i);
+    abs_dets[n] = std::abs(det);
+  }
+  dists.assign(NUM_DISTS, 0.);
+  for (int n=1; n<=NUM_DISTS; ++n) {
+    RealMatrix W_n(Teuchos::View, W, NUM_VARS, n),
+      U_n(Teuchos::View, U, NUM_VARS, n), D(NUM_VARS, NUM_VARS);
+    D.multiply(Teuchos::NO_TRANS, Teuchos::TRANS,  1., W_n, W_n, 0.);
+    D.multiply(Teuchos::NO_TRANS, Teuchos::TRANS, -1., U_n, U_n, 1.);
+    dists[n-1] = D.normFrobenius();
+  }
+}
+
+/// compare subspace_metrics() with reference_metrics()
+void check_metrics(const RealMatrix& W, const RealMatrix& U)
+{
+  RealArray abs_dets(NUM_MINORS + 1, 0.), dists(NUM_DISTS, 0.),
+    ref_dets, ref_dists;
+  ActiveSubspaceModel::BootstrapWorkspace ws;
+  ActiveSubspaceModel::subspace_metrics(W, U, NUM_MINORS, NUM_DISTS, ws,
+					abs_dets.data(), dists.data());
+  reference_metrics(W, U, ref_dets, ref_dists);
+  for (int j=1; j<=NUM_MINORS; ++j)
+    BOOST_CHECK_CLOSE(abs_dets[j], ref_dets[j], 1.e-8);
+  for (int j=0; j<NUM_DISTS; ++j)
+    BOOST_CHECK_CLOSE(dists[j], ref_dists[j], 1.e-8);
+}
+
+/// the pivot of the unpivoted elimination of P = W^T U at step j and
+/// the largest candidate in its column
+void elimination_pivot(const RealMatrix& W, const RealMatrix& U, int j,
+		       Real& pivot, Real& col_max)
+{
+  RealMatrix P(NUM_VECS, NUM_VECS);
+  P.multiply(Teuchos::TRANS, Teuchos::NO_TRANS, 1., W, U, 0.);
+  int i, k, c;
+  for (k=0; k<j; ++k)
+    for (i=k+1; i<NUM_VECS; ++i) {
+      Real l = P(i,k) / P(k,k);
+      for (c=k+1; c<NUM_VECS; ++c)
+	P(i,c) -= l * P(k,c);
+    }
+  pivot = std::abs(P(j,j)); col_max = 0.;
+  for (i=j; i<NUM_VECS; ++i)
+    col_max = std::max(col_max, std::abs(P(i,j)));
+}
+
+} // anonymous namespace
+
+
+BOOST_AUTO_TEST_CASE(test_active_subspace_metrics_random_subspace)
+{
+  std::mt19937 gen(2468);
+  RealMatrix W = random_matrix(gen, NUM_VARS, NUM_VECS),
+    U = random_matrix(gen, NUM_VARS, NUM_VECS);
+  orthonormalize(W); orthonormalize(U);
+  check_metrics(W, U);
+}
+
+
+BOOST_AUTO_TEST_CASE(test_active_subspace_metrics_perturbed_subspace)
+{
+  // a replicate subspace close to W, as from a converged derivative
+  // matrix: every pivot of the unpivoted elimination is accepted
+  std::mt19937 gen(1357);
+  RealMatrix W = random_matrix(gen, NUM_VARS, NUM_VECS),
+    U = random_matrix(gen, NUM_VARS, NUM_VECS);
+  orthonormalize(W);
+  for (int j=0; j<NUM_VECS; ++j)
+    for (int i=0; i<NUM_VARS; ++i)
+      U(i,j) = W(i,j) + 0.05 * U(i,j);
+  orthonormalize(U);
+  for (int j=0; j<NUM_MINORS; ++j) {
+    Real pivot, col_max;
+    elimination_pivot(W, U, j, pivot, col_max);
+    BOOST_CHECK(pivot >= 0.1 * col_max);
+  }
+  check_metrics(W, U);
+}
+
+
+BOOST_AUTO_TEST_CASE(test_active_subspace_metrics_small_pivot)
+{
+  // a replicate nearly orthogonal to the first vector of W: without the
+  // fallback to partial pivoting, the tiny first pivot of P = W^T U
+  // amplifies rounding in the larger minors
+  std::mt19937 gen(8642);
+  std::uniform_real_distribution<> dist(-0.15, 0.15);
+  RealMatrix W = random_matrix(gen, NUM_VARS, NUM_VARS),
+    P(NUM_VECS, NUM_VECS);
+  orthonormalize(W);
+  for (int j=0; j<NUM_VECS; ++j)
+    for (int i=0; i<NUM_VECS; ++i)
+      P(i,j) = dist(gen);
+  P(0,0) = 1.e-12;
+  RealMatrix U = subspace_with_projection(W, P);
+  Real pivot, col_max;
+  elimination_pivot(W, U, 0, pivot, col_max);
+  BOOST_REQUIRE(pivot < 0.1 * col_max);
+  check_metrics(W, U);
+}
+
+
+BOOST_AUTO_TEST_CASE(test_active_subspace_metrics_pivot_fallback)
+{
+  // swapping the second and third vectors of a slightly perturbed U makes
+  // the second pivot small relative to its column, forcing the remaining
+  // minors to be factored with partial pivoting
+  std::mt19937 gen(97531);
+  RealMatrix W = random_matrix(gen, NUM_VARS, NUM_VECS),
+    U = random_matrix(gen, NUM_VARS, NUM_VECS);
+  orthonormalize(W);
+  for (int j=0; j<NUM_VECS; ++j) {
+    int w_j = (j == 1) ? 2 : ((j == 2) ? 1 : j);
+    for (int i=0; i<NUM_VARS; ++i)
+      U(i,j) = W(i,w_j) + 0.01 * U(i,j);
+  }
+  orthonormalize(U);
+  Real pivot, col_max;
+  elimination_pivot(W, U, 1, pivot, col_max);
+  BOOST_REQUIRE(pivot < 0.1 * col_max);
+  check_metrics(W, U);
+
+  // an exact swap: the second leading minor is singular
+  for (int j=0; j<NUM_VECS; ++j) {
+    int w_j = (j == 1) ? 2 : ((j == 2) ? 1 : j);
+    for (int i=0; i<NUM_VARS; ++i)
+      U(i,j) = W(i,w_j);
+  }
+  RealArray abs_dets(NUM_MINORS + 1, 0.), dists(NUM_DISTS, 0.);
+  ActiveSubspaceModel::BootstrapWorkspace ws;
+  ActiveSubspaceModel::subspace_metrics(W, U, NUM_MINORS, NUM_DISTS, ws,
+					abs_dets.data(), dists.data());
+  BOOST_CHECK_CLOSE(abs_dets[1], 1., 1.e-8);
+  BOOST_CHECK_SMALL(abs_dets[2], 1.e-12);
+  BOOST_CHECK_CLOSE(abs_dets[3], 1., 1.e-8);
+  BOOST_CHECK_CLOSE(abs_dets[4], 1., 1.e-8);
+  BOOST_CHECK_SMALL(dists[0], 1.e-12);
+  BOOST_CHECK_CLOSE(dists[1], std::sqrt(2.), 1.e-8);
+  BOOST_CHECK_SMALL(dists[2], 1.e-12);
+}
@@ -58,3 +58,29 @@ BOOST_AUTO_TEST_CASE( test_bootstrap_seq_container )
                                 test_output_vals.begin(),
                                 test_output_vals.end());
 }
+
+BOOST_AUTO_TEST_CASE( test_bootstrap_sample_indices )
+{
+  using namespace Dakota;
+
+  // the indices locate the blocks of a bootstrapped sample drawn from the
+  // same random state
+  double test_input_vals[] = {1,2,3,4,5,6,7,8};
+  RealMatrix test_matrix(Teuchos::Copy, test_input_vals, 1, 1, 8);
+  BootstrapSampler<RealMatrix> bootstrapS(test_matrix, 2);
+
+  RealMatrix result(test_matrix);
+  BootstrapSamplerBase<RealMatrix>::set_seed(17);
+  bootstrapS(result);
+
+  std::vector<size_t> indices;
+  BootstrapSamplerBase<RealMatrix>::set_seed(17);
+  bootstrapS.sample_indices(4, indices);
+
+  BOOST_CHECK_EQUAL(indices.size(), 4);
+  for (size_t b = 0; b < 4; ++b) {
+    BOOST_CHECK(indices[b] < 4);
+    BOOST_CHECK_EQUAL(result(0, 2*b), test_matrix(0, 2*indices[b]));
+    BOOST_CHECK_EQUAL(result(0, 2*b+1), test_matrix(0, 2*indices[b]+1));
+  }
+}
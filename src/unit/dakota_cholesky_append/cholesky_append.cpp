@@ -0,0 +1,174 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+
+#include "dakota_linear_algebra.hpp"
+#include "dakota_mersenne_twister.hpp"
+#include "Teuchos_LAPACK.hpp"
+#include <boost/random/uniform_real_distribution.hpp>
+#include <cmath>
+
+#define BOOST_TEST_MODULE dakota_cholesky_append
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+
+namespace {
+
+const int NUM_VARS = 2;
+
+/// Gaussian correlation exp(-sum_i exp(theta_i) (x_i - y_i)^2), as
+/// in GaussProcApproximation
+Real correlation(const RealMatrix& pts, int j, const Real* x)
+{
+  const Real theta[NUM_VARS] = { 0.3, -0.5 };
+  Real sume = 0.;
+  for (int i=0; i<NUM_VARS; ++i) {
+    Real pt_diff = pts(j,i) - x[i];
+    sume += std::exp(theta[i]) * pt_diff * pt_diff;
+  }
+  return std::exp(-sume);
+}
+
+/// row j of pts as a point
+RealVector point(const RealMatrix& pts, int j)
+{
+  RealVector x(NUM_VARS, false);
+  for (int i=0; i<NUM_VARS; ++i)
+    x[i] = pts(j,i);
+  return x;
+}
+
+/// correlations of x with the leading n points
+RealVector corr_vector(const RealMatrix& pts, int n, const Real* x)
+{
+  RealVector r(n, false);
+  for (int j=0; j<n; ++j)
+    r[j] = correlation(pts, j, x);
+  return r;
+}
+
+/// lower Cholesky factor of the correlation matrix of the leading n
+/// points, from a full factorization
+RealMatrix full_factor(const RealMatrix& pts, int n)
+{
+  RealMatrix chol(n, n); // upper triangle remains zero
+  for (int j=0; j<n; ++j) {
+    RealVector x = point(pts, j);
+    for (int k=j; k<n; ++k)
+      chol(k,j) = correlation(pts, k, x.values());
+  }
+  Teuchos::LAPACK<int, Real> la;
+  int info;
+  la.POTRF('L', n, chol.values(), chol.stride(), &info);
+  BOOST_REQUIRE_EQUAL(info, 0);
+  return chol;
+}
+
+/// solve L L' x = b in place
+void chol_solve(const RealMatrix& chol, RealVector& b)
+{
+  Teuchos::LAPACK<int, Real> la;
+  int info;
+  la.POTRS('L', chol.numRows(), 1, chol.values(), chol.stride(), b.values(),
+	   b.length(), &info);
+  BOOST_REQUIRE_EQUAL(info, 0);
+}
+
+/// constant-trend kriging mean and (unscaled) variance at x, as
+/// computed by GaussProcApproximation from the covariance factor
+void kriging_predict(const RealMatrix& chol, const RealMatrix& pts,
+		     const RealVector& y, const Real* x, Real& mean, Real& var)
+{
+  int n = chol.numRows();
+  RealVector ones(n, false), r = corr_vector(pts, n, x);
+  ones.putScalar(1.);
+  RealVector rinv_1(ones), rinv_y(y), rinv_r(r);
+  chol_solve(chol, rinv_1); chol_solve(chol, rinv_y); chol_solve(chol, rinv_r);
+  Real beta = ones.dot(rinv_y) / ones.dot(rinv_1);
+  RealVector resid(y);
+  for (int j=0; j<n; ++j)
+    resid[j] -= beta;
+  chol_solve(chol, resid);
+  mean = beta + r.dot(resid);
+  Real u = 1. - ones.dot(rinv_r);
+  var = 1. - r.dot(rinv_r) + u * u / ones.dot(rinv_1);
+}
+
+}
+
+
+BOOST_AUTO_TEST_CASE(test_appended_factor_matches_full_factorization)
+{
+  const int num_initial = 6, num_appended = 8, num_total = 14;
+  boost::random::mt19937 rng(271828);
+  boost::random::uniform_real_distribution<Real> x_dist(-2., 2.);
+  RealMatrix pts(num_total, NUM_VARS, false);
+  RealVector y(num_total, false);
+  for (int j=0; j<num_total; ++j) {
+    for (int i=0; i<NUM_VARS; ++i)
+      pts(j,i) = x_dist(rng);
+    y[j] = std::sin(pts(j,0)) + pts(j,1) * pts(j,1);
+  }
+
+  // append points one at a time, as rebuild() does for liar points
+  RealMatrix chol = full_factor(pts, num_initial);
+  for (int n=num_initial; n<num_total; ++n) {
+    RealVector x = point(pts, n);
+    Real pivot = cholesky_append(chol, corr_vector(pts, n, x.values()), 1.);
+    BOOST_CHECK_GT(pivot, 0.);
+    BOOST_REQUIRE_EQUAL(chol.numRows(), n+1);
+    BOOST_REQUIRE_EQUAL(chol.numCols(), n+1);
+
+    RealMatrix full = full_factor(pts, n+1);
+    for (int j=0; j<=n; ++j)
+      for (int k=0; k<=n; ++k)
+	BOOST_CHECK_SMALL(chol(k,j) - full(k,j), 1.e-10);
+  }
+
+  // predictions from the appended and the refactored covariance agree
+  RealMatrix full = full_factor(pts, num_total);
+  const Real test_pts[3][NUM_VARS]
+    = { { 0., 0. }, { 1.5, -0.75 }, { -1.9, 1.2 } };
+  for (int t=0; t<3; ++t) {
+    Real app_mean, app_var, full_mean, full_var;
+    kriging_predict(chol, pts, y, test_pts[t], app_mean, app_var);
+    kriging_predict(full, pts, y, test_pts[t], full_mean, full_var);
+    BOOST_CHECK_CLOSE(app_mean, full_mean, 1.e-8);
+    BOOST_CHECK_SMALL(app_var - full_var, 1.e-10);
+  }
+
+  // interpolation of an appended training point
+  Real mean, var;
+  RealVector x_last = point(pts, num_total-1);
+  kriging_predict(chol, pts, y, x_last.values(), mean, var);
+  BOOST_CHECK_CLOSE(mean, y[num_total-1], 1.e-6);
+  BOOST_CHECK_SMALL(var, 1.e-8);
+}
+
+
+BOOST_AUTO_TEST_CASE(test_append_to_empty_and_duplicate_point)
+{
+  // appending to an empty factor gives sqrt(alpha)
+  RealMatrix chol;
+  RealVector empty;
+  BOOST_CHECK_CLOSE(cholesky_append(chol, empty, 4.), 4., 1.e-12);
+  BOOST_REQUIRE_EQUAL(chol.numRows(), 1);
+  BOOST_CHECK_CLOSE(chol(0,0), 2., 1.e-12);
+
+  // a duplicate point leaves a non-positive pivot and a zero diagonal
+  RealMatrix pts(2, NUM_VARS);
+  pts(0,0) = pts(1,0) = 0.25; pts(0,1) = pts(1,1) = -0.5;
+  chol = full_factor(pts, 1);
+  RealVector x = point(pts, 1);
+  Real pivot = cholesky_append(chol, corr_vector(pts, 1, x.values()), 1.);
+  BOOST_CHECK_LE(pivot, 1.e-15);
+  BOOST_CHECK_EQUAL(chol(1,1), 0.);
+  BOOST_CHECK_CLOSE(chol(1,0), 1., 1.e-12);
+}
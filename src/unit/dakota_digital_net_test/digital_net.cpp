@@ -632,6 +632,30 @@ BOOST_AUTO_TEST_CASE(digital_net_check_annulus)
   BOOST_CHECK_CLOSE(4*integrand, 0.65*std::atan(1), 1e-1);
 }
 
+// +-------------------------------------------------------------------------+
+// |              Test skip-ahead and blocked point generation               |
+// +-------------------------------------------------------------------------+
+BOOST_AUTO_TEST_CASE(digital_net_check_skip_ahead)
+{
+  // Get digital net with a fixed seed
+  Dakota::DigitalNet digital_net(23);
+
+  // Get all points at once (large enough to be generated in blocks)
+  size_t numPoints = 1 << 16;
+  size_t dimension = 8;
+  Dakota::RealMatrix points(dimension, numPoints);
+  digital_net.get_points(points);
+
+  // Points between arbitrary indices must match the corresponding points
+  size_t nMin = 12345;
+  size_t nMax = 54321;
+  Dakota::RealMatrix points_range(dimension, nMax - nMin);
+  digital_net.get_points(nMin, nMax, points_range);
+  for ( size_t n = nMin; n < nMax; ++n )
+    for ( size_t d = 0; d < dimension; ++d )
+      BOOST_CHECK_EQUAL(points_range[n - nMin][d], points[n][d]);
+}
+
 } // end namespace TestDigitalNet
 
 } // end namespace TestLowDiscrepancy
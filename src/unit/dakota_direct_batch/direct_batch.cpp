@@ -0,0 +1,170 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "LibraryEnvironment.hpp"
+#include "TestDriverInterface.hpp"
+
+#include <memory>
+#include <string>
+
+#define BOOST_TEST_MODULE dakota_direct_batch
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+
+namespace {
+
+  /// text_book values, gradients, and Hessians over a parameter study
+  /// of 21 evaluations; {batch} is replaced by the batch specification
+  const std::string pstudy_input =
+    "method \n"
+    "  centered_parameter_study \n"
+    "    step_vector = 0.1 0.1 \n"
+    "    steps_per_variable = 5 5 \n"
+    "    output silent \n"
+    "variables \n"
+    "  continuous_design = 2 \n"
+    "    initial_point = 0.9 1.1 \n"
+    "    descriptors = 'x1' 'x2' \n"
+    "interface \n"
+    "  direct \n"
+    "    analysis_driver = 'text_book' \n"
+    "{batch}"
+    "responses \n"
+    "  objective_functions = 1 \n"
+    "  nonlinear_inequality_constraints = 2 \n"
+    "  analytic_gradients \n"
+    "  analytic_hessians \n";
+
+  const size_t num_evals = 21, num_fns = 3, num_vars = 2;
+
+
+  /// text_book driver recording its results in evaluation order and
+  /// counting batch and single evaluation calls
+  class RecordingTestDriver: public TestDriverInterface
+  {
+  public:
+    RecordingTestDriver(const ProblemDescDB& problem_db):
+      TestDriverInterface(problem_db)
+    { }
+
+    size_t numBatchCalls = 0;  ///< derived_map_batch() calls that mapped
+    size_t numSingleCalls = 0; ///< derived_map_ac() calls
+    /// per evaluation: values, gradients, and Hessian lower triangles
+    std::vector<RealArray> results;
+
+  protected:
+
+    bool derived_map_batch(BatchEvaluation& batch) override
+    {
+      if (!TestDriverInterface::derived_map_batch(batch))
+	return false;
+      ++numBatchCalls;
+      size_t num_dv = batch.num_derivative_variables();
+      for (size_t j=0; j<batch.num_evaluations(); ++j) {
+	RealArray res;
+	for (size_t i=0; i<num_fns; ++i)
+	  res.push_back(batch.function_values()(i, j));
+	for (size_t i=0; i<num_fns; ++i)
+	  for (size_t r=0; r<num_dv; ++r)
+	    res.push_back(batch.function_gradients()(r, j*num_fns + i));
+	for (size_t i=0; i<num_fns; ++i)
+	  for (size_t c=0; c<num_dv; ++c)
+	    for (size_t r=c; r<num_dv; ++r)
+	      res.push_back(batch.function_hessians()
+			    (r, (j*num_fns + i)*num_dv + c));
+	results.push_back(res);
+      }
+      return true;
+    }
+
+    int derived_map_ac(const String& ac_name) override
+    {
+      ++numSingleCalls;
+      int fail_code = TestDriverInterface::derived_map_ac(ac_name);
+      RealArray res;
+      for (size_t i=0; i<num_fns; ++i)
+	res.push_back(fnVals[i]);
+      for (size_t i=0; i<num_fns; ++i)
+	for (size_t r=0; r<numDerivVars; ++r)
+	  res.push_back(fnGrads(r, i));
+      for (size_t i=0; i<num_fns; ++i)
+	for (size_t c=0; c<numDerivVars; ++c)
+	  for (size_t r=c; r<numDerivVars; ++r)
+	    res.push_back(fnHessians[i](r, c));
+      results.push_back(res);
+      return fail_code;
+    }
+  };
+
+
+  /// counts and results recorded by the driver during one study
+  struct StudyRecord {
+    size_t numBatchCalls;
+    size_t numSingleCalls;
+    std::vector<RealArray> results;
+  };
+
+  /// run the parameter study with the given batch specification and
+  /// return the record of the plugged-in driver
+  StudyRecord run_study(const std::string& batch)
+  {
+    std::string input(pstudy_input);
+    input.replace(input.find("{batch}"), 7, batch);
+    ProgramOptions opts;
+    opts.echo_input(false);
+    opts.input_string(input);
+    LibraryEnvironment env(MPI_COMM_WORLD, opts, false);
+    env.exit_mode("throw");
+    env.done_modifying_db();
+
+    auto driver = std::make_shared<RecordingTestDriver>
+      (env.problem_description_db());
+    BOOST_REQUIRE(env.plugin_interface("simulation", "direct", "text_book",
+				       driver));
+    env.execute();
+    return StudyRecord{ driver->numBatchCalls, driver->numSingleCalls,
+			driver->results };
+  }
+
+}
+
+//----------------------------------------------------------------
+
+/** Each batch of the queue is mapped by a single call of the driver. */
+BOOST_AUTO_TEST_CASE(test_text_book_batch_in_one_call)
+{
+  StudyRecord record = run_study("    batch \n      size = 7 \n");
+  BOOST_CHECK_EQUAL(record.numSingleCalls, 0);
+  BOOST_CHECK_EQUAL(record.numBatchCalls, num_evals / 7);
+  BOOST_CHECK_EQUAL(record.results.size(), num_evals);
+
+  // unlimited batch size: the whole parameter study in one call
+  record = run_study("    batch \n");
+  BOOST_CHECK_EQUAL(record.numSingleCalls, 0);
+  BOOST_CHECK_EQUAL(record.numBatchCalls, 1);
+  BOOST_CHECK_EQUAL(record.results.size(), num_evals);
+}
+
+/** Batch results agree bitwise with single evaluations. */
+BOOST_AUTO_TEST_CASE(test_text_book_batch_matches_single)
+{
+  StudyRecord single = run_study(""),
+    batched = run_study("    batch \n      size = 4 \n");
+  BOOST_CHECK_EQUAL(single.numBatchCalls, 0);
+  BOOST_CHECK_EQUAL(single.numSingleCalls, num_evals);
+  BOOST_CHECK_EQUAL(batched.numBatchCalls, (num_evals + 3) / 4);
+  BOOST_REQUIRE_EQUAL(single.results.size(), num_evals);
+  BOOST_REQUIRE_EQUAL(batched.results.size(), num_evals);
+  size_t num_results = num_fns * (1 + num_vars + num_vars*(num_vars+1)/2);
+  for (size_t j=0; j<num_evals; ++j) {
+    BOOST_REQUIRE_EQUAL(single.results[j].size(), num_results);
+    BOOST_CHECK(single.results[j] == batched.results[j]);
+  }
+}
@@ -0,0 +1,132 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+
+/** \file dream_batch.cpp Test generation-batched DREAM against the core */
+
+#include "opt_tpl_test.hpp"
+#include "LibraryEnvironment.hpp"
+#include "dakota_tabular_io.hpp"
+#include <boost/filesystem.hpp>
+#include <fstream>
+
+#define BOOST_TEST_MODULE dakota_dream_batch
+#include <boost/test/included/unit_test.hpp>
+
+namespace {
+
+const int NUM_CHAINS = 5, NUM_GENERATIONS = 200, NUM_PARAMS = 2;
+
+/// DREAM calibration of the Rosenbrock residuals (no data), whose
+/// posterior mode is x = (1, 1)
+std::string dream_input(bool batch, const std::string& chain_file)
+{
+  return std::string(R"(
+method
+  bayes_calibration dream
+    chain_samples = 1000 seed = 348
+    chains = 5
+)") + (batch ? "    batch_generations\n" : "") +
+    "    export_chain_points_file '" + chain_file + "' freeform\n" + R"(
+    burn_in_samples = 500
+  output silent
+
+variables
+  uniform_uncertain 2
+    lower_bounds -2. -2.
+    upper_bounds  2.  2.
+    descriptors 'x1' 'x2'
+
+interface
+  direct
+    analysis_driver = 'rosenbrock'
+
+responses
+  calibration_terms = 2
+  descriptors 'f1' 'f2'
+  no_gradients
+  no_hessians
+)";
+}
+
+/// run DREAM, returning the exported chain as (x1, x2, f1, f2) columns
+Dakota::RealMatrix run_dream(bool batch)
+{
+  std::string chain_file = batch ? "dakota_dream_batch_chain.dat"
+    : "dakota_dream_core_chain.dat";
+  std::shared_ptr<Dakota::LibraryEnvironment>
+    p_env(Dakota::Opt_TPL_Test::create_env(dream_input(batch, chain_file)));
+  p_env->execute();
+
+  Dakota::RealMatrix chain;
+  Dakota::TabularIO::read_data_tabular(chain_file, "test_dream_batch", chain,
+				       2*NUM_PARAMS, Dakota::TABULAR_NONE);
+  return chain;
+}
+
+double row_mean(const Dakota::RealMatrix& chain, int row)
+{
+  double mean = 0.;
+  for (int j=0; j<chain.numCols(); ++j)
+    mean += chain(row, j);
+  return mean / chain.numCols();
+}
+
+/// number of lines in filename
+size_t num_lines(const std::string& filename)
+{
+  std::ifstream in(filename);
+  std::string line;
+  size_t count = 0;
+  while (std::getline(in, line))
+    ++count;
+  return count;
+}
+
+}
+
+
+BOOST_AUTO_TEST_CASE(test_dream_batch_generations)
+{
+  Dakota::RealMatrix core_chain = run_dream(false);
+
+  const char* files[] = { "dakota_dream_gr.txt", "dakota_dream_restart.txt" };
+  for (const char* f : files)
+    boost::filesystem::remove(f);
+  for (int j=0; j<NUM_CHAINS; ++j)
+    boost::filesystem::remove("dakota_dream_chain" + std::to_string(j)
+			      + ".txt");
+
+  Dakota::RealMatrix batch_chain = run_dream(true);
+
+  // same number of post-burn-in samples
+  BOOST_REQUIRE_EQUAL(core_chain.numCols(), 500);
+  BOOST_REQUIRE_EQUAL(batch_chain.numCols(), core_chain.numCols());
+
+  // the core output files are written: a header and a line per
+  // generation per chain, a line per print step (10 generations) of
+  // Gelman-Rubin statistics, and the par_num, chain_num and a line
+  // per chain for restart
+  for (int j=0; j<NUM_CHAINS; ++j)
+    BOOST_CHECK_EQUAL(num_lines("dakota_dream_chain" + std::to_string(j)
+				+ ".txt"), NUM_GENERATIONS + 1);
+  BOOST_CHECK_EQUAL(num_lines("dakota_dream_gr.txt"), NUM_GENERATIONS/10 + 1);
+  BOOST_CHECK_EQUAL(num_lines("dakota_dream_restart.txt"), NUM_CHAINS + 3);
+
+  // the posterior means agree with those of the DREAM core to within
+  // sampling error, and the exported responses are those of the
+  // exported parameters (f2 = 1 - x1)
+  for (int i=0; i<NUM_PARAMS; ++i)
+    BOOST_CHECK_SMALL(row_mean(batch_chain, i) - row_mean(core_chain, i), 0.4);
+  for (int j=0; j<batch_chain.numCols(); ++j) {
+    BOOST_CHECK_SMALL(batch_chain(3, j) - (1. - batch_chain(0, j)), 1.e-7);
+    BOOST_CHECK_GE(batch_chain(0, j), -2.); BOOST_CHECK_LE(batch_chain(0, j), 2.);
+    BOOST_CHECK_GE(batch_chain(1, j), -2.); BOOST_CHECK_LE(batch_chain(1, j), 2.);
+  }
+}
@@ -0,0 +1,143 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+
+#include "EvaluationThreadPool.hpp"
+#include <chrono>
+#include <stdexcept>
+
+#define BOOST_TEST_MODULE dakota_evaluation_thread_pool
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+
+namespace {
+
+/// collect all outstanding evaluations of pool
+void wait_all(EvaluationThreadPool& pool, IntSet& completed_ids,
+	      std::map<int, std::exception_ptr>& failures)
+{
+  while (pool.outstanding())
+    pool.wait(completed_ids, failures, true);
+}
+
+}
+
+//------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_tasks_start_in_submission_order)
+{
+  const size_t num_threads = 4;
+  const int num_evals = 64;
+  EvaluationThreadPool pool;
+  pool.initialize(num_threads);
+  BOOST_CHECK_EQUAL(pool.num_threads(), num_threads);
+
+  std::mutex order_mutex;
+  std::vector<int> start_order;
+  std::vector<size_t> thread_used(num_evals + 1, num_threads);
+  for (int id=1; id<=num_evals; ++id)
+    pool.submit(id, [&, id](size_t thread_index) {
+	{
+	  std::lock_guard<std::mutex> lock(order_mutex);
+	  start_order.push_back(id);
+	}
+	thread_used[id] = thread_index;
+	std::this_thread::sleep_for(std::chrono::microseconds(100 * (id % 3)));
+      });
+
+  IntSet completed_ids;
+  std::map<int, std::exception_ptr> failures;
+  wait_all(pool, completed_ids, failures);
+
+  BOOST_CHECK_EQUAL(completed_ids.size(), num_evals);
+  BOOST_CHECK(failures.empty());
+  BOOST_REQUIRE_EQUAL(start_order.size(), num_evals);
+  for (int i=0; i<num_evals; ++i)
+    BOOST_CHECK_EQUAL(start_order[i], i+1);
+  for (int id=1; id<=num_evals; ++id)
+    BOOST_CHECK(thread_used[id] < num_threads);
+}
+
+BOOST_AUTO_TEST_CASE(test_single_thread_completes_in_order)
+{
+  EvaluationThreadPool pool;
+  pool.initialize(1);
+
+  std::vector<int> finish_order;
+  for (int id=1; id<=10; ++id)
+    pool.submit(id, [&finish_order, id](size_t) { finish_order.push_back(id); });
+
+  IntSet completed_ids;
+  std::map<int, std::exception_ptr> failures;
+  wait_all(pool, completed_ids, failures);
+  BOOST_REQUIRE_EQUAL(finish_order.size(), 10);
+  for (int i=0; i<10; ++i)
+    BOOST_CHECK_EQUAL(finish_order[i], i+1);
+}
+
+BOOST_AUTO_TEST_CASE(test_exceptions_returned_with_eval_id)
+{
+  EvaluationThreadPool pool;
+  pool.initialize(3);
+
+  for (int id=1; id<=12; ++id)
+    pool.submit(id, [id](size_t) {
+	if (id % 4 == 0)
+	  throw std::runtime_error("eval " + std::to_string(id) + " failed");
+      });
+
+  IntSet completed_ids;
+  std::map<int, std::exception_ptr> failures;
+  wait_all(pool, completed_ids, failures);
+
+  // failed evaluations complete like the others, with their exception
+  BOOST_CHECK_EQUAL(completed_ids.size(), 12);
+  BOOST_REQUIRE_EQUAL(failures.size(), 3);
+  for (const auto& failure : failures) {
+    BOOST_CHECK_EQUAL(failure.first % 4, 0);
+    BOOST_CHECK(completed_ids.count(failure.first));
+    try {
+      std::rethrow_exception(failure.second);
+      BOOST_FAIL("exception not rethrown");
+    }
+    catch (const std::runtime_error& e) {
+      BOOST_CHECK_EQUAL(std::string(e.what()),
+			"eval " + std::to_string(failure.first) + " failed");
+    }
+  }
+
+  // the pool remains usable after failures
+  pool.submit(13, [](size_t) { });
+  completed_ids.clear(); failures.clear();
+  wait_all(pool, completed_ids, failures);
+  BOOST_CHECK_EQUAL(completed_ids.size(), 1);
+  BOOST_CHECK(failures.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_nonblocking_wait)
+{
+  EvaluationThreadPool pool;
+  pool.initialize(1);
+
+  std::mutex gate;
+  gate.lock();
+  pool.submit(1, [&gate](size_t) { std::lock_guard<std::mutex> lock(gate); });
+
+  IntSet completed_ids;
+  std::map<int, std::exception_ptr> failures;
+  pool.wait(completed_ids, failures, false);
+  BOOST_CHECK(completed_ids.empty());
+  BOOST_CHECK_EQUAL(pool.outstanding(), 1);
+
+  gate.unlock();
+  wait_all(pool, completed_ids, failures);
+  BOOST_CHECK_EQUAL(completed_ids.size(), 1);
+  BOOST_CHECK_EQUAL(pool.outstanding(), 0);
+}
@@ -11,6 +11,8 @@
 #include "ExperimentData.hpp"
 #include "dakota_data_io.hpp"
 #include "DakotaVariables.hpp"
+#include "DataMethod.hpp"
+#include "DataResponses.hpp"
 
 #include <string>
 
@@ -188,6 +190,126 @@ BOOST_AUTO_TEST_CASE(test_expt_data_twofield)
   Real triple_prod = expt_data.apply_covariance(resid_vals, 0);
   //std::cout << "triple_prod = " << triple_prod << std::endl;
   BOOST_CHECK_CLOSE( triple_prod, 3.06251e+14, 2.e-4 );
+
+  // Test block scaling of residual vectors against the triple product
+  RealMatrix resid_block(resid_vals.length(), 3);
+  for( int j=0; j<3; ++j )
+    for( int i=0; i<resid_vals.length(); ++i )
+      resid_block(i,j) = (j+1) * resid_vals[i];
+  expt_data.scale_residuals(resid_block);
+  for( int j=0; j<3; ++j ) {
+    RealVector scaled_resid = Teuchos::getCol(Teuchos::View, resid_block, j);
+    BOOST_CHECK_CLOSE( scaled_resid.dot(scaled_resid), (j+1)*(j+1)*triple_prod,
+		       1.e-8 );
+  }
+}
+
+//----------------------------------------------------------------
+
+namespace {
+
+  // expose the multiplier expansion used by the residual scaling
+  class ExperimentDataTester: public ExperimentData
+  {
+  public:
+    ExperimentDataTester(size_t num_experiments, size_t num_config_vars,
+			 const boost::filesystem::path& data_prefix,
+			 const SharedResponseData& srd,
+			 const StringArray& variance_types,
+			 short output_level):
+      ExperimentData(num_experiments, num_config_vars, data_prefix, srd,
+		     variance_types, output_level)
+    { }
+
+    using ExperimentData::generate_multipliers;
+  };
+
+}
+
+BOOST_AUTO_TEST_CASE(test_expt_data_multipliers)
+{
+  const size_t  SECOND_NUM_FIELD_VALUES = 9;
+
+  IntVector field_lengths(NUM_FIELDS+1);
+  field_lengths[0] = NUM_FIELD_VALUES;
+  field_lengths[1] = SECOND_NUM_FIELD_VALUES;
+  mock_srd.field_lengths(field_lengths);
+
+  StringArray variance_types(NUM_FIELDS+1);
+  variance_types[0] = "diagonal";
+  variance_types[1] = "matrix";
+
+  StringArray field_labels(NUM_FIELDS+1);
+  field_labels[0] = "new_voltage";
+  field_labels[1] = "pressure";
+  mock_srd.field_group_labels(field_labels);
+
+  ExperimentDataTester expt_data(NUM_EXPTS, NUM_CONFIG_VARS,
+				 "../expt_data_test_files", mock_srd,
+				 variance_types, 0 /* SILENT_OUTPUT */);
+  expt_data.load_data("expt_data unit test call", gen_mock_vars());
+
+  size_t num_resid = expt_data.num_total_exppoints();
+  BOOST_CHECK( num_resid == NUM_FIELD_VALUES + SECOND_NUM_FIELD_VALUES );
+
+  // The cached residual counts per multiplier must reproduce the sum
+  // of logs over the expanded multipliers; alternate the modes so the
+  // cache is rebuilt whenever the mode or number of multipliers changes
+  RealVector empty_mults;
+  Real cov_log_det = 2.*expt_data.half_log_cov_determinant(empty_mults,
+							   CALIBRATE_NONE);
+  unsigned short modes[] = { CALIBRATE_PER_EXPER, CALIBRATE_PER_RESP,
+			     CALIBRATE_BOTH, CALIBRATE_PER_RESP,
+			     CALIBRATE_PER_EXPER, CALIBRATE_BOTH };
+  size_t num_resp_groups = NUM_FIELDS+1;
+  for (size_t k=0; k<6; ++k) {
+    size_t num_mults = (modes[k] == CALIBRATE_PER_EXPER) ? NUM_EXPTS :
+      (modes[k] == CALIBRATE_PER_RESP) ? num_resp_groups :
+      NUM_EXPTS * num_resp_groups;
+    RealVector mults(num_mults), expanded;
+    for (size_t m=0; m<num_mults; ++m)
+      mults[m] = 0.5 + 0.75*m + 0.25*k;
+    expt_data.generate_multipliers(mults, modes[k], expanded);
+    BOOST_REQUIRE( expanded.length() == num_resid );
+    Real gold_log_det = cov_log_det;
+    for (size_t i=0; i<num_resid; ++i)
+      gold_log_det += std::log(expanded[i]);
+    BOOST_CHECK_CLOSE( 2.*expt_data.half_log_cov_determinant(mults, modes[k]),
+		       gold_log_det, 1.e-10 );
+  }
+
+  // Deferred block scaling of the residuals of several evals (as in
+  // DataTransformModel::scale_response_block()) must match scaling the
+  // residual response of each eval in turn, including the multipliers
+  const int num_evals = 3;
+  RealVector mults(num_resp_groups);
+  mults[0] = 2.; mults[1] = 0.25;
+  RealMatrix resid_block(num_resid, num_evals);
+  for (int j=0; j<num_evals; ++j)
+    for (size_t i=0; i<num_resid; ++i)
+      resid_block(i,j) = std::sin(1. + i + 7.*j);
+  std::vector<Response> gold_resp;
+  for (int j=0; j<num_evals; ++j) {
+    Response resid_resp(SIMULATION_RESPONSE, ActiveSet(num_resid));
+    RealVector fn_vals = resid_resp.function_values_view();
+    for (size_t i=0; i<num_resid; ++i)
+      fn_vals[i] = resid_block(i,j);
+    expt_data.scale_residuals(resid_resp);
+    expt_data.scale_residuals(mults, CALIBRATE_PER_RESP, 0, resid_resp);
+    gold_resp.push_back(resid_resp);
+  }
+
+  expt_data.scale_residuals(resid_block);
+  for (int j=0; j<num_evals; ++j) {
+    Response resid_resp(SIMULATION_RESPONSE, ActiveSet(num_resid));
+    RealVector fn_vals = resid_resp.function_values_view();
+    for (size_t i=0; i<num_resid; ++i)
+      fn_vals[i] = resid_block(i,j);
+    expt_data.scale_residuals(mults, CALIBRATE_PER_RESP, 0, resid_resp);
+    const RealVector& gold_vals = gold_resp[j].function_values();
+    for (size_t i=0; i<num_resid; ++i)
+      BOOST_CHECK_CLOSE( resid_resp.function_value(i), gold_vals[i], 1.e-10 );
+  }
 }
 
 //----------------------------------------------------------------
@@ -10,6 +10,8 @@
 
 #include "dakota_data_io.hpp"
 #include "dakota_tabular_io.hpp"
+#include "TabularReader.hpp"
+#include "TabularWriter.hpp"
 
 #include <string>
 
@@ -322,3 +324,70 @@ BOOST_AUTO_TEST_CASE(test_read_bad_data1)
 }
 
 //----------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_tabular_reader_writer)
+{
+  const int NUM_VARS = 3;
+  const int NUM_PTS = 25;
+  const std::string filename("test_tabular_reader_data");
+  RealMatrix samples(NUM_VARS, NUM_PTS);
+  samples.random();
+
+  {
+    std::ofstream out_file;
+    TabularIO::open_file(out_file, filename, "unit test tabular writer");
+    out_file << "%eval_id interface x1 x2 x3\n";
+    TabularIO::TabularWriter writer(out_file);
+    writer.write_rows(samples, "sim", TABULAR_ANNOTATED);
+  }
+  used_filenames.push_back(filename);
+
+  // read in chunks smaller than the file
+  TabularIO::TabularReader reader(filename, "unit test tabular reader",
+				  TABULAR_ANNOTATED);
+  BOOST_CHECK( reader.header().size() == NUM_VARS + 2 );
+  RealMatrix chunk;
+  size_t num_read, total_read = 0;
+  while ( (num_read = reader.read_records(chunk, NUM_VARS, 10)) ) {
+    for( size_t j=0; j<num_read; ++j )
+      for( int i=0; i<NUM_VARS; ++i )
+	BOOST_CHECK_CLOSE( samples(i, total_read+j), chunk(i, j), 1.e-7 );
+    total_read += num_read;
+  }
+  BOOST_CHECK( total_read == NUM_PTS );
+
+  // project onto the last and first variables
+  TabularIO::TabularReader proj_reader(filename, "unit test tabular reader",
+				       TABULAR_ANNOTATED);
+  proj_reader.project(SizetArray({2, 0}));
+  Real record[2];
+  int eval_id = 0; String iface_id;
+  for( int j=0; j<NUM_PTS; ++j ) {
+    BOOST_REQUIRE( proj_reader.read_record(record, 2, eval_id, iface_id) );
+    BOOST_CHECK( eval_id == j+1 );
+    BOOST_CHECK( iface_id == "sim" );
+    BOOST_CHECK_CLOSE( samples(2, j), record[0], 1.e-7 );
+    BOOST_CHECK_CLOSE( samples(0, j), record[1], 1.e-7 );
+  }
+  BOOST_CHECK( !proj_reader.read_record(record, 2) );
+}
+
+//----------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_tabular_reader_parse)
+{
+  Real value;
+  const std::string good[] = { "1", "-2.5", ".5", "1e-300", "0.1", "nan" };
+  for( const auto& tok : good ) {
+    BOOST_CHECK( TabularIO::TabularReader::
+		 parse_real(tok.data(), tok.data() + tok.size(), value) );
+    if( tok != "nan" )
+      BOOST_CHECK( value == std::strtod(tok.c_str(), NULL) );
+  }
+  const std::string bad[] = { "x", "1.0d0", "1e", "-", "1..2" };
+  for( const auto& tok : bad )
+    BOOST_CHECK( !TabularIO::TabularReader::
+		 parse_real(tok.data(), tok.data() + tok.size(), value) );
+}
+
+//----------------------------------------------------------------
@@ -0,0 +1,129 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "LibraryEnvironment.hpp"
+#include "NonDGenACVSampling.hpp"
+#include "DakotaResponse.hpp"
+
+#include <memory>
+#include <string>
+
+#define BOOST_TEST_MODULE dakota_gen_acv
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+
+namespace {
+
+  /// online pilot GenACV over all model subsets of a 5-level ensemble,
+  /// iterated until the HF target is met or max_iterations is reached
+  const char gen_acv_input[] =
+    "environment \n"
+    "  output_precision = 16 \n"
+    "method \n"
+    "  model_pointer = 'HIERARCH' \n"
+    "  approximate_control_variate \n"
+    "    acv_mf \n"
+    "    solution_mode online_pilot \n"
+    "    pilot_samples = 20 \n"
+    "    seed = 8674132 \n"
+    "    search_model_graphs \n"
+    "      model_selection \n"
+    "      kl_recursion \n"
+    "    max_function_evaluations = 500 \n"
+    "    max_iterations = 3 \n"
+    "    output silent \n"
+    "model \n"
+    "  id_model = 'HIERARCH' \n"
+    "  variables_pointer = 'HF_VARS' \n"
+    "  surrogate ensemble \n"
+    "    truth_model = 'HF' \n"
+    "model \n"
+    "  id_model = 'HF' \n"
+    "  variables_pointer = 'HF_VARS' \n"
+    "  interface_pointer = 'HF_INT' \n"
+    "  simulation \n"
+    "    solution_level_control = 'mesh_size' \n"
+    "    solution_level_cost = 1 4 16 64 256 \n"
+    "variables \n"
+    "  id_variables = 'HF_VARS' \n"
+    "  uniform_uncertain = 9 \n"
+    "    lower_bounds = 9*-1. \n"
+    "    upper_bounds = 9* 1. \n"
+    "  discrete_state_set \n"
+    "    integer = 1 \n"
+    "      initial_state = 64 \n"
+    "      set_values = 4 8 16 32 64 \n"
+    "      descriptors = 'mesh_size' \n"
+    "    real = 4 \n"
+    "      elements_per_variable = 2 2 1 1 \n"
+    "      set_values = 0.1 1 0.5 4 1 0.2 \n"
+    "      descriptors = 'field_mean' 'field_std_dev' 'kernel_order' \n"
+    "                    'kernel_length' \n"
+    "      initial_state = 1 4 1 0.2 \n"
+    "    string = 2 \n"
+    "      elements_per_variable = 2 2 \n"
+    "      initial_state = 'cosine' 'off' \n"
+    "      set_values = 'cosine' 'exponential' 'off' 'on' \n"
+    "      descriptors = 'kernel_type' 'positivity' \n"
+    "interface \n"
+    "  id_interface = 'HF_INT' \n"
+    "  direct \n"
+    "    analysis_driver = 'steady_state_diffusion_1d' \n"
+    "responses \n"
+    "  response_functions = 3 \n"
+    "  no_gradients \n"
+    "  no_hessians \n";
+
+  /// library environment exposing its top-level GenACV iterator
+  class GenACVTestEnvironment: public LibraryEnvironment
+  {
+  public:
+    GenACVTestEnvironment(const ProgramOptions& opts):
+      LibraryEnvironment(MPI_COMM_WORLD, opts, false)
+    { exit_mode("throw"); done_modifying_db(); }
+
+    NonDGenACVSampling& gen_acv()
+    {
+      return *std::static_pointer_cast<NonDGenACVSampling>
+	(topLevelIterator.iterator_rep());
+    }
+  };
+
+  /// final statistics of an online GenACV study, with or without
+  /// pruning of model subsets by their merit bounds
+  RealVector run_gen_acv(bool prune)
+  {
+    ProgramOptions opts;
+    opts.echo_input(false);
+    opts.input_string(gen_acv_input);
+    GenACVTestEnvironment env(opts);
+    env.gen_acv().prune_model_sets(prune);
+    env.execute();
+    return RealVector(env.response_results().function_values());
+  }
+
+}
+
+//----------------------------------------------------------------
+
+/** The incumbent merit is reset for each online iteration, such that
+    pruning by the merit bounds selects the same DAG (and so draws the
+    same sample increments and final statistics) as searching all model
+    subsets. */
+BOOST_AUTO_TEST_CASE(test_gen_acv_online_pruning)
+{
+  RealVector full_stats = run_gen_acv(false),
+    pruned_stats = run_gen_acv(true);
+
+  BOOST_REQUIRE( full_stats.length() > 0 );
+  BOOST_REQUIRE( pruned_stats.length() == full_stats.length() );
+  for (int i=0; i<full_stats.length(); ++i)
+    BOOST_CHECK_CLOSE( pruned_stats[i], full_stats[i], 1.e-6 );
+}
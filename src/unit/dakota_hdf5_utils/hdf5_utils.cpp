@@ -299,6 +299,152 @@ BOOST_AUTO_TEST_CASE(test_hdf5_cpp_row_append)
   }
 }
 
+BOOST_AUTO_TEST_CASE(test_hdf5_cpp_block_append)
+{
+  const std::string file_name("hdf5_block_append.h5");
+  const std::string ds_name("/unlimited_rows");
+  const std::string empty_ds_name("/unlimited_empty");
+
+  RealMatrix rmat(MAT_ROWS, MAT_COLS);
+  rmat.random();
+
+  // Write the first row individually, then the remaining rows as one block,
+  // then overwrite the last two rows using set_vectors
+  const int num_block_rows = MAT_ROWS - 1;
+  {
+    HDF5IOHelper h5_io(file_name, /* overwrite */ true);
+    std::vector<int> dims = {0, MAT_COLS};
+    h5_io.create_empty_dataset(ds_name, dims, Dakota::ResultsOutputType::REAL, MAT_ROWS);
+    h5_io.create_empty_dataset(empty_ds_name, dims, Dakota::ResultsOutputType::REAL, MAT_ROWS);
+    RealVector vec_out(MAT_COLS);
+    for(int j = 0; j < MAT_COLS; ++j)
+      vec_out[j] = rmat(0,j);
+    h5_io.append_vector(ds_name, vec_out, true);
+    std::vector<Real> block(num_block_rows*MAT_COLS, 0.0);
+    h5_io.append_vectors(ds_name, block, num_block_rows);
+    for(int i = 1; i < MAT_ROWS; ++i)
+      for(int j = 0; j < MAT_COLS; ++j)
+        block[(i-1)*MAT_COLS + j] = rmat(i,j);
+    h5_io.set_vectors(ds_name, block, 1, num_block_rows);
+    BOOST_CHECK_EQUAL(h5_io.append_empty(empty_ds_name, MAT_ROWS), 0);
+    BOOST_CHECK_EQUAL(h5_io.append_empty(empty_ds_name, 2), MAT_ROWS);
+  }
+
+  RealMatrix test_mat;
+  {
+    HDF5IOHelper h5_io(file_name);
+    h5_io.read_matrix(ds_name, test_mat, false);
+  }
+
+  BOOST_CHECK(test_mat.numRows() == MAT_ROWS);
+  BOOST_CHECK(test_mat.numCols() == MAT_COLS);
+  for(int i = 0; i < MAT_ROWS; ++i) {
+    for(int j = 0; j < MAT_COLS; ++j) {
+      BOOST_CHECK( rmat(i,j) == test_mat(i,j) );
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_hdf5_cpp_scalar_block_append)
+{
+  const std::string file_name("hdf5_scalar_block_append.h5");
+  const std::string ds_name("/unlimited_ds");
+
+  std::vector<int> vec_out(VEC_SIZE);
+  for(int i = 0; i < VEC_SIZE; ++i)
+    vec_out[i] = 3*i + 1;
+
+  {
+    HDF5IOHelper h5_io(file_name, /* overwrite */ true);
+    std::vector<int> dims = {0};
+    h5_io.create_empty_dataset(ds_name, dims, Dakota::ResultsOutputType::INTEGER, VEC_SIZE);
+    h5_io.append_scalar(ds_name, vec_out[0]);
+    std::vector<int> block(vec_out.begin() + 1, vec_out.end());
+    h5_io.append_scalars(ds_name, block);
+  }
+
+  std::vector<int> test_vec(VEC_SIZE);
+  {
+    HDF5IOHelper h5_io(file_name);
+    h5_io.read_vector(ds_name, test_vec);
+  }
+
+  BOOST_CHECK_EQUAL_COLLECTIONS( vec_out.begin(), vec_out.end(), test_vec.begin(), test_vec.end() );
+}
+
+BOOST_AUTO_TEST_CASE(test_hdf5_cpp_chunk_aligned_block_append)
+{
+  const std::string file_name("hdf5_chunk_aligned_block_append.h5");
+  const std::string ds_name("/unlimited_ds");
+  const std::string rows_ds_name("/unlimited_rows");
+  const int block_size = 5, num_blocks = 4;
+  const int num_appended = block_size*num_blocks + 1;
+
+  // extent of the 0th dimension and its chunk size, as seen by a reader
+  auto extent_and_chunk = [&](const std::string &name) {
+    H5::H5File h5_file(file_name, H5F_ACC_RDONLY);
+    H5::DataSet ds = h5_file.openDataSet(name);
+    hsize_t dims[2], chunks[2];
+    ds.getSpace().getSimpleExtentDims(dims);
+    ds.getCreatePlist().getChunk(ds.getSpace().getSimpleExtentNdims(), chunks);
+    return std::make_pair(dims[0], chunks[0]);
+  };
+
+  std::vector<int> vec_out(num_appended);
+  for(int i = 0; i < num_appended; ++i)
+    vec_out[i] = 2*i + 1;
+
+  {
+    HDF5IOHelper h5_io(file_name, /* overwrite */ true);
+    std::vector<int> dims = {0};
+    // chunks of several blocks
+    h5_io.create_empty_dataset(ds_name, dims, Dakota::ResultsOutputType::INTEGER, 1024);
+    std::vector<int> row_dims = {0, MAT_COLS};
+    h5_io.create_empty_dataset(rows_ds_name, row_dims, Dakota::ResultsOutputType::REAL, 1024);
+
+    for(int b = 0; b < num_blocks; ++b) {
+      std::vector<int> block(vec_out.begin() + b*block_size,
+                             vec_out.begin() + (b+1)*block_size);
+      h5_io.append_scalars(ds_name, block);
+      h5_io.flush();
+      // the dataset grows in whole chunks, not by the block size
+      auto ext = extent_and_chunk(ds_name);
+      const hsize_t num_used = (b+1)*block_size;
+      BOOST_CHECK( ext.second > block_size );
+      BOOST_CHECK_EQUAL( ext.first % ext.second, 0 );
+      BOOST_CHECK( ext.first >= num_used && ext.first < num_used + ext.second );
+    }
+    // a single-element append follows the appended (not the reserved) rows
+    h5_io.append_scalar(ds_name, vec_out.back());
+    h5_io.flush();
+    BOOST_CHECK_EQUAL( extent_and_chunk(ds_name).first, num_appended );
+
+    // rows reserved beyond the appended ones cannot be set
+    BOOST_CHECK_EQUAL( h5_io.append_empty(rows_ds_name, block_size), 0 );
+    std::vector<Real> row_block(MAT_COLS, 1.0);
+    h5_io.set_vectors(rows_ds_name, row_block, block_size - 1, 1);
+    BOOST_CHECK_THROW( h5_io.set_vectors(rows_ds_name, row_block, block_size, 1),
+                       std::runtime_error );
+    h5_io.trim_reserved_layers();
+    h5_io.flush();
+    BOOST_CHECK_EQUAL( extent_and_chunk(rows_ds_name).first, block_size );
+    h5_io.append_vectors(rows_ds_name, row_block, 1);
+    // released when the helper is destroyed
+  }
+
+  std::vector<int> test_vec;
+  RealMatrix test_mat;
+  {
+    HDF5IOHelper h5_io(file_name);
+    h5_io.read_vector(ds_name, test_vec);
+    h5_io.read_matrix(rows_ds_name, test_mat, false);
+  }
+  BOOST_CHECK_EQUAL_COLLECTIONS( vec_out.begin(), vec_out.end(), test_vec.begin(), test_vec.end() );
+  BOOST_CHECK_EQUAL( test_mat.numRows(), block_size + 1 );
+  BOOST_CHECK_EQUAL( test_mat(block_size - 1, 0), 1.0 );
+  BOOST_CHECK_EQUAL( test_mat(block_size, 0), 1.0 );
+}
+
 /* This capability has been disabled for now
   BOOST_AUTO_TEST_CASE(test_hdf5_cpp_col_append)
 {
@@ -0,0 +1,157 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "LibraryEnvironment.hpp"
+#include "DakotaModel.hpp"
+#include "DakotaResponse.hpp"
+
+#include <cstdio>
+#include <string>
+#include <system_error>
+
+#define BOOST_TEST_MODULE dakota_measured_cost
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+
+namespace {
+
+  /// MFMC over an ensemble in which only the HF model provides an
+  /// offline solution_level_cost
+  const char mfmc_input[] =
+    "environment \n"
+    "  output_precision = 16 \n"
+    "method \n"
+    "  model_pointer = 'NONHIER' \n"
+    "  multifidelity_sampling \n"
+    "    max_function_evaluations = 100 \n"
+    "    pilot_samples = 20 \n"
+    "    seed = 8674132 \n"
+    "    output silent \n"
+    "model \n"
+    "  id_model = 'NONHIER' \n"
+    "  variables_pointer = 'HF_VARS' \n"
+    "  surrogate ensemble \n"
+    "    truth_model = 'HF' \n"
+    "    unordered_model_fidelities = 'LF' \n"
+    "model \n"
+    "  id_model = 'LF' \n"
+    "  variables_pointer = 'LF_VARS' \n"
+    "  interface_pointer = 'LF_INT' \n"
+    "  simulation \n"
+    "model \n"
+    "  id_model = 'HF' \n"
+    "  variables_pointer = 'HF_VARS' \n"
+    "  interface_pointer = 'HF_INT' \n"
+    "  simulation \n"
+    "    solution_level_cost = 1. \n"
+    "variables \n"
+    "  id_variables = 'LF_VARS' \n"
+    "  uniform_uncertain = 2 \n"
+    "    lower_bounds = 2*-1. \n"
+    "    upper_bounds = 2* 1. \n"
+    "    descriptors = 'x' 'y' \n"
+    "  continuous_state = 1 \n"
+    "    initial_state = 0.5235987755983 \n"
+    "    descriptors = 'theta' \n"
+    "  discrete_state_set integer = 1 \n"
+    "    initial_state = 2 \n"
+    "    set_values = 2 \n"
+    "    descriptors = 'ModelForm' \n"
+    "variables \n"
+    "  id_variables = 'HF_VARS' \n"
+    "  uniform_uncertain = 2 \n"
+    "    lower_bounds = 2*-1. \n"
+    "    upper_bounds = 2* 1. \n"
+    "    descriptors = 'x' 'y' \n"
+    "  continuous_state = 1 \n"
+    "    initial_state = 1.5707963267949 \n"
+    "    descriptors = 'theta' \n"
+    "  discrete_state_set integer = 1 \n"
+    "    initial_state = 0 \n"
+    "    set_values = 0 \n"
+    "    descriptors = 'ModelForm' \n"
+    "interface \n"
+    "  id_interface = 'LF_INT' \n"
+    "  direct \n"
+    "    analysis_driver = 'tunable_model' \n"
+    "interface \n"
+    "  id_interface = 'HF_INT' \n"
+    "  direct \n"
+    "    analysis_driver = 'tunable_model' \n"
+    "responses \n"
+    "  response_functions = 1 \n"
+    "  no_gradients \n"
+    "  no_hessians \n";
+
+  const char restart_file[] = "dakota_measured_cost.rst";
+
+  /// library environment for mfmc_input, configured to throw on abort
+  std::shared_ptr<LibraryEnvironment>
+  create_env(const String& read_rst, const String& write_rst)
+  {
+    ProgramOptions opts;
+    opts.echo_input(false);
+    opts.input_string(mfmc_input);
+    if (!read_rst.empty())  opts.read_restart_file(read_rst);
+    if (!write_rst.empty()) opts.write_restart_file(write_rst);
+    auto p_env = std::make_shared<LibraryEnvironment>
+      (MPI_COMM_WORLD, opts, false);
+    p_env->exit_mode("throw");
+    p_env->done_modifying_db();
+    return p_env;
+  }
+
+  /// simulation model from the environment's model list with given id
+  Model simulation_model(LibraryEnvironment& env, const String& model_id)
+  {
+    ModelList models = env.filtered_model_list("simulation", "direct",
+					       "tunable_model");
+    for (ModelLIter ml_it = models.begin(); ml_it != models.end(); ++ml_it)
+      if (ml_it->model_id() == model_id)
+	return *ml_it; // envelope copy shares the model representation
+    BOOST_FAIL("model " << model_id << " not found");
+    return Model();
+  }
+
+}
+
+//----------------------------------------------------------------
+
+/** Only the model lacking an offline solution_level_cost has its
+    evaluations timed; the user-supplied HF cost is used as given. */
+BOOST_AUTO_TEST_CASE(test_measured_cost_without_metadata)
+{
+  std::shared_ptr<LibraryEnvironment> p_env = create_env("", "");
+  p_env->execute();
+
+  BOOST_CHECK( p_env->response_results().function_values().length() > 0 );
+
+  RealVector lf_cost
+    = simulation_model(*p_env, "LF").solution_level_measured_costs(),
+    hf_cost = simulation_model(*p_env, "HF").solution_level_measured_costs();
+  BOOST_REQUIRE( lf_cost.length() == 1 );
+  BOOST_CHECK( lf_cost[0] > 0. );
+  for (int i=0; i<hf_cost.length(); ++i)
+    BOOST_CHECK_EQUAL( hf_cost[i], 0. );
+}
+
+/** Evaluations recovered from a restart file are cache hits that cannot
+    be timed, so a model without cost data aborts at construction. */
+BOOST_AUTO_TEST_CASE(test_measured_cost_restart_abort)
+{
+  {
+    std::shared_ptr<LibraryEnvironment> p_env = create_env("", restart_file);
+    p_env->execute();
+  }
+
+  BOOST_CHECK_THROW( create_env(restart_file, ""), std::system_error );
+
+  std::remove(restart_file);
+}
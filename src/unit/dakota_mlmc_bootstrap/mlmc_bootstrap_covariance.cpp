@@ -0,0 +1,203 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "NonDMultilevelSampling.hpp"
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <random>
+
+#define BOOST_TEST_MODULE dakota_mlmc_bootstrap
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+
+namespace {
+
+const int NUM_FNS = 2;
+const int NUM_LEVELS = 3;
+const int NUM_SAMPLES = 20;
+const int NUM_BS_SAMPLES = 100;
+
+/// stored samples for each level; levels above 0 hold the QoI at
+/// level l followed by the (correlated) QoI at level l-1
+IntRealMatrixMap level_samples()
+{
+  std::mt19937 gen(1234);
+  std::normal_distribution<Real> normal(0., 1.);
+  IntRealMatrixMap lev_samples;
+  for (int lev = 0; lev < NUM_LEVELS; ++lev) {
+    int num_rows = (lev > 0) ? 2*NUM_FNS : NUM_FNS;
+    RealMatrix& samples = lev_samples[lev];
+    samples.shapeUninitialized(num_rows, NUM_SAMPLES);
+    for (int j = 0; j < NUM_SAMPLES; ++j)
+      for (int i = 0; i < NUM_FNS; ++i) {
+	samples(i, j) = (i + 1.) * std::exp(normal(gen) / (lev + 1.));
+	if (lev > 0)
+	  samples(i + NUM_FNS, j) = samples(i, j) + 0.1 * normal(gen);
+      }
+  }
+  return lev_samples;
+}
+
+Real mean(const RealVector& x, Real N)
+{
+  Real sum = 0;
+  for (int i = 0; i < x.length(); ++i)
+    sum += x[i];
+  return sum/N;
+}
+
+Real std_dev(const RealVector& x, Real N)
+{
+  Real sigma = 0, mean_hat = mean(x, N);
+  for (int i = 0; i < x.length(); ++i)
+    sigma += (x[i] - mean_hat)*(x[i] - mean_hat);
+  return std::sqrt(sigma/(N-1.));
+}
+
+Real cov(const RealVector& x, const RealVector& y)
+{
+  int n = x.length();
+  Real mean_x = mean(x, n), mean_y = mean(y, n), c = 0;
+  for (int i = 0; i < n; ++i)
+    c += (x[i] - mean_x)*(y[i] - mean_y);
+  return c/(n - 1.);
+}
+
+/// uncached reference: redraw the replicates from the seed and copy
+/// each into vectors, as before bootstrap replicates were cached
+Real uncached_bootstrap_covariance(int step, int qoi,
+				   const IntRealMatrixMap& lev_samples,
+				   Real N, int seed)
+{
+  const RealMatrix& samples = lev_samples.find(step)->second;
+  int nb_samples = samples.numCols();
+  boost::mt19937 rng(seed);
+  boost::random::uniform_int_distribution<> rand_int_range(0, nb_samples-1);
+  boost::variate_generator
+    < boost::mt19937, boost::random::uniform_int_distribution<> >
+    rand_int(rng, rand_int_range);
+
+  RealVector bs_l(nb_samples), bs_lm1(nb_samples),
+    meanl_bs(NUM_BS_SAMPLES), meanlm1_bs(NUM_BS_SAMPLES),
+    sigmal_bs(NUM_BS_SAMPLES), sigmalm1_bs(NUM_BS_SAMPLES);
+  for (int bs = 0; bs < NUM_BS_SAMPLES; ++bs) {
+    for (int s = 0; s < nb_samples; ++s) {
+      int idx = rand_int();
+      bs_l[s] = samples(qoi, idx);
+      bs_lm1[s] = (step > 0) ? samples(qoi + NUM_FNS, idx) : 0;
+    }
+    meanl_bs[bs] = mean(bs_l, N);  sigmal_bs[bs] = std_dev(bs_l, N);
+    meanlm1_bs[bs] = mean(bs_lm1, N);  sigmalm1_bs[bs] = std_dev(bs_lm1, N);
+  }
+
+  Real c = cov(meanl_bs, sigmal_bs);
+  if (step > 0)
+    c = c - cov(meanlm1_bs, sigmal_bs) - cov(meanl_bs, sigmalm1_bs)
+      + cov(meanlm1_bs, sigmalm1_bs);
+  return c;
+}
+
+} // anonymous namespace
+
+
+/// the cached estimates, both on a cold and a warm cache, are bitwise
+/// identical to those from redrawing the replicates on every call
+BOOST_AUTO_TEST_CASE(test_mlmc_bootstrap_covariance_matches_uncached)
+{
+  IntRealMatrixMap lev_samples = level_samples();
+  std::map<size_t, BootstrapReplicates> warm_cache;
+  Real N_values[] = { NUM_SAMPLES, 35., 127.5 };
+  int seed = 4321;
+
+  for (int pass = 0; pass < 2; ++pass)
+    for (int lev = 0; lev < NUM_LEVELS; ++lev)
+      for (int qoi = 0; qoi < NUM_FNS; ++qoi)
+	for (Real N : N_values) {
+	  Real ref = uncached_bootstrap_covariance(lev, qoi, lev_samples,
+						   N, seed), grad = -1.;
+	  std::map<size_t, BootstrapReplicates> cold_cache;
+	  Real cold = NonDMultilevelSampling::compute_bootstrap_covariance(
+	    lev, qoi, lev_samples, N, true, grad, &seed, cold_cache);
+	  BOOST_CHECK_EQUAL(cold, ref);
+	  BOOST_CHECK_EQUAL(grad, 0.); // gradient is disabled upstream
+
+	  Real warm = NonDMultilevelSampling::compute_bootstrap_covariance(
+	    lev, qoi, lev_samples, N, false, grad, &seed, warm_cache);
+	  BOOST_CHECK_EQUAL(warm, ref);
+	}
+}
+
+
+/// repeated calls with the seed and pilot samples fixed, as from the
+/// objective, gradient and constraint callbacks of the sample allocation
+/// optimizer, are served from the cache without redrawing the replicates
+BOOST_AUTO_TEST_CASE(test_mlmc_bootstrap_covariance_cache_reuse)
+{
+  IntRealMatrixMap lev_samples = level_samples();
+  std::map<size_t, BootstrapReplicates> cache;
+  int seed = 87;
+  Real N = NUM_SAMPLES, grad;
+
+  for (int lev = 0; lev < NUM_LEVELS; ++lev)
+    for (int qoi = 0; qoi < NUM_FNS; ++qoi)
+      NonDMultilevelSampling::compute_bootstrap_covariance(
+	lev, qoi, lev_samples, N, false, grad, &seed, cache);
+  BOOST_REQUIRE_EQUAL(cache.size(), NUM_LEVELS);
+
+  // retain the drawn replicates and tag each cached estimate, such that a
+  // recomputation (rather than a lookup) is detected
+  std::map<size_t, IntMatrix> indices;
+  for (int lev = 0; lev < NUM_LEVELS; ++lev) {
+    BootstrapReplicates& replicates = cache[lev];
+    BOOST_CHECK_EQUAL(replicates.seed, seed);
+    BOOST_CHECK_EQUAL(replicates.numSamples, NUM_SAMPLES);
+    BOOST_CHECK_EQUAL(replicates.indices.numCols(), NUM_BS_SAMPLES);
+    BOOST_CHECK_EQUAL(replicates.covariances.size(), NUM_FNS);
+    indices[lev] = replicates.indices;
+    for (int qoi = 0; qoi < NUM_FNS; ++qoi)
+      replicates.covariances[std::make_pair(size_t(qoi), N)].first
+	= 1000. * lev + qoi;
+  }
+
+  // objective, gradient and constraint evaluations over several iterations
+  for (int iter = 0; iter < 3; ++iter)
+    for (int call = 0; call < 3; ++call)
+      for (int lev = 0; lev < NUM_LEVELS; ++lev)
+	for (int qoi = 0; qoi < NUM_FNS; ++qoi) {
+	  Real c = NonDMultilevelSampling::compute_bootstrap_covariance(
+	    lev, qoi, lev_samples, N, call == 1, grad, &seed, cache);
+	  BOOST_CHECK_EQUAL(c, 1000. * lev + qoi);
+	}
+  for (int lev = 0; lev < NUM_LEVELS; ++lev) {
+    BOOST_CHECK(cache[lev].indices == indices[lev]);
+    BOOST_CHECK_EQUAL(cache[lev].covariances.size(), NUM_FNS);
+  }
+
+  // a new N reuses the replicates and adds an estimate
+  Real N_new = 2. * NUM_SAMPLES;
+  Real c = NonDMultilevelSampling::compute_bootstrap_covariance(
+    1, 0, lev_samples, N_new, false, grad, &seed, cache);
+  BOOST_CHECK_EQUAL(c, uncached_bootstrap_covariance(1, 0, lev_samples,
+						     N_new, seed));
+  BOOST_CHECK(cache[1].indices == indices[1]);
+  BOOST_CHECK_EQUAL(cache[1].covariances.size(), NUM_FNS + 1);
+
+  // a new seed redraws the replicates and discards the estimates
+  ++seed;
+  c = NonDMultilevelSampling::compute_bootstrap_covariance(
+    1, 0, lev_samples, N, false, grad, &seed, cache);
+  BOOST_CHECK_EQUAL(c, uncached_bootstrap_covariance(1, 0, lev_samples,
+						     N, seed));
+  BOOST_CHECK_EQUAL(cache[1].seed, seed);
+  BOOST_CHECK_EQUAL(cache[1].covariances.size(), 1);
+  BOOST_CHECK(!(cache[1].indices == indices[1]));
+}
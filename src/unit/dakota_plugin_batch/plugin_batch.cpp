@@ -0,0 +1,183 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+
+#include "PluginInterface.hpp"
+#include "ParamResponsePair.hpp"
+
+#define BOOST_TEST_MODULE dakota_plugin_batch
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+namespace DP = DakotaPlugins;
+
+namespace {
+
+/// the test model: f_i(x) = 1000 * eval_id + (i+1) * x_i, whose
+/// gradient d f_i / d x_r = (i+1) * delta_ir + eval_id makes results
+/// attributed to the wrong evaluation detectable
+Real test_fn(int eval_id, size_t i, const Real* x)
+{ return 1000. * eval_id + (i+1) * x[i]; }
+
+Real test_grad(int eval_id, size_t i, size_t r)
+{ return ((i == r) ? i+1. : 0.) + eval_id; }
+
+
+/// plugin implementing only the single evaluator, which exercises the
+/// default evaluate_batch()
+class SinglePlugin: public DP::DakotaInterfaceAPI
+{
+public:
+  DP::EvalResponse evaluate(DP::EvalRequest const& request) override
+  {
+    ++numCalls;
+    DP::EvalResponse response;
+    resize_response_arrays(request, response);
+    for (size_t i = 0; i < request.activeSet.size(); ++i) {
+      if (request.activeSet[i] & 1)
+	response.functions[i] = test_fn(request.functionEvalId, i,
+					request.continuousVars.data());
+      if (request.activeSet[i] & 2)
+	for (size_t r = 0; r < request.derivativeVars.size(); ++r)
+	  response.gradients[i][r] = test_grad(request.functionEvalId, i, r);
+    }
+    return response;
+  }
+
+  size_t numCalls = 0;
+};
+
+
+/// plugin overriding the contiguous batch evaluator
+class BatchPlugin: public DP::DakotaInterfaceAPI
+{
+public:
+  DP::EvalResponse evaluate(DP::EvalRequest const&) override
+  { throw std::runtime_error("single evaluator called for a batch"); }
+
+  void evaluate_batch(DP::BatchEvalRequest const& request,
+		      DP::BatchEvalResponse& response) override
+  {
+    ++numCalls;
+    size_t const num_fns = request.numFunctions,
+      num_derivs = request.derivativeVars.size();
+    for (size_t j = 0; j < request.numEvals; ++j) {
+      int const eval_id = request.functionEvalIds[j];
+      double const* x = request.continuousVars + j*request.numContinuousVars;
+      for (size_t i = 0; i < num_fns; ++i) {
+	size_t const k = j*num_fns + i;
+	if (request.activeSet[k] & 1)
+	  response.functions[k] = test_fn(eval_id, i, x);
+	if (request.activeSet[k] & 2)
+	  for (size_t r = 0; r < num_derivs; ++r)
+	    response.gradients[k*num_derivs + r] = test_grad(eval_id, i, r);
+      }
+    }
+  }
+
+  size_t numCalls = 0;
+};
+
+
+/// queue of evaluations of 2 variables and 2 functions, inserted out of
+/// eval id order, with values only or values and gradients requested
+PRPQueue make_queue()
+{
+  SizetArray vc_totals(NUM_VC_TOTALS, 0);
+  vc_totals[TOTAL_CDV] = 2;
+  std::pair<short, short> view(MIXED_ALL, EMPTY_VIEW);
+  SharedVariablesData svd(view, vc_totals);
+
+  PRPQueue prp_queue;
+  const int eval_ids[] = { 12, 3, 7, 25, 4 };
+  for (int id : eval_ids) {
+    Variables vars(svd);
+    vars.continuous_variable(0.5 * id, 0);
+    vars.continuous_variable(-1. * id, 1);
+    ActiveSet set(2, 2);
+    ShortArray asv(2, 1);
+    if (id % 2) asv[1] = 3;
+    set.request_vector(asv);
+    Response resp(SIMULATION_RESPONSE, set);
+    prp_queue.insert(ParamResponsePair(vars, "PLUGIN", resp, id));
+  }
+  return prp_queue;
+}
+
+/// check each response against the test model at its own eval id
+void check_responses(const PRPQueue& prp_queue)
+{
+  for (const ParamResponsePair& prp : prp_queue) {
+    int id = prp.eval_id();
+    const Real* x = prp.variables().continuous_variables().values();
+    const Response& resp = prp.response();
+    const ShortArray& asv = resp.active_set_request_vector();
+    for (size_t i = 0; i < 2; ++i) {
+      BOOST_CHECK_CLOSE(resp.function_value(i), test_fn(id, i, x), 1.e-12);
+      if (asv[i] & 2) {
+	const RealMatrix& grads = resp.function_gradients();
+	for (size_t r = 0; r < 2; ++r)
+	  BOOST_CHECK_EQUAL(grads(r, i), test_grad(id, i, r));
+      }
+    }
+  }
+}
+
+}
+
+//------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_batch_override_maps_to_eval_ids)
+{
+  PRPQueue prp_queue = make_queue();
+  BatchEvaluation batch_eval;
+  BOOST_REQUIRE(batch_eval.pack(prp_queue));
+  BOOST_CHECK_EQUAL(batch_eval.num_evaluations(), prp_queue.size());
+
+  BatchPlugin plugin;
+  PluginInterface::evaluate_packed_batch(plugin, batch_eval,
+					 prp_queue.begin()->variables());
+  BOOST_CHECK_EQUAL(plugin.numCalls, 1);
+  batch_eval.unpack(prp_queue);
+  check_responses(prp_queue);
+}
+
+BOOST_AUTO_TEST_CASE(test_default_batch_calls_single_evaluator)
+{
+  PRPQueue prp_queue = make_queue();
+  BatchEvaluation batch_eval;
+  BOOST_REQUIRE(batch_eval.pack(prp_queue));
+
+  SinglePlugin plugin;
+  PluginInterface::evaluate_packed_batch(plugin, batch_eval,
+					 prp_queue.begin()->variables());
+  BOOST_CHECK_EQUAL(plugin.numCalls, prp_queue.size());
+  batch_eval.unpack(prp_queue);
+  check_responses(prp_queue);
+}
+
+BOOST_AUTO_TEST_CASE(test_batch_storage_reused)
+{
+  // a second batch of the same shape reuses storage and must not see
+  // results left from the first
+  PRPQueue prp_queue = make_queue();
+  BatchEvaluation batch_eval;
+  BatchPlugin plugin;
+  BOOST_REQUIRE(batch_eval.pack(prp_queue));
+  PluginInterface::evaluate_packed_batch(plugin, batch_eval,
+					 prp_queue.begin()->variables());
+
+  PRPQueue second_queue = make_queue();
+  BOOST_REQUIRE(batch_eval.pack(second_queue));
+  BOOST_CHECK_EQUAL(batch_eval.function_values()(0, 0), 0.);
+  PluginInterface::evaluate_packed_batch(plugin, batch_eval,
+					 second_queue.begin()->variables());
+  batch_eval.unpack(second_queue);
+  check_responses(second_queue);
+}
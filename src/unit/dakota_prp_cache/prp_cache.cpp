@@ -0,0 +1,189 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+
+#include "QuantizedPRPCache.hpp"
+#include "dakota_data_util.hpp"
+#include <cmath>
+#include <limits>
+
+#define BOOST_TEST_MODULE dakota_prp_cache
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+
+namespace {
+
+/// Variables with num_cv continuous and one discrete integer variable
+Variables make_vars(size_t num_cv)
+{
+  SizetArray vc_totals(NUM_VC_TOTALS, 0);
+  vc_totals[TOTAL_CDV] = num_cv;
+  vc_totals[TOTAL_DDIV] = 1;
+  std::pair<short, short> view(MIXED_ALL, EMPTY_VIEW);
+  SharedVariablesData svd(view, vc_totals);
+  return Variables(svd);
+}
+
+/// deep-copied PRP for vars with a value-only response
+ParamResponsePair make_prp(const Variables& vars, const String& iface_id,
+			   int eval_id, short asv_val = 1)
+{
+  ActiveSet set(1, vars.cv());
+  set.request_values(asv_val);
+  Response resp(SIMULATION_RESPONSE, set);
+  resp.function_value((Real)eval_id, 0);
+  return ParamResponsePair(vars, iface_id, resp, eval_id);
+}
+
+ActiveSet value_set(size_t num_cv)
+{
+  ActiveSet set(1, num_cv);
+  set.request_values(1);
+  return set;
+}
+
+}
+
+//------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_exact_lookup_hits_and_misses)
+{
+  QuantizedPRPCache cache;
+  cache.initialize(0., 0);
+
+  Variables vars = make_vars(2);
+  vars.continuous_variable(1.5, 0);
+  vars.continuous_variable(-0.25, 1);
+  vars.all_discrete_int_variable(3, 0);
+  cache.insert(make_prp(vars, "IFACE", 1));
+  BOOST_CHECK_EQUAL(cache.size(), 1);
+
+  ActiveSet set = value_set(2);
+  Variables search = vars.copy();
+  const ParamResponsePair* found = cache.find("IFACE", search, set);
+  BOOST_REQUIRE(found != NULL);
+  BOOST_CHECK_EQUAL(found->eval_id(), 1);
+
+  // other interface, discrete value, or continuous value one ulp away
+  BOOST_CHECK(cache.find("OTHER", search, set) == NULL);
+  search.all_discrete_int_variable(4, 0);
+  BOOST_CHECK(cache.find("IFACE", search, set) == NULL);
+  search.all_discrete_int_variable(3, 0);
+  search.continuous_variable(std::nextafter(1.5, 2.), 0);
+  BOOST_CHECK(cache.find("IFACE", search, set) == NULL);
+
+  // requests not contained in the cached active set
+  search.continuous_variable(1.5, 0);
+  ActiveSet grad_set = value_set(2);
+  grad_set.request_values(3);
+  BOOST_CHECK(cache.find("IFACE", search, grad_set) == NULL);
+
+  // -0. matches 0., consistent with operator==
+  Variables zero_vars = vars.copy();
+  zero_vars.continuous_variable(0., 1);
+  cache.insert(make_prp(zero_vars, "IFACE", 2));
+  search.continuous_variable(-0., 1);
+  found = cache.find("IFACE", search, set);
+  BOOST_REQUIRE(found != NULL);
+  BOOST_CHECK_EQUAL(found->eval_id(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_tolerance_lookup_matches_nearby)
+{
+  // sweep values finely across many quantization cells, so that cached
+  // and search values fall on both sides of cell boundaries, and require
+  // the cache to agree with nearby() for offsets on either side of the
+  // tolerance
+  const Real rel_tol = 1.e-6;
+  QuantizedPRPCache cache;
+  cache.initialize(rel_tol, 0);
+
+  Variables vars = make_vars(1);
+  const int num_pts = 2000;
+  for (int k=0; k<num_pts; ++k) {
+    Variables v = vars.copy();
+    v.continuous_variable(((k % 2) ? -1. : 1.) * std::exp(1.e-7 * k), 0);
+    cache.insert(make_prp(v, "IFACE", k+1));
+  }
+  BOOST_CHECK_EQUAL(cache.size(), num_pts);
+
+  ActiveSet set = value_set(1);
+  const Real offsets[] = { 0., 0.5, -0.5, 0.99, -0.99, 1.01, -1.01, 2. };
+  size_t num_hits = 0, num_misses = 0;
+  for (int k=0; k<num_pts; k+=3) {
+    Real x = ((k % 2) ? -1. : 1.) * std::exp(1.e-7 * k);
+    Variables cached = vars.copy();
+    cached.continuous_variable(x, 0);
+    for (Real off : offsets) {
+      Variables search = vars.copy();
+      search.continuous_variable(x * (1. + off * rel_tol), 0);
+      const ParamResponsePair* found = cache.find("IFACE", search, set);
+      if (nearby(cached, search, rel_tol)) {
+	// a hit on the entry itself or on a neighbor within tolerance
+	BOOST_REQUIRE(found != NULL);
+	BOOST_CHECK(nearby(found->variables(), search, rel_tol));
+	++num_hits;
+      }
+      else if (found) // only a different entry within tolerance may match
+	BOOST_CHECK(nearby(found->variables(), search, rel_tol) &&
+		    found->eval_id() != k+1);
+      else
+	++num_misses;
+    }
+  }
+  BOOST_CHECK(num_hits > 0);
+  BOOST_CHECK(num_misses > 0);
+
+  // values near zero only match values near zero
+  Variables zero_vars = vars.copy();
+  zero_vars.continuous_variable(0., 0);
+  cache.insert(make_prp(zero_vars, "IFACE", num_pts+1));
+  Variables search = vars.copy();
+  search.continuous_variable(std::numeric_limits<Real>::denorm_min(), 0);
+  const ParamResponsePair* found = cache.find("IFACE", search, set);
+  BOOST_REQUIRE(found != NULL);
+  BOOST_CHECK_EQUAL(found->eval_id(), num_pts+1);
+  search.continuous_variable(1.e-300, 0);
+  BOOST_CHECK(cache.find("IFACE", search, set) == NULL);
+}
+
+BOOST_AUTO_TEST_CASE(test_lru_eviction_and_erase)
+{
+  QuantizedPRPCache cache;
+  cache.initialize(0., 2);
+
+  Variables vars = make_vars(1);
+  std::vector<ParamResponsePair> prps;
+  for (int k=1; k<=3; ++k) {
+    Variables v = vars.copy();
+    v.continuous_variable((Real)k, 0);
+    prps.push_back(make_prp(v, "IFACE", k));
+  }
+  ActiveSet set = value_set(1);
+
+  cache.insert(prps[0]);
+  cache.insert(prps[1]);
+  // touch the first entry so that the second is least recently used
+  BOOST_CHECK(cache.find("IFACE", prps[0].variables(), set) != NULL);
+  cache.insert(prps[2]);
+  BOOST_CHECK_EQUAL(cache.size(), 2);
+  BOOST_CHECK(cache.find("IFACE", prps[0].variables(), set) != NULL);
+  BOOST_CHECK(cache.find("IFACE", prps[1].variables(), set) == NULL);
+  BOOST_CHECK(cache.find("IFACE", prps[2].variables(), set) != NULL);
+
+  cache.erase(prps[0]);
+  BOOST_CHECK_EQUAL(cache.size(), 1);
+  BOOST_CHECK(cache.find("IFACE", prps[0].variables(), set) == NULL);
+  BOOST_CHECK(cache.find("IFACE", prps[2].variables(), set) != NULL);
+
+  cache.clear();
+  BOOST_CHECK_EQUAL(cache.size(), 0);
+  BOOST_CHECK(cache.find("IFACE", prps[2].variables(), set) == NULL);
+}
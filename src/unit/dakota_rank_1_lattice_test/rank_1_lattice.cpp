@@ -599,6 +599,30 @@ BOOST_AUTO_TEST_CASE(lattice_check_lattice_negative_seed)
   );
 }
 
+// +-------------------------------------------------------------------------+
+// |                      Test blocked point generation                      |
+// +-------------------------------------------------------------------------+
+BOOST_AUTO_TEST_CASE(lattice_check_blocked_points)
+{
+  // Get randomly-shifted rank-1 lattice rule with a fixed seed
+  Dakota::Rank1Lattice lattice(23);
+
+  // Get all points at once (large enough to be generated in blocks)
+  size_t numPoints = 1 << 16;
+  size_t dimension = 8;
+  Dakota::RealMatrix points(dimension, numPoints);
+  lattice.get_points(points);
+
+  // Points between arbitrary indices must match the corresponding points
+  size_t nMin = 12345;
+  size_t nMax = 54321;
+  Dakota::RealMatrix points_range(dimension, nMax - nMin);
+  lattice.get_points(nMin, nMax, points_range);
+  for ( size_t n = nMin; n < nMax; ++n )
+    for ( size_t d = 0; d < dimension; ++d )
+      BOOST_CHECK_EQUAL(points_range[n - nMin][d], points[n][d]);
+}
+
 } // end namespace TestRank1Lattice
 
 } // end namespace TestLowDiscrepancy
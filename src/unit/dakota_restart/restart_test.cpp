@@ -163,14 +163,16 @@ BOOST_AUTO_TEST_CASE(test_io_restart_1var)
     RestartWriter rst_writer(rst_stream);
     prps_out = generate_minimal_prps(num_evals, rst_writer);
   }
-  boost::archive::binary_iarchive restart_input_archive(rst_stream);
-  RestartVersion rst_ver;
-  restart_input_archive & rst_ver;
+  RestartReader rst_reader(rst_stream);
+  BOOST_CHECK(rst_reader.version().framed_records());
   for (int eval_id = 1; eval_id <= num_evals; ++eval_id) {
     ParamResponsePair prp_in;
-    restart_input_archive & prp_in;
+    BOOST_REQUIRE(rst_reader.read_prp(prp_in));
     prps_in.push_back(prp_in);
   }
+  ParamResponsePair prp_end;
+  BOOST_CHECK(!rst_reader.read_prp(prp_end));
+  BOOST_CHECK(!rst_reader.truncated());
 
   BOOST_CHECK(prps_in == prps_out);
 
@@ -192,15 +194,11 @@ BOOST_AUTO_TEST_CASE(test_io_restart_allvar)
     prps_out = generate_and_write_prps(num_evals, rst_writer);
   }
 
-  // scope to destruct ifstream so file can be removed
+  // scope to destruct reader so file can be removed
   {
-    std::ifstream restart_input_fs(rst_filename, std::ios::binary);
-    boost::archive::binary_iarchive restart_input_archive(restart_input_fs);
-
-    RestartVersion rst_ver;
-    restart_input_archive & rst_ver;
-
-    prps_in = read_prps(num_evals, restart_input_archive);
+    RestartReader rst_reader(rst_filename);
+    BOOST_CHECK(rst_reader.read_prps(prps_in) == num_evals);
+    BOOST_CHECK(!rst_reader.truncated());
     BOOST_CHECK(prps_in == prps_out);
   }
 
@@ -251,6 +249,15 @@ BOOST_AUTO_TEST_CASE(test_io_restart_read_oldfile)
     BOOST_CHECK(prps_in == prps_out);
   }
 
+  // the reader falls back to the archive stream
+  {
+    RestartReader rst_reader(rst_filename);
+    BOOST_CHECK(!rst_reader.version().framed_records());
+    PRPArray prps_rdr;
+    BOOST_CHECK(rst_reader.read_prps(prps_rdr) == num_evals);
+    BOOST_CHECK(prps_rdr == prps_out);
+  }
+
   boost::filesystem::remove(rst_filename);
 }
 
@@ -329,8 +336,65 @@ BOOST_AUTO_TEST_CASE(test_io_restart_read_newfile)
     BOOST_CHECK(rst_ver.restartVersion >= RestartVersion::restartFirstVersionNumber);
     BOOST_CHECK(rst_ver.dakotaRelease == "6.16.0+");
     BOOST_CHECK(rst_ver.dakotaSHA1 == "a1b2c3d4e5f6");
+  }
+
+  {
+    RestartReader rst_reader(rst_filename);
+    BOOST_CHECK(rst_reader.read_prps(prps_in) == num_evals);
+    BOOST_CHECK(prps_in == prps_out);
+  }
+
+  boost::filesystem::remove(rst_filename);
+}
+
+
+// Verify a file without its index (e.g., after an abort) or with a
+// corrupt tail is truncated to the complete records preceding it
+BOOST_AUTO_TEST_CASE(test_io_restart_truncated_tail)
+{
+  std::string rst_filename("truncated.rst");
+  boost::filesystem::remove(rst_filename);
+
+  const int num_evals = 10;
+  PRPArray prps_out;
+  {
+    RestartWriter rst_writer(rst_filename);
+    prps_out = generate_and_write_prps(num_evals, rst_writer);
+  }
 
-    prps_in = read_prps(num_evals, inarch);
+  // drop the trailer, index, and part of the last record
+  size_t index_size = sizeof(RestartVersion::RecordHeader) + num_evals *
+    sizeof(RestartVersion::IndexEntry) + sizeof(RestartVersion::IndexTrailer);
+  boost::filesystem::resize_file(rst_filename,
+    boost::filesystem::file_size(rst_filename) - index_size - 8);
+  {
+    RestartReader rst_reader(rst_filename);
+    PRPArray prps_in;
+    BOOST_CHECK(rst_reader.read_prps(prps_in) == num_evals - 1);
+    BOOST_CHECK(rst_reader.truncated());
+    prps_out.pop_back();
+    BOOST_CHECK(prps_in == prps_out);
+  }
+
+  // corrupt the last byte of the final record of a complete file
+  {
+    RestartWriter rst_writer(rst_filename);
+    prps_out = generate_and_write_prps(num_evals, rst_writer);
+  }
+  {
+    std::fstream rst_fs(rst_filename,
+			std::ios::in | std::ios::out | std::ios::binary);
+    rst_fs.seekg(-(std::streamoff)index_size - 1, std::ios::end);
+    char last_byte = rst_fs.get();
+    rst_fs.seekp(-(std::streamoff)index_size - 1, std::ios::end);
+    rst_fs.put(~last_byte);
+  }
+  {
+    RestartReader rst_reader(rst_filename);
+    PRPArray prps_in;
+    BOOST_CHECK(rst_reader.read_prps(prps_in) == num_evals - 1);
+    BOOST_CHECK(rst_reader.truncated());
+    prps_out.pop_back();
     BOOST_CHECK(prps_in == prps_out);
   }
 
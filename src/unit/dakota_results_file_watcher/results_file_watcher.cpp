@@ -0,0 +1,205 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+
+#include "ResultsFileWatcher.hpp"
+#include <fstream>
+
+#define BOOST_TEST_MODULE dakota_results_file_watcher
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+
+namespace {
+
+/// scratch directory, removed when the test case ends
+struct ScratchDir {
+  ScratchDir(): path(bfs::temp_directory_path() /
+		     bfs::unique_path("dakota_rfw_%%%%-%%%%"))
+  { bfs::create_directories(path); }
+  ~ScratchDir()
+  { boost::system::error_code ec; bfs::remove_all(path, ec); }
+  bfs::path path;
+};
+
+/// whether watcher reports id ready in a single nonblocking pass
+bool is_ready(ResultsFileWatcher& watcher, int id)
+{
+  IntSet ready_ids;
+  watcher.ready(ready_ids);
+  return ready_ids.count(id) > 0;
+}
+
+/// alternate ready() and wait() until id is ready; the bound covers
+/// several maximal polling delays
+bool wait_ready(ResultsFileWatcher& watcher, int id, size_t max_passes = 40)
+{
+  for (size_t i=0; i<max_passes; ++i) {
+    if (is_ready(watcher, id))
+      return true;
+    watcher.wait();
+  }
+  return false;
+}
+
+/// write a complete results file and close it
+void write_file(const bfs::path& file, const String& contents)
+{ std::ofstream out(file.string().c_str()); out << contents; }
+
+bfs::path sentinel(const bfs::path& file)
+{ return bfs::path(file.string() + ".done"); }
+
+}
+
+//------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_close_after_write_signals_ready)
+{
+  ScratchDir dir;
+  bfs::path results = dir.path / "results.out.1";
+  ResultsFileWatcher watcher;
+  watcher.add(1, results);
+  BOOST_CHECK(!is_ready(watcher, 1));
+
+  write_file(results, "1.0 f\n");
+  // the close event is queued before the writer returns; without
+  // inotify the first poll only records the size and time
+  BOOST_CHECK_EQUAL(is_ready(watcher, 1), watcher.event_driven());
+  BOOST_CHECK(wait_ready(watcher, 1));
+  watcher.remove(1);
+}
+
+BOOST_AUTO_TEST_CASE(test_rename_into_place_signals_ready)
+{
+  ScratchDir dir;
+  bfs::path results = dir.path / "results.out.1",
+    partial = dir.path / "results.out.1.tmp";
+  ResultsFileWatcher watcher;
+  watcher.add(1, results);
+  write_file(partial, "1.0 f\n");
+  bfs::rename(partial, results);
+  BOOST_CHECK_EQUAL(is_ready(watcher, 1), watcher.event_driven());
+  BOOST_CHECK(wait_ready(watcher, 1));
+  watcher.remove(1);
+}
+
+BOOST_AUTO_TEST_CASE(test_sentinel_signals_ready)
+{
+  ScratchDir dir;
+  bfs::path results = dir.path / "results.out.1";
+  ResultsFileWatcher watcher;
+  watcher.add(1, results);
+
+  // the results file is left open, so only the sentinel signals completion
+  std::ofstream out(results.string().c_str());
+  out << "1.0 f\n" << std::flush;
+  write_file(sentinel(results), "");
+  // found by the close event, or by the initial poll of the sentinel
+  BOOST_CHECK(is_ready(watcher, 1));
+
+  // the sentinel is consumed once the evaluation is removed
+  watcher.remove(1);
+  BOOST_CHECK(!bfs::exists(sentinel(results)));
+}
+
+BOOST_AUTO_TEST_CASE(test_stat_polling_signals_ready)
+{
+  ScratchDir dir;
+  bfs::path results = dir.path / "results.out.1";
+  ResultsFileWatcher watcher;
+  watcher.add(1, results);
+
+  // no close, rename, or sentinel: as for a write from another host,
+  // only stable size and modification time across polls signal completion
+  std::ofstream out(results.string().c_str());
+  out << "1.0 f\n" << std::flush;
+  BOOST_CHECK(!is_ready(watcher, 1));
+  BOOST_CHECK(wait_ready(watcher, 1));
+  watcher.remove(1);
+}
+
+BOOST_AUTO_TEST_CASE(test_incomplete_read_waits_for_new_signal)
+{
+  ScratchDir dir;
+  bfs::path results = dir.path / "results.out.1";
+  ResultsFileWatcher watcher;
+  watcher.add(1, results);
+  std::ofstream out(results.string().c_str());
+  out << "1.0 f\n" << std::flush;
+  BOOST_CHECK(wait_ready(watcher, 1));
+
+  watcher.retry(1);
+  BOOST_CHECK(!is_ready(watcher, 1));
+  out << "2.0 f\n";
+  out.close();
+  BOOST_CHECK(wait_ready(watcher, 1));
+  watcher.remove(1);
+}
+
+BOOST_AUTO_TEST_CASE(test_reused_file_name)
+{
+  ScratchDir dir;
+  bfs::path results = dir.path / "results.out";
+  ResultsFileWatcher watcher;
+
+  // first evaluation completes through its sentinel; its close event is
+  // left pending when the evaluation is removed
+  watcher.add(1, results);
+  write_file(results, "1.0 f\n");
+  write_file(sentinel(results), "");
+  watcher.remove(1);
+  BOOST_CHECK(!bfs::exists(sentinel(results)));
+
+  // a sentinel from an earlier run is cleared before the next launch,
+  // as is the results file (unless allow_existing_results)
+  write_file(sentinel(results), "");
+  ResultsFileWatcher::clear_sentinel(results);
+  BOOST_CHECK(!bfs::exists(sentinel(results)));
+  bfs::remove(results);
+  ResultsFileWatcher::clear_sentinel(results); // no sentinel: no error
+
+  // neither the stale events nor stale files signal the second evaluation
+  watcher.add(2, results);
+  BOOST_CHECK(!is_ready(watcher, 2));
+  for (size_t i=0; i<4; ++i) {
+    watcher.wait();
+    BOOST_CHECK(!is_ready(watcher, 2));
+  }
+
+  write_file(results, "2.0 f\n");
+  BOOST_CHECK(wait_ready(watcher, 2));
+  watcher.remove(2);
+}
+
+BOOST_AUTO_TEST_CASE(test_shared_directory_watch)
+{
+  ScratchDir dir;
+  ResultsFileWatcher watcher;
+  const int num_evals = 8;
+  for (int id=1; id<=num_evals; ++id)
+    watcher.add(id, dir.path / ("results.out." + std::to_string(id)));
+
+  // complete the even evaluations only
+  for (int id=2; id<=num_evals; id+=2)
+    write_file(dir.path / ("results.out." + std::to_string(id)), "1.0 f\n");
+  for (int id=2; id<=num_evals; id+=2)
+    BOOST_CHECK(wait_ready(watcher, id));
+  IntSet ready_ids;
+  watcher.ready(ready_ids);
+  for (int id=1; id<=num_evals; id+=2)
+    BOOST_CHECK(!ready_ids.count(id));
+
+  // removing some evaluations keeps the watch for the others
+  for (int id=2; id<=num_evals; id+=2)
+    watcher.remove(id);
+  write_file(dir.path / "results.out.1", "1.0 f\n");
+  BOOST_CHECK(wait_ready(watcher, 1));
+  for (int id=1; id<=num_evals; id+=2)
+    watcher.remove(id);
+}
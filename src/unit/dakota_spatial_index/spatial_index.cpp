@@ -0,0 +1,91 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+
+#include "SpatialIndex.hpp"
+#include <cmath>
+#include <random>
+
+#define BOOST_TEST_MODULE dakota_spatial_index
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+
+namespace {
+
+/// squared distance between x and y, ignoring coordinate skip_dim
+Real dist_sq(const RealArray& x, const RealArray& y, size_t skip_dim = _NPOS)
+{
+  Real sum = 0.;
+  for (size_t d=0; d<x.size(); ++d)
+    if (d != skip_dim)
+      sum += (x[d] - y[d]) * (x[d] - y[d]);
+  return sum;
+}
+
+}
+
+//------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_spatial_index_queries_match_linear_scan)
+{
+  std::mt19937 gen(1234);
+  std::uniform_real_distribution<Real> unif(0., 1.);
+
+  for (size_t num_dims=1; num_dims<=5; num_dims+=2) {
+    SpatialIndex index;
+    index.initialize(num_dims);
+    std::vector<RealArray> points;
+    for (size_t n=0; n<2000; ++n) {
+      RealArray x(num_dims);
+      for (size_t d=0; d<num_dims; ++d)
+	// coarse coordinates for some points, to exercise repeated values
+	x[d] = (n % 5) ? unif(gen) : std::floor(4.*unif(gen)) / 4.;
+      if (n % 97 == 96) x = points[n/2]; // coincident points
+      BOOST_CHECK_EQUAL(index.insert(x.data()), n);
+      points.push_back(x);
+
+      if (n % 41) continue;
+      RealArray q(num_dims);
+      for (size_t d=0; d<num_dims; ++d)
+	q[d] = unif(gen);
+
+      // nearest: first minimizer in insertion order
+      size_t i, closest = 0;
+      for (i=1; i<points.size(); ++i)
+	if (dist_sq(q, points[i]) < dist_sq(q, points[closest]))
+	  closest = i;
+      BOOST_CHECK_EQUAL(index.nearest(q.data()), closest);
+
+      // fixed radius, about a point and about an axis-parallel line
+      Real radius = 0.2;
+      size_t skip_dims[] = { _NPOS, num_dims - 1 };
+      for (size_t s=0; s<2; ++s) {
+	SizetArray found, expected;
+	index.ball_query(q.data(), radius, found, skip_dims[s]);
+	for (i=0; i<points.size(); ++i)
+	  if (dist_sq(q, points[i], skip_dims[s]) <= radius * radius)
+	    expected.push_back(i);
+	BOOST_CHECK(found == expected);
+      }
+    }
+    BOOST_CHECK_EQUAL(index.size(), points.size());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_spatial_index_empty)
+{
+  SpatialIndex index;
+  index.initialize(3);
+  Real x[3] = { 0.5, 0.5, 0.5 };
+  BOOST_CHECK_EQUAL(index.nearest(x), _NPOS);
+  SizetArray found;
+  index.ball_query(x, 10., found);
+  BOOST_CHECK(found.empty());
+}
@@ -13,6 +13,9 @@
 #include "dakota_tabular_io.hpp"
 #include "bayes_calibration_utils.hpp"
 #include "dakota_stat_util.hpp"
+#include "StreamingStatistics.hpp"
+#include "KNNInfoEstimator.hpp"
+#include "TreeGaussianKDE.hpp"
 #include <random>
 #include <thread>
 
@@ -107,6 +110,131 @@ BOOST_AUTO_TEST_CASE(test_stat_utils_mutual_info_ksg2)
 
 //------------------------------------
 
+BOOST_AUTO_TEST_CASE(test_stat_utils_mutual_info_candidates)
+{
+  // Read in matrices 
+  std::ifstream infile1("stat_util_test_files/Matrix1.txt");
+  std::ifstream infile2("stat_util_test_files/Matrix2.txt");
+  RealMatrix Xmatrix;
+  Xmatrix.shapeUninitialized(2,1000);
+  for (int i = 0; i < 1000; ++i){
+    infile1 >> Xmatrix[i][0];
+    infile2 >> Xmatrix[i][1];
+  }
+
+  // candidates sharing the X samples, estimated on several threads,
+  // reproduce the single-candidate estimate
+  RealMatrixArray candidates(5, Xmatrix);
+  for (int i = 0; i < 1000; ++i)
+    candidates[2](1,i) = Xmatrix(0,i);
+  Real gold_mi[2] = { -0.02189544513, -0.0561375052 };
+  for (unsigned short alg = 0; alg < 2; ++alg) {
+    KNNInfoEstimator mi_estimator(alg);
+    mi_estimator.x_samples(Xmatrix, 1);
+    RealVector mi_est;
+    mi_estimator.mutual_info(candidates, 1, mi_est, 3);
+    BOOST_CHECK_EQUAL(mi_est.length(), 5);
+    for (int c = 0; c < 5; ++c)
+      if (c == 2)
+	// Y identical to X is highly informative
+	BOOST_CHECK(mi_est[c] > 1.);
+      else {
+	BOOST_CHECK_CLOSE(mi_est[c], gold_mi[alg], 5.e-1);
+	BOOST_CHECK_EQUAL(mi_est[c], mi_est[0]);
+      }
+  }
+}
+
+//------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_stat_utils_tree_gaussian_kde)
+{
+  // bimodal samples in two dimensions, with densities evaluated at the
+  // samples and at points well into the tails
+  std::mt19937 rng(1234);
+  std::normal_distribution<Real> normal;
+  int i, num_samples = 4000, num_points = 1000;
+  RealMatrix samples(2, num_samples), points(2, num_points);
+  for (i = 0; i < num_samples; ++i) {
+    samples(0,i) = normal(rng) + ((i % 3) ? 0. : 4.);
+    samples(1,i) = 2. * normal(rng);
+  }
+  for (i = 0; i < num_points; ++i)
+    if (i % 2)
+      { points(0,i) = 4. * normal(rng); points(1,i) = 8. * normal(rng); }
+    else
+      { points(0,i) = samples(0,i); points(1,i) = samples(1,i); }
+
+  TreeGaussianKDE exact_kde;
+  exact_kde.initialize(samples);
+  RealVector exact_pdf;
+  exact_kde.pdf(points, exact_pdf);
+
+  // the exact density sums the product Gaussian kernels
+  const RealVector& h = exact_kde.bandwidths();
+  Real direct = 0.;
+  for (i = 0; i < num_samples; ++i)
+    direct += std::exp(-.5 * std::pow((points(0,0) - samples(0,i)) / h[0], 2)
+		       -.5 * std::pow((points(1,0) - samples(1,i)) / h[1], 2));
+  direct /= num_samples * 2. * PI * h[0] * h[1];
+  BOOST_CHECK_CLOSE(exact_pdf[0], direct, 1.e-10);
+
+  // the tree traversal respects the relative tolerance, independent of
+  // the number of threads
+  Real rel_tol = 1.e-3;
+  TreeGaussianKDE tree_kde(rel_tol);
+  tree_kde.initialize(samples);
+  RealVector tree_pdf, tree_pdf_threaded;
+  tree_kde.pdf(points, tree_pdf, 1);
+  tree_kde.pdf(points, tree_pdf_threaded, 3);
+  for (i = 0; i < num_points; ++i) {
+    BOOST_CHECK(std::abs(tree_pdf[i] - exact_pdf[i]) <=
+		rel_tol * exact_pdf[i]);
+    BOOST_CHECK_EQUAL(tree_pdf[i], tree_pdf_threaded[i]);
+  }
+}
+
+//------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_stat_utils_tree_gaussian_kde_pecos)
+{
+  // pushforward responses (num_qoi x num_samples) as in WASABI, with
+  // the density evaluated at the responses and at independent points
+  std::mt19937 rng(5678);
+  std::normal_distribution<Real> normal;
+  int i, num_samples = 2000, num_points = 500;
+  RealMatrix responses(2, num_samples), points(2, 2*num_points);
+  for (i = 0; i < num_samples; ++i) {
+    responses(0,i) = normal(rng);
+    responses(1,i) = .5 * responses(0,i) * responses(0,i) + normal(rng);
+  }
+  for (i = 0; i < num_points; ++i) {
+    points(0,i) = responses(0,i); points(1,i) = responses(1,i);
+    points(0,num_points+i) = 2. * normal(rng);
+    points(1,num_points+i) = 3. * normal(rng);
+  }
+
+  // the exact density estimate used by WASABI when kde_tolerance is 0
+  Pecos::DensityEstimator pecos_kde("gaussian_kde");
+  pecos_kde.initialize(responses, Teuchos::TRANS);
+  RealVector pecos_pdf;
+  pecos_kde.pdf(points, pecos_pdf, Teuchos::TRANS);
+
+  Real rel_tols[] = { 1.e-2, 1.e-3 };
+  for (size_t t = 0; t < 2; ++t) {
+    TreeGaussianKDE tree_kde(rel_tols[t]);
+    tree_kde.initialize(responses);
+    RealVector tree_pdf;
+    tree_kde.pdf(points, tree_pdf);
+    BOOST_REQUIRE(tree_pdf.length() == pecos_pdf.length());
+    for (i = 0; i < 2*num_points; ++i)
+      BOOST_CHECK(std::abs(tree_pdf[i] - pecos_pdf[i]) <=
+		  rel_tols[t] * pecos_pdf[i]);
+  }
+}
+
+//------------------------------------
+
 BOOST_AUTO_TEST_CASE(test_stat_utils_batch_means_mean)
 {
   // Read in matrices 
@@ -173,3 +301,168 @@ BOOST_AUTO_TEST_CASE(test_stat_utils_batch_means_percentile)
 }
 
 //------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_stat_utils_streaming_statistics)
+{
+  std::mt19937 gen(12345);
+  std::lognormal_distribution<> dist(0., 0.5);
+  size_t i, r, num_obs = 5000, num_qoi = 2;
+  RealVectorArray fn_samples(num_obs);
+  for (i=0; i<num_obs; ++i) {
+    fn_samples[i].sizeUninitialized(num_qoi);
+    fn_samples[i][0] = dist(gen); fn_samples[i][1] = -dist(gen);
+  }
+  fn_samples[7][1] = std::numeric_limits<Real>::quiet_NaN();
+
+  RealVectorArray resp_levels(num_qoi);
+  resp_levels[0].resize(2); resp_levels[0][0] = 0.5; resp_levels[0][1] = 1.5;
+  BitArray track(num_qoi); track.set(0);
+
+  // batch (threaded) accumulation vs. two disjoint partial accumulations
+  StreamingStatistics batch, part1, part2;
+  batch.initialize(num_qoi, resp_levels, track, num_obs);
+  part1.initialize(num_qoi, resp_levels, track, num_obs);
+  part2.initialize(num_qoi, resp_levels, track, num_obs);
+  batch.update(fn_samples, 4);
+  for (i=0; i<num_obs; ++i)
+    (i < num_obs/3) ? part1.update(fn_samples[i]) : part2.update(fn_samples[i]);
+  part1.merge(part2);
+  batch.finalize(); part1.finalize();
+
+  BOOST_CHECK(batch.num_samples(0) == num_obs);
+  BOOST_CHECK(batch.num_samples(1) == num_obs - 1);
+  for (size_t q=0; q<num_qoi; ++q) {
+    // two-pass reference moments
+    Real mean = 0., cm2 = 0., cm3 = 0., cm4 = 0., n = 0.;
+    for (i=0; i<num_obs; ++i)
+      if (std::isfinite(fn_samples[i][q])) { mean += fn_samples[i][q]; ++n; }
+    mean /= n;
+    for (i=0; i<num_obs; ++i)
+      if (std::isfinite(fn_samples[i][q])) {
+	Real d = fn_samples[i][q] - mean, d2 = d * d;
+	cm2 += d2; cm3 += d2 * d; cm4 += d2 * d2;
+      }
+    Real mom_b[4], mom_p[4];
+    batch.moments(q).moments(false, mom_b);
+    part1.moments(q).moments(false, mom_p);
+    BOOST_CHECK_CLOSE(mom_b[0], mean, 1.e-10);
+    BOOST_CHECK_CLOSE(mom_b[1], std::sqrt(cm2 / (n - 1.)), 1.e-10);
+    BOOST_CHECK_CLOSE(mom_b[2], n * std::sqrt(n - 1.) * cm3
+		      / ((n - 2.) * std::pow(cm2, 1.5)), 1.e-8);
+    BOOST_CHECK_CLOSE(mom_b[3], (n - 1.) / ((n - 2.) * (n - 3.))
+		      * ((n + 1.) * n * cm4 / (cm2 * cm2) - 3. * (n - 1.)),
+		      1.e-8);
+    for (size_t m=0; m<4; ++m)
+      BOOST_CHECK_CLOSE(mom_b[m], mom_p[m], 1.e-8);
+    BOOST_CHECK(batch.min(q) == part1.min(q));
+    BOOST_CHECK(batch.max(q) == part1.max(q));
+  }
+
+  // level counts and exact order statistics
+  RealArray sorted(num_obs);
+  SizetArray bins(3, 0);
+  for (i=0; i<num_obs; ++i) {
+    Real s = sorted[i] = fn_samples[i][0];
+    ++bins[(s <= 0.5) ? 0 : ((s <= 1.5) ? 1 : 2)];
+  }
+  std::sort(sorted.begin(), sorted.end());
+  BOOST_CHECK(batch.level_counts(0) == bins);
+  BOOST_CHECK(part1.level_counts(0) == bins);
+  BOOST_CHECK(batch.quantiles(0).exact());
+  for (r=0; r<num_obs; r+=499) {
+    BOOST_CHECK(batch.quantiles(0).ranked_value(r) == sorted[r]);
+    BOOST_CHECK(part1.quantiles(0).ranked_value(r) == sorted[r]);
+  }
+
+  // compacted sketch: bounded rank error
+  QuantileSketch sketch(256);
+  for (i=0; i<num_obs; ++i)
+    sketch.add(fn_samples[i][0]);
+  sketch.finalize();
+  BOOST_CHECK(!sketch.exact());
+  for (r=num_obs/10; r<num_obs; r+=num_obs/10) {
+    size_t rank = std::lower_bound(sorted.begin(), sorted.end(),
+				   sketch.ranked_value(r)) - sorted.begin();
+    BOOST_CHECK(std::abs((long)rank - (long)r) < (long)(4*num_obs/256));
+  }
+}
+
+//------------------------------------
+
+#ifdef DAKOTA_HAVE_MPI
+BOOST_AUTO_TEST_CASE(test_stat_utils_streaming_statistics_reduce)
+{
+  int mpi_init = 0;
+  MPI_Initialized(&mpi_init);
+  if (!mpi_init)
+    MPI_Init(NULL, NULL);
+
+  std::mt19937 gen(54321);
+  std::normal_distribution<> dist(1., 2.);
+  size_t i, r, num_obs = 3000, num_parts = 3, num_qoi = 2;
+  RealVectorArray fn_samples(num_obs);
+  for (i=0; i<num_obs; ++i) {
+    fn_samples[i].sizeUninitialized(num_qoi);
+    fn_samples[i][0] = dist(gen); fn_samples[i][1] = dist(gen) * dist(gen);
+  }
+  RealVectorArray resp_levels(num_qoi);
+  resp_levels[1].resize(3);
+  resp_levels[1][0] = -1.; resp_levels[1][1] = 0.; resp_levels[1][2] = 1.;
+  BitArray track(num_qoi); track.set();
+
+  // partial statistics transferred as in reduce() (pack, unpack into the
+  // same configuration, merge) vs. a single accumulation
+  StreamingStatistics all, merged;
+  all.initialize(num_qoi, resp_levels, track, 512);
+  merged.initialize(num_qoi, resp_levels, track, 512);
+  all.update(fn_samples);
+  for (size_t p=0; p<num_parts; ++p) {
+    StreamingStatistics part, received;
+    part.initialize(num_qoi, resp_levels, track, 512);
+    received.initialize(num_qoi, resp_levels, track, 512);
+    for (i=p; i<num_obs; i+=num_parts)
+      part.update(fn_samples[i]);
+    MPIPackBuffer send_buff;
+    part.pack(send_buff);
+    MPIUnpackBuffer recv_buff(const_cast<char*>(send_buff.buf()),
+			      send_buff.size(), false);
+    received.unpack(recv_buff);
+    merged.merge(received);
+  }
+
+  // reduction over a single rank leaves the statistics unchanged
+  merged.reduce(MPI_COMM_SELF);
+  all.finalize(); merged.finalize();
+
+  BOOST_CHECK(merged.num_observations() == num_obs);
+  for (size_t q=0; q<num_qoi; ++q) {
+    Real mom_a[4], mom_m[4];
+    all.moments(q).moments(true, mom_a);
+    merged.moments(q).moments(true, mom_m);
+    for (size_t m=0; m<4; ++m)
+      BOOST_CHECK_CLOSE(mom_a[m], mom_m[m], 1.e-8);
+    BOOST_CHECK(all.min(q) == merged.min(q));
+    BOOST_CHECK(all.max(q) == merged.max(q));
+    BOOST_CHECK(all.level_counts(q) == merged.level_counts(q));
+
+    // both sketches compacted to a fixed capacity: bounded rank error
+    RealArray sorted(num_obs);
+    for (i=0; i<num_obs; ++i)
+      sorted[i] = fn_samples[i][q];
+    std::sort(sorted.begin(), sorted.end());
+    BOOST_CHECK(merged.quantiles(q).count() == num_obs);
+    BOOST_CHECK(!merged.quantiles(q).exact());
+    for (r=num_obs/10; r<num_obs; r+=num_obs/10) {
+      size_t rank = std::lower_bound(sorted.begin(), sorted.end(),
+				     merged.quantiles(q).ranked_value(r))
+	- sorted.begin();
+      BOOST_CHECK(std::abs((long)rank - (long)r) < (long)(4*num_obs/512));
+    }
+  }
+
+  if (!mpi_init)
+    MPI_Finalize();
+}
+#endif // DAKOTA_HAVE_MPI
+
+//------------------------------------
@@ -0,0 +1,213 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+
+#include "StreamingVBD.hpp"
+#include "dakota_mersenne_twister.hpp"
+#include <boost/random/uniform_real_distribution.hpp>
+#include <cmath>
+
+#define BOOST_TEST_MODULE dakota_streaming_vbd
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+
+namespace {
+
+const size_t NUM_VARS = 3;
+const size_t NUM_FNS  = 2;
+
+/// Ishigami function (a = 7, b = 0.1) and a linear function of
+/// x in [-pi, pi]^3
+RealVector fns(const Real* x)
+{
+  RealVector f(NUM_FNS);
+  f[0] = std::sin(x[0]) + 7. * std::pow(std::sin(x[1]), 2)
+    + 0.1 * std::pow(x[2], 4) * std::sin(x[0]);
+  f[1] = 3. * x[0] + 2. * x[1] + x[2];
+  return f;
+}
+
+/// responses of the pick-and-freeze design for num_samples samples
+/// of A and B, ordered A, B, C_1, ..., C_NUM_VARS
+RealVectorArray pick_freeze_responses(size_t num_samples, int seed)
+{
+  boost::random::mt19937 rng(seed);
+  boost::random::uniform_real_distribution<Real> x_dist(-M_PI, M_PI);
+  RealMatrix a(NUM_VARS, num_samples), b(NUM_VARS, num_samples);
+  size_t i, j, v;
+  for (j=0; j<num_samples; ++j)
+    for (i=0; i<NUM_VARS; ++i)
+      { a(i, j) = x_dist(rng); b(i, j) = x_dist(rng); }
+
+  RealVectorArray resp(num_samples * (NUM_VARS + 2));
+  for (j=0; j<num_samples; ++j) {
+    resp[j]               = fns(a[j]);
+    resp[num_samples + j] = fns(b[j]);
+  }
+  Real c[NUM_VARS];
+  for (v=0; v<NUM_VARS; ++v)
+    for (j=0; j<num_samples; ++j) {
+      for (i=0; i<NUM_VARS; ++i)
+	c[i] = (i == v) ? a(i, j) : b(i, j);
+      resp[(v + 2) * num_samples + j] = fns(c);
+    }
+  return resp;
+}
+
+/// the full-tensor Saltelli/Jansen estimator previously used by
+/// SensAnalysisGlobal::compute_pick_and_freeze_vbd_stats()
+void batch_indices(const RealVectorArray& resp, size_t num_samples,
+		   RealVectorArray& index_si, RealVectorArray& index_ti)
+{
+  index_si.assign(NUM_FNS, RealVector(NUM_VARS));
+  index_ti.assign(NUM_FNS, RealVector(NUM_VARS));
+  Real n = (Real)num_samples;
+  for (size_t k=0; k<NUM_FNS; ++k) {
+    Real mean_a = 0., mean_b = 0., overall_mean = 0., var_c = 0.;
+    size_t i, j;
+    for (j=0; j<num_samples; ++j) {
+      mean_a += resp[j][k]; mean_b += resp[num_samples + j][k];
+      var_c += std::pow(resp[j][k], 2) + std::pow(resp[num_samples + j][k], 2);
+    }
+    for (j=0; j<resp.size(); ++j)
+      overall_mean += resp[j][k];
+    overall_mean /= (Real)resp.size();
+    mean_a /= n; mean_b /= n;
+    Real mean_c = (mean_a + mean_b) / 2.;
+    var_c = var_c / (2. * n) - mean_c * mean_c;
+
+    for (i=0; i<NUM_VARS; ++i) {
+      Real sum_s = 0., sum_t = 0.;
+      for (j=0; j<num_samples; ++j) {
+	Real diff = resp[(i + 2) * num_samples + j][k]
+	  - resp[num_samples + j][k];
+	sum_s += (resp[j][k] - overall_mean) * diff;
+	sum_t += diff * diff;
+      }
+      index_si[k][i] = (sum_s / n) / var_c;
+      index_ti[k][i] = (sum_t / (2. * n)) / var_c;
+    }
+  }
+}
+
+void check_close(const RealVectorArray& x, const RealVectorArray& y, Real tol)
+{
+  BOOST_REQUIRE_EQUAL(x.size(), y.size());
+  for (size_t k=0; k<x.size(); ++k) {
+    BOOST_REQUIRE_EQUAL(x[k].length(), y[k].length());
+    for (int i=0; i<x[k].length(); ++i)
+      BOOST_CHECK_SMALL(x[k][i] - y[k][i], tol);
+  }
+}
+
+}
+
+
+BOOST_AUTO_TEST_CASE(test_streaming_matches_batch_indices)
+{
+  size_t num_samples = 500;
+  RealVectorArray resp = pick_freeze_responses(num_samples, 1234);
+
+  RealVectorArray batch_si, batch_ti;
+  batch_indices(resp, num_samples, batch_si, batch_ti);
+
+  StreamingVBD vbd;
+  vbd.initialize(NUM_FNS, NUM_VARS, num_samples);
+  vbd.update(resp, 1);
+  RealVectorArray si, ti;
+  vbd.compute_indices(si, ti);
+  check_close(si, batch_si, 1.e-10);
+  check_close(ti, batch_ti, 1.e-10);
+}
+
+
+BOOST_AUTO_TEST_CASE(test_out_of_order_and_threaded_updates)
+{
+  size_t num_samples = 200, num_evals = num_samples * (NUM_VARS + 2);
+  RealVectorArray resp = pick_freeze_responses(num_samples, 4321);
+
+  StreamingVBD in_order;
+  in_order.initialize(NUM_FNS, NUM_VARS, num_samples);
+  in_order.update(resp, 1);
+  RealVectorArray si, ti;
+  in_order.compute_indices(si, ti);
+
+  // C responses arrive before the A and B responses they depend on
+  StreamingVBD reversed;
+  reversed.initialize(NUM_FNS, NUM_VARS, num_samples);
+  for (size_t e=num_evals; e>0; --e)
+    reversed.update(e - 1, resp[e - 1]);
+  RealVectorArray rev_si, rev_ti;
+  reversed.compute_indices(rev_si, rev_ti);
+  check_close(rev_si, si, 1.e-12);
+  check_close(rev_ti, ti, 1.e-12);
+
+  // per-variable partitioning leaves the sums unchanged
+  StreamingVBD threaded;
+  threaded.initialize(NUM_FNS, NUM_VARS, num_samples);
+  threaded.update(resp, NUM_VARS);
+  RealVectorArray thr_si, thr_ti;
+  threaded.compute_indices(thr_si, thr_ti);
+  for (size_t k=0; k<NUM_FNS; ++k)
+    for (size_t i=0; i<NUM_VARS; ++i) {
+      BOOST_CHECK_EQUAL(thr_si[k][i], si[k][i]);
+      BOOST_CHECK_EQUAL(thr_ti[k][i], ti[k][i]);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(test_analytic_indices_and_bootstrap_intervals)
+{
+  // Ishigami: S = (0.3139, 0.4424, 0), T = (0.5576, 0.4424, 0.2437);
+  // linear: S = T = (9, 4, 1) / 14
+  const Real exact_s[NUM_FNS][NUM_VARS]
+    = { { 0.3139, 0.4424, 0. }, { 9./14., 4./14., 1./14. } };
+  const Real exact_t[NUM_FNS][NUM_VARS]
+    = { { 0.5576, 0.4424, 0.2437 }, { 9./14., 4./14., 1./14. } };
+
+  size_t num_samples = 20000, num_boot = 200;
+  RealVectorArray resp = pick_freeze_responses(num_samples, 52983);
+
+  StreamingVBD vbd;
+  vbd.initialize(NUM_FNS, NUM_VARS, num_samples, num_boot, 7);
+  BOOST_CHECK_EQUAL(vbd.num_bootstrap(), num_boot);
+  vbd.update(resp);
+  RealVectorArray si, ti;
+  vbd.compute_indices(si, ti);
+  RealMatrixArray si_ci, ti_ci;
+  vbd.compute_confidence_intervals(0.95, si_ci, ti_ci);
+  BOOST_REQUIRE_EQUAL(si_ci.size(), NUM_FNS);
+  BOOST_REQUIRE_EQUAL(ti_ci.size(), NUM_FNS);
+
+  for (size_t k=0; k<NUM_FNS; ++k) {
+    BOOST_REQUIRE_EQUAL(si_ci[k].numRows(), 2);
+    BOOST_REQUIRE_EQUAL(si_ci[k].numCols(), (int)NUM_VARS);
+    for (size_t i=0; i<NUM_VARS; ++i) {
+      BOOST_CHECK_SMALL(si[k][i] - exact_s[k][i], 0.03);
+      BOOST_CHECK_SMALL(ti[k][i] - exact_t[k][i], 0.03);
+      // intervals are ordered, contain the estimate and are narrow
+      BOOST_CHECK_LE(si_ci[k](0, i), si[k][i]);
+      BOOST_CHECK_GE(si_ci[k](1, i), si[k][i]);
+      BOOST_CHECK_LE(ti_ci[k](0, i), ti[k][i]);
+      BOOST_CHECK_GE(ti_ci[k](1, i), ti[k][i]);
+      BOOST_CHECK_LT(si_ci[k](1, i) - si_ci[k](0, i), 0.1);
+      BOOST_CHECK_LT(ti_ci[k](1, i) - ti_ci[k](0, i), 0.1);
+    }
+  }
+
+  // without resamples the intervals are empty
+  StreamingVBD no_boot;
+  no_boot.initialize(NUM_FNS, NUM_VARS, 100);
+  no_boot.update(pick_freeze_responses(100, 11));
+  no_boot.compute_confidence_intervals(0.95, si_ci, ti_ci);
+  BOOST_REQUIRE_EQUAL(si_ci.size(), NUM_FNS);
+  BOOST_CHECK_EQUAL(si_ci[0].numRows(), 0);
+  BOOST_CHECK_EQUAL(ti_ci[1].numCols(), 0);
+}
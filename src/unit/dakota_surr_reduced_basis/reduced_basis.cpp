@@ -371,6 +371,92 @@ BOOST_AUTO_TEST_CASE(test_reduced_basis_truncations)
 
 //----------------------------------------------------------------
 
+BOOST_AUTO_TEST_CASE(test_reduced_basis_randomized_svd)
+{
+  // Use the response submatrix
+  RealMatrix matrix = get_parameter_and_response_submatrices().second;
+
+  ReducedBasis full_basis;
+  full_basis.set_matrix(matrix);
+  full_basis.update_svd();
+
+  // --------------- What we are testing
+  ReducedBasis::VarianceExplained truncation(0.99);
+  ReducedBasis reduced_basis;
+  reduced_basis.set_matrix(matrix);
+  reduced_basis.update_randomized_svd(truncation);
+  // --------------- What we are testing
+
+  const RealVector & singular_values = reduced_basis.get_singular_values();
+  const RealVector & full_singular_values = full_basis.get_singular_values();
+  int num_values = singular_values.length();
+
+  // only the leading singular triplets are computed, but the truncation
+  // is that of the full factorization
+  BOOST_CHECK( reduced_basis.is_truncated() );
+  BOOST_CHECK( num_values < full_singular_values.length() );
+  BOOST_CHECK( truncation.get_num_components(reduced_basis) == 4 );
+  BOOST_CHECK_CLOSE(reduced_basis.get_eigen_values_sum(), 86.00739691478532, 1.e-12);
+  for( int i=0; i<4; ++i )
+    BOOST_CHECK_CLOSE(singular_values(i), full_singular_values(i), 1.e-8);
+
+  BOOST_CHECK( reduced_basis.get_left_singular_vector().numCols() == num_values );
+  BOOST_CHECK( reduced_basis.get_right_singular_vector_transpose().numRows() == num_values );
+}
+
+//----------------------------------------------------------------
+
+BOOST_AUTO_TEST_CASE(test_reduced_basis_append_rows)
+{
+  // Use the response submatrix
+  RealMatrix matrix = get_parameter_and_response_submatrices().second;
+  int num_rows = matrix.numRows(), num_cols = matrix.numCols();
+
+  ReducedBasis full_basis;
+  full_basis.set_matrix(matrix);
+  full_basis.update_svd();
+
+  // --------------- What we are testing
+  // factor the first 60 observations, then append the rest in two updates
+  ReducedBasis reduced_basis;
+  reduced_basis.set_matrix(RealMatrix(Teuchos::Copy, matrix, 60, num_cols, 0, 0));
+  reduced_basis.update_svd();
+  reduced_basis.append_rows(RealMatrix(Teuchos::Copy, matrix, 15, num_cols, 60, 0));
+  reduced_basis.append_rows(RealMatrix(Teuchos::Copy, matrix, 25, num_cols, 75, 0));
+  // --------------- What we are testing
+
+  const RealVector & singular_values = reduced_basis.get_singular_values();
+  const RealVector & full_singular_values = full_basis.get_singular_values();
+  BOOST_CHECK( singular_values.length() == full_singular_values.length() );
+  for( int i=0; i<5; ++i )
+    BOOST_CHECK_CLOSE(singular_values(i), full_singular_values(i), 1.e-8);
+  BOOST_CHECK_CLOSE(reduced_basis.get_eigen_values_sum(),
+                    full_basis.get_eigen_values_sum(), 1.e-10);
+
+  // the matrix is centered by the means of all observations
+  RealMatrix centered_diff(reduced_basis.get_matrix());
+  centered_diff -= full_basis.get_matrix();
+  BOOST_CHECK_SMALL(centered_diff.normFrobenius(), 1.e-12);
+  const RealVector & column_means = reduced_basis.get_column_means();
+  const RealVector & full_column_means = full_basis.get_column_means();
+  for( int j=0; j<num_cols; ++j )
+    BOOST_CHECK_SMALL(column_means(j) - full_column_means(j), 1.e-12);
+
+  // the updated factors reconstruct the centered matrix
+  const RealMatrix & U_mat = reduced_basis.get_left_singular_vector();
+  const RealMatrix & VT_mat = reduced_basis.get_right_singular_vector_transpose();
+  RealMatrix US_mat(U_mat);
+  for( int j=0; j<US_mat.numCols(); ++j )
+    for( int i=0; i<num_rows; ++i )
+      US_mat(i,j) *= singular_values(j);
+  RealMatrix reconstructed_mat(num_rows, num_cols);
+  reconstructed_mat.multiply(Teuchos::NO_TRANS, Teuchos::NO_TRANS, 1.0, US_mat, VT_mat, 0.0);
+  reconstructed_mat -= full_basis.get_matrix();
+  BOOST_CHECK_SMALL(reconstructed_mat.normFrobenius(), 1.e-10);
+}
+
+//----------------------------------------------------------------
+
 #ifdef HAVE_DAKOTA_SURROGATES
 
 #include "DakotaSurrogatesGP.hpp"
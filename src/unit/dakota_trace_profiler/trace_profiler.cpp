@@ -0,0 +1,143 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "TraceProfiler.hpp"
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#define BOOST_TEST_MODULE dakota_trace_profiler
+#include <boost/test/included/unit_test.hpp>
+
+using namespace Dakota;
+namespace pt = boost::property_tree;
+
+namespace {
+
+  const char trace_file[] = "dakota_trace_profiler.json";
+
+  /// parse the Chrome trace written by TraceProfiler::finalize()
+  pt::ptree read_trace(const String& file_name)
+  {
+    pt::ptree trace;
+    std::ifstream trace_stream(file_name.c_str());
+    BOOST_REQUIRE( trace_stream.good() );
+    pt::read_json(trace_stream, trace);
+    return trace;
+  }
+
+  /// the events of a parsed trace with the given name and phase
+  std::vector<pt::ptree>
+  trace_events(const pt::ptree& trace, const String& name, const String& ph)
+  {
+    std::vector<pt::ptree> events;
+    for (const pt::ptree::value_type& ev : trace.get_child("traceEvents"))
+      if (ev.second.get<String>("name") == name &&
+	  ev.second.get<String>("ph") == ph)
+	events.push_back(ev.second);
+    return events;
+  }
+
+}
+
+//----------------------------------------------------------------
+
+/** Scoped phases are written as complete events and spans as async
+    begin/end pairs sharing an id; the file parses as JSON. */
+BOOST_AUTO_TEST_CASE(test_trace_profiler_chrome_trace)
+{
+  TraceProfiler::initialize(trace_file, 0);
+  BOOST_REQUIRE( TraceProfiler::active() );
+
+  String method_string("sampling");
+  {
+    TraceScope trace_scope(method_string + "::core_run", "iterator");
+    TraceScope eval_scope("write_parameters", "interface", 7);
+  }
+  TraceProfiler::begin_span("evaluation", "interface", &method_string, 3);
+  TraceProfiler::begin_span("evaluation", "interface", &method_string, 4);
+  TraceProfiler::end_span("evaluation", "interface", &method_string, 4);
+  TraceProfiler::end_span("evaluation", "interface", &method_string, 3);
+  // ending a span that was never started records nothing
+  TraceProfiler::end_span("queue_wait", "interface", &method_string, 5);
+  // an open span is not written
+  TraceProfiler::begin_span("queue_wait", "interface", &method_string, 6);
+
+  std::ostringstream summary;
+  TraceProfiler::finalize(summary, true);
+  BOOST_CHECK( !TraceProfiler::active() );
+  BOOST_CHECK( summary.str().find("sampling::core_run") != String::npos );
+  BOOST_CHECK( summary.str().find(trace_file) != String::npos );
+
+  pt::ptree trace = read_trace(trace_file);
+  BOOST_CHECK_EQUAL( trace.get<String>("displayTimeUnit"), "ms" );
+  BOOST_CHECK_EQUAL( trace.get_child("traceEvents").size(), 6 );
+
+  std::vector<pt::ptree> core_run
+    = trace_events(trace, "sampling::core_run", "X");
+  BOOST_REQUIRE_EQUAL( core_run.size(), 1 );
+  BOOST_CHECK_EQUAL( core_run[0].get<String>("cat"), "iterator" );
+  BOOST_CHECK_EQUAL( core_run[0].get<int>("pid"), 0 );
+  BOOST_CHECK( core_run[0].get<double>("dur") >= 0. );
+  BOOST_CHECK( !core_run[0].get_child_optional("args") );
+
+  // the nested phase completes first and lies within the enclosing one
+  std::vector<pt::ptree> write_params
+    = trace_events(trace, "write_parameters", "X");
+  BOOST_REQUIRE_EQUAL( write_params.size(), 1 );
+  BOOST_CHECK_EQUAL( write_params[0].get<int>("args.eval_id"), 7 );
+  BOOST_CHECK( write_params[0].get<double>("ts")
+	       >= core_run[0].get<double>("ts") );
+  BOOST_CHECK( write_params[0].get<double>("dur")
+	       <= core_run[0].get<double>("dur") );
+
+  std::vector<pt::ptree> begins = trace_events(trace, "evaluation", "b"),
+    ends = trace_events(trace, "evaluation", "e");
+  BOOST_REQUIRE_EQUAL( begins.size(), 2 );
+  BOOST_REQUIRE_EQUAL( ends.size(), 2 );
+  for (size_t i=0; i<2; ++i) {
+    BOOST_CHECK_EQUAL( begins[i].get<String>("id"), ends[i].get<String>("id") );
+    BOOST_CHECK( ends[i].get<double>("ts") >= begins[i].get<double>("ts") );
+  }
+  BOOST_CHECK( begins[0].get<String>("id") != begins[1].get<String>("id") );
+  // spans are written in order of completion
+  BOOST_CHECK_EQUAL( begins[0].get<int>("args.eval_id"), 4 );
+  BOOST_CHECK_EQUAL( begins[1].get<int>("args.eval_id"), 3 );
+  BOOST_CHECK( trace_events(trace, "queue_wait", "b").empty() );
+
+  std::remove(trace_file);
+}
+
+/** While inactive, instrumentation points record nothing. */
+BOOST_AUTO_TEST_CASE(test_trace_profiler_inactive)
+{
+  BOOST_REQUIRE( !TraceProfiler::active() );
+  {
+    TraceScope trace_scope("core_run", "iterator");
+    TraceProfiler::begin_span("evaluation", "interface", nullptr, 1);
+  }
+  TraceProfiler::end_span("evaluation", "interface", nullptr, 1);
+
+  // a later trace holds only events recorded while active
+  TraceProfiler::initialize(trace_file, 0);
+  TraceProfiler::end_span("evaluation", "interface", nullptr, 1);
+  std::ostringstream summary;
+  TraceProfiler::finalize(summary, false);
+  BOOST_CHECK( summary.str().empty() );
+
+  pt::ptree trace = read_trace(trace_file);
+  BOOST_CHECK( trace.get_child("traceEvents").empty() );
+
+  std::remove(trace_file);
+}
@@ -0,0 +1,50 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#include "util_threads.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+
+namespace dakota {
+namespace util {
+
+/// number of processes sharing this node, as set by the parallel library
+static std::atomic<size_t> processes_per_node(1);
+
+// ------------------------------------------------------------
+
+size_t thread_budget() {
+  const char* env_threads = std::getenv("DAKOTA_NUM_THREADS");
+  if (env_threads) {
+    char* end = nullptr;
+    long n = std::strtol(env_threads, &end, 10);
+    if (end != env_threads && n > 0) return n;
+  }
+  size_t hw_threads = std::thread::hardware_concurrency();
+  return std::max<size_t>(1, hw_threads / processes_per_node.load());
+}
+
+// ------------------------------------------------------------
+
+size_t num_threads(size_t num_requested, size_t max_useful) {
+  size_t n = (num_requested) ? num_requested : thread_budget();
+  return std::max<size_t>(1, std::min(n, max_useful));
+}
+
+// ------------------------------------------------------------
+
+void set_processes_per_node(size_t num_procs) {
+  processes_per_node.store(std::max<size_t>(1, num_procs));
+}
+
+}  // namespace util
+}  // namespace dakota
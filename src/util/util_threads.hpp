@@ -0,0 +1,52 @@
+/*  _______________________________________________________________________
+
+    Dakota: Explore and predict with confidence.
+    Copyright 2014-2023
+    National Technology & Engineering Solutions of Sandia, LLC (NTESS).
+    This software is distributed under the GNU Lesser General Public License.
+    For more information, see the README file in the top Dakota directory.
+    _______________________________________________________________________ */
+
+#ifndef DAKOTA_UTIL_THREADS_HPP
+#define DAKOTA_UTIL_THREADS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace dakota {
+namespace util {
+
+/**
+ *  \brief Number of threads a process may use for a parallel computation
+ *
+ *  The budget is the value of the environment variable DAKOTA_NUM_THREADS
+ *  when set to a positive integer.  Otherwise, the hardware concurrency of
+ *  the node is divided among the processes sharing it (see
+ *  set_processes_per_node()), with at least one thread per process.
+ *  \returns The per-process thread budget
+ */
+size_t thread_budget();
+
+/**
+ *  \brief Number of threads for a parallel computation
+ *  \param[in] num_requested Number of threads requested by the caller, e.g.,
+ * from a user specification; 0 selects the thread_budget()
+ *  \param[in] max_useful Largest number of threads the computation can use
+ * (e.g., its number of work blocks)
+ *  \returns The number of threads to launch (at least 1)
+ */
+size_t num_threads(size_t num_requested = 0, size_t max_useful = SIZE_MAX);
+
+/**
+ *  \brief Set the number of processes running on this node
+ *
+ *  Called by the parallel library once the MPI configuration is known, so
+ *  that threaded computations in each process do not oversubscribe the node.
+ *  \param[in] num_procs Number of processes on this node (0 is treated as 1)
+ */
+void set_processes_per_node(size_t num_procs);
+
+}  // namespace util
+}  // namespace dakota
+
+#endif  // DAKOTA_UTIL_THREADS_HPP
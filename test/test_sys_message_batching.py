@@ -0,0 +1,152 @@
+#!/usr/bin/env python
+"""Test batched evaluation messages from a dedicated master
+
+Run the same sampling study on a dedicated master with three evaluation
+servers, once sending one evaluation per message and once with
+message_batching, and check that the evaluation ids, variables,
+responses, and final statistics agree.
+
+Script is intended to be run by CTest from dakota.build/test directory
+"""
+from __future__ import print_function
+import os
+import subprocess
+import sys
+
+if len(sys.argv) < 3:
+    raise RuntimeError("Usage:\n  " + sys.argv[0] +
+                       " /path/to/dakota /path/to/mpiexec [numproc_flag]")
+else:
+    print("Running with arguments", sys.argv)
+
+dakota_exe = sys.argv[1]
+mpiexec = sys.argv[2]
+numproc_flag = sys.argv[3] if len(sys.argv) > 3 else "-np"
+num_procs = 4  # dedicated master + 3 evaluation servers
+
+test_subdir = "sys_message_batching"
+error_cnt = 0
+
+dakota_input = """
+environment
+  tabular_data
+    tabular_data_file = '{name}.dat'
+
+method
+  sampling
+    sample_type lhs
+    samples = 50
+    seed = 5034
+
+variables
+  uniform_uncertain = 2
+    lower_bounds = 0.5 -2.9
+    upper_bounds = 2.9 -0.5
+    descriptors  = 'x1' 'x2'
+
+interface
+  direct
+    analysis_drivers = 'text_book'
+  evaluation_servers = 3
+  evaluation_scheduling master
+{batching}
+
+responses
+  response_functions = 3
+  no_gradients
+  no_hessians
+"""
+
+# (name, batching specification); batches of at most 4 evaluations
+# leave a partial batch at the end of the queue
+studies = [("unbatched", ""),
+           ("batched",   "    message_batching\n      max_batch_size = 4")]
+
+
+def read_tabular(tabular_file):
+    """Return the header and the data lines keyed by evaluation id"""
+    with open(tabular_file) as tf:
+        lines = tf.read().splitlines()
+    evals = {}
+    for line in lines[1:]:
+        fields = line.split()
+        if fields:
+            evals[int(fields[0])] = fields[2:]  # skip interface id
+    return lines[0], evals
+
+
+def final_statistics(output):
+    """Return the moment statistics reported at the end of the study"""
+    lines = output.splitlines()
+    for i, line in enumerate(lines):
+        if line.startswith("Sample moment statistics"):
+            return [l.split() for l in lines[i+1:i+5]]
+    return []
+
+
+# Setup a directory for the study outputs, remove any stale output
+if os.path.exists(test_subdir):
+    if not os.path.isdir(test_subdir):
+        raise RuntimeError(test_subdir + " exists, but is not a directory.")
+else:
+    os.mkdir(test_subdir)
+os.chdir(test_subdir)
+
+results = {}
+for name, batching in studies:
+    input_file = "dakota_" + name + ".in"
+    for fname in (input_file, name + ".dat", name + ".rst"):
+        if os.path.exists(fname):
+            os.remove(fname)
+    with open(input_file, "w") as inf:
+        inf.write(dakota_input.format(name=name, batching=batching))
+
+    dakota_cmd = " ".join([mpiexec, numproc_flag, str(num_procs), dakota_exe,
+                           "-input", input_file, "-write_restart",
+                           name + ".rst"])
+    print("Running: " + dakota_cmd)
+    pobj = subprocess.Popen(dakota_cmd, shell=True, stdout=subprocess.PIPE,
+                            stderr=subprocess.PIPE, universal_newlines=True)
+    stdout, stderr = pobj.communicate()
+    if pobj.returncode != 0 or not os.path.exists(name + ".dat"):
+        print("ERROR: " + name + " study failed\n" + stderr)
+        error_cnt += 1
+        continue
+    results[name] = (read_tabular(name + ".dat"), final_statistics(stdout))
+
+if len(results) == len(studies):
+    (ref_header, ref_evals), ref_stats = results["unbatched"]
+    (header, evals), stats = results["batched"]
+
+    if header != ref_header:
+        print("ERROR: tabular headers differ")
+        error_cnt += 1
+
+    if sorted(evals) == sorted(ref_evals) == list(range(1, 51)):
+        print("INFO: evaluation ids agree")
+    else:
+        print("ERROR: evaluation ids differ:\n  unbatched: " +
+              str(sorted(ref_evals)) + "\n  batched:   " + str(sorted(evals)))
+        error_cnt += 1
+
+    mismatched = [i for i in ref_evals if evals.get(i) != ref_evals[i]]
+    if mismatched:
+        print("ERROR: variables or responses differ for evaluation ids " +
+              str(mismatched))
+        error_cnt += 1
+    else:
+        print("INFO: variables and responses agree for each evaluation id")
+
+    if ref_stats and stats == ref_stats:
+        print("INFO: final statistics agree")
+    else:
+        print("ERROR: final statistics differ:\n  unbatched: " +
+              str(ref_stats) + "\n  batched:   " + str(stats))
+        error_cnt += 1
+
+if error_cnt > 0:
+    print("{:d} errors encountered during test.".format(error_cnt))
+    sys.exit(1)
+
+print("All tests passed.")
+sys.exit(0)